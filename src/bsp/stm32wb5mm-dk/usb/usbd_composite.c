@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_composite.h"
+#include "usbd_composite_builder.h"
+#include "usbd_core.h"
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Register a class in the composite device and select it for the class specific registrations which follow */
+uint8_t USBD_COMPOSITE_AddClass(USBD_HandleTypeDef *pdev, USBD_ClassTypeDef *pclass,
+                                USBD_CompositeClassTypeDef classtype, uint8_t *EpAddr, uint32_t instance)
+{
+  uint8_t class_id = USBD_COMPOSITE_INVALID_CLASS_ID;
+
+  if (USBD_RegisterClassComposite(pdev, pclass, classtype, EpAddr) == USBD_OK)
+  {
+    class_id = (uint8_t)USBD_CMPSIT_SetClassID(pdev, classtype, instance);
+  }
+
+  return class_id;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBD_COMPOSITE_H
+#define __USBD_COMPOSITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_def.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Class identifier returned on error */
+#define USBD_COMPOSITE_INVALID_CLASS_ID 0xFFU
+
+/* Exported functions ------------------------------------------------------- */
+
+/* Register a class in the composite device and select it for the class specific
+ * registrations which follow, returns the class identifier or USBD_COMPOSITE_INVALID_CLASS_ID.
+ * The composite builder header declares its prototypes with 'class' as parameter name
+ * and thus cannot be included from C++ code, this wrapper is the C++ entry point */
+uint8_t USBD_COMPOSITE_AddClass(USBD_HandleTypeDef *pdev, USBD_ClassTypeDef *pclass,
+                                USBD_CompositeClassTypeDef classtype, uint8_t *EpAddr, uint32_t instance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBD_COMPOSITE_H */
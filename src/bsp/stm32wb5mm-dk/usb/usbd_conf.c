@@ -20,6 +20,7 @@
 #include "stm32wbxx_hal.h"
 #include "usbd_core.h"
 #include "usbd_cdc.h"
+#include "usbd_msc.h"
 
 /* Private typedef ---------------------------------------------------------- */
 /* Private define ----------------------------------------------------------- */
@@ -240,11 +241,16 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef * pdev)
   /* Initialize LL Driver */
   HAL_PCD_Init(&s_hpcd);
 
+  /* Packet memory layout : buffer table, control endpoints then both CDC
+   * functions (the MSC function uses the endpoints of the first one) */
   HAL_PCDEx_PMAConfig(&s_hpcd , 0x00 , PCD_SNG_BUF, 0x40);
   HAL_PCDEx_PMAConfig(&s_hpcd , 0x80 , PCD_SNG_BUF, 0x80);
-  HAL_PCDEx_PMAConfig(&s_hpcd , CDC_IN_EP , PCD_SNG_BUF, 0x94);
-  HAL_PCDEx_PMAConfig(&s_hpcd , CDC_OUT_EP , PCD_SNG_BUF, 0xD4);
-  HAL_PCDEx_PMAConfig(&s_hpcd, CDC_CMD_EP, PCD_SNG_BUF, 0x114);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC_IN_EP , PCD_SNG_BUF, 0xC0);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC_OUT_EP , PCD_SNG_BUF, 0x100);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC_CMD_EP , PCD_SNG_BUF, 0x140);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC2_IN_EP , PCD_SNG_BUF, 0x150);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC2_OUT_EP , PCD_SNG_BUF, 0x190);
+  HAL_PCDEx_PMAConfig(&s_hpcd , CDC2_CMD_EP , PCD_SNG_BUF, 0x1D0);
 
   return USBD_OK;
 }
@@ -481,23 +487,45 @@ void USBD_LL_Delay(uint32_t Delay)
   HAL_Delay(Delay);
 }
 
+/* Static allocation slots, one per class of the composite device */
+static uint32_t s_mem[USBD_MAX_SUPPORTED_CLASS][(MAX_STATIC_ALLOC_SIZE + 3u) / 4u];
+static uint8_t s_mem_used[USBD_MAX_SUPPORTED_CLASS];
+
 /**
-  * @brief  static single allocation.
+  * @brief  static allocation in the first free slot.
   * @param  size: size of allocated memory
-  * @retval None
+  * @retval Allocated memory, NULL if no slot is free
   */
 void *USBD_static_malloc(uint32_t size)
 {
-  static uint32_t mem[MAX_STATIC_ALLOC_SIZE];
-  return mem;
+  void *p = NULL;
+  uint32_t i;
+
+  for (i = 0u; (p == NULL) && (i < USBD_MAX_SUPPORTED_CLASS); i++)
+  {
+    if ((s_mem_used[i] == 0u) && (size <= sizeof(s_mem[i])))
+    {
+      s_mem_used[i] = 1u;
+      p = s_mem[i];
+    }
+  }
+  return p;
 }
 
 /**
-  * @brief  Dummy memory free
+  * @brief  static allocation release
   * @param  *p pointer to allocated  memory address
   * @retval None
   */
 void USBD_static_free(void *p)
 {
-  return;
+  uint32_t i;
+
+  for (i = 0u; i < USBD_MAX_SUPPORTED_CLASS; i++)
+  {
+    if (p == s_mem[i])
+    {
+      s_mem_used[i] = 0u;
+    }
+  }
 }
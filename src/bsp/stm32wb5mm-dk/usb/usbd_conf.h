@@ -29,23 +29,45 @@
 /* Exported types ------------------------------------------------------------ */
 /* Exported constants -------------------------------------------------------- */
 /* Common Config */
-#define USBD_MAX_NUM_INTERFACES               2
+#define USBD_MAX_NUM_INTERFACES               4
 #define USBD_MAX_NUM_CONFIGURATION            1
 #define USBD_MAX_STR_DESC_SIZ                 0x100
 #define USBD_SUPPORT_USER_STRING              0
 #define USBD_SELF_POWERED                     1
 #define USBD_DEBUG_LEVEL                      0
 
+/* Composite Config : two CDC ACM functions or one MSC function */
+#define USE_USBD_COMPOSITE
+#define USBD_MAX_SUPPORTED_CLASS              2U
+#define USBD_COMPOSITE_USE_IAD                1U
+#define USBD_CMPSIT_ACTIVATE_CDC              1U
+#define USBD_CMPSIT_ACTIVATE_MSC              1U
+
+/* CDC Class Config */
+#define CDC_IN_EP                             0x81U
+#define CDC_OUT_EP                            0x01U
+#define CDC_CMD_EP                            0x82U
+#define CDC2_IN_EP                            0x83U
+#define CDC2_OUT_EP                           0x03U
+#define CDC2_CMD_EP                           0x84U
+
+/* MSC Class Config */
+#define MSC_MEDIA_PACKET                      4096U
+#define MSC_EPIN_ADDR                         CDC_IN_EP
+#define MSC_EPOUT_ADDR                        CDC_OUT_EP
+
 /* Exported macro ------------------------------------------------------------ */
 /* Memory management macros */
 
-/* For footprint reasons and since only one allocation is handled in the HID
- * class driver, the malloc/free is changed into a static allocation method */
+/* For footprint reasons, the malloc/free is changed into a static allocation
+ * method with one slot per class of the composite device */
 
 void *USBD_static_malloc(uint32_t size);
 void USBD_static_free(void *p);
 
-#define MAX_STATIC_ALLOC_SIZE     sizeof(USBD_CDC_HandleTypeDef) /* HID Class Driver Structure size */
+/* Largest Class Driver Structure size */
+#define MAX_STATIC_ALLOC_SIZE     ((sizeof(USBD_MSC_BOT_HandleTypeDef) > sizeof(USBD_CDC_HandleTypeDef)) ? \
+                                   sizeof(USBD_MSC_BOT_HandleTypeDef) : sizeof(USBD_CDC_HandleTypeDef))
 
 #define USBD_malloc               USBD_static_malloc
 #define USBD_free                 USBD_static_free
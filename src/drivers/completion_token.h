@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_COMPLETION_TOKEN_H
+#define OV_COMPLETION_TOKEN_H
+
+#include "delegate.h"
+#include "semaphore.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Completion token of an asynchronous transfer
+ *        The token is owned by the caller and must remain valid until the end of the transfer,
+ *        its completion can be waited, polled or notified through a callback
+ */
+class completion_token
+{
+  public:
+    /** @brief Completion callback, the parameter indicates if the transfer succeeded (may be called from an interrupt) */
+    using callback = delegate<void, bool>;
+
+    /** @brief Token states */
+    enum class state : uint8_t
+    {
+        /** @brief No transfer has been submitted */
+        idle,
+        /** @brief Transfer is pending */
+        pending,
+        /** @brief Transfer succeeded */
+        success,
+        /** @brief Transfer failed or has been cancelled */
+        error
+    };
+
+    /** @brief Transfer parameters, reserved for the driver which processes the token */
+    struct request
+    {
+        /** @brief Transfer descriptor */
+        const void* desc;
+        /** @brief Current data buffer */
+        uint8_t* data;
+        /** @brief Number of bytes left */
+        size_t size;
+        /** @brief Driver specific parameter */
+        uint32_t param;
+    };
+
+    /** @brief Constructor */
+    completion_token();
+    /** @brief Constructor with a completion callback */
+    completion_token(const callback& on_completion);
+    /** @brief Copy constructor */
+    completion_token(const completion_token& copy) = delete;
+    /** @brief Move constructor */
+    completion_token(completion_token&& move) = delete;
+
+    /** @brief Copy operator */
+    completion_token& operator=(completion_token& copy) = delete;
+
+    /** @brief Set the completion callback */
+    void set_callback(const callback& on_completion) { m_callback = on_completion; }
+
+    /** @brief Get the state of the transfer */
+    state get_state() const { return m_state; }
+
+    /** @brief Indicate if the transfer is pending */
+    bool is_pending() const { return (m_state == state::pending); }
+
+    /** @brief Wait for the end of the transfer, return true if the transfer succeeded */
+    bool wait(uint32_t ms_timeout);
+
+    /** @brief Get the transfer parameters (driver side) */
+    request& get_request() { return m_request; }
+
+    /** @brief Mark the transfer as pending, fails if the token is already in use (driver side) */
+    bool start();
+
+    /** @brief Signal the end of the transfer, from a task or from an interrupt (driver side) */
+    void complete(bool success);
+
+  private:
+    /** @brief State of the transfer */
+    volatile state m_state;
+    /** @brief End of transfer semaphore */
+    semaphore m_done_sem;
+    /** @brief Completion callback */
+    callback m_callback;
+    /** @brief Transfer parameters */
+    request m_request;
+    /** @brief Next token in the driver's queue */
+    completion_token* m_next;
+
+    friend class completion_queue;
+};
+
+/**
+ * @brief Queue of the tokens submitted to a driver, in submission order
+ *        Accesses must be serialized by the driver (interrupts masked)
+ */
+class completion_queue
+{
+  public:
+    /** @brief Constructor */
+    completion_queue() : m_head(nullptr), m_tail(nullptr) { }
+
+    /** @brief Indicate if the queue is empty */
+    bool is_empty() const { return (m_head == nullptr); }
+
+    /** @brief Get the oldest token of the queue */
+    completion_token* front() const { return m_head; }
+
+    /** @brief Add a token at the end of the queue */
+    void push(completion_token& token)
+    {
+        token.m_next = nullptr;
+        if (m_tail != nullptr)
+        {
+            m_tail->m_next = &token;
+        }
+        else
+        {
+            m_head = &token;
+        }
+        m_tail = &token;
+    }
+
+    /** @brief Remove the oldest token of the queue */
+    completion_token* pop()
+    {
+        completion_token* token = m_head;
+        if (token != nullptr)
+        {
+            m_head = token->m_next;
+            if (m_head == nullptr)
+            {
+                m_tail = nullptr;
+            }
+            token->m_next = nullptr;
+        }
+        return token;
+    }
+
+    /** @brief Remove a token from the queue, return false if the token is not in the queue */
+    bool remove(completion_token& token)
+    {
+        bool              ret      = false;
+        completion_token* previous = nullptr;
+        completion_token* current  = m_head;
+        while ((current != nullptr) && !ret)
+        {
+            if (current == &token)
+            {
+                if (previous != nullptr)
+                {
+                    previous->m_next = current->m_next;
+                }
+                else
+                {
+                    m_head = current->m_next;
+                }
+                if (m_tail == current)
+                {
+                    m_tail = previous;
+                }
+                current->m_next = nullptr;
+                ret             = true;
+            }
+            else
+            {
+                previous = current;
+                current  = current->m_next;
+            }
+        }
+        return ret;
+    }
+
+  private:
+    /** @brief Oldest token */
+    completion_token* m_head;
+    /** @brief Newest token */
+    completion_token* m_tail;
+};
+
+} // namespace ov
+
+#endif // OV_COMPLETION_TOKEN_H
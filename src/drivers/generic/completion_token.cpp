@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "completion_token.h"
+#include "os.h"
+
+namespace ov
+{
+
+/** @brief Constructor */
+completion_token::completion_token() : m_state(state::idle), m_done_sem(0u, 1u), m_callback(), m_request(), m_next(nullptr) { }
+
+/** @brief Constructor with a completion callback */
+completion_token::completion_token(const callback& on_completion)
+    : m_state(state::idle), m_done_sem(0u, 1u), m_callback(on_completion), m_request(), m_next(nullptr)
+{
+}
+
+/** @brief Wait for the end of the transfer, return true if the transfer succeeded */
+bool completion_token::wait(uint32_t ms_timeout)
+{
+    // A signal may remain from a previous transfer which has not been waited
+    bool timeout = false;
+    while ((m_state == state::pending) && !timeout)
+    {
+        timeout = !m_done_sem.take(ms_timeout);
+    }
+    return (m_state == state::success);
+}
+
+/** @brief Mark the transfer as pending, fails if the token is already in use (driver side) */
+bool completion_token::start()
+{
+    bool ret = false;
+
+    if (m_state != state::pending)
+    {
+        m_request = {};
+        m_next    = nullptr;
+        m_state   = state::pending;
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+/** @brief Signal the end of the transfer, from a task or from an interrupt (driver side) */
+void completion_token::complete(bool success)
+{
+    // State is updated first so that the callback can resubmit the token
+    m_state = (success ? state::success : state::error);
+    if (!m_callback.is_null())
+    {
+        m_callback(static_cast<bool>(success));
+    }
+
+    // Wake up the waiting task
+    if (os::is_in_isr())
+    {
+        bool higher_priority_task_woken = false;
+        m_done_sem.release_from_isr(higher_priority_task_woken);
+        os::yield_from_isr(higher_priority_task_woken);
+    }
+    else
+    {
+        m_done_sem.release();
+    }
+}
+
+} // namespace ov
@@ -24,8 +24,21 @@ bool soft_i2c::init()
     return ret;
 }
 
+/** @brief Start an asynchronous transfer of a chain of descriptors (the transfer is done before returning) */
+bool soft_i2c::xfer_async(const uint8_t slave_address, const xfer_desc& xfer, completion_token& token)
+{
+    // Bit banging is done in the caller's context
+    bool ret = token.start();
+    if (ret)
+    {
+        token.complete(transfer(slave_address, xfer));
+    }
+
+    return ret;
+}
+
 /** @brief Transfer data through the I2C */
-bool soft_i2c::xfer(const uint8_t slave_address, const xfer_desc& xfer)
+bool soft_i2c::transfer(const uint8_t slave_address, const xfer_desc& xfer)
 {
     bool ret = false;
 
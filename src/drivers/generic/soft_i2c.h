@@ -26,8 +26,11 @@ class soft_i2c : public i_i2c
     /** @brief Initialize the driver */
     bool init();
 
-    /** @brief Transfer data through the I2C */
-    bool xfer(const uint8_t slave_address, const xfer_desc& xfer) override;
+    /** @brief Start an asynchronous transfer of a chain of descriptors (the transfer is done before returning) */
+    bool xfer_async(const uint8_t slave_address, const xfer_desc& xfer, completion_token& token) override;
+
+    /** @brief Cancel an asynchronous transfer which has not completed yet */
+    void cancel(completion_token&) override { }
 
   private:
     /** @brief SCL pin */
@@ -37,6 +40,8 @@ class soft_i2c : public i_i2c
     /** @brief Delay function */
     delay_func m_delay;
 
+    /** @brief Transfer data through the I2C */
+    bool transfer(const uint8_t slave_address, const xfer_desc& xfer);
     /** @brief Set the lines in idle state */
     bool set_idle();
     /** @brief Generate a start condition */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "xfer_queue.h"
+#include "critical_section.h"
+
+namespace ov
+{
+
+/** @brief Constructor */
+xfer_queue::xfer_queue(const start_func& start, const abort_func& abort)
+    : m_start(start), m_abort(abort), m_pending(), m_current(nullptr)
+{
+}
+
+/** @brief Submit a token whose request has been filled, it is started immediately if no transfer is in progress */
+void xfer_queue::submit(completion_token& token)
+{
+    completion_queue failed;
+
+    {
+        critical_section cs;
+        m_pending.push(token);
+        if (m_current == nullptr)
+        {
+            start_next(failed);
+        }
+    }
+
+    complete(failed, false);
+}
+
+/** @brief Cancel a token which is queued or in progress */
+void xfer_queue::cancel(completion_token& token)
+{
+    completion_queue failed;
+    bool             cancelled = false;
+
+    {
+        critical_section cs;
+        cancelled = m_pending.remove(token);
+        if (!cancelled && (m_current == &token))
+        {
+            // Abort the transfer in progress and start the next one
+            m_abort(token);
+            m_current = nullptr;
+            start_next(failed);
+            cancelled = true;
+        }
+    }
+
+    if (cancelled)
+    {
+        token.complete(false);
+    }
+    complete(failed, false);
+}
+
+/** @brief Signal the end of the transfer in progress and start the next one */
+void xfer_queue::end_of_xfer(bool success)
+{
+    completion_queue  failed;
+    completion_token* token = nullptr;
+
+    {
+        critical_section cs;
+        token     = m_current;
+        m_current = nullptr;
+        start_next(failed);
+    }
+
+    // The next transfer is already in progress when the callback of the previous one is invoked
+    if (token != nullptr)
+    {
+        token->complete(success);
+    }
+    complete(failed, false);
+}
+
+/** @brief Start the next pending transfers until one has been started, the failed ones are moved to a queue */
+void xfer_queue::start_next(completion_queue& failed)
+{
+    bool started = false;
+    while (!started && !m_pending.is_empty())
+    {
+        completion_token* token = m_pending.pop();
+        m_current               = token;
+        started                 = m_start(*token);
+        if (!started)
+        {
+            m_current = nullptr;
+            failed.push(*token);
+        }
+    }
+}
+
+/** @brief Complete all the tokens of a queue */
+void xfer_queue::complete(completion_queue& tokens, bool success)
+{
+    completion_token* token = tokens.pop();
+    while (token != nullptr)
+    {
+        token->complete(success);
+        token = tokens.pop();
+    }
+}
+
+} // namespace ov
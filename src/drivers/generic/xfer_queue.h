@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_XFER_QUEUE_H
+#define OV_XFER_QUEUE_H
+
+#include "completion_token.h"
+#include "delegate.h"
+
+namespace ov
+{
+
+/**
+ * @brief Queue of the asynchronous transfers of a driver which processes one transfer at a time
+ *        Transfers are started in submission order, the tokens are completed outside of the critical sections
+ *        so that their callbacks can submit new transfers
+ */
+class xfer_queue
+{
+  public:
+    /** @brief Start the transfer of a token, return false if it could not be started (called in a critical section) */
+    using start_func = delegate<bool, completion_token&>;
+    /** @brief Abort the transfer in progress of a token (called in a critical section) */
+    using abort_func = delegate<void, completion_token&>;
+
+    /** @brief Constructor */
+    xfer_queue(const start_func& start, const abort_func& abort);
+
+    /** @brief Submit a token whose request has been filled, it is started immediately if no transfer is in progress */
+    void submit(completion_token& token);
+
+    /** @brief Cancel a token which is queued or in progress */
+    void cancel(completion_token& token);
+
+    /** @brief Get the token of the transfer in progress */
+    completion_token* get_current() const { return m_current; }
+
+    /** @brief Signal the end of the transfer in progress and start the next one */
+    void end_of_xfer(bool success);
+
+  private:
+    /** @brief Start function */
+    start_func m_start;
+    /** @brief Abort function */
+    abort_func m_abort;
+    /** @brief Tokens waiting to be started */
+    completion_queue m_pending;
+    /** @brief Token of the transfer in progress */
+    completion_token* volatile m_current;
+
+    /** @brief Start the next pending transfers until one has been started, the failed ones are moved to a queue */
+    void start_next(completion_queue& failed);
+
+    /** @brief Complete all the tokens of a queue */
+    static void complete(completion_queue& tokens, bool success);
+};
+
+} // namespace ov
+
+#endif // OV_XFER_QUEUE_H
@@ -6,6 +6,8 @@
 #ifndef OV_I_I2C_H
 #define OV_I_I2C_H
 
+#include "completion_token.h"
+
 #include <cstddef>
 #include <cstdint>
 
@@ -49,8 +51,37 @@ class i_i2c
         const xfer_desc* next;
     };
 
+    /** @brief Maximum duration of a blocking transfer in milliseconds */
+    static constexpr uint32_t XFER_TIMEOUT = 100u;
+
+    /**
+     * @brief Start an asynchronous transfer of a chain of descriptors
+     *        The descriptors and the buffers must remain valid until the completion of the token
+     */
+    virtual bool xfer_async(const uint8_t slave_address, const xfer_desc& xfer, completion_token& token) = 0;
+
+    /** @brief Cancel an asynchronous transfer which has not completed yet */
+    virtual void cancel(completion_token& token) = 0;
+
     /** @brief Transfer data through the I2C */
-    virtual bool xfer(const uint8_t slave_address, const xfer_desc& xfer) = 0;
+    bool xfer(const uint8_t slave_address, const xfer_desc& xfer)
+    {
+        completion_token token;
+        bool             ret = xfer_async(slave_address, xfer, token);
+        return ret && wait(token);
+    }
+
+  private:
+    /** @brief Wait for the end of a blocking transfer */
+    bool wait(completion_token& token)
+    {
+        bool ret = token.wait(XFER_TIMEOUT);
+        if (token.is_pending())
+        {
+            cancel(token);
+        }
+        return ret;
+    }
 };
 
 } // namespace ov
@@ -6,6 +6,8 @@
 #ifndef OV_I_QSPI_H
 #define OV_I_QSPI_H
 
+#include "completion_token.h"
+
 #include <cstddef>
 #include <cstdint>
 
@@ -62,14 +64,54 @@ class i_qspi
         line_mode data_mode;
     };
 
+    /** @brief Maximum duration of a blocking command in milliseconds */
+    static constexpr uint32_t XFER_TIMEOUT = 5000u;
+
+    /**
+     * @brief Start an asynchronous QSPI read command
+     *        The command and the buffer must remain valid until the completion of the token
+     */
+    virtual bool read_async(const command& cmd, void* buffer, size_t size, completion_token& token) = 0;
+
+    /**
+     * @brief Start an asynchronous QSPI write command
+     *        The command and the buffer must remain valid until the completion of the token
+     */
+    virtual bool write_async(const command& cmd, const void* buffer, size_t size, completion_token& token) = 0;
+
+    /** @brief Cancel an asynchronous command which has not completed yet */
+    virtual void cancel(completion_token& token) = 0;
+
     /** @brief Execute a QSPI read command */
-    virtual bool read(const command& cmd, void* buffer, size_t size) = 0;
+    bool read(const command& cmd, void* buffer, size_t size)
+    {
+        completion_token token;
+        bool             ret = read_async(cmd, buffer, size, token);
+        return ret && wait(token);
+    }
 
     /** @brief Execute a QSPI write command */
-    virtual bool write(const command& cmd, const void* buffer, size_t size) = 0;
+    bool write(const command& cmd, const void* buffer, size_t size)
+    {
+        completion_token token;
+        bool             ret = write_async(cmd, buffer, size, token);
+        return ret && wait(token);
+    }
 
     /** @brief Poll a register state */
     virtual bool poll(uint8_t cmd, uint8_t mask, uint8_t value, uint32_t ms_timeout) = 0;
+
+  private:
+    /** @brief Wait for the end of a blocking command */
+    bool wait(completion_token& token)
+    {
+        bool ret = token.wait(XFER_TIMEOUT);
+        if (token.is_pending())
+        {
+            cancel(token);
+        }
+        return ret;
+    }
 };
 
 } // namespace ov
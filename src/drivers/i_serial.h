@@ -6,8 +6,11 @@
 #ifndef OV_I_SERIAL_H
 #define OV_I_SERIAL_H
 
+#include "completion_token.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace ov
 {
@@ -19,14 +22,81 @@ class i_serial
     /** @brief Destructor */
     virtual ~i_serial() { }
 
+    /** @brief Maximum duration of a blocking write in milliseconds */
+    static constexpr uint32_t WRITE_TIMEOUT = 1000u;
+
+    /**
+     * @brief Start an asynchronous read, the token completes when the requested number of bytes has been received
+     *        The buffer must remain valid until the completion of the token
+     */
+    virtual bool read_async(void* buffer, size_t size, completion_token& token) = 0;
+
+    /**
+     * @brief Start an asynchronous write
+     *        The buffer must remain valid until the completion of the token
+     */
+    virtual bool write_async(const void* buffer, size_t size, completion_token& token) = 0;
+
+    /** @brief Cancel an asynchronous read or write which has not completed yet */
+    virtual void cancel(completion_token& token) = 0;
+
     /** @brief Read data from the serial port */
-    virtual bool read(void* buffer, size_t size, uint32_t ms_timeout) = 0;
+    bool read(void* buffer, size_t size, uint32_t ms_timeout)
+    {
+        completion_token token;
+        bool             ret = read_async(buffer, size, token);
+        return ret && wait(token, ms_timeout);
+    }
 
     /** @brief Write data to the serial port */
-    virtual bool write(const void* buffer, size_t size) = 0;
+    bool write(const void* buffer, size_t size)
+    {
+        completion_token token;
+        bool             ret = write_async(buffer, size, token);
+        return ret && wait(token, WRITE_TIMEOUT);
+    }
 
     /** @brief Write a null-terminated string to the serial port */
-    virtual bool write(const char* str) = 0;
+    bool write(const char* str) { return write(str, strlen(str)); }
+
+    /** @brief Data segment of a scatter-gather write */
+    struct segment
+    {
+        /** @brief Data */
+        const void* data;
+        /** @brief Size in bytes */
+        size_t size;
+    };
+
+    /** @brief Write several segments to the serial port, they are all queued before waiting so that they are sent back to back */
+    template <size_t COUNT>
+    bool write(const segment (&segments)[COUNT])
+    {
+        completion_token tokens[COUNT];
+        size_t           started = 0u;
+        while ((started < COUNT) && write_async(segments[started].data, segments[started].size, tokens[started]))
+        {
+            started++;
+        }
+        bool ret = (started == COUNT);
+        for (size_t i = 0; i < started; i++)
+        {
+            ret = wait(tokens[i], WRITE_TIMEOUT) && ret;
+        }
+        return ret;
+    }
+
+  private:
+    /** @brief Wait for the end of a blocking transfer */
+    bool wait(completion_token& token, uint32_t ms_timeout)
+    {
+        bool ret = token.wait(ms_timeout);
+        if (token.is_pending())
+        {
+            cancel(token);
+        }
+        return ret;
+    }
 };
 
 } // namespace ov
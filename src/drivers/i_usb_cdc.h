@@ -32,6 +32,9 @@ class i_usb_cdc : public i_serial
         virtual void on_cdc_link_down() = 0;
     };
 
+    /** @brief Start the USB device as a CDC serial port */
+    virtual bool start() = 0;
+
     /** @brief Register a listener to USB CDC events */
     virtual void register_listener(i_listener& listener) = 0;
 
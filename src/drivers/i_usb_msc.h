@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_USB_MSC_H
+#define OV_I_USB_MSC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Interface for USB mass storage drivers implementations */
+class i_usb_msc
+{
+  public:
+    /** @brief Destructor */
+    virtual ~i_usb_msc() { }
+
+    /** @brief Size of a block in bytes */
+    static constexpr uint32_t BLOCK_SIZE = 512u;
+
+    /** @brief Read-only storage exposed to the USB host */
+    class i_storage
+    {
+      public:
+        /** @brief Destructor */
+        virtual ~i_storage() { }
+
+        /** @brief Get the number of blocks of the storage */
+        virtual uint32_t get_block_count() = 0;
+
+        /** @brief Read consecutive blocks, called from the USB driver's thread */
+        virtual bool read(uint32_t block, void* buffer, uint32_t count) = 0;
+    };
+
+    /** @brief Start the USB device as a mass storage device exposing a storage */
+    virtual bool start(i_storage& storage) = 0;
+
+    /** @brief Indicate if the USB host has configured the mass storage device */
+    virtual bool is_link_up() = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_USB_MSC_H
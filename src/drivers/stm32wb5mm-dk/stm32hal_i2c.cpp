@@ -4,8 +4,6 @@
  */
 
 #include "stm32hal_i2c.h"
-#include "os.h"
-#include "thread.h"
 
 namespace ov
 {
@@ -13,8 +11,15 @@ namespace ov
 /** @brief HAL I2C handles */
 static I2C_HandleTypeDef* s_i2cs[2u];
 
+/** @brief Interrupts used for the transfers : TXIE, RXIE, NACKIE, STOPIE, TCIE, ERRIE */
+static constexpr uint32_t I2C_XFER_IT_MASK = (1u << 1u) | (1u << 2u) | (1u << 4u) | (1u << 5u) | (1u << 6u) | (1u << 7u);
+
 /** @brief Constructor */
-stm32hal_i2c::stm32hal_i2c(I2C_TypeDef* instance) : m_i2c{}, m_xfer(nullptr), m_error(i_i2c::error::success)
+stm32hal_i2c::stm32hal_i2c(I2C_TypeDef* instance)
+    : m_i2c{},
+      m_xfers(xfer_queue::start_func::create<stm32hal_i2c, &stm32hal_i2c::start_xfer>(*this),
+              xfer_queue::abort_func::create<stm32hal_i2c, &stm32hal_i2c::abort_xfer>(*this)),
+      m_error(i_i2c::error::success)
 {
     // Save parameters
     m_i2c.Instance = instance;
@@ -77,140 +82,179 @@ bool stm32hal_i2c::init()
     return ret;
 }
 
-/** @brief Transfer data through the I2C */
-bool stm32hal_i2c::xfer(const uint8_t slave_address, const xfer_desc& xfer)
+/** @brief Start an asynchronous transfer of a chain of descriptors */
+bool stm32hal_i2c::xfer_async(const uint8_t slave_address, const xfer_desc& xfer, completion_token& token)
 {
-    I2C_TypeDef* const i2c = m_i2c.Instance;
-
-    // Wait bus free
-    while ((i2c->ISR & (1u << 15u)) != 0)
+    bool ret = token.start();
+    if (ret)
     {
+        completion_token::request& request = token.get_request();
+        request.desc                       = &xfer;
+        request.param                      = slave_address;
+        m_xfers.submit(token);
     }
 
-    // Transfer loop
-    m_xfer = &xfer;
-    do
+    return ret;
+}
+
+/** @brief Cancel an asynchronous transfer which has not completed yet */
+void stm32hal_i2c::cancel(completion_token& token)
+{
+    m_xfers.cancel(token);
+}
+
+/** @brief IRQ handler */
+void stm32hal_i2c::irq_handler()
+{
+    I2C_TypeDef* const      i2c   = m_i2c.Instance;
+    const uint32_t          isr   = i2c->ISR;
+    completion_token* const token = m_xfers.get_current();
+    if (token == nullptr)
     {
-        // Reset error flag
-        m_error  = i_i2c::error::success;
+        // Spurious interrupt
+        i2c->CR1 &= ~I2C_XFER_IT_MASK;
         i2c->ICR = 0xFFFFFFFFu;
-
-        // Configure transfer
-        uint32_t cr2_reg;
-        cr2_reg = (slave_address << 0u) | (m_xfer->size << 16u);
-        if (m_xfer->read)
+    }
+    else if ((isr & ((1u << 9u) | (1u << 8u) | (1u << 4u))) != 0)
+    {
+        // Check error
+        if ((isr & (1u << 9u)) != 0)
         {
-            cr2_reg |= (1u << 10u);
+            m_error = i_i2c::error::arbitration_lost;
         }
-        if (m_xfer->stop_cond && (m_xfer->size != 0))
+        else if ((isr & (1u << 8u)) != 0)
         {
-            cr2_reg |= (1u << 25u);
+            m_error = i_i2c::error::bus_error;
         }
         else
         {
-            cr2_reg |= (1u << 24u);
+            m_error = i_i2c::error::nack;
         }
 
-        // Start condition
-        cr2_reg |= (1u << 13u);
-        i2c->CR2 = cr2_reg;
+        // Abort DMA
+        i2c->CR1 &= ~((1u << 14u) | (1u << 15u));
 
-        // Enable error interrupts
-        i2c->CR1 |= ((1u << 4u) | (1u << 7u));
+        // Stop condition
+        i2c->CR2 |= (1u << 14u);
 
-        // Wait for end of transfer
-        uint8_t current_byte = 0;
-        if (m_xfer->read)
+        desc_completed(false);
+    }
+    else
+    {
+        completion_token::request& request = token->get_request();
+        if (((isr & (1u << 2u)) != 0) && (request.size != 0u))
         {
-            do
-            {
-                // Wait rx ready condition
-                while ((m_error == i_i2c::error::success) && ((i2c->ISR & (1u << 2u)) == 0))
-                {
-                }
-                if (m_error == i_i2c::error::success)
-                {
-                    m_xfer->data[current_byte] = i2c->RXDR;
-                    current_byte++;
-                }
-            } while ((m_error == i_i2c::error::success) && (current_byte != m_xfer->size));
-
-            // Wait end of transfer
-            while ((i2c->ISR & (1u << 6u)) != 0)
-            {
-            }
+            // Rx ready
+            *request.data = static_cast<uint8_t>(i2c->RXDR);
+            request.data++;
+            request.size--;
         }
-        else
+        else if (((isr & (1u << 1u)) != 0) && (request.size != 0u))
         {
-            do
-            {
-                // Wait tx ready condition
-                while ((m_error == i_i2c::error::success) && ((i2c->ISR & (1u << 1u)) == 0))
-                {
-                }
-                if (m_error == i_i2c::error::success)
-                {
-                    i2c->TXDR = m_xfer->data[current_byte];
-                    current_byte++;
-                }
-            } while ((m_error == i_i2c::error::success) && (current_byte != m_xfer->size));
+            // Tx ready
+            i2c->TXDR = *request.data;
+            request.data++;
+            request.size--;
         }
-
-        // Wait stop condition
-        if (m_xfer->stop_cond)
+        else if ((isr & (1u << 5u)) != 0)
         {
-            const uint32_t start_time = os::now();
-            while (((i2c->ISR & (1u << 5u)) == 0) && ((os::now() - start_time) <= 100u))
+            // Stop condition generated at the end of the transfer
+            desc_completed(true);
+        }
+        else if ((isr & ((1u << 6u) | (1u << 7u))) != 0)
+        {
+            // Transfer complete without stop condition
+            const xfer_desc* desc = static_cast<const xfer_desc*>(request.desc);
+            if (desc->stop_cond)
             {
+                i2c->CR2 |= (1u << 14u);
             }
+            desc_completed(true);
         }
+        else
+        {
+            m_error = i_i2c::error::other;
+            i2c->CR2 |= (1u << 14u);
+            desc_completed(false);
+        }
+    }
+}
 
-        // Disable error interrupts
-        i2c->CR1 &= ~((1u << 4u) | (1u << 7u));
-
-        // Reset error flag
-        i2c->ICR = 0xFFFFFFFFu;
-
-        // Next transfer
-        m_xfer = m_xfer->next;
-    } while ((m_xfer != nullptr) && (m_error == i_i2c::error::success));
+/** @brief Start the transfer of the current descriptor of a token */
+bool stm32hal_i2c::start_xfer(completion_token& token)
+{
+    I2C_TypeDef* const         i2c     = m_i2c.Instance;
+    completion_token::request& request = token.get_request();
+    const xfer_desc*           desc    = static_cast<const xfer_desc*>(request.desc);
 
-    // Clear control register
-    //i2c->CR2 = 0;
+    // Reset error flag
+    m_error  = i_i2c::error::success;
+    i2c->ICR = 0xFFFFFFFFu;
 
-    return (m_error == i_i2c::error::success);
-}
+    // Bytes to transfer
+    request.data = desc->data;
+    request.size = desc->size;
 
-/** @brief IRQ handler */
-void stm32hal_i2c::irq_handler()
-{
-    // Check error
-    I2C_TypeDef* const i2c = m_i2c.Instance;
-    if ((i2c->ISR & (1u << 9u)) != 0)
-    {
-        m_error = i_i2c::error::arbitration_lost;
-    }
-    else if ((i2c->ISR & (1u << 8u)) != 0)
+    // Configure transfer
+    uint32_t cr2_reg;
+    cr2_reg = (request.param << 0u) | (desc->size << 16u);
+    if (desc->read)
     {
-        m_error = i_i2c::error::bus_error;
+        cr2_reg |= (1u << 10u);
     }
-    else if ((i2c->ISR & (1u << 4u)) != 0)
+    if (desc->stop_cond && (desc->size != 0))
     {
-        m_error = i_i2c::error::nack;
+        cr2_reg |= (1u << 25u);
     }
     else
     {
-        m_error = i_i2c::error::other;
+        cr2_reg |= (1u << 24u);
     }
 
-    // Abort DMA
-    i2c->CR1 &= ~((1u << 14u) | (1u << 15u));
+    // Enable interrupts, the data are transferred by the IRQ handler
+    i2c->CR1 |= I2C_XFER_IT_MASK;
 
-    // Reset error flag
-    i2c->ICR = 0xFFFFFFFFu;
+    // Start condition
+    cr2_reg |= (1u << 13u);
+    i2c->CR2 = cr2_reg;
 
-    // Stop condition
+    return true;
+}
+
+/** @brief Abort the transfer in progress of a token */
+void stm32hal_i2c::abort_xfer(completion_token&)
+{
+    I2C_TypeDef* const i2c = m_i2c.Instance;
+
+    // Disable interrupts and release the bus
+    i2c->CR1 &= ~I2C_XFER_IT_MASK;
     i2c->CR2 |= (1u << 14u);
+    i2c->ICR = 0xFFFFFFFFu;
+}
+
+/** @brief End of the transfer of the current descriptor */
+void stm32hal_i2c::desc_completed(bool success)
+{
+    I2C_TypeDef* const         i2c     = m_i2c.Instance;
+    completion_token*          token   = m_xfers.get_current();
+    completion_token::request& request = token->get_request();
+    const xfer_desc*           desc    = static_cast<const xfer_desc*>(request.desc);
+
+    // Disable interrupts and reset flags
+    i2c->CR1 &= ~I2C_XFER_IT_MASK;
+    i2c->ICR = 0xFFFFFFFFu;
+
+    // Next transfer of the chain
+    bool chained = false;
+    if (success && (desc->next != nullptr))
+    {
+        request.desc = desc->next;
+        chained      = start_xfer(*token);
+    }
+    if (!chained)
+    {
+        m_xfers.end_of_xfer(success);
+    }
 }
 
 } // namespace ov
@@ -7,7 +7,7 @@
 #define OV_STM32HAL_I2C_H
 
 #include "i_i2c.h"
-#include "semaphore.h"
+#include "xfer_queue.h"
 
 #include "stm32wbxx_hal.h"
 #include "stm32wbxx_hal_i2c.h"
@@ -25,8 +25,11 @@ class stm32hal_i2c : public i_i2c
     /** @brief Initialize the driver */
     bool init();
 
-    /** @brief Transfer data through the I2C */
-    bool xfer(const uint8_t slave_address, const xfer_desc& xfer) override;
+    /** @brief Start an asynchronous transfer of a chain of descriptors */
+    bool xfer_async(const uint8_t slave_address, const xfer_desc& xfer, completion_token& token) override;
+
+    /** @brief Cancel an asynchronous transfer which has not completed yet */
+    void cancel(completion_token& token) override;
 
     /** @brief IRQ handler */
     void irq_handler();
@@ -35,11 +38,18 @@ class stm32hal_i2c : public i_i2c
     /** @brief HAL I2C handle */
     I2C_HandleTypeDef m_i2c;
 
-    /** @brief Current transfer */
-    const xfer_desc* m_xfer;
+    /** @brief Queued transfers */
+    xfer_queue m_xfers;
 
     /** @brief Current error status */
     volatile error m_error;
+
+    /** @brief Start the transfer of the current descriptor of a token */
+    bool start_xfer(completion_token& token);
+    /** @brief Abort the transfer in progress of a token */
+    void abort_xfer(completion_token& token);
+    /** @brief End of the transfer of the current descriptor */
+    void desc_completed(bool success);
 };
 
 } // namespace ov
@@ -5,9 +5,7 @@
 
 #include "stm32hal_lpuart.h"
 
-#include "os.h"
-
-#include <cstring>
+#include "critical_section.h"
 
 namespace ov
 {
@@ -18,8 +16,9 @@ static UART_HandleTypeDef* s_lpuart;
 /** @brief Constructor */
 stm32hal_lpuart::stm32hal_lpuart()
     : m_lpuart{},
-      m_rx_sem(0u, 1u),
-      m_tx_sem(0u, 1u),
+      m_writes(xfer_queue::start_func::create<stm32hal_lpuart, &stm32hal_lpuart::start_write>(*this),
+               xfer_queue::abort_func::create<stm32hal_lpuart, &stm32hal_lpuart::abort_write>(*this)),
+      m_read(nullptr),
       m_rx_byte(0),
       m_rx_buffer(),
       m_rx_write_index(0u),
@@ -80,86 +79,137 @@ bool stm32hal_lpuart::init()
     return ret;
 }
 
-/** @brief Read data from the serial port */
-bool stm32hal_lpuart::read(void* buffer, size_t size, uint32_t ms_timeout)
+/** @brief Start an asynchronous read, only one read can be pending at a time */
+bool stm32hal_lpuart::read_async(void* buffer, size_t size, completion_token& token)
 {
-    bool ret = true;
+    bool ret       = false;
+    bool completed = false;
 
-    // Read loop
-    size_t   read_count = 0;
-    uint8_t* u8_buffer  = reinterpret_cast<uint8_t*>(buffer);
-    while (ret && (read_count != size))
     {
-        // Wait for incoming data
-        if (m_rx_bytes_count == 0u)
-        {
-            ret = m_rx_sem.take(ms_timeout);
-        }
-        if (ret)
+        critical_section cs;
+        if ((m_read == nullptr) && token.start())
         {
-            // Disable RX interrupts
-            ATOMIC_CLEAR_BIT(m_lpuart.Instance->CR1, USART_CR1_RXNEIE_RXFNEIE);
+            completion_token::request& request = token.get_request();
+            request.data                       = reinterpret_cast<uint8_t*>(buffer);
+            request.size                       = size;
 
-            // Read available bytes
-            while ((m_rx_bytes_count != 0u) && (read_count != size))
+            // Read the bytes already received, the missing ones will be received under interrupt
+            completed = read_rx_buffer(token);
+            if (!completed)
             {
-                *u8_buffer = m_rx_buffer[m_rx_read_index];
-                u8_buffer++;
-                m_rx_read_index++;
-                read_count++;
-                m_rx_bytes_count--;
-                if (m_rx_read_index == RX_BUFFER_SIZE)
-                {
-                    m_rx_read_index = 0;
-                }
+                m_read = &token;
             }
-
-            // Enable RX interrupts
-            ATOMIC_SET_BIT(m_lpuart.Instance->CR1, USART_CR1_RXNEIE_RXFNEIE);
+            ret = true;
         }
     }
+    if (completed)
+    {
+        token.complete(true);
+    }
 
     return ret;
 }
 
-/** @brief Write data to the serial port */
-bool stm32hal_lpuart::write(const void* buffer, size_t size)
+/** @brief Start an asynchronous write */
+bool stm32hal_lpuart::write_async(const void* buffer, size_t size, completion_token& token)
 {
+    bool ret = token.start();
+    if (ret)
+    {
+        if (size != 0)
+        {
+            completion_token::request& request = token.get_request();
+            request.data                       = reinterpret_cast<uint8_t*>(const_cast<void*>(buffer));
+            request.size                       = size;
+            m_writes.submit(token);
+        }
+        else
+        {
+            token.complete(true);
+        }
+    }
+
+    return ret;
+}
 
-    bool ret = true;
+/** @brief Cancel an asynchronous read or write which has not completed yet */
+void stm32hal_lpuart::cancel(completion_token& token)
+{
+    bool is_read = false;
 
-    // Start transmission using interrupts
-    if (size != 0)
     {
-        if (HAL_UART_Transmit_IT(&m_lpuart, reinterpret_cast<const uint8_t*>(buffer), static_cast<size_t>(size)) == HAL_OK)
+        critical_section cs;
+        if (m_read == &token)
         {
-            // Wait end of transmission
-            m_tx_sem.take();
-            ret = true;
+            m_read  = nullptr;
+            is_read = true;
         }
     }
+    if (is_read)
+    {
+        token.complete(false);
+    }
     else
     {
-        ret = true;
+        m_writes.cancel(token);
     }
+}
 
-    return ret;
+/** @brief Start the write of a token */
+bool stm32hal_lpuart::start_write(completion_token& token)
+{
+    const completion_token::request& request = token.get_request();
+    return (HAL_UART_Transmit_IT(&m_lpuart, request.data, static_cast<uint16_t>(request.size)) == HAL_OK);
+}
+
+/** @brief Abort the write in progress of a token */
+void stm32hal_lpuart::abort_write(completion_token&)
+{
+    HAL_UART_AbortTransmit(&m_lpuart);
 }
 
-/** @brief Write a null-terminated string to the serial port */
-bool stm32hal_lpuart::write(const char* str)
+/** @brief Copy the bytes of the rx buffer into the pending read, return true if the read is complete */
+bool stm32hal_lpuart::read_rx_buffer(completion_token& token)
 {
-    return write(str, strlen(str));
+    completion_token::request& request = token.get_request();
+    while ((m_rx_bytes_count != 0u) && (request.size != 0u))
+    {
+        *request.data = m_rx_buffer[m_rx_read_index];
+        request.data++;
+        request.size--;
+        m_rx_read_index++;
+        m_rx_bytes_count--;
+        if (m_rx_read_index == RX_BUFFER_SIZE)
+        {
+            m_rx_read_index = 0;
+        }
+    }
+
+    return (request.size == 0u);
 }
 
 /** @brief  Rx Transfer completed callback */
 void stm32hal_lpuart::rx_completed(UART_HandleTypeDef* handle)
 {
-    bool             higher_priority_task_woken = false;
-    stm32hal_lpuart* usart                      = reinterpret_cast<stm32hal_lpuart*>(handle->user);
+    stm32hal_lpuart* usart = reinterpret_cast<stm32hal_lpuart*>(handle->user);
 
     // Store received byte
-    if (usart->m_rx_bytes_count != stm32hal_lpuart::RX_BUFFER_SIZE)
+    completion_token* completed = nullptr;
+    completion_token* read      = usart->m_read;
+    if (read != nullptr)
+    {
+        // Directly into the pending read
+        completion_token::request& request = read->get_request();
+        *request.data                      = usart->m_rx_byte;
+        request.data++;
+        request.size--;
+        if (request.size == 0u)
+        {
+            usart->m_read = nullptr;
+            completed     = read;
+        }
+    }
+    else if (usart->m_rx_bytes_count != stm32hal_lpuart::RX_BUFFER_SIZE)
     {
         usart->m_rx_buffer[usart->m_rx_write_index] = usart->m_rx_byte;
         usart->m_rx_write_index++;
@@ -168,23 +218,23 @@ void stm32hal_lpuart::rx_completed(UART_HandleTypeDef* handle)
         {
             usart->m_rx_write_index = 0;
         }
-
-        // Notify reception
-        usart->m_rx_sem.release_from_isr(higher_priority_task_woken);
-        ov::os::yield_from_isr(higher_priority_task_woken);
     }
 
     // Restart reception
     HAL_UART_Receive_IT(&usart->m_lpuart, &usart->m_rx_byte, 1u);
+
+    // Notify reception
+    if (completed != nullptr)
+    {
+        completed->complete(true);
+    }
 }
 
 /** @brief  Tx completed callback */
 void stm32hal_lpuart::tx_completed(UART_HandleTypeDef* handle)
 {
-    bool             higher_priority_task_woken = false;
-    stm32hal_lpuart* usart                      = reinterpret_cast<stm32hal_lpuart*>(handle->user);
-    usart->m_tx_sem.release_from_isr(higher_priority_task_woken);
-    ov::os::yield_from_isr(higher_priority_task_woken);
+    stm32hal_lpuart* usart = reinterpret_cast<stm32hal_lpuart*>(handle->user);
+    usart->m_writes.end_of_xfer(true);
 }
 
 } // namespace ov
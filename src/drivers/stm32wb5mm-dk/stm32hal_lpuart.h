@@ -7,7 +7,7 @@
 #define OV_STM32HAL_LPUART_H
 
 #include "i_serial.h"
-#include "semaphore.h"
+#include "xfer_queue.h"
 
 #include "stm32wbxx_hal.h"
 #include "stm32wbxx_hal_uart.h"
@@ -25,14 +25,14 @@ class stm32hal_lpuart : public i_serial
     /** @brief Initialize the driver */
     bool init();
 
-    /** @brief Read data from the serial port */
-    bool read(void* buffer, size_t size, uint32_t ms_timeout) override;
+    /** @brief Start an asynchronous read, only one read can be pending at a time */
+    bool read_async(void* buffer, size_t size, completion_token& token) override;
 
-    /** @brief Write data to the serial port */
-    bool write(const void* buffer, size_t size) override;
+    /** @brief Start an asynchronous write */
+    bool write_async(const void* buffer, size_t size, completion_token& token) override;
 
-    /** @brief Write a null-terminated string to the serial port */
-    bool write(const char* str) override;
+    /** @brief Cancel an asynchronous read or write which has not completed yet */
+    void cancel(completion_token& token) override;
 
   private:
     /** @brief Size of the rx buffer in bytes */
@@ -40,10 +40,10 @@ class stm32hal_lpuart : public i_serial
 
     /** @brief HAL USART handle */
     UART_HandleTypeDef m_lpuart;
-    /** @brief Rx semaphore */
-    semaphore m_rx_sem;
-    /** @brief Tx semaphore */
-    semaphore m_tx_sem;
+    /** @brief Queued writes */
+    xfer_queue m_writes;
+    /** @brief Pending read */
+    completion_token* volatile m_read;
     /** @brief Rx byte */
     uint8_t m_rx_byte;
     /** @brief Rx buffer */
@@ -55,6 +55,13 @@ class stm32hal_lpuart : public i_serial
     /** @brief Number of bytes in the rx buffer */
     uint32_t m_rx_bytes_count;
 
+    /** @brief Start the write of a token */
+    bool start_write(completion_token& token);
+    /** @brief Abort the write in progress of a token */
+    void abort_write(completion_token& token);
+    /** @brief Copy the bytes of the rx buffer into the pending read, return true if the read is complete */
+    bool read_rx_buffer(completion_token& token);
+
     /** @brief  Rx completed callback */
     static void rx_completed(UART_HandleTypeDef* handle);
     /** @brief  Tx completed callback */
@@ -5,9 +5,6 @@
 
 #include "stm32hal_qspi.h"
 
-#include "os.h"
-#include "thread.h"
-
 namespace ov
 {
 
@@ -26,7 +23,11 @@ static QSPI_HandleTypeDef* s_qspi;
 static DMA_HandleTypeDef* s_hdma_qspi;
 
 /** @brief Constructor */
-stm32hal_qspi::stm32hal_qspi() : m_qspi{}, m_hdma_qspi{}, m_rx_sem(0u, 1u), m_tx_sem(0u, 1u)
+stm32hal_qspi::stm32hal_qspi()
+    : m_qspi{},
+      m_hdma_qspi{},
+      m_xfers(xfer_queue::start_func::create<stm32hal_qspi, &stm32hal_qspi::start_xfer>(*this),
+              xfer_queue::abort_func::create<stm32hal_qspi, &stm32hal_qspi::abort_xfer>(*this))
 {
     // Save instances
     m_qspi.user = this;
@@ -68,8 +69,10 @@ bool stm32hal_qspi::init()
         {
             // Register callbacks
             __HAL_LINKDMA(&m_qspi, hdma, m_hdma_qspi);
-            m_qspi.RxCpltCallback = &stm32hal_qspi::rx_completed;
-            m_qspi.TxCpltCallback = &stm32hal_qspi::tx_completed;
+            m_qspi.CmdCpltCallback = &stm32hal_qspi::cmd_completed;
+            m_qspi.RxCpltCallback  = &stm32hal_qspi::rx_completed;
+            m_qspi.TxCpltCallback  = &stm32hal_qspi::tx_completed;
+            m_qspi.ErrorCallback   = &stm32hal_qspi::error;
 
             // Enable interrupts
             HAL_NVIC_SetPriority(QUADSPI_IRQn, 15u, 0u);
@@ -83,53 +86,82 @@ bool stm32hal_qspi::init()
     return ret;
 }
 
-/** @brief Execute a QSPI read command */
-bool stm32hal_qspi::read(const command& cmd, void* buffer, size_t size)
+/** @brief Start an asynchronous QSPI read command */
+bool stm32hal_qspi::read_async(const command& cmd, void* buffer, size_t size, completion_token& token)
+{
+    return submit(cmd, buffer, size, false, token);
+}
+
+/** @brief Start an asynchronous QSPI write command */
+bool stm32hal_qspi::write_async(const command& cmd, const void* buffer, size_t size, completion_token& token)
+{
+    return submit(cmd, buffer, size, true, token);
+}
+
+/** @brief Cancel an asynchronous command which has not completed yet */
+void stm32hal_qspi::cancel(completion_token& token)
+{
+    m_xfers.cancel(token);
+}
+
+/** @brief Poll a register state */
+bool stm32hal_qspi::poll(uint8_t cmd, uint8_t mask, uint8_t value, uint32_t ms_timeout)
 {
     bool ret = false;
 
     QSPI_CommandTypeDef qspi_command = {};
 
-    qspi_command.Instruction        = static_cast<uint32_t>(cmd.cmd);
-    qspi_command.Address            = cmd.address;
-    qspi_command.AlternateBytes     = 0;
-    qspi_command.AddressSize        = STM32_ADDRESS_SIZES[static_cast<int>(cmd.addr_size)];
-    qspi_command.AlternateBytesSize = 0;
-    qspi_command.DummyCycles        = static_cast<uint32_t>(cmd.dummy_cycles);
-    qspi_command.InstructionMode    = QSPI_INSTRUCTION_1_LINE;
-    qspi_command.AddressMode        = STM32_ADDRESS_MODES[static_cast<int>(cmd.addr_mode)];
-    qspi_command.AlternateByteMode  = QSPI_ALTERNATE_BYTES_NONE;
-    qspi_command.DataMode           = STM32_DATA_MODES[static_cast<int>(cmd.data_mode)];
-    qspi_command.NbData             = static_cast<uint32_t>(size);
-    qspi_command.DdrMode            = QSPI_DDR_MODE_DISABLE;
-    qspi_command.SIOOMode           = QSPI_SIOO_INST_EVERY_CMD;
+    qspi_command.Instruction       = static_cast<uint32_t>(cmd);
+    qspi_command.DummyCycles       = 0;
+    qspi_command.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
+    qspi_command.AddressMode       = QSPI_ADDRESS_NONE;
+    qspi_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    qspi_command.DataMode          = QSPI_DATA_1_LINE;
+    qspi_command.DdrMode           = QSPI_DDR_MODE_DISABLE;
+    qspi_command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
 
-    // Send the command
-    if (HAL_QSPI_Command(&m_qspi, &qspi_command, HAL_QSPI_TIMEOUT_DEFAULT_VALUE) == HAL_OK)
+    QSPI_AutoPollingTypeDef qspi_polling;
+
+    qspi_polling.Match           = static_cast<uint32_t>(value);
+    qspi_polling.Mask            = static_cast<uint32_t>(mask);
+    qspi_polling.Interval        = 0x10u;
+    qspi_polling.StatusBytesSize = 1u;
+    qspi_polling.MatchMode       = QSPI_MATCH_MODE_AND;
+    qspi_polling.AutomaticStop   = QSPI_AUTOMATIC_STOP_ENABLE;
+
+    if (HAL_QSPI_AutoPolling(&m_qspi, &qspi_command, &qspi_polling, ms_timeout) == HAL_OK)
     {
-        // Read data
-        if (buffer && (size != 0u))
-        {
-            if (HAL_QSPI_Receive_DMA(&m_qspi, reinterpret_cast<uint8_t*>(buffer)) == HAL_OK)
-            {
-                // Wait for completion
-                ret = m_rx_sem.take(HAL_QSPI_TIMEOUT_DEFAULT_VALUE);
-            }
-        }
-        else
-        {
-            ret = true;
-        }
+        ret = true;
     }
 
     return ret;
 }
 
-/** @brief Execute a QSPI write command */
-bool stm32hal_qspi::write(const command& cmd, const void* buffer, size_t size)
+/** @brief Submit an asynchronous command */
+bool stm32hal_qspi::submit(const command& cmd, const void* buffer, size_t size, bool is_write, completion_token& token)
+{
+    bool ret = token.start();
+    if (ret)
+    {
+        completion_token::request& request = token.get_request();
+        request.desc                       = &cmd;
+        request.data                       = reinterpret_cast<uint8_t*>(const_cast<void*>(buffer));
+        request.size                       = (buffer ? size : 0u);
+        request.param                      = (is_write ? 1u : 0u);
+        m_xfers.submit(token);
+    }
+
+    return ret;
+}
+
+/** @brief Start the command of a token */
+bool stm32hal_qspi::start_xfer(completion_token& token)
 {
     bool ret = false;
 
+    const completion_token::request& request = token.get_request();
+    const command&                   cmd     = *static_cast<const command*>(request.desc);
+
     QSPI_CommandTypeDef qspi_command = {};
 
     qspi_command.Instruction        = static_cast<uint32_t>(cmd.cmd);
@@ -142,80 +174,68 @@ bool stm32hal_qspi::write(const command& cmd, const void* buffer, size_t size)
     qspi_command.AddressMode        = STM32_ADDRESS_MODES[static_cast<int>(cmd.addr_mode)];
     qspi_command.AlternateByteMode  = QSPI_ALTERNATE_BYTES_NONE;
     qspi_command.DataMode           = STM32_DATA_MODES[static_cast<int>(cmd.data_mode)];
-    qspi_command.NbData             = static_cast<uint32_t>(size);
+    qspi_command.NbData             = static_cast<uint32_t>(request.size);
     qspi_command.DdrMode            = QSPI_DDR_MODE_DISABLE;
     qspi_command.SIOOMode           = QSPI_SIOO_INST_EVERY_CMD;
+    if (request.size == 0u)
+    {
+        // Without data phase, the end of the command is signaled by the command completed callback
+        qspi_command.DataMode = QSPI_DATA_NONE;
+    }
 
     // Send the command
-    if (HAL_QSPI_Command(&m_qspi, &qspi_command, HAL_QSPI_TIMEOUT_DEFAULT_VALUE) == HAL_OK)
+    if (HAL_QSPI_Command_IT(&m_qspi, &qspi_command) == HAL_OK)
     {
-        // Write data
-        if (buffer && (size != 0u))
+        // Transfer data using DMA
+        if (request.size == 0u)
         {
-            if (HAL_QSPI_Transmit_DMA(&m_qspi, reinterpret_cast<uint8_t*>(const_cast<void*>(buffer))) == HAL_OK)
-            {
-                // Wait for completion
-                ret = m_tx_sem.take(HAL_QSPI_TIMEOUT_DEFAULT_VALUE);
-            }
+            ret = true;
+        }
+        else if (request.param != 0u)
+        {
+            ret = (HAL_QSPI_Transmit_DMA(&m_qspi, request.data) == HAL_OK);
         }
         else
         {
-            ret = true;
+            ret = (HAL_QSPI_Receive_DMA(&m_qspi, request.data) == HAL_OK);
         }
     }
 
     return ret;
 }
 
-/** @brief Poll a register state */
-bool stm32hal_qspi::poll(uint8_t cmd, uint8_t mask, uint8_t value, uint32_t ms_timeout)
+/** @brief Abort the command in progress of a token */
+void stm32hal_qspi::abort_xfer(completion_token&)
 {
-    bool ret = false;
-
-    QSPI_CommandTypeDef qspi_command = {};
-
-    qspi_command.Instruction       = static_cast<uint32_t>(cmd);
-    qspi_command.DummyCycles       = 0;
-    qspi_command.InstructionMode   = QSPI_INSTRUCTION_1_LINE;
-    qspi_command.AddressMode       = QSPI_ADDRESS_NONE;
-    qspi_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
-    qspi_command.DataMode          = QSPI_DATA_1_LINE;
-    qspi_command.DdrMode           = QSPI_DDR_MODE_DISABLE;
-    qspi_command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
-
-    QSPI_AutoPollingTypeDef qspi_polling;
-
-    qspi_polling.Match           = static_cast<uint32_t>(value);
-    qspi_polling.Mask            = static_cast<uint32_t>(mask);
-    qspi_polling.Interval        = 0x10u;
-    qspi_polling.StatusBytesSize = 1u;
-    qspi_polling.MatchMode       = QSPI_MATCH_MODE_AND;
-    qspi_polling.AutomaticStop   = QSPI_AUTOMATIC_STOP_ENABLE;
-
-    if (HAL_QSPI_AutoPolling(&m_qspi, &qspi_command, &qspi_polling, ms_timeout) == HAL_OK)
-    {
-        ret = true;
-    }
+    HAL_QSPI_Abort(&m_qspi);
+}
 
-    return ret;
+/** @brief  Command completed callback */
+void stm32hal_qspi::cmd_completed(QSPI_HandleTypeDef* handle)
+{
+    stm32hal_qspi* qspi = reinterpret_cast<stm32hal_qspi*>(handle->user);
+    qspi->m_xfers.end_of_xfer(true);
 }
 
 /** @brief  Rx Transfer completed callback */
 void stm32hal_qspi::rx_completed(QSPI_HandleTypeDef* handle)
 {
-    bool           higher_priority_task_woken = false;
-    stm32hal_qspi* qspi                       = reinterpret_cast<stm32hal_qspi*>(handle->user);
-    qspi->m_rx_sem.release_from_isr(higher_priority_task_woken);
-    ov::os::yield_from_isr(higher_priority_task_woken);
+    stm32hal_qspi* qspi = reinterpret_cast<stm32hal_qspi*>(handle->user);
+    qspi->m_xfers.end_of_xfer(true);
 }
 
 /** @brief  Tx completed callback */
 void stm32hal_qspi::tx_completed(QSPI_HandleTypeDef* handle)
 {
-    bool           higher_priority_task_woken = false;
-    stm32hal_qspi* qspi                       = reinterpret_cast<stm32hal_qspi*>(handle->user);
-    qspi->m_tx_sem.release_from_isr(higher_priority_task_woken);
-    ov::os::yield_from_isr(higher_priority_task_woken);
+    stm32hal_qspi* qspi = reinterpret_cast<stm32hal_qspi*>(handle->user);
+    qspi->m_xfers.end_of_xfer(true);
+}
+
+/** @brief  Error callback */
+void stm32hal_qspi::error(QSPI_HandleTypeDef* handle)
+{
+    stm32hal_qspi* qspi = reinterpret_cast<stm32hal_qspi*>(handle->user);
+    qspi->m_xfers.end_of_xfer(false);
 }
 
 } // namespace ov
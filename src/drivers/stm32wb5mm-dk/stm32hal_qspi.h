@@ -7,7 +7,7 @@
 #define OV_STM32HAL_QSPI_H
 
 #include "i_qspi.h"
-#include "semaphore.h"
+#include "xfer_queue.h"
 
 #include "stm32wbxx_hal.h"
 #include "stm32wbxx_hal_qspi.h"
@@ -25,11 +25,14 @@ class stm32hal_qspi : public i_qspi
     /** @brief Initialize the driver */
     bool init();
 
-    /** @brief Execute a QSPI read command */
-    bool read(const command& cmd, void* buffer, size_t size) override;
+    /** @brief Start an asynchronous QSPI read command */
+    bool read_async(const command& cmd, void* buffer, size_t size, completion_token& token) override;
 
-    /** @brief Execute a QSPI write command */
-    bool write(const command& cmd, const void* buffer, size_t size) override;
+    /** @brief Start an asynchronous QSPI write command */
+    bool write_async(const command& cmd, const void* buffer, size_t size, completion_token& token) override;
+
+    /** @brief Cancel an asynchronous command which has not completed yet */
+    void cancel(completion_token& token) override;
 
     /** @brief Poll a register state */
     bool poll(uint8_t cmd, uint8_t mask, uint8_t value, uint32_t ms_timeout) override;
@@ -39,15 +42,24 @@ class stm32hal_qspi : public i_qspi
     QSPI_HandleTypeDef m_qspi;
     /** @brief HAL DMA handle */
     DMA_HandleTypeDef m_hdma_qspi;
-    /** @brief Rx semaphore */
-    semaphore m_rx_sem;
-    /** @brief Tx semaphore */
-    semaphore m_tx_sem;
+    /** @brief Queued commands */
+    xfer_queue m_xfers;
+
+    /** @brief Submit an asynchronous command */
+    bool submit(const command& cmd, const void* buffer, size_t size, bool is_write, completion_token& token);
+    /** @brief Start the command of a token */
+    bool start_xfer(completion_token& token);
+    /** @brief Abort the command in progress of a token */
+    void abort_xfer(completion_token& token);
 
+    /** @brief  Command completed callback */
+    static void cmd_completed(QSPI_HandleTypeDef* handle);
     /** @brief  Rx completed callback */
     static void rx_completed(QSPI_HandleTypeDef* handle);
     /** @brief  Tx completed callback */
     static void tx_completed(QSPI_HandleTypeDef* handle);
+    /** @brief  Error callback */
+    static void error(QSPI_HandleTypeDef* handle);
 };
 
 } // namespace ov
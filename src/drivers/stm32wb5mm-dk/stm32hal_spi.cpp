@@ -4,7 +4,6 @@
  */
 
 #include "stm32hal_spi.h"
-#include "os.h"
 
 namespace ov
 {
@@ -20,7 +19,11 @@ static SPI_HandleTypeDef* s_spis[2u];
 
 /** @brief Constructor */
 stm32hal_spi::stm32hal_spi(SPI_TypeDef* instance, uint32_t baudrate, polarity pol, phase pha, i_cs_driver& cs_driver)
-    : m_cs_driver(cs_driver), m_spi{}, m_baudrate(baudrate), m_xfer_sem(0u, 1u)
+    : m_cs_driver(cs_driver),
+      m_spi{},
+      m_baudrate(baudrate),
+      m_xfers(xfer_queue::start_func::create<stm32hal_spi, &stm32hal_spi::start_xfer>(*this),
+              xfer_queue::abort_func::create<stm32hal_spi, &stm32hal_spi::abort_xfer>(*this))
 {
     // Save parameters
     m_spi.Instance         = instance;
@@ -64,8 +67,10 @@ bool stm32hal_spi::init()
     if (HAL_SPI_Init(&m_spi) == HAL_OK)
     {
         // Register callbacks
-        m_spi.RxCpltCallback = &stm32hal_spi::rx_completed;
-        m_spi.TxCpltCallback = &stm32hal_spi::tx_completed;
+        m_spi.RxCpltCallback   = &stm32hal_spi::rx_completed;
+        m_spi.TxCpltCallback   = &stm32hal_spi::tx_completed;
+        m_spi.TxRxCpltCallback = &stm32hal_spi::tx_rx_completed;
+        m_spi.ErrorCallback    = &stm32hal_spi::error;
 
         // Enable interrupts
         if (m_spi.Instance == SPI1)
@@ -85,49 +90,25 @@ bool stm32hal_spi::init()
     return ret;
 }
 
-/** @brief Transfer data through the SPI */
-bool stm32hal_spi::xfer(const xfer_desc& xfer)
+/** @brief Start an asynchronous transfer of a chain of descriptors */
+bool stm32hal_spi::xfer_async(const xfer_desc& xfer, completion_token& token)
 {
-    bool ret = false;
-
-    // Transfer loop
-    const xfer_desc* current_xfer = &xfer;
-    do
+    bool ret = token.start();
+    if (ret)
     {
-        // Enable peripheral selection
-        m_cs_driver.enable(current_xfer->cs);
-
-        // Execute transfer
-        HAL_StatusTypeDef err;
-        if (current_xfer->read_data && current_xfer->write_data)
-        {
-            err = HAL_SPI_TransmitReceive(
-                &m_spi, const_cast<uint8_t*>(current_xfer->write_data), current_xfer->read_data, current_xfer->size, 10000u);
-        }
-        else if (current_xfer->read_data)
-        {
-            err = HAL_SPI_Receive(&m_spi, current_xfer->read_data, current_xfer->size, 10000u);
-        }
-        else
-        {
-            err = HAL_SPI_Transmit(&m_spi, const_cast<uint8_t*>(current_xfer->write_data), current_xfer->size, 10000u);
-        }
-        ret = (err == HAL_OK);
-
-        // Release peripheral selection
-        if (!current_xfer->keep_cs_active)
-        {
-            m_cs_driver.disable(current_xfer->cs);
-        }
-
-        // Next transfer
-        current_xfer = current_xfer->next;
-
-    } while (current_xfer && ret);
+        token.get_request().desc = &xfer;
+        m_xfers.submit(token);
+    }
 
     return ret;
 }
 
+/** @brief Cancel an asynchronous transfer which has not completed yet */
+void stm32hal_spi::cancel(completion_token& token)
+{
+    m_xfers.cancel(token);
+}
+
 /** @brief Compute the prescaler value */
 uint32_t stm32hal_spi::compute_prescaler()
 {
@@ -169,26 +150,105 @@ uint32_t stm32hal_spi::compute_prescaler()
     return prescaler;
 }
 
+/** @brief Start the transfer of the current descriptor of a token */
+bool stm32hal_spi::start_xfer(completion_token& token)
+{
+    const xfer_desc* desc = static_cast<const xfer_desc*>(token.get_request().desc);
+
+    // Enable peripheral selection
+    m_cs_driver.enable(desc->cs);
+
+    // Start transfer using interrupts
+    HAL_StatusTypeDef err;
+    if (desc->read_data && desc->write_data)
+    {
+        err = HAL_SPI_TransmitReceive_IT(&m_spi, const_cast<uint8_t*>(desc->write_data), desc->read_data, desc->size);
+    }
+    else if (desc->read_data)
+    {
+        err = HAL_SPI_Receive_IT(&m_spi, desc->read_data, desc->size);
+    }
+    else
+    {
+        err = HAL_SPI_Transmit_IT(&m_spi, const_cast<uint8_t*>(desc->write_data), desc->size);
+    }
+    bool ret = (err == HAL_OK);
+    if (!ret)
+    {
+        // Release peripheral selection
+        m_cs_driver.disable(desc->cs);
+    }
+
+    return ret;
+}
+
+/** @brief Abort the transfer in progress of a token */
+void stm32hal_spi::abort_xfer(completion_token& token)
+{
+    const xfer_desc* desc = static_cast<const xfer_desc*>(token.get_request().desc);
+    HAL_SPI_Abort(&m_spi);
+    m_cs_driver.disable(desc->cs);
+}
+
+/** @brief End of the transfer of the current descriptor */
+void stm32hal_spi::desc_completed(bool success)
+{
+    completion_token* token = m_xfers.get_current();
+    if (token != nullptr)
+    {
+        completion_token::request& request = token->get_request();
+        const xfer_desc*           desc    = static_cast<const xfer_desc*>(request.desc);
+
+        // Release peripheral selection
+        if (!desc->keep_cs_active)
+        {
+            m_cs_driver.disable(desc->cs);
+        }
+
+        // Next transfer of the chain
+        bool chained = false;
+        if (success && (desc->next != nullptr))
+        {
+            request.desc = desc->next;
+            chained      = start_xfer(*token);
+            success      = chained;
+        }
+        if (!chained)
+        {
+            m_xfers.end_of_xfer(success);
+        }
+    }
+}
+
 /** @brief  Rx completed callback */
 void stm32hal_spi::rx_completed(SPI_HandleTypeDef* handle)
 {
-    bool          higher_priority_task_woken = false;
-    stm32hal_spi* spi                        = reinterpret_cast<stm32hal_spi*>(handle->user);
-    spi->m_xfer_sem.release_from_isr(higher_priority_task_woken);
-    ov::os::yield_from_isr(higher_priority_task_woken);
+    stm32hal_spi* spi = reinterpret_cast<stm32hal_spi*>(handle->user);
+    spi->desc_completed(true);
 }
 
 /** @brief  Tx completed callback */
 void stm32hal_spi::tx_completed(SPI_HandleTypeDef* handle)
 {
-    bool          higher_priority_task_woken = false;
-    stm32hal_spi* spi                        = reinterpret_cast<stm32hal_spi*>(handle->user);
-    spi->m_xfer_sem.release_from_isr(higher_priority_task_woken);
-    ov::os::yield_from_isr(higher_priority_task_woken);
+    stm32hal_spi* spi = reinterpret_cast<stm32hal_spi*>(handle->user);
+    spi->desc_completed(true);
 }
 
-} // namespace ov
+/** @brief  Tx/Rx completed callback */
+void stm32hal_spi::tx_rx_completed(SPI_HandleTypeDef* handle)
+{
+    stm32hal_spi* spi = reinterpret_cast<stm32hal_spi*>(handle->user);
+    spi->desc_completed(true);
+}
 
+/** @brief  Error callback */
+void stm32hal_spi::error(SPI_HandleTypeDef* handle)
+{
+    stm32hal_spi* spi = reinterpret_cast<stm32hal_spi*>(handle->user);
+    spi->desc_completed(false);
+}
+
+} // namespace ov
 /** @brief This function handles SPI1 global interrupt */
 extern "C" void SPI1_IRQHandler(void)
 {
@@ -7,7 +7,7 @@
 #define OV_STM32HAL_SPI_H
 
 #include "i_spi.h"
-#include "semaphore.h"
+#include "xfer_queue.h"
 
 #include "stm32wbxx_hal.h"
 #include "stm32wbxx_hal_spi.h"
@@ -25,8 +25,11 @@ class stm32hal_spi : public i_spi
     /** @brief Initialize the driver */
     bool init();
 
-    /** @brief Transfer data through the SPI */
-    bool xfer(const xfer_desc& xfer) override;
+    /** @brief Start an asynchronous transfer of a chain of descriptors */
+    bool xfer_async(const xfer_desc& xfer, completion_token& token) override;
+
+    /** @brief Cancel an asynchronous transfer which has not completed yet */
+    void cancel(completion_token& token) override;
 
   private:
     /** @brief Chip select driver */
@@ -35,16 +38,27 @@ class stm32hal_spi : public i_spi
     SPI_HandleTypeDef m_spi;
     /** @brief Baudrate */
     uint32_t m_baudrate;
-    /** @brief End of transfer semaphore */
-    semaphore m_xfer_sem;
+    /** @brief Queued transfers */
+    xfer_queue m_xfers;
 
     /** @brief Compute the prescaler value */
     uint32_t compute_prescaler();
 
+    /** @brief Start the transfer of the current descriptor of a token */
+    bool start_xfer(completion_token& token);
+    /** @brief Abort the transfer in progress of a token */
+    void abort_xfer(completion_token& token);
+    /** @brief End of the transfer of the current descriptor */
+    void desc_completed(bool success);
+
     /** @brief  Rx completed callback */
     static void rx_completed(SPI_HandleTypeDef* handle);
     /** @brief  Tx completed callback */
     static void tx_completed(SPI_HandleTypeDef* handle);
+    /** @brief  Tx/Rx completed callback */
+    static void tx_rx_completed(SPI_HandleTypeDef* handle);
+    /** @brief  Error callback */
+    static void error(SPI_HandleTypeDef* handle);
 };
 
 } // namespace ov
@@ -4,8 +4,9 @@
  */
 
 #include "stm32hal_usb_cdc.h"
-#include "os.h"
+#include "critical_section.h"
 #include "usbd_cdc.h"
+#include "usbd_composite.h"
 #include "usbd_conf.h"
 #include "usbd_core.h"
 #include "usbd_desc.h"
@@ -15,52 +16,60 @@
 namespace ov
 {
 
-/** @brief USB CDC driver instance */
-static stm32hal_usb_cdc* s_instance;
+/** @brief HAL USB handle shared by all the ports */
+static USBD_HandleTypeDef s_usb;
+/** @brief USB CDC driver instances */
+static stm32hal_usb_cdc* s_ports[stm32hal_usb_cdc::MAX_PORTS];
+/** @brief Indicate if the USB device has been started */
+static bool s_is_started = false;
 
 /** @brief Constructor */
-stm32hal_usb_cdc::stm32hal_usb_cdc()
-    : m_usb{},
+stm32hal_usb_cdc::stm32hal_usb_cdc(uint8_t port)
+    : m_port(port),
+      m_class_id(0xFFu),
       m_is_link_up(false),
-      m_rx_sem(0u, 1u),
-      m_tx_sem(1u, 1u),
+      m_writes(),
+      m_tx_count(0u),
+      m_read(nullptr),
       m_listener(nullptr),
       m_ll_rx_buffer(),
-      m_ll_tx_buffer(),
-      m_rx_buffer()
+      m_rx_buffer(),
+      m_tx_buffer()
 {
     // Save instance
-    s_instance = this;
+    if (m_port < MAX_PORTS)
+    {
+        s_ports[m_port] = this;
+    }
 }
 
-/** @brief Initialize the driver */
-bool stm32hal_usb_cdc::init()
+/** @brief Start the USB device with all its CDC ports, it is started only once */
+bool stm32hal_usb_cdc::start()
 {
-    bool ret = false;
-
-    /** @brief USB CDC interface callbacks */
-    static USBD_CDC_ItfTypeDef usbd_cdc_iface = {&stm32hal_usb_cdc::iface_init,
-                                                 &stm32hal_usb_cdc::iface_deinit,
-                                                 &stm32hal_usb_cdc::iface_control,
-                                                 &stm32hal_usb_cdc::iface_receive,
-                                                 &stm32hal_usb_cdc::iface_transmit_done};
-
-    // Initialize USB library (this will initialize all clocks and pinout)
-    USBD_StatusTypeDef usb_status = USBD_Init(&m_usb, &VCP_Desc, 0u);
-    if (usb_status == USBD_OK)
+    bool ret = s_is_started;
+    if (!ret)
     {
-        // Register USB CDC class
-        usb_status = USBD_RegisterClass(&m_usb, USBD_CDC_CLASS);
+        // Initialize USB library (this will initialize all clocks and pinout)
+        USBD_StatusTypeDef usb_status = USBD_Init(&s_usb, &VCP_Desc, 0u);
         if (usb_status == USBD_OK)
         {
-            // Register USB CDC interface callbacks
-            usb_status = static_cast<USBD_StatusTypeDef>(USBD_CDC_RegisterInterface(&m_usb, &usbd_cdc_iface));
-            if (usb_status == USBD_OK)
+            // Register a CDC class for each port, in port order
+            uint8_t instance = 0u;
+            ret              = true;
+            for (uint8_t port = 0u; ret && (port < MAX_PORTS); port++)
+            {
+                if (s_ports[port] != nullptr)
+                {
+                    ret = s_ports[port]->register_class(instance);
+                    instance++;
+                }
+            }
+            if (ret)
             {
                 // Start USB
-                usb_status = USBD_Start(&m_usb);
-
-                ret = (usb_status == USBD_OK);
+                usb_status   = USBD_Start(&s_usb);
+                ret          = (usb_status == USBD_OK);
+                s_is_started = ret;
             }
         }
     }
@@ -68,109 +77,208 @@ bool stm32hal_usb_cdc::init()
     return ret;
 }
 
-/** @brief Read data from the serial port */
-bool stm32hal_usb_cdc::read(void* buffer, size_t size, uint32_t ms_timeout)
+/** @brief Start an asynchronous read, only one read can be pending at a time */
+bool stm32hal_usb_cdc::read_async(void* buffer, size_t size, completion_token& token)
 {
-    bool ret = true;
+    bool ret       = false;
+    bool completed = false;
 
-    // Read loop
-    size_t   left    = size;
-    uint8_t* rx_data = reinterpret_cast<uint8_t*>(buffer);
-    while (ret && (left != 0u))
     {
-        // Disable interrupts
-        NVIC_DisableIRQ(USB_LP_IRQn);
-
-        // Read available data
-        while ((left != 0u) && m_rx_buffer.read(*rx_data))
+        critical_section cs;
+        if ((m_read == nullptr) && token.start())
         {
-            // Next data
-            rx_data++;
-            left--;
+            completion_token::request& request = token.get_request();
+            request.data                       = reinterpret_cast<uint8_t*>(buffer);
+            request.size                       = size;
+
+            // Read the bytes already received, the missing ones will be received under interrupt
+            completed = read_rx_buffer(token);
+            if (!completed)
+            {
+                m_read = &token;
+            }
+            ret = true;
         }
+    }
+    if (completed)
+    {
+        token.complete(true);
+    }
 
-        // Enable interrupts
-        NVIC_EnableIRQ(USB_LP_IRQn);
+    return ret;
+}
 
-        // Wait for more data
-        if (left != 0u)
+/**
+ * @brief Start an asynchronous write, it fails if the USB link is down
+ *        The write completes as soon as its data has been copied into the transmit ring
+ */
+bool stm32hal_usb_cdc::write_async(const void* buffer, size_t size, completion_token& token)
+{
+    bool ret = token.start();
+    if (ret)
+    {
+        completion_token::request& request = token.get_request();
+        request.data                       = reinterpret_cast<uint8_t*>(const_cast<void*>(buffer));
+        request.size                       = size;
+
+        bool completed = true;
+        bool success   = false;
+        {
+            critical_section cs;
+            if (m_is_link_up)
+            {
+                // Keep the submission order, the write waits for space if the ring is full
+                success = true;
+                if (!m_writes.is_empty() || !fill_tx_buffer(token))
+                {
+                    m_writes.push(token);
+                    completed = false;
+                }
+                start_tx();
+            }
+        }
+        if (completed)
         {
-            ret = m_rx_sem.take(ms_timeout);
+            token.complete(success);
         }
     }
 
     return ret;
 }
 
-/** @brief Write data to the serial port */
-bool stm32hal_usb_cdc::write(const void* buffer, size_t size)
+/** @brief Cancel an asynchronous read or write which has not completed yet */
+void stm32hal_usb_cdc::cancel(completion_token& token)
 {
-    bool ret = true;
+    bool cancelled = false;
 
-    // Write loop
-    size_t         left    = size;
-    const uint8_t* tx_data = reinterpret_cast<const uint8_t*>(buffer);
-    while (ret && (left != 0u))
     {
-        // Wait end of previous transmission
-        ret = m_tx_sem.take(100u);
-        if (ret)
+        critical_section cs;
+        if (m_read == &token)
         {
-            // Copy data into transmission buffer
-            size_t tx_count = left;
-            if (tx_count > sizeof(m_ll_tx_buffer))
-            {
-                tx_count = sizeof(m_ll_tx_buffer);
-            }
-            memcpy(m_ll_tx_buffer, tx_data, tx_count);
+            m_read    = nullptr;
+            cancelled = true;
+        }
+        else
+        {
+            // The bytes already copied into the transmit ring are still transmitted
+            cancelled = m_writes.remove(token);
+        }
+    }
+    if (cancelled)
+    {
+        token.complete(false);
+    }
+}
+
+/** @brief Copy the bytes of a write into the transmit ring, return true if all the bytes have been copied */
+bool stm32hal_usb_cdc::fill_tx_buffer(completion_token& token)
+{
+    completion_token::request& request = token.get_request();
+
+    size_t count = m_tx_buffer.write(request.data, request.size);
+    request.data += count;
+    request.size -= count;
+
+    return (request.size == 0u);
+}
+
+/** @brief Copy the waiting writes into the transmit ring, the completed ones are moved to a queue */
+void stm32hal_usb_cdc::fill_tx_buffer(completion_queue& completed)
+{
+    while (!m_writes.is_empty() && fill_tx_buffer(*m_writes.front()))
+    {
+        completed.push(*m_writes.pop());
+    }
+}
 
-            // Start transmission
-            USBD_CDC_SetTxBuffer(&m_usb, m_ll_tx_buffer, tx_count);
-            if (USBD_CDC_TransmitPacket(&m_usb) != USBD_OK)
+/** @brief Start the transmission of the transmit ring if no transfer is in progress */
+void stm32hal_usb_cdc::start_tx()
+{
+    if (m_tx_count == 0u)
+    {
+        // Transmit the contiguous bytes in place, the CDC class ends the transfer with a ZLP if needed
+        size_t         count = 0u;
+        const uint8_t* data  = m_tx_buffer.peek(count);
+        if (count != 0u)
+        {
+            USBD_CDC_SetTxBuffer(&s_usb, const_cast<uint8_t*>(data), count, m_class_id);
+            if (USBD_CDC_TransmitPacket(&s_usb, m_class_id) == USBD_OK)
             {
-                ret = false;
+                m_tx_count = count;
             }
-
-            // Next data
-            left -= tx_count;
-            tx_data += tx_count;
         }
     }
+}
+
+/** @brief Copy the bytes of the receive buffer into the pending read, return true if the read is complete */
+bool stm32hal_usb_cdc::read_rx_buffer(completion_token& token)
+{
+    completion_token::request& request = token.get_request();
+    while ((request.size != 0u) && m_rx_buffer.read(*request.data))
+    {
+        // Next data
+        request.data++;
+        request.size--;
+    }
+
+    return (request.size == 0u);
+}
+
+/** @brief Register the CDC class of the port into the composite USB device */
+bool stm32hal_usb_cdc::register_class(uint8_t instance)
+{
+    static_assert(MAX_PORTS == 2u, "Endpoints and callbacks are defined for 2 ports");
+
+    /** @brief Endpoints of each port (data IN, data OUT, command IN) */
+    static uint8_t endpoints[MAX_PORTS][3u] = {{CDC_IN_EP, CDC_OUT_EP, CDC_CMD_EP}, {CDC2_IN_EP, CDC2_OUT_EP, CDC2_CMD_EP}};
+    /** @brief USB CDC interface callbacks of each port */
+    static USBD_CDC_ItfTypeDef* ifaces[MAX_PORTS] = {get_iface<0u>(), get_iface<1u>()};
+
+    bool ret   = false;
+    m_class_id = USBD_COMPOSITE_AddClass(&s_usb, USBD_CDC_CLASS, CLASS_TYPE_CDC, endpoints[m_port], instance);
+    if (m_class_id != USBD_COMPOSITE_INVALID_CLASS_ID)
+    {
+        // Register USB CDC interface callbacks
+        USBD_StatusTypeDef usb_status = static_cast<USBD_StatusTypeDef>(USBD_CDC_RegisterInterface(&s_usb, ifaces[m_port]));
+        ret                           = (usb_status == USBD_OK);
+    }
 
     return ret;
 }
 
-/** @brief Write a null-terminated string to the serial port */
-bool stm32hal_usb_cdc::write(const char* str)
+/** @brief Get the USB CDC interface callbacks of a port */
+template <uint8_t PORT>
+USBD_CDC_ItfTypeDef* stm32hal_usb_cdc::get_iface()
 {
-    return write(str, strlen(str));
+    // The callbacks have no context, each port has its own set of callbacks
+    static USBD_CDC_ItfTypeDef usbd_cdc_iface = {
+        []() -> int8_t { return s_ports[PORT]->iface_init(); },
+        []() -> int8_t { return s_ports[PORT]->iface_deinit(); },
+        [](uint8_t cmd, uint8_t* buff, uint16_t length) -> int8_t { return s_ports[PORT]->iface_control(cmd, buff, length); },
+        [](uint8_t* buff, uint32_t* length) -> int8_t { return s_ports[PORT]->iface_receive(buff, length); },
+        [](uint8_t* buff, uint32_t* length, uint8_t epnum) -> int8_t { return s_ports[PORT]->iface_transmit_done(buff, length, epnum); }};
+    return &usbd_cdc_iface;
 }
 
 /** @brief Initializes the CDC media low layer */
 int8_t stm32hal_usb_cdc::iface_init()
 {
-    // Get instance
-    USBD_HandleTypeDef* usbd_handle = &s_instance->m_usb;
-
     // Set Application Buffers
-    USBD_CDC_SetTxBuffer(usbd_handle, s_instance->m_ll_tx_buffer, 0);
-    USBD_CDC_SetRxBuffer(usbd_handle, s_instance->m_ll_rx_buffer);
-
-    // Clear receive buffer
-    s_instance->m_rx_buffer.clear();
+    USBD_CDC_SetTxBuffer(&s_usb, nullptr, 0, m_class_id);
+    USBD_CDC_SetRxBuffer(&s_usb, m_ll_rx_buffer);
 
-    // Release TX semaphore
-    bool higher_priority_task_woken = false;
-    s_instance->m_tx_sem.release_from_isr(higher_priority_task_woken);
-    os::yield_from_isr(higher_priority_task_woken);
+    // Clear receive and transmit buffers
+    m_rx_buffer.clear();
+    m_tx_buffer.clear();
+    m_tx_count = 0u;
 
     // Update link status
-    s_instance->m_is_link_up = true;
+    m_is_link_up = true;
 
     // Notify listener
-    if (s_instance->m_listener != nullptr)
+    if (m_listener != nullptr)
     {
-        s_instance->m_listener->on_cdc_link_up();
+        m_listener->on_cdc_link_up();
     }
 
     return USBD_OK;
@@ -178,18 +286,31 @@ int8_t stm32hal_usb_cdc::iface_init()
 /** @brief DeInitializes the CDC media low layer */
 int8_t stm32hal_usb_cdc::iface_deinit()
 {
-    // Release TX semaphore
-    bool higher_priority_task_woken = false;
-    s_instance->m_tx_sem.release_from_isr(higher_priority_task_woken);
-    os::yield_from_isr(higher_priority_task_woken);
-
     // Update link status
-    s_instance->m_is_link_up = false;
+    m_is_link_up = false;
+
+    // Drop the bytes to transmit and fail the waiting writes
+    completion_queue failed;
+    {
+        critical_section cs;
+        m_tx_buffer.clear();
+        m_tx_count = 0u;
+        while (!m_writes.is_empty())
+        {
+            failed.push(*m_writes.pop());
+        }
+    }
+    completion_token* token = failed.pop();
+    while (token != nullptr)
+    {
+        token->complete(false);
+        token = failed.pop();
+    }
 
     // Notify listener
-    if (s_instance->m_listener != nullptr)
+    if (m_listener != nullptr)
     {
-        s_instance->m_listener->on_cdc_link_down();
+        m_listener->on_cdc_link_down();
     }
 
     return USBD_OK;
@@ -204,29 +325,42 @@ int8_t stm32hal_usb_cdc::iface_control(uint8_t, uint8_t*, uint16_t)
 /** @brief Data received over USB OUT endpoint are sent over CDC interface through this function */
 int8_t stm32hal_usb_cdc::iface_receive(uint8_t* buff, uint32_t* length)
 {
-    // Get instance
-    USBD_HandleTypeDef* usbd_handle = &s_instance->m_usb;
-
-    // Check if the receive buffer was empty to notify waiting task
-    bool was_empty = s_instance->m_rx_buffer.is_empty();
+    // Write data directly into the pending read
+    completion_token* completed = nullptr;
+    completion_token* read      = m_read;
+    uint32_t          left      = (*length);
+    if (read != nullptr)
+    {
+        completion_token::request& request = read->get_request();
+        while ((left != 0u) && (request.size != 0u))
+        {
+            *request.data = *buff;
+            request.data++;
+            request.size--;
+            buff++;
+            left--;
+        }
+        if (request.size == 0u)
+        {
+            m_read    = nullptr;
+            completed = read;
+        }
+    }
 
-    // Write data into the receive buffer
-    uint32_t left = (*length);
-    while ((left != 0u) && (s_instance->m_rx_buffer.write(*buff)))
+    // Write remaining data into the receive buffer
+    while ((left != 0u) && (m_rx_buffer.write(*buff)))
     {
         buff++;
         left--;
     }
 
     // Initiate next USB packet transfer
-    USBD_CDC_ReceivePacket(usbd_handle);
+    USBD_CDC_ReceivePacket(&s_usb);
 
-    // Signal waiting tasks that data is available
-    if (was_empty && !s_instance->m_rx_buffer.is_empty())
+    // Signal waiting task that data is available
+    if (completed != nullptr)
     {
-        bool higher_priority_task_woken = false;
-        s_instance->m_rx_sem.release_from_isr(higher_priority_task_woken);
-        os::yield_from_isr(higher_priority_task_woken);
+        completed->complete(true);
     }
 
     return USBD_OK;
@@ -235,19 +369,25 @@ int8_t stm32hal_usb_cdc::iface_receive(uint8_t* buff, uint32_t* length)
 /** @brief Data has been transmitted over USB IN endpoint */
 int8_t stm32hal_usb_cdc::iface_transmit_done(uint8_t*, uint32_t*, uint8_t)
 {
-    // Notify end of transmission
-    bool higher_priority_task_woken = false;
-    s_instance->m_tx_sem.release_from_isr(higher_priority_task_woken);
-    os::yield_from_isr(higher_priority_task_woken);
+    // Release the transmitted bytes, copy the waiting writes into the freed space and transmit the next bytes
+    completion_queue completed;
+    {
+        critical_section cs;
+        m_tx_buffer.drop(m_tx_count);
+        m_tx_count = 0u;
+        fill_tx_buffer(completed);
+        start_tx();
+    }
+
+    // The next transfer is already in progress when the callbacks of the completed writes are invoked
+    completion_token* token = completed.pop();
+    while (token != nullptr)
+    {
+        token->complete(true);
+        token = completed.pop();
+    }
 
     return USBD_OK;
 }
 
 } // namespace ov
-
-/** @brief This function handles USB low priority interrupt */
-extern "C" void USB_LP_IRQHandler(void)
-{
-    extern PCD_HandleTypeDef s_hpcd;
-    HAL_PCD_IRQHandler(&s_hpcd);
-}
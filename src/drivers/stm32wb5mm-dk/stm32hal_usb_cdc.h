@@ -6,9 +6,9 @@
 #ifndef OV_STM32HAL_USB_CDC_H
 #define OV_STM32HAL_USB_CDC_H
 
+#include "completion_token.h"
 #include "i_usb_cdc.h"
 #include "ring_buffer.h"
-#include "semaphore.h"
 
 #include "stm32wbxx_hal.h"
 #include "stm32wbxx_hal_pcd.h"
@@ -17,15 +17,22 @@
 namespace ov
 {
 
-/** @brief USB CDC driver implementation using STM32HAL */
+/**
+ * @brief USB CDC driver implementation using STM32HAL
+ *        Each instance is a CDC ACM function of a composite USB device with its own endpoints and buffers
+ *        Writes are coalesced into a transmit ring which is transmitted in place, as large as possible transfers
+ */
 class stm32hal_usb_cdc : public i_usb_cdc
 {
   public:
+    /** @brief Maximum number of CDC ports of the USB device */
+    static constexpr uint8_t MAX_PORTS = 2u;
+
     /** @brief Constructor */
-    stm32hal_usb_cdc();
+    stm32hal_usb_cdc(uint8_t port);
 
-    /** @brief Initialize the driver */
-    bool init();
+    /** @brief Start the USB device with all its CDC ports, it is started only once */
+    bool start() override;
 
     /** @brief Register a listener to USB CDC events */
     void register_listener(i_listener& listener) override { m_listener = &listener; }
@@ -33,43 +40,65 @@ class stm32hal_usb_cdc : public i_usb_cdc
     /** @brief Indicate if the USB link is up */
     bool is_link_up() override { return m_is_link_up; }
 
-    /** @brief Read data from the serial port */
-    bool read(void* buffer, size_t size, uint32_t ms_timeout) override;
+    /** @brief Start an asynchronous read, only one read can be pending at a time */
+    bool read_async(void* buffer, size_t size, completion_token& token) override;
 
-    /** @brief Write data to the serial port */
-    bool write(const void* buffer, size_t size) override;
+    /**
+     * @brief Start an asynchronous write, it fails if the USB link is down
+     *        The write completes as soon as its data has been copied into the transmit ring
+     */
+    bool write_async(const void* buffer, size_t size, completion_token& token) override;
 
-    /** @brief Write a null-terminated string to the serial port */
-    bool write(const char* str) override;
+    /** @brief Cancel an asynchronous read or write which has not completed yet */
+    void cancel(completion_token& token) override;
 
   private:
-    /** @brief HAL USB handle */
-    USBD_HandleTypeDef m_usb;
+    /** @brief Index of the port */
+    uint8_t m_port;
+    /** @brief Class id of the port in the composite USB device */
+    uint8_t m_class_id;
     /** @brief Indicate if the USB CDC link is up */
     bool m_is_link_up;
-    /** @brief Rx semaphore */
-    semaphore m_rx_sem;
-    /** @brief Tx semaphore */
-    semaphore m_tx_sem;
+    /** @brief Writes waiting for space in the transmit ring */
+    completion_queue m_writes;
+    /** @brief Number of bytes of the transmit ring which are being transmitted */
+    volatile size_t m_tx_count;
+    /** @brief Pending read */
+    completion_token* volatile m_read;
     /** @brief Listener to USB CDC events */
     i_listener* m_listener;
     /** @brief  Low level USB receive buffer */
     uint8_t m_ll_rx_buffer[CDC_DATA_FS_IN_PACKET_SIZE];
-    /** @brief  Low level USB transmit buffer */
-    uint8_t m_ll_tx_buffer[CDC_DATA_FS_OUT_PACKET_SIZE];
     /** @brief Receive buffer */
     ring_buffer<uint8_t, 1024u> m_rx_buffer;
+    /** @brief Transmit ring */
+    ring_buffer<uint8_t, 1024u> m_tx_buffer;
+
+    /** @brief Copy the bytes of a write into the transmit ring, return true if all the bytes have been copied */
+    bool fill_tx_buffer(completion_token& token);
+    /** @brief Copy the waiting writes into the transmit ring, the completed ones are moved to a queue */
+    void fill_tx_buffer(completion_queue& completed);
+    /** @brief Start the transmission of the transmit ring if no transfer is in progress */
+    void start_tx();
+    /** @brief Copy the bytes of the receive buffer into the pending read, return true if the read is complete */
+    bool read_rx_buffer(completion_token& token);
+    /** @brief Register the CDC class of the port into the composite USB device */
+    bool register_class(uint8_t instance);
 
     /** @brief Initializes the CDC media low layer */
-    static int8_t iface_init();
+    int8_t iface_init();
     /** @brief DeInitializes the CDC media low layer */
-    static int8_t iface_deinit();
+    int8_t iface_deinit();
     /** @brief Manage the CDC class requests */
-    static int8_t iface_control(uint8_t cmd, uint8_t* buff, uint16_t length);
+    int8_t iface_control(uint8_t cmd, uint8_t* buff, uint16_t length);
     /** @brief Data received over USB OUT endpoint are sent over CDC interface through this function */
-    static int8_t iface_receive(uint8_t* buff, uint32_t* length);
+    int8_t iface_receive(uint8_t* buff, uint32_t* length);
     /** @brief Data has been transmitted over USB IN endpoint */
-    static int8_t iface_transmit_done(uint8_t* buff, uint32_t* length, uint8_t epnum);
+    int8_t iface_transmit_done(uint8_t* buff, uint32_t* length, uint8_t epnum);
+
+    /** @brief Get the USB CDC interface callbacks of a port */
+    template <uint8_t PORT>
+    static USBD_CDC_ItfTypeDef* get_iface();
 };
 
 } // namespace ov
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "stm32hal_usb_irq.h"
+
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_hal_pcd.h"
+
+/** @brief HAL PCD handle (defined in the USB device library configuration) */
+extern PCD_HandleTypeDef s_hpcd;
+
+namespace ov
+{
+namespace usb_irq
+{
+
+/** @brief Registered interrupt handler */
+static handler s_handler;
+
+/** @brief Register the interrupt handler, without handler the interrupts are processed in the interrupt context */
+void set_handler(const handler& irq_handler)
+{
+    s_handler = irq_handler;
+}
+
+/** @brief Process the pending interrupts of the USB peripheral */
+void process()
+{
+    HAL_PCD_IRQHandler(&s_hpcd);
+}
+
+/** @brief Enable the USB interrupt */
+void enable()
+{
+    NVIC_EnableIRQ(USB_LP_IRQn);
+}
+
+/** @brief Disable the USB interrupt */
+void disable()
+{
+    NVIC_DisableIRQ(USB_LP_IRQn);
+}
+
+} // namespace usb_irq
+} // namespace ov
+
+/** @brief This function handles USB low priority interrupt */
+extern "C" void USB_LP_IRQHandler(void)
+{
+    if (ov::usb_irq::s_handler.is_null())
+    {
+        ov::usb_irq::process();
+    }
+    else
+    {
+        ov::usb_irq::s_handler.invoke();
+    }
+}
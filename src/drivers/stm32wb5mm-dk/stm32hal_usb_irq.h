@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_STM32HAL_USB_IRQ_H
+#define OV_STM32HAL_USB_IRQ_H
+
+#include "delegate.h"
+
+namespace ov
+{
+
+/** @brief Dispatch of the USB interrupt to the USB device driver which has been started */
+namespace usb_irq
+{
+
+/** @brief Interrupt handler */
+using handler = delegate<void>;
+
+/** @brief Register the interrupt handler, without handler the interrupts are processed in the interrupt context */
+void set_handler(const handler& irq_handler);
+
+/** @brief Process the pending interrupts of the USB peripheral */
+void process();
+
+/** @brief Enable the USB interrupt */
+void enable();
+
+/** @brief Disable the USB interrupt */
+void disable();
+
+} // namespace usb_irq
+} // namespace ov
+
+#endif // OV_STM32HAL_USB_IRQ_H
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "stm32hal_usb_msc.h"
+#include "os.h"
+#include "stm32hal_usb_irq.h"
+#include "usbd_composite.h"
+#include "usbd_conf.h"
+#include "usbd_core.h"
+#include "usbd_desc.h"
+
+namespace ov
+{
+
+/** @brief USB mass storage driver instance */
+static stm32hal_usb_msc* s_instance;
+
+/** @brief Standard inquiry data of the storage */
+static int8_t s_inquiry_data[STANDARD_INQUIRY_DATA_LEN] = {
+    0x00,                                                                            // Direct access device
+    static_cast<int8_t>(0x80),                                                       // Removable medium
+    0x02,                                                                            // SPC-2 compliant
+    0x02,                                                                            // Response data format
+    (STANDARD_INQUIRY_DATA_LEN - 5),                                                 // Additional length
+    0x00,                                                                            // Flags
+    0x00,                                                                            // Flags
+    0x00,                                                                            // Flags
+    'O',  'p', 'e', 'n', 'V', 'a', 'r', 'i',                                         // Manufacturer : 8 bytes
+    'F',  'l', 'i', 'g', 'h', 't', 's', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', // Product : 16 bytes
+    '1',  '.', '0', '0'                                                              // Version : 4 bytes
+};
+
+/** @brief Constructor */
+stm32hal_usb_msc::stm32hal_usb_msc() : m_usb{}, m_storage(nullptr), m_irq_sem(0u, 1u), m_thread()
+{
+    // Save instance
+    s_instance = this;
+}
+
+/** @brief Start the USB device as a mass storage device exposing a storage */
+bool stm32hal_usb_msc::start(i_storage& storage)
+{
+    bool ret = false;
+
+    /** @brief USB mass storage callbacks */
+    static USBD_StorageTypeDef usbd_msc_storage = {&stm32hal_usb_msc::storage_init,
+                                                   &stm32hal_usb_msc::storage_get_capacity,
+                                                   &stm32hal_usb_msc::storage_is_ready,
+                                                   &stm32hal_usb_msc::storage_is_write_protected,
+                                                   &stm32hal_usb_msc::storage_read,
+                                                   &stm32hal_usb_msc::storage_write,
+                                                   &stm32hal_usb_msc::storage_get_max_lun,
+                                                   s_inquiry_data};
+
+    // The USB thread must be running before the first interrupt
+    m_storage        = &storage;
+    auto thread_func = ov::thread_func::create<stm32hal_usb_msc, &stm32hal_usb_msc::thread_func>(*this);
+    if (m_thread.start(thread_func, "USB MSC", 8u, nullptr))
+    {
+        usb_irq::set_handler(usb_irq::handler::create<stm32hal_usb_msc, &stm32hal_usb_msc::irq_handler>(*this));
+
+        // Initialize USB library (this will initialize all clocks and pinout)
+        USBD_StatusTypeDef usb_status = USBD_Init(&m_usb, &MSC_Desc, 0u);
+        if (usb_status == USBD_OK)
+        {
+            // Register USB MSC class as the only function of the composite device
+            static uint8_t endpoints[] = {MSC_EPIN_ADDR, MSC_EPOUT_ADDR};
+            if (USBD_COMPOSITE_AddClass(&m_usb, USBD_MSC_CLASS, CLASS_TYPE_MSC, endpoints, 0u) != USBD_COMPOSITE_INVALID_CLASS_ID)
+            {
+                // Register storage callbacks
+                usb_status = static_cast<USBD_StatusTypeDef>(USBD_MSC_RegisterStorage(&m_usb, &usbd_msc_storage));
+                if (usb_status == USBD_OK)
+                {
+                    // Start USB
+                    usb_status = USBD_Start(&m_usb);
+
+                    ret = (usb_status == USBD_OK);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief USB interrupt handler, defers the processing to the USB thread */
+void stm32hal_usb_msc::irq_handler()
+{
+    // Keep the interrupt disabled until it has been processed
+    usb_irq::disable();
+
+    bool higher_priority_task_woken = false;
+    m_irq_sem.release_from_isr(higher_priority_task_woken);
+    os::yield_from_isr(higher_priority_task_woken);
+}
+
+/** @brief USB thread */
+void stm32hal_usb_msc::thread_func(void*)
+{
+    while (true)
+    {
+        // Wait for an interrupt
+        m_irq_sem.take();
+
+        // Process it, the storage is read from here
+        usb_irq::process();
+        usb_irq::enable();
+    }
+}
+
+/** @brief Initialize the storage */
+int8_t stm32hal_usb_msc::storage_init(uint8_t)
+{
+    return 0;
+}
+
+/** @brief Get the capacity of the storage */
+int8_t stm32hal_usb_msc::storage_get_capacity(uint8_t, uint32_t* block_num, uint16_t* block_size)
+{
+    *block_num  = s_instance->m_storage->get_block_count();
+    *block_size = static_cast<uint16_t>(BLOCK_SIZE);
+    return 0;
+}
+
+/** @brief Indicate if the storage is ready */
+int8_t stm32hal_usb_msc::storage_is_ready(uint8_t)
+{
+    return 0;
+}
+
+/** @brief Indicate if the storage is write protected */
+int8_t stm32hal_usb_msc::storage_is_write_protected(uint8_t)
+{
+    return 1;
+}
+
+/** @brief Read blocks from the storage */
+int8_t stm32hal_usb_msc::storage_read(uint8_t, uint8_t* buf, uint32_t blk_addr, uint16_t blk_len)
+{
+    bool ret = s_instance->m_storage->read(blk_addr, buf, blk_len);
+    return (ret ? 0 : -1);
+}
+
+/** @brief Write blocks to the storage */
+int8_t stm32hal_usb_msc::storage_write(uint8_t, uint8_t*, uint32_t, uint16_t)
+{
+    // Read-only storage
+    return -1;
+}
+
+/** @brief Get the highest logical unit number */
+int8_t stm32hal_usb_msc::storage_get_max_lun()
+{
+    return 0;
+}
+
+} // namespace ov
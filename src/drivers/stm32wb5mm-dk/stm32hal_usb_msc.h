@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_STM32HAL_USB_MSC_H
+#define OV_STM32HAL_USB_MSC_H
+
+#include "i_usb_msc.h"
+#include "semaphore.h"
+#include "thread.h"
+
+#include "stm32wbxx_hal.h"
+#include "stm32wbxx_hal_pcd.h"
+#include "usbd_msc.h"
+
+namespace ov
+{
+
+/**
+ * @brief USB mass storage driver implementation using STM32HAL
+ *        The USB interrupts are processed in a dedicated thread so that the storage can be read
+ *        with blocking calls while the host waits for the data
+ */
+class stm32hal_usb_msc : public i_usb_msc
+{
+  public:
+    /** @brief Constructor */
+    stm32hal_usb_msc();
+
+    /** @brief Start the USB device as a mass storage device exposing a storage */
+    bool start(i_storage& storage) override;
+
+    /** @brief Indicate if the USB host has configured the mass storage device */
+    bool is_link_up() override { return (m_usb.dev_state == USBD_STATE_CONFIGURED); }
+
+  private:
+    /** @brief HAL USB handle */
+    USBD_HandleTypeDef m_usb;
+    /** @brief Exposed storage */
+    i_storage* m_storage;
+    /** @brief Semaphore to signal a pending USB interrupt */
+    semaphore m_irq_sem;
+    /** @brief USB thread */
+    thread<4096u> m_thread;
+
+    /** @brief USB interrupt handler, defers the processing to the USB thread */
+    void irq_handler();
+
+    /** @brief USB thread */
+    void thread_func(void*);
+
+    /** @brief Initialize the storage */
+    static int8_t storage_init(uint8_t lun);
+    /** @brief Get the capacity of the storage */
+    static int8_t storage_get_capacity(uint8_t lun, uint32_t* block_num, uint16_t* block_size);
+    /** @brief Indicate if the storage is ready */
+    static int8_t storage_is_ready(uint8_t lun);
+    /** @brief Indicate if the storage is write protected */
+    static int8_t storage_is_write_protected(uint8_t lun);
+    /** @brief Read blocks from the storage */
+    static int8_t storage_read(uint8_t lun, uint8_t* buf, uint32_t blk_addr, uint16_t blk_len);
+    /** @brief Write blocks to the storage */
+    static int8_t storage_write(uint8_t lun, uint8_t* buf, uint32_t blk_addr, uint16_t blk_len);
+    /** @brief Get the highest logical unit number */
+    static int8_t storage_get_max_lun();
+};
+
+} // namespace ov
+
+#endif // OV_STM32HAL_USB_MSC_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_H
+#define OV_AIRSPACE_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Airspace classes */
+enum class airspace_class : uint8_t
+{
+    /** @brief Unknown class */
+    unknown,
+    /** @brief Class A */
+    a,
+    /** @brief Class B */
+    b,
+    /** @brief Class C */
+    c,
+    /** @brief Class D */
+    d,
+    /** @brief Class E */
+    e,
+    /** @brief Class F */
+    f,
+    /** @brief Class G */
+    g,
+    /** @brief Control zone */
+    ctr,
+    /** @brief Restricted area */
+    restricted,
+    /** @brief Danger area */
+    danger,
+    /** @brief Prohibited area */
+    prohibited,
+    /** @brief Prohibited for gliders */
+    glider_prohibited,
+    /** @brief Transponder mandatory zone */
+    tmz,
+    /** @brief Radio mandatory zone */
+    rmz,
+    /** @brief Wave window */
+    wave
+};
+
+/** @brief Reference of an airspace vertical limit */
+enum class airspace_altitude_ref : uint8_t
+{
+    /** @brief Above mean sea level (flight levels are converted to MSL) */
+    msl,
+    /** @brief Above ground level */
+    agl,
+    /** @brief Surface */
+    sfc,
+    /** @brief Unlimited */
+    unlimited
+};
+
+/** @brief Proximity status of the nearest airspace */
+struct airspace_status
+{
+    /** @brief Proximity levels */
+    enum class level : uint8_t
+    {
+        /** @brief No airspace nearby */
+        none,
+        /** @brief Airspace nearby */
+        near,
+        /** @brief Airspace very close */
+        warning,
+        /** @brief Inside an airspace */
+        inside
+    };
+
+    /** @brief Proximity level */
+    level proximity;
+    /** @brief Airspace class */
+    airspace_class cls;
+    /** @brief Airspace name */
+    char name[32u];
+    /** @brief Horizontal distance in meters (0 = inside the lateral limits) */
+    uint32_t horizontal_distance;
+    /** @brief Vertical distance in meters (0 = inside the vertical limits) */
+    uint32_t vertical_distance;
+    /** @brief Indicate if the status is valid */
+    bool is_valid;
+};
+
+/** @brief Get the short name of an airspace class */
+const char* airspace_class_name(airspace_class cls);
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_H
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_checker.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+airspace_checker::airspace_checker()
+    : m_state(state::idle),
+      m_cell{},
+      m_item(0u),
+      m_projection(),
+      m_altitude(0),
+      m_ground(0),
+      m_ground_is_valid(false),
+      m_record{},
+      m_vertex(0u),
+      m_first_x(0.f),
+      m_first_y(0.f),
+      m_prev_x(0.f),
+      m_prev_y(0.f),
+      m_inside(false),
+      m_min_distance2(0.f),
+      m_best{},
+      m_vertices{}
+{
+}
+
+/** @brief Restart the check from scratch */
+void airspace_checker::reset()
+{
+    m_state = state::idle;
+}
+
+/** @brief Continue the check */
+bool airspace_checker::update(
+    airspace_db& db, const geo::position& pos, int32_t altitude, const terrain_status& terrain, airspace_status& status)
+{
+    bool ret = false;
+
+    // Start a new scan if needed
+    if (m_state == state::idle)
+    {
+        start_scan(db, pos, altitude, terrain);
+    }
+
+    // Bounded amount of work
+    size_t work = MAX_WORK_PER_UPDATE;
+    while (!ret && (work != 0u))
+    {
+        if (m_state == state::next_airspace)
+        {
+            if (m_item < m_cell.item_count)
+            {
+                // Read next airspace
+                airspace_db::item airspace_index = 0u;
+                bool              is_valid       = db.read_item(m_cell, m_item, airspace_index);
+                is_valid                         = is_valid && db.read_record(airspace_index, m_record);
+                if (is_valid && is_candidate())
+                {
+                    m_vertex        = 0u;
+                    m_inside        = false;
+                    m_min_distance2 = static_cast<float>((NEAR_HORIZONTAL_DISTANCE + 1u) * (NEAR_HORIZONTAL_DISTANCE + 1u));
+                    m_state         = state::vertices;
+                }
+                m_item++;
+                work--;
+            }
+            else
+            {
+                // End of scan
+                status  = m_best;
+                m_state = state::idle;
+                ret     = true;
+            }
+        }
+        else
+        {
+            // Read a block of vertices
+            size_t count = m_record.vertex_count - m_vertex;
+            count        = (count > VERTEX_BUFFER_SIZE) ? VERTEX_BUFFER_SIZE : count;
+            count        = (count > work) ? work : count;
+            if (db.read_vertices(m_record.first_vertex + m_vertex, m_vertices, count))
+            {
+                // Process edges
+                for (size_t i = 0u; i < count; i++)
+                {
+                    float x = 0.f;
+                    float y = 0.f;
+                    m_projection.to_xy(m_vertices[i], x, y);
+                    if (m_vertex == 0u)
+                    {
+                        m_first_x = x;
+                        m_first_y = y;
+                    }
+                    else
+                    {
+                        process_edge(m_prev_x, m_prev_y, x, y);
+                    }
+                    m_prev_x = x;
+                    m_prev_y = y;
+                    m_vertex++;
+                }
+                work -= count;
+
+                // Close the polygon
+                if (m_vertex == m_record.vertex_count)
+                {
+                    process_edge(m_prev_x, m_prev_y, m_first_x, m_first_y);
+                    end_airspace();
+                    m_state = state::next_airspace;
+                }
+            }
+            else
+            {
+                // Skip airspace
+                m_state = state::next_airspace;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Start a new scan */
+void airspace_checker::start_scan(airspace_db& db, const geo::position& pos, int32_t altitude, const terrain_status& terrain)
+{
+    m_projection.set_reference(pos);
+    m_altitude        = altitude;
+    m_ground          = terrain.elevation;
+    m_ground_is_valid = terrain.is_valid;
+    m_item            = 0u;
+    if (!db.get_cell(pos, m_cell))
+    {
+        // Outside of the grid => no airspace
+        m_cell = {};
+    }
+
+    m_best           = {};
+    m_best.proximity = airspace_status::level::none;
+    m_best.is_valid  = true;
+    m_state          = state::next_airspace;
+}
+
+/** @brief Indicate if the current airspace may be near enough to process its vertices */
+bool airspace_checker::is_candidate() const
+{
+    bool ret = (get_vertical_distance() <= NEAR_VERTICAL_DISTANCE) && (m_record.vertex_count >= 3u);
+    if (ret)
+    {
+        // Distance to the bounding box
+        float min_x = 0.f;
+        float min_y = 0.f;
+        float max_x = 0.f;
+        float max_y = 0.f;
+        m_projection.to_xy(m_record.min, min_x, min_y);
+        m_projection.to_xy(m_record.max, max_x, max_y);
+        const float dx   = (min_x > 0.f) ? min_x : ((max_x < 0.f) ? -max_x : 0.f);
+        const float dy   = (min_y > 0.f) ? min_y : ((max_y < 0.f) ? -max_y : 0.f);
+        const float near = static_cast<float>(NEAR_HORIZONTAL_DISTANCE);
+        ret              = ((dx * dx + dy * dy) <= (near * near));
+    }
+    return ret;
+}
+
+/** @brief Process an edge of the current airspace */
+void airspace_checker::process_edge(float x1, float y1, float x2, float y2)
+{
+    // The position is the origin of the projection
+    // Ray casting toward the east for the point in polygon test
+    if ((y1 > 0.f) != (y2 > 0.f))
+    {
+        const float x = x1 - y1 * (x2 - x1) / (y2 - y1);
+        if (x > 0.f)
+        {
+            m_inside = !m_inside;
+        }
+    }
+
+    // Distance to the segment
+    const float dx   = x2 - x1;
+    const float dy   = y2 - y1;
+    const float len2 = dx * dx + dy * dy;
+    float       t    = 0.f;
+    if (len2 > 0.f)
+    {
+        t = -(x1 * dx + y1 * dy) / len2;
+        t = (t < 0.f) ? 0.f : ((t > 1.f) ? 1.f : t);
+    }
+    const float px        = x1 + t * dx;
+    const float py        = y1 + t * dy;
+    const float distance2 = px * px + py * py;
+    if (distance2 < m_min_distance2)
+    {
+        m_min_distance2 = distance2;
+    }
+}
+
+/** @brief Terminate the processing of the current airspace */
+void airspace_checker::end_airspace()
+{
+    // Compute distances
+    const uint32_t horizontal_distance = m_inside ? 0u : static_cast<uint32_t>(std::sqrt(m_min_distance2));
+    const uint32_t vertical_distance   = get_vertical_distance();
+    const auto     level               = get_level(horizontal_distance, vertical_distance);
+
+    // Keep the most relevant airspace
+    if ((level > m_best.proximity) ||
+        ((level == m_best.proximity) && (level != airspace_status::level::none) &&
+         ((horizontal_distance + vertical_distance) < (m_best.horizontal_distance + m_best.vertical_distance))))
+    {
+        m_best.proximity           = level;
+        m_best.cls                 = m_record.cls;
+        m_best.horizontal_distance = horizontal_distance;
+        m_best.vertical_distance   = vertical_distance;
+        memcpy(m_best.name, m_record.name, sizeof(m_best.name));
+        m_best.name[sizeof(m_best.name) - 1u] = 0;
+    }
+}
+
+/** @brief Compute the vertical distance to the current airspace (m) */
+uint32_t airspace_checker::get_vertical_distance() const
+{
+    // AGL limits are considered as MSL limits when the terrain elevation is unknown
+    int32_t floor = m_record.floor;
+    if (m_record.floor_ref == airspace_altitude_ref::sfc)
+    {
+        floor = INT32_MIN;
+    }
+    else if ((m_record.floor_ref == airspace_altitude_ref::agl) && m_ground_is_valid)
+    {
+        floor += m_ground;
+    }
+    int32_t ceiling = m_record.ceiling;
+    if (m_record.ceiling_ref == airspace_altitude_ref::unlimited)
+    {
+        ceiling = INT32_MAX;
+    }
+    else if ((m_record.ceiling_ref == airspace_altitude_ref::agl) && m_ground_is_valid)
+    {
+        ceiling += m_ground;
+    }
+
+    uint32_t distance = 0u;
+    if (m_altitude < floor)
+    {
+        distance = static_cast<uint32_t>(floor - m_altitude);
+    }
+    else if (m_altitude > ceiling)
+    {
+        distance = static_cast<uint32_t>(m_altitude - ceiling);
+    }
+    else
+    {
+        // Inside the vertical limits
+    }
+    return distance;
+}
+
+/** @brief Compute the proximity level corresponding to distances */
+airspace_status::level airspace_checker::get_level(uint32_t horizontal_distance, uint32_t vertical_distance)
+{
+    airspace_status::level level = airspace_status::level::none;
+    if ((horizontal_distance == 0u) && (vertical_distance == 0u))
+    {
+        level = airspace_status::level::inside;
+    }
+    else if ((horizontal_distance <= WARNING_HORIZONTAL_DISTANCE) && (vertical_distance <= WARNING_VERTICAL_DISTANCE))
+    {
+        level = airspace_status::level::warning;
+    }
+    else if ((horizontal_distance <= NEAR_HORIZONTAL_DISTANCE) && (vertical_distance <= NEAR_VERTICAL_DISTANCE))
+    {
+        level = airspace_status::level::near;
+    }
+    else
+    {
+        // Too far
+    }
+    return level;
+}
+
+} // namespace ov
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_CHECKER_H
+#define OV_AIRSPACE_CHECKER_H
+
+#include "airspace_db.h"
+#include "terrain.h"
+
+namespace ov
+{
+
+/**
+ * @brief Incremental airspace proximity checker
+ *        The airspaces of the grid cell containing the position are scanned over several updates,
+ *        each update reading at most MAX_WORK_PER_UPDATE records or vertices from the database.
+ *        The status is published at the end of each scan, it reflects the position at the start of the scan
+ *        so that an airspace entry is reported at most 2 scans late
+ */
+class airspace_checker
+{
+  public:
+    /** @brief Horizontal distance to report an airspace as near (m) */
+    static constexpr uint32_t NEAR_HORIZONTAL_DISTANCE = 3000u;
+    /** @brief Vertical distance to report an airspace as near (m) */
+    static constexpr uint32_t NEAR_VERTICAL_DISTANCE = 300u;
+    /** @brief Horizontal distance to report a warning (m) */
+    static constexpr uint32_t WARNING_HORIZONTAL_DISTANCE = 1000u;
+    /** @brief Vertical distance to report a warning (m) */
+    static constexpr uint32_t WARNING_VERTICAL_DISTANCE = 100u;
+    /**
+     * @brief Maximum number of records and vertices read on each update
+     *        The densest cell of a national database needs about 10000 reads, it is scanned in 4 updates
+     *        so that an entry is reported within 2s at the 250ms check period
+     */
+    static constexpr size_t MAX_WORK_PER_UPDATE = 2560u;
+    /** @brief Number of vertices read at once */
+    static constexpr size_t VERTEX_BUFFER_SIZE = 16u;
+
+    /** @brief Constructor */
+    airspace_checker();
+
+    /** @brief Restart the check from scratch */
+    void reset();
+
+    /**
+     * @brief Continue the check
+     * @param db Airspace database
+     * @param pos Current position
+     * @param altitude Current altitude (m)
+     * @param terrain Terrain below the current position, used to convert AGL limits
+     * @param status Status updated at the end of a scan
+     * @return true if a scan has completed and the status has been updated
+     */
+    bool update(airspace_db& db, const geo::position& pos, int32_t altitude, const terrain_status& terrain, airspace_status& status);
+
+  private:
+    /** @brief Scan states */
+    enum class state
+    {
+        /** @brief No scan in progress */
+        idle,
+        /** @brief Select the next airspace of the cell */
+        next_airspace,
+        /** @brief Process the vertices of the current airspace */
+        vertices
+    };
+
+    /** @brief Scan state */
+    state m_state;
+    /** @brief Grid cell being scanned */
+    airspace_db::cell m_cell;
+    /** @brief Index of the next item of the cell */
+    uint32_t m_item;
+    /** @brief Projection centered on the position at the start of the scan */
+    geo::flat_projection m_projection;
+    /** @brief Altitude at the start of the scan (m) */
+    int32_t m_altitude;
+    /** @brief Terrain elevation at the start of the scan (m) */
+    int32_t m_ground;
+    /** @brief Indicate if the terrain elevation is known */
+    bool m_ground_is_valid;
+    /** @brief Current airspace */
+    airspace_db::record m_record;
+    /** @brief Index of the next vertex of the current airspace */
+    uint32_t m_vertex;
+    /** @brief First vertex of the current airspace (m) */
+    float m_first_x;
+    /** @brief First vertex of the current airspace (m) */
+    float m_first_y;
+    /** @brief Previous vertex of the current airspace (m) */
+    float m_prev_x;
+    /** @brief Previous vertex of the current airspace (m) */
+    float m_prev_y;
+    /** @brief Indicate if the position is inside the current airspace polygon */
+    bool m_inside;
+    /** @brief Squared minimum distance to the edges of the current airspace (m²) */
+    float m_min_distance2;
+    /** @brief Most relevant airspace of the scan */
+    airspace_status m_best;
+    /** @brief Vertex buffer */
+    geo::position m_vertices[VERTEX_BUFFER_SIZE];
+
+    /** @brief Start a new scan */
+    void start_scan(airspace_db& db, const geo::position& pos, int32_t altitude, const terrain_status& terrain);
+
+    /** @brief Indicate if the current airspace may be near enough to process its vertices */
+    bool is_candidate() const;
+
+    /** @brief Process an edge of the current airspace */
+    void process_edge(float x1, float y1, float x2, float y2);
+
+    /** @brief Terminate the processing of the current airspace */
+    void end_airspace();
+
+    /** @brief Compute the vertical distance to the current airspace (m) */
+    uint32_t get_vertical_distance() const;
+
+    /** @brief Compute the proximity level corresponding to distances */
+    static airspace_status::level get_level(uint32_t horizontal_distance, uint32_t vertical_distance);
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_CHECKER_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_console.h"
+#include "airspace_db.h"
+#include "i_airspace_manager.h"
+#include "ov_data.h"
+
+#include <cstdio>
+
+namespace ov
+{
+
+/** @brief Constructor */
+airspace_console::airspace_console(i_debug_console& console, i_airspace_manager& airspaces)
+    : m_console(console),
+      m_airspaces(airspaces),
+      m_airimport_handler{"airimport",
+                          "Import an OpenAir file into the airspace database",
+                          ov::handler_func::create<airspace_console, &airspace_console::airimport_handler>(*this),
+                          nullptr,
+                          false},
+      m_airstatus_handler{"airstatus",
+                          "Display the airspace database status and the nearest airspace",
+                          ov::handler_func::create<airspace_console, &airspace_console::airstatus_handler>(*this),
+                          nullptr,
+                          false}
+{
+}
+
+/** @brief Register command handlers */
+void airspace_console::register_handlers()
+{
+    m_console.register_handler(m_airimport_handler);
+    m_console.register_handler(m_airstatus_handler);
+}
+
+/** @brief Handler for the 'airimport' command */
+void airspace_console::airimport_handler(const char* openair_path)
+{
+    const char* path = airspace_db::OPENAIR_FILE;
+    if (openair_path)
+    {
+        path = openair_path;
+    }
+
+    if (m_airspaces.import(path))
+    {
+        m_console.write_line("Import started");
+    }
+    else
+    {
+        m_console.write_line("Unable to start import");
+    }
+}
+
+/** @brief Handler for the 'airstatus' command */
+void airspace_console::airstatus_handler(const char*)
+{
+    // Database
+    char tmp[96u];
+    switch (m_airspaces.get_status())
+    {
+        case i_airspace_manager::status::ready:
+            snprintf(tmp, sizeof(tmp), "Database : %ld airspaces", static_cast<long>(m_airspaces.get_airspace_count()));
+            break;
+
+        case i_airspace_manager::status::importing:
+            snprintf(tmp, sizeof(tmp), "Database : import in progress");
+            break;
+
+        case i_airspace_manager::status::import_error:
+            snprintf(tmp, sizeof(tmp), "Database : import error");
+            break;
+
+        case i_airspace_manager::status::no_database:
+            [[fallthrough]];
+        default:
+            snprintf(tmp, sizeof(tmp), "Database : none");
+            break;
+    }
+    m_console.write_line(tmp);
+
+    // Nearest airspace
+    auto airspace = ov::data::get_airspace();
+    if (!airspace.is_valid)
+    {
+        m_console.write_line("Nearest : unavailable");
+    }
+    else if (airspace.proximity == airspace_status::level::none)
+    {
+        m_console.write_line("Nearest : none");
+    }
+    else
+    {
+        static const char* const s_levels[] = {"none", "near", "warning", "inside"};
+        snprintf(tmp,
+                 sizeof(tmp),
+                 "Nearest : %s [%s] %s, H=%ldm V=%ldm",
+                 airspace.name,
+                 airspace_class_name(airspace.cls),
+                 s_levels[static_cast<int>(airspace.proximity)],
+                 static_cast<long>(airspace.horizontal_distance),
+                 static_cast<long>(airspace.vertical_distance));
+        m_console.write_line(tmp);
+    }
+}
+
+} // namespace ov
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_CONSOLE_H
+#define OV_AIRSPACE_CONSOLE_H
+
+#include "i_debug_console.h"
+
+namespace ov
+{
+
+// Forward declarations
+class i_airspace_manager;
+
+/** @brief Console command helpers for the airspace manager */
+class airspace_console
+{
+  public:
+    /** @brief Constructor */
+    airspace_console(i_debug_console& console, i_airspace_manager& airspaces);
+
+    /** @brief Register command handlers */
+    void register_handlers();
+
+  private:
+    /** @brief Console */
+    i_debug_console& m_console;
+    /** @brief Airspace manager */
+    i_airspace_manager& m_airspaces;
+
+    /** @brief Handler for the 'airimport' command */
+    ov::i_debug_console::cmd_handler m_airimport_handler;
+    /** @brief Handler for the 'airstatus' command */
+    ov::i_debug_console::cmd_handler m_airstatus_handler;
+
+    /** @brief Handler for the 'airimport' command */
+    void airimport_handler(const char* openair_path);
+    /** @brief Handler for the 'airstatus' command */
+    void airstatus_handler(const char*);
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_CONSOLE_H
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_db.h"
+#include "fs.h"
+
+namespace ov
+{
+
+/** @brief Get the short name of an airspace class */
+const char* airspace_class_name(airspace_class cls)
+{
+    static const char* const s_names[] = {"?", "A", "B", "C", "D", "E", "F", "G", "CTR", "R", "Q", "P", "GP", "TMZ", "RMZ", "W"};
+
+    const char* name = s_names[0u];
+    if (static_cast<size_t>(cls) < (sizeof(s_names) / sizeof(s_names[0u])))
+    {
+        name = s_names[static_cast<size_t>(cls)];
+    }
+    return name;
+}
+
+/** @brief Constructor, opens the database */
+airspace_db::airspace_db()
+    : m_header{},
+      m_index(ov::fs::open(INDEX_FILE, ov::fs::o_rdonly)),
+      m_records(ov::fs::open(RECORDS_FILE, ov::fs::o_rdonly)),
+      m_vertices(ov::fs::open(VERTICES_FILE, ov::fs::o_rdonly))
+{
+    // Read header
+    if (is_open())
+    {
+        bool is_valid = m_index.read(m_header);
+        is_valid      = is_valid && (m_header.magic == header::MAGIC_NUMBER) && (m_header.version == header::VERSION);
+        is_valid      = is_valid && (m_header.grid_columns <= MAX_GRID_SIZE) && (m_header.grid_rows <= MAX_GRID_SIZE);
+        is_valid      = is_valid && (m_header.cell_size > 0);
+        if (!is_valid)
+        {
+            close();
+        }
+    }
+}
+
+/** @brief Close the database */
+void airspace_db::close()
+{
+    m_index.close();
+    m_records.close();
+    m_vertices.close();
+}
+
+/** @brief Get the grid cell containing a position, returns false outside of the grid */
+bool airspace_db::get_cell(const geo::position& pos, cell& c)
+{
+    bool ret = false;
+
+    // Compute cell coordinates
+    const int64_t column =
+        static_cast<int64_t>(geo::wrap_longitude(static_cast<int64_t>(pos.longitude) - m_header.grid_origin.longitude)) /
+        m_header.cell_size;
+    const int64_t row = (static_cast<int64_t>(pos.latitude) - m_header.grid_origin.latitude) / m_header.cell_size;
+    if ((pos.latitude >= m_header.grid_origin.latitude) && (row < m_header.grid_rows) && (column >= 0) &&
+        (column < m_header.grid_columns))
+    {
+        // Read cell
+        const uint32_t cell_index = static_cast<uint32_t>(row * m_header.grid_columns + column);
+        ret                       = read_at(m_index, sizeof(header) + cell_index * sizeof(cell), &c, sizeof(c));
+    }
+
+    return ret;
+}
+
+/** @brief Read an item of a grid cell */
+bool airspace_db::read_item(const cell& c, uint32_t index, item& airspace_index)
+{
+    bool ret = false;
+
+    if (index < c.item_count)
+    {
+        const uint32_t cells_size = static_cast<uint32_t>(m_header.grid_columns) * m_header.grid_rows * sizeof(cell);
+        const uint32_t offset     = sizeof(header) + cells_size + (c.first_item + index) * sizeof(item);
+        ret                       = read_at(m_index, offset, &airspace_index, sizeof(airspace_index));
+    }
+
+    return ret;
+}
+
+/** @brief Read an airspace record */
+bool airspace_db::read_record(uint32_t airspace_index, record& r)
+{
+    bool ret = false;
+
+    if (airspace_index < m_header.airspace_count)
+    {
+        ret = read_at(m_records, sizeof(uint32_t) + airspace_index * sizeof(record), &r, sizeof(r));
+    }
+
+    return ret;
+}
+
+/** @brief Read consecutive vertices */
+bool airspace_db::read_vertices(uint32_t first_vertex, geo::position* vertices, size_t count)
+{
+    bool ret = false;
+
+    if ((first_vertex + count) <= m_header.vertex_count)
+    {
+        ret = read_at(m_vertices, sizeof(uint32_t) + first_vertex * sizeof(geo::position), vertices, count * sizeof(geo::position));
+    }
+
+    return ret;
+}
+
+/** @brief Seek to an absolute position and read data */
+bool airspace_db::read_at(file& f, uint32_t offset, void* data, size_t size)
+{
+    int32_t new_offset = 0;
+    size_t  read_count = 0;
+    bool    ret        = f.seek(static_cast<int32_t>(offset), file::seek_set, new_offset);
+    ret                = ret && f.read(data, size, read_count);
+    return (ret && (read_count == size));
+}
+
+} // namespace ov
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_DB_H
+#define OV_AIRSPACE_DB_H
+
+#include "airspace.h"
+#include "file.h"
+#include "geodesy.h"
+
+namespace ov
+{
+
+/**
+ * @brief Read access to the airspace database
+ *        The database is split in 3 files to be written sequentially by the importer:
+ *        - index : header, grid cells and cell items (indexes of the airspaces overlapping each cell)
+ *        - records : fixed size airspace descriptions
+ *        - vertices : polygon vertices of all the airspaces
+ *        Nothing is cached in RAM except the header, every access is a seek + read
+ */
+class airspace_db
+{
+  public:
+    /** @brief Directory to store the airspace database */
+    static constexpr const char* AIRSPACE_DIR = "/airspaces";
+    /** @brief Index file */
+    static constexpr const char* INDEX_FILE = "/airspaces/airspaces.idx";
+    /** @brief Records file */
+    static constexpr const char* RECORDS_FILE = "/airspaces/airspaces.asp";
+    /** @brief Vertices file */
+    static constexpr const char* VERTICES_FILE = "/airspaces/airspaces.vtx";
+    /** @brief Default OpenAir file to import */
+    static constexpr const char* OPENAIR_FILE = "/airspaces/openair.txt";
+
+    /** @brief Index header */
+    struct header
+    {
+        /** @brief Magic number */
+        uint32_t magic;
+        /** @brief Format version */
+        uint32_t version;
+        /** @brief Number of airspaces */
+        uint32_t airspace_count;
+        /** @brief Number of vertices */
+        uint32_t vertex_count;
+        /** @brief Number of cell items */
+        uint32_t item_count;
+        /** @brief South west corner of the grid */
+        geo::position grid_origin;
+        /** @brief Size of a grid cell (1 = 1e-7°) */
+        int32_t cell_size;
+        /** @brief Number of columns of the grid */
+        uint16_t grid_columns;
+        /** @brief Number of rows of the grid */
+        uint16_t grid_rows;
+
+        /** @brief Magic number value */
+        static constexpr uint32_t MAGIC_NUMBER = 0xA125BACEu;
+        /** @brief Current format version */
+        static constexpr uint32_t VERSION = 1u;
+    };
+
+    /** @brief Airspace record */
+    struct record
+    {
+        /** @brief Name */
+        char name[32u];
+        /** @brief Class */
+        airspace_class cls;
+        /** @brief Floor reference */
+        airspace_altitude_ref floor_ref;
+        /** @brief Ceiling reference */
+        airspace_altitude_ref ceiling_ref;
+        /** @brief Padding */
+        uint8_t reserved;
+        /** @brief Floor in meters */
+        int32_t floor;
+        /** @brief Ceiling in meters */
+        int32_t ceiling;
+        /** @brief South west corner of the bounding box */
+        geo::position min;
+        /** @brief North east corner of the bounding box */
+        geo::position max;
+        /** @brief Index of the first vertex */
+        uint32_t first_vertex;
+        /** @brief Number of vertices */
+        uint32_t vertex_count;
+    };
+
+    /** @brief Grid cell */
+    struct cell
+    {
+        /** @brief Index of the first item */
+        uint32_t first_item;
+        /** @brief Number of items */
+        uint32_t item_count;
+    };
+
+    /** @brief Cell item = airspace index */
+    using item = uint16_t;
+
+    /** @brief Maximum number of airspaces */
+    static constexpr uint32_t MAX_AIRSPACES = 0xFFFFu;
+    /** @brief Maximum number of rows or columns of the grid */
+    static constexpr uint16_t MAX_GRID_SIZE = 32u;
+
+    /** @brief Constructor, opens the database */
+    airspace_db();
+
+    /** @brief Indicate if the database is valid */
+    bool is_open() const { return m_index.is_open() && m_records.is_open() && m_vertices.is_open(); }
+
+    /** @brief Close the database */
+    void close();
+
+    /** @brief Get the index header */
+    const header& get_header() const { return m_header; }
+
+    /** @brief Get the grid cell containing a position, returns false outside of the grid */
+    bool get_cell(const geo::position& pos, cell& c);
+
+    /** @brief Read an item of a grid cell */
+    bool read_item(const cell& c, uint32_t index, item& airspace_index);
+
+    /** @brief Read an airspace record */
+    bool read_record(uint32_t airspace_index, record& r);
+
+    /** @brief Read consecutive vertices */
+    bool read_vertices(uint32_t first_vertex, geo::position* vertices, size_t count);
+
+  private:
+    /** @brief Index header */
+    header m_header;
+    /** @brief Index file */
+    file m_index;
+    /** @brief Records file */
+    file m_records;
+    /** @brief Vertices file */
+    file m_vertices;
+
+    /** @brief Seek to an absolute position and read data */
+    static bool read_at(file& f, uint32_t offset, void* data, size_t size);
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_DB_H
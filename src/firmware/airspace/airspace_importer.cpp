@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_importer.h"
+#include "fs.h"
+#include "line_reader.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Temporary index file */
+static constexpr const char* INDEX_TMP_FILE = "/airspaces/airspaces.idx.tmp";
+/** @brief Temporary records file */
+static constexpr const char* RECORDS_TMP_FILE = "/airspaces/airspaces.asp.tmp";
+/** @brief Temporary vertices file */
+static constexpr const char* VERTICES_TMP_FILE = "/airspaces/airspaces.vtx.tmp";
+
+/** @brief Constructor */
+airspace_importer::airspace_importer()
+    : m_parser(),
+      m_records(nullptr),
+      m_vertices(nullptr),
+      m_record{},
+      m_header{},
+      m_min{},
+      m_max{},
+      m_cell_counts{},
+      m_items{}
+{
+}
+
+/** @brief Import an OpenAir file, the previous database is replaced on success */
+bool airspace_importer::import(const char* openair_path, uint32_t& airspace_count)
+{
+    // Create the database files
+    bool ret = parse(openair_path);
+    ret      = ret && build_index();
+    if (ret)
+    {
+        // Replace the database, the index is removed first so that
+        // a partially replaced database can never be opened
+        ov::fs::remove(airspace_db::INDEX_FILE);
+        ret            = ov::fs::rename(RECORDS_TMP_FILE, airspace_db::RECORDS_FILE);
+        ret            = ret && ov::fs::rename(VERTICES_TMP_FILE, airspace_db::VERTICES_FILE);
+        ret            = ret && ov::fs::rename(INDEX_TMP_FILE, airspace_db::INDEX_FILE);
+        airspace_count = m_header.airspace_count;
+    }
+    else
+    {
+        // Cleanup
+        ov::fs::remove(INDEX_TMP_FILE);
+        ov::fs::remove(RECORDS_TMP_FILE);
+        ov::fs::remove(VERTICES_TMP_FILE);
+        airspace_count = 0u;
+    }
+
+    return ret;
+}
+
+/** @brief Parse the OpenAir file into the temporary records and vertices files */
+bool airspace_importer::parse(const char* openair_path)
+{
+    // Open files
+    file source   = ov::fs::open(openair_path, ov::fs::o_rdonly);
+    file records  = ov::fs::open(RECORDS_TMP_FILE, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    file vertices = ov::fs::open(VERTICES_TMP_FILE, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    bool ret      = source.is_open() && records.is_open() && vertices.is_open();
+    if (ret)
+    {
+        // Initialize parsing
+        m_records        = &records;
+        m_vertices       = &vertices;
+        m_record         = {};
+        m_header         = {};
+        m_header.magic   = airspace_db::header::MAGIC_NUMBER;
+        m_header.version = airspace_db::header::VERSION;
+        m_min            = {INT32_MAX, INT32_MAX};
+        m_max            = {INT32_MIN, INT32_MIN};
+        ret              = records.write(m_header.magic) && vertices.write(m_header.magic);
+        m_parser.reset(openair_parser::vertex_handler::create<airspace_importer, &airspace_importer::on_vertex>(*this),
+                       openair_parser::airspace_handler::create<airspace_importer, &airspace_importer::on_airspace>(*this));
+
+        // Parse the source file line by line, too long lines are truncated
+        line_reader reader(source);
+        char        line[128u];
+        while (ret && reader.read_line(line, sizeof(line)))
+        {
+            ret = m_parser.parse_line(line);
+        }
+        ret = ret && m_parser.finish();
+        ret = ret && (m_header.airspace_count != 0u);
+
+        m_records  = nullptr;
+        m_vertices = nullptr;
+    }
+
+    // Flush files
+    ret = records.close() && ret;
+    ret = vertices.close() && ret;
+
+    return ret;
+}
+
+/** @brief Build the index from the temporary records file */
+bool airspace_importer::build_index()
+{
+    // Open files
+    file records = ov::fs::open(RECORDS_TMP_FILE, ov::fs::o_rdonly);
+    file index   = ov::fs::open(INDEX_TMP_FILE, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    bool ret     = records.is_open() && index.is_open();
+    if (ret)
+    {
+        // Compute grid
+        compute_grid();
+        const uint32_t columns    = m_header.grid_columns;
+        const uint32_t cell_count = columns * m_header.grid_rows;
+
+        // Count the items of each cell
+        uint32_t            magic = 0u;
+        airspace_db::record r;
+        memset(m_cell_counts, 0, sizeof(m_cell_counts));
+        ret = records.read(magic);
+        for (uint32_t i = 0u; ret && (i < m_header.airspace_count); i++)
+        {
+            ret = records.read(r);
+            if (ret)
+            {
+                const cell_range range = get_cell_range(r);
+                for (int32_t row = range.first_row; row <= range.last_row; row++)
+                {
+                    for (int32_t column = range.first_column; column <= range.last_column; column++)
+                    {
+                        m_cell_counts[static_cast<uint32_t>(row) * columns + static_cast<uint32_t>(column)]++;
+                    }
+                }
+            }
+        }
+
+        // Write header and cells
+        m_header.item_count = 0u;
+        for (uint32_t c = 0u; c < cell_count; c++)
+        {
+            m_header.item_count += m_cell_counts[c];
+        }
+        ret = ret && index.write(m_header);
+        airspace_db::cell cell{0u, 0u};
+        for (uint32_t c = 0u; ret && (c < cell_count); c++)
+        {
+            cell.item_count = m_cell_counts[c];
+            ret             = index.write(cell);
+            cell.first_item += cell.item_count;
+        }
+
+        // Write items by chunks of consecutive cells fitting in the items buffer
+        uint32_t first_cell = 0u;
+        while (ret && (first_cell < cell_count))
+        {
+            // Select cells and turn their counts into write cursors
+            uint32_t last_cell  = first_cell;
+            uint32_t chunk_size = 0u;
+            while ((last_cell < cell_count) && ((chunk_size + m_cell_counts[last_cell]) <= ITEMS_BUFFER_SIZE))
+            {
+                const uint32_t count     = m_cell_counts[last_cell];
+                m_cell_counts[last_cell] = chunk_size;
+                chunk_size += count;
+                last_cell++;
+            }
+            ret = (last_cell != first_cell);
+
+            // Fill the items buffer
+            int32_t new_offset = 0;
+            ret                = ret && records.seek(sizeof(magic), file::seek_set, new_offset);
+            for (uint32_t i = 0u; ret && (i < m_header.airspace_count); i++)
+            {
+                ret = records.read(r);
+                if (ret)
+                {
+                    const cell_range range = get_cell_range(r);
+                    for (int32_t row = range.first_row; row <= range.last_row; row++)
+                    {
+                        for (int32_t column = range.first_column; column <= range.last_column; column++)
+                        {
+                            const uint32_t c = static_cast<uint32_t>(row) * columns + static_cast<uint32_t>(column);
+                            if ((c >= first_cell) && (c < last_cell))
+                            {
+                                m_items[m_cell_counts[c]] = static_cast<airspace_db::item>(i);
+                                m_cell_counts[c]++;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Write items
+            size_t write_count = 0u;
+            ret                = ret && index.write(m_items, chunk_size * sizeof(airspace_db::item), write_count);
+            ret                = ret && (write_count == (chunk_size * sizeof(airspace_db::item)));
+
+            first_cell = last_cell;
+        }
+    }
+
+    // Flush index
+    ret = index.close() && ret;
+
+    return ret;
+}
+
+/** @brief Compute the grid dimensions */
+void airspace_importer::compute_grid()
+{
+    // Grid covers the bounding box of all the airspaces extended by the cell margin
+    const float   meters_to_units = 1.f / (geo::EARTH_RADIUS * geo::UNITS_TO_RAD);
+    const int32_t margin          = static_cast<int32_t>(CELL_MARGIN * meters_to_units);
+    const int64_t lat_span        = static_cast<int64_t>(m_max.latitude) - m_min.latitude + 2 * margin;
+    const int64_t lon_span        = static_cast<int64_t>(m_max.longitude) - m_min.longitude + 4 * margin;
+    const int64_t span            = (lat_span > lon_span) ? lat_span : lon_span;
+
+    int64_t cell_size = span / airspace_db::MAX_GRID_SIZE + 1;
+    if (cell_size < MIN_CELL_SIZE)
+    {
+        cell_size = MIN_CELL_SIZE;
+    }
+    m_header.cell_size             = static_cast<int32_t>(cell_size);
+    m_header.grid_origin.latitude  = m_min.latitude - margin;
+    m_header.grid_origin.longitude = geo::wrap_longitude(static_cast<int64_t>(m_min.longitude) - 2 * margin);
+    m_header.grid_rows             = static_cast<uint16_t>(lat_span / cell_size + 1);
+    m_header.grid_columns          = static_cast<uint16_t>(lon_span / cell_size + 1);
+    if (m_header.grid_rows > airspace_db::MAX_GRID_SIZE)
+    {
+        m_header.grid_rows = airspace_db::MAX_GRID_SIZE;
+    }
+    if (m_header.grid_columns > airspace_db::MAX_GRID_SIZE)
+    {
+        m_header.grid_columns = airspace_db::MAX_GRID_SIZE;
+    }
+}
+
+/** @brief Compute the range of grid cells covered by an airspace */
+airspace_importer::cell_range airspace_importer::get_cell_range(const airspace_db::record& r) const
+{
+    // Margins, the longitudinal one depends on the latitude
+    const float   meters_to_units = 1.f / (geo::EARTH_RADIUS * geo::UNITS_TO_RAD);
+    const int64_t lat_margin      = static_cast<int64_t>(CELL_MARGIN * meters_to_units);
+    const int32_t min_abs_lat     = std::abs(r.min.latitude);
+    const int32_t max_abs_lat     = std::abs(r.max.latitude);
+    const int32_t highest_lat     = (min_abs_lat > max_abs_lat) ? min_abs_lat : max_abs_lat;
+    float         cos_lat         = std::cos(static_cast<float>(highest_lat) * geo::UNITS_TO_RAD);
+    if (cos_lat < 0.1f)
+    {
+        cos_lat = 0.1f;
+    }
+    const int64_t lon_margin = static_cast<int64_t>(static_cast<float>(lat_margin) / cos_lat);
+
+    // Compute cells
+    const int64_t cell_size  = m_header.cell_size;
+    const int64_t origin_lat = m_header.grid_origin.latitude;
+    const int64_t origin_lon = m_header.grid_origin.longitude;
+    cell_range    range      = {static_cast<int32_t>((r.min.latitude - lat_margin - origin_lat) / cell_size),
+                                static_cast<int32_t>((r.max.latitude + lat_margin - origin_lat) / cell_size),
+                                static_cast<int32_t>((r.min.longitude - lon_margin - origin_lon) / cell_size),
+                                static_cast<int32_t>((r.max.longitude + lon_margin - origin_lon) / cell_size)};
+
+    // Clamp to the grid
+    const int32_t last_row    = static_cast<int32_t>(m_header.grid_rows) - 1;
+    const int32_t last_column = static_cast<int32_t>(m_header.grid_columns) - 1;
+    range.first_row           = (range.first_row < 0) ? 0 : ((range.first_row > last_row) ? last_row : range.first_row);
+    range.last_row            = (range.last_row < 0) ? 0 : ((range.last_row > last_row) ? last_row : range.last_row);
+    range.first_column        = (range.first_column < 0) ? 0 : ((range.first_column > last_column) ? last_column : range.first_column);
+    range.last_column         = (range.last_column < 0) ? 0 : ((range.last_column > last_column) ? last_column : range.last_column);
+
+    return range;
+}
+
+/** @brief Handle a vertex from the parser */
+bool airspace_importer::on_vertex(const geo::position& vertex)
+{
+    bool ret = m_vertices->write(vertex);
+    if (ret)
+    {
+        // Update bounding box
+        if (m_record.vertex_count == 0u)
+        {
+            m_record.first_vertex = m_header.vertex_count;
+            m_record.min          = vertex;
+            m_record.max          = vertex;
+        }
+        else
+        {
+            m_record.min.latitude  = (vertex.latitude < m_record.min.latitude) ? vertex.latitude : m_record.min.latitude;
+            m_record.min.longitude = (vertex.longitude < m_record.min.longitude) ? vertex.longitude : m_record.min.longitude;
+            m_record.max.latitude  = (vertex.latitude > m_record.max.latitude) ? vertex.latitude : m_record.max.latitude;
+            m_record.max.longitude = (vertex.longitude > m_record.max.longitude) ? vertex.longitude : m_record.max.longitude;
+        }
+        m_record.vertex_count++;
+        m_header.vertex_count++;
+    }
+    return ret;
+}
+
+/** @brief Handle the end of an airspace from the parser */
+bool airspace_importer::on_airspace(const openair_parser::airspace_desc& desc)
+{
+    bool ret = true;
+
+    // Only valid polygons are stored, the vertices of the other ones are left unused
+    if (m_record.vertex_count >= 3u)
+    {
+        ret = (m_header.airspace_count < airspace_db::MAX_AIRSPACES);
+        if (ret)
+        {
+            memcpy(m_record.name, desc.name, sizeof(m_record.name));
+            m_record.cls         = desc.cls;
+            m_record.floor_ref   = desc.floor_ref;
+            m_record.ceiling_ref = desc.ceiling_ref;
+            m_record.floor       = desc.floor;
+            m_record.ceiling     = desc.ceiling;
+            ret                  = m_records->write(m_record);
+        }
+        if (ret)
+        {
+            // Update global bounding box
+            m_min.latitude  = (m_record.min.latitude < m_min.latitude) ? m_record.min.latitude : m_min.latitude;
+            m_min.longitude = (m_record.min.longitude < m_min.longitude) ? m_record.min.longitude : m_min.longitude;
+            m_max.latitude  = (m_record.max.latitude > m_max.latitude) ? m_record.max.latitude : m_max.latitude;
+            m_max.longitude = (m_record.max.longitude > m_max.longitude) ? m_record.max.longitude : m_max.longitude;
+            m_header.airspace_count++;
+        }
+    }
+
+    // Next airspace
+    m_record = {};
+
+    return ret;
+}
+
+} // namespace ov
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_IMPORTER_H
+#define OV_AIRSPACE_IMPORTER_H
+
+#include "airspace_db.h"
+#include "openair_parser.h"
+
+namespace ov
+{
+
+/**
+ * @brief Import an OpenAir file into the airspace database
+ *        The source file is streamed line by line, records and vertices are written sequentially
+ *        and the grid index is built in several passes over the records so that the RAM usage
+ *        does not depend on the size of the source file
+ */
+class airspace_importer
+{
+  public:
+    /** @brief Margin added around each airspace when assigning it to grid cells (m) */
+    static constexpr float CELL_MARGIN = 5000.f;
+    /** @brief Minimum size of a grid cell (1 = 1e-7°) */
+    static constexpr int32_t MIN_CELL_SIZE = geo::UNITS_PER_DEGREE / 20;
+    /** @brief Size of the buffer used to build the cell items */
+    static constexpr size_t ITEMS_BUFFER_SIZE = 1024u;
+
+    /** @brief Constructor */
+    airspace_importer();
+
+    /** @brief Import an OpenAir file, the previous database is replaced on success */
+    bool import(const char* openair_path, uint32_t& airspace_count);
+
+  private:
+    /** @brief Range of grid cells covered by an airspace */
+    struct cell_range
+    {
+        /** @brief First row */
+        int32_t first_row;
+        /** @brief Last row */
+        int32_t last_row;
+        /** @brief First column */
+        int32_t first_column;
+        /** @brief Last column */
+        int32_t last_column;
+    };
+
+    /** @brief OpenAir parser */
+    openair_parser m_parser;
+    /** @brief Records file being written */
+    file* m_records;
+    /** @brief Vertices file being written */
+    file* m_vertices;
+    /** @brief Record of the current airspace */
+    airspace_db::record m_record;
+    /** @brief Index header */
+    airspace_db::header m_header;
+    /** @brief Bounding box of all the airspaces - south west */
+    geo::position m_min;
+    /** @brief Bounding box of all the airspaces - north east */
+    geo::position m_max;
+    /** @brief Number of items per cell, then write cursors */
+    uint32_t m_cell_counts[airspace_db::MAX_GRID_SIZE * airspace_db::MAX_GRID_SIZE];
+    /** @brief Cell items buffer */
+    airspace_db::item m_items[ITEMS_BUFFER_SIZE];
+
+    /** @brief Parse the OpenAir file into the temporary records and vertices files */
+    bool parse(const char* openair_path);
+
+    /** @brief Build the index from the temporary records file */
+    bool build_index();
+
+    /** @brief Compute the grid dimensions */
+    void compute_grid();
+
+    /** @brief Compute the range of grid cells covered by an airspace */
+    cell_range get_cell_range(const airspace_db::record& r) const;
+
+    /** @brief Handle a vertex from the parser */
+    bool on_vertex(const geo::position& vertex);
+
+    /** @brief Handle the end of an airspace from the parser */
+    bool on_airspace(const openair_parser::airspace_desc& desc);
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_IMPORTER_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_manager.h"
+#include "fs.h"
+#include "os.h"
+#include "ov_data.h"
+
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Period of the proximity checks in milliseconds */
+static const uint32_t CHECK_PERIOD_MS = 250u;
+
+/** @brief Constructor */
+airspace_manager::airspace_manager()
+    : m_status(status::no_database),
+      m_airspace_count(0u),
+      m_import_requested(false),
+      m_import_path{},
+      m_importer(),
+      m_checker(),
+      m_thread()
+{
+}
+
+/** @brief Initialize the airspace manager */
+bool airspace_manager::init()
+{
+    bool ret = true;
+
+    // Create the directory to store the airspace database
+    dir storage_dir = fs::open_dir(airspace_db::AIRSPACE_DIR);
+    if (!storage_dir.is_open())
+    {
+        ret = fs::mkdir(airspace_db::AIRSPACE_DIR);
+    }
+
+    if (ret)
+    {
+        // Start airspace thread
+        auto thread_func = ov::thread_func::create<airspace_manager, &airspace_manager::thread_func>(*this);
+        ret              = m_thread.start(thread_func, "Airspace", 2u, nullptr);
+    }
+
+    return ret;
+}
+
+/** @brief Import an OpenAir file into the database (asynchronous) */
+bool airspace_manager::import(const char* openair_path)
+{
+    bool ret = false;
+
+    // Check if an import is already in progress
+    if (!m_import_requested && (strlen(openair_path) < sizeof(m_import_path)))
+    {
+        strcpy(m_import_path, openair_path);
+        m_import_requested = true;
+        ret                = true;
+    }
+
+    return ret;
+}
+
+/** @brief Airspace thread */
+void airspace_manager::thread_func(void*)
+{
+    // Thread loop
+    while (true)
+    {
+        {
+            // Open the database
+            airspace_db db;
+            if (db.is_open())
+            {
+                m_airspace_count = db.get_header().airspace_count;
+                if (m_status != status::import_error)
+                {
+                    m_status = status::ready;
+                }
+            }
+            else
+            {
+                m_airspace_count = 0u;
+                if (m_status != status::import_error)
+                {
+                    m_status = status::no_database;
+                }
+            }
+            m_checker.reset();
+
+            // Check airspaces proximity until an import is requested
+            while (!m_import_requested)
+            {
+                ov_data data = ov::data::get();
+                if (db.is_open() && data.gnss.is_valid && data.altimeter.is_valid)
+                {
+                    airspace_status airspace;
+                    if (m_checker.update(db, data.gnss.get_position(), data.altimeter.altitude / 10, data.terrain, airspace))
+                    {
+                        ov::data::set_airspace(airspace);
+                    }
+                }
+                else
+                {
+                    m_checker.reset();
+                    ov::data::invalidate_airspace();
+                }
+
+                ov::this_thread::sleep_for(CHECK_PERIOD_MS);
+            }
+        }
+
+        // Import a new database
+        m_status = status::importing;
+        ov::data::invalidate_airspace();
+
+        uint32_t airspace_count = 0u;
+        if (m_importer.import(m_import_path, airspace_count))
+        {
+            m_status = status::ready;
+        }
+        else
+        {
+            m_status = status::import_error;
+        }
+        m_import_requested = false;
+    }
+}
+
+} // namespace ov
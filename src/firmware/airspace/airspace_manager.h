@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_MANAGER_H
+#define OV_AIRSPACE_MANAGER_H
+
+#include "airspace_checker.h"
+#include "airspace_importer.h"
+#include "i_airspace_manager.h"
+#include "thread.h"
+
+namespace ov
+{
+
+/** @brief Airspace manager */
+class airspace_manager : public i_airspace_manager
+{
+  public:
+    /** @brief Constructor */
+    airspace_manager();
+
+    /** @brief Initialize the airspace manager */
+    bool init();
+
+    /** @brief Import an OpenAir file into the database (asynchronous) */
+    bool import(const char* openair_path) override;
+
+    /** @brief Get the status of the database */
+    status get_status() override { return m_status; }
+
+    /** @brief Get the number of airspaces in the database */
+    uint32_t get_airspace_count() override { return m_airspace_count; }
+
+  private:
+    /** @brief Status of the database */
+    status m_status;
+    /** @brief Number of airspaces in the database */
+    uint32_t m_airspace_count;
+    /** @brief Indicate that an import has been requested */
+    bool m_import_requested;
+    /** @brief Path of the file to import */
+    char m_import_path[64u];
+    /** @brief Importer */
+    airspace_importer m_importer;
+    /** @brief Proximity checker */
+    airspace_checker m_checker;
+    /** @brief Airspace thread */
+    thread<4096u> m_thread;
+
+    /** @brief Airspace thread */
+    void thread_func(void*);
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_MANAGER_H
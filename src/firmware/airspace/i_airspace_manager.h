@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_AIRSPACE_MANAGER_H
+#define OV_I_AIRSPACE_MANAGER_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Interface for the airspace manager implementation */
+class i_airspace_manager
+{
+  public:
+    /** @brief Status of the airspace database */
+    enum class status
+    {
+        /** @brief No database */
+        no_database,
+        /** @brief Database ready */
+        ready,
+        /** @brief Import in progress */
+        importing,
+        /** @brief Import error */
+        import_error
+    };
+
+    /** @brief Destructor */
+    virtual ~i_airspace_manager() { }
+
+    /** @brief Import an OpenAir file into the database (asynchronous) */
+    virtual bool import(const char* openair_path) = 0;
+
+    /** @brief Get the status of the database */
+    virtual status get_status() = 0;
+
+    /** @brief Get the number of airspaces in the database */
+    virtual uint32_t get_airspace_count() = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_AIRSPACE_MANAGER_H
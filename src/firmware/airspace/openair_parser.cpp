@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "openair_parser.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Meters per nautical mile */
+static constexpr float METERS_PER_NM = 1852.f;
+/** @brief Meters per foot */
+static constexpr double METERS_PER_FOOT = 0.3048;
+
+/** @brief Constructor */
+openair_parser::openair_parser() : m_on_vertex(), m_on_airspace(), m_current{}, m_in_airspace(false), m_center{}, m_clockwise(true) { }
+
+/** @brief Start a new file */
+void openair_parser::reset(const vertex_handler& on_vertex, const airspace_handler& on_airspace)
+{
+    m_on_vertex   = on_vertex;
+    m_on_airspace = on_airspace;
+    m_current     = {};
+    m_in_airspace = false;
+    m_center      = {};
+    m_clockwise   = true;
+}
+
+/** @brief Parse a line (modified during parsing), returns false if a handler failed */
+bool openair_parser::parse_line(char* line)
+{
+    bool ret = true;
+
+    // Remove trailing spaces
+    size_t len = strlen(line);
+    while ((len > 0u) && ((line[len - 1u] == ' ') || (line[len - 1u] == '\t') || (line[len - 1u] == '\r')))
+    {
+        len--;
+        line[len] = 0;
+    }
+
+    // Split record type and arguments, skip comments
+    char* type = const_cast<char*>(skip_spaces(line));
+    if ((type[0u] != 0) && (type[0u] != '*'))
+    {
+        char* args = type;
+        while ((*args != 0) && (*args != ' ') && (*args != '\t'))
+        {
+            args++;
+        }
+        if (*args != 0)
+        {
+            *args = 0;
+            args  = const_cast<char*>(skip_spaces(args + 1u));
+        }
+
+        // Decode record
+        if (strcmp(type, "AC") == 0)
+        {
+            // New airspace
+            if (m_in_airspace)
+            {
+                ret = end_airspace();
+            }
+            m_current             = {};
+            m_current.cls         = parse_class(args);
+            m_current.floor_ref   = airspace_altitude_ref::sfc;
+            m_current.ceiling_ref = airspace_altitude_ref::unlimited;
+            m_in_airspace         = true;
+            m_clockwise           = true;
+        }
+        else if (m_in_airspace)
+        {
+            if (strcmp(type, "AN") == 0)
+            {
+                strncpy(m_current.name, args, sizeof(m_current.name) - 1u);
+            }
+            else if (strcmp(type, "AL") == 0)
+            {
+                parse_altitude(args, m_current.floor, m_current.floor_ref);
+            }
+            else if (strcmp(type, "AH") == 0)
+            {
+                parse_altitude(args, m_current.ceiling, m_current.ceiling_ref);
+            }
+            else if (strcmp(type, "V") == 0)
+            {
+                // Variable assignment
+                if (strncmp(args, "X=", 2u) == 0)
+                {
+                    const char* pos = &args[2u];
+                    parse_position(pos, m_center);
+                }
+                else if (strncmp(args, "D=", 2u) == 0)
+                {
+                    m_clockwise = (args[2u] != '-');
+                }
+                else
+                {
+                    // Ignored
+                }
+            }
+            else if (strcmp(type, "DP") == 0)
+            {
+                // Polygon point
+                const char*   pos = args;
+                geo::position vertex;
+                if (parse_position(pos, vertex))
+                {
+                    ret = add_vertex(vertex);
+                }
+            }
+            else if (strcmp(type, "DC") == 0)
+            {
+                // Circle
+                const float radius = strtof(args, nullptr) * METERS_PER_NM;
+                ret                = add_arc(radius, 0.f, 360.f);
+            }
+            else if (strcmp(type, "DA") == 0)
+            {
+                // Arc defined by radius and angles
+                char*       next   = nullptr;
+                const float radius = strtof(args, &next) * METERS_PER_NM;
+                next               = const_cast<char*>(skip_spaces(next));
+                next += (*next == ',') ? 1u : 0u;
+                const float start = strtof(next, &next);
+                next              = const_cast<char*>(skip_spaces(next));
+                next += (*next == ',') ? 1u : 0u;
+                const float end = strtof(next, nullptr);
+                ret             = add_arc(radius, start, end);
+            }
+            else if (strcmp(type, "DB") == 0)
+            {
+                // Arc defined by its end points
+                const char*   pos = args;
+                geo::position start;
+                geo::position end;
+                if (parse_position(pos, start))
+                {
+                    pos = skip_spaces(pos);
+                    pos += (*pos == ',') ? 1u : 0u;
+                    if (parse_position(pos, end))
+                    {
+                        ret = add_arc(geo::distance(m_center, start), geo::bearing(m_center, start), geo::bearing(m_center, end));
+                    }
+                }
+            }
+            else
+            {
+                // Ignored record
+            }
+        }
+        else
+        {
+            // Record outside of an airspace
+        }
+    }
+
+    return ret;
+}
+
+/** @brief End of file, returns false if a handler failed */
+bool openair_parser::finish()
+{
+    bool ret = true;
+    if (m_in_airspace)
+    {
+        ret = end_airspace();
+    }
+    return ret;
+}
+
+/** @brief Terminate the current airspace */
+bool openair_parser::end_airspace()
+{
+    m_in_airspace = false;
+    return m_on_airspace(m_current);
+}
+
+/** @brief Add a vertex to the current airspace */
+bool openair_parser::add_vertex(const geo::position& vertex)
+{
+    m_current.vertex_count++;
+    return m_on_vertex(vertex);
+}
+
+/** @brief Add the vertices of an arc around the current center */
+bool openair_parser::add_arc(float radius, float start_angle, float end_angle)
+{
+    bool ret = true;
+
+    // Compute sweep angle
+    float sweep = (m_clockwise ? (end_angle - start_angle) : (start_angle - end_angle));
+    while (sweep <= 0.f)
+    {
+        sweep += 360.f;
+    }
+    while (sweep > 360.f)
+    {
+        sweep -= 360.f;
+    }
+
+    // Full circles do not repeat their first vertex
+    const int  steps       = static_cast<int>(std::ceil(sweep / ARC_STEP));
+    const bool full_circle = (sweep >= 360.f);
+    const int  last_step   = (full_circle ? (steps - 1) : steps);
+    for (int i = 0; ret && (i <= last_step); i++)
+    {
+        const float delta = (sweep * static_cast<float>(i)) / static_cast<float>(steps);
+        const float angle = (m_clockwise ? (start_angle + delta) : (start_angle - delta));
+        ret               = add_vertex(geo::destination(m_center, geo::normalize_bearing(angle), radius));
+    }
+
+    return ret;
+}
+
+/** @brief Parse an airspace class */
+airspace_class openair_parser::parse_class(const char* str)
+{
+    static const struct
+    {
+        const char*    name;
+        airspace_class cls;
+    } s_classes[] = {{"A", airspace_class::a},
+                     {"B", airspace_class::b},
+                     {"C", airspace_class::c},
+                     {"D", airspace_class::d},
+                     {"E", airspace_class::e},
+                     {"F", airspace_class::f},
+                     {"G", airspace_class::g},
+                     {"CTR", airspace_class::ctr},
+                     {"R", airspace_class::restricted},
+                     {"Q", airspace_class::danger},
+                     {"P", airspace_class::prohibited},
+                     {"GP", airspace_class::glider_prohibited},
+                     {"TMZ", airspace_class::tmz},
+                     {"RMZ", airspace_class::rmz},
+                     {"W", airspace_class::wave}};
+
+    airspace_class cls = airspace_class::unknown;
+    for (const auto& c : s_classes)
+    {
+        if (strcmp(str, c.name) == 0)
+        {
+            cls = c.cls;
+            break;
+        }
+    }
+    return cls;
+}
+
+/** @brief Parse an altitude limit */
+void openair_parser::parse_altitude(const char* str, int32_t& altitude, airspace_altitude_ref& ref)
+{
+    // Work on an upper case copy
+    char   alt[32u];
+    size_t i = 0u;
+    for (; (i < (sizeof(alt) - 1u)) && (str[i] != 0); i++)
+    {
+        alt[i] = ((str[i] >= 'a') && (str[i] <= 'z')) ? static_cast<char>(str[i] - 'a' + 'A') : str[i];
+    }
+    alt[i] = 0;
+
+    // Decode
+    altitude = 0;
+    ref      = airspace_altitude_ref::sfc;
+    if (strstr(alt, "UNL") != nullptr)
+    {
+        ref = airspace_altitude_ref::unlimited;
+    }
+    else if (strncmp(alt, "FL", 2u) == 0)
+    {
+        // Flight level, converted with the standard atmosphere
+        const long level = strtol(skip_spaces(&alt[2u]), nullptr, 10);
+        altitude         = static_cast<int32_t>(std::lround(static_cast<double>(level) * 100. * METERS_PER_FOOT));
+        ref              = airspace_altitude_ref::msl;
+    }
+    else if ((alt[0u] >= '0') && (alt[0u] <= '9'))
+    {
+        // Value and unit
+        char*        unit  = nullptr;
+        const double value = strtod(alt, &unit);
+        unit               = const_cast<char*>(skip_spaces(unit));
+        if ((unit[0u] == 'M') && (unit[1u] != 'S'))
+        {
+            altitude = static_cast<int32_t>(std::lround(value));
+        }
+        else
+        {
+            altitude = static_cast<int32_t>(std::lround(value * METERS_PER_FOOT));
+        }
+
+        // Reference
+        if ((strstr(unit, "AGL") != nullptr) || (strstr(unit, "GND") != nullptr) || (strstr(unit, "SFC") != nullptr))
+        {
+            ref = airspace_altitude_ref::agl;
+        }
+        else
+        {
+            ref = airspace_altitude_ref::msl;
+        }
+    }
+    else
+    {
+        // SFC, GND or unknown
+    }
+}
+
+/** @brief Parse a coordinate pair "DD:MM:SS N DDD:MM:SS E", str points after the parsed coordinates */
+bool openair_parser::parse_position(const char*& str, geo::position& pos)
+{
+    bool ret = parse_coordinate(str, pos.latitude);
+    ret      = ret && parse_coordinate(str, pos.longitude);
+    return ret;
+}
+
+/** @brief Parse a single coordinate "DD:MM:SS N" or "DD:MM.mmm N" */
+bool openair_parser::parse_coordinate(const char*& str, int32_t& value)
+{
+    bool ret = false;
+
+    // Degrees, minutes, seconds
+    char*  next    = nullptr;
+    double degrees = static_cast<double>(strtol(skip_spaces(str), &next, 10));
+    if (*next == ':')
+    {
+        degrees += strtod(next + 1u, &next) / 60.;
+        if (*next == ':')
+        {
+            degrees += strtod(next + 1u, &next) / 3600.;
+        }
+    }
+
+    // Hemisphere
+    const char* hemisphere = skip_spaces(next);
+    switch (*hemisphere)
+    {
+        case 'S':
+        case 's':
+        case 'W':
+        case 'w':
+            degrees = -degrees;
+            [[fallthrough]];
+        case 'N':
+        case 'n':
+        case 'E':
+        case 'e':
+            value = static_cast<int32_t>(std::lround(degrees * static_cast<double>(geo::UNITS_PER_DEGREE)));
+            str   = hemisphere + 1u;
+            ret   = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return ret;
+}
+
+/** @brief Skip spaces and tabs */
+const char* openair_parser::skip_spaces(const char* str)
+{
+    while ((*str == ' ') || (*str == '\t'))
+    {
+        str++;
+    }
+    return str;
+}
+
+} // namespace ov
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_OPENAIR_PARSER_H
+#define OV_OPENAIR_PARSER_H
+
+#include "airspace.h"
+#include "delegate.h"
+#include "geodesy.h"
+
+namespace ov
+{
+
+/**
+ * @brief Line by line parser for OpenAir airspace files
+ *        Supported records : AC, AN, AL, AH, V X=, V D=, DP, DC, DA, DB
+ *        Arcs and circles are converted to polygons so that only vertices are produced
+ */
+class openair_parser
+{
+  public:
+    /** @brief Airspace description */
+    struct airspace_desc
+    {
+        /** @brief Name */
+        char name[32u];
+        /** @brief Class */
+        airspace_class cls;
+        /** @brief Floor reference */
+        airspace_altitude_ref floor_ref;
+        /** @brief Ceiling reference */
+        airspace_altitude_ref ceiling_ref;
+        /** @brief Floor in meters */
+        int32_t floor;
+        /** @brief Ceiling in meters */
+        int32_t ceiling;
+        /** @brief Number of vertices */
+        uint32_t vertex_count;
+    };
+
+    /** @brief Handler called for each vertex of the current airspace */
+    using vertex_handler = delegate<bool, const geo::position&>;
+    /** @brief Handler called at the end of each airspace */
+    using airspace_handler = delegate<bool, const airspace_desc&>;
+
+    /** @brief Angular step in degrees to convert arcs to polygons */
+    static constexpr float ARC_STEP = 5.f;
+
+    /** @brief Constructor */
+    openair_parser();
+
+    /** @brief Start a new file */
+    void reset(const vertex_handler& on_vertex, const airspace_handler& on_airspace);
+
+    /** @brief Parse a line (modified during parsing), returns false if a handler failed */
+    bool parse_line(char* line);
+
+    /** @brief End of file, returns false if a handler failed */
+    bool finish();
+
+  private:
+    /** @brief Vertex handler */
+    vertex_handler m_on_vertex;
+    /** @brief Airspace handler */
+    airspace_handler m_on_airspace;
+    /** @brief Current airspace */
+    airspace_desc m_current;
+    /** @brief Indicate if an airspace is in progress */
+    bool m_in_airspace;
+    /** @brief Arc center */
+    geo::position m_center;
+    /** @brief Arc direction (true = clockwise) */
+    bool m_clockwise;
+
+    /** @brief Terminate the current airspace */
+    bool end_airspace();
+
+    /** @brief Add a vertex to the current airspace */
+    bool add_vertex(const geo::position& vertex);
+
+    /** @brief Add the vertices of an arc around the current center */
+    bool add_arc(float radius, float start_angle, float end_angle);
+
+    /** @brief Parse an airspace class */
+    static airspace_class parse_class(const char* str);
+
+    /** @brief Parse an altitude limit */
+    static void parse_altitude(const char* str, int32_t& altitude, airspace_altitude_ref& ref);
+
+    /** @brief Parse a coordinate pair "DD:MM:SS N DDD:MM:SS E", str points after the parsed coordinates */
+    static bool parse_position(const char*& str, geo::position& pos);
+
+    /** @brief Parse a single coordinate "DD:MM:SS N" or "DD:MM.mmm N" */
+    static bool parse_coordinate(const char*& str, int32_t& value);
+
+    /** @brief Skip spaces and tabs */
+    static const char* skip_spaces(const char* str);
+};
+
+} // namespace ov
+
+#endif // OV_OPENAIR_PARSER_H
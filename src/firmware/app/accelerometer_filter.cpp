@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "accelerometer_filter.h"
+
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Constructor with the FIFO sample rate in Hz */
+accelerometer_filter::accelerometer_filter(uint16_t sample_rate)
+    : m_x_filter(biquad_coefs::low_pass(CUTOFF_FREQUENCY, static_cast<float>(sample_rate))),
+      m_y_filter(m_x_filter.get_coefs()),
+      m_z_filter(m_x_filter.get_coefs()),
+      m_x_decimator(),
+      m_y_decimator(),
+      m_z_decimator(),
+      m_sample{}
+{
+}
+
+/** @brief Reset the filters and the current block */
+void accelerometer_filter::reset()
+{
+    m_x_filter.reset();
+    m_y_filter.reset();
+    m_z_filter.reset();
+    m_x_decimator.reset();
+    m_y_decimator.reset();
+    m_z_decimator.reset();
+    m_sample = {};
+}
+
+/** @brief Add a FIFO sample, returns true when a new decimated sample is available */
+bool accelerometer_filter::add_sample(const i_accelerometer_sensor::data& sample)
+{
+    // The 3 decimators always complete their blocks together
+    m_x_decimator.add_value(m_x_filter.add_value(sample.x_accel));
+    m_y_decimator.add_value(m_y_filter.add_value(sample.y_accel));
+    bool ret = m_z_decimator.add_value(m_z_filter.add_value(sample.z_accel));
+    if (ret)
+    {
+        m_sample.x_accel = m_x_decimator.get_value();
+        m_sample.y_accel = m_y_decimator.get_value();
+        m_sample.z_accel = m_z_decimator.get_value();
+
+        // Compute total acceleration
+        m_sample.total_accel =
+            static_cast<int16_t>(sqrtf(static_cast<float>(m_sample.x_accel) * static_cast<float>(m_sample.x_accel) +
+                                       static_cast<float>(m_sample.y_accel) * static_cast<float>(m_sample.y_accel) +
+                                       static_cast<float>(m_sample.z_accel) * static_cast<float>(m_sample.z_accel)));
+        m_sample.is_valid = true;
+    }
+
+    return ret;
+}
+
+} // namespace ov
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_ACCELEROMETER_FILTER_H
+#define OV_ACCELEROMETER_FILTER_H
+
+#include "biquad_filter.h"
+#include "decimator.h"
+#include "i_accelerometer_sensor.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Reduce the accelerometer FIFO samples to the acquisition rate of the main loop
+ *        Each axis goes through a low-pass filter below the Nyquist frequency of the main loop,
+ *        then through a block mean spanning the acquisition period
+ */
+class accelerometer_filter
+{
+  public:
+    /** @brief Decimation factor : 104Hz FIFO rate down to the 4Hz acquisition rate of the main loop */
+    static constexpr size_t DECIMATION = 26u;
+    /** @brief Cutoff frequency of the low-pass filter in Hz */
+    static constexpr float CUTOFF_FREQUENCY = 1.5f;
+
+    /** @brief Constructor with the FIFO sample rate in Hz */
+    accelerometer_filter(uint16_t sample_rate);
+
+    /** @brief Reset the filters and the current block */
+    void reset();
+
+    /** @brief Add a FIFO sample, returns true when a new decimated sample is available */
+    bool add_sample(const i_accelerometer_sensor::data& sample);
+
+    /** @brief Get the last decimated sample, invalid until the first block is complete */
+    const i_accelerometer_sensor::data& get_sample() const { return m_sample; }
+
+  private:
+    /** @brief Low-pass filter on X */
+    biquad_filter<int16_t> m_x_filter;
+    /** @brief Low-pass filter on Y */
+    biquad_filter<int16_t> m_y_filter;
+    /** @brief Low-pass filter on Z */
+    biquad_filter<int16_t> m_z_filter;
+    /** @brief Decimator on X */
+    decimator<int16_t, int32_t, DECIMATION> m_x_decimator;
+    /** @brief Decimator on Y */
+    decimator<int16_t, int32_t, DECIMATION> m_y_decimator;
+    /** @brief Decimator on Z */
+    decimator<int16_t, int32_t, DECIMATION> m_z_decimator;
+    /** @brief Last decimated sample */
+    i_accelerometer_sensor::data m_sample;
+};
+
+} // namespace ov
+
+#endif // OV_ACCELEROMETER_FILTER_H
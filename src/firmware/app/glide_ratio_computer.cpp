@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "glide_ratio_computer.h"
+#include "ov_data.h"
+
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Constructor */
+glide_ratio_computer::glide_ratio_computer()
+    : m_slots{},
+      m_depth(MIN_SLOTS),
+      m_next(0u),
+      m_count(0u),
+      m_distance_sum(0u),
+      m_slot_distance(0u),
+      m_slot_start_altitude(0),
+      m_slot_elapsed_ms(0u),
+      m_last_timestamp(0u),
+      m_last_altitude(0),
+      m_started(false),
+      m_last_position{},
+      m_glide_ratio(ov_data::INVALID_GLIDE_RATIO_VALUE)
+{
+}
+
+/** @brief Set the duration of the integration window in milliseconds */
+void glide_ratio_computer::set_window(uint32_t window_ms)
+{
+    // Compute depth
+    size_t depth = static_cast<size_t>(window_ms / SLOT_DURATION_MS);
+    if (depth < MIN_SLOTS)
+    {
+        depth = MIN_SLOTS;
+    }
+    if (depth > MAX_SLOTS)
+    {
+        depth = MAX_SLOTS;
+    }
+
+    // Restart computation on change
+    if (depth != m_depth)
+    {
+        m_depth = depth;
+        reset();
+    }
+}
+
+/** @brief Reset the computation */
+void glide_ratio_computer::reset()
+{
+    m_next            = 0u;
+    m_count           = 0u;
+    m_distance_sum    = 0u;
+    m_slot_distance   = 0u;
+    m_slot_elapsed_ms = 0u;
+    m_started         = false;
+    m_glide_ratio     = ov_data::INVALID_GLIDE_RATIO_VALUE;
+}
+
+/** @brief Update the computation with new sensor data */
+uint16_t glide_ratio_computer::update(const i_gnss::data& gnss, int32_t altitude, uint32_t timestamp)
+{
+    if (gnss.is_valid)
+    {
+        const geo::position position = gnss.get_position();
+        if (m_started)
+        {
+            // Distance travelled since the last fix, a short dropout is bridged
+            // by the straight line between the surrounding fixes
+            uint32_t distance = 0u;
+            if (position != m_last_position)
+            {
+                distance        = static_cast<uint32_t>(std::lround(geo::distance(m_last_position, position) * 10.f));
+                m_last_position = position;
+            }
+            add_interval(distance, altitude, timestamp - m_last_timestamp);
+        }
+        else
+        {
+            // First fix, start a new window
+            m_started             = true;
+            m_last_position       = position;
+            m_slot_start_altitude = altitude;
+            m_slot_elapsed_ms     = 0u;
+        }
+        m_last_timestamp = timestamp;
+        m_last_altitude  = altitude;
+    }
+    else if (m_started)
+    {
+        // The slots are frozen during a dropout and the last glide ratio is kept,
+        // restart computation if the dropout is too long
+        if ((timestamp - m_last_timestamp) > MAX_GNSS_GAP_MS)
+        {
+            reset();
+        }
+    }
+    else
+    {
+        // Waiting for a valid fix
+    }
+
+    return m_glide_ratio;
+}
+
+/** @brief Split the distance travelled since the last fix into the slots covered by the elapsed time */
+void glide_ratio_computer::add_interval(uint32_t distance, int32_t altitude, uint32_t elapsed_ms)
+{
+    // Distance and altitude are interpolated linearly at each slot boundary, so that the distance
+    // of a bridged dropout is spread over the slots of the dropout instead of a single slot
+    uint32_t remaining_ms       = elapsed_ms;
+    uint32_t remaining_distance = distance;
+    while ((m_slot_elapsed_ms + remaining_ms) >= SLOT_DURATION_MS)
+    {
+        const uint32_t part_ms       = SLOT_DURATION_MS - m_slot_elapsed_ms;
+        const uint32_t part_distance = (remaining_distance * part_ms) / remaining_ms;
+        remaining_distance -= part_distance;
+        remaining_ms -= part_ms;
+
+        const int64_t altitude_change = static_cast<int64_t>(altitude - m_last_altitude) * (elapsed_ms - remaining_ms);
+        const int32_t slot_altitude   = m_last_altitude + static_cast<int32_t>(altitude_change / static_cast<int64_t>(elapsed_ms));
+
+        m_slot_distance += part_distance;
+        m_slot_elapsed_ms = 0u;
+        close_slot(slot_altitude);
+    }
+    m_slot_distance += remaining_distance;
+    m_slot_elapsed_ms += remaining_ms;
+}
+
+/** @brief Close the current slot and push it into the window */
+void glide_ratio_computer::close_slot(int32_t altitude)
+{
+    // Remove the oldest slot from the window
+    if (m_count == m_depth)
+    {
+        m_distance_sum -= m_slots[m_next].distance;
+    }
+    else
+    {
+        m_count++;
+    }
+
+    // Add the current slot
+    slot& current          = m_slots[m_next];
+    current.distance       = m_slot_distance;
+    current.start_altitude = m_slot_start_altitude;
+    m_distance_sum += m_slot_distance;
+    m_next++;
+    if (m_next == m_depth)
+    {
+        m_next = 0u;
+    }
+
+    // Start a new slot
+    m_slot_distance       = 0u;
+    m_slot_start_altitude = altitude;
+
+    // Compute glide ratio once the window is full
+    uint16_t glide_ratio = ov_data::INVALID_GLIDE_RATIO_VALUE;
+    if (m_count == m_depth)
+    {
+        const int32_t altitude_loss = m_slots[m_next].start_altitude - altitude;
+        if (altitude_loss > 0)
+        {
+            const uint32_t ratio = (m_distance_sum * 10u) / static_cast<uint32_t>(altitude_loss);
+            if (ratio < ov_data::INVALID_GLIDE_RATIO_VALUE)
+            {
+                glide_ratio = static_cast<uint16_t>(ratio);
+            }
+        }
+    }
+    m_glide_ratio = glide_ratio;
+}
+
+} // namespace ov
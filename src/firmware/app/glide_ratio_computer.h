@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_GLIDE_RATIO_COMPUTER_H
+#define OV_GLIDE_RATIO_COMPUTER_H
+
+#include "geodesy.h"
+#include "i_gnss.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Glide ratio computation over a sliding time window
+ *        Horizontal distance is integrated from successive GNSS fixes and split into 1s slots,
+ *        running sums are updated in O(1) each time a slot enters or leaves the window
+ */
+class glide_ratio_computer
+{
+  public:
+    /** @brief Duration of a slot in milliseconds */
+    static constexpr uint32_t SLOT_DURATION_MS = 1000u;
+    /** @brief Maximum number of slots in the window */
+    static constexpr size_t MAX_SLOTS = 60u;
+    /** @brief Minimum number of slots in the window */
+    static constexpr size_t MIN_SLOTS = 2u;
+    /** @brief Maximum GNSS dropout duration in milliseconds which can be bridged without resetting the window */
+    static constexpr uint32_t MAX_GNSS_GAP_MS = 5000u;
+
+    /** @brief Constructor */
+    glide_ratio_computer();
+
+    /** @brief Set the duration of the integration window in milliseconds */
+    void set_window(uint32_t window_ms);
+
+    /** @brief Get the number of slots in the integration window */
+    size_t get_depth() const { return m_depth; }
+
+    /** @brief Reset the computation */
+    void reset();
+
+    /**
+     * @brief Update the computation with new sensor data
+     * @param gnss GNSS data
+     * @param altitude Barometric altitude (1 = 0.1m)
+     * @param timestamp Timestamp of the data in milliseconds
+     * @return Glide ratio (1 = 0.1) or ov_data::INVALID_GLIDE_RATIO_VALUE
+     */
+    uint16_t update(const i_gnss::data& gnss, int32_t altitude, uint32_t timestamp);
+
+    /** @brief Get the last computed glide ratio (1 = 0.1) */
+    uint16_t get_glide_ratio() const { return m_glide_ratio; }
+
+  private:
+    /** @brief Slot of the integration window */
+    struct slot
+    {
+        /** @brief Horizontal distance travelled during the slot (1 = 0.1m) */
+        uint32_t distance;
+        /** @brief Altitude at the start of the slot (1 = 0.1m) */
+        int32_t start_altitude;
+    };
+
+    /** @brief Slots */
+    slot m_slots[MAX_SLOTS];
+    /** @brief Number of slots in the window */
+    size_t m_depth;
+    /** @brief Index of the next slot to write */
+    size_t m_next;
+    /** @brief Number of slots currently stored */
+    size_t m_count;
+    /** @brief Sum of the distances of the stored slots (1 = 0.1m) */
+    uint32_t m_distance_sum;
+    /** @brief Distance travelled during the current slot (1 = 0.1m) */
+    uint32_t m_slot_distance;
+    /** @brief Altitude at the start of the current slot (1 = 0.1m) */
+    int32_t m_slot_start_altitude;
+    /** @brief Elapsed time in the current slot in milliseconds */
+    uint32_t m_slot_elapsed_ms;
+    /** @brief Timestamp of the last valid GNSS fix in milliseconds */
+    uint32_t m_last_timestamp;
+    /** @brief Altitude at the last valid GNSS fix (1 = 0.1m) */
+    int32_t m_last_altitude;
+    /** @brief Indicate if the computation has started */
+    bool m_started;
+    /** @brief Last valid GNSS position */
+    geo::position m_last_position;
+    /** @brief Last computed glide ratio (1 = 0.1) */
+    uint16_t m_glide_ratio;
+
+    /** @brief Split the distance travelled since the last fix into the slots covered by the elapsed time */
+    void add_interval(uint32_t distance, int32_t altitude, uint32_t elapsed_ms);
+
+    /** @brief Close the current slot and push it into the window */
+    void close_slot(int32_t altitude);
+};
+
+} // namespace ov
+
+#endif // OV_GLIDE_RATIO_COMPUTER_H
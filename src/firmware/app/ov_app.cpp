@@ -4,11 +4,16 @@
  */
 
 #include "ov_app.h"
+#include "accelerometer_filter.h"
+#include "delay_line.h"
 #include "fs.h"
-#include "mean_filter.h"
+#include "glide_ratio_computer.h"
+#include "median_filter.h"
 #include "os.h"
 #include "ov_config.h"
 #include "ov_data.h"
+#include "running_stats.h"
+#include "te_vario.h"
 
 #include <stdio.h>
 
@@ -23,6 +28,10 @@ ov_app::ov_app()
       m_config_console(m_console),
       m_sensors_console(m_console, m_board.get_altimeter()),
       m_recorder_console(m_console, m_recorder),
+      m_airspace_console(m_console, m_airspaces),
+      m_terrain_console(m_console, m_terrain),
+      m_navigation_console(m_console, m_navigation),
+      m_stream_console(m_console, m_stream),
       m_hmi(m_board.get_display(),
             m_console,
             m_board.get_previous_button(),
@@ -34,9 +43,18 @@ ov_app::ov_app()
             m_board.get_altimeter()),
       m_ble(m_board.get_ble_stack()),
       m_recorder(),
+      m_flight_drive(),
       m_xctrack(m_board.get_usb_cdc()),
-      m_maintenance(m_board.get_usb_cdc()),
-      m_thread()
+      m_airspaces(),
+      m_terrain(),
+      m_navigation(),
+      m_fusion(m_board.get_accelerometer(), m_board.get_gyroscope()),
+      m_stream(m_board.get_maintenance_cdc()),
+      m_maintenance(m_board.get_maintenance_cdc(), m_airspaces, m_terrain, m_stream),
+      m_thread(),
+      m_integ_times_changed(true),
+      m_speed_to_fly(),
+      m_polar_changed(true)
 {
 }
 
@@ -78,18 +96,30 @@ void ov_app::thread_func(void*)
     i_barometric_altimeter::data baro_data;
     i_accelerometer_sensor::data accel_data;
 
-    // Sensor acquisition period
-    constexpr uint32_t sensor_period_ms = 250u;
+    // Sensor acquisition period, the samples are sent to the external instruments at the same rate (10Hz)
+    constexpr uint32_t sensor_period_ms = 100u;
+
+    // Accelerometer FIFO samples, reduced to the acquisition period
+    const uint16_t               accel_rate = accelerometer.get_fifo_rate();
+    i_accelerometer_sensor::data accel_samples[i_sensor_stream::MAX_ACCEL_BLOCK_SAMPLES];
+    accelerometer_filter         accel_filter(accel_rate);
 
     // Filters for sink rate and glide ratio computation
-    circular_buffer<int32_t, 40u>                           sink_rate_altitudes;
-    mean_filter<int16_t, int32_t, 1000u / sensor_period_ms> sink_rate_filter;
+    median_filter<int32_t, 3u>                                altitude_filter;
+    delay_line<int32_t, te_vario::MAX_DEPTH>                  sink_rate_altitudes;
+    running_stats<int16_t, int32_t, 1000u / sensor_period_ms> sink_rate_filter;
+
+    glide_ratio_computer glide_ratio;
 
-    uint32_t                       glide_ratio_period_ms = 0u;
-    circular_buffer<int32_t, 15u>  glide_ratio_altitudes;
-    circular_buffer<uint16_t, 15u> glide_ratio_distances;
+    // Total energy compensation and its filter
+    te_vario                                                  te;
+    running_stats<int16_t, int32_t, 1000u / sensor_period_ms> te_sink_rate_filter;
+
+    // MacCready setting
+    uint16_t mac_cready = 0u;
 
     // Main loop
+    uint32_t cycle_time = ov::os::now();
     while (true)
     {
         // Get gnss data
@@ -108,62 +138,147 @@ void ov_app::thread_func(void*)
         baro_data = altimeter.get_data();
         ov::data::set_altimeter(baro_data);
 
-        // Get accelerometer data
-        accel_data = accelerometer.get_data();
+        // Get accelerometer data from the FIFO by blocks, each block is streamed as it is read
+        size_t accel_count = 0u;
+        size_t block_count = 0u;
+        do
+        {
+            block_count = accelerometer.read_fifo(accel_samples, i_sensor_stream::MAX_ACCEL_BLOCK_SAMPLES);
+            m_stream.push_accelerometer_samples(accel_samples, block_count, accel_rate);
+            for (size_t i = 0u; i < block_count; i++)
+            {
+                accel_filter.add_sample(accel_samples[i]);
+            }
+            accel_count += block_count;
+        } while (block_count == i_sensor_stream::MAX_ACCEL_BLOCK_SAMPLES);
+        accel_data          = accel_filter.get_sample();
+        accel_data.is_valid = accel_data.is_valid && (accel_count != 0u);
         ov::data::set_accelerometer(accel_data);
 
-        // Filters depths
-        size_t sink_rate_depth   = ov::config::get().sr_integ_time / sensor_period_ms;
-        size_t glide_ratio_depth = ov::config::get().gr_integ_time / 1000u;
-        if (sink_rate_altitudes.get_depth() != sink_rate_depth)
+        // Filters settings, recomputed only when they have changed
+        if (m_integ_times_changed)
         {
-            sink_rate_altitudes.set_depth(sink_rate_depth);
+            m_integ_times_changed  = false;
+            const ov_config config = ov::config::get();
+
+            // At least 2 altitudes are needed to span a time interval
+            size_t sink_rate_depth = config.sr_integ_time / sensor_period_ms;
+            if ((sink_rate_depth > 1u) && (sink_rate_altitudes.get_depth() != sink_rate_depth))
+            {
+                sink_rate_altitudes.set_depth(sink_rate_depth);
+            }
+            te.set_window(sink_rate_altitudes.get_depth(), sensor_period_ms);
+            te.set_wind_correction(config.te_wind_corr);
+            glide_ratio.set_window(config.gr_integ_time);
         }
-        if (glide_ratio_altitudes.get_depth() != glide_ratio_depth)
+
+        // Speed to fly tables, recomputed only when the selected polar or the MacCready setting have changed
+        if (m_polar_changed)
         {
-            glide_ratio_altitudes.set_depth(glide_ratio_depth);
-            glide_ratio_distances.set_depth(glide_ratio_depth);
+            m_polar_changed        = false;
+            const ov_config config = ov::config::get();
+
+            const uint8_t       polars[] = {config.glider1_polar, config.glider2_polar, config.glider3_polar, config.glider4_polar};
+            const uint8_t       glider   = ((config.glider >= 1u) && (config.glider <= 4u)) ? config.glider : 1u;
+            const glider_polar* polar    = ov::polar::get(polars[glider - 1u]);
+            if ((polar == nullptr) || !m_speed_to_fly.set_polar(*polar))
+            {
+                m_speed_to_fly.reset();
+            }
+            mac_cready = config.mac_cready;
         }
 
-        // Compute sink rate
-        int32_t previous_altitude = sink_rate_altitudes.get_oldest_value();
-        int32_t delta_alti        = baro_data.altitude - previous_altitude;
-        sink_rate_altitudes.add_value(baro_data.altitude);
+        // Reject altitude spikes
+        const int32_t altitude = altitude_filter.add_value(baro_data.altitude);
 
-        int16_t sink_rate      = static_cast<int16_t>((delta_alti * 1000) / static_cast<int32_t>(sink_rate_depth * sensor_period_ms));
-        auto    mean_sink_rate = sink_rate_filter.add_value(sink_rate);
+        // Compute sink rate once the altitude history is filled
+        int16_t sink_rate = 0;
+        sink_rate_altitudes.add_value(altitude);
+        if (sink_rate_altitudes.is_full())
+        {
+            // The oldest value has been stored (depth - 1) periods ago
+            const int32_t delta_alti = altitude - sink_rate_altitudes.get_oldest_value();
+            const int32_t delta_time = static_cast<int32_t>((sink_rate_altitudes.get_depth() - 1u) * sensor_period_ms);
+            sink_rate                = static_cast<int16_t>((delta_alti * 1000) / delta_time);
+        }
+        auto mean_sink_rate = sink_rate_filter.add_value(sink_rate);
         ov::data::set_sink_rate(mean_sink_rate);
 
-        // Compute glide ratio every second
-        glide_ratio_period_ms += sensor_period_ms;
-        if (sensor_period_ms == 1000u)
+        // Total energy sink rate on the same window, the netto sink rate removes the glider's sink at the current airspeed
+        int16_t te_sink_rate    = ov_data::INVALID_SINK_RATE_VALUE;
+        int16_t netto_sink_rate = ov_data::INVALID_SINK_RATE_VALUE;
+        if (te.update(gnss_data, sink_rate, ov::os::now()) && sink_rate_altitudes.is_full())
         {
-            int32_t previous_altitude = glide_ratio_altitudes.get_oldest_value();
-            delta_alti                = baro_data.altitude - previous_altitude;
-            glide_ratio_altitudes.add_value(baro_data.altitude);
-            if (gnss_data.is_valid)
+            te_sink_rate = te_sink_rate_filter.add_value(te.get_te_sink_rate());
+            if (m_speed_to_fly.is_valid())
             {
-                glide_ratio_distances.add_value(static_cast<uint16_t>(gnss_data.speed));
+                netto_sink_rate = te.get_netto_sink_rate(te_sink_rate, m_speed_to_fly);
             }
-            else
+        }
+        ov::data::set_te_sink_rates(te_sink_rate, netto_sink_rate);
+
+        // Speed to fly and final glide, the sink of the polar is given at the same airspeed as the netto sink rate
+        polar_status polar = {};
+        if (m_speed_to_fly.is_valid())
+        {
+            polar.mac_cready   = mac_cready;
+            polar.speed_to_fly = m_speed_to_fly.get_speed_to_fly(mac_cready);
+            if (gnss_data.is_valid)
             {
-                glide_ratio_distances.add_value(glide_ratio_distances.get_oldest_value());
+                polar.polar_sink          = m_speed_to_fly.get_sink(te.get_airspeed());
+                polar.is_polar_sink_valid = true;
             }
-
-            // Glide ratio validity
-            uint16_t glide_ratio = ov_data::INVALID_GLIDE_RATIO_VALUE;
-            if (gnss_data.is_valid && (delta_alti > 0))
+            const navigation_status navigation = ov::data::get_navigation();
+            if (navigation.is_valid && !navigation.goal_reached)
             {
-                uint16_t cumulated_distance = glide_ratio_distances.sum();
-                glide_ratio                 = cumulated_distance / static_cast<uint16_t>(delta_alti);
+                polar.final_glide_altitude = m_speed_to_fly.get_final_glide_altitude(navigation.goal_distance, mac_cready);
+                polar.is_final_glide_valid = true;
             }
-            ov::data::set_glide_ratio(glide_ratio);
-
-            // Reset computation period
-            glide_ratio_period_ms = 0u;
+            polar.is_valid = true;
+        }
+        ov::data::set_polar(polar);
+
+        // Send the new sample to the external instruments
+        i_xctrack_link::sample instrument_sample = {};
+        instrument_sample.pressure               = baro_data.pressure;
+        instrument_sample.altitude               = altitude;
+        instrument_sample.vario                  = mean_sink_rate;
+        instrument_sample.temperature            = baro_data.temperature;
+        instrument_sample.x_accel                = accel_data.x_accel;
+        instrument_sample.y_accel                = accel_data.y_accel;
+        instrument_sample.z_accel                = accel_data.z_accel;
+        instrument_sample.total_accel            = accel_data.total_accel;
+        instrument_sample.is_baro_valid          = baro_data.is_valid;
+        instrument_sample.is_accel_valid         = accel_data.is_valid;
+        instrument_sample.polar                  = polar;
+        instrument_sample.te_vario               = te_sink_rate;
+        instrument_sample.netto_vario            = netto_sink_rate;
+        instrument_sample.is_te_valid            = (te_sink_rate != ov_data::INVALID_SINK_RATE_VALUE);
+        instrument_sample.is_netto_valid         = (netto_sink_rate != ov_data::INVALID_SINK_RATE_VALUE);
+        m_xctrack.publish(instrument_sample);
+
+        // Compute glide ratio
+        const uint16_t current_glide_ratio = glide_ratio.update(gnss_data, altitude, ov::os::now());
+        ov::data::set_glide_ratio(current_glide_ratio);
+
+        // Stream the outputs of the main loop for bench captures, the raw samples are streamed where they are acquired
+        if (m_stream.is_started())
+        {
+            stream_samples(accel_data, altitude, mean_sink_rate, current_glide_ratio);
         }
 
-        ov::this_thread::sleep_for(sensor_period_ms);
+        // Pace the acquisition on deadlines so that the processing time does not lower the sample rate,
+        // a late cycle restarts the deadlines instead of running several cycles back to back
+        cycle_time += sensor_period_ms;
+        const int32_t remaining = static_cast<int32_t>(cycle_time - ov::os::now());
+        if (remaining > 0)
+        {
+            ov::this_thread::sleep_for(static_cast<uint32_t>(remaining));
+        }
+        else
+        {
+            cycle_time = ov::os::now();
+        }
     }
 }
 
@@ -180,7 +295,8 @@ void ov_app::startup()
     bool fs_reinitialized = false;
     ov::fs::init(fs_reinitialized, m_board.get_storage_memory());
 
-    // Load configuration
+    // Load configuration, the filters are notified of its changes
+    ov::config::subscribe(ov::config::listener::create<ov_app, &ov_app::on_config_changed>(*this));
     if (!ov::config::load())
     {
         // Save default values
@@ -192,6 +308,10 @@ void ov_app::startup()
     m_config_console.register_handlers();
     m_sensors_console.register_handlers();
     m_recorder_console.register_handlers();
+    m_airspace_console.register_handlers();
+    m_terrain_console.register_handlers();
+    m_navigation_console.register_handlers();
+    m_stream_console.register_handlers();
 
     // Start console
     m_console.start();
@@ -199,15 +319,89 @@ void ov_app::startup()
     // Initialize recorder
     m_recorder.init();
 
+    // Start USB device, the recorded flights are exposed once the flight catalog has been checked
+    if (ov::config::get().usb_mass_storage)
+    {
+        m_flight_drive.init();
+        m_board.get_usb_msc().start(m_flight_drive);
+    }
+    else
+    {
+        // Both CDC ports are started at once
+        m_board.get_usb_cdc().start();
+    }
+
+    // Start airspace checks
+    m_airspaces.init();
+
+    // Start terrain lookups
+    m_terrain.init();
+
+    // Start task navigation
+    m_navigation.init();
+
+    // Start position propagation between the GNSS fixes
+    m_fusion.init();
+
     // Load altimeter with calibration data
     const auto& config = ov::config::get();
     m_board.get_altimeter().set_references(config.alti_ref_temp, config.alti_ref_pressure, config.alti_ref_alti);
 
-    // Start XCTrack link
+    // Start XCTrack link, its sentences are also sent over the BLE serial port
+    m_xctrack.set_serial_output(&m_ble.uart());
     m_xctrack.init();
 
+    // Start sensor stream, the raw GNSS sentences are dispatched to the stream and to the XCTrack link
+    m_stream.init();
+    m_board.get_gnss().set_listener(this);
+    m_board.get_altimeter().set_listener(&m_stream);
+
     // Start maintenance link
     m_maintenance.init();
 }
 
+/** @brief Push the outputs of the current acquisition cycle in the sensor stream */
+void ov_app::stream_samples(const i_accelerometer_sensor::data& accel_data, int32_t altitude, int16_t sink_rate, uint16_t glide_ratio)
+{
+    i_sensor_stream::accelerometer_record accel = {};
+    accel.x_accel                               = accel_data.x_accel;
+    accel.y_accel                               = accel_data.y_accel;
+    accel.z_accel                               = accel_data.z_accel;
+    accel.total_accel                           = accel_data.total_accel;
+    accel.is_valid                              = accel_data.is_valid;
+    m_stream.push(i_sensor_stream::record_type::accelerometer, &accel, sizeof(accel));
+
+    const i_sensor_stream::filters_record filters = {altitude, sink_rate, glide_ratio};
+    m_stream.push(i_sensor_stream::record_type::filters, &filters, sizeof(filters));
+}
+
+/** @brief Called for each valid sentence received from the GNSS, without start of frame and checksum */
+void ov_app::on_sentence(const char* sentence, size_t size)
+{
+    m_stream.on_sentence(sentence, size);
+    m_xctrack.forward_gnss_sentence(sentence, size);
+}
+
+/** @brief Called once for each new fix from the GNSS */
+void ov_app::on_fix(const i_gnss::data& fix)
+{
+    m_stream.on_fix(fix);
+}
+
+/** @brief Called when the configuration has changed */
+void ov_app::on_config_changed(const ov_config& new_config, const ov_config& old_config)
+{
+    if ((new_config.sr_integ_time != old_config.sr_integ_time) || (new_config.gr_integ_time != old_config.gr_integ_time) ||
+        (new_config.te_wind_corr != old_config.te_wind_corr))
+    {
+        m_integ_times_changed = true;
+    }
+    if ((new_config.glider != old_config.glider) || (new_config.glider1_polar != old_config.glider1_polar) ||
+        (new_config.glider2_polar != old_config.glider2_polar) || (new_config.glider3_polar != old_config.glider3_polar) ||
+        (new_config.glider4_polar != old_config.glider4_polar) || (new_config.mac_cready != old_config.mac_cready))
+    {
+        m_polar_changed = true;
+    }
+}
+
 } // namespace ov
@@ -6,16 +6,28 @@
 #ifndef OV_APP_H
 #define OV_APP_H
 
+#include "airspace_console.h"
+#include "airspace_manager.h"
 #include "ble_manager.h"
 #include "config_console.h"
 #include "debug_console.h"
+#include "flight_drive.h"
 #include "flight_recorder.h"
 #include "fs_console.h"
+#include "fusion_manager.h"
 #include "hmi_manager.h"
 #include "maintenance_manager.h"
 #include "ov_board.h"
+#include "ov_config.h"
 #include "recorder_console.h"
+#include "sensor_stream.h"
 #include "sensors_console.h"
+#include "speed_to_fly.h"
+#include "stream_console.h"
+#include "navigation_console.h"
+#include "navigation_manager.h"
+#include "terrain_console.h"
+#include "terrain_manager.h"
 #include "thread.h"
 #include "xctrack_link.h"
 
@@ -23,7 +35,7 @@ namespace ov
 {
 
 /** @brief Open Vario application */
-class ov_app
+class ov_app : public i_gnss::i_listener
 {
   public:
     /** @brief Constructor */
@@ -48,24 +60,62 @@ class ov_app
     sensors_console m_sensors_console;
     /** @brief Flight recorder console */
     recorder_console m_recorder_console;
+    /** @brief Airspace console commands */
+    airspace_console m_airspace_console;
+    /** @brief Terrain console commands */
+    terrain_console m_terrain_console;
+    /** @brief Navigation console commands */
+    navigation_console m_navigation_console;
+    /** @brief Sensor stream console commands */
+    stream_console m_stream_console;
     /** @brief HMI manager */
     hmi_manager m_hmi;
     /** @brief BLE */
     ble_manager m_ble;
     /** @brief Flight recorder */
     flight_recorder m_recorder;
+    /** @brief Recorded flights exposed over USB mass storage */
+    flight_drive m_flight_drive;
     /** @brief XCTrack link */
     xctrack_link m_xctrack;
+    /** @brief Airspace manager */
+    airspace_manager m_airspaces;
+    /** @brief Terrain manager */
+    terrain_manager m_terrain;
+    /** @brief Navigation manager */
+    navigation_manager m_navigation;
+    /** @brief GNSS and inertial sensors fusion */
+    fusion_manager m_fusion;
+    /** @brief Sensor stream */
+    sensor_stream m_stream;
     /** @brief Maintenance manager */
     maintenance_manager m_maintenance;
     /** @brief Main thread */
-    thread<2048u> m_thread;
+    thread<3072u> m_thread;
+    /** @brief Indicate if the integration times have changed and the filters depths must be recomputed */
+    volatile bool m_integ_times_changed;
+    /** @brief Speed to fly tables of the selected glider */
+    speed_to_fly m_speed_to_fly;
+    /** @brief Indicate if the glider polar or the MacCready setting have changed and the speed to fly tables must be recomputed */
+    volatile bool m_polar_changed;
 
     /** @brief Main thread */
     void thread_func(void*);
 
     /** @brief Startup process */
     void startup();
+
+    /** @brief Push the outputs of the current acquisition cycle in the sensor stream */
+    void stream_samples(const i_accelerometer_sensor::data& accel_data, int32_t altitude, int16_t sink_rate, uint16_t glide_ratio);
+
+    /** @brief Called for each valid sentence received from the GNSS, without start of frame and checksum */
+    void on_sentence(const char* sentence, size_t size) override;
+
+    /** @brief Called once for each new fix from the GNSS */
+    void on_fix(const i_gnss::data& fix) override;
+
+    /** @brief Called when the configuration has changed */
+    void on_config_changed(const ov_config& new_config, const ov_config& old_config);
 };
 
 } // namespace ov
@@ -55,6 +55,20 @@ int16_t get_sink_rate()
     return s_data.sink_rate;
 }
 
+/** @brief Get the total energy sink rate */
+int16_t get_te_sink_rate()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.te_sink_rate;
+}
+
+/** @brief Get the netto sink rate */
+int16_t get_netto_sink_rate()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.netto_sink_rate;
+}
+
 /** @brief Get the glide ratio */
 uint16_t get_glide_ratio()
 {
@@ -62,6 +76,41 @@ uint16_t get_glide_ratio()
     return s_data.glide_ratio;
 }
 
+/** @brief Get the nearest airspace status */
+airspace_status get_airspace()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.airspace;
+}
+
+/** @brief Get the terrain status */
+terrain_status get_terrain()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.terrain;
+}
+
+/** @brief Get the task navigation status */
+navigation_status get_navigation()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.navigation;
+}
+
+/** @brief Get the speed to fly and final glide status */
+polar_status get_polar()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.polar;
+}
+
+/** @brief Get the position propagated between the GNSS fixes */
+position_estimate get_position_estimate()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_data.estimate;
+}
+
 // Setters
 
 /** @brief Set the GNSS data */
@@ -99,6 +148,14 @@ void set_sink_rate(int16_t data)
     s_data.sink_rate = data;
 }
 
+/** @brief Set the total energy and netto sink rates */
+void set_te_sink_rates(int16_t te_sink_rate, int16_t netto_sink_rate)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.te_sink_rate    = te_sink_rate;
+    s_data.netto_sink_rate = netto_sink_rate;
+}
+
 /** @brief Set the sink rate */
 void set_glide_ratio(uint16_t data)
 {
@@ -106,5 +163,54 @@ void set_glide_ratio(uint16_t data)
     s_data.glide_ratio = data;
 }
 
+/** @brief Set the nearest airspace status */
+void set_airspace(const airspace_status& data)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.airspace = data;
+}
+
+/** @brief Invalidate the nearest airspace status */
+void invalidate_airspace()
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.airspace = {};
+}
+
+/** @brief Set the terrain status */
+void set_terrain(const terrain_status& data)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.terrain = data;
+}
+
+/** @brief Set the task navigation status */
+void set_navigation(const navigation_status& data)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.navigation = data;
+}
+
+/** @brief Invalidate the task navigation status */
+void invalidate_navigation()
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.navigation = {};
+}
+
+/** @brief Set the speed to fly and final glide status */
+void set_polar(const polar_status& data)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.polar = data;
+}
+
+/** @brief Set the position propagated between the GNSS fixes */
+void set_position_estimate(const position_estimate& data)
+{
+    lock_guard<mutex> lock(s_mutex);
+    s_data.estimate = data;
+}
+
 } // namespace data
 } // namespace ov
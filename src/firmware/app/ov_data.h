@@ -6,9 +6,14 @@
 #ifndef OV_DATA_H
 #define OV_DATA_H
 
+#include "airspace.h"
 #include "i_accelerometer_sensor.h"
 #include "i_barometric_altimeter.h"
 #include "i_gnss.h"
+#include "navigation.h"
+#include "polar.h"
+#include "position_estimate.h"
+#include "terrain.h"
 
 namespace ov
 {
@@ -24,11 +29,27 @@ struct ov_data
     i_accelerometer_sensor::data accelerometer;
     /** @brief Sink rate (1 = 0.1m/s) */
     int16_t sink_rate;
+    /** @brief Total energy sink rate (1 = 0.1m/s) */
+    int16_t te_sink_rate;
+    /** @brief Netto sink rate, the air mass vertical speed (1 = 0.1m/s) */
+    int16_t netto_sink_rate;
     /** @brief Glide ratio (1 = 0.1) */
     uint16_t glide_ratio;
+    /** @brief Nearest airspace */
+    airspace_status airspace;
+    /** @brief Terrain below the current position */
+    terrain_status terrain;
+    /** @brief Task navigation */
+    navigation_status navigation;
+    /** @brief Speed to fly and final glide */
+    polar_status polar;
+    /** @brief Position propagated between the GNSS fixes */
+    position_estimate estimate;
 
     /** @brief Invalid glide ratio value */
     static constexpr uint16_t INVALID_GLIDE_RATIO_VALUE = 9999u;
+    /** @brief Invalid total energy and netto sink rate value */
+    static constexpr int16_t INVALID_SINK_RATE_VALUE = INT16_MAX;
 };
 
 namespace data
@@ -51,9 +72,30 @@ i_accelerometer_sensor::data get_accelerometer();
 /** @brief Get the sink rate */
 int16_t get_sink_rate();
 
+/** @brief Get the total energy sink rate */
+int16_t get_te_sink_rate();
+
+/** @brief Get the netto sink rate */
+int16_t get_netto_sink_rate();
+
 /** @brief Get the glide ratio */
 uint16_t get_glide_ratio();
 
+/** @brief Get the nearest airspace status */
+airspace_status get_airspace();
+
+/** @brief Get the terrain status */
+terrain_status get_terrain();
+
+/** @brief Get the task navigation status */
+navigation_status get_navigation();
+
+/** @brief Get the speed to fly and final glide status */
+polar_status get_polar();
+
+/** @brief Get the position propagated between the GNSS fixes */
+position_estimate get_position_estimate();
+
 // Setters
 
 /** @brief Set the GNSS data */
@@ -71,9 +113,33 @@ void set_accelerometer(const i_accelerometer_sensor::data& data);
 /** @brief Set the sink rate */
 void set_sink_rate(int16_t data);
 
+/** @brief Set the total energy and netto sink rates */
+void set_te_sink_rates(int16_t te_sink_rate, int16_t netto_sink_rate);
+
 /** @brief Set the sink rate */
 void set_glide_ratio(uint16_t data);
 
+/** @brief Set the nearest airspace status */
+void set_airspace(const airspace_status& data);
+
+/** @brief Invalidate the nearest airspace status */
+void invalidate_airspace();
+
+/** @brief Set the terrain status */
+void set_terrain(const terrain_status& data);
+
+/** @brief Set the task navigation status */
+void set_navigation(const navigation_status& data);
+
+/** @brief Invalidate the task navigation status */
+void invalidate_navigation();
+
+/** @brief Set the speed to fly and final glide status */
+void set_polar(const polar_status& data);
+
+/** @brief Set the position propagated between the GNSS fixes */
+void set_position_estimate(const position_estimate& data);
+
 } // namespace data
 } // namespace ov
 
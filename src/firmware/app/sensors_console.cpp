@@ -70,13 +70,16 @@ void sensors_console::alti_handler(const char*)
 /** @brief Handler for the 'alticalib' command */
 void sensors_console::alticalib_handler(const char* new_alti)
 {
-    auto  alti_data = ov::data::get_altimeter();
-    int   altitude  = atoi(new_alti) * 10;
-    auto& config    = ov::config::get();
+    auto alti_data = ov::data::get_altimeter();
+    int  altitude  = atoi(new_alti) * 10;
     m_altimeter.set_references(alti_data.temperature, alti_data.pressure, altitude);
-    config.alti_ref_temp     = alti_data.temperature;
-    config.alti_ref_pressure = alti_data.pressure;
-    config.alti_ref_alti     = altitude;
+
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
+    config.alti_ref_temp           = alti_data.temperature;
+    config.alti_ref_pressure       = alti_data.pressure;
+    config.alti_ref_alti           = altitude;
+    tr.commit(false);
 }
 
 /** @brief Handler for the 'accel' command */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "te_vario.h"
+#include "geodesy.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace ov
+{
+
+/** @brief Twice the standard gravity scaled for an energy height in 0.1m from a speed in 0.1m/s (1 = 0.001m/s²) */
+static constexpr uint64_t TWO_G = 196133u;
+
+/** @brief Constructor */
+te_vario::te_vario()
+    : m_energy_heights(),
+      m_period_ms(100u),
+      m_wind_correction(false),
+      m_airspeed(0u),
+      m_te_sink_rate(0),
+      m_is_wind_valid(false),
+      m_wind_speed(0u),
+      m_wind_direction(0u),
+      m_circling(false),
+      m_last_track(0),
+      m_circle_turn(0),
+      m_circle_start(0u),
+      m_circle_min_speed(0u),
+      m_circle_max_speed(0u),
+      m_circle_max_track(0u)
+{
+}
+
+/** @brief Set the window of the barometric sink rate : number of samples and sample period in milliseconds */
+void te_vario::set_window(size_t depth, uint32_t period_ms)
+{
+    // Restart computation on change
+    if ((depth != m_energy_heights.get_depth()) || (period_ms != m_period_ms))
+    {
+        if ((depth > 1u) && m_energy_heights.set_depth(depth))
+        {
+            m_period_ms = period_ms;
+        }
+        reset();
+    }
+}
+
+/** @brief Reset the computation, the wind estimation is kept */
+void te_vario::reset()
+{
+    m_energy_heights.reset();
+    m_te_sink_rate = 0;
+    m_circling     = false;
+}
+
+/** @brief Update the computation with a new sample */
+bool te_vario::update(const i_gnss::data& gnss, int16_t sink_rate, uint32_t timestamp)
+{
+    bool ret = false;
+
+    if (gnss.is_valid)
+    {
+        update_wind(gnss, timestamp);
+
+        // Airspeed, the wind vector is removed from the ground speed vector
+        m_airspeed = gnss.speed;
+        if (m_wind_correction && m_is_wind_valid)
+        {
+            const float   ground_speed = static_cast<float>(gnss.speed);
+            const float   wind_speed   = static_cast<float>(m_wind_speed);
+            const int32_t delta_track  = static_cast<int32_t>(gnss.track_angle) - static_cast<int32_t>(m_wind_direction);
+            const float   angle        = static_cast<float>(delta_track) * geo::DEG_TO_RAD / 10.f;
+            const float   cross        = 2.f * ground_speed * wind_speed * std::cos(angle);
+            const float   square       = ground_speed * ground_speed + wind_speed * wind_speed - cross;
+            m_airspeed                 = (square > 0.f) ? static_cast<uint32_t>(std::lround(std::sqrt(square))) : 0u;
+        }
+
+        // Energy height v²/2g
+        const int32_t energy_height = static_cast<int32_t>((static_cast<uint64_t>(m_airspeed) * m_airspeed * 1000u) / TWO_G);
+
+        // Compute the energy height variation once the window is filled
+        m_energy_heights.add_value(energy_height);
+        if (m_energy_heights.is_full())
+        {
+            // The oldest value has been stored (depth - 1) periods ago, a gain of kinetic energy is a loss of height
+            const int32_t delta_height = energy_height - m_energy_heights.get_oldest_value();
+            const int32_t delta_time   = static_cast<int32_t>((m_energy_heights.get_depth() - 1u) * m_period_ms);
+            int32_t       te_sink_rate = static_cast<int32_t>(sink_rate) + (delta_height * 1000) / delta_time;
+            if (te_sink_rate > std::numeric_limits<int16_t>::max() - 1)
+            {
+                te_sink_rate = std::numeric_limits<int16_t>::max() - 1;
+            }
+            if (te_sink_rate < std::numeric_limits<int16_t>::min())
+            {
+                te_sink_rate = std::numeric_limits<int16_t>::min();
+            }
+            m_te_sink_rate = static_cast<int16_t>(te_sink_rate);
+            ret            = true;
+        }
+    }
+    else
+    {
+        // The energy height history is not continuous anymore
+        reset();
+    }
+
+    return ret;
+}
+
+/** @brief Get the netto sink rate, the sink of the polar at the estimated airspeed is removed from a total energy sink rate */
+int16_t te_vario::get_netto_sink_rate(int16_t te_sink_rate, const speed_to_fly& polar) const
+{
+    int32_t netto = static_cast<int32_t>(te_sink_rate) - polar.get_sink(m_airspeed);
+    if (netto > std::numeric_limits<int16_t>::max() - 1)
+    {
+        netto = std::numeric_limits<int16_t>::max() - 1;
+    }
+    if (netto < std::numeric_limits<int16_t>::min())
+    {
+        netto = std::numeric_limits<int16_t>::min();
+    }
+    return static_cast<int16_t>(netto);
+}
+
+/** @brief Update the wind estimation with new GNSS data */
+void te_vario::update_wind(const i_gnss::data& gnss, uint32_t timestamp)
+{
+    if (gnss.speed < MIN_TRACK_SPEED)
+    {
+        // Track angle is meaningless at low speed
+        m_circling = false;
+    }
+    else if (!m_circling)
+    {
+        start_circle(gnss, timestamp);
+    }
+    else
+    {
+        // Turn since the previous data in [-180°, 180°[
+        const int32_t track = static_cast<int32_t>(gnss.track_angle);
+        int32_t       turn  = track - m_last_track;
+        if (turn >= 1800)
+        {
+            turn -= 3600;
+        }
+        if (turn < -1800)
+        {
+            turn += 3600;
+        }
+        m_last_track = track;
+
+        // A circle must be flown in the same direction and in a limited time
+        if (((turn > 0) && (m_circle_turn < 0)) || ((turn < 0) && (m_circle_turn > 0)) ||
+            ((timestamp - m_circle_start) > MAX_CIRCLE_DURATION_MS))
+        {
+            start_circle(gnss, timestamp);
+        }
+        else
+        {
+            m_circle_turn += turn;
+            if (gnss.speed < m_circle_min_speed)
+            {
+                m_circle_min_speed = gnss.speed;
+            }
+            if (gnss.speed > m_circle_max_speed)
+            {
+                m_circle_max_speed = gnss.speed;
+                m_circle_max_track = gnss.track_angle;
+            }
+
+            // On a full circle the ground speed is maximal downwind and minimal upwind
+            if (std::abs(m_circle_turn) >= WIND_CIRCLE_ANGLE)
+            {
+                m_wind_speed     = (m_circle_max_speed - m_circle_min_speed) / 2u;
+                m_wind_direction = m_circle_max_track;
+                m_is_wind_valid  = true;
+                start_circle(gnss, timestamp);
+            }
+        }
+    }
+}
+
+/** @brief Start a new circle */
+void te_vario::start_circle(const i_gnss::data& gnss, uint32_t timestamp)
+{
+    m_circling         = true;
+    m_last_track       = static_cast<int32_t>(gnss.track_angle);
+    m_circle_turn      = 0;
+    m_circle_start     = timestamp;
+    m_circle_min_speed = gnss.speed;
+    m_circle_max_speed = gnss.speed;
+    m_circle_max_track = gnss.track_angle;
+}
+
+} // namespace ov
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TE_VARIO_H
+#define OV_TE_VARIO_H
+
+#include "delay_line.h"
+#include "i_gnss.h"
+#include "speed_to_fly.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Total energy compensation of the barometric sink rate
+ *        The kinetic energy is converted into an energy height v²/2g which is differentiated over the same window
+ *        as the barometric sink rate so that both terms are in phase, the update is O(1) per sample.
+ *        The GNSS speed is used as airspeed, it can be corrected by the wind estimated from the ground speed
+ *        variations over a full circle
+ */
+class te_vario
+{
+  public:
+    /** @brief Maximum number of samples in the window (10s at the 100ms acquisition period) */
+    static constexpr size_t MAX_DEPTH = 100u;
+    /** @brief Minimum turn in the same direction to estimate the wind (1 = 0.1°) */
+    static constexpr int32_t WIND_CIRCLE_ANGLE = 3600;
+    /** @brief Maximum duration of a circle to estimate the wind in milliseconds */
+    static constexpr uint32_t MAX_CIRCLE_DURATION_MS = 60000u;
+    /** @brief Minimum ground speed for the track angle to be meaningful (1 = 0.1m/s) */
+    static constexpr uint32_t MIN_TRACK_SPEED = 30u;
+
+    /** @brief Constructor */
+    te_vario();
+
+    /** @brief Set the window of the barometric sink rate : number of samples and sample period in milliseconds */
+    void set_window(size_t depth, uint32_t period_ms);
+
+    /** @brief Enable or disable the wind correction of the airspeed */
+    void set_wind_correction(bool enabled) { m_wind_correction = enabled; }
+
+    /** @brief Reset the computation, the wind estimation is kept */
+    void reset();
+
+    /**
+     * @brief Update the computation with a new sample
+     * @param gnss GNSS data
+     * @param sink_rate Barometric sink rate over the window (1 = 0.1m/s)
+     * @param timestamp Timestamp of the sample in milliseconds
+     * @return true if the total energy sink rate is valid
+     */
+    bool update(const i_gnss::data& gnss, int16_t sink_rate, uint32_t timestamp);
+
+    /** @brief Get the total energy sink rate (1 = 0.1m/s) */
+    int16_t get_te_sink_rate() const { return m_te_sink_rate; }
+
+    /**
+     * @brief Get the netto sink rate, the sink of the polar at the estimated airspeed is removed from a total energy sink rate
+     * @param te_sink_rate Total energy sink rate (1 = 0.1m/s)
+     * @param polar Speed to fly computation of the selected polar, it must be valid
+     * @return Netto sink rate (1 = 0.1m/s)
+     */
+    int16_t get_netto_sink_rate(int16_t te_sink_rate, const speed_to_fly& polar) const;
+
+    /** @brief Get the estimated airspeed (1 = 0.1m/s) */
+    uint32_t get_airspeed() const { return m_airspeed; }
+
+    /** @brief Indicate if the wind has been estimated */
+    bool is_wind_valid() const { return m_is_wind_valid; }
+
+  private:
+    /** @brief Energy heights of the window (1 = 0.1m) */
+    delay_line<int32_t, MAX_DEPTH> m_energy_heights;
+    /** @brief Sample period in milliseconds */
+    uint32_t m_period_ms;
+    /** @brief Indicate if the wind correction is enabled */
+    bool m_wind_correction;
+    /** @brief Estimated airspeed (1 = 0.1m/s) */
+    uint32_t m_airspeed;
+    /** @brief Total energy sink rate (1 = 0.1m/s) */
+    int16_t m_te_sink_rate;
+
+    /** @brief Indicate if the wind has been estimated */
+    bool m_is_wind_valid;
+    /** @brief Wind speed (1 = 0.1m/s) */
+    uint32_t m_wind_speed;
+    /** @brief Direction the wind is blowing to (1 = 0.1°) */
+    uint16_t m_wind_direction;
+    /** @brief Indicate if a circle is in progress */
+    bool m_circling;
+    /** @brief Track angle of the previous GNSS data (1 = 0.1°) */
+    int32_t m_last_track;
+    /** @brief Turn accumulated in the same direction since the start of the circle (1 = 0.1°) */
+    int32_t m_circle_turn;
+    /** @brief Start time of the circle in milliseconds */
+    uint32_t m_circle_start;
+    /** @brief Minimum ground speed during the circle (1 = 0.1m/s) */
+    uint32_t m_circle_min_speed;
+    /** @brief Maximum ground speed during the circle (1 = 0.1m/s) */
+    uint32_t m_circle_max_speed;
+    /** @brief Track angle at the maximum ground speed (1 = 0.1°) */
+    uint16_t m_circle_max_track;
+
+    /** @brief Update the wind estimation with new GNSS data */
+    void update_wind(const i_gnss::data& gnss, uint32_t timestamp);
+
+    /** @brief Start a new circle */
+    void start_circle(const i_gnss::data& gnss, uint32_t timestamp);
+};
+
+} // namespace ov
+
+#endif // OV_TE_VARIO_H
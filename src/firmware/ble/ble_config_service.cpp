@@ -131,7 +131,7 @@ ble_config_service::ble_config_service()
 /** @brief Set the initial values of the characteristics */
 void ble_config_service::set_init_values()
 {
-    auto& config = ov::config::get();
+    const ov_config config = ov::config::get();
     m_device_name_char.update_value(config.device_name);
     m_glider1_name_char.update_value(config.glider1_name);
     m_glider2_name_char.update_value(config.glider2_name);
@@ -163,46 +163,51 @@ bool ble_config_service::save_config_handler(const uint32_t& new_value)
 /** @brief Event handler for the device's name characteristic */
 bool ble_config_service::device_name_handler(const char* new_value)
 {
-    auto& config = ov::config::get();
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
     memset(config.device_name, 0, sizeof(config.device_name));
-    strcpy(config.device_name, new_value);
-    return true;
+    strncpy(config.device_name, new_value, sizeof(config.device_name) - 1u);
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the glider 1's name characteristic */
 bool ble_config_service::glider1_name_handler(const char* new_value)
 {
-    auto& config = ov::config::get();
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
     memset(config.glider1_name, 0, sizeof(config.glider1_name));
-    strcpy(config.glider1_name, new_value);
-    return true;
+    strncpy(config.glider1_name, new_value, sizeof(config.glider1_name) - 1u);
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the glider 2's name characteristic */
 bool ble_config_service::glider2_name_handler(const char* new_value)
 {
-    auto& config = ov::config::get();
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
     memset(config.glider2_name, 0, sizeof(config.glider2_name));
-    strcpy(config.glider2_name, new_value);
-    return true;
+    strncpy(config.glider2_name, new_value, sizeof(config.glider2_name) - 1u);
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the glider 3's name characteristic */
 bool ble_config_service::glider3_name_handler(const char* new_value)
 {
-    auto& config = ov::config::get();
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
     memset(config.glider3_name, 0, sizeof(config.glider3_name));
-    strcpy(config.glider3_name, new_value);
-    return true;
+    strncpy(config.glider3_name, new_value, sizeof(config.glider3_name) - 1u);
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the glider 4's name characteristic */
 bool ble_config_service::glider4_name_handler(const char* new_value)
 {
-    auto& config = ov::config::get();
+    ov::config::transaction tr;
+    auto&                   config = tr.values();
     memset(config.glider4_name, 0, sizeof(config.glider4_name));
-    strcpy(config.glider4_name, new_value);
-    return true;
+    strncpy(config.glider4_name, new_value, sizeof(config.glider4_name) - 1u);
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the selected glider characteristic */
@@ -211,9 +216,9 @@ bool ble_config_service::selected_glider_handler(const uint8_t& new_value)
     bool ret = false;
     if ((new_value > 0) && (new_value <= 4u))
     {
-        auto& config  = ov::config::get();
-        config.glider = new_value;
-        ret           = true;
+        ov::config::transaction tr;
+        tr.values().glider = new_value;
+        ret                = tr.commit(false);
     }
     return ret;
 }
@@ -221,12 +226,12 @@ bool ble_config_service::selected_glider_handler(const uint8_t& new_value)
 /** @brief Event handler for the sink rate integration time characteristic */
 bool ble_config_service::sr_integ_time_char_handler(const uint32_t& new_value)
 {
-    bool  ret    = false;
-    auto& config = ov::config::get();
+    bool ret = false;
     if ((new_value >= 100u) && (new_value <= 10000u))
     {
-        config.sr_integ_time = new_value;
-        ret                  = true;
+        ov::config::transaction tr;
+        tr.values().sr_integ_time = new_value;
+        ret                       = tr.commit(false);
     }
     return ret;
 }
@@ -234,12 +239,12 @@ bool ble_config_service::sr_integ_time_char_handler(const uint32_t& new_value)
 /** @brief Event handler for the glide ratio integration time characteristic */
 bool ble_config_service::gr_integ_time_char_handler(const uint32_t& new_value)
 {
-    bool  ret    = false;
-    auto& config = ov::config::get();
+    bool ret = false;
     if ((new_value >= 1000u) && (new_value <= 15000u))
     {
-        config.gr_integ_time = new_value;
-        ret                  = true;
+        ov::config::transaction tr;
+        tr.values().gr_integ_time = new_value;
+        ret                       = tr.commit(false);
     }
     return ret;
 }
@@ -247,17 +252,17 @@ bool ble_config_service::gr_integ_time_char_handler(const uint32_t& new_value)
 /** @brief Event handler for the night mode characteristic */
 bool ble_config_service::is_night_mode_on_char_handler(const bool& new_value)
 {
-    auto& config            = ov::config::get();
-    config.is_night_mode_on = new_value;
-    return true;
+    ov::config::transaction tr;
+    tr.values().is_night_mode_on = new_value;
+    return tr.commit(false);
 }
 
 /** @brief Event handler for the display screen saver timeout characteristic */
 bool ble_config_service::disp_saver_timeout_handler(const uint32_t& new_value)
 {
-    auto& config              = ov::config::get();
-    config.disp_saver_timeout = new_value;
-    return true;
+    ov::config::transaction tr;
+    tr.values().disp_saver_timeout = new_value;
+    return tr.commit(false);
 }
 
 } // namespace ov
@@ -18,6 +18,9 @@ class ble_config_service
     /** @brief Get the BLE service */
     i_ble_service& get_service() { return m_service; }
 
+    /** @brief Get the number of characteristics of the service */
+    static constexpr size_t get_chars_count() { return m_chars_count; }
+
     /** @brief Set the initial values of the characteristics */
     void set_init_values();
 
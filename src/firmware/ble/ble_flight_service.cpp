@@ -0,0 +1,444 @@
+
+#include "ble_flight_service.h"
+#include "flight_catalog.h"
+#include "fs.h"
+#include "i_flight_recorder.h"
+#include "lock_guard.h"
+#include "os.h"
+#include "text_writer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief UUID of the service */
+static const uint8_t BLE_FLIGHT_SERVICE_UUID[] = {
+    0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x67u, 0x00u, 0x01u};
+
+/** @brief UUID of the control characteristic */
+static const uint8_t CONTROL_CHAR_UUID[] = {
+    0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x67u, 0x01u, 0x01u};
+
+/** @brief UUID of the status characteristic */
+static const uint8_t STATUS_CHAR_UUID[] = {
+    0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x67u, 0x02u, 0x01u};
+
+/** @brief UUID of the data characteristic */
+static const uint8_t DATA_CHAR_UUID[] = {
+    0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x67u, 0x03u, 0x01u};
+
+/** @brief Delay before retrying to queue a status notification (ms) */
+static constexpr uint32_t STATUS_RETRY_PERIOD = 10u;
+
+/** @brief Constructor, the wake semaphore is signaled when notifications are waiting to be sent */
+ble_flight_service::ble_flight_service(semaphore& wake_sem)
+    : m_service("Flight download service", BLE_FLIGHT_SERVICE_UUID, m_chars, m_chars_count),
+      m_control_char(m_service, "Control", CONTROL_CHAR_UUID, MAX_COMMAND_SIZE, i_ble_characteristic::properties::write),
+      m_status_char(m_service, "Status", STATUS_CHAR_UUID, MAX_STATUS_SIZE, i_ble_characteristic::properties::notify),
+      m_data_char(m_service, "Data", DATA_CHAR_UUID, i_ble_stack::MAX_NOTIFICATION_SIZE, i_ble_characteristic::properties::notify),
+      m_is_connected(false),
+      m_mutex(),
+      m_wake_sem(wake_sem),
+      m_reader_sem(0u, 1u),
+      m_transfer(),
+      m_command(command::none),
+      m_command_index(0u),
+      m_command_offset(0u),
+      m_command_window(0u),
+      m_status_frames(),
+      m_file(),
+      m_read_offset(0u),
+      m_buffer{},
+      m_packet{},
+      m_thread()
+{
+    // Fill characteristics array
+    m_chars[0u] = &m_control_char;
+    m_chars[1u] = &m_status_char;
+    m_chars[2u] = &m_data_char;
+
+    // Register event handlers
+    m_control_char.register_app_event_handler(
+        i_ble_characteristic::event_handler::create<ble_flight_service, &ble_flight_service::control_handler>(*this));
+}
+
+/** @brief Start the read-ahead thread */
+bool ble_flight_service::init()
+{
+    auto thread_func = ov::thread_func::create<ble_flight_service, &ble_flight_service::thread_func>(*this);
+    bool ret         = m_thread.start(thread_func, "BLE FLT", 4u, nullptr);
+
+    return ret;
+}
+
+/** @brief Change the connection state, the transfer is aborted on disconnection */
+void ble_flight_service::set_connected(bool is_connected)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!is_connected)
+        {
+            m_transfer.abort();
+            m_command = command::none;
+            m_status_frames.clear();
+        }
+        m_is_connected = is_connected;
+    }
+    m_reader_sem.release();
+}
+
+/** @brief Send the pending notifications of up to the given size, return false if some notifications could not be sent */
+bool ble_flight_service::process(size_t max_size)
+{
+    bool sent = true;
+
+    // Status notifications
+    max_size = std::min(max_size, i_ble_stack::MAX_NOTIFICATION_SIZE);
+    while (sent)
+    {
+        status_frame frame = {};
+        size_t       count = 0u;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            const status_frame* oldest = m_status_frames.peek(count);
+            if (count != 0u)
+            {
+                frame = *oldest;
+            }
+        }
+        if (count == 0u)
+        {
+            break;
+        }
+        sent = m_status_char.update_value_from_app(frame.data, std::min<size_t>(frame.size, max_size));
+        if (sent)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_status_frames.drop(1u);
+        }
+    }
+
+    // Data notifications, in bursts up to the end of the window or of the data read ahead
+    while (sent && (max_size > DATA_HEADER_SIZE))
+    {
+        flight_transfer::packet p;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            uint32_t now = os::now();
+            m_transfer.check_timeout(now);
+            if (!m_transfer.next_packet(max_size - DATA_HEADER_SIZE, m_read_offset, now, p))
+            {
+                break;
+            }
+
+            // The data of the packet cannot be overwritten until it has been acknowledged
+            memcpy(&m_packet[0u], &p.sequence, sizeof(p.sequence));
+            memcpy(&m_packet[2u], &p.offset, sizeof(p.offset));
+            size_t index      = p.offset % BUFFER_SIZE;
+            size_t first_part = std::min(p.size, BUFFER_SIZE - index);
+            memcpy(&m_packet[DATA_HEADER_SIZE], &m_buffer[index], first_part);
+            memcpy(&m_packet[DATA_HEADER_SIZE + first_part], &m_buffer[0u], p.size - first_part);
+        }
+        sent = m_data_char.update_value_from_app(m_packet, DATA_HEADER_SIZE + p.size);
+        if (!sent)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_transfer.cancel_packet(p);
+        }
+    }
+
+    return sent;
+}
+
+/** @brief Read-ahead thread */
+void ble_flight_service::thread_func(void*)
+{
+    // Thread loop
+    while (true)
+    {
+        // Wait for a command or for room in the read-ahead buffer
+        m_reader_sem.take();
+
+        // Get the pending command
+        command  cmd    = command::none;
+        uint16_t index  = 0u;
+        uint32_t offset = 0u;
+        uint8_t  window = 0u;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            cmd       = m_command;
+            index     = m_command_index;
+            offset    = m_command_offset;
+            window    = m_command_window;
+            m_command = command::none;
+        }
+
+        // Execute it
+        switch (cmd)
+        {
+            case command::list:
+                list_flights(index);
+                break;
+
+            case command::start:
+                start_transfer(index, offset, window);
+                break;
+
+            default:
+                // Nothing to do
+                break;
+        }
+
+        // Fill the read-ahead buffer
+        read_ahead();
+    }
+}
+
+/** @brief Send the flights of the catalog starting from an index */
+void ble_flight_service::list_flights(uint16_t first)
+{
+    flight_catalog::reader catalog;
+    uint16_t               count = static_cast<uint16_t>(catalog.is_open() ? catalog.get_count() : 0u);
+    if ((first < count) && catalog.seek(first))
+    {
+        flight_catalog::summary flight;
+        for (uint16_t index = first; (index < count) && m_is_connected && catalog.read(flight); index++)
+        {
+            uint8_t frame[MAX_STATUS_SIZE];
+            frame[0u] = static_cast<uint8_t>(status::list_entry);
+            memcpy(&frame[1u], &index, sizeof(index));
+            memcpy(&frame[3u], &count, sizeof(count));
+            memcpy(&frame[5u], &flight.size, sizeof(flight.size));
+            size_t name_size = strnlen(flight.name, std::min(sizeof(flight.name), MAX_STATUS_SIZE - 9u));
+            memcpy(&frame[9u], flight.name, name_size);
+            push_status_wait(frame, 9u + name_size);
+        }
+    }
+
+    uint8_t frame[3u] = {static_cast<uint8_t>(status::list_end)};
+    memcpy(&frame[1u], &count, sizeof(count));
+    push_status_wait(frame, sizeof(frame));
+}
+
+/** @brief Open a flight file and start its download */
+void ble_flight_service::start_transfer(uint16_t index, uint32_t offset, uint8_t window)
+{
+    // Stop the previous download
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_transfer.abort();
+    }
+    m_file.close();
+
+    // Open the flight file
+    flight_catalog::reader  catalog;
+    flight_catalog::summary flight;
+    char                    path[64u];
+    text_writer             writer(path);
+    bool                    ret = catalog.is_open() && catalog.seek(index) && catalog.read(flight);
+    if (ret)
+    {
+        flight.name[sizeof(flight.name) - 1u] = 0;
+        writer.write(i_flight_recorder::RECORDED_DATA_DIR).write('/').write(flight.name);
+        ret = !writer.is_truncated() && fs::open(m_file, path, fs::o_rdonly);
+    }
+    int32_t file_size = 0;
+    ret               = ret && m_file.seek(0, file::seek_end, file_size);
+
+    // Start the transfer, the resume offset is ignored if it is outside of the file
+    uint32_t start_offset = 0u;
+    if (ret)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_transfer.start(static_cast<uint32_t>(file_size), offset, window, os::now());
+        start_offset  = m_transfer.get_acked_offset();
+        m_read_offset = start_offset;
+    }
+    int32_t new_offset = 0;
+    ret                = ret && m_file.seek(static_cast<int32_t>(start_offset), file::seek_set, new_offset);
+    if (!ret)
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_transfer.abort();
+    }
+
+    uint8_t frame[12u] = {static_cast<uint8_t>(status::started), static_cast<uint8_t>(ret ? 0u : 1u)};
+    memcpy(&frame[2u], &index, sizeof(index));
+    memcpy(&frame[4u], &file_size, sizeof(file_size));
+    memcpy(&frame[8u], &start_offset, sizeof(start_offset));
+    push_status_wait(frame, sizeof(frame));
+
+    // Nothing to send if the whole file has already been received
+    lock_guard<mutex> lock(m_mutex);
+    if (ret && (m_transfer.get_state() == flight_transfer::state::completed))
+    {
+        push_completed(os::now());
+    }
+}
+
+/** @brief Read the file into the free space of the read-ahead buffer */
+void ble_flight_service::read_ahead()
+{
+    bool transferring = true;
+    while (transferring)
+    {
+        // Room left in the buffer, the data from the acknowledged offset must be kept for the retransmissions
+        size_t   size        = 0u;
+        uint32_t read_offset = 0u;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            transferring = (m_transfer.get_state() == flight_transfer::state::transferring);
+            read_offset  = m_read_offset;
+            if (transferring)
+            {
+                size_t index = read_offset % BUFFER_SIZE;
+                size         = std::min(READ_SIZE, BUFFER_SIZE - index);
+                size         = std::min<size_t>(size, m_transfer.get_acked_offset() + BUFFER_SIZE - read_offset);
+                size         = std::min<size_t>(size, m_transfer.get_file_size() - read_offset);
+            }
+        }
+        if (!transferring || (size == 0u))
+        {
+            break;
+        }
+
+        // Read outside of the lock, the free space of the buffer is not used by the notifications
+        size_t read_count = 0u;
+        if (m_file.read(&m_buffer[read_offset % BUFFER_SIZE], size, read_count) && (read_count != 0u))
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_read_offset += static_cast<uint32_t>(read_count);
+            }
+            m_wake_sem.release();
+        }
+        else
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_transfer.abort();
+            transferring = false;
+        }
+    }
+
+    // Release the file at the end of the transfer
+    if (!transferring && m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+/** @brief Queue a status notification, the mutex must be held */
+bool ble_flight_service::push_status(const uint8_t* data, size_t size)
+{
+    status_frame frame;
+    frame.size = static_cast<uint8_t>(std::min(size, MAX_STATUS_SIZE));
+    memcpy(frame.data, data, frame.size);
+
+    bool ret = m_status_frames.write(frame);
+    if (ret)
+    {
+        m_wake_sem.release();
+    }
+    return ret;
+}
+
+/** @brief Queue a status notification, waiting for room while a device is connected */
+void ble_flight_service::push_status_wait(const uint8_t* data, size_t size)
+{
+    bool pushed = false;
+    while (!pushed && m_is_connected)
+    {
+        {
+            lock_guard<mutex> lock(m_mutex);
+            pushed = push_status(data, size);
+        }
+        if (!pushed)
+        {
+            ov::this_thread::sleep_for(STATUS_RETRY_PERIOD);
+        }
+    }
+}
+
+/** @brief Queue the completed status notification, the mutex must be held */
+void ble_flight_service::push_completed(uint32_t now)
+{
+    const flight_transfer::stats stats = m_transfer.get_stats(now);
+
+    uint8_t frame[17u] = {static_cast<uint8_t>(status::completed)};
+    memcpy(&frame[1u], &stats.bytes_sent, sizeof(stats.bytes_sent));
+    memcpy(&frame[5u], &stats.bytes_retransmitted, sizeof(stats.bytes_retransmitted));
+    memcpy(&frame[9u], &stats.duration, sizeof(stats.duration));
+    memcpy(&frame[13u], &stats.throughput, sizeof(stats.throughput));
+    (void)push_status(frame, sizeof(frame));
+}
+
+/** @brief Event handler for the control characteristic */
+bool ble_flight_service::control_handler(i_ble_characteristic&, const void* new_value, size_t new_size)
+{
+    bool           ret  = false;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(new_value);
+
+    if ((new_value != nullptr) && (new_size != 0u))
+    {
+        lock_guard<mutex> lock(m_mutex);
+        switch (static_cast<command>(data[0u]))
+        {
+            case command::list:
+                if (new_size == 3u)
+                {
+                    m_command = command::list;
+                    memcpy(&m_command_index, &data[1u], sizeof(m_command_index));
+                    ret = true;
+                }
+                break;
+
+            case command::start:
+                if (new_size == 8u)
+                {
+                    m_command = command::start;
+                    memcpy(&m_command_index, &data[1u], sizeof(m_command_index));
+                    memcpy(&m_command_offset, &data[3u], sizeof(m_command_offset));
+                    m_command_window = data[7u];
+                    ret              = true;
+                }
+                break;
+
+            case command::ack:
+                if (new_size == 6u)
+                {
+                    // Handled right away so that the next burst can start
+                    uint32_t offset = 0u;
+                    memcpy(&offset, &data[1u], sizeof(offset));
+                    uint32_t now         = os::now();
+                    bool     was_running = (m_transfer.get_state() == flight_transfer::state::transferring);
+                    m_transfer.acknowledge(offset, ((data[5u] & 0x01u) != 0u), now);
+                    if (was_running && (m_transfer.get_state() == flight_transfer::state::completed))
+                    {
+                        push_completed(now);
+                    }
+                    m_wake_sem.release();
+                    ret = true;
+                }
+                break;
+
+            case command::abort:
+                m_transfer.abort();
+                ret = true;
+                break;
+
+            default:
+                // Unknown command
+                break;
+        }
+    }
+    if (ret)
+    {
+        m_reader_sem.release();
+    }
+
+    return ret;
+}
+
+} // namespace ov
@@ -0,0 +1,181 @@
+
+#ifndef OV_BLE_FLIGHT_SERVICE_H
+#define OV_BLE_FLIGHT_SERVICE_H
+
+#include "ble_characteristic.h"
+#include "ble_service.h"
+#include "file.h"
+#include "flight_transfer.h"
+#include "i_ble_stack.h"
+#include "mutex.h"
+#include "ring_buffer.h"
+#include "semaphore.h"
+#include "thread.h"
+
+namespace ov
+{
+
+/**
+ * @brief BLE flight download service
+ *        The central lists the recorded flights from the flight catalog and downloads a flight file in bursts of notifications,
+ *        the file is read ahead from the filesystem by a dedicated thread so that the notifications are never waiting for the flash
+ *
+ *        Commands written to the control characteristic (little endian) :
+ *          - list     : 0x01, first flight index (uint16)
+ *          - start    : 0x02, flight index (uint16), resume offset (uint32), window in packets (uint8, 0 = maximum)
+ *          - ack      : 0x03, offset received without gap (uint32), flags (uint8, bit 0 = retransmission request)
+ *          - abort    : 0x04
+ *        Status notifications :
+ *          - list entry : 0x81, flight index (uint16), flights count (uint16), file size (uint32), file name (truncated to the MTU)
+ *          - list end   : 0x82, flights count (uint16)
+ *          - started    : 0x83, result (uint8, 0 = success), flight index (uint16), file size (uint32), start offset (uint32)
+ *          - completed  : 0x84, bytes sent (uint32), bytes sent again (uint32), duration in ms (uint32), throughput in bytes/s (uint32)
+ *        Data notifications : sequence number (uint16), offset (uint32), file data
+ */
+class ble_flight_service
+{
+  public:
+    /** @brief Constructor, the wake semaphore is signaled when notifications are waiting to be sent */
+    ble_flight_service(semaphore& wake_sem);
+
+    /** @brief Start the read-ahead thread */
+    bool init();
+
+    /** @brief Get the BLE service */
+    i_ble_service& get_service() { return m_service; }
+
+    /** @brief Get the number of characteristics of the service */
+    static constexpr size_t get_chars_count() { return m_chars_count; }
+
+    /** @brief Change the connection state, the transfer is aborted on disconnection */
+    void set_connected(bool is_connected);
+
+    /** @brief Send the pending notifications of up to the given size, return false if some notifications could not be sent */
+    bool process(size_t max_size);
+
+  private:
+    /** @brief Size of the read-ahead buffer in bytes, it also keeps the unacknowledged data */
+    static constexpr size_t BUFFER_SIZE = 8192u;
+    /** @brief Size of a read from the filesystem in bytes */
+    static constexpr size_t READ_SIZE = 512u;
+    /** @brief Size of the header of a data notification (sequence number and offset) in bytes */
+    static constexpr size_t DATA_HEADER_SIZE = 6u;
+    /** @brief Maximum size of a command in bytes */
+    static constexpr size_t MAX_COMMAND_SIZE = 8u;
+    /** @brief Maximum size of a status notification in bytes */
+    static constexpr size_t MAX_STATUS_SIZE = 48u;
+
+    static_assert(BUFFER_SIZE >= (flight_transfer::MAX_WINDOW * (i_ble_stack::MAX_NOTIFICATION_SIZE - DATA_HEADER_SIZE)),
+                  "The read-ahead buffer must hold a full window of unacknowledged data");
+
+    /** @brief Commands */
+    enum class command : uint8_t
+    {
+        /** @brief No command */
+        none = 0x00u,
+        /** @brief List the flights */
+        list = 0x01u,
+        /** @brief Start a download */
+        start = 0x02u,
+        /** @brief Acknowledge the received data */
+        ack = 0x03u,
+        /** @brief Abort the download */
+        abort = 0x04u
+    };
+
+    /** @brief Status notifications */
+    enum class status : uint8_t
+    {
+        /** @brief Flight of the list */
+        list_entry = 0x81u,
+        /** @brief End of the list */
+        list_end = 0x82u,
+        /** @brief Download started */
+        started = 0x83u,
+        /** @brief Download completed */
+        completed = 0x84u
+    };
+
+    /** @brief Status notification waiting to be sent */
+    struct status_frame
+    {
+        /** @brief Size in bytes */
+        uint8_t size;
+        /** @brief Data */
+        uint8_t data[MAX_STATUS_SIZE];
+    };
+
+    /** @brief Number of characteristics */
+    static const size_t m_chars_count = 3u;
+    /** @brief Characteristics */
+    i_ble_characteristic* m_chars[m_chars_count];
+
+    /** @brief BLE service */
+    ble_service m_service;
+
+    /** @brief Control characteristic (written by the central) */
+    ble_characteristic_base m_control_char;
+    /** @brief Status characteristic */
+    ble_characteristic_base m_status_char;
+    /** @brief Data characteristic */
+    ble_characteristic_base m_data_char;
+
+    /** @brief Indicate if a device is connected */
+    volatile bool m_is_connected;
+    /** @brief Mutex to protect the transfer, the pending command and the status notifications */
+    mutex m_mutex;
+    /** @brief Signaled when notifications are waiting to be sent */
+    semaphore& m_wake_sem;
+    /** @brief Signaled when a command has been received or when room has been made in the read-ahead buffer */
+    semaphore m_reader_sem;
+    /** @brief Transfer state machine */
+    flight_transfer m_transfer;
+    /** @brief Pending command */
+    command m_command;
+    /** @brief Flight index of the pending command */
+    uint16_t m_command_index;
+    /** @brief Resume offset of the pending command */
+    uint32_t m_command_offset;
+    /** @brief Window of the pending command */
+    uint8_t m_command_window;
+    /** @brief Status notifications waiting to be sent */
+    ring_buffer<status_frame, 8u> m_status_frames;
+    /** @brief Flight file being downloaded */
+    file m_file;
+    /** @brief Offset up to which the file has been read into the read-ahead buffer */
+    uint32_t m_read_offset;
+    /** @brief Read-ahead buffer, file offset N is stored at index N % BUFFER_SIZE */
+    uint8_t m_buffer[BUFFER_SIZE];
+    /** @brief Data notification */
+    uint8_t m_packet[i_ble_stack::MAX_NOTIFICATION_SIZE];
+    /** @brief Read-ahead thread */
+    thread<2048u> m_thread;
+
+    /** @brief Read-ahead thread */
+    void thread_func(void*);
+
+    /** @brief Send the flights of the catalog starting from an index */
+    void list_flights(uint16_t first);
+
+    /** @brief Open a flight file and start its download */
+    void start_transfer(uint16_t index, uint32_t offset, uint8_t window);
+
+    /** @brief Read the file into the free space of the read-ahead buffer */
+    void read_ahead();
+
+    /** @brief Queue a status notification, the mutex must be held */
+    bool push_status(const uint8_t* data, size_t size);
+
+    /** @brief Queue a status notification, waiting for room while a device is connected */
+    void push_status_wait(const uint8_t* data, size_t size);
+
+    /** @brief Queue the completed status notification, the mutex must be held */
+    void push_completed(uint32_t now);
+
+    /** @brief Event handler for the control characteristic */
+    bool control_handler(i_ble_characteristic& characteristic, const void* new_value, size_t new_size);
+};
+
+} // namespace ov
+
+#endif // OV_BLE_FLIGHT_SERVICE_H
@@ -1,15 +1,35 @@
 
 #include "ble_manager.h"
+#include "os.h"
+#include "ov_config.h"
+
+#include <algorithm>
 
 namespace ov
 {
 
+static_assert((i_ble_stack::get_attribute_records(ble_config_service::get_chars_count()) +
+               i_ble_stack::get_attribute_records(ble_rt_data_service::get_chars_count()) +
+               i_ble_stack::get_attribute_records(ble_uart_service::get_chars_count()) +
+               i_ble_stack::get_attribute_records(ble_flight_service::get_chars_count())) <= i_ble_stack::MAX_ATTRIBUTE_RECORDS,
+              "The GATT database of the stack must hold the attribute records of all the services");
+
 /** @brief Constructor */
-ble_manager::ble_manager(i_ble_stack& ble_stack) : m_ble_stack(ble_stack), m_thread(), m_services(), m_config_service(), m_rt_data_service()
+ble_manager::ble_manager(i_ble_stack& ble_stack)
+    : m_ble_stack(ble_stack),
+      m_thread(),
+      m_wake_sem(0u, 1u),
+      m_services(),
+      m_config_service(),
+      m_rt_data_service(),
+      m_uart_service(m_wake_sem),
+      m_flight_service(m_wake_sem)
 {
     // Fill services array
     m_services[0u] = &m_config_service.get_service();
     m_services[1u] = &m_rt_data_service.get_service();
+    m_services[2u] = &m_uart_service.get_service();
+    m_services[3u] = &m_flight_service.get_service();
 }
 
 /** @brief Start the BLE manager */
@@ -17,6 +37,7 @@ bool ble_manager::start()
 {
     // Start BLE stack
     bool ret = m_ble_stack.start(m_services, sizeof(m_services) / sizeof(i_ble_service*));
+    ret      = ret && m_flight_service.init();
     if (ret)
     {
         // Start thread
@@ -40,13 +61,73 @@ void ble_manager::thread_func(void*)
     m_config_service.set_init_values();
 
     // Thread loop
+    bool     was_connected  = false;
+    uint32_t last_values    = 0u;
+    uint32_t last_telemetry = 0u;
+    uint32_t last_refresh   = 0u;
+    bool     pending        = false;
+    uint32_t config_version = 0u;
+    uint8_t  ble_rate       = ov::config::get(config_version).ble_rate;
     while (true)
     {
-        // Update characteristics
-        m_rt_data_service.update_values();
+        // Refresh the telemetry rate only when the configuration has changed
+        if (ov::config::get_version() != config_version)
+        {
+            ble_rate = ov::config::get(config_version).ble_rate;
+        }
+
+        // Update legacy characteristics
+        uint32_t now = ov::os::now();
+        if ((now - last_values) >= VALUES_PERIOD)
+        {
+            m_rt_data_service.update_values();
+            last_values = now;
+        }
+
+        // Track the connection state
+        bool is_connected = m_ble_stack.is_device_connected();
+        if (is_connected != was_connected)
+        {
+            m_uart_service.set_connected(is_connected);
+            m_flight_service.set_connected(is_connected);
+        }
+
+        const uint32_t rate             = std::clamp<uint32_t>(ble_rate, 1u, 10u);
+        const uint32_t telemetry_period = 1000u / rate;
+        if (is_connected)
+        {
+            const size_t max_size = m_ble_stack.get_att_mtu() - i_ble_stack::NOTIFICATION_HEADER_SIZE;
+
+            // Notify telemetry frames, all the fields are sent on connection and periodically
+            if (!was_connected || ((now - last_telemetry) >= telemetry_period))
+            {
+                bool refresh = !was_connected || ((now - last_refresh) >= REFRESH_PERIOD);
+                if (refresh)
+                {
+                    last_refresh = now;
+                }
+                m_rt_data_service.update_telemetry(max_size, refresh);
+                last_telemetry = now;
+            }
+
+            // Send the bytes written to the serial port and the flight download notifications
+            pending = !m_uart_service.flush(max_size);
+            pending = !m_flight_service.process(max_size) || pending;
+        }
+        was_connected = is_connected;
 
-        // Wait next period
-        ov::this_thread::sleep_for(500u);
+        // Wait for the next telemetry frame, the other notifications are sent as soon as they are ready
+        const uint32_t elapsed = ov::os::now() - last_telemetry;
+        const uint32_t timeout = (elapsed < telemetry_period) ? (telemetry_period - elapsed) : 0u;
+        if (is_connected && pending)
+        {
+            // Let the stack send the queued notifications before retrying
+            ov::this_thread::sleep_for(std::min(timeout, RETRY_PERIOD));
+        }
+        else
+        {
+            m_wake_sem.take(timeout);
+        }
     }
 }
 
@@ -3,10 +3,13 @@
 #define OV_BLE_MANAGER_H
 
 #include "i_ble_manager.h"
+#include "semaphore.h"
 #include "thread.h"
 
 #include "ble_config_service.h"
+#include "ble_flight_service.h"
 #include "ble_rt_data_service.h"
+#include "ble_uart_service.h"
 
 namespace ov
 {
@@ -27,18 +30,34 @@ class ble_manager : public i_ble_manager
     /** @brief Get the BLE stack */
     i_ble_stack& ble_stack() override { return m_ble_stack; }
 
+    /** @brief Get the BLE serial port */
+    i_serial& uart() override { return m_uart_service; }
+
   private:
     /** @brief BLE stack */
     i_ble_stack& m_ble_stack;
     /** @brief BLE update thread */
     thread<2048u> m_thread;
+    /** @brief Signaled when notifications are waiting to be sent */
+    semaphore m_wake_sem;
     /** @brief BLE services */
-    i_ble_service* m_services[2u];
+    i_ble_service* m_services[4u];
 
     /** @brief Configuration service */
     ble_config_service m_config_service;
     /** @brief Real-time data service */
     ble_rt_data_service m_rt_data_service;
+    /** @brief Serial port service */
+    ble_uart_service m_uart_service;
+    /** @brief Flight download service */
+    ble_flight_service m_flight_service;
+
+    /** @brief Period of the legacy characteristics update (ms) */
+    static constexpr uint32_t VALUES_PERIOD = 500u;
+    /** @brief Period of the telemetry refresh with all the fields (ms) */
+    static constexpr uint32_t REFRESH_PERIOD = 1000u;
+    /** @brief Delay before retrying to send the notifications when the stack is busy (ms) */
+    static constexpr uint32_t RETRY_PERIOD = 10u;
 
     /** @brief BLE update thread */
     void thread_func(void*);
@@ -1,8 +1,12 @@
 
 #include "ble_rt_data_service.h"
+#include "os.h"
 #include "ov_data.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 
 namespace ov
@@ -40,6 +44,35 @@ static const uint8_t SINK_RATE_CHAR_UUID[] = {
 static const uint8_t GLIDE_RATIO_CHAR_UUID[] = {
     0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x66u, 0x07u, 0x01u};
 
+/** @brief UUID of the telemetry frame characteristic */
+static const uint8_t TELEMETRY_CHAR_UUID[] = {
+    0x51u, 0x6Cu, 0x57u, 0x37u, 0x82u, 0x50u, 0x49u, 0x3Bu, 0xBBu, 0x95u, 0xB2u, 0xA1u, 0x6Fu, 0x66u, 0x08u, 0x01u};
+
+/** @brief Field of the telemetry frame */
+struct telemetry_field
+{
+    /** @brief Flag in the fields mask */
+    uint8_t flag;
+    /** @brief Offset of the value */
+    size_t offset;
+    /** @brief Size of the value in bytes */
+    size_t size;
+};
+
+/**
+ * @brief Fields of the telemetry frame, in frame order
+ *        Frame : sequence number (uint16), timestamp in ms (uint32), fields mask (uint8) then the fields of the mask, little endian
+ */
+template <typename T>
+static constexpr telemetry_field TELEMETRY_FIELDS[] = {{0x01u, offsetof(T, latitude), sizeof(T::latitude) + sizeof(T::longitude)},
+                                                       {0x02u, offsetof(T, speed), sizeof(T::speed)},
+                                                       {0x04u, offsetof(T, altitude), sizeof(T::altitude)},
+                                                       {0x08u, offsetof(T, total_accel), sizeof(T::total_accel)},
+                                                       {0x10u, offsetof(T, sink_rate), sizeof(T::sink_rate)},
+                                                       {0x20u, offsetof(T, glide_ratio), sizeof(T::glide_ratio)},
+                                                       {0x40u, offsetof(T, te_sink_rate), sizeof(T::te_sink_rate)},
+                                                       {0x80u, offsetof(T, netto_sink_rate), sizeof(T::netto_sink_rate)}};
+
 /** @brief Constructor */
 ble_rt_data_service::ble_rt_data_service()
     : m_service("Real-time data service", BLE_RT_DATA_SERVICE_UUID, m_chars, m_chars_count),
@@ -59,7 +92,15 @@ ble_rt_data_service::ble_rt_data_service()
       m_glide_ratio_char(m_service,
                          "Glide ratio",
                          GLIDE_RATIO_CHAR_UUID,
-                         i_ble_characteristic::properties::read | i_ble_characteristic::properties::notify)
+                         i_ble_characteristic::properties::read | i_ble_characteristic::properties::notify),
+      m_telemetry_char(m_service,
+                       "Telemetry",
+                       TELEMETRY_CHAR_UUID,
+                       MAX_TELEMETRY_SIZE,
+                       i_ble_characteristic::properties::read | i_ble_characteristic::properties::notify),
+      m_telemetry_sent{},
+      m_telemetry_changed(0u),
+      m_telemetry_sequence(0u)
 {
     // Fill characteristics array
     m_chars[0u] = &m_latitude_char;
@@ -69,6 +110,7 @@ ble_rt_data_service::ble_rt_data_service()
     m_chars[4u] = &m_total_accel_char;
     m_chars[5u] = &m_sink_rate_char;
     m_chars[6u] = &m_glide_ratio_char;
+    m_chars[7u] = &m_telemetry_char;
 }
 
 /** @brief Update the values of the characteristics */
@@ -115,4 +157,82 @@ void ble_rt_data_service::update_values()
     m_glide_ratio_char.update_value(data.glide_ratio);
 }
 
+/**
+ * @brief Notify the fields of the telemetry frame which changed since they were last sent
+ *        The frame is limited to the given size, the fields which do not fit are sent in the next frames
+ *        A refresh sends all the fields whether they changed or not
+ */
+void ble_rt_data_service::update_telemetry(size_t max_size, bool refresh)
+{
+    auto data = ov::data::get();
+
+    // Current values, invalid ones are set to their maximum value
+    telemetry_values values = {};
+    if (data.gnss.is_valid)
+    {
+        const auto position = data.gnss.get_position();
+        values.latitude     = position.latitude;
+        values.longitude    = position.longitude;
+        values.speed        = static_cast<uint16_t>(std::min<uint32_t>(data.gnss.speed, std::numeric_limits<uint16_t>::max() - 1u));
+    }
+    else
+    {
+        values.latitude  = std::numeric_limits<int32_t>::max();
+        values.longitude = std::numeric_limits<int32_t>::max();
+        values.speed     = std::numeric_limits<uint16_t>::max();
+    }
+    values.altitude        = data.altimeter.is_valid ? data.altimeter.altitude : std::numeric_limits<int32_t>::max();
+    values.total_accel     = data.accelerometer.is_valid ? data.accelerometer.total_accel : std::numeric_limits<int16_t>::max();
+    values.sink_rate       = data.sink_rate;
+    values.glide_ratio     = data.glide_ratio;
+    values.te_sink_rate    = data.te_sink_rate;
+    values.netto_sink_rate = data.netto_sink_rate;
+
+    // Flag the fields which changed since they were last sent
+    const uint8_t* new_values  = reinterpret_cast<const uint8_t*>(&values);
+    uint8_t*       sent_values = reinterpret_cast<uint8_t*>(&m_telemetry_sent);
+    for (const auto& field : TELEMETRY_FIELDS<telemetry_values>)
+    {
+        if (refresh || (memcmp(&new_values[field.offset], &sent_values[field.offset], field.size) != 0))
+        {
+            m_telemetry_changed |= field.flag;
+        }
+    }
+
+    // Pack the changed fields which fit in the frame
+    if (m_telemetry_changed != 0u)
+    {
+        uint8_t frame[MAX_TELEMETRY_SIZE];
+        uint8_t mask = 0u;
+        size_t  size = TELEMETRY_HEADER_SIZE;
+        for (const auto& field : TELEMETRY_FIELDS<telemetry_values>)
+        {
+            if (((m_telemetry_changed & field.flag) != 0u) && ((size + field.size) <= max_size))
+            {
+                memcpy(&frame[size], &new_values[field.offset], field.size);
+                size += field.size;
+                mask |= field.flag;
+            }
+        }
+        const uint32_t timestamp = ov::os::now();
+        memcpy(&frame[0u], &m_telemetry_sequence, sizeof(m_telemetry_sequence));
+        memcpy(&frame[2u], &timestamp, sizeof(timestamp));
+        frame[6u] = mask;
+
+        // Send the frame in a single notification
+        if ((mask != 0u) && m_telemetry_char.update_value_from_app(frame, size))
+        {
+            for (const auto& field : TELEMETRY_FIELDS<telemetry_values>)
+            {
+                if ((mask & field.flag) != 0u)
+                {
+                    memcpy(&sent_values[field.offset], &new_values[field.offset], field.size);
+                }
+            }
+            m_telemetry_changed &= static_cast<uint8_t>(~mask);
+            m_telemetry_sequence++;
+        }
+    }
+}
+
 } // namespace ov
@@ -18,12 +18,50 @@ class ble_rt_data_service
     /** @brief Get the BLE service */
     i_ble_service& get_service() { return m_service; }
 
+    /** @brief Get the number of characteristics of the service */
+    static constexpr size_t get_chars_count() { return m_chars_count; }
+
     /** @brief Update the values of the characteristics */
     void update_values();
 
+    /**
+     * @brief Notify the fields of the telemetry frame which changed since they were last sent
+     *        The frame is limited to the given size, the fields which do not fit are sent in the next frames
+     *        A refresh sends all the fields whether they changed or not
+     */
+    void update_telemetry(size_t max_size, bool refresh);
+
   private:
     /** @brief Number of characteristics */
-    static const size_t m_chars_count = 7u;
+    static const size_t m_chars_count = 8u;
+
+    /** @brief Size of the header of a telemetry frame (sequence number, timestamp and fields mask) in bytes */
+    static constexpr size_t TELEMETRY_HEADER_SIZE = 7u;
+    /** @brief Maximum size of a telemetry frame in bytes */
+    static constexpr size_t MAX_TELEMETRY_SIZE = TELEMETRY_HEADER_SIZE + 24u;
+
+    /** @brief Values of the fields of a telemetry frame */
+    struct telemetry_values
+    {
+        /** @brief Latitude (1 = 1e-7°) */
+        int32_t latitude;
+        /** @brief Longitude (1 = 1e-7°) */
+        int32_t longitude;
+        /** @brief Speed (1 = 0.1 m/s) */
+        uint16_t speed;
+        /** @brief Altitude (1 = 0.1m) */
+        int32_t altitude;
+        /** @brief Total acceleration (1000 = 1g) */
+        int16_t total_accel;
+        /** @brief Sink rate (1 = 0.1m/s) */
+        int16_t sink_rate;
+        /** @brief Glide ratio (1 = 0.1) */
+        uint16_t glide_ratio;
+        /** @brief Total energy sink rate (1 = 0.1m/s) */
+        int16_t te_sink_rate;
+        /** @brief Netto sink rate (1 = 0.1m/s) */
+        int16_t netto_sink_rate;
+    };
     /** @brief Characteristics */
     i_ble_characteristic* m_chars[m_chars_count];
 
@@ -44,6 +82,15 @@ class ble_rt_data_service
     ble_characteristic<int16_t> m_sink_rate_char;
     /** @brief Glide ratio characteristic characteristic */
     ble_characteristic<uint16_t> m_glide_ratio_char;
+    /** @brief Telemetry frame characteristic */
+    ble_characteristic_base m_telemetry_char;
+
+    /** @brief Values of the fields of the telemetry frame when they were last sent */
+    telemetry_values m_telemetry_sent;
+    /** @brief Fields of the telemetry frame which changed and have not been sent yet */
+    uint8_t m_telemetry_changed;
+    /** @brief Sequence number of the next telemetry frame */
+    uint16_t m_telemetry_sequence;
 };
 
 } // namespace ov
@@ -0,0 +1,208 @@
+
+#include "ble_uart_service.h"
+#include "lock_guard.h"
+
+#include <algorithm>
+
+namespace ov
+{
+
+/** @brief UUID of the service (6E400001-B5A3-F393-E0A9-E50E24DCCA9E) */
+static const uint8_t BLE_UART_SERVICE_UUID[] = {
+    0x9Eu, 0xCAu, 0xDCu, 0x24u, 0x0Eu, 0xE5u, 0xA9u, 0xE0u, 0x93u, 0xF3u, 0xA3u, 0xB5u, 0x01u, 0x00u, 0x40u, 0x6Eu};
+
+/** @brief UUID of the receive characteristic (6E400002-B5A3-F393-E0A9-E50E24DCCA9E) */
+static const uint8_t RX_CHAR_UUID[] = {
+    0x9Eu, 0xCAu, 0xDCu, 0x24u, 0x0Eu, 0xE5u, 0xA9u, 0xE0u, 0x93u, 0xF3u, 0xA3u, 0xB5u, 0x02u, 0x00u, 0x40u, 0x6Eu};
+
+/** @brief UUID of the transmit characteristic (6E400003-B5A3-F393-E0A9-E50E24DCCA9E) */
+static const uint8_t TX_CHAR_UUID[] = {
+    0x9Eu, 0xCAu, 0xDCu, 0x24u, 0x0Eu, 0xE5u, 0xA9u, 0xE0u, 0x93u, 0xF3u, 0xA3u, 0xB5u, 0x03u, 0x00u, 0x40u, 0x6Eu};
+
+/** @brief Constructor, the wake semaphore is signaled when bytes are waiting to be sent */
+ble_uart_service::ble_uart_service(semaphore& wake_sem)
+    : m_service("UART service", BLE_UART_SERVICE_UUID, m_chars, m_chars_count),
+      m_tx_char(m_service, "TX", TX_CHAR_UUID, i_ble_stack::MAX_NOTIFICATION_SIZE, i_ble_characteristic::properties::notify),
+      m_rx_char(m_service, "RX", RX_CHAR_UUID, i_ble_stack::MAX_NOTIFICATION_SIZE, i_ble_characteristic::properties::write),
+      m_is_connected(false),
+      m_mutex(),
+      m_wake_sem(wake_sem),
+      m_tx_buffer(),
+      m_rx_buffer(),
+      m_read(nullptr)
+{
+    // Fill characteristics array
+    m_chars[0u] = &m_rx_char;
+    m_chars[1u] = &m_tx_char;
+
+    // Register event handlers
+    m_rx_char.register_app_event_handler(
+        i_ble_characteristic::event_handler::create<ble_uart_service, &ble_uart_service::rx_handler>(*this));
+}
+
+/** @brief Change the connection state, the pending bytes are dropped on disconnection */
+void ble_uart_service::set_connected(bool is_connected)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (!is_connected)
+    {
+        m_tx_buffer.clear();
+        m_rx_buffer.clear();
+    }
+    m_is_connected = is_connected;
+}
+
+/** @brief Send the pending bytes in notifications of up to the given size, return false if some bytes could not be sent */
+bool ble_uart_service::flush(size_t max_size)
+{
+    max_size   = std::min(max_size, i_ble_stack::MAX_NOTIFICATION_SIZE);
+    bool sent  = true;
+    bool empty = false;
+    while (sent && !empty)
+    {
+        // Only this function removes bytes from the transmit ring so they can be sent in place
+        size_t         count = 0u;
+        const uint8_t* data  = nullptr;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            data = m_tx_buffer.peek(count);
+        }
+        count = std::min(count, max_size);
+        empty = (count == 0u);
+
+        // The bytes stay in the ring if the stack cannot queue the notification
+        if (!empty)
+        {
+            sent = m_tx_char.update_value_from_app(data, count);
+            if (sent)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_tx_buffer.drop(count);
+            }
+        }
+    }
+
+    return empty;
+}
+
+/**
+ * @brief Start an asynchronous read, the token completes when the requested number of bytes has been received
+ *        The buffer must remain valid until the completion of the token
+ */
+bool ble_uart_service::read_async(void* buffer, size_t size, completion_token& token)
+{
+    bool ret       = false;
+    bool completed = false;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if ((m_read == nullptr) && token.start())
+        {
+            completion_token::request& request = token.get_request();
+            request.data                       = reinterpret_cast<uint8_t*>(buffer);
+            request.size                       = size;
+
+            // Read the bytes already received, the missing ones will be received from the stack
+            completed = read_rx_buffer(token);
+            if (!completed)
+            {
+                m_read = &token;
+            }
+            ret = true;
+        }
+    }
+    if (completed)
+    {
+        token.complete(true);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Start an asynchronous write, it fails if no device is connected or if there is not enough room for all the bytes
+ *        The write completes as soon as its data has been copied into the transmit ring
+ */
+bool ble_uart_service::write_async(const void* buffer, size_t size, completion_token& token)
+{
+    bool ret = token.start();
+    if (ret)
+    {
+        // Writes are never split so that the sentences are not truncated when the link is too slow
+        bool success = false;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (m_is_connected && (m_tx_buffer.get_free_count() >= size))
+            {
+                m_tx_buffer.write(reinterpret_cast<const uint8_t*>(buffer), size);
+                success = true;
+            }
+        }
+        if (success)
+        {
+            m_wake_sem.release();
+        }
+        token.complete(success);
+    }
+
+    return ret;
+}
+
+/** @brief Cancel an asynchronous read or write which has not completed yet */
+void ble_uart_service::cancel(completion_token& token)
+{
+    bool cancelled = false;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_read == &token)
+        {
+            m_read    = nullptr;
+            cancelled = true;
+        }
+    }
+    if (cancelled)
+    {
+        token.complete(false);
+    }
+}
+
+/** @brief Copy the received bytes into the buffer of a read, return true if all the requested bytes have been copied */
+bool ble_uart_service::read_rx_buffer(completion_token& token)
+{
+    completion_token::request& request = token.get_request();
+    while ((request.size != 0u) && m_rx_buffer.read(*request.data))
+    {
+        // Next data
+        request.data++;
+        request.size--;
+    }
+
+    return (request.size == 0u);
+}
+
+/** @brief Event handler for the receive characteristic */
+bool ble_uart_service::rx_handler(i_ble_characteristic&, const void* new_value, size_t new_size)
+{
+    completion_token* completed = nullptr;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        // Bytes which do not fit in the receive ring are lost
+        m_rx_buffer.write(reinterpret_cast<const uint8_t*>(new_value), new_size);
+        if ((m_read != nullptr) && read_rx_buffer(*m_read))
+        {
+            completed = m_read;
+            m_read    = nullptr;
+        }
+    }
+    if (completed != nullptr)
+    {
+        completed->complete(true);
+    }
+
+    return true;
+}
+
+} // namespace ov
@@ -0,0 +1,89 @@
+
+#ifndef OV_BLE_UART_SERVICE_H
+#define OV_BLE_UART_SERVICE_H
+
+#include "ble_characteristic.h"
+#include "ble_service.h"
+#include "i_ble_stack.h"
+#include "i_serial.h"
+#include "mutex.h"
+#include "ring_buffer.h"
+#include "semaphore.h"
+
+namespace ov
+{
+
+/**
+ * @brief BLE serial port service compatible with the Nordic UART service used by the phone flight applications
+ *        The written bytes are coalesced into a transmit ring which is sent in notifications as large as the ATT MTU allows
+ */
+class ble_uart_service : public i_serial
+{
+  public:
+    /** @brief Constructor, the wake semaphore is signaled when bytes are waiting to be sent */
+    ble_uart_service(semaphore& wake_sem);
+
+    /** @brief Get the BLE service */
+    i_ble_service& get_service() { return m_service; }
+
+    /** @brief Get the number of characteristics of the service */
+    static constexpr size_t get_chars_count() { return m_chars_count; }
+
+    /** @brief Change the connection state, the pending bytes are dropped on disconnection */
+    void set_connected(bool is_connected);
+
+    /** @brief Send the pending bytes in notifications of up to the given size, return false if some bytes could not be sent */
+    bool flush(size_t max_size);
+
+    /**
+     * @brief Start an asynchronous read, the token completes when the requested number of bytes has been received
+     *        The buffer must remain valid until the completion of the token
+     */
+    bool read_async(void* buffer, size_t size, completion_token& token) override;
+
+    /**
+     * @brief Start an asynchronous write, it fails if no device is connected or if there is not enough room for all the bytes
+     *        The write completes as soon as its data has been copied into the transmit ring
+     */
+    bool write_async(const void* buffer, size_t size, completion_token& token) override;
+
+    /** @brief Cancel an asynchronous read or write which has not completed yet */
+    void cancel(completion_token& token) override;
+
+  private:
+    /** @brief Number of characteristics */
+    static const size_t m_chars_count = 2u;
+    /** @brief Characteristics */
+    i_ble_characteristic* m_chars[m_chars_count];
+
+    /** @brief BLE service */
+    ble_service m_service;
+
+    /** @brief Transmit characteristic (notified to the central) */
+    ble_characteristic_base m_tx_char;
+    /** @brief Receive characteristic (written by the central) */
+    ble_characteristic_base m_rx_char;
+
+    /** @brief Indicate if a device is connected */
+    volatile bool m_is_connected;
+    /** @brief Mutex to protect the buffers and the pending read */
+    mutex m_mutex;
+    /** @brief Signaled when bytes are written into the transmit ring */
+    semaphore& m_wake_sem;
+    /** @brief Transmit ring */
+    ring_buffer<uint8_t, 1024u> m_tx_buffer;
+    /** @brief Receive ring */
+    ring_buffer<uint8_t, 256u> m_rx_buffer;
+    /** @brief Pending read */
+    completion_token* m_read;
+
+    /** @brief Copy the received bytes into the buffer of a read, return true if all the requested bytes have been copied */
+    bool read_rx_buffer(completion_token& token);
+
+    /** @brief Event handler for the receive characteristic */
+    bool rx_handler(i_ble_characteristic& characteristic, const void* new_value, size_t new_size);
+};
+
+} // namespace ov
+
+#endif // OV_BLE_UART_SERVICE_H
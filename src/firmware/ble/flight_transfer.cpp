@@ -0,0 +1,203 @@
+
+#include "flight_transfer.h"
+
+namespace ov
+{
+
+/** @brief Constructor */
+flight_transfer::flight_transfer()
+    : m_state(state::idle),
+      m_file_size(0u),
+      m_start_offset(0u),
+      m_acked_offset(0u),
+      m_next_offset(0u),
+      m_sent_offset(0u),
+      m_previous_sent_offset(0u),
+      m_window(MAX_WINDOW),
+      m_in_flight{},
+      m_in_flight_count(0u),
+      m_sequence(0u),
+      m_start_time(0u),
+      m_end_time(0u),
+      m_ack_time(0u),
+      m_bytes_sent(0u),
+      m_bytes_retransmitted(0u)
+{
+}
+
+/** @brief Start a transfer, from the resume offset if it is inside the file */
+void flight_transfer::start(uint32_t file_size, uint32_t resume_offset, uint8_t window, uint32_t now)
+{
+    if (resume_offset > file_size)
+    {
+        resume_offset = 0u;
+    }
+    if ((window == 0u) || (window > MAX_WINDOW))
+    {
+        window = MAX_WINDOW;
+    }
+
+    m_state                = (resume_offset == file_size) ? state::completed : state::transferring;
+    m_file_size            = file_size;
+    m_start_offset         = resume_offset;
+    m_acked_offset         = resume_offset;
+    m_next_offset          = resume_offset;
+    m_sent_offset          = resume_offset;
+    m_previous_sent_offset = resume_offset;
+    m_window               = window;
+    m_in_flight_count      = 0u;
+    m_sequence             = 0u;
+    m_start_time           = now;
+    m_end_time             = now;
+    m_ack_time             = now;
+    m_bytes_sent           = 0u;
+    m_bytes_retransmitted  = 0u;
+}
+
+/** @brief Abort the transfer */
+void flight_transfer::abort()
+{
+    if (m_state == state::transferring)
+    {
+        m_state = state::aborted;
+    }
+}
+
+/**
+ * @brief Get the next packet to send, the file data is available up to the given offset
+ *        Return false if the window is full or if there is no data to send
+ */
+bool flight_transfer::next_packet(size_t max_size, uint32_t available_offset, uint32_t now, packet& p)
+{
+    bool ret = false;
+
+    if (available_offset > m_file_size)
+    {
+        available_offset = m_file_size;
+    }
+    if ((m_state == state::transferring) && (m_in_flight_count < m_window) && (m_next_offset < available_offset) && (max_size != 0u))
+    {
+        // Packets are as large as possible
+        size_t size = available_offset - m_next_offset;
+        if (size > max_size)
+        {
+            size = max_size;
+        }
+        p.sequence = m_sequence;
+        p.offset   = m_next_offset;
+        p.size     = size;
+
+        // The acknowledgement timeout starts with the first packet of the window
+        if (m_in_flight_count == 0u)
+        {
+            m_ack_time = now;
+        }
+        m_in_flight[m_in_flight_count] = m_next_offset + static_cast<uint32_t>(size);
+        m_in_flight_count++;
+        m_sequence++;
+        m_next_offset += static_cast<uint32_t>(size);
+        m_bytes_sent += static_cast<uint32_t>(size);
+        m_bytes_retransmitted += retransmitted_size(p);
+        m_previous_sent_offset = m_sent_offset;
+        if (m_next_offset > m_sent_offset)
+        {
+            m_sent_offset = m_next_offset;
+        }
+        ret = true;
+    }
+
+    return ret;
+}
+
+/** @brief Cancel the last packet returned by next_packet because it could not be sent */
+void flight_transfer::cancel_packet(const packet& p)
+{
+    if ((m_in_flight_count != 0u) && (m_in_flight[m_in_flight_count - 1u] == (p.offset + p.size)))
+    {
+        m_in_flight_count--;
+        m_sequence--;
+        m_next_offset = p.offset;
+        m_sent_offset = m_previous_sent_offset;
+        m_bytes_sent -= static_cast<uint32_t>(p.size);
+        m_bytes_retransmitted -= retransmitted_size(p);
+    }
+}
+
+/** @brief Handle an acknowledgement of the offset up to which the file has been received, and an optional retransmission request */
+void flight_transfer::acknowledge(uint32_t offset, bool retransmit, uint32_t now)
+{
+    if ((m_state == state::transferring) && (offset >= m_acked_offset) && (offset <= m_sent_offset))
+    {
+        // Release the acknowledged packets
+        uint8_t released = 0u;
+        while ((released < m_in_flight_count) && (m_in_flight[released] <= offset))
+        {
+            released++;
+        }
+        for (uint8_t i = released; i < m_in_flight_count; i++)
+        {
+            m_in_flight[i - released] = m_in_flight[i];
+        }
+        m_in_flight_count = static_cast<uint8_t>(m_in_flight_count - released);
+        m_acked_offset    = offset;
+        m_ack_time        = now;
+
+        if (m_acked_offset == m_file_size)
+        {
+            m_state    = state::completed;
+            m_end_time = now;
+        }
+        else if (retransmit || (m_next_offset < m_acked_offset))
+        {
+            // Packets have been lost
+            rewind(now);
+        }
+    }
+}
+
+/** @brief Check the acknowledgement timeout, return true if the unacknowledged packets must be sent again */
+bool flight_transfer::check_timeout(uint32_t now)
+{
+    bool ret = (m_state == state::transferring) && (m_in_flight_count != 0u) && ((now - m_ack_time) >= ACK_TIMEOUT);
+    if (ret)
+    {
+        rewind(now);
+    }
+    return ret;
+}
+
+/** @brief Get the statistics of the transfer */
+flight_transfer::stats flight_transfer::get_stats(uint32_t now) const
+{
+    stats ret               = {};
+    ret.bytes_sent          = m_bytes_sent;
+    ret.bytes_retransmitted = m_bytes_retransmitted;
+    ret.duration            = ((m_state == state::completed) ? m_end_time : now) - m_start_time;
+    if (ret.duration != 0u)
+    {
+        ret.throughput = static_cast<uint32_t>((static_cast<uint64_t>(m_acked_offset - m_start_offset) * 1000u) / ret.duration);
+    }
+    return ret;
+}
+
+/** @brief Get the part of a packet which had already been sent before it, the sent offset must not include the packet */
+uint32_t flight_transfer::retransmitted_size(const packet& p) const
+{
+    uint32_t ret = 0u;
+    if (p.offset < m_sent_offset)
+    {
+        const uint32_t end = p.offset + static_cast<uint32_t>(p.size);
+        ret                = ((end < m_sent_offset) ? end : m_sent_offset) - p.offset;
+    }
+    return ret;
+}
+
+/** @brief Restart the transfer from the acknowledged offset */
+void flight_transfer::rewind(uint32_t now)
+{
+    m_in_flight_count = 0u;
+    m_next_offset     = m_acked_offset;
+    m_ack_time        = now;
+}
+
+} // namespace ov
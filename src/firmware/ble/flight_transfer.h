@@ -0,0 +1,144 @@
+
+#ifndef OV_FLIGHT_TRANSFER_H
+#define OV_FLIGHT_TRANSFER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief State machine of a file transfer in numbered packets with a sliding acknowledgement window
+ *        The receiver acknowledges the offset up to which it has received the file without gap,
+ *        a retransmission request or a missing acknowledgement restarts the transfer from the acknowledged offset (go-back-N)
+ *        It does not depend on the OS or on the BLE stack, the current time is given by the caller
+ */
+class flight_transfer
+{
+  public:
+    /** @brief Maximum number of unacknowledged packets */
+    static constexpr uint8_t MAX_WINDOW = 32u;
+
+    /** @brief Duration without acknowledgement after which the unacknowledged packets are sent again (ms) */
+    static constexpr uint32_t ACK_TIMEOUT = 1000u;
+
+    /** @brief Transfer states */
+    enum class state : uint8_t
+    {
+        /** @brief No transfer */
+        idle,
+        /** @brief Transfer in progress */
+        transferring,
+        /** @brief All the file has been acknowledged */
+        completed,
+        /** @brief Transfer aborted */
+        aborted
+    };
+
+    /** @brief Packet to send */
+    struct packet
+    {
+        /** @brief Sequence number, incremented on each packet sent including the retransmissions */
+        uint16_t sequence;
+        /** @brief Offset of the data in the file */
+        uint32_t offset;
+        /** @brief Size of the data in bytes */
+        size_t size;
+    };
+
+    /** @brief Transfer statistics */
+    struct stats
+    {
+        /** @brief Number of bytes sent including the retransmissions */
+        uint32_t bytes_sent;
+        /** @brief Number of bytes sent again */
+        uint32_t bytes_retransmitted;
+        /** @brief Duration of the transfer (ms) */
+        uint32_t duration;
+        /** @brief Number of acknowledged bytes per second */
+        uint32_t throughput;
+    };
+
+    /** @brief Constructor */
+    flight_transfer();
+
+    /** @brief Start a transfer, from the resume offset if it is inside the file */
+    void start(uint32_t file_size, uint32_t resume_offset, uint8_t window, uint32_t now);
+
+    /** @brief Abort the transfer */
+    void abort();
+
+    /**
+     * @brief Get the next packet to send, the file data is available up to the given offset
+     *        Return false if the window is full or if there is no data to send
+     */
+    bool next_packet(size_t max_size, uint32_t available_offset, uint32_t now, packet& p);
+
+    /** @brief Cancel the last packet returned by next_packet because it could not be sent */
+    void cancel_packet(const packet& p);
+
+    /** @brief Handle an acknowledgement of the offset up to which the file has been received, and an optional retransmission request */
+    void acknowledge(uint32_t offset, bool retransmit, uint32_t now);
+
+    /** @brief Check the acknowledgement timeout, return true if the unacknowledged packets must be sent again */
+    bool check_timeout(uint32_t now);
+
+    /** @brief Get the state of the transfer */
+    state get_state() const { return m_state; }
+
+    /** @brief Get the size of the file */
+    uint32_t get_file_size() const { return m_file_size; }
+
+    /** @brief Get the offset up to which the file has been acknowledged */
+    uint32_t get_acked_offset() const { return m_acked_offset; }
+
+    /** @brief Get the offset of the next data to send */
+    uint32_t get_next_offset() const { return m_next_offset; }
+
+    /** @brief Get the statistics of the transfer */
+    stats get_stats(uint32_t now) const;
+
+  private:
+    /** @brief State of the transfer */
+    state m_state;
+    /** @brief Size of the file */
+    uint32_t m_file_size;
+    /** @brief Offset at which the transfer started */
+    uint32_t m_start_offset;
+    /** @brief Offset up to which the file has been acknowledged */
+    uint32_t m_acked_offset;
+    /** @brief Offset of the next data to send */
+    uint32_t m_next_offset;
+    /** @brief Highest offset sent */
+    uint32_t m_sent_offset;
+    /** @brief Highest offset sent before the last packet, restored when the last packet is cancelled */
+    uint32_t m_previous_sent_offset;
+    /** @brief Maximum number of unacknowledged packets */
+    uint8_t m_window;
+    /** @brief End offsets of the unacknowledged packets, oldest first */
+    uint32_t m_in_flight[MAX_WINDOW];
+    /** @brief Number of unacknowledged packets */
+    uint8_t m_in_flight_count;
+    /** @brief Sequence number of the next packet */
+    uint16_t m_sequence;
+    /** @brief Start time of the transfer */
+    uint32_t m_start_time;
+    /** @brief End time of the transfer */
+    uint32_t m_end_time;
+    /** @brief Time of the last acknowledgement or of the start of the transfer */
+    uint32_t m_ack_time;
+    /** @brief Number of bytes sent including the retransmissions */
+    uint32_t m_bytes_sent;
+    /** @brief Number of bytes sent again */
+    uint32_t m_bytes_retransmitted;
+
+    /** @brief Get the part of a packet which had already been sent before it */
+    uint32_t retransmitted_size(const packet& p) const;
+    /** @brief Restart the transfer from the acknowledged offset */
+    void rewind(uint32_t now);
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_TRANSFER_H
@@ -18,6 +18,21 @@ class i_ble_stack
     /** @brief Destructor */
     virtual ~i_ble_stack() { }
 
+    /** @brief Maximum ATT MTU supported by the stack */
+    static constexpr size_t MAX_ATT_MTU = 247u;
+
+    /** @brief Size of the ATT header of a notification in bytes */
+    static constexpr size_t NOTIFICATION_HEADER_SIZE = 3u;
+
+    /** @brief Maximum size of the value of a notification in bytes */
+    static constexpr size_t MAX_NOTIFICATION_SIZE = MAX_ATT_MTU - NOTIFICATION_HEADER_SIZE;
+
+    /** @brief Maximum number of GATT attribute records of the user services */
+    static constexpr size_t MAX_ATTRIBUTE_RECORDS = 76u;
+
+    /** @brief Get the number of GATT attribute records of a service : 1 for the service and 3 for each characteristic */
+    static constexpr size_t get_attribute_records(size_t chars_count) { return 1u + (3u * chars_count); }
+
     /** @brief Start the stack */
     virtual bool start(i_ble_service* services[], size_t services_count) = 0;
 
@@ -29,6 +44,9 @@ class i_ble_stack
 
     /** @brief Indicate if a device is connected */
     virtual bool is_device_connected() = 0;
+
+    /** @brief Get the ATT MTU negotiated with the connected device */
+    virtual uint16_t get_att_mtu() = 0;
 };
 
 } // namespace ov
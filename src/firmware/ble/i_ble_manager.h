@@ -3,6 +3,7 @@
 #define OV_I_BLE_MANAGER_H
 
 #include "i_ble_stack.h"
+#include "i_serial.h"
 
 namespace ov
 {
@@ -22,6 +23,9 @@ class i_ble_manager
 
     /** @brief Get the BLE stack */
     virtual i_ble_stack& ble_stack() = 0;
+
+    /** @brief Get the BLE serial port */
+    virtual i_serial& uart() = 0;
 };
 
 } // namespace ov
@@ -149,6 +149,11 @@ typedef struct
     uint8_t Advertising_mgr_timer_Id;
     /* USER CODE BEGIN PTD_1*/
 
+    /**
+   * ATT MTU negotiated on the current connection
+   */
+    uint16_t Att_Mtu;
+
     /* USER CODE END PTD_1 */
 } BleApplicationContext_t;
 
@@ -164,6 +169,8 @@ typedef struct
 #define BD_ADDR_SIZE_LOCAL 6
 
 /* USER CODE BEGIN PD */
+#define DLE_MAX_TX_OCTETS 251u  /**< Maximum link layer payload with data length extension */
+#define DLE_MAX_TX_TIME   2120u /**< Transmit time of the maximum link layer payload (us) */
 
 /* USER CODE END PD */
 
@@ -290,7 +297,7 @@ bool s_app_ble_is_ready = false;
 static void APP_BLE_Init(void)
 {
     // Device name
-    auto& ov_config = ov::config::get();
+    auto ov_config  = ov::config::get();
     a_LocalName[0u] = AD_TYPE_COMPLETE_LOCAL_NAME;
     memcpy(&a_LocalName[1u], ov_config.device_name, sizeof(ov_config.device_name));
     a_LocalName_size = strlen(a_LocalName);
@@ -375,6 +382,7 @@ static void APP_BLE_Init(void)
    */
     BleApplicationContext.Device_Connection_Status                      = APP_BLE_IDLE;
     BleApplicationContext.BleApplicationContext_legacy.connectionHandle = 0xFFFF;
+    BleApplicationContext.Att_Mtu                                       = BLE_DEFAULT_ATT_MTU;
 
     /**
    * From here, all initialization are BLE application specific
@@ -477,6 +485,7 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* p_Pckt)
                             p_disconnection_complete_event->Reason);
 
                 /* USER CODE BEGIN EVT_DISCONN_COMPLETE_2 */
+                BleApplicationContext.Att_Mtu = BLE_DEFAULT_ATT_MTU;
 
                 /* USER CODE END EVT_DISCONN_COMPLETE_2 */
             }
@@ -591,6 +600,16 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* p_Pckt)
                     }
                     BleApplicationContext.BleApplicationContext_legacy.connectionHandle = p_connection_complete_event->Connection_Handle;
                     /* USER CODE BEGIN HCI_EVT_LE_CONN_COMPLETE */
+                    BleApplicationContext.Att_Mtu = BLE_DEFAULT_ATT_MTU;
+
+                    /* Use the longest link layer packets and ask for the largest ATT MTU
+                       so that a full notification goes out in a single connection event,
+                       then switch to the 2M PHY if the central supports it */
+                    (void)hci_le_set_data_length(p_connection_complete_event->Connection_Handle, DLE_MAX_TX_OCTETS, DLE_MAX_TX_TIME);
+                    (void)aci_gatt_exchange_config(p_connection_complete_event->Connection_Handle);
+                    (void)hci_le_set_phy(
+                        p_connection_complete_event->Connection_Handle, ALL_PHYS_PREFERENCE, TX_2M_PREFERRED, RX_2M_PREFERRED, 0u);
+
                     bdaddr = BleGetBdAddress();
                     sprintf(BdAddress, "BD_ad=%02x%02x%02x%02x%02x%02x", bdaddr[5], bdaddr[4], bdaddr[3], bdaddr[2], bdaddr[1], bdaddr[0]);
                     /* USER CODE END HCI_EVT_LE_CONN_COMPLETE */
@@ -713,6 +732,13 @@ SVCCTL_UserEvtFlowStatus_t SVCCTL_App_Notification(void* p_Pckt)
                     break; /* ACI_GAP_PROC_COMPLETE_VSEVT_CODE */
 
                     /* USER CODE BEGIN BLUE_EVT */
+                case ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE:
+                {
+                    aci_att_exchange_mtu_resp_event_rp0* exchange_mtu_resp = (aci_att_exchange_mtu_resp_event_rp0*)p_blecore_evt->data;
+                    APP_DBG_MSG(">>== ACI_ATT_EXCHANGE_MTU_RESP_VSEVT_CODE - MTU: %d\n", exchange_mtu_resp->Server_RX_MTU);
+                    BleApplicationContext.Att_Mtu = exchange_mtu_resp->Server_RX_MTU;
+                }
+                break;
 
                     /* USER CODE END BLUE_EVT */
             }
@@ -737,6 +763,11 @@ APP_BLE_ConnStatus_t APP_BLE_Get_Server_Connection_Status(void)
     return BleApplicationContext.Device_Connection_Status;
 }
 
+uint16_t APP_BLE_Get_Att_Mtu(void)
+{
+    return BleApplicationContext.Att_Mtu;
+}
+
 /* USER CODE BEGIN FD*/
 void APP_BLE_Key_Button1_Action(void)
 {
@@ -991,7 +1022,7 @@ static void Ble_Hci_Gap_Gatt_Init(void)
 
     if (role > 0)
     {
-        auto&       ov_config = ov::config::get();
+        auto        ov_config = ov::config::get();
         const char* name      = ov_config.device_name;
         ret                   = aci_gap_init(
             role, CFG_PRIVACY, APPBLE_GAP_DEVICE_NAME_LENGTH, &gap_service_handle, &gap_dev_name_char_handle, &gap_appearance_char_handle);
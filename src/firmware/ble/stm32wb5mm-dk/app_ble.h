@@ -52,6 +52,7 @@ extern "C"
     /* Exported functions ---------------------------------------------*/
     void                 APPE_Tl_Init(void);
     APP_BLE_ConnStatus_t APP_BLE_Get_Server_Connection_Status(void);
+    uint16_t             APP_BLE_Get_Att_Mtu(void);
     bool                 APP_BLE_Is_Ready();
 
     /* USER CODE BEGIN EF */
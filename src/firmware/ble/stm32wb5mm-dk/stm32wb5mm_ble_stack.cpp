@@ -5,7 +5,9 @@
 
 #include "stm32wb5mm_ble_stack.h"
 #include "app_ble.h"
+#include "app_conf.h"
 #include "ble_vs_codes.h"
+#include "os.h"
 #include "stm32_seq.h"
 
 extern "C"
@@ -19,8 +21,17 @@ namespace ov
 /** @brief Singleton */
 static stm32wb5mm_ble_stack* s_ble_stack;
 
+static_assert(CFG_BLE_MAX_ATT_MTU == i_ble_stack::MAX_ATT_MTU, "The characteristics are sized from the maximum ATT MTU of the stack");
+
+/** @brief Number of GATT attribute records added by the stack for the GAP and GATT services */
+static constexpr size_t STACK_ATTRIBUTE_RECORDS = 9u;
+
+static_assert(CFG_BLE_NUM_GATT_ATTRIBUTES >= (STACK_ATTRIBUTE_RECORDS + i_ble_stack::MAX_ATTRIBUTE_RECORDS),
+              "The GATT database must hold the attribute records of the stack and of the user services");
+
 /** @brief Constructor */
-stm32wb5mm_ble_stack::stm32wb5mm_ble_stack() : m_thread(), m_services(nullptr), m_services_count(0u), m_is_started(false), m_is_ready(false)
+stm32wb5mm_ble_stack::stm32wb5mm_ble_stack()
+    : m_thread(), m_services(nullptr), m_services_count(0u), m_is_started(false), m_is_ready(false), m_is_failed(false)
 {
     s_ble_stack = this;
 }
@@ -36,6 +47,14 @@ bool stm32wb5mm_ble_stack::start(i_ble_service* services[], size_t services_coun
     auto thread_func = ov::thread_func::create<stm32wb5mm_ble_stack, &stm32wb5mm_ble_stack::thread_func>(*this);
     bool ret         = m_thread.start(thread_func, "BLE", 7u, nullptr);
 
+    // Wait for the creation of the services in the GATT database
+    const uint32_t start_time = ov::os::now();
+    while (ret && !m_is_ready && !m_is_failed && ((ov::os::now() - start_time) < START_TIMEOUT))
+    {
+        ov::this_thread::sleep_for(10u);
+    }
+    ret = ret && m_is_ready;
+
     return ret;
 }
 
@@ -47,6 +66,12 @@ bool stm32wb5mm_ble_stack::is_device_connected()
     return ret;
 }
 
+/** @brief Get the ATT MTU negotiated with the connected device */
+uint16_t stm32wb5mm_ble_stack::get_att_mtu()
+{
+    return APP_BLE_Get_Att_Mtu();
+}
+
 /** @brief BLE thread */
 void stm32wb5mm_ble_stack::thread_func(void*)
 {
@@ -63,61 +88,71 @@ void stm32wb5mm_ble_stack::thread_func(void*)
         // Create user services once the stack is ready
         if (APP_BLE_Is_Ready())
         {
-            if (!m_is_ready)
+            if (!m_is_ready && !m_is_failed)
             {
+                bool created = true;
                 if (m_services)
                 {
                     SVCCTL_RegisterSvcHandler(&stm32wb5mm_ble_stack::service_event_handler);
 
-                    for (size_t i = 0u; i < m_services_count; i++)
+                    for (size_t i = 0u; created && (i < m_services_count); i++)
                     {
-                        create_service(m_services[i]);
+                        created = create_service(m_services[i]);
                     }
                 }
-                m_is_ready = true;
+                m_is_ready  = created;
+                m_is_failed = !created;
             }
         }
     }
 }
 
 /** @brief Create a BLE service */
-void stm32wb5mm_ble_stack::create_service(i_ble_service* service)
+bool stm32wb5mm_ble_stack::create_service(i_ble_service* service)
 {
-    // Create service
-    Service_UUID_t svc_uuid   = {};
-    uint16_t       svc_handle = 0;
+    // Create service, it fails when the GATT database is full
+    Service_UUID_t svc_uuid    = {};
+    uint16_t       svc_handle  = 0;
+    const uint8_t  svc_records = static_cast<uint8_t>(get_attribute_records(service->get_chars_count()));
     memcpy(svc_uuid.Service_UUID_128, service->get_uuid(), sizeof(svc_uuid.Service_UUID_128));
-    (void)aci_gatt_add_service(UUID_TYPE_128,
-                               &svc_uuid,
-                               PRIMARY_SERVICE,
-                               1u + (3u * service->get_chars_count()), // Max_Attribute_Records
-                               &svc_handle);
+    tBleStatus status = aci_gatt_add_service(UUID_TYPE_128,
+                                             &svc_uuid,
+                                             PRIMARY_SERVICE,
+                                             svc_records, // Max_Attribute_Records
+                                             &svc_handle);
+    bool       ret    = (status == BLE_STATUS_SUCCESS);
     service->set_handle(svc_handle);
 
     // Create characteristics
     Char_UUID_t            char_uuid   = {};
     uint16_t               char_handle = 0;
     i_ble_characteristic** chars       = service->get_chars();
-    for (size_t i = 0; i < service->get_chars_count(); i++)
+    for (size_t i = 0; ret && (i < service->get_chars_count()); i++)
     {
         i_ble_characteristic* characteristic = chars[i];
         memcpy(char_uuid.Char_UUID_128, characteristic->get_uuid(), sizeof(char_uuid.Char_UUID_128));
-        (void)aci_gatt_add_char(svc_handle,
-                                UUID_TYPE_128,
-                                &char_uuid,
-                                characteristic->get_size(),
-                                characteristic->get_properties(),
-                                ATTR_PERMISSION_NONE,
-                                GATT_NOTIFY_WRITE_REQ_AND_WAIT_FOR_APPL_RESP, // gattEvtMask
-                                16u,                                          // encryKeySize
-                                1u,                                           // isVariable: 1
-                                &char_handle);
-        characteristic->set_handle(char_handle);
-
-        characteristic->register_stack_event_handler(
-            i_ble_characteristic::event_handler::create<stm32wb5mm_ble_stack, &stm32wb5mm_ble_stack::on_characteristic_updated_handler>(
-                *this));
+        status = aci_gatt_add_char(svc_handle,
+                                   UUID_TYPE_128,
+                                   &char_uuid,
+                                   characteristic->get_size(),
+                                   characteristic->get_properties(),
+                                   ATTR_PERMISSION_NONE,
+                                   GATT_NOTIFY_WRITE_REQ_AND_WAIT_FOR_APPL_RESP, // gattEvtMask
+                                   16u,                                          // encryKeySize
+                                   1u,                                           // isVariable: 1
+                                   &char_handle);
+        ret    = (status == BLE_STATUS_SUCCESS);
+        if (ret)
+        {
+            characteristic->set_handle(char_handle);
+
+            characteristic->register_stack_event_handler(
+                i_ble_characteristic::event_handler::create<stm32wb5mm_ble_stack, &stm32wb5mm_ble_stack::on_characteristic_updated_handler>(
+                    *this));
+        }
     }
+
+    return ret;
 }
 
 /** @brief Find a BLE characteristic from its handle */
@@ -17,10 +17,13 @@ namespace ov
 class stm32wb5mm_ble_stack : public i_ble_stack
 {
   public:
+    /** @brief Maximum time to wait for the creation of the services in milliseconds */
+    static constexpr uint32_t START_TIMEOUT = 5000u;
+
     /** @brief Constructor */
     stm32wb5mm_ble_stack();
 
-    /** @brief Start the stack */
+    /** @brief Start the stack, fails if the services could not be created */
     bool start(i_ble_service* services[], size_t services_count);
 
     /** @brief Indicate if the stack is started */
@@ -32,6 +35,9 @@ class stm32wb5mm_ble_stack : public i_ble_stack
     /** @brief Indicate if a device is connected */
     bool is_device_connected() override;
 
+    /** @brief Get the ATT MTU negotiated with the connected device */
+    uint16_t get_att_mtu() override;
+
   private:
     /** @brief BLE thread */
     thread<2048u> m_thread;
@@ -43,11 +49,13 @@ class stm32wb5mm_ble_stack : public i_ble_stack
     bool m_is_started;
     /** @brief Indicate that the stack is ready */
     bool m_is_ready;
+    /** @brief Indicate that the creation of the services has failed */
+    bool m_is_failed;
 
     /** @brief BLE thread */
     void thread_func(void*);
     /** @brief Create a BLE service */
-    void create_service(i_ble_service* service);
+    bool create_service(i_ble_service* service);
     /** @brief Find a BLE characteristic from its handle */
     i_ble_characteristic* find_characteristic(uint16_t handle);
     /** @brief Handler called when a characteristic value must be updated in the BLE stack */
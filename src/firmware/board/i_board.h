@@ -12,9 +12,11 @@
 #include "i_button.h"
 #include "i_display.h"
 #include "i_gnss.h"
+#include "i_gyroscope_sensor.h"
 #include "i_serial.h"
 #include "i_storage_memory.h"
 #include "i_usb_cdc.h"
+#include "i_usb_msc.h"
 
 namespace ov
 {
@@ -32,9 +34,15 @@ class i_board
     /** @brief Get the debug serial port */
     virtual i_serial& get_debug_port() = 0;
 
-    /** @brief Get the USB CDC port */
+    /** @brief Get the USB CDC port used by the flight instruments */
     virtual i_usb_cdc& get_usb_cdc() = 0;
 
+    /** @brief Get the USB CDC port used by the maintenance link */
+    virtual i_usb_cdc& get_maintenance_cdc() = 0;
+
+    /** @brief Get the USB mass storage device */
+    virtual i_usb_msc& get_usb_msc() = 0;
+
     /** @brief Get the storage memory */
     virtual i_storage_memory& get_storage_memory() = 0;
 
@@ -61,6 +69,9 @@ class i_board
 
     /** @brief Get the accelerometer */
     virtual i_accelerometer_sensor& get_accelerometer() = 0;
+
+    /** @brief Get the gyroscope */
+    virtual i_gyroscope_sensor& get_gyroscope() = 0;
 };
 
 } // namespace ov
@@ -20,7 +20,9 @@ static TIM_HandleTypeDef s_hal_tick;
 ov_board::ov_board()
     : m_dbg_usart_drv(),
 
-      m_usb_cdc_drv(),
+      m_usb_cdc_drv(0u),
+      m_maintenance_cdc_drv(1u),
+      m_usb_msc_drv(),
 
       m_qspi_drv(),
 
@@ -75,7 +77,6 @@ bool ov_board::init()
     ret = hal_init();
     ret = io_init() && ret;
     ret = m_dbg_usart_drv.init() && ret;
-    ret = m_usb_cdc_drv.init() && ret;
     ret = m_qspi_drv.init() && ret;
     ret = m_spi1_cs_drv.init() && ret;
     ret = m_spi1_drv.init() && ret;
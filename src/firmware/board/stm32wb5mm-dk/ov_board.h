@@ -18,6 +18,7 @@
 #include "stm32hal_spi.h"
 #include "stm32hal_usart.h"
 #include "stm32hal_usb_cdc.h"
+#include "stm32hal_usb_msc.h"
 
 // Peripherals
 #include "barometric_altimeter.h"
@@ -54,9 +55,15 @@ class ov_board : public i_board
     /** @brief Get the debug serial port */
     i_serial& get_debug_port() override { return m_dbg_usart_drv; }
 
-    /** @brief Get the USB CDC port */
+    /** @brief Get the USB CDC port used by the flight instruments */
     i_usb_cdc& get_usb_cdc() override { return m_usb_cdc_drv; }
 
+    /** @brief Get the USB CDC port used by the maintenance link */
+    i_usb_cdc& get_maintenance_cdc() override { return m_maintenance_cdc_drv; }
+
+    /** @brief Get the USB mass storage device */
+    i_usb_msc& get_usb_msc() override { return m_usb_msc_drv; }
+
     /** @brief Get the storage memory */
     i_storage_memory& get_storage_memory() override { return m_qspi_nor_flash; }
 
@@ -84,12 +91,19 @@ class ov_board : public i_board
     /** @brief Get the accelerometer */
     i_accelerometer_sensor& get_accelerometer() override { return m_accelerometer_sensor; }
 
+    /** @brief Get the gyroscope */
+    i_gyroscope_sensor& get_gyroscope() override { return m_accelerometer_sensor; }
+
   private:
     /** @brief Debug USART driver */
     stm32hal_usart m_dbg_usart_drv;
 
-    /** @brief USB CDC driver */
+    /** @brief USB CDC driver for the flight instruments */
     stm32hal_usb_cdc m_usb_cdc_drv;
+    /** @brief USB CDC driver for the maintenance link */
+    stm32hal_usb_cdc m_maintenance_cdc_drv;
+    /** @brief USB mass storage driver */
+    stm32hal_usb_msc m_usb_msc_drv;
 
     /** @brief QSPI driver */
     stm32hal_qspi m_qspi_drv;
@@ -147,7 +161,7 @@ class ov_board : public i_board
     /** @brief Barometric altimeter */
     barometric_altimeter m_altimeter;
 
-    /** @brief Accelerometer sensor */
+    /** @brief Accelerometer and gyroscope sensor */
     ism330dhcx m_accelerometer_sensor;
 
     /** @brief Initialize the HAL */
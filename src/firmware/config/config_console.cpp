@@ -55,6 +55,7 @@ void config_console::confdump_handler(const char*)
     static const char*  entry_types[] = {"int", "uint", "bool", "float", "double", "string"};
     const config_entry* entry         = ov::config::get_desc();
     int                 id            = 0;
+    const ov_config     config        = ov::config::get();
 
     m_console.write_line("Id\tName\tType\tSize\tValue\tDefault");
     m_console.write_line("---------------------------------------------");
@@ -72,7 +73,7 @@ void config_console::confdump_handler(const char*)
         {
             case entry_type::sint:
             {
-                int32_t*       val         = reinterpret_cast<int32_t*>(entry->value);
+                const int32_t* val         = reinterpret_cast<const int32_t*>(ov::config::get_value(config, *entry));
                 const int32_t* default_val = reinterpret_cast<const int32_t*>(entry->default_value);
                 snprintf(tmp, sizeof(tmp), "%ld\t", (*val));
                 m_console.write(tmp);
@@ -83,7 +84,7 @@ void config_console::confdump_handler(const char*)
 
             case entry_type::uint:
             {
-                uint32_t*       val         = reinterpret_cast<uint32_t*>(entry->value);
+                const uint32_t* val         = reinterpret_cast<const uint32_t*>(ov::config::get_value(config, *entry));
                 const uint32_t* default_val = reinterpret_cast<const uint32_t*>(entry->default_value);
                 snprintf(tmp, sizeof(tmp), "%lu\t", (*val));
                 m_console.write(tmp);
@@ -94,7 +95,7 @@ void config_console::confdump_handler(const char*)
 
             case entry_type::boolean:
             {
-                bool*       val         = reinterpret_cast<bool*>(entry->value);
+                const bool* val         = reinterpret_cast<const bool*>(ov::config::get_value(config, *entry));
                 const bool* default_val = reinterpret_cast<const bool*>(entry->default_value);
                 if (*val)
                 {
@@ -117,7 +118,7 @@ void config_console::confdump_handler(const char*)
 
             case entry_type::string:
             {
-                char*       val         = reinterpret_cast<char*>(entry->value);
+                const char* val         = reinterpret_cast<const char*>(ov::config::get_value(config, *entry));
                 const char* default_val = reinterpret_cast<const char*>(entry->default_value);
                 m_console.write(val);
                 m_console.write("\t");
@@ -155,14 +156,16 @@ void config_console::confwrite_handler(const char* param_id)
         }
         if (current_id == id)
         {
-            bool success = true;
+            ov::config::transaction tr;
+            void*                   entry_value = ov::config::get_value(tr.values(), *entry);
+            bool                    success     = true;
 
             switch (entry->type)
             {
                 case entry_type::sint:
                 {
                     int      val       = atoi(value);
-                    int32_t* entry_val = reinterpret_cast<int32_t*>(entry->value);
+                    int32_t* entry_val = reinterpret_cast<int32_t*>(entry_value);
                     *entry_val         = static_cast<int32_t>(val);
                 }
                 break;
@@ -170,14 +173,14 @@ void config_console::confwrite_handler(const char* param_id)
                 case entry_type::uint:
                 {
                     int       val       = atoi(value);
-                    uint32_t* entry_val = reinterpret_cast<uint32_t*>(entry->value);
+                    uint32_t* entry_val = reinterpret_cast<uint32_t*>(entry_value);
                     *entry_val          = static_cast<uint32_t>(val);
                 }
                 break;
 
                 case entry_type::boolean:
                 {
-                    bool* entry_val = reinterpret_cast<bool*>(entry->value);
+                    bool* entry_val = reinterpret_cast<bool*>(entry_value);
                     if (strcmp(value, "true") == 0)
                     {
                         *entry_val = true;
@@ -195,7 +198,7 @@ void config_console::confwrite_handler(const char* param_id)
 
                 case entry_type::string:
                 {
-                    char* entry_val = reinterpret_cast<char*>(entry->value);
+                    char* entry_val = reinterpret_cast<char*>(entry_value);
                     strncpy(entry_val, value, entry->size - 1u);
                     entry_val[entry->size - 1u] = 0;
                 }
@@ -207,6 +210,7 @@ void config_console::confwrite_handler(const char* param_id)
             }
             if (success)
             {
+                tr.commit(false);
                 m_console.write_line("Configuration value updated!");
             }
             else
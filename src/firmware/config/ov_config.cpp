@@ -5,9 +5,12 @@
 
 #include "ov_config.h"
 #include "fs.h"
+#include "lock_guard.h"
+#include "mutex.h"
 #include "ov_config_default.h"
 
 #include <cstring>
+#include <utility>
 
 namespace ov
 {
@@ -16,7 +19,7 @@ namespace ov
 static const char* OV_CONFIG_FILE_PATH = "/ov.cfg";
 
 /** @brief Current configuration file version */
-static const uint32_t CURRENT_CONFIG_VERSION = 0x00000001u;
+static const uint32_t CURRENT_CONFIG_VERSION = 0x00000007u;
 /** @brief Magic number for start of configuration file */
 static const uint32_t MAGIC_START = 0x8BADF00Du;
 /** @brief Magic number for end of configuration file */
@@ -25,6 +28,27 @@ static const uint32_t MAGIC_END = 0xDEADBEEFu;
 /** @brief Configuration */
 static ov_config s_config;
 
+/** @brief Version of the configuration */
+static uint32_t s_version;
+
+/** @brief Mutex to protect concurrent access to the configuration, its version and its listeners */
+static mutex s_mutex;
+
+/** @brief Listeners of the configuration changes */
+static config::listener s_listeners[config::MAX_LISTENERS];
+
+/** @brief Number of listeners */
+static size_t s_listeners_count;
+
+/** @brief Mutex to serialize the saves and the notifications of the changes, outside of the configuration lock */
+static mutex s_publish_mutex;
+
+/** @brief Latest configuration values being saved or notified */
+static ov_config s_latest;
+
+/** @brief Configuration values of the last notification to the listeners */
+static ov_config s_published;
+
 /** @brief Configuration description */
 static const config_entry s_config_desc[] = {
     // Device settings
@@ -34,54 +58,242 @@ static const config_entry s_config_desc[] = {
     {"Glider3 name", entry_type::string, sizeof(s_config.glider3_name), &s_config.glider3_name, s_default_glider3_name},
     {"Glider4 name", entry_type::string, sizeof(s_config.glider4_name), &s_config.glider4_name, s_default_glider4_name},
     {"Selected glider", entry_type::uint, sizeof(s_config.glider), &s_config.glider, &s_default_glider},
+    {"Glider1 polar", entry_type::uint, sizeof(s_config.glider1_polar), &s_config.glider1_polar, &s_default_glider1_polar},
+    {"Glider2 polar", entry_type::uint, sizeof(s_config.glider2_polar), &s_config.glider2_polar, &s_default_glider2_polar},
+    {"Glider3 polar", entry_type::uint, sizeof(s_config.glider3_polar), &s_config.glider3_polar, &s_default_glider3_polar},
+    {"Glider4 polar", entry_type::uint, sizeof(s_config.glider4_polar), &s_config.glider4_polar, &s_default_glider4_polar},
+    {"MacCready", entry_type::uint, sizeof(s_config.mac_cready), &s_config.mac_cready, &s_default_mac_cready},
     // Sensors settings
     {"Sink rate integ time", entry_type::uint, sizeof(s_config.sr_integ_time), &s_config.sr_integ_time, &s_default_sr_integ_time},
     {"Glide ratio integ time", entry_type::uint, sizeof(s_config.gr_integ_time), &s_config.gr_integ_time, &s_default_gr_integ_time},
+    {"TE wind correction", entry_type::boolean, sizeof(s_config.te_wind_corr), &s_config.te_wind_corr, &s_default_te_wind_corr},
     {"Alti ref temp", entry_type::sint, sizeof(s_config.alti_ref_temp), &s_config.alti_ref_temp, &s_default_alti_ref_temp},
     {"Alti ref pressure", entry_type::uint, sizeof(s_config.alti_ref_pressure), &s_config.alti_ref_pressure, &s_default_alti_ref_pressure},
     {"Alti ref altitude", entry_type::sint, sizeof(s_config.alti_ref_alti), &s_config.alti_ref_alti, &s_default_alti_ref_alti},
     // Recorder settings
     {"Recording period", entry_type::uint, sizeof(s_config.recording_period), &s_config.recording_period, &s_default_recording_period},
+    {"Auto recording", entry_type::boolean, sizeof(s_config.auto_record), &s_config.auto_record, &s_default_auto_record},
     // Display settings
     {"Night mode", entry_type::boolean, sizeof(s_config.is_night_mode_on), &s_config.is_night_mode_on, &s_default_is_night_mode_on},
     {"Display timeout", entry_type::uint, sizeof(s_config.disp_saver_timeout), &s_config.disp_saver_timeout, &s_default_disp_saver_timeout},
+    // USB settings
+    {"USB mass storage", entry_type::boolean, sizeof(s_config.usb_mass_storage), &s_config.usb_mass_storage, &s_default_usb_mass_storage},
+    // External instruments settings
+    {"Instr protocols", entry_type::uint, sizeof(s_config.instr_protocols), &s_config.instr_protocols, &s_default_instr_protocols},
+    {"Instr rate", entry_type::uint, sizeof(s_config.instr_rate), &s_config.instr_rate, &s_default_instr_rate},
+    // BLE settings
+    {"BLE rate", entry_type::uint, sizeof(s_config.ble_rate), &s_config.ble_rate, &s_default_ble_rate},
     // Null entry
     {nullptr, entry_type::sint, 0u, nullptr, nullptr}};
 
 namespace config
 {
 
-/** @brief Get the configuration */
-ov_config& get()
+/** @brief Set the default values in a set of configuration values */
+static void set_default_values(ov_config& values)
+{
+    // For each configuration value
+    auto* entry = &s_config_desc[0];
+    while (entry->name != nullptr)
+    {
+        // Copy default value
+        memcpy(get_value(values, *entry), entry->default_value, entry->size);
+
+        // Next entry
+        entry++;
+    }
+}
+
+/** @brief Write a set of configuration values to the configuration file */
+static bool write_file(const ov_config& values)
+{
+    bool ret = false;
+
+    // Open the configuration file
+    auto file = ov::fs::open(OV_CONFIG_FILE_PATH, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    if (file.is_open())
+    {
+        size_t write_count = 0;
+
+        // Write header
+        ret = file.write(CURRENT_CONFIG_VERSION);
+        ret = ret && file.write(MAGIC_START);
+
+        // Write values
+        auto* entry = &s_config_desc[0];
+        while (ret && (entry->name != nullptr))
+        {
+            // Write entry
+            size_t entry_name_len = strlen(entry->name);
+
+            ret = ret && file.write(&entry_name_len, sizeof(entry_name_len), write_count);
+            ret = ret && file.write(&entry->name, entry_name_len, write_count);
+            ret = ret && file.write(&entry->type, sizeof(entry->type), write_count);
+            ret = ret && file.write(&entry->size, sizeof(entry->size), write_count);
+            ret = ret && file.write(get_value(values, *entry), entry->size, write_count);
+
+            // Next entry
+            entry++;
+        }
+
+        // Write footer
+        ret = ret && file.write(MAGIC_END);
+    }
+
+    return ret;
+}
+
+/** @brief Save the latest configuration values if requested and notify their changes to the listeners */
+static bool publish(bool persist)
+{
+    bool ret = true;
+
+    // The configuration is only locked to copy the latest values, concurrent commits are notified once in order
+    lock_guard<mutex> lock(s_publish_mutex);
+    size_t            listeners_count = 0u;
+    {
+        lock_guard<mutex> config_lock(s_mutex);
+        s_latest        = s_config;
+        listeners_count = s_listeners_count;
+    }
+    if (persist)
+    {
+        ret = write_file(s_latest);
+    }
+    if (memcmp(&s_latest, &s_published, sizeof(ov_config)) != 0)
+    {
+        for (size_t i = 0; i < listeners_count; i++)
+        {
+            s_listeners[i](s_latest, s_published);
+        }
+        s_published = s_latest;
+    }
+
+    return ret;
+}
+
+/** @brief Constructor, lock the configuration */
+transaction::transaction() : m_values(), m_is_locked(true)
+{
+    s_mutex.lock();
+    m_values = s_config;
+}
+
+/** @brief Destructor, the modifications which have not been committed are dropped */
+transaction::~transaction()
+{
+    if (m_is_locked)
+    {
+        s_mutex.unlock();
+    }
+}
+
+/**
+ * @brief Apply the modifications and unlock the configuration, the configuration is then saved once if requested
+ *        Nothing is done if no value has changed, otherwise the version is incremented and the listeners are notified
+ *        after the unlock. Return false if the configuration could not be saved
+ */
+bool transaction::commit(bool persist)
+{
+    bool ret = false;
+
+    if (m_is_locked)
+    {
+        ret                = true;
+        const bool changed = (memcmp(&m_values, &s_config, sizeof(ov_config)) != 0);
+        if (changed)
+        {
+            // The transaction keeps the previous values
+            std::swap(s_config, m_values);
+            s_version++;
+        }
+        m_is_locked = false;
+        s_mutex.unlock();
+
+        // The file is written and the listeners are called without blocking the readers of the configuration
+        if (changed)
+        {
+            ret = publish(persist);
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Get a copy of the configuration */
+ov_config get()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_config;
+}
+
+/** @brief Get a copy of the configuration with its version */
+ov_config get(uint32_t& version)
 {
+    lock_guard<mutex> lock(s_mutex);
+    version = s_version;
     return s_config;
 }
 
+/** @brief Get the version of the configuration, it is incremented each time a value changes */
+uint32_t get_version()
+{
+    lock_guard<mutex> lock(s_mutex);
+    return s_version;
+}
+
+/**
+ * @brief Register a listener of the configuration changes
+ *        It is called in the order of the changes without the configuration locked, it can read the configuration but must not modify it
+ */
+bool subscribe(const listener& l)
+{
+    bool ret = false;
+
+    lock_guard<mutex> lock(s_mutex);
+    if (s_listeners_count < MAX_LISTENERS)
+    {
+        s_listeners[s_listeners_count] = l;
+        s_listeners_count++;
+        ret                            = true;
+    }
+
+    return ret;
+}
+
 /** @brief Get the configuration description */
 const config_entry* get_desc()
 {
     return s_config_desc;
 }
 
+/** @brief Get the address of the value of a configuration entry in a set of configuration values */
+void* get_value(ov_config& values, const config_entry& entry)
+{
+    const size_t offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(entry.value) - reinterpret_cast<uint8_t*>(&s_config));
+    return reinterpret_cast<uint8_t*>(&values) + offset;
+}
+
+/** @brief Get the address of the value of a configuration entry in a set of configuration values */
+const void* get_value(const ov_config& values, const config_entry& entry)
+{
+    const size_t offset = static_cast<size_t>(reinterpret_cast<uint8_t*>(entry.value) - reinterpret_cast<uint8_t*>(&s_config));
+    return reinterpret_cast<const uint8_t*>(&values) + offset;
+}
+
 /** @brief Set the default configuration values */
 void set_default_values()
 {
-    // For each configuration value
-    auto* entry = &s_config_desc[0];
-    while (entry->name != nullptr)
-    {
-        // Copy default value
-        memcpy(entry->value, entry->default_value, entry->size);
-
-        // Next entry
-        entry++;
-    }
+    transaction tr;
+    set_default_values(tr.values());
+    tr.commit(false);
 }
 
 /** @brief Load the configuration */
 bool load()
 {
-    bool ret = false;
+    bool        ret = false;
+    transaction tr;
 
     // Open the configuration file
     auto file = ov::fs::open(OV_CONFIG_FILE_PATH, ov::fs::o_rdonly);
@@ -111,7 +323,7 @@ bool load()
             ret = file.read(&type, sizeof(entry->type), read_count);
             ret = file.read(&entry_size, sizeof(entry->size), read_count);
             ret = ret && (type == entry->type) && (entry_size == entry->size);
-            ret = ret && file.read(entry->value, entry->size, read_count);
+            ret = ret && file.read(get_value(tr.values(), *entry), entry->size, read_count);
 
             // Next entry
             entry++;
@@ -124,8 +336,9 @@ bool load()
     if (!ret)
     {
         // Set default values
-        set_default_values();
+        set_default_values(tr.values());
     }
+    tr.commit(false);
 
     return ret;
 }
@@ -133,40 +346,12 @@ bool load()
 /** @brief Save the configuration */
 bool save()
 {
-    bool ret = false;
-
-    // Open the configuration file
-    auto file = ov::fs::open(OV_CONFIG_FILE_PATH, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
-    if (file.is_open())
+    lock_guard<mutex> lock(s_publish_mutex);
     {
-        size_t write_count = 0;
-
-        // Write header
-        ret = file.write(CURRENT_CONFIG_VERSION);
-        ret = ret && file.write(MAGIC_START);
-
-        // Write values
-        auto* entry = &s_config_desc[0];
-        while (ret && (entry->name != nullptr))
-        {
-            // Write entry
-            size_t entry_name_len = strlen(entry->name);
-
-            ret = ret && file.write(&entry_name_len, sizeof(entry_name_len), write_count);
-            ret = ret && file.write(&entry->name, entry_name_len, write_count);
-            ret = ret && file.write(&entry->type, sizeof(entry->type), write_count);
-            ret = ret && file.write(&entry->size, sizeof(entry->size), write_count);
-            ret = ret && file.write(entry->value, entry->size, write_count);
-
-            // Next entry
-            entry++;
-        }
-
-        // Write footer
-        ret = ret && file.write(MAGIC_END);
+        lock_guard<mutex> config_lock(s_mutex);
+        s_latest = s_config;
     }
-
-    return ret;
+    return write_file(s_latest);
 }
 
 } // namespace config
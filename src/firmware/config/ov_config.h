@@ -6,6 +6,9 @@
 #ifndef OV_CONFIG_H
 #define OV_CONFIG_H
 
+#include "delegate.h"
+
+#include <cstddef>
 #include <cstdint>
 
 namespace ov
@@ -28,6 +31,16 @@ struct ov_config
     char glider4_name[32u];
     /** @brief Selected glider */
     uint8_t glider;
+    /** @brief Glider 1's polar (index in the polar database) */
+    uint8_t glider1_polar;
+    /** @brief Glider 2's polar (index in the polar database) */
+    uint8_t glider2_polar;
+    /** @brief Glider 3's polar (index in the polar database) */
+    uint8_t glider3_polar;
+    /** @brief Glider 4's polar (index in the polar database) */
+    uint8_t glider4_polar;
+    /** @brief MacCready setting (1 = 0.1m/s) */
+    uint8_t mac_cready;
 
     // Sensors settings
 
@@ -35,6 +48,8 @@ struct ov_config
     uint32_t sr_integ_time;
     /** @brief Glide ratio integration time (ms) */
     uint32_t gr_integ_time;
+    /** @brief Correct the airspeed of the total energy vario with the wind estimated while circling */
+    bool te_wind_corr;
 
     /** @brief Reference temperature for the barometric altimeter (1 = 0.1°C) */
     int16_t alti_ref_temp;
@@ -47,6 +62,8 @@ struct ov_config
 
     /** @brief Recording period in milliseconds */
     uint32_t recording_period;
+    /** @brief Automatic start/stop of the recording on takeoff/landing */
+    bool auto_record;
 
     // Display settings
 
@@ -54,6 +71,21 @@ struct ov_config
     bool is_night_mode_on;
     /** @brief Display screen saver timeout in milliseconds */
     uint32_t disp_saver_timeout;
+
+    // USB settings
+
+    /** @brief Expose the recorded flights as a USB mass storage device instead of the USB serial port (applied on reboot) */
+    bool usb_mass_storage;
+
+    // External instruments settings
+
+    /** @brief Protocols of the sentences sent to the external instruments (bit flags of instrument_protocol) */
+    uint8_t instr_protocols;
+    /** @brief Maximum rate of the sentences sent to the external instruments (Hz) */
+    uint8_t instr_rate;
+
+    /** @brief Rate of the BLE telemetry notifications (Hz) */
+    uint8_t ble_rate;
 };
 
 /** @brief Confiuration entry type */
@@ -82,7 +114,7 @@ struct config_entry
     entry_type type;
     /** @brief Size */
     uint16_t size;
-    /** @brief Value */
+    /** @brief Value in the global configuration, it must be accessed through config::get_value() */
     void* value;
     /** @brief Default value */
     const void* default_value;
@@ -91,12 +123,74 @@ struct config_entry
 namespace config
 {
 
-/** @brief Get the configuration */
-ov_config& get();
+/** @brief Listener of the configuration changes, called with the new values and the previous values */
+using listener = delegate<void, const ov_config&, const ov_config&>;
+
+/** @brief Maximum number of listeners */
+static constexpr size_t MAX_LISTENERS = 4u;
+
+/**
+ * @brief Write transaction on the configuration
+ *        The configuration is locked from the construction of the transaction to its commit or its destruction,
+ *        the values are modified on a copy which replaces the configuration on commit so that the readers never see a partial update
+ */
+class transaction
+{
+  public:
+    /** @brief Constructor, lock the configuration */
+    transaction();
+    /** @brief Copy constructor */
+    transaction(const transaction& copy) = delete;
+    /** @brief Move constructor */
+    transaction(transaction&& move) = delete;
+
+    /** @brief Destructor, the modifications which have not been committed are dropped */
+    ~transaction();
+
+    /** @brief Copy operator */
+    transaction& operator=(const transaction& copy) = delete;
+
+    /** @brief Get the values to modify */
+    ov_config& values() { return m_values; }
+
+    /**
+     * @brief Apply the modifications and unlock the configuration, the configuration is then saved once if requested
+     *        Nothing is done if no value has changed, otherwise the version is incremented and the listeners are notified
+     *        after the unlock. Return false if the configuration could not be saved
+     */
+    bool commit(bool persist);
+
+  private:
+    /** @brief Modified values, the previous values after the commit */
+    ov_config m_values;
+    /** @brief Indicate if the configuration is locked by the transaction */
+    bool m_is_locked;
+};
+
+/** @brief Get a copy of the configuration */
+ov_config get();
+
+/** @brief Get a copy of the configuration with its version */
+ov_config get(uint32_t& version);
+
+/** @brief Get the version of the configuration, it is incremented each time a value changes */
+uint32_t get_version();
+
+/**
+ * @brief Register a listener of the configuration changes
+ *        It is called in the order of the changes without the configuration locked, it can read the configuration but must not modify it
+ */
+bool subscribe(const listener& l);
 
 /** @brief Get the configuration description */
 const config_entry* get_desc();
 
+/** @brief Get the address of the value of a configuration entry in a set of configuration values */
+void* get_value(ov_config& values, const config_entry& entry);
+
+/** @brief Get the address of the value of a configuration entry in a set of configuration values */
+const void* get_value(const ov_config& values, const config_entry& entry);
+
 /** @brief Set the default configuration values */
 void set_default_values();
 
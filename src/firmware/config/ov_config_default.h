@@ -25,6 +25,16 @@ static const char s_default_glider3_name[32u] = "My glider 3";
 static const char s_default_glider4_name[32u] = "My glider 4";
 /** @brief Selected glider */
 static const uint8_t s_default_glider = 1u;
+/** @brief Glider 1's polar (EN-B) */
+static const uint8_t s_default_glider1_polar = 1u;
+/** @brief Glider 2's polar (EN-B) */
+static const uint8_t s_default_glider2_polar = 1u;
+/** @brief Glider 3's polar (EN-B) */
+static const uint8_t s_default_glider3_polar = 1u;
+/** @brief Glider 4's polar (EN-B) */
+static const uint8_t s_default_glider4_polar = 1u;
+/** @brief MacCready setting (1 = 0.1m/s) */
+static const uint8_t s_default_mac_cready = 10u;
 
 // Sensors settings
 
@@ -32,6 +42,8 @@ static const uint8_t s_default_glider = 1u;
 static const uint32_t s_default_sr_integ_time = 2000u;
 /** @brief Glide ratio integration time (ms) */
 static const uint32_t s_default_gr_integ_time = 5000u;
+/** @brief Correct the airspeed of the total energy vario with the wind estimated while circling */
+static const bool s_default_te_wind_corr = true;
 /** @brief Reference temperature for the barometric altimeter (1 = 0.1°C) */
 static const int16_t s_default_alti_ref_temp = 150;
 /** @brief Reference pressure for the barometric altimeter (1 = 0.01mbar) */
@@ -43,6 +55,8 @@ static const int32_t s_default_alti_ref_alti = 0;
 
 /** @brief Recording period in milliseconds */
 static const uint32_t s_default_recording_period = 1000u;
+/** @brief Automatic start/stop of the recording on takeoff/landing */
+static const bool s_default_auto_record = true;
 
 // Display settings
 
@@ -51,6 +65,21 @@ static const bool s_default_is_night_mode_on = true;
 /** @brief Display screen saver timeout in milliseconds */
 static const uint32_t s_default_disp_saver_timeout = 20000u;
 
+// USB settings
+
+/** @brief USB mass storage mode */
+static const bool s_default_usb_mass_storage = false;
+
+// External instruments settings
+
+/** @brief Protocols of the sentences sent to the external instruments (LK8EX1 and XCTOD) */
+static const uint8_t s_default_instr_protocols = 0x09u;
+/** @brief Maximum rate of the sentences sent to the external instruments (Hz) */
+static const uint8_t s_default_instr_rate = 10u;
+
+/** @brief Rate of the BLE telemetry notifications (Hz) */
+static const uint8_t s_default_ble_rate = 10u;
+
 } // namespace ov
 
 #endif // OV_CONFIG_DEFAULT_H
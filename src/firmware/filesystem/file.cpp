@@ -8,16 +8,15 @@
 namespace ov
 {
 
+/** @brief Default constructor, the file is closed */
+file::file() : m_lfs(nullptr), m_file{}, m_config{}, m_buffer{}
+{
+}
+
 /** @brief Constructor */
-file::file(lfs_t* lfs, const char* path, int flags) : m_lfs(lfs), m_file{}, m_config{}, m_buffer{}
+file::file(lfs_t* lfs, const char* path, int flags) : file()
 {
-    // Open the file
-    m_config.buffer = m_buffer;
-    int err         = lfs_file_opencfg(m_lfs, &m_file, path, flags, &m_config);
-    if (err != LFS_ERR_OK)
-    {
-        m_lfs = nullptr;
-    }
+    open(lfs, path, flags);
 }
 
 /** @brief Move constructor */
@@ -32,6 +31,23 @@ file::~file()
     close();
 }
 
+/** @brief Open the file, the previously opened file is closed */
+bool file::open(lfs_t* lfs, const char* path, int flags)
+{
+    close();
+
+    // Open the file
+    m_lfs           = lfs;
+    m_config.buffer = m_buffer;
+    int err         = lfs_file_opencfg(m_lfs, &m_file, path, flags, &m_config);
+    if (err != LFS_ERR_OK)
+    {
+        m_lfs = nullptr;
+    }
+
+    return is_open();
+}
+
 /** @brief Close the file */
 bool file::close()
 {
@@ -27,6 +27,8 @@ class file
         seek_end = LFS_SEEK_END
     };
 
+    /** @brief Default constructor, the file is closed */
+    file();
     /** @brief Constructor */
     file(lfs_t* lfs, const char* path, int flags);
     /** @brief Copy constructor */
@@ -43,6 +45,9 @@ class file
     /** @brief Indicate if the file is valid */
     operator bool() const { return is_open(); }
 
+    /** @brief Open the file, the previously opened file is closed */
+    bool open(lfs_t* lfs, const char* path, int flags);
+
     /** @brief Close the file */
     bool close();
 
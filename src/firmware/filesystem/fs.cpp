@@ -63,8 +63,8 @@ bool init(bool& fs_reinitialized, i_storage_memory& storage_memory)
         // Block device configuration
         .read_size      = FS_CACHE_SIZE,
         .prog_size      = FS_CACHE_SIZE,
-        .block_size     = storage_memory.get_block_size(),
-        .block_count    = storage_memory.get_size() / storage_memory.get_block_size(),
+        .block_size     = static_cast<lfs_size_t>(storage_memory.get_block_size()),
+        .block_count    = static_cast<lfs_size_t>(storage_memory.get_size() / storage_memory.get_block_size()),
         .block_cycles   = 500u,
         .cache_size     = FS_CACHE_SIZE,
         .lookahead_size = FS_CACHE_SIZE,
@@ -76,9 +76,9 @@ bool init(bool& fs_reinitialized, i_storage_memory& storage_memory)
 
         // Limits
         .name_max     = 64u,
-        .file_max     = LFS_FILE_MAX,                   // Keep default value
-        .attr_max     = LFS_ATTR_MAX,                   // Keep default value
-        .metadata_max = storage_memory.get_block_size() // Keep default value
+        .file_max     = LFS_FILE_MAX,                                            // Keep default value
+        .attr_max     = LFS_ATTR_MAX,                                            // Keep default value
+        .metadata_max = static_cast<lfs_size_t>(storage_memory.get_block_size()) // Keep default value
     };
 
     // Mount the filesystem
@@ -153,6 +153,12 @@ file open(const char* path, int flags)
     return file(&s_lfs, path, flags);
 }
 
+/** @brief Open or create a file into an existing file object */
+bool open(file& f, const char* path, int flags)
+{
+    return f.open(&s_lfs, path, flags);
+}
+
 /** @brief Open a directory */
 dir open_dir(const char* path)
 {
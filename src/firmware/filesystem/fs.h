@@ -48,6 +48,9 @@ bool rename(const char* old_path, const char* new_path);
 /** @brief Open or create a file */
 file open(const char* path, int flags);
 
+/** @brief Open or create a file into an existing file object */
+bool open(file& f, const char* path, int flags);
+
 /** @brief Open a directory */
 dir open_dir(const char* path);
 
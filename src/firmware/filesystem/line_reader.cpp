@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "line_reader.h"
+
+namespace ov
+{
+
+/** @brief Constructor */
+line_reader::line_reader(file& f) : m_file(f), m_buffer{}, m_count(0u), m_index(0u), m_eof(false) { }
+
+/** @brief Read the next line without its end of line characters, too long lines are truncated */
+bool line_reader::read_line(char* line, size_t size)
+{
+    bool   ret      = false;
+    bool   end      = false;
+    size_t line_len = 0u;
+    while (!end)
+    {
+        // Refill buffer
+        if (m_index == m_count)
+        {
+            m_index = 0u;
+            m_count = 0u;
+            if (m_eof || !m_file.read(m_buffer, sizeof(m_buffer), m_count) || (m_count == 0u))
+            {
+                m_eof = true;
+                end   = true;
+            }
+        }
+        else
+        {
+            // Extract line
+            const char c = m_buffer[m_index];
+            m_index++;
+            ret = true;
+            if (c == '\n')
+            {
+                end = true;
+            }
+            else if ((c != '\r') && (line_len < (size - 1u)))
+            {
+                line[line_len] = c;
+                line_len++;
+            }
+            else
+            {
+                // Ignored character or line too long
+            }
+        }
+    }
+    line[line_len] = 0;
+
+    return ret;
+}
+
+} // namespace ov
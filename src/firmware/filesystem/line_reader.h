@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_LINE_READER_H
+#define OV_LINE_READER_H
+
+#include "file.h"
+
+namespace ov
+{
+
+/** @brief Helper to read a text file line by line */
+class line_reader
+{
+  public:
+    /** @brief Constructor */
+    line_reader(file& f);
+
+    /**
+     * @brief Read the next line without its end of line characters, too long lines are truncated
+     * @param line Buffer to store the null terminated line
+     * @param size Size of the buffer in bytes
+     * @return false at the end of the file
+     */
+    bool read_line(char* line, size_t size);
+
+  private:
+    /** @brief File to read */
+    file& m_file;
+    /** @brief Read buffer */
+    char m_buffer[64u];
+    /** @brief Number of bytes in the read buffer */
+    size_t m_count;
+    /** @brief Index of the next byte in the read buffer */
+    size_t m_index;
+    /** @brief Indicate that the end of the file has been reached */
+    bool m_eof;
+};
+
+} // namespace ov
+
+#endif // OV_LINE_READER_H
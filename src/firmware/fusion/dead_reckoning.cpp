@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "dead_reckoning.h"
+
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Conversion factor from gyroscope units (0.01°/s) to rad/s */
+static constexpr float RATE_TO_RAD = geo::DEG_TO_RAD / 100.f;
+
+/** @brief Conversion factor from track angle units (0.1°) to radians */
+static constexpr float TRACK_TO_RAD = geo::DEG_TO_RAD / 10.f;
+
+/** @brief Full turn in radians */
+static constexpr float FULL_TURN = 2.f * geo::PI;
+
+/** @brief Minimum norm of the filtered acceleration to give the vertical direction (1000 = 1g) */
+static constexpr float MIN_GRAVITY = 500.f;
+
+/** @brief Maximum along track acceleration used for the propagation (m/s²) */
+static constexpr float MAX_ACCELERATION = 3.f;
+
+/** @brief Wrap an angle difference in the [-180°, 180°[ range, the difference must be within one turn (rad) */
+static float wrap_angle(float angle)
+{
+    if (angle >= geo::PI)
+    {
+        angle -= FULL_TURN;
+    }
+    else if (angle < -geo::PI)
+    {
+        angle += FULL_TURN;
+    }
+    return angle;
+}
+
+/** @brief Normalize a heading in the [0°, 360°[ range, the heading must be within one turn of this range (rad) */
+static float normalize_heading(float heading)
+{
+    if (heading < 0.f)
+    {
+        heading += FULL_TURN;
+    }
+    else if (heading >= FULL_TURN)
+    {
+        heading -= FULL_TURN;
+    }
+    return heading;
+}
+
+/** @brief Meters per radian of longitude at a position, bounded near the poles */
+static float get_east_scale(const geo::position& pos)
+{
+    return std::fmax(geo::EARTH_RADIUS * std::cos(static_cast<float>(pos.latitude) * geo::UNITS_TO_RAD), 1.f);
+}
+
+/** @brief Constructor */
+dead_reckoning::dead_reckoning()
+    : m_is_initialized(false),
+      m_origin{},
+      m_east_scale(geo::EARTH_RADIUS),
+      m_east(0.f),
+      m_north(0.f),
+      m_speed(0.f),
+      m_acceleration(0.f),
+      m_heading(0.f),
+      m_heading_rate_bias(0.f),
+      m_gyro_turn(0.f),
+      m_gravity{},
+      m_is_gravity_valid(false),
+      m_fix_speed(0u),
+      m_fix_track(0u),
+      m_fix_age(0u)
+{
+}
+
+/** @brief Reset the estimation, it restarts on the next fix */
+void dead_reckoning::reset()
+{
+    // Gravity direction and gyroscope bias do not depend on the fixes and are kept
+    m_is_initialized = false;
+    m_fix_age        = 0u;
+}
+
+/** @brief Propagate the estimation with new inertial data acquired dt milliseconds after the previous ones */
+void dead_reckoning::propagate(const i_accelerometer_sensor::data& accel, const i_gyroscope_sensor::data& gyro, uint32_t dt)
+{
+    // Gravity direction
+    if (accel.is_valid)
+    {
+        const float acceleration[] = {
+            static_cast<float>(accel.x_accel), static_cast<float>(accel.y_accel), static_cast<float>(accel.z_accel)};
+        for (size_t i = 0; i < 3u; i++)
+        {
+            m_gravity[i] = m_is_gravity_valid ? (m_gravity[i] + GRAVITY_GAIN * (acceleration[i] - m_gravity[i])) : acceleration[i];
+        }
+        m_is_gravity_valid = true;
+    }
+
+    if (m_is_initialized)
+    {
+        const float dt_s = static_cast<float>(dt) / 1000.f;
+        m_fix_age += dt;
+
+        // Heading, a counterclockwise rotation around the vertical axis decreases the heading
+        if (gyro.is_valid && m_is_gravity_valid)
+        {
+            const float norm = std::sqrt(m_gravity[0u] * m_gravity[0u] + m_gravity[1u] * m_gravity[1u] + m_gravity[2u] * m_gravity[2u]);
+            if (norm > MIN_GRAVITY)
+            {
+                const float dot = m_gravity[0u] * static_cast<float>(gyro.x_rate) + m_gravity[1u] * static_cast<float>(gyro.y_rate) +
+                                  m_gravity[2u] * static_cast<float>(gyro.z_rate);
+                const float vertical_rate = dot * RATE_TO_RAD / norm;
+                const float turn          = (m_heading_rate_bias - vertical_rate) * dt_s;
+                m_heading                 = normalize_heading(m_heading + turn);
+                m_gyro_turn += turn;
+            }
+        }
+
+        // Speed
+        m_speed += m_acceleration * dt_s;
+        if (m_speed < 0.f)
+        {
+            m_speed = 0.f;
+        }
+
+        // Position
+        m_east += m_speed * std::sin(m_heading) * dt_s;
+        m_north += m_speed * std::cos(m_heading) * dt_s;
+    }
+}
+
+/** @brief Correct the estimation with a new GNSS fix */
+void dead_reckoning::correct(const i_gnss::data& gnss)
+{
+    if (gnss.is_valid)
+    {
+        if (!m_is_initialized || (m_fix_age > MAX_PROPAGATION_MS))
+        {
+            init(gnss);
+        }
+        else
+        {
+            // Pull the position toward the fix then move the origin of the local frame on the fix
+            const geo::position fix       = gnss.get_position();
+            const float         fix_east  = geo::delta_lon_rad(m_origin, fix) * m_east_scale;
+            const float         fix_north = geo::delta_lat_rad(m_origin, fix) * geo::EARTH_RADIUS;
+            m_east                        = (1.f - POSITION_GAIN) * (m_east - fix_east);
+            m_north                       = (1.f - POSITION_GAIN) * (m_north - fix_north);
+            m_origin                      = fix;
+            m_east_scale                  = get_east_scale(fix);
+
+            // Along track acceleration between the last fixes
+            const float dt_s = static_cast<float>(m_fix_age) / 1000.f;
+            if (dt_s > 0.f)
+            {
+                const float delta_speed = static_cast<float>(static_cast<int32_t>(gnss.speed) - static_cast<int32_t>(m_fix_speed)) / 10.f;
+                m_acceleration          = std::fmax(std::fmin(delta_speed / dt_s, MAX_ACCELERATION), -MAX_ACCELERATION);
+            }
+            m_speed = static_cast<float>(gnss.speed) / 10.f;
+
+            // Heading and gyroscope bias, only when the track angles are meaningful
+            const float track = static_cast<float>(gnss.track_angle) * TRACK_TO_RAD;
+            if (gnss.speed >= MIN_TRACK_SPEED)
+            {
+                if ((m_fix_speed >= MIN_TRACK_SPEED) && (dt_s > 0.f))
+                {
+                    const float gnss_turn = wrap_angle(track - static_cast<float>(m_fix_track) * TRACK_TO_RAD);
+                    m_heading_rate_bias += BIAS_GAIN * (gnss_turn - m_gyro_turn) / dt_s;
+                    m_heading = normalize_heading(m_heading + HEADING_GAIN * wrap_angle(track - m_heading));
+                }
+                else
+                {
+                    m_heading = track;
+                }
+            }
+        }
+
+        m_fix_speed = gnss.speed;
+        m_fix_track = gnss.track_angle;
+        m_fix_age   = 0u;
+        m_gyro_turn = 0.f;
+    }
+}
+
+/** @brief Get the current estimate */
+position_estimate dead_reckoning::get_estimate() const
+{
+    position_estimate ret = {};
+    if (m_is_initialized)
+    {
+        const int64_t longitude = static_cast<int64_t>(m_origin.longitude) + std::lround(m_east / m_east_scale * geo::RAD_TO_UNITS);
+        ret.position.latitude   = m_origin.latitude + static_cast<int32_t>(std::lround(m_north / geo::EARTH_RADIUS * geo::RAD_TO_UNITS));
+        ret.position.longitude  = geo::wrap_longitude(longitude);
+        ret.speed               = static_cast<uint32_t>(std::lround(m_speed * 10.f));
+        ret.track_angle         = static_cast<uint16_t>(std::lround(m_heading * geo::RAD_TO_DEG * 10.f) % 3600);
+        ret.fix_age             = m_fix_age;
+        ret.is_valid            = (m_fix_age <= MAX_PROPAGATION_MS);
+    }
+    return ret;
+}
+
+/** @brief Start the estimation on a fix */
+void dead_reckoning::init(const i_gnss::data& gnss)
+{
+    m_is_initialized = true;
+    m_origin         = gnss.get_position();
+    m_east_scale     = get_east_scale(m_origin);
+    m_east           = 0.f;
+    m_north          = 0.f;
+    m_speed          = static_cast<float>(gnss.speed) / 10.f;
+    m_acceleration   = 0.f;
+    m_heading        = static_cast<float>(gnss.track_angle) * TRACK_TO_RAD;
+}
+
+} // namespace ov
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_DEAD_RECKONING_H
+#define OV_DEAD_RECKONING_H
+
+#include "i_accelerometer_sensor.h"
+#include "i_gnss.h"
+#include "i_gyroscope_sensor.h"
+#include "position_estimate.h"
+
+namespace ov
+{
+
+/**
+ * @brief Horizontal dead reckoning between the GNSS fixes
+ *        The heading is propagated with the rotation rate around the vertical axis, which is the gyroscope rate projected
+ *        on the low-pass filtered acceleration so that it does not depend on the mounting of the device. The speed is
+ *        propagated with the along track acceleration measured between the last fixes, and the position is integrated
+ *        in a local frame centered on the last fix. Each fix pulls the position and the heading toward the GNSS values
+ *        and estimates the gyroscope bias from the difference between the GNSS and the gyroscope turns.
+ *        Each update runs in a constant number of single precision operations and does not depend on the OS,
+ *        the elapsed time is given by the caller
+ */
+class dead_reckoning
+{
+  public:
+    /** @brief Fraction of the position error corrected on each fix */
+    static constexpr float POSITION_GAIN = 0.7f;
+    /** @brief Fraction of the heading error corrected on each fix */
+    static constexpr float HEADING_GAIN = 0.5f;
+    /** @brief Fraction of the turn rate error used to correct the gyroscope bias on each fix */
+    static constexpr float BIAS_GAIN = 0.1f;
+    /** @brief Gain of the low-pass filter estimating the gravity direction */
+    static constexpr float GRAVITY_GAIN = 0.02f;
+    /** @brief Minimum ground speed for the track angle to be meaningful (1 = 0.1m/s) */
+    static constexpr uint32_t MIN_TRACK_SPEED = 30u;
+    /** @brief Maximum propagation time without a fix in milliseconds, the estimate is invalid afterwards */
+    static constexpr uint32_t MAX_PROPAGATION_MS = 3000u;
+
+    /** @brief Constructor */
+    dead_reckoning();
+
+    /** @brief Reset the estimation, it restarts on the next fix */
+    void reset();
+
+    /** @brief Propagate the estimation with new inertial data acquired dt milliseconds after the previous ones */
+    void propagate(const i_accelerometer_sensor::data& accel, const i_gyroscope_sensor::data& gyro, uint32_t dt);
+
+    /** @brief Correct the estimation with a new GNSS fix */
+    void correct(const i_gnss::data& gnss);
+
+    /** @brief Get the current estimate */
+    position_estimate get_estimate() const;
+
+  private:
+    /** @brief Indicate if the estimation has been initialized by a fix */
+    bool m_is_initialized;
+    /** @brief Origin of the local frame, the last fix */
+    geo::position m_origin;
+    /** @brief Meters per radian of longitude at the origin */
+    float m_east_scale;
+    /** @brief Position east of the origin (m) */
+    float m_east;
+    /** @brief Position north of the origin (m) */
+    float m_north;
+    /** @brief Ground speed (m/s) */
+    float m_speed;
+    /** @brief Along track acceleration (m/s²) */
+    float m_acceleration;
+    /** @brief Heading, clockwise from north (rad) */
+    float m_heading;
+    /** @brief Gyroscope bias on the heading rate (rad/s) */
+    float m_heading_rate_bias;
+    /** @brief Heading change integrated from the gyroscope since the last fix (rad) */
+    float m_gyro_turn;
+    /** @brief Low-pass filtered acceleration, opposite to the gravity (1000 = 1g) */
+    float m_gravity[3u];
+    /** @brief Indicate if the gravity direction has been initialized */
+    bool m_is_gravity_valid;
+    /** @brief Ground speed of the last fix (1 = 0.1m/s) */
+    uint32_t m_fix_speed;
+    /** @brief Track angle of the last fix (1 = 0.1°) */
+    uint16_t m_fix_track;
+    /** @brief Time elapsed since the last fix in milliseconds */
+    uint32_t m_fix_age;
+
+    /** @brief Start the estimation on a fix */
+    void init(const i_gnss::data& gnss);
+};
+
+} // namespace ov
+
+#endif // OV_DEAD_RECKONING_H
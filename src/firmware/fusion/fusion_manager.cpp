@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "fusion_manager.h"
+#include "os.h"
+#include "ov_data.h"
+
+namespace ov
+{
+
+/** @brief Period of the inertial updates in milliseconds */
+static const uint32_t UPDATE_PERIOD_MS = 20u;
+
+/** @brief Constructor */
+fusion_manager::fusion_manager(i_accelerometer_sensor& accelerometer, i_gyroscope_sensor& gyroscope)
+    : m_accelerometer(accelerometer), m_gyroscope(gyroscope), m_filter(), m_fix_date{}, m_thread()
+{
+}
+
+/** @brief Initialize the fusion manager */
+bool fusion_manager::init()
+{
+    // Start fusion thread
+    auto thread_func = ov::thread_func::create<fusion_manager, &fusion_manager::thread_func>(*this);
+    bool ret         = m_thread.start(thread_func, "Fusion", 2u, nullptr);
+
+    return ret;
+}
+
+/** @brief Fusion thread */
+void fusion_manager::thread_func(void*)
+{
+    uint32_t last_update = ov::os::now();
+
+    // Thread loop
+    while (true)
+    {
+        // Propagate with the inertial sensors, the elapsed time is measured to absorb the scheduling jitter
+        const i_accelerometer_sensor::data accel_data = m_accelerometer.get_data();
+        const i_gyroscope_sensor::data     gyro_data  = m_gyroscope.get_gyro_data();
+        const uint32_t                     now        = ov::os::now();
+        m_filter.propagate(accel_data, gyro_data, now - last_update);
+        last_update = now;
+
+        // Correct on each new GNSS fix
+        const i_gnss::data gnss = ov::data::get_gnss();
+        if (gnss.is_valid && ((gnss.date.millis != m_fix_date.millis) || (gnss.date.second != m_fix_date.second) ||
+                              (gnss.date.minute != m_fix_date.minute) || (gnss.date.hour != m_fix_date.hour)))
+        {
+            m_filter.correct(gnss);
+            m_fix_date = gnss.date;
+        }
+
+        // Publish the estimate
+        ov::data::set_position_estimate(m_filter.get_estimate());
+
+        ov::this_thread::sleep_for(UPDATE_PERIOD_MS);
+    }
+}
+
+} // namespace ov
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FUSION_MANAGER_H
+#define OV_FUSION_MANAGER_H
+
+#include "dead_reckoning.h"
+#include "thread.h"
+
+namespace ov
+{
+
+/** @brief Propagate the GNSS position at the inertial sensors rate and publish the estimate */
+class fusion_manager
+{
+  public:
+    /** @brief Constructor */
+    fusion_manager(i_accelerometer_sensor& accelerometer, i_gyroscope_sensor& gyroscope);
+
+    /** @brief Initialize the fusion manager */
+    bool init();
+
+  private:
+    /** @brief Accelerometer */
+    i_accelerometer_sensor& m_accelerometer;
+    /** @brief Gyroscope */
+    i_gyroscope_sensor& m_gyroscope;
+    /** @brief Dead reckoning filter */
+    dead_reckoning m_filter;
+    /** @brief Date and time of the last GNSS fix used for a correction */
+    date_time m_fix_date;
+    /** @brief Fusion thread */
+    thread<1024u> m_thread;
+
+    /** @brief Fusion thread */
+    void thread_func(void*);
+};
+
+} // namespace ov
+
+#endif // OV_FUSION_MANAGER_H
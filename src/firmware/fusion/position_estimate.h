@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_POSITION_ESTIMATE_H
+#define OV_POSITION_ESTIMATE_H
+
+#include "geodesy.h"
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Horizontal position propagated from the inertial sensors between the GNSS fixes */
+struct position_estimate
+{
+    /** @brief Position */
+    geo::position position;
+    /** @brief Ground speed (1 = 0.1m/s) */
+    uint32_t speed;
+    /** @brief Track angle (1 = 0.1°) */
+    uint16_t track_angle;
+    /** @brief Time elapsed since the last GNSS fix in milliseconds */
+    uint32_t fix_age;
+    /** @brief Indicate if the estimate is valid */
+    bool is_valid;
+};
+
+} // namespace ov
+
+#endif // OV_POSITION_ESTIMATE_H
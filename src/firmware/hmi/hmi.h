@@ -48,8 +48,14 @@ enum class hmi_screen
     dashboard3,
     /** @brief Dashboard 4 */
     dashboard4,
+    /** @brief Airspace */
+    airspace,
+    /** @brief Task navigation */
+    navigation,
     /** @brief Flight */
     flight,
+    /** @brief Flight history */
+    flight_history,
     /** @brief GNSS */
     gnss,
     /** @brief BLE */
@@ -61,7 +61,9 @@ void hmi_console::night_handler(const char* mode)
     {
         m_console.write_line("OFF");
     }
-    ov::config::get().is_night_mode_on = on;
+    ov::config::transaction tr;
+    tr.values().is_night_mode_on = on;
+    tr.commit(false);
 }
 
 } // namespace ov
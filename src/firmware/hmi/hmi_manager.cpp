@@ -9,6 +9,7 @@
 #include "i_hmi_screen.h"
 #include "os.h"
 #include "ov_config.h"
+#include "ov_data.h"
 
 #include <YACSGL.h>
 #include <YACSWL.h>
@@ -33,6 +34,7 @@ hmi_manager::hmi_manager(i_display&              display,
       m_buttons(),
       m_hmi_console(debug_console, *this),
       m_display_on(true),
+      m_airspace_level(airspace_status::level::none),
       m_current_screen(&m_splash_screen),
       m_next_screen(hmi_screen::splash),
       m_screens(),
@@ -41,7 +43,10 @@ hmi_manager::hmi_manager(i_display&              display,
       m_dashboard2_screen(*this),
       m_dashboard3_screen(*this),
       m_dashboard4_screen(*this),
+      m_airspace_screen(*this),
+      m_navigation_screen(*this),
       m_flight_screen(*this, recorder),
+      m_flight_history_screen(*this),
       m_gnss_screen(*this),
       m_ble_screen(*this, ble_manager),
       m_usb_screen(*this, xctrack_link),
@@ -67,14 +72,17 @@ hmi_manager::hmi_manager(i_display&              display,
     m_screens[2u]  = &m_dashboard2_screen;
     m_screens[3u]  = &m_dashboard3_screen;
     m_screens[4u]  = &m_dashboard4_screen;
-    m_screens[5u]  = &m_flight_screen;
-    m_screens[6u]  = &m_gnss_screen;
-    m_screens[7u]  = &m_ble_screen;
-    m_screens[8u]  = &m_usb_screen;
-    m_screens[9u]  = &m_settings_screen;
-    m_screens[10u] = &m_settings_glider_screen;
-    m_screens[11u] = &m_settings_display_screen;
-    m_screens[12u] = &m_settings_exit_screen;
+    m_screens[5u]  = &m_airspace_screen;
+    m_screens[6u]  = &m_navigation_screen;
+    m_screens[7u]  = &m_flight_screen;
+    m_screens[8u]  = &m_flight_history_screen;
+    m_screens[9u]  = &m_gnss_screen;
+    m_screens[10u] = &m_ble_screen;
+    m_screens[11u] = &m_usb_screen;
+    m_screens[12u] = &m_settings_screen;
+    m_screens[13u] = &m_settings_glider_screen;
+    m_screens[14u] = &m_settings_display_screen;
+    m_screens[15u] = &m_settings_exit_screen;
 }
 
 /** @brief Start the HMI manager */
@@ -174,33 +182,50 @@ void hmi_manager::thread_func(void*)
             bt.is_pushed = is_pushed;
         }
 
+        // Show the airspace screen when getting close to an airspace while a dashboard is displayed
+        auto airspace_level = ov::data::get_airspace().proximity;
+        if ((airspace_level >= airspace_status::level::warning) && (airspace_level > m_airspace_level))
+        {
+            auto current_id = m_current_screen->get_id();
+            if ((current_id >= hmi_screen::dashboard1) && (current_id <= hmi_screen::dashboard4))
+            {
+                m_next_screen    = hmi_screen::airspace;
+                last_user_action = os::now();
+            }
+        }
+        m_airspace_level = airspace_level;
+
         // Update current screen
         if (m_current_screen->get_id() != m_next_screen)
         {
-            // Switch screen
+            // Switch screen, the new screen is fully redrawn
             m_current_screen = m_screens[static_cast<int>(m_next_screen)];
+            m_current_screen->invalidate();
         }
-        m_current_screen->set_night_mode(ov::config::get().is_night_mode_on);
-        m_current_screen->refresh(frame);
+        const ov_config config = ov::config::get();
+        m_current_screen->set_night_mode(config.is_night_mode_on);
+        uint32_t modified_pages = m_current_screen->refresh(frame);
 
         // Refresh rate = 5FPS
         if (m_display.is_on())
         {
-            if (!m_display_on ||
-                ((ov::config::get().disp_saver_timeout != 0u) && ((os::now() - last_user_action) > ov::config::get().disp_saver_timeout)))
+            if (!m_display_on || ((config.disp_saver_timeout != 0u) && ((os::now() - last_user_action) > config.disp_saver_timeout)))
             {
                 m_display.turn_off();
             }
         }
         else
         {
-            if (m_display_on &&
-                ((ov::config::get().disp_saver_timeout == 0u) || ((os::now() - last_user_action) <= ov::config::get().disp_saver_timeout)))
+            if (m_display_on && ((config.disp_saver_timeout == 0u) || ((os::now() - last_user_action) <= config.disp_saver_timeout)))
             {
                 m_display.turn_on();
             }
         }
-        m_display.refresh();
+        if (modified_pages != 0u)
+        {
+            // Transfer only the modified pages
+            m_display.refresh(modified_pages);
+        }
         ov::this_thread::sleep_for(200u);
     }
 }
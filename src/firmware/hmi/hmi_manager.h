@@ -6,17 +6,21 @@
 #ifndef OV_HMI_MANAGER_H
 #define OV_HMI_MANAGER_H
 
+#include "airspace.h"
 #include "hmi_console.h"
 #include "i_hmi_manager.h"
 #include "thread.h"
 
+#include "airspace_screen.h"
 #include "ble_screen.h"
 #include "dashboard1_screen.h"
 #include "dashboard2_screen.h"
 #include "dashboard3_screen.h"
 #include "dashboard4_screen.h"
+#include "flight_history_screen.h"
 #include "flight_screen.h"
 #include "gnss_screen.h"
+#include "navigation_screen.h"
 #include "settings_display_screen.h"
 #include "settings_exit_screen.h"
 #include "settings_glider_screen.h"
@@ -77,6 +81,8 @@ class hmi_manager : public i_hmi_manager
     hmi_console m_hmi_console;
     /** @brief Indicate if the display is ON */
     bool m_display_on;
+    /** @brief Last airspace proximity level */
+    airspace_status::level m_airspace_level;
 
     /** @brief Current screen */
     i_hmi_screen* m_current_screen;
@@ -95,8 +101,14 @@ class hmi_manager : public i_hmi_manager
     dashboard3_screen m_dashboard3_screen;
     /** @brief Dashboard 4 screen */
     dashboard4_screen m_dashboard4_screen;
+    /** @brief Airspace screen */
+    airspace_screen m_airspace_screen;
+    /** @brief Navigation screen */
+    navigation_screen m_navigation_screen;
     /** @brief Flight screen */
     flight_screen m_flight_screen;
+    /** @brief Flight history screen */
+    flight_history_screen m_flight_history_screen;
     /** @brief GNSS screen */
     gnss_screen m_gnss_screen;
     /** @brief BLE screen */
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_screen.h"
+#include "ov_data.h"
+#include "text_writer.h"
+
+#include <YACSGL_font_5x7.h>
+
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+airspace_screen::airspace_screen(i_hmi_manager& hmi_manager) : base_screen(hmi_screen::airspace, hmi_manager) { }
+
+/** @brief Button event */
+void airspace_screen::event(button bt, button_event bt_event)
+{
+    if (bt_event == button_event::short_push)
+    {
+        if (bt == button::next)
+        {
+            switch_to_screen(hmi_screen::navigation);
+        }
+        if (bt == button::previous)
+        {
+            switch_to_screen(hmi_screen::dashboard4);
+        }
+    }
+}
+
+/** @brief Initialize the screen */
+void airspace_screen::on_init(YACSGL_frame_t& frame)
+{
+    // Default values
+    strcpy(m_status_string, "Unavailable");
+    m_name_string[0u]      = 0;
+    m_distances_string[0u] = 0;
+
+    // Airspace label
+    YACSWL_label_init(&m_airspace_label);
+    YACSWL_label_set_text(&m_airspace_label, "Airspace");
+    YACSWL_widget_set_border_width(&m_airspace_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_airspace_label.widget, (frame.frame_x_width - YACSWL_widget_get_width(&m_airspace_label.widget)) / 2u, 5u);
+
+    // Status label
+    YACSWL_label_init(&m_status_label);
+    YACSWL_label_set_text(&m_status_label, m_status_string);
+    YACSWL_widget_set_border_width(&m_status_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_status_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_airspace_label.widget) + YACSWL_widget_get_height(&m_airspace_label.widget));
+
+    // Name label
+    YACSWL_label_init(&m_name_label);
+    YACSWL_label_set_text(&m_name_label, m_name_string);
+    YACSWL_label_set_font(&m_name_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_name_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_name_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_status_label.widget) + YACSWL_widget_get_height(&m_status_label.widget));
+
+    // Distances label
+    YACSWL_label_init(&m_distances_label);
+    YACSWL_label_set_text(&m_distances_label, m_distances_string);
+    YACSWL_label_set_font(&m_distances_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_distances_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_distances_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_name_label.widget) + YACSWL_widget_get_height(&m_name_label.widget) + 2u);
+
+    // Add to root widget
+    YACSWL_widget_add_child(&m_root_widget, &m_airspace_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_status_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_name_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_distances_label.widget);
+}
+
+/** @brief Refresh the contents of the screen */
+void airspace_screen::on_refresh(YACSGL_frame_t&)
+{
+    // Update strings
+    auto airspace     = ov::data::get_airspace();
+    bool show_details = false;
+    if (!airspace.is_valid)
+    {
+        strcpy(m_status_string, "Unavailable");
+    }
+    else
+    {
+        switch (airspace.proximity)
+        {
+            case airspace_status::level::inside:
+                text_writer(m_status_string).write("INSIDE ").write(airspace_class_name(airspace.cls));
+                show_details = true;
+                break;
+
+            case airspace_status::level::warning:
+                text_writer(m_status_string).write("WARNING ").write(airspace_class_name(airspace.cls));
+                show_details = true;
+                break;
+
+            case airspace_status::level::near:
+                text_writer(m_status_string).write("Near ").write(airspace_class_name(airspace.cls));
+                show_details = true;
+                break;
+
+            case airspace_status::level::none:
+                [[fallthrough]];
+            default:
+                strcpy(m_status_string, "Clear");
+                break;
+        }
+    }
+    if (show_details)
+    {
+        strcpy(m_name_string, airspace.name);
+        text_writer distances(m_distances_string);
+        distances.write("H: ").write_int(airspace.horizontal_distance).write("m V: ").write_int(airspace.vertical_distance).write('m');
+    }
+    YACSWL_widget_set_displayed(&m_name_label.widget, show_details);
+    YACSWL_widget_set_displayed(&m_distances_label.widget, show_details);
+}
+
+} // namespace ov
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_AIRSPACE_SCREEN_H
+#define OV_AIRSPACE_SCREEN_H
+
+#include "base_screen.h"
+
+namespace ov
+{
+
+/** @brief Airspace screen */
+class airspace_screen : public base_screen
+{
+  public:
+    /** @brief Constructor */
+    airspace_screen(i_hmi_manager& hmi_manager);
+
+    /** @brief Button event */
+    void event(button bt, button_event bt_event) override;
+
+  private:
+    /** @brief Airspace label */
+    YACSWL_label_t m_airspace_label;
+    /** @brief Status label */
+    YACSWL_label_t m_status_label;
+    /** @brief Name label */
+    YACSWL_label_t m_name_label;
+    /** @brief Distances label */
+    YACSWL_label_t m_distances_label;
+    /** @brief Status string */
+    char m_status_string[20u];
+    /** @brief Name string */
+    char m_name_string[32u];
+    /** @brief Distances string */
+    char m_distances_string[24u];
+
+    /** @brief Initialize the screen */
+    void on_init(YACSGL_frame_t& frame) override;
+
+    /** @brief Refresh the contents of the screen */
+    void on_refresh(YACSGL_frame_t& frame) override;
+};
+
+} // namespace ov
+
+#endif // OV_AIRSPACE_SCREEN_H
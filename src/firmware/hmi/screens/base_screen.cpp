@@ -4,6 +4,7 @@
  */
 
 #include "base_screen.h"
+#include "i_display.h"
 #include "i_hmi_manager.h"
 
 namespace ov
@@ -11,7 +12,13 @@ namespace ov
 
 /** @brief Constructor */
 base_screen::base_screen(hmi_screen screen_id, i_hmi_manager& hmi_manager)
-    : m_root_widget(), m_screen_id(screen_id), m_hmi_manager(hmi_manager)
+    : m_root_widget(),
+      m_screen_id(screen_id),
+      m_hmi_manager(hmi_manager),
+      m_tracked_labels(),
+      m_tracked_count(0u),
+      m_full_redraw(true),
+      m_night_mode(false)
 {
 }
 
@@ -25,21 +32,111 @@ void base_screen::init(YACSGL_frame_t& frame)
 
     // Specific init
     on_init(frame);
+
+    // First refresh draws the whole screen
+    m_full_redraw = true;
 }
 
-/** @brief Refresh the contents of the screen */
-void base_screen::refresh(YACSGL_frame_t& frame)
+/** @brief Refresh the contents of the screen and get the pages of the frame which have been modified (bit n = page n) */
+uint32_t base_screen::refresh(YACSGL_frame_t& frame)
 {
+    uint32_t pages = 0u;
+
     // Specific refresh
     on_refresh(frame);
 
-    // Draw widgets
-    YACSWL_widget_draw(&m_root_widget, &frame);
+    if (m_full_redraw || (m_tracked_count == 0u))
+    {
+        // Draw widgets
+        for (size_t i = 0u; i < m_tracked_count; i++)
+        {
+            tracked_label& tracked = m_tracked_labels[i];
+            YACSWL_label_set_text(tracked.label, tracked.text);
+            tracked.hash       = hash(tracked.text);
+            tracked.drawn_area = get_area(*tracked.label);
+        }
+        YACSWL_widget_draw(&m_root_widget, &frame);
+        pages         = get_pages({0u, 0u, YACSWL_widget_get_width(&m_root_widget), YACSWL_widget_get_height(&m_root_widget)});
+        m_full_redraw = false;
+    }
+    else
+    {
+        // Update the labels whose text has changed
+        const YACSGL_pixel_t background                      = (m_night_mode ? YACSGL_P_BLACK : YACSGL_P_WHITE);
+        area                 erased[MAX_TRACKED_LABELS]      = {};
+        size_t               erased_count                    = 0u;
+        bool                 must_redraw[MAX_TRACKED_LABELS] = {};
+        for (size_t i = 0u; i < m_tracked_count; i++)
+        {
+            tracked_label& tracked   = m_tracked_labels[i];
+            const uint32_t text_hash = hash(tracked.text);
+            if (text_hash != tracked.hash)
+            {
+                const area old_area = tracked.drawn_area;
+                YACSWL_label_set_text(tracked.label, tracked.text);
+                tracked.hash       = text_hash;
+                tracked.drawn_area = get_area(*tracked.label);
+                must_redraw[i]     = true;
+
+                // The label fills its background when drawn, the previous text is erased only if it was larger
+                if (!contains(tracked.drawn_area, old_area))
+                {
+                    YACSGL_rect_fill(&frame, old_area.x, old_area.y, old_area.x + old_area.width, old_area.y + old_area.height, background);
+                    pages |= get_pages(old_area);
+                    erased[erased_count] = old_area;
+                    erased_count++;
+                }
+            }
+        }
+
+        // Labels overlapping an erased or a redrawn label must be redrawn too to get the same result as a full redraw
+        bool marked = true;
+        while (marked)
+        {
+            marked = false;
+            for (size_t i = 0u; i < m_tracked_count; i++)
+            {
+                const area& label_area = m_tracked_labels[i].drawn_area;
+                bool        overlaps   = must_redraw[i];
+                for (size_t j = 0u; (j < erased_count) && !overlaps; j++)
+                {
+                    overlaps = intersects(label_area, erased[j]);
+                }
+                for (size_t j = 0u; (j < m_tracked_count) && !overlaps; j++)
+                {
+                    overlaps = (must_redraw[j] && intersects(label_area, m_tracked_labels[j].drawn_area));
+                }
+                if (overlaps && !must_redraw[i])
+                {
+                    must_redraw[i] = true;
+                    marked         = true;
+                }
+            }
+        }
+
+        // Redraw in the drawing order of the widgets
+        for (size_t i = 0u; i < m_tracked_count; i++)
+        {
+            if (must_redraw[i])
+            {
+                YACSWL_widget_draw(&m_tracked_labels[i].label->widget, &frame);
+                pages |= get_pages(m_tracked_labels[i].drawn_area);
+            }
+        }
+    }
+
+    return pages;
 }
 
 /** @brief Set the night mode */
 void base_screen::set_night_mode(bool is_on)
 {
+    if (is_on != m_night_mode)
+    {
+        // Colors of the whole screen are changed
+        m_night_mode  = is_on;
+        m_full_redraw = true;
+    }
     if (is_on)
     {
         YACSWL_widget_set_foreground_color(&m_root_widget, YACSGL_P_WHITE);
@@ -58,4 +155,73 @@ void base_screen::switch_to_screen(hmi_screen screen)
     m_hmi_manager.set_next_screen(screen);
 }
 
+/** @brief Set the text of a label and redraw only this label when its text changes */
+bool base_screen::track_label(YACSWL_label_t& label, const char* text)
+{
+    bool ret = false;
+
+    YACSWL_label_set_text(&label, text);
+    if (m_tracked_count < MAX_TRACKED_LABELS)
+    {
+        tracked_label& tracked = m_tracked_labels[m_tracked_count];
+        tracked.label          = &label;
+        tracked.text           = text;
+        tracked.hash           = hash(text);
+        tracked.drawn_area     = get_area(label);
+        m_tracked_count++;
+
+        ret = true;
+    }
+
+    return ret;
+}
+
+/** @brief Compute the hash of a text */
+uint32_t base_screen::hash(const char* text)
+{
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    while (*text != 0)
+    {
+        h ^= static_cast<uint8_t>(*text);
+        h *= 16777619u;
+        text++;
+    }
+    return h;
+}
+
+/** @brief Get the area of a label */
+base_screen::area base_screen::get_area(YACSWL_label_t& label)
+{
+    return {YACSWL_widget_get_pos_x(&label.widget),
+            YACSWL_widget_get_pos_y(&label.widget),
+            YACSWL_widget_get_width(&label.widget),
+            YACSWL_widget_get_height(&label.widget)};
+}
+
+/** @brief Indicate if 2 areas have pixels in common */
+bool base_screen::intersects(const area& a, const area& b)
+{
+    return ((a.x <= (b.x + b.width)) && (b.x <= (a.x + a.width)) && (a.y <= (b.y + b.height)) && (b.y <= (a.y + a.height)));
+}
+
+/** @brief Indicate if an area contains another area */
+bool base_screen::contains(const area& a, const area& b)
+{
+    return ((a.x <= b.x) && ((b.x + b.width) <= (a.x + a.width)) && (a.y <= b.y) && ((b.y + b.height) <= (a.y + a.height)));
+}
+
+/** @brief Get the pages of the frame covered by an area (bit n = page n) */
+uint32_t base_screen::get_pages(const area& a)
+{
+    uint32_t     pages = 0u;
+    const size_t first = a.y / i_display::PAGE_HEIGHT;
+    const size_t last  = (a.y + a.height) / i_display::PAGE_HEIGHT;
+    for (size_t page = first; (page <= last) && (page < 32u); page++)
+    {
+        pages |= (1u << page);
+    }
+    return pages;
+}
+
 } // namespace ov
@@ -9,6 +9,7 @@
 #include "i_hmi_screen.h"
 
 #include <YACSWL.h>
+#include <cstddef>
 
 namespace ov
 {
@@ -32,8 +33,11 @@ class base_screen : public i_hmi_screen
     /** @brief Button event */
     void event(button, button_event) override { }
 
-    /** @brief Refresh the contents of the screen */
-    void refresh(YACSGL_frame_t& frame) override;
+    /** @brief Refresh the contents of the screen and get the pages of the frame which have been modified (bit n = page n) */
+    uint32_t refresh(YACSGL_frame_t& frame) override;
+
+    /** @brief Force a full redraw of the screen at the next refresh */
+    void invalidate() override { m_full_redraw = true; }
 
     /** @brief Set the night mode */
     void set_night_mode(bool is_on) override;
@@ -51,14 +55,74 @@ class base_screen : public i_hmi_screen
     /** @brief Switch to the specified screen */
     void switch_to_screen(hmi_screen screen);
 
+    /**
+     * @brief Set the text of a label and redraw only this label when its text changes
+     *        A screen where all the labels are tracked is not fully redrawn at each refresh,
+     *        screens which move or hide widgets must not track their labels.
+     *        Labels must be tracked in the order they are added to the root widget, overlapping labels are redrawn together
+     */
+    bool track_label(YACSWL_label_t& label, const char* text);
+
     /** @brief Get HMI manager */
     i_hmi_manager& get_hmi() { return m_hmi_manager; }
 
   private:
+    /** @brief Maximum number of tracked labels */
+    static constexpr size_t MAX_TRACKED_LABELS = 8u;
+
+    /** @brief Area of the frame */
+    struct area
+    {
+        /** @brief X coordinate of the top left corner */
+        uint16_t x;
+        /** @brief Y coordinate of the top left corner */
+        uint16_t y;
+        /** @brief Width (inclusive) */
+        uint16_t width;
+        /** @brief Height (inclusive) */
+        uint16_t height;
+    };
+
+    /** @brief Label whose text is tracked */
+    struct tracked_label
+    {
+        /** @brief Label */
+        YACSWL_label_t* label;
+        /** @brief Text */
+        const char* text;
+        /** @brief Hash of the text at the last draw */
+        uint32_t hash;
+        /** @brief Area of the label at the last draw */
+        area drawn_area;
+    };
+
     /** @brief Screen identifier */
     const hmi_screen m_screen_id;
     /** @brief HMI manager */
     i_hmi_manager& m_hmi_manager;
+    /** @brief Tracked labels */
+    tracked_label m_tracked_labels[MAX_TRACKED_LABELS];
+    /** @brief Number of tracked labels */
+    size_t m_tracked_count;
+    /** @brief Indicate if the whole screen must be redrawn at the next refresh */
+    bool m_full_redraw;
+    /** @brief Indicate if the night mode is on */
+    bool m_night_mode;
+
+    /** @brief Compute the hash of a text */
+    static uint32_t hash(const char* text);
+
+    /** @brief Get the area of a label */
+    static area get_area(YACSWL_label_t& label);
+
+    /** @brief Indicate if 2 areas have pixels in common */
+    static bool intersects(const area& a, const area& b);
+
+    /** @brief Indicate if an area contains another area */
+    static bool contains(const area& a, const area& b);
+
+    /** @brief Get the pages of the frame covered by an area (bit n = page n) */
+    static uint32_t get_pages(const area& a);
 };
 
 } // namespace ov
@@ -7,9 +7,8 @@
 #include "i_barometric_altimeter.h"
 #include "ov_config.h"
 #include "ov_data.h"
+#include "text_writer.h"
 
-#include <cmath>
-#include <cstdio>
 #include <cstring>
 
 namespace ov
@@ -48,11 +47,12 @@ void dashboard1_screen::event(button bt, button_event bt_event)
                 {
                     m_altimeter.set_references(alti_data.temperature, alti_data.pressure, gnss_data.altitude);
 
-                    auto& config             = ov::config::get();
-                    config.alti_ref_alti     = gnss_data.altitude;
-                    config.alti_ref_pressure = alti_data.pressure;
-                    config.alti_ref_temp     = alti_data.temperature;
-                    ov::config::save();
+                    ov::config::transaction tr;
+                    auto&                   config = tr.values();
+                    config.alti_ref_alti           = gnss_data.altitude;
+                    config.alti_ref_pressure       = alti_data.pressure;
+                    config.alti_ref_temp           = alti_data.temperature;
+                    tr.commit(true);
                 }
             }
         }
@@ -69,24 +69,24 @@ void dashboard1_screen::on_init(YACSGL_frame_t&)
 
     // QNH label
     YACSWL_label_init(&m_qnh_label);
-    YACSWL_label_set_text(&m_qnh_label, m_qnh_string);
+    track_label(m_qnh_label, m_qnh_string);
     YACSWL_widget_set_border_width(&m_qnh_label.widget, 0u);
     YACSWL_widget_set_pos(&m_qnh_label.widget, 5u, 5u);
 
     // Pressure label
     YACSWL_label_init(&m_pressure_label);
-    YACSWL_label_set_text(&m_pressure_label, m_pressure_string);
+    track_label(m_pressure_label, m_pressure_string);
     YACSWL_widget_set_border_width(&m_pressure_label.widget, 0u);
     YACSWL_widget_set_pos(
-        &m_pressure_label.widget, 5u, YACSWL_widget_get_pos_y(&m_qnh_label.widget) + YACSWL_widget_get_height(&m_qnh_label.widget));
+        &m_pressure_label.widget, 5u, YACSWL_widget_get_pos_y(&m_qnh_label.widget) + YACSWL_widget_get_height(&m_qnh_label.widget) + 1u);
 
     // Temperature label
     YACSWL_label_init(&m_temperature_label);
-    YACSWL_label_set_text(&m_temperature_label, m_temperature_string);
+    track_label(m_temperature_label, m_temperature_string);
     YACSWL_widget_set_border_width(&m_temperature_label.widget, 0u);
     YACSWL_widget_set_pos(&m_temperature_label.widget,
                           5u,
-                          YACSWL_widget_get_pos_y(&m_pressure_label.widget) + YACSWL_widget_get_height(&m_pressure_label.widget));
+                          YACSWL_widget_get_pos_y(&m_pressure_label.widget) + YACSWL_widget_get_height(&m_pressure_label.widget) + 1u);
 
     // Add to root widget
     YACSWL_widget_add_child(&m_root_widget, &m_qnh_label.widget);
@@ -102,18 +102,13 @@ void dashboard1_screen::on_refresh(YACSGL_frame_t&)
     if (alti.is_valid)
     {
         // Altitude
-        int32_t altitude = alti.altitude / 10;
-        snprintf(m_qnh_string, sizeof(m_qnh_string), "A : %04ldm", altitude);
+        text_writer(m_qnh_string).write("A : ").write_int(alti.altitude / 10, 4u).write('m');
 
         // Pressure
-        int32_t pressure = alti.pressure / 100;
-        int32_t part     = alti.pressure - pressure * 100u;
-        snprintf(m_pressure_string, sizeof(m_pressure_string), "P : %04ld.%02ldmbar", pressure, part);
+        text_writer(m_pressure_string).write("P : ").write_fixed(alti.pressure, 2u, 4u).write("mbar");
 
         // Temperature
-        int32_t temperature = alti.temperature / 10;
-        part                = abs(alti.temperature - temperature * 10u);
-        snprintf(m_temperature_string, sizeof(m_temperature_string), "T : %02ld.%0ldC", temperature, part);
+        text_writer(m_temperature_string).write("T : ").write_fixed(alti.temperature, 1u, 2u).write('C');
     }
     else
     {
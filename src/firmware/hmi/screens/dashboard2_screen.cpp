@@ -5,9 +5,10 @@
 
 #include "dashboard2_screen.h"
 #include "ov_data.h"
+#include "text_writer.h"
+
+#include <YACSGL_font_5x7.h>
 
-#include <cmath>
-#include <cstdio>
 #include <cstring>
 
 namespace ov
@@ -39,33 +40,44 @@ void dashboard2_screen::on_init(YACSGL_frame_t&)
     strcpy(m_sink_rate_string, "SR: +00.0m/s");
     strcpy(m_glide_ratio_string, "GR: 00.0");
     strcpy(m_speed_string, "SP: 000.0km/h");
+    strcpy(m_te_string, "TE +--.- NE +--.-m/s");
 
     // Sink rate label
     YACSWL_label_init(&m_sink_rate_label);
-    YACSWL_label_set_text(&m_sink_rate_label, m_sink_rate_string);
+    track_label(m_sink_rate_label, m_sink_rate_string);
     YACSWL_widget_set_border_width(&m_sink_rate_label.widget, 0u);
     YACSWL_widget_set_pos(&m_sink_rate_label.widget, 5u, 5u);
 
     // Glide ratio label
     YACSWL_label_init(&m_glide_ratio_label);
-    YACSWL_label_set_text(&m_glide_ratio_label, m_glide_ratio_string);
+    track_label(m_glide_ratio_label, m_glide_ratio_string);
     YACSWL_widget_set_border_width(&m_glide_ratio_label.widget, 0u);
     YACSWL_widget_set_pos(&m_glide_ratio_label.widget,
                           5u,
-                          YACSWL_widget_get_pos_y(&m_sink_rate_label.widget) + YACSWL_widget_get_height(&m_sink_rate_label.widget));
+                          YACSWL_widget_get_pos_y(&m_sink_rate_label.widget) + YACSWL_widget_get_height(&m_sink_rate_label.widget) + 1u);
 
     // Speed label
     YACSWL_label_init(&m_speed_label);
-    YACSWL_label_set_text(&m_speed_label, m_speed_string);
+    track_label(m_speed_label, m_speed_string);
     YACSWL_widget_set_border_width(&m_speed_label.widget, 0u);
     YACSWL_widget_set_pos(&m_speed_label.widget,
                           5u,
-                          YACSWL_widget_get_pos_y(&m_glide_ratio_label.widget) + YACSWL_widget_get_height(&m_glide_ratio_label.widget));
+                          YACSWL_widget_get_pos_y(&m_glide_ratio_label.widget) + YACSWL_widget_get_height(&m_glide_ratio_label.widget) +
+                              1u);
+
+    // Total energy and netto sink rates label
+    YACSWL_label_init(&m_te_label);
+    track_label(m_te_label, m_te_string);
+    YACSWL_label_set_font(&m_te_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_te_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_te_label.widget, 5u, YACSWL_widget_get_pos_y(&m_speed_label.widget) + YACSWL_widget_get_height(&m_speed_label.widget) + 2u);
 
     // Add to root widget
     YACSWL_widget_add_child(&m_root_widget, &m_sink_rate_label.widget);
     YACSWL_widget_add_child(&m_root_widget, &m_glide_ratio_label.widget);
     YACSWL_widget_add_child(&m_root_widget, &m_speed_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_te_label.widget);
 }
 
 /** @brief Refresh the contents of the screen */
@@ -78,15 +90,7 @@ void dashboard2_screen::on_refresh(YACSGL_frame_t&)
     if (alti_data.is_valid)
     {
         auto sink_rate = ov::data::get_sink_rate();
-        char sign      = '+';
-        if (sink_rate < 0)
-        {
-            sign = '-';
-        }
-        sink_rate             = abs(sink_rate);
-        int16_t sink_rate_int = sink_rate / 10;
-        int16_t part          = sink_rate - sink_rate_int * 10;
-        snprintf(m_sink_rate_string, sizeof(m_sink_rate_string), "SR: %c%02d.%dm/s", sign, sink_rate_int, part);
+        text_writer(m_sink_rate_string).write("SR: ").write_fixed(sink_rate, 1u, 2u, true).write("m/s");
     }
     else
     {
@@ -100,9 +104,7 @@ void dashboard2_screen::on_refresh(YACSGL_frame_t&)
         auto glide_ratio = ov::data::get_glide_ratio();
         if (glide_ratio != ov_data::INVALID_GLIDE_RATIO_VALUE)
         {
-            uint16_t glide_ratio_int = glide_ratio / 10;
-            uint16_t part            = glide_ratio - glide_ratio_int * 10;
-            snprintf(m_glide_ratio_string, sizeof(m_glide_ratio_string), "GR: %02d.%d", glide_ratio_int, part);
+            text_writer(m_glide_ratio_string).write("GR: ").write_fixed(glide_ratio, 1u, 2u);
         }
         else
         {
@@ -111,15 +113,37 @@ void dashboard2_screen::on_refresh(YACSGL_frame_t&)
 
         // Speed => Use dam/h unit for computation to avoid precision loss
         uint32_t speed_damh = gnss.speed * 36u;
-        uint32_t speed      = speed_damh / 100u;
-        uint32_t part       = (speed_damh - speed * 100u) / 10u;
-        snprintf(m_speed_string, sizeof(m_speed_string), "SP: %03ld.%ldkm/h", speed, part);
+        text_writer(m_speed_string).write("SP: ").write_fixed(speed_damh / 10u, 1u, 3u).write("km/h");
     }
     else
     {
         strcpy(m_speed_string, "SP: ---.-km/h");
         strcpy(m_glide_ratio_string, "GR: --.-");
     }
+
+    // Total energy and netto sink rates
+    text_writer te_writer(m_te_string);
+    auto        te_sink_rate = ov::data::get_te_sink_rate();
+    te_writer.write("TE ");
+    if (te_sink_rate != ov_data::INVALID_SINK_RATE_VALUE)
+    {
+        te_writer.write_fixed(te_sink_rate, 1u, 2u, true);
+    }
+    else
+    {
+        te_writer.write("+--.-");
+    }
+    auto netto_sink_rate = ov::data::get_netto_sink_rate();
+    te_writer.write(" NE ");
+    if (netto_sink_rate != ov_data::INVALID_SINK_RATE_VALUE)
+    {
+        te_writer.write_fixed(netto_sink_rate, 1u, 2u, true);
+    }
+    else
+    {
+        te_writer.write("+--.-");
+    }
+    te_writer.write("m/s");
 }
 
 } // namespace ov
@@ -28,12 +28,16 @@ class dashboard2_screen : public base_screen
     YACSWL_label_t m_glide_ratio_label;
     /** @brief Speed label */
     YACSWL_label_t m_speed_label;
+    /** @brief Total energy and netto sink rates label */
+    YACSWL_label_t m_te_label;
     /** @brief Glide ratio string */
     char m_glide_ratio_string[10u];
     /** @brief Speed string */
     char m_speed_string[16u];
     /** @brief Sink rate string */
     char m_sink_rate_string[14u];
+    /** @brief Total energy and netto sink rates string */
+    char m_te_string[24u];
 
     /** @brief Initialize the screen */
     void on_init(YACSGL_frame_t& frame) override;
@@ -5,8 +5,8 @@
 
 #include "dashboard3_screen.h"
 #include "ov_data.h"
+#include "text_writer.h"
 
-#include <cstdio>
 #include <cstring>
 
 namespace ov
@@ -41,23 +41,23 @@ void dashboard3_screen::on_init(YACSGL_frame_t&)
 
     // Latitude label
     YACSWL_label_init(&m_lat_label);
-    YACSWL_label_set_text(&m_lat_label, m_lat_string);
+    track_label(m_lat_label, m_lat_string);
     YACSWL_widget_set_border_width(&m_lat_label.widget, 0u);
     YACSWL_widget_set_pos(&m_lat_label.widget, 5u, 5u);
 
     // Longitude label
     YACSWL_label_init(&m_lon_label);
-    YACSWL_label_set_text(&m_lon_label, m_lon_string);
+    track_label(m_lon_label, m_lon_string);
     YACSWL_widget_set_border_width(&m_lon_label.widget, 0u);
     YACSWL_widget_set_pos(
-        &m_lon_label.widget, 5u, YACSWL_widget_get_pos_y(&m_lat_label.widget) + YACSWL_widget_get_height(&m_lat_label.widget));
+        &m_lon_label.widget, 5u, YACSWL_widget_get_pos_y(&m_lat_label.widget) + YACSWL_widget_get_height(&m_lat_label.widget) + 1u);
 
     // Track angle label
     YACSWL_label_init(&m_track_angle_label);
-    YACSWL_label_set_text(&m_track_angle_label, m_track_angle_string);
+    track_label(m_track_angle_label, m_track_angle_string);
     YACSWL_widget_set_border_width(&m_track_angle_label.widget, 0u);
     YACSWL_widget_set_pos(
-        &m_track_angle_label.widget, 5u, YACSWL_widget_get_pos_y(&m_lon_label.widget) + YACSWL_widget_get_height(&m_lon_label.widget));
+        &m_track_angle_label.widget, 5u, YACSWL_widget_get_pos_y(&m_lon_label.widget) + YACSWL_widget_get_height(&m_lon_label.widget) + 1u);
 
     // Add to root widget
     YACSWL_widget_add_child(&m_root_widget, &m_lat_label.widget);
@@ -88,7 +88,8 @@ void dashboard3_screen::on_refresh(YACSGL_frame_t&)
             gnss.latitude *= -1.;
         }
         i_gnss::to_dms(gnss.latitude, deg, min, sec);
-        snprintf(m_lat_string, sizeof(m_lat_string), "LA: %02ld.%02ld'%02ld''%c", deg, min, sec, ref);
+        text_writer lat(m_lat_string);
+        lat.write("LA: ").write_int(deg, 2u).write('.').write_int(min, 2u).write('\'').write_int(sec, 2u).write("''").write(ref);
 
         // Longitude
         if (gnss.longitude >= 0)
@@ -101,12 +102,11 @@ void dashboard3_screen::on_refresh(YACSGL_frame_t&)
             gnss.longitude *= -1.;
         }
         i_gnss::to_dms(gnss.longitude, deg, min, sec);
-        snprintf(m_lon_string, sizeof(m_lon_string), "LO: %02ld.%02ld'%02ld''%c", deg, min, sec, ref);
+        text_writer lon(m_lon_string);
+        lon.write("LO: ").write_int(deg, 2u).write('.').write_int(min, 2u).write('\'').write_int(sec, 2u).write("''").write(ref);
 
         // Track angle
-        uint16_t angle = gnss.track_angle / 10u;
-        uint16_t part  = gnss.track_angle - angle * 10u;
-        snprintf(m_track_angle_string, sizeof(m_track_angle_string), "TA: %03d.%d", angle, part);
+        text_writer(m_track_angle_string).write("TA: ").write_fixed(gnss.track_angle, 1u, 3u);
     }
     else
     {
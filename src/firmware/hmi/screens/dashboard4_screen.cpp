@@ -5,8 +5,10 @@
 
 #include "dashboard4_screen.h"
 #include "ov_data.h"
+#include "text_writer.h"
+
+#include <YACSGL_font_5x7.h>
 
-#include <cstdio>
 #include <cstring>
 
 namespace ov
@@ -22,7 +24,7 @@ void dashboard4_screen::event(button bt, button_event bt_event)
     {
         if (bt == button::next)
         {
-            switch_to_screen(hmi_screen::flight);
+            switch_to_screen(hmi_screen::airspace);
         }
         if (bt == button::previous)
         {
@@ -36,15 +38,45 @@ void dashboard4_screen::on_init(YACSGL_frame_t&)
 {
     // Default values
     strcpy(m_accel_string, "A : 0.00g");
+    strcpy(m_height_string, "H : 0000m");
+    strcpy(m_stf_string, "STF ---km/h MC -.-");
+    strcpy(m_final_glide_string, "FG ----m PS --.-m/s");
 
     // Acceleration label
     YACSWL_label_init(&m_accel_label);
-    YACSWL_label_set_text(&m_accel_label, m_accel_string);
+    track_label(m_accel_label, m_accel_string);
     YACSWL_widget_set_border_width(&m_accel_label.widget, 0u);
     YACSWL_widget_set_pos(&m_accel_label.widget, 5u, 5u);
 
+    // Height above ground label
+    YACSWL_label_init(&m_height_label);
+    track_label(m_height_label, m_height_string);
+    YACSWL_widget_set_border_width(&m_height_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_height_label.widget, 5u, YACSWL_widget_get_pos_y(&m_accel_label.widget) + YACSWL_widget_get_height(&m_accel_label.widget) + 1u);
+
+    // Speed to fly label
+    YACSWL_label_init(&m_stf_label);
+    track_label(m_stf_label, m_stf_string);
+    YACSWL_label_set_font(&m_stf_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_stf_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_stf_label.widget, 5u, YACSWL_widget_get_pos_y(&m_height_label.widget) + YACSWL_widget_get_height(&m_height_label.widget) + 2u);
+
+    // Final glide label
+    YACSWL_label_init(&m_final_glide_label);
+    track_label(m_final_glide_label, m_final_glide_string);
+    YACSWL_label_set_font(&m_final_glide_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_final_glide_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_final_glide_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_stf_label.widget) + YACSWL_widget_get_height(&m_stf_label.widget) + 1u);
+
     // Add to root widget
     YACSWL_widget_add_child(&m_root_widget, &m_accel_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_height_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_stf_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_final_glide_label.widget);
 }
 
 /** @brief Refresh the contents of the screen */
@@ -55,14 +87,58 @@ void dashboard4_screen::on_refresh(YACSGL_frame_t&)
     if (accelerometer.is_valid)
     {
         // Acceleration angle
-        uint16_t accel = accelerometer.total_accel / 1000u;
-        uint16_t part  = (accelerometer.total_accel - accel * 1000u) / 10u;
-        snprintf(m_accel_string, sizeof(m_accel_string), "A : %d.%02dg", accel, part);
+        text_writer(m_accel_string).write("A : ").write_fixed(accelerometer.total_accel / 10, 2u).write('g');
     }
     else
     {
         strcpy(m_accel_string, "A : -.--g");
     }
+    auto terrain = ov::data::get_terrain();
+    if (terrain.is_valid)
+    {
+        // Height above ground
+        text_writer(m_height_string).write("H : ").write_int(terrain.height / 10, 4u).write('m');
+    }
+    else
+    {
+        strcpy(m_height_string, "H : ----m");
+    }
+    auto polar = ov::data::get_polar();
+    if (polar.is_valid)
+    {
+        // Speed to fly and MacCready setting
+        text_writer(m_stf_string)
+            .write("STF ")
+            .write_int((polar.speed_to_fly * 36u + 50u) / 100u, 3u)
+            .write("km/h MC ")
+            .write_fixed(polar.mac_cready, 1u);
+
+        // Final glide altitude and polar sink at the current speed
+        text_writer final_glide(m_final_glide_string);
+        final_glide.write("FG ");
+        if (polar.is_final_glide_valid)
+        {
+            final_glide.write_int(polar.final_glide_altitude / 10u, 4u).write('m');
+        }
+        else
+        {
+            final_glide.write("----m");
+        }
+        final_glide.write(" PS ");
+        if (polar.is_polar_sink_valid)
+        {
+            final_glide.write_fixed(polar.polar_sink, 1u, 1u, true).write("m/s");
+        }
+        else
+        {
+            final_glide.write("--.-m/s");
+        }
+    }
+    else
+    {
+        strcpy(m_stf_string, "STF ---km/h MC -.-");
+        strcpy(m_final_glide_string, "FG ----m PS --.-m/s");
+    }
 }
 
 } // namespace ov
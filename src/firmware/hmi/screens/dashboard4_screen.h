@@ -26,6 +26,18 @@ class dashboard4_screen : public base_screen
     YACSWL_label_t m_accel_label;
     /** @brief Acceleration string */
     char m_accel_string[18u];
+    /** @brief Height above ground label */
+    YACSWL_label_t m_height_label;
+    /** @brief Height above ground string */
+    char m_height_string[18u];
+    /** @brief Speed to fly label */
+    YACSWL_label_t m_stf_label;
+    /** @brief Speed to fly string */
+    char m_stf_string[24u];
+    /** @brief Final glide label */
+    YACSWL_label_t m_final_glide_label;
+    /** @brief Final glide string */
+    char m_final_glide_string[24u];
 
     /** @brief Initialize the screen */
     void on_init(YACSGL_frame_t& frame) override;
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_history_screen.h"
+#include "flight_catalog.h"
+
+#include <YACSGL_font_5x7.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+flight_history_screen::flight_history_screen(i_hmi_manager& hmi_manager)
+    : base_screen(hmi_screen::flight_history, hmi_manager), m_selected(0u), m_revision(0u), m_reload(true)
+{
+}
+
+/** @brief Button event */
+void flight_history_screen::event(button bt, button_event bt_event)
+{
+    if (bt_event == button_event::short_push)
+    {
+        if (bt == button::next)
+        {
+            switch_to_screen(hmi_screen::gnss);
+        }
+        if (bt == button::previous)
+        {
+            switch_to_screen(hmi_screen::flight);
+        }
+        if (bt == button::select)
+        {
+            // Go to the previous flight
+            m_selected++;
+            m_reload = true;
+        }
+    }
+}
+
+/** @brief Initialize the screen */
+void flight_history_screen::on_init(YACSGL_frame_t&)
+{
+    // Default values
+    strcpy(m_title_string, "History");
+    strcpy(m_date_string, "No flight");
+    m_duration_string[0] = 0;
+    m_max_string[0]      = 0;
+    m_glider_string[0]   = 0;
+
+    // Title label
+    YACSWL_label_init(&m_title_label);
+    YACSWL_label_set_text(&m_title_label, m_title_string);
+    YACSWL_label_set_font(&m_title_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_title_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_title_label.widget, 5u, 5u);
+
+    // Date label
+    YACSWL_label_init(&m_date_label);
+    YACSWL_label_set_text(&m_date_label, m_date_string);
+    YACSWL_label_set_font(&m_date_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_date_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_date_label.widget, 5u, YACSWL_widget_get_pos_y(&m_title_label.widget) + YACSWL_widget_get_height(&m_title_label.widget) + 2u);
+
+    // Duration and distance label
+    YACSWL_label_init(&m_duration_label);
+    YACSWL_label_set_text(&m_duration_label, m_duration_string);
+    YACSWL_label_set_font(&m_duration_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_duration_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_duration_label.widget, 5u, YACSWL_widget_get_pos_y(&m_date_label.widget) + YACSWL_widget_get_height(&m_date_label.widget) + 2u);
+
+    // Maximum altitude, climb and thermal count label
+    YACSWL_label_init(&m_max_label);
+    YACSWL_label_set_text(&m_max_label, m_max_string);
+    YACSWL_label_set_font(&m_max_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_max_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_max_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_duration_label.widget) + YACSWL_widget_get_height(&m_duration_label.widget) + 2u);
+
+    // Glider label
+    YACSWL_label_init(&m_glider_label);
+    YACSWL_label_set_text(&m_glider_label, m_glider_string);
+    YACSWL_label_set_font(&m_glider_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_glider_label.widget, 0u);
+    YACSWL_widget_set_pos(
+        &m_glider_label.widget, 5u, YACSWL_widget_get_pos_y(&m_max_label.widget) + YACSWL_widget_get_height(&m_max_label.widget) + 2u);
+
+    // Add to root widget
+    YACSWL_widget_add_child(&m_root_widget, &m_title_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_date_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_duration_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_max_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_glider_label.widget);
+}
+
+/** @brief Refresh the contents of the screen */
+void flight_history_screen::on_refresh(YACSGL_frame_t&)
+{
+    // Reload the displayed flight when selected or when the catalog has been modified
+    uint32_t revision = flight_catalog::get_revision();
+    if (m_reload || (revision != m_revision))
+    {
+        flight_catalog::reader  catalog;
+        flight_catalog::summary flight;
+        size_t                  count = catalog.get_count();
+        if (m_selected >= count)
+        {
+            m_selected = 0u;
+        }
+        if (catalog.seek(count - 1u - m_selected) && catalog.read(flight))
+        {
+            // Most recent flights first
+            snprintf(m_title_string, sizeof(m_title_string), "History %d/%d", static_cast<int>(m_selected + 1u), static_cast<int>(count));
+            snprintf(m_date_string,
+                     sizeof(m_date_string),
+                     "%04d-%02d-%02d %02d:%02d",
+                     static_cast<int>(flight.start.year) + 2000,
+                     static_cast<int>(flight.start.month),
+                     static_cast<int>(flight.start.day),
+                     static_cast<int>(flight.start.hour),
+                     static_cast<int>(flight.start.minute));
+            snprintf(m_duration_string,
+                     sizeof(m_duration_string),
+                     "%02dh%02d %d.%dkm",
+                     static_cast<int>(flight.stats.airtime / 3600u),
+                     static_cast<int>((flight.stats.airtime % 3600u) / 60u),
+                     static_cast<int>(flight.stats.distance / 1000u),
+                     static_cast<int>((flight.stats.distance % 1000u) / 100u));
+            snprintf(m_max_string,
+                     sizeof(m_max_string),
+                     "%dm %d.%dm/s %dT",
+                     static_cast<int>(flight.stats.max_altitude / 10),
+                     static_cast<int>(flight.stats.max_climb / 10),
+                     static_cast<int>(abs(flight.stats.max_climb % 10)),
+                     static_cast<int>(flight.stats.thermal_count));
+            snprintf(m_glider_string, sizeof(m_glider_string), "%s", flight.glider);
+        }
+        else
+        {
+            strcpy(m_title_string, "History");
+            strcpy(m_date_string, "No flight");
+            m_duration_string[0] = 0;
+            m_max_string[0]      = 0;
+            m_glider_string[0]   = 0;
+        }
+        m_revision = revision;
+        m_reload   = false;
+    }
+}
+
+} // namespace ov
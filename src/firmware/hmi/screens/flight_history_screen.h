@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_HISTORY_SCREEN_H
+#define OV_FLIGHT_HISTORY_SCREEN_H
+
+#include "base_screen.h"
+
+#include <cstddef>
+
+namespace ov
+{
+
+/** @brief Flight history screen */
+class flight_history_screen : public base_screen
+{
+  public:
+    /** @brief Constructor */
+    flight_history_screen(i_hmi_manager& hmi_manager);
+
+    /** @brief Button event */
+    void event(button bt, button_event bt_event) override;
+
+  private:
+    /** @brief Title label */
+    YACSWL_label_t m_title_label;
+    /** @brief Date label */
+    YACSWL_label_t m_date_label;
+    /** @brief Duration and distance label */
+    YACSWL_label_t m_duration_label;
+    /** @brief Maximum altitude, climb and thermal count label */
+    YACSWL_label_t m_max_label;
+    /** @brief Glider label */
+    YACSWL_label_t m_glider_label;
+    /** @brief Title string */
+    char m_title_string[24u];
+    /** @brief Date string */
+    char m_date_string[24u];
+    /** @brief Duration and distance string */
+    char m_duration_string[24u];
+    /** @brief Maximum altitude, climb and thermal count string */
+    char m_max_string[24u];
+    /** @brief Glider string */
+    char m_glider_string[24u];
+    /** @brief Displayed flight, 0 is the most recent flight */
+    size_t m_selected;
+    /** @brief Revision of the catalog of the displayed flight */
+    uint32_t m_revision;
+    /** @brief Indicate if the displayed flight must be reloaded */
+    bool m_reload;
+
+    /** @brief Initialize the screen */
+    void on_init(YACSGL_frame_t& frame) override;
+
+    /** @brief Refresh the contents of the screen */
+    void on_refresh(YACSGL_frame_t& frame) override;
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_HISTORY_SCREEN_H
@@ -6,8 +6,9 @@
 #include "flight_screen.h"
 #include "i_flight_recorder.h"
 #include "i_hmi_manager.h"
+#include "text_writer.h"
 
-#include <cstdio>
+#include <YACSGL_font_5x7.h>
 
 namespace ov
 {
@@ -25,11 +26,11 @@ void flight_screen::event(button bt, button_event bt_event)
     {
         if (bt == button::next)
         {
-            switch_to_screen(hmi_screen::gnss);
+            switch_to_screen(hmi_screen::flight_history);
         }
         if (bt == button::previous)
         {
-            switch_to_screen(hmi_screen::dashboard4);
+            switch_to_screen(hmi_screen::navigation);
         }
         if (bt == button::select)
         {
@@ -74,10 +75,22 @@ void flight_screen::on_init(YACSGL_frame_t& frame)
                           YACSWL_widget_get_pos_y(&m_flight_status_label.widget) + YACSWL_widget_get_height(&m_flight_status_label.widget));
     YACSWL_widget_set_margins(&m_flight_start_label.widget, 0u, 0u, 0u, 0u);
 
+    // Flight statistics labels
+    for (size_t i = 0; i < 2u; i++)
+    {
+        m_flight_stats_strings[i][0] = 0;
+        YACSWL_label_init(&m_flight_stats_labels[i]);
+        YACSWL_label_set_text(&m_flight_stats_labels[i], m_flight_stats_strings[i]);
+        YACSWL_label_set_font(&m_flight_stats_labels[i], &YACSGL_font_5x7);
+        YACSWL_widget_set_border_width(&m_flight_stats_labels[i].widget, 0u);
+    }
+
     // Add to root widget
     YACSWL_widget_add_child(&m_root_widget, &m_flight_label.widget);
     YACSWL_widget_add_child(&m_root_widget, &m_flight_status_label.widget);
     YACSWL_widget_add_child(&m_root_widget, &m_flight_start_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_flight_stats_labels[0u].widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_flight_stats_labels[1u].widget);
 }
 
 /** @brief Refresh the contents of the screen */
@@ -107,10 +120,20 @@ void flight_screen::on_refresh(YACSGL_frame_t& frame)
             uint32_t duration_h = duration / 3600u;
             uint32_t duration_m = (duration - (duration_h * 3600u)) / 60u;
             uint32_t duration_s = (duration - (duration_h * 3600u) - (duration_m * 60u));
-            snprintf(m_flight_status_string, sizeof(m_flight_status_string), "%02ldh %02ldmin %02lds", duration_h, duration_m, duration_s);
+            text_writer status(m_flight_status_string);
+            status.write_int(duration_h, 2u).write("h ").write_int(duration_m, 2u).write("min ").write_int(duration_s, 2u).write('s');
 
             YACSWL_label_set_text(&m_flight_status_label, m_flight_status_string);
             YACSWL_label_set_text(&m_flight_start_label, "flying!");
+
+            // Live flight statistics
+            auto stats = m_recorder.get_stats();
+            text_writer distance_line(m_flight_stats_strings[0u]);
+            distance_line.write_fixed(stats.distance / 100u, 1u).write("km ").write_int(stats.max_altitude / 10).write("m ");
+            distance_line.write_int(stats.thermal_count).write('T');
+            text_writer climb_line(m_flight_stats_strings[1u]);
+            climb_line.write_fixed(stats.max_climb, 1u).write('/').write_fixed(stats.max_sink, 1u).write("m/s ");
+            climb_line.write_int((stats.max_speed * 36u) / 100u).write("km/h");
         }
         break;
 
@@ -135,6 +158,12 @@ void flight_screen::on_refresh(YACSGL_frame_t& frame)
             break;
     }
 
+    if (m_recorder.get_status() != i_flight_recorder::status::started)
+    {
+        m_flight_stats_strings[0u][0u] = 0;
+        m_flight_stats_strings[1u][0u] = 0;
+    }
+
     // Update widgets position
     YACSWL_widget_set_pos(&m_flight_status_label.widget,
                           (frame.frame_x_width - YACSWL_widget_get_width(&m_flight_status_label.widget)) / 2u,
@@ -142,6 +171,12 @@ void flight_screen::on_refresh(YACSGL_frame_t& frame)
     YACSWL_widget_set_pos(&m_flight_start_label.widget,
                           (frame.frame_x_width - YACSWL_widget_get_width(&m_flight_start_label.widget)) / 2u,
                           YACSWL_widget_get_pos_y(&m_flight_status_label.widget) + YACSWL_widget_get_height(&m_flight_status_label.widget));
+    uint16_t y = 2u + YACSWL_widget_get_pos_y(&m_flight_start_label.widget) + YACSWL_widget_get_height(&m_flight_start_label.widget);
+    for (auto& stats_label : m_flight_stats_labels)
+    {
+        YACSWL_widget_set_pos(&stats_label.widget, (frame.frame_x_width - YACSWL_widget_get_width(&stats_label.widget)) / 2u, y);
+        y += YACSWL_widget_get_height(&stats_label.widget);
+    }
 }
 
 } // namespace ov
@@ -33,8 +33,12 @@ class flight_screen : public base_screen
     YACSWL_label_t m_flight_status_label;
     /** @brief Flight start label */
     YACSWL_label_t m_flight_start_label;
+    /** @brief Flight statistics labels */
+    YACSWL_label_t m_flight_stats_labels[2u];
     /** @brief Status label string */
     char m_flight_status_string[18u];
+    /** @brief Flight statistics strings */
+    char m_flight_stats_strings[2u][24u];
     /** @brief Flight start string 1 */
     static constexpr const char* m_flight_start_string1 = "Press SELECT";
     /** @brief Flight start string 2 */
@@ -5,10 +5,10 @@
 
 #include "gnss_screen.h"
 #include "ov_data.h"
+#include "text_writer.h"
 
 #include <YACSGL_font_5x7.h>
 
-#include <cstdio>
 #include <cstring>
 
 namespace ov
@@ -28,7 +28,7 @@ void gnss_screen::event(button bt, button_event bt_event)
         }
         if (bt == button::previous)
         {
-            switch_to_screen(hmi_screen::flight);
+            switch_to_screen(hmi_screen::flight_history);
         }
     }
 }
@@ -82,19 +82,14 @@ void gnss_screen::on_refresh(YACSGL_frame_t& frame)
         }
         else
         {
-            snprintf(m_signal_status_string, sizeof(m_signal_status_string), "%02d sat(s)", static_cast<int>(gnss.satellite_count));
+            text_writer(m_signal_status_string).write_int(gnss.satellite_count, 2u).write(" sat(s)");
             YACSWL_label_set_text(&m_signal_status_label, m_signal_status_string);
         }
 
-        snprintf(m_date_time_string,
-                 sizeof(m_date_time_string),
-                 "%04d-%02d-%02dT%02d:%02d:%02dZ",
-                 static_cast<int>(gnss.date.year) + 2000,
-                 static_cast<int>(gnss.date.month),
-                 static_cast<int>(gnss.date.day),
-                 static_cast<int>(gnss.date.hour),
-                 static_cast<int>(gnss.date.minute),
-                 static_cast<int>(gnss.date.second));
+        text_writer date_time(m_date_time_string);
+        date_time.write_int(gnss.date.year + 2000, 4u).write('-').write_int(gnss.date.month, 2u).write('-').write_int(gnss.date.day, 2u);
+        date_time.write('T').write_int(gnss.date.hour, 2u).write(':').write_int(gnss.date.minute, 2u);
+        date_time.write(':').write_int(gnss.date.second, 2u).write('Z');
         YACSWL_widget_set_displayed(&m_date_time_label.widget, true);
     }
     else
@@ -9,6 +9,7 @@
 #include "hmi.h"
 
 #include <YACSGL.h>
+#include <cstdint>
 
 namespace ov
 {
@@ -29,8 +30,11 @@ class i_hmi_screen
     /** @brief Button event */
     virtual void event(button bt, button_event bt_event) = 0;
 
-    /** @brief Refresh the contents of the screen */
-    virtual void refresh(YACSGL_frame_t& frame) = 0;
+    /** @brief Refresh the contents of the screen and get the pages of the frame which have been modified (bit n = page n) */
+    virtual uint32_t refresh(YACSGL_frame_t& frame) = 0;
+
+    /** @brief Force a full redraw of the screen at the next refresh */
+    virtual void invalidate() = 0;
 
     /** @brief Set the night mode */
     virtual void set_night_mode(bool is_on) = 0;
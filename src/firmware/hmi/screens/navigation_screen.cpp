@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "navigation_screen.h"
+#include "ov_data.h"
+#include "text_writer.h"
+
+#include <YACSGL_font_5x7.h>
+
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+navigation_screen::navigation_screen(i_hmi_manager& hmi_manager) : base_screen(hmi_screen::navigation, hmi_manager) { }
+
+/** @brief Button event */
+void navigation_screen::event(button bt, button_event bt_event)
+{
+    if (bt_event == button_event::short_push)
+    {
+        if (bt == button::next)
+        {
+            switch_to_screen(hmi_screen::flight);
+        }
+        if (bt == button::previous)
+        {
+            switch_to_screen(hmi_screen::airspace);
+        }
+    }
+}
+
+/** @brief Initialize the screen */
+void navigation_screen::on_init(YACSGL_frame_t&)
+{
+    // Default values
+    strcpy(m_turnpoint_string, "No task");
+    strcpy(m_distance_string, "TP : ---.-km");
+    strcpy(m_goal_string, "GO : ---.-km");
+    strcpy(m_glide_ratio_string, "RG : --.-");
+
+    // Turnpoint label
+    YACSWL_label_init(&m_turnpoint_label);
+    track_label(m_turnpoint_label, m_turnpoint_string);
+    YACSWL_label_set_font(&m_turnpoint_label, &YACSGL_font_5x7);
+    YACSWL_widget_set_border_width(&m_turnpoint_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_turnpoint_label.widget, 5u, 5u);
+
+    // Turnpoint distance label
+    YACSWL_label_init(&m_distance_label);
+    track_label(m_distance_label, m_distance_string);
+    YACSWL_widget_set_border_width(&m_distance_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_distance_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_turnpoint_label.widget) + YACSWL_widget_get_height(&m_turnpoint_label.widget) + 2u);
+
+    // Goal distance label
+    YACSWL_label_init(&m_goal_label);
+    track_label(m_goal_label, m_goal_string);
+    YACSWL_widget_set_border_width(&m_goal_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_goal_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_distance_label.widget) + YACSWL_widget_get_height(&m_distance_label.widget) + 1u);
+
+    // Required glide ratio label
+    YACSWL_label_init(&m_glide_ratio_label);
+    track_label(m_glide_ratio_label, m_glide_ratio_string);
+    YACSWL_widget_set_border_width(&m_glide_ratio_label.widget, 0u);
+    YACSWL_widget_set_pos(&m_glide_ratio_label.widget,
+                          5u,
+                          YACSWL_widget_get_pos_y(&m_goal_label.widget) + YACSWL_widget_get_height(&m_goal_label.widget) + 1u);
+
+    // Add to root widget
+    YACSWL_widget_add_child(&m_root_widget, &m_turnpoint_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_distance_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_goal_label.widget);
+    YACSWL_widget_add_child(&m_root_widget, &m_glide_ratio_label.widget);
+}
+
+/** @brief Refresh the contents of the screen */
+void navigation_screen::on_refresh(YACSGL_frame_t&)
+{
+    // Update strings
+    auto navigation = ov::data::get_navigation();
+    if (!navigation.is_valid)
+    {
+        strcpy(m_turnpoint_string, "No task");
+        strcpy(m_distance_string, "TP : ---.-km");
+        strcpy(m_goal_string, "GO : ---.-km");
+        strcpy(m_glide_ratio_string, "RG : --.-");
+    }
+    else if (navigation.goal_reached)
+    {
+        strcpy(m_turnpoint_string, "Goal reached!");
+        strcpy(m_distance_string, "TP : 000.0km");
+        strcpy(m_goal_string, "GO : 000.0km");
+        strcpy(m_glide_ratio_string, "RG : --.-");
+    }
+    else
+    {
+        // Active turnpoint and bearing
+        text_writer turnpoint(m_turnpoint_string);
+        turnpoint.write_int(navigation.turnpoint_index + 1u).write('/').write_int(navigation.turnpoint_count).write(' ');
+        turnpoint.write(navigation.turnpoint).write(' ').write_int(navigation.bearing / 10u, 3u);
+
+        // Distances
+        text_writer(m_distance_string).write("TP : ").write_fixed(navigation.turnpoint_distance / 100u, 1u, 3u).write("km");
+        text_writer(m_goal_string).write("GO : ").write_fixed(navigation.goal_distance / 100u, 1u, 3u).write("km");
+
+        // Required glide ratio
+        if (navigation.required_glide_ratio != ov_data::INVALID_GLIDE_RATIO_VALUE)
+        {
+            text_writer(m_glide_ratio_string).write("RG : ").write_fixed(navigation.required_glide_ratio, 1u, 2u);
+        }
+        else
+        {
+            strcpy(m_glide_ratio_string, "RG : --.-");
+        }
+    }
+}
+
+} // namespace ov
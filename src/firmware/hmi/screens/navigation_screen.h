@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_NAVIGATION_SCREEN_H
+#define OV_NAVIGATION_SCREEN_H
+
+#include "base_screen.h"
+
+namespace ov
+{
+
+/** @brief Task navigation screen */
+class navigation_screen : public base_screen
+{
+  public:
+    /** @brief Constructor */
+    navigation_screen(i_hmi_manager& hmi_manager);
+
+    /** @brief Button event */
+    void event(button bt, button_event bt_event) override;
+
+  private:
+    /** @brief Turnpoint label */
+    YACSWL_label_t m_turnpoint_label;
+    /** @brief Turnpoint distance label */
+    YACSWL_label_t m_distance_label;
+    /** @brief Goal distance label */
+    YACSWL_label_t m_goal_label;
+    /** @brief Required glide ratio label */
+    YACSWL_label_t m_glide_ratio_label;
+    /** @brief Turnpoint string */
+    char m_turnpoint_string[24u];
+    /** @brief Turnpoint distance string */
+    char m_distance_string[24u];
+    /** @brief Goal distance string */
+    char m_goal_string[24u];
+    /** @brief Required glide ratio string */
+    char m_glide_ratio_string[24u];
+
+    /** @brief Initialize the screen */
+    void on_init(YACSGL_frame_t& frame) override;
+
+    /** @brief Refresh the contents of the screen */
+    void on_refresh(YACSGL_frame_t& frame) override;
+};
+
+} // namespace ov
+
+#endif // OV_NAVIGATION_SCREEN_H
@@ -28,7 +28,9 @@ void settings_display_screen::event(button bt, button_event bt_event)
         }
         if (bt == button::select)
         {
-            ov::config::get().is_night_mode_on = !ov::config::get().is_night_mode_on;
+            ov::config::transaction tr;
+            tr.values().is_night_mode_on = !tr.values().is_night_mode_on;
+            tr.commit(false);
         }
     }
 }
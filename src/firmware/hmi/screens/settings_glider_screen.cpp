@@ -28,7 +28,8 @@ void settings_glider_screen::event(button bt, button_event bt_event)
         }
         if (bt == button::select)
         {
-            auto& config = ov::config::get();
+            ov::config::transaction tr;
+            auto&                   config = tr.values();
             if (config.glider == 4u)
             {
                 config.glider = 1u;
@@ -37,6 +38,7 @@ void settings_glider_screen::event(button bt, button_event bt_event)
             {
                 config.glider++;
             }
+            tr.commit(false);
         }
     }
 }
@@ -66,8 +68,8 @@ void settings_glider_screen::on_init(YACSGL_frame_t& frame)
 /** @brief Refresh the contents of the screen */
 void settings_glider_screen::on_refresh(YACSGL_frame_t& frame)
 {
-    auto&       config      = ov::config::get();
-    const char* glider_name = nullptr;
+    const ov_config config      = ov::config::get();
+    const char*     glider_name = nullptr;
     switch (config.glider)
     {
         default:
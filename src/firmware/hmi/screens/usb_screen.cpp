@@ -83,7 +83,7 @@ void usb_screen::on_refresh(YACSGL_frame_t& frame)
         }
         else
         {
-            YACSWL_label_set_text(&m_mode_label, m_ovtoolbox_string);
+            YACSWL_label_set_text(&m_mode_label, m_xctrack_off_string);
         }
         YACSWL_widget_set_displayed(&m_mode_label.widget, true);
     }
@@ -39,8 +39,8 @@ class usb_screen : public base_screen
     static constexpr const char* m_not_connected_string = "Not connected";
     /** @brief XCTrack string */
     static constexpr const char* m_xctrack_string = "XCTrack";
-    /** @brief OV ToolBox string */
-    static constexpr const char* m_ovtoolbox_string = "OV ToolBox";
+    /** @brief XCTrack disabled string */
+    static constexpr const char* m_xctrack_off_string = "XCTrack off";
 
     /** @brief Initialize the screen */
     void on_init(YACSGL_frame_t& frame) override;
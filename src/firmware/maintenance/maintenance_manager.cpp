@@ -4,11 +4,17 @@
  */
 
 #include "maintenance_manager.h"
+#include "airspace_db.h"
+#include "flight_catalog.h"
 #include "flight_file.h"
 #include "fs.h"
+#include "i_airspace_manager.h"
 #include "i_flight_recorder.h"
+#include "i_sensor_stream.h"
+#include "i_terrain_manager.h"
 #include "os.h"
 #include "ov_config.h"
+#include "terrain_tile.h"
 
 #include <cstdio>
 #include <cstring>
@@ -17,7 +23,13 @@ namespace ov
 {
 
 /** @brief Constructor */
-maintenance_manager::maintenance_manager(i_serial& serial_port) : m_protocol(serial_port), m_thread() { }
+maintenance_manager::maintenance_manager(i_serial&          serial_port,
+                                         i_airspace_manager& airspaces,
+                                         i_terrain_manager&  terrain,
+                                         i_sensor_stream&    stream)
+    : m_protocol(serial_port), m_airspaces(airspaces), m_terrain(terrain), m_stream(stream), m_thread()
+{
+}
 
 /** @brief Initialize the maintenance */
 bool maintenance_manager::init()
@@ -54,6 +66,22 @@ void maintenance_manager::thread_func(void*)
                 send_response = handle_read_flight_req(request);
                 break;
 
+            case ov_request_id::upload_airspaces:
+                send_response = handle_upload_airspaces_req(request);
+                break;
+
+            case ov_request_id::upload_terrain:
+                send_response = handle_upload_terrain_req(request);
+                break;
+
+            case ov_request_id::stream_start:
+                send_response = handle_stream_start_req(request);
+                break;
+
+            case ov_request_id::stream_stop:
+                send_response = handle_stream_stop_req(request);
+                break;
+
             default:
                 // Timeout
                 break;
@@ -97,6 +125,14 @@ void maintenance_manager::write(ov_request& request, const void* data, size_t si
 /** @brief Handle the device infos request */
 bool maintenance_manager::handle_device_infos_req(ov_request& request)
 {
+    // Negotiate the protocol version, legacy tools send the request without payload
+    uint8_t version = maintenance_protocol::PROTOCOL_V1;
+    if (request.size != 0)
+    {
+        version = std::min(request.payload[0], maintenance_protocol::PROTOCOL_V2);
+        version = std::max(version, maintenance_protocol::PROTOCOL_V1);
+    }
+
     // Prepare response
     request.size = 0;
     memset(request.payload, 0, sizeof(request.payload));
@@ -104,8 +140,13 @@ bool maintenance_manager::handle_device_infos_req(ov_request& request)
     write(request, ov::config::get().device_name);
     write(request, "stm32wb5mm-dk");
     write(request, OPENVARIO_MAJOR "." OPENVARIO_MINOR "." OPENVARIO_FIX);
+    write(request, version);
 
-    return true;
+    // The response is sent with the current version, the negotiated one applies to the next frames
+    m_protocol.send_response(request);
+    maintenance_protocol::set_version(version);
+
+    return false;
 }
 
 /** @brief Handle the list flights request */
@@ -115,39 +156,53 @@ bool maintenance_manager::handle_list_flights_req(ov_request& request)
     request.size = 0;
     memset(request.payload, 0, sizeof(request.payload));
 
-    // Open the flights directory
-    dir flight_dir = ov::fs::open_dir(i_flight_recorder::RECORDED_DATA_DIR);
-    if (flight_dir.is_open())
+    // Open the flight catalog
+    flight_catalog::reader catalog;
+    if (catalog.is_open())
     {
-        // Send first response
+        // Send first response with the number of flights
         write(request, true);
+        write(request, static_cast<uint16_t>(catalog.get_count()));
         m_protocol.send_response(request);
 
-        // List files
-        dir::entry entry;
-        bool       entry_found = true;
-        while (entry_found && (m_protocol.wait_for_request(1000u).id == ov_request_id::list_flights_data))
+        // Send the flight summaries in packets
+        bool summaries_found = true;
+        while (summaries_found && (m_protocol.wait_for_request(1000u).id == ov_request_id::list_flights_data))
         {
-            // Go to next valid entry
-            entry_found = false;
-            while (!entry_found && flight_dir.read(entry))
+            // Prepare response
+            request.size = 0;
+            memset(request.payload, 0, sizeof(request.payload));
+
+            // Read a packet of summaries
+            int                     count = 0;
+            flight_catalog::summary flight;
+            while ((count < static_cast<int>(ov_request::MAX_PAYLOAD_SIZE / sizeof(flight))) && catalog.read(flight))
             {
-                if (entry.type == dir::entry_type::file)
+                // Write summary
+                if (count == 0)
                 {
-                    size_t filename_len = strlen(entry.name);
-                    if ((filename_len > 4u) && (strcmp(&entry.name[filename_len - 4u], i_flight_recorder::RECORDED_DATA_EXT) == 0))
-                    {
-                        // Send response
-                        request.size = 0;
-                        memset(request.payload, 0, sizeof(request.payload));
-                        write(request, true);
-                        write(request, entry.name);
-                        write(request, entry.size);
-                        m_protocol.send_response(request);
-
-                        entry_found = true;
-                    }
+                    write(request, true);
                 }
+                write(request, flight.name);
+                write(request, flight.size);
+                write(request, flight.start);
+                write(request, flight.stats.airtime);
+                write(request, flight.stats.distance);
+                write(request, flight.stats.max_speed);
+                write(request, flight.stats.max_altitude);
+                write(request, flight.stats.min_altitude);
+                write(request, flight.stats.max_climb);
+                write(request, flight.stats.max_sink);
+                write(request, flight.stats.thermal_count);
+                write(request, flight.glider);
+
+                count++;
+            }
+            summaries_found = (count != 0);
+            if (summaries_found)
+            {
+                // Send response
+                m_protocol.send_response(request);
             }
         }
 
@@ -243,4 +298,142 @@ bool maintenance_manager::handle_read_flight_req(ov_request& request)
     return true;
 }
 
+/** @brief Handle the upload airspaces request */
+bool maintenance_manager::handle_upload_airspaces_req(ov_request& request)
+{
+    // Size of the OpenAir file
+    uint32_t size = 0u;
+    bool     ret  = (request.size == sizeof(size));
+    if (ret)
+    {
+        memcpy(&size, request.payload, sizeof(size));
+    }
+
+    // Create the file to import
+    file openair = ov::fs::open(airspace_db::OPENAIR_FILE, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    ret          = ret && openair.is_open();
+    request.size = 0;
+    memset(request.payload, 0, sizeof(request.payload));
+    write(request, ret);
+    if (ret)
+    {
+        // Send first response
+        m_protocol.send_response(request);
+
+        // Receive file contents and start import
+        ret = receive_file(request, openair, size, ov_request_id::upload_airspaces_data);
+        ret = ret && m_airspaces.import(airspace_db::OPENAIR_FILE);
+
+        // Last response indicates if the import has been started
+        request.size = 0;
+        memset(request.payload, 0, sizeof(request.payload));
+        write(request, ret);
+    }
+
+    return true;
+}
+
+/** @brief Handle the upload terrain request */
+bool maintenance_manager::handle_upload_terrain_req(ov_request& request)
+{
+    // Size of the tile file and south west corner of the tile
+    uint32_t size      = 0u;
+    int16_t  latitude  = 0;
+    int16_t  longitude = 0;
+    bool     ret       = (request.size == (sizeof(size) + sizeof(latitude) + sizeof(longitude)));
+    if (ret)
+    {
+        memcpy(&size, &request.payload[0u], sizeof(size));
+        memcpy(&latitude, &request.payload[sizeof(size)], sizeof(latitude));
+        memcpy(&longitude, &request.payload[sizeof(size) + sizeof(latitude)], sizeof(longitude));
+        ret = (latitude >= -90) && (latitude < 90) && (longitude >= -180) && (longitude < 180);
+    }
+
+    // Create the tile file
+    char path[terrain_tile::MAX_PATH_SIZE];
+    terrain_tile::get_path(latitude, longitude, path);
+    file tile    = ov::fs::open(path, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    ret          = ret && tile.is_open();
+    request.size = 0;
+    memset(request.payload, 0, sizeof(request.payload));
+    write(request, ret);
+    if (ret)
+    {
+        // Send first response
+        m_protocol.send_response(request);
+
+        // Receive file contents and drop the cached blocks of the previous version of the tile
+        ret = receive_file(request, tile, size, ov_request_id::upload_terrain_data);
+        m_terrain.reload();
+
+        // Last response indicates if the tile has been stored
+        request.size = 0;
+        memset(request.payload, 0, sizeof(request.payload));
+        write(request, ret);
+    }
+
+    return true;
+}
+
+/** @brief Handle the stream start request */
+bool maintenance_manager::handle_stream_start_req(ov_request& request)
+{
+    // Start streaming, the records are sent in stream data frames
+    bool ret     = m_stream.start();
+    request.size = 0;
+    memset(request.payload, 0, sizeof(request.payload));
+    write(request, ret);
+
+    return true;
+}
+
+/** @brief Handle the stream stop request */
+bool maintenance_manager::handle_stream_stop_req(ov_request& request)
+{
+    // Stop streaming and report the statistics
+    bool ret     = m_stream.stop();
+    auto stats   = m_stream.get_stats();
+    request.size = 0;
+    memset(request.payload, 0, sizeof(request.payload));
+    write(request, ret);
+    write(request, stats.records);
+    write(request, stats.dropped);
+    write(request, stats.frames);
+
+    return true;
+}
+
+/** @brief Receive the contents of an uploaded file, the first response must have been sent */
+bool maintenance_manager::receive_file(ov_request& request, file& f, uint32_t size, ov_request_id data_id)
+{
+    bool ret = true;
+
+    // Receive file contents
+    uint32_t received = 0u;
+    while (ret && (received < size))
+    {
+        ov_request& data_request = m_protocol.wait_for_request(1000u);
+        ret                      = (data_request.id == data_id);
+        ret                      = ret && ((received + data_request.size) <= size);
+        if (ret)
+        {
+            size_t write_count = 0u;
+            ret                = f.write(data_request.payload, data_request.size, write_count);
+            ret                = ret && (write_count == data_request.size);
+            received += data_request.size;
+        }
+        if (ret && (received < size))
+        {
+            // Acknowledge data
+            request.size = 0;
+            memset(request.payload, 0, sizeof(request.payload));
+            write(request, true);
+            m_protocol.send_response(request);
+        }
+    }
+    ret = f.close() && ret;
+
+    return ret;
+}
+
 } // namespace ov
@@ -14,15 +14,19 @@
 namespace ov
 {
 
-// Forward declaration
+// Forward declarations
 struct date_time;
+class i_airspace_manager;
+class i_sensor_stream;
+class i_terrain_manager;
+class file;
 
 /** @brief Handle the maintenance link */
 class maintenance_manager
 {
   public:
     /** @brief Constructor */
-    maintenance_manager(i_serial& serial_port);
+    maintenance_manager(i_serial& serial_port, i_airspace_manager& airspaces, i_terrain_manager& terrain, i_sensor_stream& stream);
 
     /** @brief Initialize the maintenance */
     bool init();
@@ -30,6 +34,12 @@ class maintenance_manager
   protected:
     /** @brief Maintenance protocol */
     maintenance_protocol m_protocol;
+    /** @brief Airspace manager */
+    i_airspace_manager& m_airspaces;
+    /** @brief Terrain manager */
+    i_terrain_manager& m_terrain;
+    /** @brief Sensor stream */
+    i_sensor_stream& m_stream;
     /** @brief Maintenance thread */
     thread<2048u> m_thread;
 
@@ -55,6 +65,16 @@ class maintenance_manager
     bool handle_list_flights_req(ov_request& request);
     /** @brief Handle the read flight request */
     bool handle_read_flight_req(ov_request& request);
+    /** @brief Handle the upload airspaces request */
+    bool handle_upload_airspaces_req(ov_request& request);
+    /** @brief Handle the upload terrain request */
+    bool handle_upload_terrain_req(ov_request& request);
+    /** @brief Handle the stream start request */
+    bool handle_stream_start_req(ov_request& request);
+    /** @brief Handle the stream stop request */
+    bool handle_stream_stop_req(ov_request& request);
+    /** @brief Receive the contents of an uploaded file, the first response must have been sent */
+    bool receive_file(ov_request& request, file& f, uint32_t size, ov_request_id data_id);
 };
 
 } // namespace ov
@@ -4,7 +4,10 @@
  */
 
 #include "maintenance_protocol.h"
+#include "crc16.h"
 #include "i_serial.h"
+#include "lock_guard.h"
+#include "mutex.h"
 #include "os.h"
 
 #include <cstring>
@@ -12,6 +15,11 @@
 namespace ov
 {
 
+/** @brief Mutex to send complete frames */
+static mutex s_tx_mutex;
+/** @brief Protocol version used on the maintenance link */
+static volatile uint8_t s_version = maintenance_protocol::PROTOCOL_V1;
+
 /** @brief Constructor */
 maintenance_protocol::maintenance_protocol(i_serial& serial_port) : m_serial_port(serial_port), m_request{} { }
 
@@ -23,7 +31,6 @@ ov_request& maintenance_protocol::wait_for_request(uint32_t timeout)
     rx_state             state            = rx_state::wait_sof1;
     uint16_t             bytes_count      = 0;
     uint16_t             crc              = 0;
-    uint32_t             expected_crc     = 0;
     bool                 reset_state      = true;
     uint8_t              byte             = 0;
     uint32_t             start_rx         = os::now();
@@ -35,22 +42,12 @@ ov_request& maintenance_protocol::wait_for_request(uint32_t timeout)
         // Reset state if needed
         if (reset_state)
         {
-            state        = rx_state::wait_sof1;
-            bytes_count  = 0;
-            crc          = 0;
-            expected_crc = 0;
+            state       = rx_state::wait_sof1;
+            bytes_count = 0;
+            crc         = 0;
             memset(&m_request, 0, sizeof(m_request));
             reset_state = false;
         }
-        else
-        {
-            // Update CRC
-            if (state <= rx_state::wait_crc1)
-            {
-                expected_crc += byte;
-                expected_crc = expected_crc << 1;
-            }
-        }
 
         // Wait for an incoming byte
         if (m_serial_port.read(&byte, sizeof(byte), INTER_BYTES_TIMEOUT_MS))
@@ -82,7 +79,7 @@ ov_request& maintenance_protocol::wait_for_request(uint32_t timeout)
                 // Wait id
                 case rx_state::wait_id:
                 {
-                    if ((byte > static_cast<uint8_t>(ov_request_id::min)) && (byte > static_cast<uint8_t>(ov_request_id::min)))
+                    if ((byte > static_cast<uint8_t>(ov_request_id::min)) && (byte < static_cast<uint8_t>(ov_request_id::max)))
                     {
                         m_request.id = static_cast<ov_request_id>(byte);
                         state        = rx_state::wait_len1;
@@ -142,7 +139,7 @@ ov_request& maintenance_protocol::wait_for_request(uint32_t timeout)
                 case rx_state::wait_crc2:
                 {
                     crc += (byte << 8);
-                    if (crc == static_cast<uint16_t>(expected_crc & 0x0000FFFFu))
+                    if (check_crc(crc))
                     {
                         req_received = true;
                     }
@@ -180,45 +177,111 @@ ov_request& maintenance_protocol::wait_for_request(uint32_t timeout)
 /** @brief Send a response */
 void maintenance_protocol::send_response(const ov_request& request)
 {
-    uint32_t crc = 0;
+    send_frame(m_serial_port, request.id, request.payload, request.size);
+}
 
-    // Send start of frame
-    bool ret = send_and_update_crc(&START_OF_FRAME, sizeof(START_OF_FRAME), crc);
+/** @brief Send a frame, frames sent from different threads on the same link are not interleaved */
+bool maintenance_protocol::send_frame(i_serial& serial_port, ov_request_id id, const void* payload, uint16_t size)
+{
+    lock_guard<mutex> lock(s_tx_mutex);
 
-    // Send id and size
-    ret = ret && send_and_update_crc(&request.id, sizeof(request.id), crc);
-    ret = ret && send_and_update_crc(&request.size, sizeof(request.size), crc);
+    // Build the header and the CRC, the payload is sent in place
+    uint8_t header[HEADER_SIZE];
+    make_header(header, id, size);
+    uint16_t crc = compute_crc(s_version, header, payload, size);
 
-    // Send payload
-    if (request.size != 0)
+    // Queue the whole frame in a single scatter-gather write
+    bool ret = false;
+    if (size != 0)
+    {
+        const i_serial::segment segments[] = {{header, sizeof(header)}, {payload, size}, {&crc, sizeof(crc)}};
+        ret                                = serial_port.write(segments);
+    }
+    else
     {
-        ret = ret && send_and_update_crc(request.payload, request.size, crc);
+        const i_serial::segment segments[] = {{header, sizeof(header)}, {&crc, sizeof(crc)}};
+        ret                                = serial_port.write(segments);
     }
 
-    // Send CRC
-    if (ret)
+    return ret;
+}
+
+/** @brief Get the protocol version used on the maintenance link */
+uint8_t maintenance_protocol::get_version()
+{
+    return s_version;
+}
+
+/** @brief Set the protocol version negotiated on the maintenance link, it applies to the next frames */
+void maintenance_protocol::set_version(uint8_t version)
+{
+    // Wait for the end of the frame being sent
+    lock_guard<mutex> lock(s_tx_mutex);
+    s_version = version;
+}
+
+/**
+ * @brief Check the CRC of the received request
+ *        A device infos request is also accepted with the legacy checksum so that any tool can
+ *        renegotiate the protocol version, the link then falls back to the legacy version
+ */
+bool maintenance_protocol::check_crc(uint16_t crc)
+{
+    uint8_t header[HEADER_SIZE];
+    make_header(header, m_request.id, m_request.size);
+
+    bool ret = (compute_crc(s_version, header, m_request.payload, m_request.size) == crc);
+    if (!ret && (s_version != PROTOCOL_V1) && (m_request.id == ov_request_id::device_infos))
     {
-        m_serial_port.write(&crc, sizeof(uint16_t));
+        ret = (compute_crc(PROTOCOL_V1, header, m_request.payload, m_request.size) == crc);
+        if (ret)
+        {
+            set_version(PROTOCOL_V1);
+        }
     }
+
+    return ret;
 }
 
-/** @brief Send data and update the CRC computation */
-bool maintenance_protocol::send_and_update_crc(const void* data, size_t size, uint32_t& crc)
+/** @brief Build the header of a frame */
+void maintenance_protocol::make_header(uint8_t (&header)[HEADER_SIZE], ov_request_id id, uint16_t size)
 {
-    // Send data
-    bool ret = m_serial_port.write(data, size);
+    header[0] = START_OF_FRAME_1;
+    header[1] = START_OF_FRAME_2;
+    header[2] = START_OF_FRAME_3;
+    header[3] = START_OF_FRAME_4;
+    header[4] = static_cast<uint8_t>(id);
+    header[5] = static_cast<uint8_t>(size & 0xFFu);
+    header[6] = static_cast<uint8_t>(size >> 8u);
+}
 
-    // Update CRC
-    const uint8_t* buff = reinterpret_cast<const uint8_t*>(data);
+/** @brief Compute the CRC of a frame */
+uint16_t maintenance_protocol::compute_crc(uint8_t version, const uint8_t (&header)[HEADER_SIZE], const void* payload, uint16_t size)
+{
+    uint16_t crc = 0;
+    if (version == PROTOCOL_V1)
+    {
+        crc = update_checksum(update_checksum(0u, header, HEADER_SIZE), payload, size);
+    }
+    else
+    {
+        crc = crc16::update(crc16::compute(header, HEADER_SIZE), payload, size);
+    }
+
+    return crc;
+}
+
+/** @brief Update the legacy additive checksum, only its 16 lower bits are transmitted */
+uint16_t maintenance_protocol::update_checksum(uint16_t checksum, const void* data, size_t size)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
     while (size != 0)
     {
-        crc += *buff;
-        crc <<= 1;
-        buff++;
+        checksum = static_cast<uint16_t>((checksum + *bytes) << 1u);
+        bytes++;
         size--;
     }
-
-    return ret;
+    return checksum;
 }
 
 } // namespace ov
@@ -24,6 +24,13 @@ enum class ov_request_id : uint8_t
     list_flights_data,
     read_flight,
     read_flight_data,
+    upload_airspaces,
+    upload_airspaces_data,
+    upload_terrain,
+    upload_terrain_data,
+    stream_start,
+    stream_stop,
+    stream_data,
     max // Do not use
 };
 
@@ -54,6 +61,20 @@ class maintenance_protocol
     /** @brief Send a response */
     void send_response(const ov_request& request);
 
+    /** @brief Send a frame, frames sent from different threads on the same link are not interleaved */
+    static bool send_frame(i_serial& serial_port, ov_request_id id, const void* payload, uint16_t size);
+
+    /** @brief Legacy protocol version, frames are protected by an additive checksum */
+    static constexpr uint8_t PROTOCOL_V1 = 1u;
+    /** @brief Protocol version 2, frames are protected by a CRC-16/CCITT-FALSE */
+    static constexpr uint8_t PROTOCOL_V2 = 2u;
+
+    /** @brief Get the protocol version used on the maintenance link */
+    static uint8_t get_version();
+
+    /** @brief Set the protocol version negotiated on the maintenance link, it applies to the next frames */
+    static void set_version(uint8_t version);
+
   protected:
     /** @brief Receive state */
     enum class rx_state : int
@@ -77,8 +98,6 @@ class maintenance_protocol
 
     /** @brief Inter bytes timeout in milliseconds */
     static constexpr uint32_t INTER_BYTES_TIMEOUT_MS = 500u;
-    /** @brief Start of frame */
-    static constexpr uint32_t START_OF_FRAME = 0x8BADF00Du;
     /** @brief Start of frame - 1st byte*/
     static constexpr uint8_t START_OF_FRAME_1 = 0x0Du;
     /** @brief Start of frame - 2nd byte*/
@@ -88,8 +107,20 @@ class maintenance_protocol
     /** @brief Start of frame - 4th byte*/
     static constexpr uint8_t START_OF_FRAME_4 = 0x8Bu;
 
-    /** @brief Send data and update the CRC computation */
-    bool send_and_update_crc(const void* data, size_t size, uint32_t& crc);
+    /** @brief Size of the header of a frame in bytes (start of frame, id and size) */
+    static constexpr size_t HEADER_SIZE = 7u;
+
+    /** @brief Check the CRC of the received request */
+    bool check_crc(uint16_t crc);
+
+    /** @brief Build the header of a frame */
+    static void make_header(uint8_t (&header)[HEADER_SIZE], ov_request_id id, uint16_t size);
+
+    /** @brief Compute the CRC of a frame */
+    static uint16_t compute_crc(uint8_t version, const uint8_t (&header)[HEADER_SIZE], const void* payload, uint16_t size);
+
+    /** @brief Update the legacy additive checksum, only its 16 lower bits are transmitted */
+    static uint16_t update_checksum(uint16_t checksum, const void* data, size_t size);
 };
 
 } // namespace ov
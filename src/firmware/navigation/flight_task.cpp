@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_task.h"
+#include "fs.h"
+#include "line_reader.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+flight_task::flight_task() : m_turnpoints{}, m_count(0u) { }
+
+/** @brief Load a task file, the waypoints are looked up in the waypoint database */
+bool flight_task::load(const char* path)
+{
+    m_count = 0u;
+
+    // Read turnpoints definitions
+    file task_file = ov::fs::open(path, ov::fs::o_rdonly);
+    bool ret       = task_file.is_open();
+    if (ret)
+    {
+        line_reader reader(task_file);
+        char        line[64u];
+        while (ret && reader.read_line(line, sizeof(line)))
+        {
+            ret = parse_line(line);
+        }
+        ret = ret && (m_count >= 2u);
+    }
+
+    // Lookup waypoints
+    if (ret)
+    {
+        waypoint waypoints[MAX_TURNPOINTS];
+        bool     found[MAX_TURNPOINTS];
+        for (size_t i = 0u; i < m_count; i++)
+        {
+            waypoints[i] = m_turnpoints[i].wp;
+        }
+        ret = waypoint_db::find(waypoints, found, m_count);
+        for (size_t i = 0u; ret && (i < m_count); i++)
+        {
+            m_turnpoints[i].wp = waypoints[i];
+            ret                = found[i];
+        }
+    }
+    if (!ret)
+    {
+        m_count = 0u;
+    }
+
+    return ret;
+}
+
+/** @brief Parse a line of a task file */
+bool flight_task::parse_line(char* line)
+{
+    bool ret = true;
+
+    // Skip empty lines and comments
+    char* type_str = next_token(line);
+    if ((type_str[0u] != 0) && (type_str[0u] != '#'))
+    {
+        turnpoint tp = {};
+        if (strcmp(type_str, "takeoff") == 0)
+        {
+            tp.type = turnpoint_type::takeoff;
+        }
+        else if (strcmp(type_str, "sss") == 0)
+        {
+            tp.type = turnpoint_type::start;
+        }
+        else if (strcmp(type_str, "tp") == 0)
+        {
+            tp.type = turnpoint_type::turnpoint;
+        }
+        else if (strcmp(type_str, "ess") == 0)
+        {
+            tp.type = turnpoint_type::end_of_speed_section;
+        }
+        else if (strcmp(type_str, "goal") == 0)
+        {
+            tp.type = turnpoint_type::goal;
+        }
+        else
+        {
+            ret = false;
+        }
+
+        // Radius
+        char* radius_str = next_token(line);
+        char* end        = nullptr;
+        tp.radius        = strtoul(radius_str, &end, 10);
+        ret              = ret && (end != radius_str);
+
+        // Waypoint name is the rest of the line (may contain spaces)
+        ret = ret && (line[0u] != 0) && (m_count < MAX_TURNPOINTS);
+        if (ret)
+        {
+            strncpy(tp.wp.name, line, sizeof(tp.wp.name));
+            tp.wp.name[sizeof(tp.wp.name) - 1u] = 0;
+
+            m_turnpoints[m_count] = tp;
+            m_count++;
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Extract the next space separated token of a string */
+char* flight_task::next_token(char*& str)
+{
+    while ((*str == ' ') || (*str == '\t'))
+    {
+        str++;
+    }
+    char* token = str;
+    while ((*str != 0) && (*str != ' ') && (*str != '\t'))
+    {
+        str++;
+    }
+    if (*str != 0)
+    {
+        *str = 0;
+        str++;
+        while ((*str == ' ') || (*str == '\t'))
+        {
+            str++;
+        }
+    }
+    return token;
+}
+
+} // namespace ov
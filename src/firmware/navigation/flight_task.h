@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_TASK_H
+#define OV_FLIGHT_TASK_H
+
+#include "waypoint_db.h"
+
+namespace ov
+{
+
+/**
+ * @brief Competition task made of turnpoint cylinders
+ *        The task file contains one turnpoint per line : <type> <radius in meters> <waypoint name or code>
+ *        with type = takeoff, sss (start of speed section, exit cylinder), tp, ess (end of speed section) or goal
+ */
+class flight_task
+{
+  public:
+    /** @brief Default task file */
+    static constexpr const char* TASK_FILE = "/navigation/task.txt";
+    /** @brief Maximum number of turnpoints */
+    static constexpr size_t MAX_TURNPOINTS = 25u;
+
+    /** @brief Turnpoint types */
+    enum class turnpoint_type : uint8_t
+    {
+        /** @brief Takeoff */
+        takeoff,
+        /** @brief Start of speed section (exit cylinder) */
+        start,
+        /** @brief Turnpoint */
+        turnpoint,
+        /** @brief End of speed section */
+        end_of_speed_section,
+        /** @brief Goal */
+        goal
+    };
+
+    /** @brief Turnpoint */
+    struct turnpoint
+    {
+        /** @brief Waypoint at the center of the cylinder */
+        waypoint wp;
+        /** @brief Radius of the cylinder in meters */
+        uint32_t radius;
+        /** @brief Type */
+        turnpoint_type type;
+    };
+
+    /** @brief Constructor */
+    flight_task();
+
+    /** @brief Remove all the turnpoints */
+    void clear() { m_count = 0u; }
+
+    /** @brief Load a task file, the waypoints are looked up in the waypoint database */
+    bool load(const char* path);
+
+    /** @brief Get the number of turnpoints */
+    size_t get_count() const { return m_count; }
+
+    /** @brief Get a turnpoint */
+    const turnpoint& get_turnpoint(size_t index) const { return m_turnpoints[index]; }
+
+  private:
+    /** @brief Turnpoints */
+    turnpoint m_turnpoints[MAX_TURNPOINTS];
+    /** @brief Number of turnpoints */
+    size_t m_count;
+
+    /** @brief Parse a line of a task file */
+    bool parse_line(char* line);
+
+    /** @brief Extract the next space separated token of a string */
+    static char* next_token(char*& str);
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_TASK_H
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_NAVIGATION_MANAGER_H
+#define OV_I_NAVIGATION_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Interface for the navigation manager implementation */
+class i_navigation_manager
+{
+  public:
+    /** @brief Status of the task */
+    enum class status
+    {
+        /** @brief No task */
+        no_task,
+        /** @brief Task loading in progress */
+        loading,
+        /** @brief Task ready */
+        ready,
+        /** @brief Task could not be loaded */
+        load_error
+    };
+
+    /** @brief Destructor */
+    virtual ~i_navigation_manager() { }
+
+    /** @brief Load a task file (asynchronous) */
+    virtual bool load_task(const char* task_path) = 0;
+
+    /** @brief Select the active turnpoint (asynchronous) */
+    virtual bool select_turnpoint(size_t index) = 0;
+
+    /** @brief Get the status of the task */
+    virtual status get_status() = 0;
+
+    /** @brief Get the number of sweeps done on the last route optimization */
+    virtual size_t get_sweeps() = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_NAVIGATION_MANAGER_H
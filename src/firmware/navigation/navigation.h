@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_NAVIGATION_H
+#define OV_NAVIGATION_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Task navigation status */
+struct navigation_status
+{
+    /** @brief Name of the active turnpoint */
+    char turnpoint[16u];
+    /** @brief Index of the active turnpoint */
+    uint8_t turnpoint_index;
+    /** @brief Number of turnpoints of the task */
+    uint8_t turnpoint_count;
+    /** @brief Distance to the active turnpoint cylinder along the optimized route in meters */
+    uint32_t turnpoint_distance;
+    /** @brief Bearing to the optimized point of the active turnpoint (1 = 0.1°) */
+    uint16_t bearing;
+    /** @brief Distance to goal along the optimized route in meters */
+    uint32_t goal_distance;
+    /** @brief Glide ratio required to reach goal (1 = 0.1) */
+    uint16_t required_glide_ratio;
+    /** @brief Indicate if the goal has been reached */
+    bool goal_reached;
+    /** @brief Indicate if the status is valid */
+    bool is_valid;
+};
+
+} // namespace ov
+
+#endif // OV_NAVIGATION_H
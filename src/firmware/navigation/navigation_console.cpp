@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "navigation_console.h"
+#include "i_navigation_manager.h"
+#include "ov_data.h"
+#include "flight_task.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace ov
+{
+
+/** @brief Constructor */
+navigation_console::navigation_console(i_debug_console& console, i_navigation_manager& navigation)
+    : m_console(console),
+      m_navigation(navigation),
+      m_taskload_handler{"taskload",
+                         "Load a task file",
+                         ov::handler_func::create<navigation_console, &navigation_console::taskload_handler>(*this),
+                         nullptr,
+                         false},
+      m_task_handler{"task",
+                     "Display the task navigation status",
+                     ov::handler_func::create<navigation_console, &navigation_console::task_handler>(*this),
+                     nullptr,
+                     false},
+      m_tpselect_handler{"tpselect",
+                         "Select the active turnpoint",
+                         ov::handler_func::create<navigation_console, &navigation_console::tpselect_handler>(*this),
+                         nullptr,
+                         false}
+{
+}
+
+/** @brief Register command handlers */
+void navigation_console::register_handlers()
+{
+    m_console.register_handler(m_taskload_handler);
+    m_console.register_handler(m_task_handler);
+    m_console.register_handler(m_tpselect_handler);
+}
+
+/** @brief Handler for the 'taskload' command */
+void navigation_console::taskload_handler(const char* task_path)
+{
+    const char* path = flight_task::TASK_FILE;
+    if (task_path)
+    {
+        path = task_path;
+    }
+
+    if (m_navigation.load_task(path))
+    {
+        m_console.write_line("Loading started");
+    }
+    else
+    {
+        m_console.write_line("Unable to start loading");
+    }
+}
+
+/** @brief Handler for the 'task' command */
+void navigation_console::task_handler(const char*)
+{
+    // Task
+    switch (m_navigation.get_status())
+    {
+        case i_navigation_manager::status::ready:
+            m_console.write_line("Task : ready");
+            break;
+
+        case i_navigation_manager::status::loading:
+            m_console.write_line("Task : loading in progress");
+            break;
+
+        case i_navigation_manager::status::load_error:
+            m_console.write_line("Task : load error");
+            break;
+
+        case i_navigation_manager::status::no_task:
+            [[fallthrough]];
+        default:
+            m_console.write_line("Task : none");
+            break;
+    }
+
+    // Navigation
+    char tmp[96u];
+    auto navigation = ov::data::get_navigation();
+    if (!navigation.is_valid)
+    {
+        m_console.write_line("Navigation : unavailable");
+    }
+    else if (navigation.goal_reached)
+    {
+        m_console.write_line("Navigation : goal reached");
+    }
+    else
+    {
+        snprintf(tmp,
+                 sizeof(tmp),
+                 "Turnpoint %d/%d : %s, %ldm, bearing %d.%d",
+                 static_cast<int>(navigation.turnpoint_index + 1u),
+                 static_cast<int>(navigation.turnpoint_count),
+                 navigation.turnpoint,
+                 static_cast<long>(navigation.turnpoint_distance),
+                 static_cast<int>(navigation.bearing / 10u),
+                 static_cast<int>(navigation.bearing % 10u));
+        m_console.write_line(tmp);
+        snprintf(tmp,
+                 sizeof(tmp),
+                 "Goal : %ldm, required glide ratio %d.%d (%d sweeps)",
+                 static_cast<long>(navigation.goal_distance),
+                 static_cast<int>(navigation.required_glide_ratio / 10u),
+                 static_cast<int>(navigation.required_glide_ratio % 10u),
+                 static_cast<int>(m_navigation.get_sweeps()));
+        m_console.write_line(tmp);
+    }
+}
+
+/** @brief Handler for the 'tpselect' command */
+void navigation_console::tpselect_handler(const char* index)
+{
+    // Turnpoints are numbered from 1 on the user side
+    bool ret = false;
+    if (index)
+    {
+        const long tp_index = strtol(index, nullptr, 10);
+        ret                 = (tp_index > 0) && m_navigation.select_turnpoint(static_cast<size_t>(tp_index - 1));
+    }
+    if (ret)
+    {
+        m_console.write_line("Turnpoint selected");
+    }
+    else
+    {
+        m_console.write_line("Invalid turnpoint");
+    }
+}
+
+} // namespace ov
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_NAVIGATION_CONSOLE_H
+#define OV_NAVIGATION_CONSOLE_H
+
+#include "i_debug_console.h"
+
+namespace ov
+{
+
+// Forward declarations
+class i_navigation_manager;
+
+/** @brief Console command helpers for the navigation manager */
+class navigation_console
+{
+  public:
+    /** @brief Constructor */
+    navigation_console(i_debug_console& console, i_navigation_manager& navigation);
+
+    /** @brief Register command handlers */
+    void register_handlers();
+
+  private:
+    /** @brief Console */
+    i_debug_console& m_console;
+    /** @brief Navigation manager */
+    i_navigation_manager& m_navigation;
+
+    /** @brief Handler for the 'taskload' command */
+    ov::i_debug_console::cmd_handler m_taskload_handler;
+    /** @brief Handler for the 'task' command */
+    ov::i_debug_console::cmd_handler m_task_handler;
+    /** @brief Handler for the 'tpselect' command */
+    ov::i_debug_console::cmd_handler m_tpselect_handler;
+
+    /** @brief Handler for the 'taskload' command */
+    void taskload_handler(const char* task_path);
+    /** @brief Handler for the 'task' command */
+    void task_handler(const char*);
+    /** @brief Handler for the 'tpselect' command */
+    void tpselect_handler(const char* index);
+};
+
+} // namespace ov
+
+#endif // OV_NAVIGATION_CONSOLE_H
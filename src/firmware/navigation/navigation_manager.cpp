@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "navigation_manager.h"
+#include "fs.h"
+#include "os.h"
+#include "ov_data.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Period of the navigation updates in milliseconds */
+static const uint32_t UPDATE_PERIOD_MS = 250u;
+
+/** @brief Constructor */
+navigation_manager::navigation_manager()
+    : m_status(status::no_task),
+      m_load_requested(false),
+      m_task_path{},
+      m_requested_turnpoint(flight_task::MAX_TURNPOINTS),
+      m_task(),
+      m_optimizer(),
+      m_active(0u),
+      m_inside(false),
+      m_thread()
+{
+}
+
+/** @brief Initialize the navigation manager */
+bool navigation_manager::init()
+{
+    bool ret = true;
+
+    // Create the directory to store the navigation files
+    dir storage_dir = fs::open_dir(waypoint_db::NAVIGATION_DIR);
+    if (!storage_dir.is_open())
+    {
+        ret = fs::mkdir(waypoint_db::NAVIGATION_DIR);
+    }
+
+    if (ret)
+    {
+        // Load the default task if any
+        load_task(flight_task::TASK_FILE);
+
+        // Start navigation thread
+        auto thread_func = ov::thread_func::create<navigation_manager, &navigation_manager::thread_func>(*this);
+        ret              = m_thread.start(thread_func, "Navigation", 2u, nullptr);
+    }
+
+    return ret;
+}
+
+/** @brief Load a task file (asynchronous) */
+bool navigation_manager::load_task(const char* task_path)
+{
+    bool ret = false;
+
+    // Check if a loading is already in progress
+    if (!m_load_requested && (strlen(task_path) < sizeof(m_task_path)))
+    {
+        strcpy(m_task_path, task_path);
+        m_load_requested = true;
+        ret              = true;
+    }
+
+    return ret;
+}
+
+/** @brief Select the active turnpoint (asynchronous) */
+bool navigation_manager::select_turnpoint(size_t index)
+{
+    bool ret = false;
+
+    if ((m_status == status::ready) && (index < m_task.get_count()))
+    {
+        m_requested_turnpoint = index;
+        ret                   = true;
+    }
+
+    return ret;
+}
+
+/** @brief Navigation thread */
+void navigation_manager::thread_func(void*)
+{
+    // Thread loop
+    while (true)
+    {
+        // Load a new task
+        if (m_load_requested)
+        {
+            m_status = status::loading;
+            ov::data::invalidate_navigation();
+            if (m_task.load(m_task_path))
+            {
+                m_optimizer.set_task(m_task);
+                set_active_turnpoint(0u);
+                m_status = status::ready;
+            }
+            else
+            {
+                m_status = status::load_error;
+            }
+            m_load_requested = false;
+        }
+
+        // Manual turnpoint selection
+        if (m_requested_turnpoint < m_task.get_count())
+        {
+            set_active_turnpoint(m_requested_turnpoint);
+            m_requested_turnpoint = flight_task::MAX_TURNPOINTS;
+        }
+
+        // Update navigation
+        ov_data data = ov::data::get();
+        if ((m_status == status::ready) && data.gnss.is_valid && data.altimeter.is_valid)
+        {
+            navigation_status navigation = {};
+            update(data.gnss.get_position(), data.altimeter.altitude / 10, navigation);
+            ov::data::set_navigation(navigation);
+        }
+        else
+        {
+            ov::data::invalidate_navigation();
+        }
+
+        ov::this_thread::sleep_for(UPDATE_PERIOD_MS);
+    }
+}
+
+/** @brief Set the active turnpoint */
+void navigation_manager::set_active_turnpoint(size_t index)
+{
+    m_active = index;
+    m_inside = false;
+    m_optimizer.reset();
+}
+
+/** @brief Update the navigation with a new position */
+void navigation_manager::update(const geo::position& pos, int32_t altitude, navigation_status& navigation)
+{
+    // Turnpoint validation : start is validated when leaving its cylinder, other turnpoints when entering their cylinder
+    if (m_active < m_task.get_count())
+    {
+        const auto& tp     = m_task.get_turnpoint(m_active);
+        const bool  inside = (geo::distance(pos, tp.wp.position) <= static_cast<float>(tp.radius));
+        bool        validated;
+        if (tp.type == flight_task::turnpoint_type::start)
+        {
+            validated = (m_inside && !inside);
+        }
+        else
+        {
+            validated = inside;
+        }
+        m_inside = inside;
+        if (validated)
+        {
+            m_active++;
+            m_inside = false;
+        }
+    }
+
+    // Optimized route to goal
+    navigation.turnpoint_count      = static_cast<uint8_t>(m_task.get_count());
+    navigation.required_glide_ratio = ov_data::INVALID_GLIDE_RATIO_VALUE;
+    navigation.is_valid             = true;
+    if (m_active < m_task.get_count())
+    {
+        const auto&         tp             = m_task.get_turnpoint(m_active);
+        const auto&         goal           = m_task.get_turnpoint(m_task.get_count() - 1u);
+        const float         goal_distance  = m_optimizer.update(pos, m_active);
+        const geo::position target         = m_optimizer.get_point(m_active);
+        navigation.turnpoint_index             = static_cast<uint8_t>(m_active);
+        navigation.turnpoint_distance          = static_cast<uint32_t>(std::lround(m_optimizer.get_first_leg_distance()));
+        navigation.goal_distance               = static_cast<uint32_t>(std::lround(goal_distance));
+        navigation.bearing                     = static_cast<uint16_t>(std::lround(geo::bearing(pos, target) * 10.f) % 3600);
+        strncpy(navigation.turnpoint, tp.wp.name, sizeof(navigation.turnpoint));
+        navigation.turnpoint[sizeof(navigation.turnpoint) - 1u] = 0;
+
+        // Required glide ratio to reach goal elevation
+        const int32_t height = altitude - goal.wp.elevation;
+        if (height > 0)
+        {
+            const uint32_t glide_ratio = (navigation.goal_distance * 10u) / static_cast<uint32_t>(height);
+            if (glide_ratio < ov_data::INVALID_GLIDE_RATIO_VALUE)
+            {
+                navigation.required_glide_ratio = static_cast<uint16_t>(glide_ratio);
+            }
+        }
+    }
+    else
+    {
+        navigation.turnpoint_index = navigation.turnpoint_count;
+        navigation.goal_reached    = true;
+    }
+}
+
+} // namespace ov
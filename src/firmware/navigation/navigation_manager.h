@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_NAVIGATION_MANAGER_H
+#define OV_NAVIGATION_MANAGER_H
+
+#include "i_navigation_manager.h"
+#include "navigation.h"
+#include "route_optimizer.h"
+#include "thread.h"
+
+namespace ov
+{
+
+/** @brief Task navigation manager */
+class navigation_manager : public i_navigation_manager
+{
+  public:
+    /** @brief Constructor */
+    navigation_manager();
+
+    /** @brief Initialize the navigation manager */
+    bool init();
+
+    /** @brief Load a task file (asynchronous) */
+    bool load_task(const char* task_path) override;
+
+    /** @brief Select the active turnpoint (asynchronous) */
+    bool select_turnpoint(size_t index) override;
+
+    /** @brief Get the status of the task */
+    status get_status() override { return m_status; }
+
+    /** @brief Get the number of sweeps done on the last route optimization */
+    size_t get_sweeps() override { return m_optimizer.get_sweeps(); }
+
+  private:
+    /** @brief Status of the task */
+    status m_status;
+    /** @brief Indicate that a task loading has been requested */
+    bool m_load_requested;
+    /** @brief Path of the task file to load */
+    char m_task_path[64u];
+    /** @brief Requested active turnpoint, flight_task::MAX_TURNPOINTS if none */
+    size_t m_requested_turnpoint;
+    /** @brief Task */
+    flight_task m_task;
+    /** @brief Route optimizer */
+    route_optimizer m_optimizer;
+    /** @brief Index of the active turnpoint */
+    size_t m_active;
+    /** @brief Indicate if the position was inside the active cylinder on the previous update */
+    bool m_inside;
+    /** @brief Navigation thread */
+    thread<2048u> m_thread;
+
+    /** @brief Navigation thread */
+    void thread_func(void*);
+
+    /** @brief Set the active turnpoint */
+    void set_active_turnpoint(size_t index);
+
+    /** @brief Update the navigation with a new position */
+    void update(const geo::position& pos, int32_t altitude, navigation_status& navigation);
+};
+
+} // namespace ov
+
+#endif // OV_NAVIGATION_MANAGER_H
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "route_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Minimum norm of a vector to be normalized */
+static constexpr float MIN_NORM = 1e-3f;
+
+/** @brief Maximum rotation of a touch point around its cylinder on a single step (rad) */
+static constexpr float MAX_ANGLE_STEP = 0.5f;
+
+/** @brief Maximum number of times a rotation step is halved until the route gets shorter */
+static constexpr size_t MAX_STEP_HALVINGS = 8u;
+
+/** @brief Constructor */
+route_optimizer::route_optimizer()
+    : m_projection(), m_centers{}, m_radiuses{}, m_points{}, m_count(0u), m_first_leg_distance(0.f), m_sweeps(0u)
+{
+}
+
+/** @brief Set the task, the touch points are initialized at the cylinder centers */
+void route_optimizer::set_task(const flight_task& t)
+{
+    // Center the projection on the task
+    m_count = t.get_count();
+    if (m_count != 0u)
+    {
+        geo::position min = t.get_turnpoint(0u).wp.position;
+        geo::position max = min;
+        for (size_t i = 1u; i < m_count; i++)
+        {
+            const geo::position& pos = t.get_turnpoint(i).wp.position;
+            min.latitude             = std::min(min.latitude, pos.latitude);
+            min.longitude            = std::min(min.longitude, pos.longitude);
+            max.latitude             = std::max(max.latitude, pos.latitude);
+            max.longitude            = std::max(max.longitude, pos.longitude);
+        }
+        m_projection.set_reference({min.latitude + (max.latitude - min.latitude) / 2, min.longitude + (max.longitude - min.longitude) / 2});
+    }
+
+    // Project cylinders
+    for (size_t i = 0u; i < m_count; i++)
+    {
+        const auto& tp = t.get_turnpoint(i);
+        m_projection.to_xy(tp.wp.position, m_centers[i].x, m_centers[i].y);
+        m_radiuses[i] = static_cast<float>(tp.radius);
+    }
+    reset();
+}
+
+/** @brief Restart the optimization from scratch */
+void route_optimizer::reset()
+{
+    for (size_t i = 0u; i < m_count; i++)
+    {
+        m_points[i] = m_centers[i];
+    }
+    m_first_leg_distance = 0.f;
+    m_sweeps             = 0u;
+}
+
+/** @brief Update the optimized route */
+float route_optimizer::update(const geo::position& pos, size_t first)
+{
+    float distance = 0.f;
+
+    m_first_leg_distance = 0.f;
+    m_sweeps             = 0u;
+    if (first < m_count)
+    {
+        point current;
+        m_projection.to_xy(pos, current.x, current.y);
+
+        // Sweep over the touch points until they don't move anymore
+        float displacement = CONVERGENCE_DISTANCE;
+        while ((m_sweeps < MAX_SWEEPS) && (displacement >= CONVERGENCE_DISTANCE))
+        {
+            displacement = 0.f;
+            for (size_t i = first; i < (m_count - 1u); i++)
+            {
+                const point& previous = (i == first) ? current : m_points[i - 1u];
+                displacement          = std::max(displacement, optimize_point(i, previous, m_points[i + 1u]));
+            }
+            const point& previous = ((m_count - 1u) == first) ? current : m_points[m_count - 2u];
+            displacement          = std::max(displacement, optimize_last_point(m_count - 1u, previous));
+            m_sweeps++;
+        }
+
+        // Great circle distance along the route
+        geo::position previous = get_point(first);
+        m_first_leg_distance   = geo::distance(pos, previous);
+        distance               = m_first_leg_distance;
+        for (size_t i = first + 1u; i < m_count; i++)
+        {
+            const geo::position next = get_point(i);
+            distance += geo::distance(previous, next);
+            previous = next;
+        }
+    }
+
+    return distance;
+}
+
+/** @brief Get the optimized touch point of a turnpoint */
+geo::position route_optimizer::get_point(size_t index) const
+{
+    return m_projection.from_xy(m_points[index].x, m_points[index].y);
+}
+
+/** @brief Optimize the touch point of an intermediate cylinder between 2 points, returns the displacement (m) */
+float route_optimizer::optimize_point(size_t index, const point& previous, const point& next)
+{
+    const point& center = m_centers[index];
+    const float  radius = m_radiuses[index];
+    point&       p      = m_points[index];
+    point        new_p  = center;
+
+    // Point of the segment [previous, next] closest to the center
+    const float seg_x  = next.x - previous.x;
+    const float seg_y  = next.y - previous.y;
+    const float seg_l2 = seg_x * seg_x + seg_y * seg_y;
+    float       t      = 0.f;
+    if (seg_l2 > MIN_NORM)
+    {
+        t = ((center.x - previous.x) * seg_x + (center.y - previous.y) * seg_y) / seg_l2;
+        t = std::min(1.f, std::max(0.f, t));
+    }
+    const point closest = {previous.x + t * seg_x, previous.y + t * seg_y};
+    const float dx      = closest.x - center.x;
+    const float dy      = closest.y - center.y;
+    if ((dx * dx + dy * dy) <= (radius * radius))
+    {
+        // The straight line crosses the cylinder
+        new_p = closest;
+    }
+    else if (radius > 0.f)
+    {
+        if (!newton_step(center, radius, previous, next, p, new_p))
+        {
+            // Reflection on the cylinder : the sum of the unit vectors to the neighbours is along the normal
+            float v1_x = previous.x - p.x;
+            float v1_y = previous.y - p.y;
+            float v2_x = next.x - p.x;
+            float v2_y = next.y - p.y;
+            float n1   = std::sqrt(v1_x * v1_x + v1_y * v1_y);
+            float n2   = std::sqrt(v2_x * v2_x + v2_y * v2_y);
+            float nx   = ((n1 > MIN_NORM) ? (v1_x / n1) : 0.f) + ((n2 > MIN_NORM) ? (v2_x / n2) : 0.f);
+            float ny   = ((n1 > MIN_NORM) ? (v1_y / n1) : 0.f) + ((n2 > MIN_NORM) ? (v2_y / n2) : 0.f);
+            float norm = std::sqrt(nx * nx + ny * ny);
+            if (norm <= MIN_NORM)
+            {
+                // Degenerated case, use the direction of the segment closest point
+                nx   = dx;
+                ny   = dy;
+                norm = std::sqrt(nx * nx + ny * ny);
+            }
+            if (norm > MIN_NORM)
+            {
+                new_p.x = center.x + radius * nx / norm;
+                new_p.y = center.y + radius * ny / norm;
+            }
+        }
+    }
+    else
+    {
+        // Point turnpoint
+    }
+
+    const float displacement = std::hypot(new_p.x - p.x, new_p.y - p.y);
+    p                        = new_p;
+    return displacement;
+}
+
+/**
+ * @brief Move a touch point lying on its cylinder with a Newton step on its angle, returns false if the step is not defined
+ *        Unlike the reflection rule, the step does not oscillate when a neighbour is close compared to the radius
+ */
+bool route_optimizer::newton_step(const point& center, float radius, const point& previous, const point& next, const point& p, point& new_p)
+{
+    bool ret = false;
+
+    const float dx       = p.x - center.x;
+    const float dy       = p.y - center.y;
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    if (std::fabs(distance - radius) < CONVERGENCE_DISTANCE)
+    {
+        // Normal and tangent of the cylinder at the touch point
+        const float nx = dx / distance;
+        const float ny = dy / distance;
+        const float tx = -ny;
+        const float ty = nx;
+
+        // Length of both legs, first and second derivatives with respect to the angle
+        float length            = 0.f;
+        float first_derivative  = 0.f;
+        float second_derivative = 0.f;
+        for (const point* neighbour : {&previous, &next})
+        {
+            const float vx = neighbour->x - p.x;
+            const float vy = neighbour->y - p.y;
+            const float d  = std::sqrt(vx * vx + vy * vy);
+            length += d;
+            if (d > MIN_NORM)
+            {
+                const float un = (vx * nx + vy * ny) / d;
+                const float ut = (vx * tx + vy * ty) / d;
+                first_derivative -= radius * ut;
+                second_derivative += radius * un + radius * radius * un * un / d;
+            }
+        }
+
+        // The length is only convex around the optimal touch point, and the step overshoots when a neighbour is
+        // close to the cylinder : it is halved until the route gets shorter
+        if (second_derivative > MIN_NORM)
+        {
+            float step       = std::min(MAX_ANGLE_STEP, std::max(-MAX_ANGLE_STEP, -first_derivative / second_derivative));
+            bool  is_shorter = false;
+            new_p            = p;
+            ret              = true;
+            for (size_t i = 0u; !is_shorter && (i < MAX_STEP_HALVINGS); i++)
+            {
+                const float cos_step = std::cos(step);
+                const float sin_step = std::sin(step);
+                const float qx       = center.x + radius * (nx * cos_step + tx * sin_step);
+                const float qy       = center.y + radius * (ny * cos_step + ty * sin_step);
+                const point q        = {qx, qy};
+                const float l        = std::hypot(previous.x - q.x, previous.y - q.y) + std::hypot(next.x - q.x, next.y - q.y);
+                is_shorter           = (l < length);
+                if (is_shorter)
+                {
+                    new_p = q;
+                }
+                step *= 0.5f;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Optimize the touch point of the last cylinder, returns the displacement (m) */
+float route_optimizer::optimize_last_point(size_t index, const point& previous)
+{
+    const point& center = m_centers[index];
+    const float  radius = m_radiuses[index];
+    point&       p      = m_points[index];
+    point        new_p  = previous;
+
+    // Closest point of the cylinder
+    const float dx       = previous.x - center.x;
+    const float dy       = previous.y - center.y;
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance > radius)
+    {
+        new_p.x = center.x + radius * dx / distance;
+        new_p.y = center.y + radius * dy / distance;
+    }
+
+    const float displacement = std::hypot(new_p.x - p.x, new_p.y - p.y);
+    p                        = new_p;
+    return displacement;
+}
+
+} // namespace ov
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_ROUTE_OPTIMIZER_H
+#define OV_ROUTE_OPTIMIZER_H
+
+#include "flight_task.h"
+
+namespace ov
+{
+
+/**
+ * @brief Shortest route through the remaining turnpoint cylinders of a task
+ *        Each touch point is moved on its cylinder so that the route reflects on it like a light ray,
+ *        the points of the previous solution are the starting point of the next update so that only
+ *        a few sweeps are needed on each GNSS fix. Computations are done in a flat projection centered
+ *        on the task and the distances are computed on the great circle.
+ */
+class route_optimizer
+{
+  public:
+    /** @brief Maximum number of sweeps over the touch points on each update */
+    static constexpr size_t MAX_SWEEPS = 4u;
+    /** @brief Displacement of the touch points under which the route is considered as optimal (m) */
+    static constexpr float CONVERGENCE_DISTANCE = 1.f;
+
+    /** @brief Constructor */
+    route_optimizer();
+
+    /** @brief Set the task, the touch points are initialized at the cylinder centers */
+    void set_task(const flight_task& t);
+
+    /** @brief Restart the optimization from scratch */
+    void reset();
+
+    /**
+     * @brief Update the optimized route
+     * @param pos Current position
+     * @param first Index of the first turnpoint to reach
+     * @return Distance to goal along the optimized route in meters
+     */
+    float update(const geo::position& pos, size_t first);
+
+    /** @brief Get the optimized touch point of a turnpoint */
+    geo::position get_point(size_t index) const;
+
+    /** @brief Get the distance between the current position and the touch point of the first turnpoint (m) */
+    float get_first_leg_distance() const { return m_first_leg_distance; }
+
+    /** @brief Get the number of sweeps done on the last update */
+    size_t get_sweeps() const { return m_sweeps; }
+
+  private:
+    /** @brief Point in the flat projection (m) */
+    struct point
+    {
+        /** @brief East */
+        float x;
+        /** @brief North */
+        float y;
+    };
+
+    /** @brief Projection centered on the task */
+    geo::flat_projection m_projection;
+    /** @brief Cylinder centers */
+    point m_centers[flight_task::MAX_TURNPOINTS];
+    /** @brief Cylinder radiuses (m) */
+    float m_radiuses[flight_task::MAX_TURNPOINTS];
+    /** @brief Touch points */
+    point m_points[flight_task::MAX_TURNPOINTS];
+    /** @brief Number of turnpoints */
+    size_t m_count;
+    /** @brief Distance between the current position and the touch point of the first turnpoint (m) */
+    float m_first_leg_distance;
+    /** @brief Number of sweeps done on the last update */
+    size_t m_sweeps;
+
+    /** @brief Optimize the touch point of an intermediate cylinder between 2 points, returns the displacement (m) */
+    float optimize_point(size_t index, const point& previous, const point& next);
+
+    /** @brief Optimize the touch point of the last cylinder, returns the displacement (m) */
+    float optimize_last_point(size_t index, const point& previous);
+
+    /** @brief Move a touch point lying on its cylinder with a Newton step on its angle, returns false if the step is not defined */
+    static bool newton_step(const point& center, float radius, const point& previous, const point& next, const point& p, point& new_p);
+};
+
+} // namespace ov
+
+#endif // OV_ROUTE_OPTIMIZER_H
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "waypoint_db.h"
+#include "fs.h"
+#include "line_reader.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace ov
+{
+
+/** @brief Look for waypoints by name or code (case insensitive) */
+bool waypoint_db::find(waypoint* waypoints, bool* found, size_t count)
+{
+    for (size_t i = 0u; i < count; i++)
+    {
+        found[i] = false;
+    }
+
+    file waypoints_file = ov::fs::open(WAYPOINTS_FILE, ov::fs::o_rdonly);
+    bool ret            = waypoints_file.is_open();
+    if (ret)
+    {
+        // Single pass over the waypoints file
+        line_reader reader(waypoints_file);
+        char        line[160u];
+        while (reader.read_line(line, sizeof(line)))
+        {
+            // Task section of the file
+            if (strncmp(line, "-----", 5u) == 0)
+            {
+                break;
+            }
+
+            const char* name = nullptr;
+            const char* code = nullptr;
+            waypoint    wp;
+            if (parse_line(line, name, code, wp))
+            {
+                for (size_t i = 0u; i < count; i++)
+                {
+                    if (!found[i] && ((strcasecmp(waypoints[i].name, name) == 0) || (strcasecmp(waypoints[i].name, code) == 0)))
+                    {
+                        waypoints[i] = wp;
+                        found[i]     = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Parse a waypoint line of a CUP file */
+bool waypoint_db::parse_line(char* line, const char*& name, const char*& code, waypoint& wp)
+{
+    // Split fields : name, code, country, lat, lon, elev, ...
+    static constexpr size_t FIELD_COUNT = 6u;
+    const char*             fields[FIELD_COUNT];
+    size_t                  field_count = 0u;
+    char*                   current     = line;
+    while ((field_count < FIELD_COUNT) && current)
+    {
+        // Quoted fields may contain commas
+        if (*current == '"')
+        {
+            current++;
+            fields[field_count] = current;
+            char* end_quote     = strchr(current, '"');
+            if (end_quote)
+            {
+                *end_quote = 0;
+                current    = end_quote + 1;
+            }
+            else
+            {
+                current = nullptr;
+            }
+        }
+        else
+        {
+            fields[field_count] = current;
+        }
+        field_count++;
+
+        // Next field
+        if (current)
+        {
+            char* separator = strchr(current, ',');
+            if (separator)
+            {
+                *separator = 0;
+                current    = separator + 1;
+            }
+            else
+            {
+                current = nullptr;
+            }
+        }
+    }
+
+    // Header line has no valid coordinates
+    bool ret = (field_count == FIELD_COUNT);
+    ret      = ret && parse_coordinate(fields[3u], 2u, wp.position.latitude);
+    ret      = ret && parse_coordinate(fields[4u], 3u, wp.position.longitude);
+    if (ret)
+    {
+        name         = fields[0u];
+        code         = fields[1u];
+        wp.elevation = parse_elevation(fields[5u]);
+        strncpy(wp.name, (code[0u] != 0) ? code : name, sizeof(wp.name));
+        wp.name[sizeof(wp.name) - 1u] = 0;
+    }
+
+    return ret;
+}
+
+/** @brief Parse a CUP coordinate (DDMM.mmmN or DDDMM.mmmE) */
+bool waypoint_db::parse_coordinate(const char* str, size_t degree_digits, int32_t& value)
+{
+    bool ret = (strlen(str) > (degree_digits + 2u));
+    if (ret)
+    {
+        // Degrees
+        int32_t degrees = 0;
+        for (size_t i = 0u; ret && (i < degree_digits); i++)
+        {
+            ret     = (str[i] >= '0') && (str[i] <= '9');
+            degrees = degrees * 10 + (str[i] - '0');
+        }
+
+        // Minutes and hemisphere
+        char*        end     = nullptr;
+        const double minutes = strtod(&str[degree_digits], &end);
+        ret                  = ret && (end != &str[degree_digits]) && (minutes < 60.);
+        if (ret)
+        {
+            const double dd = static_cast<double>(degrees) + minutes / 60.;
+            value           = static_cast<int32_t>(std::lround(dd * static_cast<double>(geo::UNITS_PER_DEGREE)));
+            if ((*end == 'S') || (*end == 'W'))
+            {
+                value = -value;
+            }
+            else
+            {
+                ret = (*end == 'N') || (*end == 'E');
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Parse a CUP elevation (1234.5m or 4000ft) */
+int16_t waypoint_db::parse_elevation(const char* str)
+{
+    char*  end       = nullptr;
+    double elevation = strtod(str, &end);
+    if ((end[0u] == 'f') || (end[0u] == 'F'))
+    {
+        elevation *= 0.3048;
+    }
+    return static_cast<int16_t>(std::lround(elevation));
+}
+
+} // namespace ov
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_WAYPOINT_DB_H
+#define OV_WAYPOINT_DB_H
+
+#include "geodesy.h"
+
+#include <cstddef>
+
+namespace ov
+{
+
+/** @brief Waypoint */
+struct waypoint
+{
+    /** @brief Name */
+    char name[16u];
+    /** @brief Position */
+    geo::position position;
+    /** @brief Elevation in meters */
+    int16_t elevation;
+};
+
+/**
+ * @brief Read access to the waypoint database
+ *        Waypoints are stored in a SeeYou CUP file which is scanned sequentially,
+ *        several waypoints can be looked up in a single pass
+ */
+class waypoint_db
+{
+  public:
+    /** @brief Directory to store the navigation files */
+    static constexpr const char* NAVIGATION_DIR = "/navigation";
+    /** @brief Waypoints file */
+    static constexpr const char* WAYPOINTS_FILE = "/navigation/waypoints.cup";
+
+    /**
+     * @brief Look for waypoints by name or code (case insensitive)
+     * @param waypoints Waypoints to look for, the name is used as key and replaced by the waypoint code if any
+     * @param found Indicate for each waypoint if it has been found
+     * @param count Number of waypoints to look for
+     * @return false if the waypoints file cannot be read
+     */
+    static bool find(waypoint* waypoints, bool* found, size_t count);
+
+    /**
+     * @brief Parse a waypoint line of a CUP file
+     * @param line Line to parse (modified during parsing)
+     * @param name Name of the waypoint
+     * @param code Code of the waypoint
+     * @param wp Parsed waypoint
+     * @return true if the line describes a waypoint
+     */
+    static bool parse_line(char* line, const char*& name, const char*& code, waypoint& wp);
+
+  private:
+    /** @brief Parse a CUP coordinate (DDMM.mmmN or DDDMM.mmmE) */
+    static bool parse_coordinate(const char* str, size_t degree_digits, int32_t& value);
+
+    /** @brief Parse a CUP elevation (1234.5m or 4000ft) */
+    static int16_t parse_elevation(const char* str);
+};
+
+} // namespace ov
+
+#endif // OV_WAYPOINT_DB_H
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "glider_polar.h"
+
+namespace ov
+{
+namespace polar
+{
+
+/**
+ * @brief Polar database, indexed by the glider polar settings of the configuration
+ *        The class polars are generic estimates of each certification class, not the polar of a given wing,
+ *        the best glide ratio of their fitted parabola is given for reference.
+ *        The manufacturer polars go through the minimum sink and best glide points of the manufacturer's data sheet,
+ *        their top speed point is extrapolated from the parabola whose vertex is the minimum sink point
+ */
+static const glider_polar POLARS[] = {
+    // 0 : EN-A paraglider class, best glide 8.6 at 36km/h
+    {"EN-A", {30u, 37u, 46u}, {110u, 120u, 190u}},
+    // 1 : EN-B paraglider class, best glide 9.2 at 37km/h
+    {"EN-B", {31u, 38u, 50u}, {105u, 115u, 200u}},
+    // 2 : EN-C paraglider class, best glide 9.9 at 38km/h
+    {"EN-C", {32u, 39u, 54u}, {100u, 110u, 210u}},
+    // 3 : EN-D paraglider class, best glide 10.1 at 40km/h
+    {"EN-D", {33u, 40u, 58u}, {100u, 110u, 230u}},
+    // 4 : CCC competition paraglider class, best glide 10.4 at 41km/h
+    {"CCC", {34u, 42u, 62u}, {100u, 112u, 240u}},
+    // 5 : Topless hang glider class, best glide 14.6 at 50km/h
+    {"Hang glider", {35u, 50u, 80u}, {90u, 95u, 240u}},
+    // 6 : Schleicher ASK 21, data sheet : minimum sink 0.65m/s at 67km/h, best glide 34 at 90km/h
+    {"ASK 21", {67u, 90u, 150u}, {65u, 74u, 182u}},
+    // 7 : Schleicher Ka 8 b, data sheet : minimum sink 0.65m/s at 60km/h, best glide 27 at 73km/h
+    {"Ka 8 b", {60u, 73u, 110u}, {65u, 75u, 213u}}};
+
+/** @brief Get the number of polars in the database */
+size_t get_count()
+{
+    return sizeof(POLARS) / sizeof(POLARS[0]);
+}
+
+/** @brief Get a polar from the database, nullptr if the index is out of range */
+const glider_polar* get(size_t index)
+{
+    const glider_polar* ret = nullptr;
+    if (index < get_count())
+    {
+        ret = &POLARS[index];
+    }
+    return ret;
+}
+
+} // namespace polar
+} // namespace ov
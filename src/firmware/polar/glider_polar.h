@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_GLIDER_POLAR_H
+#define OV_GLIDER_POLAR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Glider polar sampled at 3 speeds, the first one is the minimum flying speed and the last one is the top speed */
+struct glider_polar
+{
+    /** @brief Number of points */
+    static constexpr size_t POINTS_COUNT = 3u;
+
+    /** @brief Name */
+    const char* name;
+    /** @brief Speeds in increasing order (km/h) */
+    uint8_t speeds[POINTS_COUNT];
+    /** @brief Sink rates at each speed (1 = 0.01m/s, positive when sinking) */
+    uint16_t sinks[POINTS_COUNT];
+};
+
+namespace polar
+{
+
+/** @brief Get the number of polars in the database */
+size_t get_count();
+
+/** @brief Get a polar from the database, nullptr if the index is out of range */
+const glider_polar* get(size_t index);
+
+} // namespace polar
+} // namespace ov
+
+#endif // OV_GLIDER_POLAR_H
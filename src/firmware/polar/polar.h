@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_POLAR_H
+#define OV_POLAR_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Speed to fly and final glide computed from the polar of the selected glider */
+struct polar_status
+{
+    /** @brief MacCready setting (1 = 0.1m/s) */
+    uint16_t mac_cready;
+    /** @brief MacCready speed to fly (1 = 0.1m/s) */
+    uint16_t speed_to_fly;
+    /** @brief Vertical speed of the glider in still air at the airspeed used for the netto sink rate (1 = 0.1m/s) */
+    int16_t polar_sink;
+    /** @brief Altitude above goal required to reach it at the speed to fly in still air (1 = 0.1m) */
+    uint32_t final_glide_altitude;
+    /** @brief Indicate if the vertical speed at the current speed is valid */
+    bool is_polar_sink_valid;
+    /** @brief Indicate if the final glide altitude is valid */
+    bool is_final_glide_valid;
+    /** @brief Indicate if the status is valid */
+    bool is_valid;
+};
+
+} // namespace ov
+
+#endif // OV_POLAR_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "speed_to_fly.h"
+
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Constructor */
+speed_to_fly::speed_to_fly() : m_is_valid(false), m_mac_cready_table(), m_sink_table() { }
+
+/** @brief Compute the tables of a polar, return false if the polar is invalid */
+bool speed_to_fly::set_polar(const glider_polar& polar)
+{
+    // Polar points in m/s
+    const float v1 = static_cast<float>(polar.speeds[0u]) / 3.6f;
+    const float v2 = static_cast<float>(polar.speeds[1u]) / 3.6f;
+    const float v3 = static_cast<float>(polar.speeds[2u]) / 3.6f;
+    const float s1 = static_cast<float>(polar.sinks[0u]) / 100.f;
+    const float s2 = static_cast<float>(polar.sinks[1u]) / 100.f;
+    const float s3 = static_cast<float>(polar.sinks[2u]) / 100.f;
+
+    m_is_valid = (v1 < v2) && (v2 < v3) && (v3 < static_cast<float>(MAX_SPEED));
+    if (m_is_valid)
+    {
+        // Sink rate parabola going through the 3 points : sink(v) = a.v² + b.v + c
+        const float d = (v1 - v2) * (v1 - v3) * (v2 - v3);
+        const float a = (v3 * (s2 - s1) + v2 * (s1 - s3) + v1 * (s3 - s2)) / d;
+        const float b = (v3 * v3 * (s1 - s2) + v2 * v2 * (s3 - s1) + v1 * v1 * (s2 - s3)) / d;
+        const float c = (v2 * v3 * (v2 - v3) * s1 + v3 * v1 * (v3 - v1) * s2 + v1 * v2 * (v1 - v2) * s3) / d;
+        m_is_valid    = (a > 0.f) && (c > 0.f);
+        if (m_is_valid)
+        {
+            // The speed to fly minimizes (sink(v) + mc) / v => a.v² = c + mc,
+            // it is bounded by the speed range of the polar
+            for (uint16_t i = 0; i <= MAX_MAC_CREADY; i++)
+            {
+                const float mc              = static_cast<float>(i) / 10.f;
+                const float v               = std::fmin(std::fmax(std::sqrt((c + mc) / a), v1), v3);
+                m_mac_cready_table[i].speed = static_cast<uint16_t>(std::lround(v * 100.f));
+                m_mac_cready_table[i].sink  = static_cast<uint16_t>(std::lround((a * v * v + b * v + c) * 1000.f));
+            }
+
+            // The sink rate is held below the minimum speed of the polar
+            for (uint32_t i = 0; i <= MAX_SPEED; i++)
+            {
+                const float v   = std::fmax(static_cast<float>(i), v1);
+                m_sink_table[i] = static_cast<int16_t>(-std::lround((a * v * v + b * v + c) * 100.f));
+            }
+        }
+    }
+
+    return m_is_valid;
+}
+
+/** @brief Get the MacCready speed to fly (1 = 0.1m/s) for a MacCready setting (1 = 0.1m/s) */
+uint16_t speed_to_fly::get_speed_to_fly(uint16_t mac_cready) const
+{
+    if (mac_cready > MAX_MAC_CREADY)
+    {
+        mac_cready = MAX_MAC_CREADY;
+    }
+    return static_cast<uint16_t>((m_mac_cready_table[mac_cready].speed + 5u) / 10u);
+}
+
+/** @brief Get the vertical speed of the glider in still air (1 = 0.1m/s) at a speed (1 = 0.1m/s) */
+int16_t speed_to_fly::get_sink(uint32_t speed) const
+{
+    // Linear interpolation between the 1m/s steps (1 = 0.001m/s)
+    int32_t sink = m_sink_table[MAX_SPEED] * 10;
+    if (speed < (MAX_SPEED * 10u))
+    {
+        const uint32_t index    = speed / 10u;
+        const int32_t  fraction = static_cast<int32_t>(speed % 10u);
+        sink                    = m_sink_table[index] * 10 + (m_sink_table[index + 1u] - m_sink_table[index]) * fraction;
+    }
+
+    // Rounded to the nearest 0.1m/s
+    sink = (sink >= 0) ? (sink + 50) : (sink - 50);
+    return static_cast<int16_t>(sink / 100);
+}
+
+/**
+ * @brief Get the altitude (1 = 0.1m) required to glide over a distance (m) in still air
+ *        at the speed to fly of a MacCready setting (1 = 0.1m/s)
+ */
+uint32_t speed_to_fly::get_final_glide_altitude(uint32_t distance, uint16_t mac_cready) const
+{
+    uint32_t ret = 0u;
+    if (m_is_valid)
+    {
+        if (mac_cready > MAX_MAC_CREADY)
+        {
+            mac_cready = MAX_MAC_CREADY;
+        }
+        const mac_cready_point& point = m_mac_cready_table[mac_cready];
+        ret                           = static_cast<uint32_t>((static_cast<uint64_t>(distance) * point.sink) / point.speed);
+    }
+    return ret;
+}
+
+} // namespace ov
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_SPEED_TO_FLY_H
+#define OV_SPEED_TO_FLY_H
+
+#include "glider_polar.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Speed to fly computation from a glider polar
+ *        The polar is fitted by a parabola and solved once into tables when it is selected,
+ *        each evaluation is then a table lookup without floating point computation
+ */
+class speed_to_fly
+{
+  public:
+    /** @brief Maximum MacCready setting of the tables (1 = 0.1m/s) */
+    static constexpr uint16_t MAX_MAC_CREADY = 100u;
+    /** @brief Maximum speed of the sink table (m/s), it covers the top speed of the sailplane polars */
+    static constexpr uint32_t MAX_SPEED = 50u;
+
+    /** @brief Constructor */
+    speed_to_fly();
+
+    /** @brief Compute the tables of a polar, return false if the polar is invalid */
+    bool set_polar(const glider_polar& polar);
+
+    /** @brief Indicate if a valid polar has been set */
+    bool is_valid() const { return m_is_valid; }
+
+    /** @brief Invalidate the tables */
+    void reset() { m_is_valid = false; }
+
+    /** @brief Get the MacCready speed to fly (1 = 0.1m/s) for a MacCready setting (1 = 0.1m/s) */
+    uint16_t get_speed_to_fly(uint16_t mac_cready) const;
+
+    /** @brief Get the vertical speed of the glider in still air (1 = 0.1m/s) at a speed (1 = 0.1m/s) */
+    int16_t get_sink(uint32_t speed) const;
+
+    /**
+     * @brief Get the altitude (1 = 0.1m) required to glide over a distance (m) in still air
+     *        at the speed to fly of a MacCready setting (1 = 0.1m/s)
+     */
+    uint32_t get_final_glide_altitude(uint32_t distance, uint16_t mac_cready) const;
+
+  private:
+    /** @brief Point of the MacCready table */
+    struct mac_cready_point
+    {
+        /** @brief Speed to fly (1 = 0.01m/s) */
+        uint16_t speed;
+        /** @brief Sink rate at the speed to fly (1 = 0.001m/s, positive when sinking) */
+        uint16_t sink;
+    };
+
+    /** @brief Indicate if a valid polar has been set */
+    bool m_is_valid;
+    /** @brief Speed to fly and sink rate for each MacCready setting */
+    mac_cready_point m_mac_cready_table[MAX_MAC_CREADY + 1u];
+    /** @brief Vertical speed for each speed in 1m/s steps (1 = 0.01m/s) */
+    int16_t m_sink_table[MAX_SPEED + 1u];
+};
+
+} // namespace ov
+
+#endif // OV_SPEED_TO_FLY_H
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_catalog.h"
+#include "flight_stats_accumulator.h"
+#include "fs.h"
+#include "i_flight_recorder.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Revision of the catalog */
+static uint32_t s_revision = 0u;
+
+/** @brief Constructor, opens the catalog */
+flight_catalog::reader::reader() : m_file(ov::fs::open(CATALOG_FILE, ov::fs::o_rdonly)), m_count(0u)
+{
+    // Check header and compute the number of flights
+    if (m_file.is_open())
+    {
+        header  h        = {};
+        int32_t size     = 0;
+        int32_t offset   = 0;
+        bool    is_valid = m_file.read(h);
+        is_valid         = is_valid && (h.magic == MAGIC_NUMBER) && (h.version == VERSION) && (h.summary_size == sizeof(summary));
+        is_valid         = is_valid && m_file.seek(0, file::seek_end, size);
+        is_valid         = is_valid && (((static_cast<size_t>(size) - sizeof(header)) % sizeof(summary)) == 0u);
+        is_valid         = is_valid && m_file.seek(sizeof(header), file::seek_set, offset);
+        if (is_valid)
+        {
+            m_count = (static_cast<size_t>(size) - sizeof(header)) / sizeof(summary);
+        }
+        else
+        {
+            m_file.close();
+        }
+    }
+}
+
+/** @brief Go to the summary of a flight */
+bool flight_catalog::reader::seek(size_t index)
+{
+    int32_t offset = 0;
+    bool    ret    = (index < m_count);
+    ret            = ret && m_file.seek(static_cast<int32_t>(sizeof(header) + index * sizeof(summary)), file::seek_set, offset);
+    return ret;
+}
+
+/** @brief Read the next flight summary */
+bool flight_catalog::reader::read(summary& flight)
+{
+    return m_file.read(flight);
+}
+
+/** @brief Check the catalog and rebuild it from the flight files if it is missing or corrupt */
+bool flight_catalog::check()
+{
+    // Check header and that all the flights are referenced
+    bool ret = false;
+    {
+        reader catalog;
+        ret = catalog.is_open() && (catalog.get_count() == get_flight_file_count());
+    }
+    if (!ret)
+    {
+        ret = rebuild();
+    }
+
+    return ret;
+}
+
+/** @brief Rebuild the catalog from the flight files */
+bool flight_catalog::rebuild()
+{
+    // The catalog is written to a temporary file which then replaces the current catalog
+    // so that a power loss during the rebuild cannot leave a partial catalog
+    file catalog = ov::fs::open(CATALOG_TMP_FILE, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly);
+    bool ret     = catalog.is_open();
+    if (ret)
+    {
+        header h = {MAGIC_NUMBER, VERSION, sizeof(summary)};
+        ret      = catalog.write(h);
+
+        // Summarize each flight file
+        dir flight_dir = ov::fs::open_dir(i_flight_recorder::RECORDED_DATA_DIR);
+        ret            = ret && flight_dir.is_open();
+        dir::entry entry;
+        while (ret && flight_dir.read(entry))
+        {
+            size_t filename_len = strlen(entry.name);
+            if ((entry.type == dir::entry_type::file) && (filename_len > 4u) &&
+                (strcmp(&entry.name[filename_len - 4u], i_flight_recorder::RECORDED_DATA_EXT) == 0))
+            {
+                summary flight;
+                if (summarize(entry.name, entry.size, flight))
+                {
+                    ret = catalog.write(flight);
+                }
+            }
+        }
+        ret = catalog.close() && ret;
+        ret = ret && ov::fs::rename(CATALOG_TMP_FILE, CATALOG_FILE);
+        s_revision++;
+    }
+
+    return ret;
+}
+
+/** @brief Add a flight to the catalog */
+bool flight_catalog::add(const summary& flight)
+{
+    // Appended data is committed atomically by the filesystem when the file is closed
+    file catalog = ov::fs::open(CATALOG_FILE, ov::fs::o_wronly | ov::fs::o_append);
+    bool ret     = catalog.is_open();
+    if (ret)
+    {
+        ret = catalog.write(flight);
+        ret = catalog.close() && ret;
+        s_revision++;
+    }
+    if (!ret)
+    {
+        // Missing or unwritable catalog, the flight file is already closed and will be part of the new catalog
+        ret = rebuild();
+    }
+
+    return ret;
+}
+
+/** @brief Make the summary of a flight from its header */
+flight_catalog::summary flight_catalog::make_summary(const char* name, uint32_t size, const flight_file::header& header)
+{
+    summary flight = {};
+    strncpy(flight.name, name, sizeof(flight.name) - 1u);
+    strncpy(flight.glider, header.glider, sizeof(flight.glider) - 1u);
+    flight.start = header.timestamp;
+    flight.size  = size;
+    flight.stats = header.stats;
+    return flight;
+}
+
+/** @brief Get the revision of the catalog, incremented on each modification */
+uint32_t flight_catalog::get_revision()
+{
+    return s_revision;
+}
+
+/** @brief Get the number of flight files */
+size_t flight_catalog::get_flight_file_count()
+{
+    size_t count      = 0u;
+    dir    flight_dir = ov::fs::open_dir(i_flight_recorder::RECORDED_DATA_DIR);
+    if (flight_dir.is_open())
+    {
+        dir::entry entry;
+        while (flight_dir.read(entry))
+        {
+            size_t filename_len = strlen(entry.name);
+            if ((entry.type == dir::entry_type::file) && (filename_len > 4u) &&
+                (strcmp(&entry.name[filename_len - 4u], i_flight_recorder::RECORDED_DATA_EXT) == 0))
+            {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/** @brief Compute the summary of a flight file */
+bool flight_catalog::summarize(const char* name, uint32_t size, summary& flight)
+{
+    char path[64u];
+    snprintf(path, sizeof(path), "%s/%s", i_flight_recorder::RECORDED_DATA_DIR, name);
+
+    flight_file f(path);
+    bool        ret = f.is_open();
+    if (ret)
+    {
+        flight = make_summary(name, size, f.get_header());
+        if (!flight.stats.is_valid)
+        {
+            // Legacy or interrupted recording, compute the statistics from the entries
+            flight_stats_accumulator accumulator;
+            flight_file::entry       entry;
+            accumulator.reset(f.get_header().period);
+            while (f.read(entry))
+            {
+                accumulator.add(entry);
+            }
+            flight.stats = accumulator.get_stats();
+        }
+        f.close();
+    }
+
+    return ret;
+}
+
+} // namespace ov
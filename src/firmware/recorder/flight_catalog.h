@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_CATALOG_H
+#define OV_FLIGHT_CATALOG_H
+
+#include "date_time.h"
+#include "file.h"
+#include "flight_file.h"
+#include "flight_stats.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Index of the recorded flights with a summary of each flight */
+class flight_catalog
+{
+  public:
+    /** @brief Flight summary */
+    struct summary
+    {
+        /** @brief Name of the flight file (without directory) */
+        char name[32u];
+        /** @brief Glider */
+        char glider[32u];
+        /** @brief Start of the flight */
+        date_time start;
+        /** @brief Size of the flight file in bytes */
+        uint32_t size;
+        /** @brief Flight statistics */
+        flight_stats stats;
+    };
+
+    /** @brief Sequential reader of the catalog */
+    class reader
+    {
+      public:
+        /** @brief Constructor, opens the catalog */
+        reader();
+
+        /** @brief Indicate if the catalog is open */
+        bool is_open() const { return m_file.is_open(); }
+
+        /** @brief Get the number of flights in the catalog */
+        size_t get_count() const { return m_count; }
+
+        /** @brief Go to the summary of a flight */
+        bool seek(size_t index);
+
+        /** @brief Read the next flight summary */
+        bool read(summary& flight);
+
+      private:
+        /** @brief Catalog file */
+        file m_file;
+        /** @brief Number of flights in the catalog */
+        size_t m_count;
+    };
+
+    /** @brief Check the catalog and rebuild it from the flight files if it is missing or corrupt */
+    static bool check();
+
+    /** @brief Rebuild the catalog from the flight files */
+    static bool rebuild();
+
+    /** @brief Add a flight to the catalog */
+    static bool add(const summary& flight);
+
+    /** @brief Make the summary of a flight from its header */
+    static summary make_summary(const char* name, uint32_t size, const flight_file::header& header);
+
+    /** @brief Get the revision of the catalog, incremented on each modification */
+    static uint32_t get_revision();
+
+    /** @brief Catalog file */
+    static constexpr const char* CATALOG_FILE = "/flights/catalog.idx";
+    /** @brief Temporary file used during a rebuild */
+    static constexpr const char* CATALOG_TMP_FILE = "/flights/catalog.tmp";
+
+  private:
+    /** @brief Catalog header */
+    struct header
+    {
+        /** @brief Magic number */
+        uint32_t magic;
+        /** @brief Version of the catalog format */
+        uint16_t version;
+        /** @brief Size of a summary */
+        uint16_t summary_size;
+    };
+
+    /** @brief Magic number value */
+    static constexpr uint32_t MAGIC_NUMBER = 0xCA7A1065u;
+    /** @brief Version of the catalog format */
+    static constexpr uint16_t VERSION = 2u;
+
+    /** @brief Get the number of flight files */
+    static size_t get_flight_file_count();
+
+    /** @brief Compute the summary of a flight file */
+    static bool summarize(const char* name, uint32_t size, summary& flight);
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_CATALOG_H
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_detector.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace ov
+{
+
+/** @brief Constructor */
+flight_detector::flight_detector()
+    : m_is_flying(false), m_duration(0u), m_accel_activity(1.f), m_reference_is_valid(false), m_reference_altitude(0.f)
+{
+}
+
+/** @brief Restart the detection, on ground or in flight */
+void flight_detector::reset(bool is_flying)
+{
+    m_is_flying = is_flying;
+    m_duration  = 0u;
+    m_accel_activity.reset();
+    m_reference_is_valid = false;
+}
+
+/** @brief Process a new flight entry sampled with the specified period in milliseconds */
+flight_detector::event flight_detector::update(const flight_file::entry& entry, uint32_t period)
+{
+    event ret = event::none;
+
+    // Accelerometer activity
+    int16_t activity = 0;
+    if (entry.accel_is_valid)
+    {
+        m_accel_activity.set_alpha(
+            ema_filter<int16_t>::alpha_from_time_constant(static_cast<float>(period), static_cast<float>(ACCEL_TIME_CONSTANT)));
+        activity = m_accel_activity.add_value(static_cast<int16_t>(abs(entry.total_accel - 1000)));
+    }
+
+    if (!m_is_flying)
+    {
+        // Takeoff when moving fast enough, when climbing/sinking significantly or when away from the launch altitude
+        const bool is_moving   = entry.gnss_is_valid && (entry.speed >= TAKEOFF_SPEED);
+        const bool is_vertical = entry.alti_is_valid && (abs(entry.sink_rate) >= TAKEOFF_VERTICAL_SPEED);
+        const bool is_away     = update_reference(entry, period);
+        if (is_moving || is_vertical || is_away)
+        {
+            m_duration += period;
+            if (m_duration >= TAKEOFF_DURATION)
+            {
+                m_is_flying = true;
+                m_duration  = 0u;
+                ret         = event::takeoff;
+            }
+        }
+        else
+        {
+            m_duration = 0u;
+        }
+    }
+    else
+    {
+        // Landing when slow, without vertical speed and at rest
+        const bool is_slow   = !entry.gnss_is_valid || (entry.speed <= LANDING_SPEED);
+        const bool is_level  = !entry.alti_is_valid || (abs(entry.sink_rate) <= LANDING_VERTICAL_SPEED);
+        const bool is_steady = !entry.accel_is_valid || (activity <= LANDING_ACCEL_ACTIVITY);
+        if (is_slow && is_level && is_steady && (entry.gnss_is_valid || entry.alti_is_valid))
+        {
+            m_duration += period;
+            if (m_duration >= LANDING_DURATION)
+            {
+                m_is_flying          = false;
+                m_duration           = 0u;
+                m_reference_is_valid = false;
+                ret                  = event::landing;
+            }
+        }
+        else
+        {
+            m_duration = 0u;
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Update the launch reference altitude and indicate if the altitude has moved away from it */
+bool flight_detector::update_reference(const flight_file::entry& entry, uint32_t period)
+{
+    bool ret = false;
+
+    if (entry.alti_is_valid)
+    {
+        const float altitude = static_cast<float>(entry.altitude);
+        if (m_reference_is_valid)
+        {
+            // Follow the altitude at a bounded rate
+            const float max_step = static_cast<float>(REFERENCE_RATE * static_cast<int32_t>(period)) / 1000.f;
+            const float delta    = altitude - m_reference_altitude;
+            if (delta > max_step)
+            {
+                m_reference_altitude += max_step;
+            }
+            else if (delta < -max_step)
+            {
+                m_reference_altitude -= max_step;
+            }
+            else
+            {
+                m_reference_altitude = altitude;
+            }
+            ret = (std::fabs(altitude - m_reference_altitude) >= static_cast<float>(TAKEOFF_HEIGHT));
+        }
+        else
+        {
+            m_reference_altitude = altitude;
+            m_reference_is_valid = true;
+        }
+    }
+
+    return ret;
+}
+
+} // namespace ov
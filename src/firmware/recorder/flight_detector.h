@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_DETECTOR_H
+#define OV_FLIGHT_DETECTOR_H
+
+#include "ema_filter.h"
+#include "flight_file.h"
+
+namespace ov
+{
+
+/**
+ * @brief Detect takeoffs and landings from the GNSS speed, the vertical speed and the accelerometer activity
+ *        A sustained altitude change from the launch reference is also a takeoff evidence, it detects the launches
+ *        into a strong wind where neither the ground speed nor the bumpy ridge lift meet the takeoff conditions
+ */
+class flight_detector
+{
+  public:
+    /** @brief Detection event */
+    enum class event
+    {
+        /** @brief Nothing detected */
+        none,
+        /** @brief Takeoff detected */
+        takeoff,
+        /** @brief Landing detected */
+        landing
+    };
+
+    /** @brief Constructor */
+    flight_detector();
+
+    /** @brief Restart the detection, on ground or in flight */
+    void reset(bool is_flying);
+
+    /** @brief Indicate if the glider is considered flying */
+    bool is_flying() const { return m_is_flying; }
+
+    /** @brief Process a new flight entry sampled with the specified period in milliseconds */
+    event update(const flight_file::entry& entry, uint32_t period);
+
+    /** @brief Minimum GNSS speed to consider a takeoff (1 = 0.1m/s) */
+    static constexpr uint32_t TAKEOFF_SPEED = 40u;
+    /** @brief Minimum vertical speed magnitude to consider a takeoff (1 = 0.1m/s) */
+    static constexpr int16_t TAKEOFF_VERTICAL_SPEED = 15;
+    /** @brief Minimum altitude change from the launch reference to consider a takeoff (1 = 0.1m) */
+    static constexpr int32_t TAKEOFF_HEIGHT = 300;
+    /**
+     * @brief Maximum rate at which the launch reference follows the altitude on ground (1 = 0.1m/s)
+     *        Hiking and pressure drifts are slower and do not move away from the reference
+     */
+    static constexpr int32_t REFERENCE_RATE = 3;
+    /** @brief Duration of the takeoff conditions before triggering in milliseconds */
+    static constexpr uint32_t TAKEOFF_DURATION = 10000u;
+    /** @brief Maximum GNSS speed to consider a landing (1 = 0.1m/s) */
+    static constexpr uint32_t LANDING_SPEED = 15u;
+    /** @brief Maximum vertical speed magnitude to consider a landing (1 = 0.1m/s) */
+    static constexpr int16_t LANDING_VERTICAL_SPEED = 5;
+    /** @brief Maximum accelerometer activity to consider a landing (1000 = 1g) */
+    static constexpr int16_t LANDING_ACCEL_ACTIVITY = 100;
+    /** @brief Duration of the landing conditions before triggering in milliseconds */
+    static constexpr uint32_t LANDING_DURATION = 60000u;
+    /** @brief Time constant of the accelerometer activity smoothing in milliseconds */
+    static constexpr uint32_t ACCEL_TIME_CONSTANT = 5000u;
+
+  private:
+    /** @brief Indicate if the glider is considered flying */
+    bool m_is_flying;
+    /** @brief Duration of the conditions for a state change in milliseconds */
+    uint32_t m_duration;
+    /** @brief Smoothed accelerometer activity (deviation from 1g) */
+    ema_filter<int16_t> m_accel_activity;
+    /** @brief Indicate if the launch reference altitude is valid */
+    bool m_reference_is_valid;
+    /** @brief Launch reference altitude (1 = 0.1m) */
+    float m_reference_altitude;
+
+    /** @brief Update the launch reference altitude and indicate if the altitude has moved away from it */
+    bool update_reference(const flight_file::entry& entry, uint32_t period);
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_DETECTOR_H
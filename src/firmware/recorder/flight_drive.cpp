@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_drive.h"
+#include "fs.h"
+#include "i_flight_recorder.h"
+#include "text_writer.h"
+
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Volume label */
+static const char VOLUME_LABEL[] = "OPENVARIO  ";
+/** @brief Volume serial number */
+static constexpr uint32_t VOLUME_ID = 0x4F564F56u;
+/** @brief Read-only file attribute */
+static constexpr uint8_t ATTR_READ_ONLY = 0x01u;
+/** @brief Volume label attribute */
+static constexpr uint8_t ATTR_VOLUME_ID = 0x08u;
+/** @brief Long file name entry attribute */
+static constexpr uint8_t ATTR_LONG_NAME = 0x0Fu;
+/** @brief Flag of the last long file name entry of a file */
+static constexpr uint8_t LFN_LAST_ENTRY = 0x40u;
+/** @brief Offsets of the characters in a long file name entry */
+static const uint8_t LFN_OFFSETS[] = {1u, 3u, 5u, 7u, 9u, 14u, 16u, 18u, 20u, 22u, 24u, 28u, 30u};
+/** @brief IGC file extension */
+static const char IGC_EXT[] = ".igc";
+
+/** @brief Store a 16 bits value in little endian */
+static void set_u16(uint8_t* data, uint16_t value)
+{
+    data[0u] = static_cast<uint8_t>(value);
+    data[1u] = static_cast<uint8_t>(value >> 8u);
+}
+
+/** @brief Store a 32 bits value in little endian */
+static void set_u32(uint8_t* data, uint32_t value)
+{
+    set_u16(data, static_cast<uint16_t>(value));
+    set_u16(&data[2u], static_cast<uint16_t>(value >> 16u));
+}
+
+/** @brief Constructor */
+flight_drive::flight_drive()
+    : m_flights{},
+      m_count(0u),
+      m_next_entry(1u),
+      m_next_cluster(FIRST_CLUSTER),
+      m_flight(),
+      m_igc(m_flight),
+      m_igc_index(MAX_FLIGHTS),
+      m_rec(),
+      m_rec_index(MAX_FLIGHTS)
+{
+}
+
+/** @brief Take the snapshot of the recorded flights */
+bool flight_drive::init()
+{
+    // The first directory entry is the volume label
+    m_count        = 0u;
+    m_next_entry   = 1u;
+    m_next_cluster = FIRST_CLUSTER;
+    m_igc_index    = MAX_FLIGHTS;
+    m_rec_index    = MAX_FLIGHTS;
+
+    flight_catalog::reader catalog;
+    bool                   ret     = catalog.is_open();
+    bool                   is_full = false;
+    for (size_t i = 0u; ret && !is_full && (i < catalog.get_count()) && (m_count < MAX_FLIGHTS); i++)
+    {
+        flight_catalog::summary summary;
+        ret = catalog.read(summary);
+        if (ret)
+        {
+            flight& f       = m_flights[m_count];
+            f.catalog_index = static_cast<uint16_t>(i);
+            f.first_entry   = static_cast<uint16_t>(m_next_entry);
+
+            // Compute the size of the files from the flight file
+            char path[64u];
+            if (make_path(summary, path) && m_flight.open(path) && m_igc.init())
+            {
+                char rec_name[32u];
+                char igc_name[32u];
+                get_names(summary, rec_name, igc_name);
+                f.files[static_cast<uint8_t>(kind::rec)] = {0u, m_flight.get_size(), get_entry_count(rec_name)};
+                f.files[static_cast<uint8_t>(kind::igc)] = {0u, m_igc.get_size(), get_entry_count(igc_name)};
+
+                // Allocate the directory entries and the clusters
+                uint32_t entry_count  = m_next_entry;
+                uint32_t next_cluster = m_next_cluster;
+                for (file_desc& desc : f.files)
+                {
+                    uint32_t cluster_count = (desc.size + CLUSTER_SIZE - 1u) / CLUSTER_SIZE;
+                    if (cluster_count != 0u)
+                    {
+                        desc.cluster = next_cluster;
+                    }
+                    next_cluster += cluster_count;
+                    entry_count += desc.entry_count;
+                }
+                is_full = (entry_count > ROOT_ENTRIES) || (next_cluster > (FIRST_CLUSTER + CLUSTER_COUNT));
+                if (!is_full)
+                {
+                    m_next_entry   = entry_count;
+                    m_next_cluster = next_cluster;
+                    m_count++;
+                }
+            }
+        }
+    }
+    m_flight.close();
+
+    return ret;
+}
+
+/** @brief Read consecutive blocks, called from the USB driver's thread */
+bool flight_drive::read(uint32_t block, void* buffer, uint32_t count)
+{
+    bool     ret    = ((block + count) <= TOTAL_SECTORS);
+    uint8_t* sector = reinterpret_cast<uint8_t*>(buffer);
+    while (ret && (count != 0u))
+    {
+        uint32_t read_count = 1u;
+        if (block < FAT_START)
+        {
+            read_boot_sector(sector);
+        }
+        else if (block < ROOT_START)
+        {
+            // Both FATs have the same content
+            read_fat_sector((block - FAT_START) % FAT_SECTORS, sector);
+        }
+        else if (block < DATA_START)
+        {
+            read_root_sector(block - ROOT_START, sector);
+        }
+        else
+        {
+            read_count = read_data_sectors(block - DATA_START, sector, count, ret);
+        }
+        block += read_count;
+        sector += read_count * SECTOR_SIZE;
+        count -= read_count;
+    }
+
+    return ret;
+}
+
+/** @brief Read the boot sector */
+void flight_drive::read_boot_sector(uint8_t* sector)
+{
+    memset(sector, 0, SECTOR_SIZE);
+
+    // Jump instruction and OEM name
+    sector[0u] = 0xEBu;
+    sector[1u] = 0x3Cu;
+    sector[2u] = 0x90u;
+    memcpy(&sector[3u], "MSDOS5.0", 8u);
+
+    // BIOS parameter block
+    set_u16(&sector[11u], static_cast<uint16_t>(SECTOR_SIZE));
+    sector[13u] = static_cast<uint8_t>(SECTORS_PER_CLUSTER);
+    set_u16(&sector[14u], static_cast<uint16_t>(FAT_START));
+    sector[16u] = 2u;
+    set_u16(&sector[17u], static_cast<uint16_t>(ROOT_ENTRIES));
+    sector[21u] = 0xF8u;
+    set_u16(&sector[22u], static_cast<uint16_t>(FAT_SECTORS));
+    set_u16(&sector[24u], 63u);
+    set_u16(&sector[26u], 255u);
+    set_u32(&sector[32u], TOTAL_SECTORS);
+
+    // Extended boot record
+    sector[36u] = 0x80u;
+    sector[38u] = 0x29u;
+    set_u32(&sector[39u], VOLUME_ID);
+    memcpy(&sector[43u], VOLUME_LABEL, 11u);
+    memcpy(&sector[54u], "FAT16   ", 8u);
+
+    // Signature
+    sector[510u] = 0x55u;
+    sector[511u] = 0xAAu;
+}
+
+/** @brief Read a sector of the FAT */
+void flight_drive::read_fat_sector(uint32_t fat_sector, uint8_t* sector)
+{
+    // The clusters of each file are contiguous, each entry points to the next cluster
+    constexpr uint32_t ENTRIES_PER_SECTOR = SECTOR_SIZE / sizeof(uint16_t);
+    uint32_t           first_cluster      = fat_sector * ENTRIES_PER_SECTOR;
+    for (uint32_t i = 0u; i < ENTRIES_PER_SECTOR; i++)
+    {
+        uint32_t cluster = first_cluster + i;
+        uint16_t value   = 0u;
+        if (cluster == 0u)
+        {
+            value = 0xFFF8u;
+        }
+        else if (cluster < FIRST_CLUSTER)
+        {
+            value = 0xFFFFu;
+        }
+        else if (cluster < m_next_cluster)
+        {
+            value = static_cast<uint16_t>(cluster + 1u);
+        }
+        set_u16(&sector[i * sizeof(uint16_t)], value);
+    }
+
+    // Mark the end of the files
+    uint32_t last_cluster = first_cluster + ENTRIES_PER_SECTOR;
+    for (size_t i = 0u; i < m_count; i++)
+    {
+        for (const file_desc& desc : m_flights[i].files)
+        {
+            uint32_t end_cluster = desc.cluster + (desc.size + CLUSTER_SIZE - 1u) / CLUSTER_SIZE - 1u;
+            if ((desc.size != 0u) && (end_cluster >= first_cluster) && (end_cluster < last_cluster))
+            {
+                set_u16(&sector[(end_cluster - first_cluster) * sizeof(uint16_t)], 0xFFFFu);
+            }
+        }
+    }
+}
+
+/** @brief Read a sector of the root directory */
+void flight_drive::read_root_sector(uint32_t root_sector, uint8_t* sector)
+{
+    memset(sector, 0, SECTOR_SIZE);
+
+    uint32_t entry      = root_sector * DIR_ENTRIES_PER_SECTOR;
+    uint32_t last_entry = entry + DIR_ENTRIES_PER_SECTOR;
+    if (entry == 0u)
+    {
+        // Volume label
+        memcpy(sector, VOLUME_LABEL, 11u);
+        sector[11u] = ATTR_VOLUME_ID;
+        entry++;
+    }
+    if (last_entry > m_next_entry)
+    {
+        last_entry = m_next_entry;
+    }
+
+    // Flight entries, the summaries are read from the catalog
+    flight_catalog::reader  catalog;
+    flight_catalog::summary summary  = {};
+    size_t                  index    = 0u;
+    bool                    is_valid = false;
+    while (entry < last_entry)
+    {
+        while (((index + 1u) < m_count) && (m_flights[index + 1u].first_entry <= entry))
+        {
+            index++;
+            is_valid = false;
+        }
+        const flight& f = m_flights[index];
+        if (!is_valid)
+        {
+            is_valid = catalog.seek(f.catalog_index) && catalog.read(summary);
+        }
+        if (is_valid)
+        {
+            write_dir_entry(f, summary, entry - f.first_entry, &sector[(entry % DIR_ENTRIES_PER_SECTOR) * DIR_ENTRY_SIZE]);
+        }
+        entry++;
+    }
+}
+
+/** @brief Read consecutive sectors of the data region, return the number of sectors which have been read */
+uint32_t flight_drive::read_data_sectors(uint32_t data_sector, uint8_t* buffer, uint32_t count, bool& success)
+{
+    uint32_t read_count = 1u;
+    uint32_t cluster    = FIRST_CLUSTER + data_sector / SECTORS_PER_CLUSTER;
+
+    // Look for the file containing the cluster
+    const file_desc* desc  = nullptr;
+    size_t           index = 0u;
+    kind             k     = kind::rec;
+    for (size_t i = 0u; (desc == nullptr) && (i < m_count) && (cluster < m_next_cluster); i++)
+    {
+        for (uint8_t j = 0u; j < 2u; j++)
+        {
+            const file_desc& d = m_flights[i].files[j];
+            if ((d.size != 0u) && (cluster >= d.cluster) && (cluster < (d.cluster + (d.size + CLUSTER_SIZE - 1u) / CLUSTER_SIZE)))
+            {
+                desc  = &d;
+                index = i;
+                k     = static_cast<kind>(j);
+            }
+        }
+    }
+
+    if (desc != nullptr)
+    {
+        // Read all the requested sectors belonging to the file at once
+        uint32_t offset     = (data_sector - (desc->cluster - FIRST_CLUSTER) * SECTORS_PER_CLUSTER) * SECTOR_SIZE;
+        uint32_t end_offset = ((desc->size + CLUSTER_SIZE - 1u) / CLUSTER_SIZE) * CLUSTER_SIZE;
+        read_count          = (end_offset - offset) / SECTOR_SIZE;
+        if (read_count > count)
+        {
+            read_count = count;
+        }
+        size_t size = read_count * SECTOR_SIZE;
+
+        char path[64u];
+        if (k == kind::rec)
+        {
+            // Raw flight file
+            if (m_rec_index != index)
+            {
+                m_rec_index = MAX_FLIGHTS;
+                if (get_path(m_flights[index], path) && fs::open(m_rec, path, fs::o_rdonly))
+                {
+                    m_rec_index = index;
+                }
+            }
+            // The unused tail of the last cluster is read as zeros
+            size_t  data_count = 0u;
+            int32_t new_offset = 0;
+            success            = (m_rec_index == index);
+            if (success && (offset < desc->size))
+            {
+                success = m_rec.seek(static_cast<int32_t>(offset), file::seek_set, new_offset);
+                success = success && m_rec.read(buffer, size, data_count);
+            }
+            if (success)
+            {
+                memset(&buffer[data_count], 0, size - data_count);
+            }
+        }
+        else
+        {
+            // IGC file generated from the flight file
+            if (m_igc_index != index)
+            {
+                m_igc_index = MAX_FLIGHTS;
+                if (get_path(m_flights[index], path) && m_flight.open(path) && m_igc.init())
+                {
+                    m_igc_index = index;
+                }
+            }
+            success = (m_igc_index == index) && m_igc.read(offset, buffer, size);
+        }
+    }
+    else
+    {
+        // Unused cluster
+        memset(buffer, 0, SECTOR_SIZE);
+    }
+
+    return read_count;
+}
+
+/** @brief Write a directory entry of a flight */
+void flight_drive::write_dir_entry(const flight& f, const flight_catalog::summary& summary, uint32_t entry, uint8_t* dir_entry)
+{
+    char names[2u][32u];
+    get_names(summary, names[0u], names[1u]);
+
+    // Look for the file of the entry
+    uint8_t file_index = 0u;
+    if (entry >= f.files[0u].entry_count)
+    {
+        entry -= f.files[0u].entry_count;
+        file_index = 1u;
+    }
+    const file_desc& desc = f.files[file_index];
+
+    // Short file name : FLTnnnnn.REC or FLTnnnnn.IGC
+    char        short_name[12u];
+    text_writer writer(short_name);
+    writer.write("FLT").write_int(static_cast<uint32_t>(&f - m_flights) + 1u, 5u).write((file_index == 0u) ? "REC" : "IGC");
+
+    uint8_t lfn_count = desc.entry_count - 1u;
+    if (entry < lfn_count)
+    {
+        // Long file name entries are stored in reverse order
+        uint8_t checksum = 0u;
+        for (size_t i = 0u; i < 11u; i++)
+        {
+            checksum = static_cast<uint8_t>(((checksum & 1u) << 7u) + (checksum >> 1u) + static_cast<uint8_t>(short_name[i]));
+        }
+        const char* name     = names[file_index];
+        size_t      length   = strlen(name);
+        uint8_t     sequence = static_cast<uint8_t>(lfn_count - entry);
+        dir_entry[0u]        = (entry == 0u) ? (sequence | LFN_LAST_ENTRY) : sequence;
+        dir_entry[11u]       = ATTR_LONG_NAME;
+        dir_entry[13u]       = checksum;
+        for (size_t i = 0u; i < LFN_CHARS; i++)
+        {
+            size_t   pos = (sequence - 1u) * LFN_CHARS + i;
+            uint16_t c   = 0xFFFFu;
+            if (pos < length)
+            {
+                c = static_cast<uint8_t>(name[pos]);
+            }
+            else if (pos == length)
+            {
+                c = 0u;
+            }
+            set_u16(&dir_entry[LFN_OFFSETS[i]], c);
+        }
+    }
+    else
+    {
+        // Short file name entry, dated with the start of the flight
+        const date_time& start = summary.start;
+        uint16_t         date  = static_cast<uint16_t>(((start.year + 20u) << 9u) | (start.month << 5u) | start.day);
+        uint16_t         time  = static_cast<uint16_t>((start.hour << 11u) | (start.minute << 5u) | (start.second / 2u));
+        memcpy(dir_entry, short_name, 11u);
+        dir_entry[11u] = ATTR_READ_ONLY;
+        set_u16(&dir_entry[14u], time);
+        set_u16(&dir_entry[16u], date);
+        set_u16(&dir_entry[18u], date);
+        set_u16(&dir_entry[22u], time);
+        set_u16(&dir_entry[24u], date);
+        set_u16(&dir_entry[26u], static_cast<uint16_t>(desc.cluster));
+        set_u32(&dir_entry[28u], desc.size);
+    }
+}
+
+/** @brief Get the path of the flight file of a flight */
+bool flight_drive::get_path(const flight& f, char (&path)[64u])
+{
+    flight_catalog::reader  catalog;
+    flight_catalog::summary summary;
+    bool                    ret = catalog.seek(f.catalog_index) && catalog.read(summary);
+    ret                         = ret && make_path(summary, path);
+    return ret;
+}
+
+/** @brief Make the path of the flight file of a flight from its summary */
+bool flight_drive::make_path(const flight_catalog::summary& summary, char (&path)[64u])
+{
+    char name[sizeof(summary.name)];
+    memcpy(name, summary.name, sizeof(name));
+    name[sizeof(name) - 1u] = 0;
+
+    text_writer writer(path);
+    writer.write(i_flight_recorder::RECORDED_DATA_DIR).write('/').write(name);
+    return !writer.is_truncated();
+}
+
+/** @brief Get the file names of a flight */
+void flight_drive::get_names(const flight_catalog::summary& summary, char (&rec_name)[32u], char (&igc_name)[32u])
+{
+    memcpy(rec_name, summary.name, sizeof(rec_name));
+    rec_name[sizeof(rec_name) - 1u] = 0;
+
+    // The IGC file replaces the extension of the flight file
+    size_t length     = strlen(rec_name);
+    size_t ext_length = strlen(i_flight_recorder::RECORDED_DATA_EXT);
+    if ((length >= ext_length) && (strcmp(&rec_name[length - ext_length], i_flight_recorder::RECORDED_DATA_EXT) == 0))
+    {
+        length -= ext_length;
+    }
+    if ((length + sizeof(IGC_EXT)) > sizeof(igc_name))
+    {
+        length = sizeof(igc_name) - sizeof(IGC_EXT);
+    }
+    memcpy(igc_name, rec_name, length);
+    memcpy(&igc_name[length], IGC_EXT, sizeof(IGC_EXT));
+}
+
+/** @brief Get the number of directory entries of a file */
+uint8_t flight_drive::get_entry_count(const char* name)
+{
+    // Long file name entries and short file name entry
+    return static_cast<uint8_t>((strlen(name) + LFN_CHARS - 1u) / LFN_CHARS + 1u);
+}
+
+} // namespace ov
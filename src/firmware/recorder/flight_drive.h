@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_DRIVE_H
+#define OV_FLIGHT_DRIVE_H
+
+#include "file.h"
+#include "flight_catalog.h"
+#include "flight_file.h"
+#include "i_usb_msc.h"
+#include "igc_converter.h"
+
+namespace ov
+{
+
+/**
+ * @brief Read-only FAT16 volume exposing the recorded flights over USB mass storage
+ *        The volume is generated on the fly from a snapshot of the flight catalog taken at initialization,
+ *        each flight is exposed as its flight file and as an IGC file stored in contiguous clusters
+ */
+class flight_drive : public i_usb_msc::i_storage
+{
+  public:
+    /** @brief Maximum number of flights exposed on the volume */
+    static constexpr size_t MAX_FLIGHTS = 128u;
+
+    /** @brief Constructor */
+    flight_drive();
+
+    /** @brief Take the snapshot of the recorded flights */
+    bool init();
+
+    /** @brief Get the number of blocks of the storage */
+    uint32_t get_block_count() override { return TOTAL_SECTORS; }
+
+    /** @brief Read consecutive blocks, called from the USB driver's thread */
+    bool read(uint32_t block, void* buffer, uint32_t count) override;
+
+  private:
+    /** @brief Size of a sector in bytes */
+    static constexpr uint32_t SECTOR_SIZE = i_usb_msc::BLOCK_SIZE;
+    /** @brief Number of sectors per cluster */
+    static constexpr uint32_t SECTORS_PER_CLUSTER = 8u;
+    /** @brief Size of a cluster in bytes */
+    static constexpr uint32_t CLUSTER_SIZE = SECTOR_SIZE * SECTORS_PER_CLUSTER;
+    /** @brief Number of data clusters */
+    static constexpr uint32_t CLUSTER_COUNT = 32768u;
+    /** @brief First data cluster */
+    static constexpr uint32_t FIRST_CLUSTER = 2u;
+    /** @brief Number of root directory entries */
+    static constexpr uint32_t ROOT_ENTRIES = 2048u;
+    /** @brief Size of a directory entry in bytes */
+    static constexpr uint32_t DIR_ENTRY_SIZE = 32u;
+    /** @brief Number of directory entries per sector */
+    static constexpr uint32_t DIR_ENTRIES_PER_SECTOR = SECTOR_SIZE / DIR_ENTRY_SIZE;
+    /** @brief Number of sectors of a FAT */
+    static constexpr uint32_t FAT_SECTORS = ((CLUSTER_COUNT + FIRST_CLUSTER) * sizeof(uint16_t) + SECTOR_SIZE - 1u) / SECTOR_SIZE;
+    /** @brief First sector of the FATs */
+    static constexpr uint32_t FAT_START = 1u;
+    /** @brief First sector of the root directory */
+    static constexpr uint32_t ROOT_START = FAT_START + 2u * FAT_SECTORS;
+    /** @brief First sector of the data region */
+    static constexpr uint32_t DATA_START = ROOT_START + (ROOT_ENTRIES * DIR_ENTRY_SIZE) / SECTOR_SIZE;
+    /** @brief Total number of sectors */
+    static constexpr uint32_t TOTAL_SECTORS = DATA_START + CLUSTER_COUNT * SECTORS_PER_CLUSTER;
+    /** @brief Number of characters of a file name stored in a long file name entry */
+    static constexpr size_t LFN_CHARS = 13u;
+
+    /** @brief File kinds of a flight */
+    enum class kind : uint8_t
+    {
+        /** @brief Flight file */
+        rec,
+        /** @brief IGC file */
+        igc
+    };
+
+    /** @brief Location of a file on the volume */
+    struct file_desc
+    {
+        /** @brief First cluster (0 if the file is empty) */
+        uint32_t cluster;
+        /** @brief Size in bytes */
+        uint32_t size;
+        /** @brief Number of directory entries */
+        uint8_t entry_count;
+    };
+
+    /** @brief Flight exposed on the volume */
+    struct flight
+    {
+        /** @brief Index of the flight in the catalog */
+        uint16_t catalog_index;
+        /** @brief First directory entry of the flight */
+        uint16_t first_entry;
+        /** @brief Files of the flight */
+        file_desc files[2u];
+    };
+
+    /** @brief Flights exposed on the volume */
+    flight m_flights[MAX_FLIGHTS];
+    /** @brief Number of flights exposed on the volume */
+    size_t m_count;
+    /** @brief First unused directory entry */
+    uint32_t m_next_entry;
+    /** @brief First unused cluster */
+    uint32_t m_next_cluster;
+    /** @brief Opened flight file used to generate the IGC files */
+    flight_file m_flight;
+    /** @brief IGC converter of the opened flight file */
+    igc_converter m_igc;
+    /** @brief Index of the flight whose flight file is opened in m_flight */
+    size_t m_igc_index;
+    /** @brief Opened flight file used to read the raw flight data */
+    file m_rec;
+    /** @brief Index of the flight whose flight file is opened in m_rec */
+    size_t m_rec_index;
+
+    /** @brief Read the boot sector */
+    void read_boot_sector(uint8_t* sector);
+    /** @brief Read a sector of the FAT */
+    void read_fat_sector(uint32_t fat_sector, uint8_t* sector);
+    /** @brief Read a sector of the root directory */
+    void read_root_sector(uint32_t root_sector, uint8_t* sector);
+    /** @brief Read consecutive sectors of the data region, return the number of sectors which have been read */
+    uint32_t read_data_sectors(uint32_t data_sector, uint8_t* buffer, uint32_t count, bool& success);
+    /** @brief Write a directory entry of a flight */
+    void write_dir_entry(const flight& f, const flight_catalog::summary& summary, uint32_t entry, uint8_t* dir_entry);
+
+    /** @brief Get the path of the flight file of a flight */
+    static bool get_path(const flight& f, char (&path)[64u]);
+    /** @brief Make the path of the flight file of a flight from its summary */
+    static bool make_path(const flight_catalog::summary& summary, char (&path)[64u]);
+    /** @brief Get the file names of a flight */
+    static void get_names(const flight_catalog::summary& summary, char (&rec_name)[32u], char (&igc_name)[32u]);
+    /** @brief Get the number of directory entries of a file */
+    static uint8_t get_entry_count(const char* name);
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_DRIVE_H
@@ -6,21 +6,34 @@
 #include "flight_file.h"
 #include "fs.h"
 
+#include <cstddef>
+
 namespace ov
 {
 
+/** @brief Default constructor, the file is closed */
+flight_file::flight_file() : m_header{}, m_file(), m_data_offset(0u)
+{
+}
+
 /** @brief Constructor to open the file for read operations */
-flight_file::flight_file(const char* path) : m_header{}, m_file(ov::fs::open(path, ov::fs::o_rdonly))
+flight_file::flight_file(const char* path) : flight_file()
 {
-    // Read header
+    open(path);
+}
+
+/** @brief Constructor to open the file for write operations */
+flight_file::flight_file(const char* path, header& flight_header)
+    : m_header(flight_header),
+      m_file(ov::fs::open(path, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly)),
+      m_data_offset(sizeof(uint32_t) + sizeof(flight_file::header))
+{
+    // Write header
     if (m_file.is_open())
     {
-        uint32_t magic    = 0;
-        bool     is_valid = m_file.read(magic);
-        if (is_valid && (magic == header::MAGIC_NUMBER))
-        {
-            is_valid = m_file.read(m_header);
-        }
+        uint32_t magic    = header::MAGIC_NUMBER;
+        bool     is_valid = m_file.write(magic);
+        is_valid          = is_valid && m_file.write(m_header);
         if (!is_valid)
         {
             m_file.close();
@@ -28,21 +41,39 @@ flight_file::flight_file(const char* path) : m_header{}, m_file(ov::fs::open(pat
     }
 }
 
-/** @brief Constructor to open the file for write operations */
-flight_file::flight_file(const char* path, header& header)
-    : m_header(header), m_file(ov::fs::open(path, ov::fs::o_creat | ov::fs::o_trunc | ov::fs::o_wronly))
+/** @brief Open a file for read operations, the previously opened file is closed */
+bool flight_file::open(const char* path)
 {
-    // Write header
-    if (m_file.is_open())
+    // Read header
+    m_header = {};
+    if (ov::fs::open(m_file, path, ov::fs::o_rdonly))
     {
-        uint32_t magic    = header::MAGIC_NUMBER;
-        bool     is_valid = m_file.write(magic);
-        is_valid          = is_valid && m_file.write(m_header);
+        uint32_t magic    = 0;
+        bool     is_valid = m_file.read(magic);
+        if (is_valid && (magic == header::MAGIC_NUMBER))
+        {
+            is_valid      = m_file.read(m_header);
+            m_data_offset = sizeof(uint32_t) + sizeof(header);
+        }
+        else if (is_valid && (magic == header::LEGACY_MAGIC_NUMBER))
+        {
+            // Header without flight statistics
+            size_t read_count = 0u;
+            is_valid          = m_file.read(&m_header, offsetof(header, stats), read_count);
+            is_valid          = is_valid && (read_count == offsetof(header, stats));
+            m_data_offset     = sizeof(uint32_t) + offsetof(header, stats);
+        }
+        else
+        {
+            is_valid = false;
+        }
         if (!is_valid)
         {
             m_file.close();
         }
     }
+
+    return m_file.is_open();
 }
 
 /** @brief Close the file */
@@ -51,6 +82,30 @@ bool flight_file::close()
     return m_file.close();
 }
 
+/** @brief Write the flight statistics into the header and close the file */
+bool flight_file::close(const flight_stats& stats)
+{
+    m_header.stats = stats;
+
+    int32_t offset = 0;
+    bool    ret    = m_file.seek(sizeof(uint32_t) + offsetof(header, stats), file::seek_set, offset);
+    ret            = ret && m_file.write(stats);
+    ret            = m_file.close() && ret;
+
+    return ret;
+}
+
+/** @brief Get the size of the file in bytes */
+uint32_t flight_file::get_size()
+{
+    int32_t offset = 0;
+    int32_t size   = 0;
+    bool    ret    = m_file.seek(0, file::seek_cur, offset);
+    ret            = ret && m_file.seek(0, file::seek_end, size);
+    ret            = ret && m_file.seek(offset, file::seek_set, offset);
+    return (ret ? static_cast<uint32_t>(size) : 0u);
+}
+
 /** @brief Write a flight entry to the file */
 bool flight_file::write(const entry& e)
 {
@@ -77,4 +132,23 @@ bool flight_file::read(entry& e)
     return ret;
 }
 
+/** @brief Get the number of flight entries in the file */
+size_t flight_file::get_entry_count()
+{
+    size_t   count = 0u;
+    uint32_t size  = get_size();
+    if (size > m_data_offset)
+    {
+        count = (size - m_data_offset) / sizeof(entry);
+    }
+    return count;
+}
+
+/** @brief Go to a flight entry */
+bool flight_file::seek(size_t index)
+{
+    int32_t offset = static_cast<int32_t>(m_data_offset + index * sizeof(entry));
+    return m_file.seek(offset, file::seek_set, offset);
+}
+
 } // namespace ov
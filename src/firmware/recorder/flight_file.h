@@ -8,6 +8,7 @@
 
 #include "date_time.h"
 #include "file.h"
+#include "flight_stats.h"
 #include "i_barometric_altimeter.h"
 #include "i_gnss.h"
 
@@ -27,9 +28,13 @@ class flight_file
         char glider[32u];
         /** @brief Entry period in milliseconds */
         uint16_t period;
+        /** @brief Flight statistics, written when the file is closed */
+        flight_stats stats;
 
         /** @brief Magic number value */
-        static constexpr uint32_t MAGIC_NUMBER = 0xBEEFF00Du;
+        static constexpr uint32_t MAGIC_NUMBER = 0xBEEFF00Eu;
+        /** @brief Magic number value of the files without flight statistics */
+        static constexpr uint32_t LEGACY_MAGIC_NUMBER = 0xBEEFF00Du;
     };
 
     /** @brief Flight file entry */
@@ -77,15 +82,26 @@ class flight_file
         bool accel_is_valid;
     };
 
+    /** @brief Default constructor, the file is closed */
+    flight_file();
     /** @brief Constructor to open the file for read operations */
     flight_file(const char* path);
 
     /** @brief Constructor to open the file for write operations */
-    flight_file(const char* path, header& header);
+    flight_file(const char* path, header& flight_header);
+
+    /** @brief Open a file for read operations, the previously opened file is closed */
+    bool open(const char* path);
 
     /** @brief Close the file */
     bool close();
 
+    /** @brief Write the flight statistics into the header and close the file */
+    bool close(const flight_stats& stats);
+
+    /** @brief Get the size of the file in bytes */
+    uint32_t get_size();
+
     /** @brief Indicate if the file is valid */
     bool is_open() const { return m_file.is_open(); }
 
@@ -98,11 +114,19 @@ class flight_file
     /** @brief Read a flight entry from the file */
     bool read(entry& e);
 
+    /** @brief Get the number of flight entries in the file */
+    size_t get_entry_count();
+
+    /** @brief Go to a flight entry */
+    bool seek(size_t index);
+
   protected:
     /** @brief Header */
     header m_header;
     /** @brief File handle */
     file m_file;
+    /** @brief Offset of the first entry in the file */
+    uint32_t m_data_offset;
 };
 
 } // namespace ov
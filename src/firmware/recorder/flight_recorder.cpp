@@ -4,19 +4,25 @@
  */
 
 #include "flight_recorder.h"
+#include "flight_catalog.h"
 #include "flight_file.h"
 #include "fs.h"
+#include "lock_guard.h"
 #include "os.h"
 #include "ov_config.h"
 #include "ov_data.h"
+#include "text_writer.h"
 
-#include <cstdio>
+#include <cstring>
 
 namespace ov
 {
 
 /** @brief Constructor */
-flight_recorder::flight_recorder() : m_status(status::stopped), m_recording_start(0u), m_thread() { }
+flight_recorder::flight_recorder()
+    : m_status(status::stopped), m_recording_start(0u), m_stats(), m_stats_mutex(), m_detector(), m_pretrigger(), m_thread()
+{
+}
 
 /** @brief Initialize the recorder */
 bool flight_recorder::init()
@@ -30,6 +36,11 @@ bool flight_recorder::init()
         ret = fs::mkdir(RECORDED_DATA_DIR);
     }
     if (ret)
+    {
+        // Check the flight catalog, recording does not depend on it
+        flight_catalog::check();
+    }
+    if (ret)
     {
         // Start recording thread
         auto thread_func = ov::thread_func::create<flight_recorder, &flight_recorder::thread_func>(*this);
@@ -82,52 +93,87 @@ uint32_t flight_recorder::get_recording_duration()
     return duration;
 }
 
+/** @brief Get the statistics of the current flight */
+flight_stats flight_recorder::get_stats()
+{
+    lock_guard<mutex> lock(m_stats_mutex);
+    return m_stats.get_stats();
+}
+
 /** @brief Recorder thread */
 void flight_recorder::thread_func(void*)
 {
-    char             filepath[64u];
-    ov_data          data;
-    const ov_config& config = ov::config::get();
+    char      filepath[64u];
+    ov_data   data;
+    uint32_t  config_version = 0u;
+    ov_config config         = ov::config::get(config_version);
 
     // Thread loop
     while (true)
     {
-        // Wait start
+        // Wait start, the takeoff is detected while waiting when the automatic recording is enabled
+        bool     auto_started = false;
+        uint32_t entry_time   = os::now();
+        m_pretrigger.clear();
         while (m_status <= status::stopped)
         {
-            ov::this_thread::sleep_for(250u);
+            // Refresh the configuration only when it has changed
+            if (ov::config::get_version() != config_version)
+            {
+                config = ov::config::get(config_version);
+            }
+            if (config.auto_record)
+            {
+                // Keep the last entries to capture the takeoff run
+                flight_file::entry entry;
+                data = ov::data::get();
+                fill_entry(data, entry);
+                m_pretrigger.add(entry);
+                if (m_detector.update(entry, config.recording_period) == flight_detector::event::takeoff)
+                {
+                    auto_started = start();
+                }
+                wait_next_entry(entry_time, config.recording_period);
+            }
+            else
+            {
+                ov::this_thread::sleep_for(250u);
+                entry_time = os::now();
+            }
+        }
+        if (!auto_started)
+        {
+            entry_time = os::now();
         }
-        ov::this_thread::sleep_for(1000u);
 
         // Save recording period so that it cannot change during the flight
         uint32_t recording_period = config.recording_period;
 
         // Create flight file path
         data = ov::data::get();
+        text_writer path(filepath);
+        path.write(RECORDED_DATA_DIR).write('/');
         if (data.gnss.is_valid)
         {
-            snprintf(filepath,
-                     sizeof(filepath),
-                     "%s/%04d-%02d-%02dT%02d-%02d-%02d%s",
-                     RECORDED_DATA_DIR,
-                     static_cast<int>(data.gnss.date.year) + 2000,
-                     static_cast<int>(data.gnss.date.month),
-                     static_cast<int>(data.gnss.date.day),
-                     static_cast<int>(data.gnss.date.hour),
-                     static_cast<int>(data.gnss.date.minute),
-                     static_cast<int>(data.gnss.date.second),
-                     RECORDED_DATA_EXT);
+            const date_time& date = data.gnss.date;
+            path.write_int(date.year + 2000, 4u).write('-').write_int(date.month, 2u).write('-').write_int(date.day, 2u);
+            path.write('T').write_int(date.hour, 2u).write('-').write_int(date.minute, 2u).write('-').write_int(date.second, 2u);
         }
         else
         {
-            uint32_t now = os::now();
-            snprintf(filepath, sizeof(filepath), "%s/%06d.rec", RECORDED_DATA_DIR, static_cast<int>(now));
+            path.write_int(os::now(), 6u);
         }
+        path.write(RECORDED_DATA_EXT);
 
         // Create flight file
+        // The file starts with the entries preceding an automatic start, its timestamp is the one of the first entry
         flight_file::header header = {};
         const char*         glider_name;
         header.timestamp = data.gnss.date;
+        if (auto_started && data.gnss.is_valid)
+        {
+            header.timestamp.subtract(static_cast<uint32_t>(m_pretrigger.get_count()) * recording_period);
+        }
         switch (config.glider)
         {
             case 1:
@@ -155,40 +201,66 @@ void flight_recorder::thread_func(void*)
             m_recording_start = os::now();
             m_status          = status::started;
 
+            // Start the flight statistics
+            {
+                lock_guard<mutex> lock(m_stats_mutex);
+                m_stats.reset(recording_period);
+            }
+
+            // Write the entries preceding an automatic start
+            flight_file::entry entry;
+            while (auto_started && m_pretrigger.read(entry))
+            {
+                if (flight.write(entry))
+                {
+                    lock_guard<mutex> lock(m_stats_mutex);
+                    m_stats.add(entry);
+                }
+            }
+            m_detector.reset(true);
+
             // Wait stop
             while (m_status != status::stopping)
             {
                 // Get flight data
                 data = ov::data::get();
+                if (ov::config::get_version() != config_version)
+                {
+                    config = ov::config::get(config_version);
+                }
 
                 // Write a new entry
-                flight_file::entry entry;
-                entry.gnss_is_valid  = data.gnss.is_valid;
-                entry.latitude       = data.gnss.latitude;
-                entry.longitude      = data.gnss.longitude;
-                entry.speed          = data.gnss.speed;
-                entry.gnss_altitude  = data.gnss.altitude;
-                entry.alti_is_valid  = data.altimeter.is_valid;
-                entry.pressure       = data.altimeter.pressure;
-                entry.altitude       = data.altimeter.altitude;
-                entry.temperature    = data.altimeter.temperature;
-                entry.accel_is_valid = data.accelerometer.is_valid;
-                entry.total_accel    = data.accelerometer.total_accel;
-                entry.sink_rate      = data.sink_rate;
-                entry.glide_ratio    = data.glide_ratio;
-                if (!flight.write(entry))
+                fill_entry(data, entry);
+                if (flight.write(entry))
+                {
+                    lock_guard<mutex> lock(m_stats_mutex);
+                    m_stats.add(entry);
+                }
+                else
                 {
                     // Error
                     m_status = status::started_error;
                 }
 
+                // Automatic stop on landing
+                if (config.auto_record && (m_detector.update(entry, recording_period) == flight_detector::event::landing))
+                {
+                    stop();
+                }
+
                 // Recording period
-                ov::this_thread::sleep_for(recording_period);
+                wait_next_entry(entry_time, recording_period);
             }
 
-            // Close flight file
-            if (flight.close())
+            // Close flight file with its statistics
+            const flight_stats stats = get_stats();
+            const uint32_t     size  = flight.get_size();
+            if (flight.close(stats))
             {
+                // Reference the flight in the catalog
+                header.stats = stats;
+                flight_catalog::add(flight_catalog::make_summary(&filepath[strlen(RECORDED_DATA_DIR) + 1u], size, header));
+
                 // Recorder is now stopped
                 ov::this_thread::sleep_for(1000u);
                 m_status = status::stopped;
@@ -207,4 +279,34 @@ void flight_recorder::thread_func(void*)
     }
 }
 
+/** @brief Fill a flight entry with the current flight data */
+void flight_recorder::fill_entry(const ov_data& data, flight_file::entry& entry)
+{
+    entry.gnss_is_valid  = data.gnss.is_valid;
+    entry.latitude       = data.gnss.latitude;
+    entry.longitude      = data.gnss.longitude;
+    entry.speed          = data.gnss.speed;
+    entry.gnss_altitude  = data.gnss.altitude;
+    entry.alti_is_valid  = data.altimeter.is_valid;
+    entry.pressure       = data.altimeter.pressure;
+    entry.altitude       = data.altimeter.altitude;
+    entry.temperature    = data.altimeter.temperature;
+    entry.accel_is_valid = data.accelerometer.is_valid;
+    entry.total_accel    = data.accelerometer.total_accel;
+    entry.sink_rate      = data.sink_rate;
+    entry.glide_ratio    = data.glide_ratio;
+}
+
+/** @brief Wait for the time of the next entry in milliseconds, the entries stay on a grid of the recording period */
+void flight_recorder::wait_next_entry(uint32_t& entry_time, uint32_t period)
+{
+    // Late entries are written immediately so that the entry index keeps matching the elapsed time
+    entry_time += period;
+    const int32_t remaining = static_cast<int32_t>(entry_time - os::now());
+    if (remaining > 0)
+    {
+        ov::this_thread::sleep_for(static_cast<uint32_t>(remaining));
+    }
+}
+
 } // namespace ov
@@ -6,12 +6,19 @@
 #ifndef OV_FLIGHT_RECORDER_H
 #define OV_FLIGHT_RECORDER_H
 
+#include "flight_detector.h"
+#include "flight_stats_accumulator.h"
 #include "i_flight_recorder.h"
+#include "mutex.h"
+#include "pretrigger_buffer.h"
 #include "thread.h"
 
 namespace ov
 {
 
+// Forward declaration
+struct ov_data;
+
 /** @brief Flight recorder */
 class flight_recorder : public i_flight_recorder
 {
@@ -34,16 +41,33 @@ class flight_recorder : public i_flight_recorder
     /** @brief Get the recording duration in seconds */
     uint32_t get_recording_duration() override;
 
+    /** @brief Get the statistics of the current flight */
+    flight_stats get_stats() override;
+
   protected:
     /** @brief Status of the recorder */
     status m_status;
     /** @brief Timestamp of the start of recording in milliseconds */
     uint32_t m_recording_start;
+    /** @brief Statistics of the current flight */
+    flight_stats_accumulator m_stats;
+    /** @brief Mutex to protect concurrent access to the statistics */
+    mutex m_stats_mutex;
+    /** @brief Takeoff and landing detection */
+    flight_detector m_detector;
+    /** @brief Entries preceding the takeoff */
+    pretrigger_buffer m_pretrigger;
     /** @brief Recorder thread */
-    thread<2048u> m_thread;
+    thread<4096u> m_thread;
 
     /** @brief Recorder thread */
     void thread_func(void*);
+
+    /** @brief Fill a flight entry with the current flight data */
+    static void fill_entry(const ov_data& data, flight_file::entry& entry);
+
+    /** @brief Wait for the time of the next entry in milliseconds, the entries stay on a grid of the recording period */
+    static void wait_next_entry(uint32_t& entry_time, uint32_t period);
 };
 
 } // namespace ov
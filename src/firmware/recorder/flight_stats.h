@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_STATS_H
+#define OV_FLIGHT_STATS_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Statistics of a flight */
+struct flight_stats
+{
+    /** @brief Airtime in seconds */
+    uint32_t airtime;
+    /** @brief Distance along the track (1 = 1m) */
+    uint32_t distance;
+    /** @brief Maximum GNSS speed (1 = 0.1m/s) */
+    uint32_t max_speed;
+    /** @brief Maximum barometric altitude (1 = 0.1m) */
+    int32_t max_altitude;
+    /** @brief Minimum barometric altitude (1 = 0.1m) */
+    int32_t min_altitude;
+    /** @brief Maximum climb rate (1 = 0.1m/s) */
+    int16_t max_climb;
+    /** @brief Maximum sink rate, negative when sinking (1 = 0.1m/s) */
+    int16_t max_sink;
+    /** @brief Number of thermals */
+    uint16_t thermal_count;
+    /** @brief Indicate if the statistics are valid */
+    bool is_valid;
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_STATS_H
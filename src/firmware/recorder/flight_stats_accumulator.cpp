@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_stats_accumulator.h"
+
+namespace ov
+{
+
+/** @brief Constructor */
+flight_stats_accumulator::flight_stats_accumulator()
+    : m_stats{},
+      m_period(0u),
+      m_count(0u),
+      m_distance(0.f),
+      m_last_position{},
+      m_last_position_is_valid(false),
+      m_alti_is_valid(false),
+      m_climb(1.f),
+      m_climbing_duration(0u),
+      m_in_thermal(false)
+{
+}
+
+/** @brief Start the statistics of a new flight */
+void flight_stats_accumulator::reset(uint32_t period)
+{
+    m_stats                  = {};
+    m_stats.is_valid         = true;
+    m_period                 = period;
+    m_count                  = 0u;
+    m_distance               = 0.f;
+    m_last_position_is_valid = false;
+    m_alti_is_valid          = false;
+    m_climbing_duration      = 0u;
+    m_in_thermal             = false;
+    m_climb.set_alpha(ema_filter<int16_t>::alpha_from_time_constant(static_cast<float>(period), static_cast<float>(CLIMB_TIME_CONSTANT)));
+    m_climb.reset();
+}
+
+/** @brief Add a flight entry */
+void flight_stats_accumulator::add(const flight_file::entry& entry)
+{
+    // Airtime
+    m_count++;
+    m_stats.airtime = static_cast<uint32_t>((static_cast<uint64_t>(m_count) * m_period) / 1000u);
+
+    // Altitude and vertical speed
+    if (entry.alti_is_valid)
+    {
+        if (!m_alti_is_valid || (entry.altitude > m_stats.max_altitude))
+        {
+            m_stats.max_altitude = entry.altitude;
+        }
+        if (!m_alti_is_valid || (entry.altitude < m_stats.min_altitude))
+        {
+            m_stats.min_altitude = entry.altitude;
+        }
+        if (!m_alti_is_valid || (entry.sink_rate > m_stats.max_climb))
+        {
+            m_stats.max_climb = entry.sink_rate;
+        }
+        if (!m_alti_is_valid || (entry.sink_rate < m_stats.max_sink))
+        {
+            m_stats.max_sink = entry.sink_rate;
+        }
+        m_alti_is_valid = true;
+
+        // Thermal detection on the smoothed climb rate with hysteresis
+        const int16_t climb = m_climb.add_value(entry.sink_rate);
+        if (climb >= THERMAL_CLIMB)
+        {
+            m_climbing_duration += m_period;
+            if (!m_in_thermal && (m_climbing_duration >= THERMAL_MIN_DURATION))
+            {
+                m_in_thermal = true;
+                m_stats.thermal_count++;
+            }
+        }
+        else if (climb < THERMAL_EXIT_CLIMB)
+        {
+            m_climbing_duration = 0u;
+            m_in_thermal        = false;
+        }
+        else
+        {
+            // Keep the current state
+        }
+    }
+
+    // Distance along the track and speed
+    if (entry.gnss_is_valid)
+    {
+        const geo::position pos = geo::position::from_degrees(entry.latitude, entry.longitude);
+        if (m_last_position_is_valid)
+        {
+            m_distance += geo::distance(m_last_position, pos);
+            m_stats.distance = static_cast<uint32_t>(m_distance);
+        }
+        m_last_position          = pos;
+        m_last_position_is_valid = true;
+
+        if (entry.speed > m_stats.max_speed)
+        {
+            m_stats.max_speed = entry.speed;
+        }
+    }
+}
+
+} // namespace ov
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_FLIGHT_STATS_ACCUMULATOR_H
+#define OV_FLIGHT_STATS_ACCUMULATOR_H
+
+#include "ema_filter.h"
+#include "flight_file.h"
+#include "flight_stats.h"
+#include "geodesy.h"
+
+namespace ov
+{
+
+/** @brief Compute the statistics of a flight sample by sample in constant time and memory */
+class flight_stats_accumulator
+{
+  public:
+    /** @brief Constructor */
+    flight_stats_accumulator();
+
+    /** @brief Start the statistics of a new flight */
+    void reset(uint32_t period);
+
+    /** @brief Add a flight entry */
+    void add(const flight_file::entry& entry);
+
+    /** @brief Get the statistics */
+    const flight_stats& get_stats() const { return m_stats; }
+
+    /** @brief Climb rate to consider that a thermal is being climbed (1 = 0.1m/s) */
+    static constexpr int16_t THERMAL_CLIMB = 5;
+    /** @brief Climb rate under which a thermal is left (1 = 0.1m/s) */
+    static constexpr int16_t THERMAL_EXIT_CLIMB = 0;
+    /** @brief Minimum climbing duration to count a thermal in milliseconds */
+    static constexpr uint32_t THERMAL_MIN_DURATION = 20000u;
+    /** @brief Time constant of the climb rate smoothing in milliseconds */
+    static constexpr uint32_t CLIMB_TIME_CONSTANT = 10000u;
+
+  private:
+    /** @brief Statistics */
+    flight_stats m_stats;
+    /** @brief Entry period in milliseconds */
+    uint32_t m_period;
+    /** @brief Number of entries */
+    uint32_t m_count;
+    /** @brief Accumulated distance (1 = 1m) */
+    float m_distance;
+    /** @brief Last valid position */
+    geo::position m_last_position;
+    /** @brief Indicate if the last position is valid */
+    bool m_last_position_is_valid;
+    /** @brief Indicate if the altimeter data has been valid at least once */
+    bool m_alti_is_valid;
+    /** @brief Smoothed climb rate for thermal detection */
+    ema_filter<int16_t> m_climb;
+    /** @brief Climbing duration in milliseconds */
+    uint32_t m_climbing_duration;
+    /** @brief Indicate if a thermal is being climbed */
+    bool m_in_thermal;
+};
+
+} // namespace ov
+
+#endif // OV_FLIGHT_STATS_ACCUMULATOR_H
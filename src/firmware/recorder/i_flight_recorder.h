@@ -6,6 +6,8 @@
 #ifndef OV_I_FLIGHT_RECORDER_H
 #define OV_I_FLIGHT_RECORDER_H
 
+#include "flight_stats.h"
+
 #include <cstdint>
 
 namespace ov
@@ -47,6 +49,9 @@ class i_flight_recorder
     /** @brief Get the recording duration in seconds */
     virtual uint32_t get_recording_duration() = 0;
 
+    /** @brief Get the statistics of the current flight */
+    virtual flight_stats get_stats() = 0;
+
     /** @brief Directory to store the recorded data */
     static constexpr const char* RECORDED_DATA_DIR = "/flights";
     /** @brief Extension for flight files */
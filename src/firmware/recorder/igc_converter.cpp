@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "igc_converter.h"
+#include "text_writer.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Write a coordinate in the IGC format (DDMMmmm or DDDMMmmm followed by the hemisphere) */
+static void write_coordinate(text_writer& writer, double value, uint8_t degree_digits, char positive, char negative)
+{
+    char hemisphere = positive;
+    if (value < 0.)
+    {
+        value      = -value;
+        hemisphere = negative;
+    }
+    uint32_t degrees = static_cast<uint32_t>(value);
+    uint32_t minutes = static_cast<uint32_t>(std::lround((value - static_cast<double>(degrees)) * 60000.));
+    if (minutes >= 60000u)
+    {
+        degrees++;
+        minutes -= 60000u;
+    }
+    writer.write_int(degrees, degree_digits).write_int(minutes, 5u).write(hemisphere);
+}
+
+/** @brief Write an altitude in the IGC format (5 characters) */
+static void write_altitude(text_writer& writer, int32_t altitude)
+{
+    if (altitude < 0)
+    {
+        if (altitude < -9999)
+        {
+            altitude = -9999;
+        }
+        writer.write('-').write_int(-altitude, 4u);
+    }
+    else
+    {
+        if (altitude > 99999)
+        {
+            altitude = 99999;
+        }
+        writer.write_int(altitude, 5u);
+    }
+}
+
+/** @brief Constructor */
+igc_converter::igc_converter(flight_file& flight) : m_flight(flight), m_header{}, m_header_size(0u), m_entry_count(0u)
+{
+}
+
+/** @brief Initialize the converter from the header of the opened flight file */
+bool igc_converter::init()
+{
+    bool ret = m_flight.is_open();
+    if (ret)
+    {
+        const flight_file::header& header = m_flight.get_header();
+
+        // Copy the glider name without the characters which are not allowed in IGC files
+        char glider[sizeof(header.glider)];
+        for (size_t i = 0u; i < sizeof(glider); i++)
+        {
+            char c    = header.glider[i];
+            glider[i] = ((c == '\r') || (c == '\n')) ? ' ' : c;
+        }
+        glider[sizeof(glider) - 1u] = 0;
+
+        text_writer writer(m_header);
+        writer.write("AXOV001OpenVario\r\n");
+        writer.write("HFDTEDATE:").write_int(header.timestamp.day, 2u).write_int(header.timestamp.month, 2u);
+        writer.write_int(header.timestamp.year, 2u).write(",01\r\n");
+        writer.write("HFPLTPILOTINCHARGE:\r\n");
+        writer.write("HFGTYGLIDERTYPE:").write(glider).write("\r\n");
+        writer.write("HFDTM100GPSDATUM:WGS-1984\r\n");
+        writer.write("HFRFWFIRMWAREVERSION:" OPENVARIO_MAJOR "." OPENVARIO_MINOR "." OPENVARIO_FIX "\r\n");
+        writer.write("HFFTYFRTYPE:OpenVario\r\n");
+        m_header_size = writer.size();
+        m_entry_count = m_flight.get_entry_count();
+        ret           = !writer.is_truncated();
+    }
+    return ret;
+}
+
+/** @brief Read a part of the IGC file */
+bool igc_converter::read(uint32_t offset, void* buffer, size_t size)
+{
+    bool  ret    = true;
+    char* output = reinterpret_cast<char*>(buffer);
+
+    // Header records
+    if (offset < m_header_size)
+    {
+        size_t count = m_header_size - offset;
+        if (count > size)
+        {
+            count = size;
+        }
+        memcpy(output, &m_header[offset], count);
+        output += count;
+        offset += static_cast<uint32_t>(count);
+        size -= count;
+    }
+
+    // B records, generated from the first entry which is part of the requested range
+    if (size != 0u)
+    {
+        size_t index     = (offset - m_header_size) / B_RECORD_SIZE;
+        size_t rec_start = (offset - m_header_size) % B_RECORD_SIZE;
+        ret              = m_flight.seek(index);
+        while (ret && (size != 0u) && (index < m_entry_count))
+        {
+            flight_file::entry e;
+            ret = m_flight.read(e);
+            if (ret)
+            {
+                char record[B_RECORD_SIZE + 1u];
+                write_fix(index, e, record);
+
+                size_t count = B_RECORD_SIZE - rec_start;
+                if (count > size)
+                {
+                    count = size;
+                }
+                memcpy(output, &record[rec_start], count);
+                output += count;
+                size -= count;
+                rec_start = 0u;
+                index++;
+            }
+        }
+    }
+
+    // Beyond the end of the file
+    if (size != 0u)
+    {
+        memset(output, 0, size);
+    }
+
+    return ret;
+}
+
+/** @brief Write the B record of a flight entry */
+void igc_converter::write_fix(size_t index, const flight_file::entry& e, char (&record)[B_RECORD_SIZE + 1u])
+{
+    const flight_file::header& header = m_flight.get_header();
+
+    // UTC time of the fix
+    uint32_t millis = static_cast<uint32_t>(header.timestamp.hour) * 3600000u + static_cast<uint32_t>(header.timestamp.minute) * 60000u +
+                      static_cast<uint32_t>(header.timestamp.second) * 1000u + header.timestamp.millis;
+    uint32_t seconds = ((millis + static_cast<uint32_t>(index) * header.period) / 1000u) % 86400u;
+
+    text_writer writer(record);
+    writer.write('B').write_int(seconds / 3600u, 2u).write_int((seconds / 60u) % 60u, 2u).write_int(seconds % 60u, 2u);
+    write_coordinate(writer, e.gnss_is_valid ? e.latitude : 0., 2u, 'N', 'S');
+    write_coordinate(writer, e.gnss_is_valid ? e.longitude : 0., 3u, 'E', 'W');
+    writer.write(e.gnss_is_valid ? 'A' : 'V');
+    write_altitude(writer, e.alti_is_valid ? (e.altitude / 10) : 0);
+    write_altitude(writer, e.gnss_is_valid ? static_cast<int32_t>(e.gnss_altitude / 10u) : 0);
+    writer.write("\r\n");
+}
+
+} // namespace ov
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_IGC_CONVERTER_H
+#define OV_IGC_CONVERTER_H
+
+#include "flight_file.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Generate the IGC representation of a flight file on the fly
+ *        All the fixes are written as B records of the same size so that any offset of the IGC file
+ *        can be generated without converting the preceding entries
+ */
+class igc_converter
+{
+  public:
+    /** @brief Size of a B record in bytes (including CRLF) */
+    static constexpr size_t B_RECORD_SIZE = 37u;
+    /** @brief Maximum size of the header records in bytes */
+    static constexpr size_t MAX_HEADER_SIZE = 256u;
+
+    /** @brief Constructor */
+    igc_converter(flight_file& flight);
+
+    /** @brief Initialize the converter from the header of the opened flight file */
+    bool init();
+
+    /** @brief Get the size of the IGC file in bytes */
+    uint32_t get_size() const { return static_cast<uint32_t>(m_header_size + m_entry_count * B_RECORD_SIZE); }
+
+    /** @brief Read a part of the IGC file */
+    bool read(uint32_t offset, void* buffer, size_t size);
+
+  private:
+    /** @brief Flight file */
+    flight_file& m_flight;
+    /** @brief Header records */
+    char m_header[MAX_HEADER_SIZE];
+    /** @brief Size of the header records in bytes */
+    size_t m_header_size;
+    /** @brief Number of entries in the flight file */
+    size_t m_entry_count;
+
+    /** @brief Write the B record of a flight entry */
+    void write_fix(size_t index, const flight_file::entry& e, char (&record)[B_RECORD_SIZE + 1u]);
+};
+
+} // namespace ov
+
+#endif // OV_IGC_CONVERTER_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "pretrigger_buffer.h"
+#include "geodesy.h"
+
+#include <climits>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Constructor */
+pretrigger_buffer::pretrigger_buffer() : m_entries() { }
+
+/** @brief Add an entry, the oldest entry is dropped when the buffer is full */
+void pretrigger_buffer::add(const flight_file::entry& entry)
+{
+    const geo::position pos = geo::position::from_degrees(entry.latitude, entry.longitude);
+
+    packed_entry packed;
+    packed.latitude      = pos.latitude;
+    packed.longitude     = pos.longitude;
+    packed.gnss_altitude = entry.gnss_altitude;
+    packed.pressure      = entry.pressure;
+    packed.altitude      = entry.altitude;
+    packed.speed         = static_cast<uint16_t>((entry.speed > UINT16_MAX) ? UINT16_MAX : entry.speed);
+    packed.temperature   = entry.temperature;
+    packed.total_accel   = entry.total_accel;
+    packed.sink_rate     = entry.sink_rate;
+    packed.glide_ratio   = entry.glide_ratio;
+    packed.flags         = 0u;
+    packed.flags |= (entry.gnss_is_valid ? GNSS_IS_VALID : 0u);
+    packed.flags |= (entry.alti_is_valid ? ALTI_IS_VALID : 0u);
+    packed.flags |= (entry.accel_is_valid ? ACCEL_IS_VALID : 0u);
+
+    if (!m_entries.write(packed))
+    {
+        // Drop the oldest entry
+        packed_entry oldest;
+        m_entries.read(oldest);
+        m_entries.write(packed);
+    }
+}
+
+/** @brief Read the oldest entry */
+bool pretrigger_buffer::read(flight_file::entry& entry)
+{
+    packed_entry packed;
+    bool         ret = m_entries.read(packed);
+    if (ret)
+    {
+        entry.latitude       = static_cast<double>(packed.latitude) / static_cast<double>(geo::UNITS_PER_DEGREE);
+        entry.longitude      = static_cast<double>(packed.longitude) / static_cast<double>(geo::UNITS_PER_DEGREE);
+        entry.speed          = packed.speed;
+        entry.gnss_altitude  = packed.gnss_altitude;
+        entry.pressure       = packed.pressure;
+        entry.altitude       = packed.altitude;
+        entry.temperature    = packed.temperature;
+        entry.total_accel    = packed.total_accel;
+        entry.sink_rate      = packed.sink_rate;
+        entry.glide_ratio    = packed.glide_ratio;
+        entry.gnss_is_valid  = ((packed.flags & GNSS_IS_VALID) != 0u);
+        entry.alti_is_valid  = ((packed.flags & ALTI_IS_VALID) != 0u);
+        entry.accel_is_valid = ((packed.flags & ACCEL_IS_VALID) != 0u);
+    }
+    return ret;
+}
+
+} // namespace ov
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_PRETRIGGER_BUFFER_H
+#define OV_PRETRIGGER_BUFFER_H
+
+#include "flight_file.h"
+#include "ring_buffer.h"
+
+namespace ov
+{
+
+/** @brief Keep the last flight entries in a compact form while waiting for the takeoff */
+class pretrigger_buffer
+{
+  public:
+    /** @brief Maximum number of entries in the buffer */
+    static constexpr size_t MAX_ENTRIES = 120u;
+
+    /** @brief Constructor */
+    pretrigger_buffer();
+
+    /** @brief Clear the buffer */
+    void clear() { m_entries.clear(); }
+
+    /** @brief Get the number of entries in the buffer */
+    size_t get_count() const { return m_entries.get_count(); }
+
+    /** @brief Add an entry, the oldest entry is dropped when the buffer is full */
+    void add(const flight_file::entry& entry);
+
+    /** @brief Read the oldest entry */
+    bool read(flight_file::entry& entry);
+
+  private:
+    /** @brief Compact flight entry */
+    struct packed_entry
+    {
+        /** @brief Latitude (1 = 1e-7°) */
+        int32_t latitude;
+        /** @brief Longitude (1 = 1e-7°) */
+        int32_t longitude;
+        /** @brief GNSS altitude (1 = 0.1 m) */
+        uint32_t gnss_altitude;
+        /** @brief Pressure (1 = 0.01mbar) */
+        int32_t pressure;
+        /** @brief Altitude (1 = 0.1m) */
+        int32_t altitude;
+        /** @brief Speed (1 = 0.1 m/s) */
+        uint16_t speed;
+        /** @brief Temperature (1 = 0.1°C) */
+        int16_t temperature;
+        /** @brief Total acceleration (1000 = 1g) */
+        int16_t total_accel;
+        /** @brief Sink rate (1 = 0.1m/s) */
+        int16_t sink_rate;
+        /** @brief Glide ratio (1 = 0.1) */
+        uint16_t glide_ratio;
+        /** @brief Validity flags */
+        uint8_t flags;
+    };
+
+    /** @brief GNSS data validity flag */
+    static constexpr uint8_t GNSS_IS_VALID = 0x01u;
+    /** @brief Altimeter data validity flag */
+    static constexpr uint8_t ALTI_IS_VALID = 0x02u;
+    /** @brief Accelerometer data validity flag */
+    static constexpr uint8_t ACCEL_IS_VALID = 0x04u;
+
+    /** @brief Entries (one slot is needed to distinguish a full buffer from an empty one) */
+    ring_buffer<packed_entry, MAX_ENTRIES + 1u> m_entries;
+};
+
+} // namespace ov
+
+#endif // OV_PRETRIGGER_BUFFER_H
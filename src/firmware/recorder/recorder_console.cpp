@@ -7,6 +7,7 @@
 #include "i_flight_recorder.h"
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace ov
@@ -59,6 +60,27 @@ void recorder_console::flstatus_handler(const char*)
 
             m_console.write("Flying since : ");
             m_console.write_line(duration_string);
+
+            // Flight statistics
+            char stats_string[64u];
+            auto stats = m_recorder.get_stats();
+            snprintf(stats_string,
+                     sizeof(stats_string),
+                     "Distance : %ldm, max speed : %ldkm/h",
+                     stats.distance,
+                     (stats.max_speed * 36u) / 100u);
+            m_console.write_line(stats_string);
+            snprintf(stats_string, sizeof(stats_string), "Altitude : %ldm - %ldm", stats.min_altitude / 10, stats.max_altitude / 10);
+            m_console.write_line(stats_string);
+            snprintf(stats_string,
+                     sizeof(stats_string),
+                     "Vario : %d.%dm/s - %d.%dm/s, thermals : %d",
+                     stats.max_sink / 10,
+                     abs(stats.max_sink % 10),
+                     stats.max_climb / 10,
+                     abs(stats.max_climb % 10),
+                     stats.thermal_count);
+            m_console.write_line(stats_string);
         }
         break;
 
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_SENSOR_STREAM_H
+#define OV_I_SENSOR_STREAM_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Interface for the binary sensor stream implementations */
+class i_sensor_stream
+{
+  public:
+    /** @brief Record types */
+    enum class record_type : uint8_t
+    {
+        /** @brief Barometric sensor conversion (barometer_record) */
+        barometer = 1u,
+        /** @brief Filtered and decimated accelerometer sample used by the main loop (accelerometer_record) */
+        accelerometer = 2u,
+        /** @brief New GNSS fix (gnss_record) */
+        gnss = 3u,
+        /** @brief Raw NMEA sentence (characters without start of frame and checksum) */
+        nmea_sentence = 4u,
+        /** @brief Filters outputs (filters_record) */
+        filters = 5u,
+        /** @brief Block of raw accelerometer samples read from the FIFO (accelerometer_block_record) */
+        accelerometer_block = 6u
+    };
+
+    /** @brief Maximum number of samples in an accelerometer block */
+    static constexpr uint8_t MAX_ACCEL_BLOCK_SAMPLES = 16u;
+
+    /** @brief Header of a record */
+    struct record_header
+    {
+        /** @brief Record type */
+        record_type type;
+        /** @brief Size of the record payload in bytes */
+        uint8_t size;
+        /** @brief Sequence number, incremented for each record including the dropped ones */
+        uint16_t sequence;
+        /** @brief Timestamp in milliseconds */
+        uint32_t timestamp;
+    };
+
+    /** @brief Barometric sensor sample */
+    struct barometer_record
+    {
+        /** @brief Raw pressure conversion result (D1) */
+        uint32_t raw_pressure;
+        /** @brief Raw temperature conversion result (D2) */
+        uint32_t raw_temperature;
+        /** @brief Pressure (1 = 0.01mbar) */
+        int32_t pressure;
+        /** @brief Altitude (1 = 0.1m) */
+        int32_t altitude;
+        /** @brief Temperature (1 = 0.1°C) */
+        int16_t temperature;
+        /** @brief Indicate if the data is valid */
+        uint8_t is_valid;
+        /** @brief Padding */
+        uint8_t reserved;
+    };
+
+    /** @brief Accelerometer sample */
+    struct accelerometer_record
+    {
+        /** @brief Acceleration on X (1000 = 1g) */
+        int16_t x_accel;
+        /** @brief Acceleration on Y (1000 = 1g) */
+        int16_t y_accel;
+        /** @brief Acceleration on Z (1000 = 1g) */
+        int16_t z_accel;
+        /** @brief Total acceleration (1000 = 1g) */
+        int16_t total_accel;
+        /** @brief Indicate if the data is valid */
+        uint8_t is_valid;
+        /** @brief Padding */
+        uint8_t reserved;
+    };
+
+    /**
+     * @brief Block of accelerometer samples, only the used samples are sent
+     *        The newest sample of a block has been acquired at most one sampling period before the record timestamp
+     */
+    struct accelerometer_block_record
+    {
+        /** @brief Sampling period in microseconds */
+        uint16_t sample_period;
+        /** @brief Number of samples */
+        uint8_t count;
+        /** @brief Padding */
+        uint8_t reserved;
+        /** @brief Acceleration on X, Y and Z of each sample from the oldest to the newest (1000 = 1g) */
+        int16_t samples[MAX_ACCEL_BLOCK_SAMPLES][3u];
+    };
+
+    /** @brief GNSS fix */
+    struct gnss_record
+    {
+        /** @brief Latitude (1 = 1e-7°) */
+        int32_t latitude;
+        /** @brief Longitude (1 = 1e-7°) */
+        int32_t longitude;
+        /** @brief Speed (1 = 0.1 m/s) */
+        uint32_t speed;
+        /** @brief Altitude (1 = 0.1 m) */
+        uint32_t altitude;
+        /** @brief Track angle (1 = 0.1°) */
+        uint16_t track_angle;
+        /** @brief Number of satellites */
+        uint8_t satellite_count;
+        /** @brief Indicate if the data is valid */
+        uint8_t is_valid;
+    };
+
+    /** @brief Filters outputs */
+    struct filters_record
+    {
+        /** @brief Median filtered altitude (1 = 0.1m) */
+        int32_t altitude;
+        /** @brief Mean sink rate (1 = 0.1m/s) */
+        int16_t sink_rate;
+        /** @brief Glide ratio (1 = 0.1) */
+        uint16_t glide_ratio;
+    };
+
+    /** @brief Streaming statistics */
+    struct stats
+    {
+        /** @brief Number of records pushed in the stream */
+        uint32_t records;
+        /** @brief Number of records dropped because the stream buffer was full */
+        uint32_t dropped;
+        /** @brief Number of frames sent */
+        uint32_t frames;
+    };
+
+    /** @brief Destructor */
+    virtual ~i_sensor_stream() { }
+
+    /** @brief Start streaming */
+    virtual bool start() = 0;
+
+    /** @brief Stop streaming */
+    virtual bool stop() = 0;
+
+    /** @brief Indicate if the streaming is started */
+    virtual bool is_started() const = 0;
+
+    /** @brief Get the streaming statistics */
+    virtual stats get_stats() = 0;
+
+    /** @brief Push a record in the stream, never blocks */
+    virtual void push(record_type type, const void* data, uint8_t size) = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_SENSOR_STREAM_H
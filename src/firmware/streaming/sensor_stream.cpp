@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "sensor_stream.h"
+#include "lock_guard.h"
+#include "maintenance_protocol.h"
+#include "os.h"
+
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+sensor_stream::sensor_stream(i_serial& serial_port)
+    : m_serial_port(serial_port),
+      m_started(false),
+      m_buffer{},
+      m_read_index(0u),
+      m_write_index(0u),
+      m_count(0u),
+      m_sequence(0u),
+      m_stats{},
+      m_mutex(),
+      m_frame{},
+      m_thread()
+{
+}
+
+/** @brief Initialize the stream */
+bool sensor_stream::init()
+{
+    // Start stream thread
+    auto thread_func = ov::thread_func::create<sensor_stream, &sensor_stream::thread_func>(*this);
+    bool ret         = m_thread.start(thread_func, "Stream", 2u, nullptr);
+
+    return ret;
+}
+
+/** @brief Start streaming */
+bool sensor_stream::start()
+{
+    lock_guard<mutex> lock(m_mutex);
+    bool              ret = !m_started;
+    if (ret)
+    {
+        // Discard the records of the previous stream
+        m_read_index  = 0u;
+        m_write_index = 0u;
+        m_count       = 0u;
+        m_sequence    = 0u;
+        m_stats       = {};
+        m_started     = true;
+    }
+
+    return ret;
+}
+
+/** @brief Stop streaming, the buffered records are still sent */
+bool sensor_stream::stop()
+{
+    lock_guard<mutex> lock(m_mutex);
+    bool              ret = m_started;
+    m_started             = false;
+
+    return ret;
+}
+
+/** @brief Get the streaming statistics */
+i_sensor_stream::stats sensor_stream::get_stats()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/** @brief Push a record in the stream, never blocks */
+void sensor_stream::push(record_type type, const void* data, uint8_t size)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (m_started)
+    {
+        // Store the record if there is enough space, otherwise drop it
+        if ((m_count + sizeof(record_header) + size) <= BUFFER_SIZE)
+        {
+            const record_header header = {type, size, m_sequence, os::now()};
+            write(&header, sizeof(header));
+            write(data, size);
+            m_stats.records++;
+        }
+        else
+        {
+            m_stats.dropped++;
+        }
+
+        // Dropped records leave a gap in the sequence numbers
+        m_sequence++;
+    }
+}
+
+/** @brief Called for each valid sentence received, without start of frame and checksum */
+void sensor_stream::on_sentence(const char* sentence, size_t size)
+{
+    if (size <= UINT8_MAX)
+    {
+        push(record_type::nmea_sentence, sentence, static_cast<uint8_t>(size));
+    }
+}
+
+/** @brief Called once for each new fix, when all the sentences of the fix have been decoded */
+void sensor_stream::on_fix(const i_gnss::data& fix)
+{
+    if (m_started)
+    {
+        gnss_record         record   = {};
+        const geo::position position = fix.get_position();
+        record.latitude              = position.latitude;
+        record.longitude             = position.longitude;
+        record.speed                 = fix.speed;
+        record.altitude              = fix.altitude;
+        record.track_angle           = fix.track_angle;
+        record.satellite_count       = fix.satellite_count;
+        record.is_valid              = fix.is_valid;
+        push(record_type::gnss, &record, sizeof(record));
+    }
+}
+
+/** @brief Called for each conversion of the barometric sensor */
+void sensor_stream::on_altimeter_data(const i_barometric_altimeter::data& altimeter_data)
+{
+    if (m_started)
+    {
+        barometer_record record = {};
+        record.raw_pressure     = altimeter_data.raw_pressure;
+        record.raw_temperature  = altimeter_data.raw_temperature;
+        record.pressure         = altimeter_data.pressure;
+        record.altitude         = altimeter_data.altitude;
+        record.temperature      = altimeter_data.temperature;
+        record.is_valid         = altimeter_data.is_valid;
+        push(record_type::barometer, &record, sizeof(record));
+    }
+}
+
+/** @brief Push the samples read from the accelerometer FIFO, split in blocks of MAX_ACCEL_BLOCK_SAMPLES */
+void sensor_stream::push_accelerometer_samples(const i_accelerometer_sensor::data* samples, size_t count, uint16_t sample_rate)
+{
+    if (m_started && (sample_rate != 0u))
+    {
+        accelerometer_block_record record = {};
+        record.sample_period               = static_cast<uint16_t>(1000000u / sample_rate);
+        while (count != 0u)
+        {
+            record.count = static_cast<uint8_t>((count < MAX_ACCEL_BLOCK_SAMPLES) ? count : MAX_ACCEL_BLOCK_SAMPLES);
+            for (uint8_t i = 0u; i < record.count; i++)
+            {
+                record.samples[i][0u] = samples[i].x_accel;
+                record.samples[i][1u] = samples[i].y_accel;
+                record.samples[i][2u] = samples[i].z_accel;
+            }
+
+            // Only the used samples are sent
+            const size_t size = sizeof(record) - sizeof(record.samples) + record.count * sizeof(record.samples[0u]);
+            push(record_type::accelerometer_block, &record, static_cast<uint8_t>(size));
+
+            samples += record.count;
+            count -= record.count;
+        }
+    }
+}
+
+/** @brief Stream thread */
+void sensor_stream::thread_func(void*)
+{
+    // Thread loop
+    while (true)
+    {
+        // Send all the buffered records
+        size_t size = fill_frame();
+        if (size != 0u)
+        {
+            if (maintenance_protocol::send_frame(m_serial_port, ov_request_id::stream_data, m_frame, static_cast<uint16_t>(size)))
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_stats.frames++;
+            }
+        }
+        else
+        {
+            ov::this_thread::sleep_for(m_started ? FLUSH_PERIOD : IDLE_PERIOD);
+        }
+    }
+}
+
+/** @brief Fill the frame payload with the next records, returns the payload size */
+size_t sensor_stream::fill_frame()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    // Frame starts with the number of dropped records
+    size_t size = sizeof(m_stats.dropped);
+    memcpy(m_frame, &m_stats.dropped, sizeof(m_stats.dropped));
+
+    // Only complete records are sent in a frame
+    bool record_fits = true;
+    while (record_fits && (m_count != 0u))
+    {
+        record_header header;
+        peek(&header, sizeof(header));
+        const size_t record_size = sizeof(header) + header.size;
+        record_fits              = ((size + record_size) <= MAX_FRAME_SIZE);
+        if (record_fits)
+        {
+            read(&m_frame[size], record_size);
+            size += record_size;
+        }
+    }
+    if (size == sizeof(m_stats.dropped))
+    {
+        // No record to send
+        size = 0u;
+    }
+
+    return size;
+}
+
+/** @brief Copy bytes from the buffer without removing them */
+void sensor_stream::peek(void* data, size_t size) const
+{
+    uint8_t*     dest  = reinterpret_cast<uint8_t*>(data);
+    const size_t first = ((m_read_index + size) <= BUFFER_SIZE) ? size : (BUFFER_SIZE - m_read_index);
+    memcpy(dest, &m_buffer[m_read_index], first);
+    memcpy(&dest[first], &m_buffer[0u], size - first);
+}
+
+/** @brief Remove bytes from the buffer */
+void sensor_stream::read(void* data, size_t size)
+{
+    peek(data, size);
+    m_read_index = (m_read_index + size) % BUFFER_SIZE;
+    m_count -= size;
+}
+
+/** @brief Add bytes to the buffer */
+void sensor_stream::write(const void* data, size_t size)
+{
+    const uint8_t* src   = reinterpret_cast<const uint8_t*>(data);
+    const size_t   first = ((m_write_index + size) <= BUFFER_SIZE) ? size : (BUFFER_SIZE - m_write_index);
+    memcpy(&m_buffer[m_write_index], src, first);
+    memcpy(&m_buffer[0u], &src[first], size - first);
+    m_write_index = (m_write_index + size) % BUFFER_SIZE;
+    m_count += size;
+}
+
+} // namespace ov
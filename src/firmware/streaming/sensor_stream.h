@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_SENSOR_STREAM_H
+#define OV_SENSOR_STREAM_H
+
+#include "i_accelerometer_sensor.h"
+#include "i_barometric_altimeter.h"
+#include "i_gnss.h"
+#include "i_sensor_stream.h"
+#include "mutex.h"
+#include "thread.h"
+
+namespace ov
+{
+
+// Forward declaration
+class i_serial;
+
+/** @brief Stream the sensor records as maintenance protocol frames */
+class sensor_stream : public i_sensor_stream, public i_gnss::i_listener, public i_barometric_altimeter::i_listener
+{
+  public:
+    /** @brief Constructor */
+    sensor_stream(i_serial& serial_port);
+
+    /** @brief Initialize the stream */
+    bool init();
+
+    /** @brief Start streaming */
+    bool start() override;
+
+    /** @brief Stop streaming */
+    bool stop() override;
+
+    /** @brief Indicate if the streaming is started */
+    bool is_started() const override { return m_started; }
+
+    /** @brief Get the streaming statistics */
+    stats get_stats() override;
+
+    /** @brief Push a record in the stream, never blocks */
+    void push(record_type type, const void* data, uint8_t size) override;
+
+    /** @brief Called for each valid sentence received, without start of frame and checksum */
+    void on_sentence(const char* sentence, size_t size) override;
+
+    /** @brief Called once for each new fix, when all the sentences of the fix have been decoded */
+    void on_fix(const i_gnss::data& fix) override;
+
+    /** @brief Called for each conversion of the barometric sensor */
+    void on_altimeter_data(const i_barometric_altimeter::data& altimeter_data) override;
+
+    /** @brief Push the samples read from the accelerometer FIFO, split in blocks of MAX_ACCEL_BLOCK_SAMPLES */
+    void push_accelerometer_samples(const i_accelerometer_sensor::data* samples, size_t count, uint16_t sample_rate);
+
+  private:
+    /** @brief Size of the buffer storing the records waiting to be sent in bytes */
+    static constexpr size_t BUFFER_SIZE = 4096u;
+    /** @brief Maximum size of a frame payload in bytes */
+    static constexpr size_t MAX_FRAME_SIZE = 1024u;
+    /** @brief Period to check for records to send in milliseconds */
+    static constexpr uint32_t FLUSH_PERIOD = 10u;
+    /** @brief Period to check for records to send when the streaming is stopped in milliseconds */
+    static constexpr uint32_t IDLE_PERIOD = 100u;
+
+    /** @brief Serial port to use for the stream */
+    i_serial& m_serial_port;
+    /** @brief Indicate if the streaming is started */
+    bool m_started;
+    /** @brief Records waiting to be sent */
+    uint8_t m_buffer[BUFFER_SIZE];
+    /** @brief Read index in the buffer */
+    size_t m_read_index;
+    /** @brief Write index in the buffer */
+    size_t m_write_index;
+    /** @brief Number of bytes stored in the buffer */
+    size_t m_count;
+    /** @brief Sequence number of the next record */
+    uint16_t m_sequence;
+    /** @brief Streaming statistics */
+    stats m_stats;
+    /** @brief Mutex to protect the buffer and the statistics */
+    mutex m_mutex;
+    /** @brief Payload of the frame being sent */
+    uint8_t m_frame[MAX_FRAME_SIZE];
+    /** @brief Stream thread */
+    thread<1024u> m_thread;
+
+    /** @brief Stream thread */
+    void thread_func(void*);
+
+    /** @brief Fill the frame payload with the next records, returns the payload size */
+    size_t fill_frame();
+    /** @brief Copy bytes from the buffer without removing them */
+    void peek(void* data, size_t size) const;
+    /** @brief Remove bytes from the buffer */
+    void read(void* data, size_t size);
+    /** @brief Add bytes to the buffer */
+    void write(const void* data, size_t size);
+};
+
+} // namespace ov
+
+#endif // OV_SENSOR_STREAM_H
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "stream_console.h"
+#include "i_sensor_stream.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+stream_console::stream_console(i_debug_console& console, i_sensor_stream& stream)
+    : m_console(console),
+      m_stream(stream),
+      m_stream_handler{"stream",
+                       "Display the sensor stream status, 'stream start' and 'stream stop' control the streaming over USB",
+                       ov::handler_func::create<stream_console, &stream_console::stream_handler>(*this),
+                       nullptr,
+                       false}
+{
+}
+
+/** @brief Register command handlers */
+void stream_console::register_handlers()
+{
+    m_console.register_handler(m_stream_handler);
+}
+
+/** @brief Handler for the 'stream' command */
+void stream_console::stream_handler(const char* param)
+{
+    if (param && (strcmp(param, "start") == 0))
+    {
+        if (m_stream.start())
+        {
+            m_console.write_line("Streaming started");
+        }
+        else
+        {
+            m_console.write_line("Streaming already started");
+        }
+    }
+    else if (param && (strcmp(param, "stop") == 0))
+    {
+        if (m_stream.stop())
+        {
+            m_console.write_line("Streaming stopped");
+        }
+        else
+        {
+            m_console.write_line("Streaming not started");
+        }
+    }
+    else
+    {
+        char tmp[96u];
+        auto stats = m_stream.get_stats();
+        snprintf(tmp,
+                 sizeof(tmp),
+                 "Streaming %s : %ld records, %ld dropped, %ld frames",
+                 m_stream.is_started() ? "started" : "stopped",
+                 static_cast<long>(stats.records),
+                 static_cast<long>(stats.dropped),
+                 static_cast<long>(stats.frames));
+        m_console.write_line(tmp);
+    }
+}
+
+} // namespace ov
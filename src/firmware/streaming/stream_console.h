@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_STREAM_CONSOLE_H
+#define OV_STREAM_CONSOLE_H
+
+#include "i_debug_console.h"
+
+namespace ov
+{
+
+// Forward declarations
+class i_sensor_stream;
+
+/** @brief Console command helpers for the sensor stream */
+class stream_console
+{
+  public:
+    /** @brief Constructor */
+    stream_console(i_debug_console& console, i_sensor_stream& stream);
+
+    /** @brief Register command handlers */
+    void register_handlers();
+
+  private:
+    /** @brief Console */
+    i_debug_console& m_console;
+    /** @brief Sensor stream */
+    i_sensor_stream& m_stream;
+
+    /** @brief Handler for the 'stream' command */
+    ov::i_debug_console::cmd_handler m_stream_handler;
+
+    /** @brief Handler for the 'stream' command */
+    void stream_handler(const char* param);
+};
+
+} // namespace ov
+
+#endif // OV_STREAM_CONSOLE_H
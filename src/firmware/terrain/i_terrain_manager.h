@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_TERRAIN_MANAGER_H
+#define OV_I_TERRAIN_MANAGER_H
+
+#include "terrain_cache.h"
+
+namespace ov
+{
+
+/** @brief Interface for the terrain manager implementation */
+class i_terrain_manager
+{
+  public:
+    /** @brief Destructor */
+    virtual ~i_terrain_manager() { }
+
+    /** @brief Get the statistics of the tile cache */
+    virtual terrain_cache::stats get_stats() = 0;
+
+    /** @brief Reset the statistics of the tile cache */
+    virtual void reset_stats() = 0;
+
+    /** @brief Drop the cached tiles after the tiles have been modified (asynchronous) */
+    virtual void reload() = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_TERRAIN_MANAGER_H
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TERRAIN_H
+#define OV_TERRAIN_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Terrain elevation below the current position */
+struct terrain_status
+{
+    /** @brief Terrain elevation in meters */
+    int16_t elevation;
+    /** @brief Height above ground (1 = 0.1m) */
+    int32_t height;
+    /** @brief Indicate if the status is valid */
+    bool is_valid;
+};
+
+} // namespace ov
+
+#endif // OV_TERRAIN_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "terrain_cache.h"
+
+#include <cmath>
+
+namespace ov
+{
+
+/** @brief Constructor */
+terrain_cache::terrain_cache() : m_entries{}, m_tile{}, m_use_counter(0u), m_stats{} { }
+
+/** @brief Drop all the cached blocks */
+void terrain_cache::clear()
+{
+    for (auto& e : m_entries)
+    {
+        e.is_valid = false;
+    }
+    m_tile = {};
+}
+
+/** @brief Get the terrain elevation at a position */
+bool terrain_cache::get_elevation(const geo::position& pos, uint32_t timestamp, int16_t& elevation)
+{
+    bool ret = false;
+
+    // Tile containing the position (south west corner)
+    constexpr int32_t units = geo::UNITS_PER_DEGREE;
+    const int32_t     lat   = (pos.latitude >= 0) ? (pos.latitude / units) : (((pos.latitude + 1) / units) - 1);
+    const int32_t     lon   = (pos.longitude >= 0) ? (pos.longitude / units) : (((pos.longitude + 1) / units) - 1);
+    if (select_tile(static_cast<int16_t>(lat), static_cast<int16_t>(lon), timestamp))
+    {
+        // Position in sample intervals from the north west corner of the tile
+        const int64_t y      = static_cast<int64_t>((lat + 1) * units - pos.latitude) * m_tile.samples_per_degree;
+        const int64_t x      = static_cast<int64_t>(pos.longitude - lon * units) * m_tile.samples_per_degree;
+        int32_t       row    = static_cast<int32_t>(y / units);
+        int32_t       column = static_cast<int32_t>(x / units);
+        float         dy     = static_cast<float>(y % units) / static_cast<float>(units);
+        float         dx     = static_cast<float>(x % units) / static_cast<float>(units);
+        if (row >= m_tile.samples_per_degree)
+        {
+            // South edge of the tile
+            row = m_tile.samples_per_degree - 1;
+            dy  = 1.f;
+        }
+        if (column >= m_tile.samples_per_degree)
+        {
+            // East edge of the tile
+            column = m_tile.samples_per_degree - 1;
+            dx     = 1.f;
+        }
+
+        // Get block
+        const uint32_t block_row    = static_cast<uint32_t>(row / m_tile.block_size);
+        const uint32_t block_column = static_cast<uint32_t>(column / m_tile.block_size);
+        const entry*   block        = get_block(block_row * m_tile.blocks_per_side + block_column);
+        if (block)
+        {
+            // Bilinear interpolation between the 4 surrounding samples
+            const size_t   stride = m_tile.block_size + 1u;
+            const size_t   index  = static_cast<size_t>(row % m_tile.block_size) * stride + static_cast<size_t>(column % m_tile.block_size);
+            const int16_t* s      = &block->samples[index];
+            const float    north  = static_cast<float>(s[0u]) + dx * static_cast<float>(s[1u] - s[0u]);
+            const float    south  = static_cast<float>(s[stride]) + dx * static_cast<float>(s[stride + 1u] - s[stride]);
+            elevation             = static_cast<int16_t>(std::lround(north + dy * (south - north)));
+            ret                   = true;
+        }
+    }
+    else
+    {
+        m_stats.no_data++;
+    }
+
+    return ret;
+}
+
+/** @brief Select the current tile, returns false if it is not available */
+bool terrain_cache::select_tile(int16_t latitude, int16_t longitude, uint32_t timestamp)
+{
+    // Check if the tile must be opened
+    const bool same_tile = m_tile.is_known && (m_tile.latitude == latitude) && (m_tile.longitude == longitude);
+    if (!same_tile || (!m_tile.is_available && ((timestamp - m_tile.open_timestamp) >= MISSING_TILE_RETRY_MS)))
+    {
+        terrain_tile tile(latitude, longitude);
+
+        m_tile                = {};
+        m_tile.latitude       = latitude;
+        m_tile.longitude      = longitude;
+        m_tile.is_known       = true;
+        m_tile.is_available   = tile.is_open();
+        m_tile.open_timestamp = timestamp;
+        if (m_tile.is_available)
+        {
+            const auto& header        = tile.get_header();
+            m_tile.samples_per_degree = header.samples_per_degree;
+            m_tile.block_size         = header.block_size;
+            m_tile.blocks_per_side    = header.blocks_per_side;
+        }
+    }
+
+    return m_tile.is_available;
+}
+
+/** @brief Get a block of the current tile, loading it if needed */
+const terrain_cache::entry* terrain_cache::get_block(uint32_t block_index)
+{
+    // Look for the block in the cache and for the least recently used entry
+    m_use_counter++;
+    entry* block = nullptr;
+    entry* lru   = &m_entries[0u];
+    for (auto& e : m_entries)
+    {
+        if (e.is_valid && (e.latitude == m_tile.latitude) && (e.longitude == m_tile.longitude) && (e.block_index == block_index))
+        {
+            block = &e;
+            break;
+        }
+        if (!e.is_valid || (lru->is_valid && (e.last_use < lru->last_use)))
+        {
+            lru = &e;
+        }
+    }
+
+    if (block)
+    {
+        m_stats.hits++;
+    }
+    else
+    {
+        // Load the block in place of the least recently used one
+        m_stats.misses++;
+        terrain_tile tile(m_tile.latitude, m_tile.longitude);
+        lru->latitude    = m_tile.latitude;
+        lru->longitude   = m_tile.longitude;
+        lru->block_index = block_index;
+        lru->is_valid =
+            tile.is_open() && (tile.get_header().block_size == m_tile.block_size) && tile.read_block(block_index, lru->samples);
+        if (lru->is_valid)
+        {
+            block = lru;
+        }
+        else
+        {
+            // Tile has been modified or corrupted
+            m_stats.errors++;
+            m_tile.is_available = false;
+        }
+    }
+    if (block)
+    {
+        block->last_use = m_use_counter;
+    }
+
+    return block;
+}
+
+} // namespace ov
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TERRAIN_CACHE_H
+#define OV_TERRAIN_CACHE_H
+
+#include "geodesy.h"
+#include "terrain_tile.h"
+
+namespace ov
+{
+
+/**
+ * @brief LRU cache of decoded terrain blocks
+ *        A lookup in a cached block only costs a bilinear interpolation,
+ *        a miss reads and decodes a single block from the tile file
+ */
+class terrain_cache
+{
+  public:
+    /** @brief Number of blocks in the cache */
+    static constexpr size_t CACHE_SIZE = 4u;
+    /** @brief Delay before trying again to open a missing or invalid tile in milliseconds */
+    static constexpr uint32_t MISSING_TILE_RETRY_MS = 10000u;
+
+    /** @brief Cache statistics */
+    struct stats
+    {
+        /** @brief Number of lookups served from a cached block */
+        uint32_t hits;
+        /** @brief Number of lookups which needed to load a block */
+        uint32_t misses;
+        /** @brief Number of lookups without terrain data */
+        uint32_t no_data;
+        /** @brief Number of blocks which could not be loaded */
+        uint32_t errors;
+    };
+
+    /** @brief Constructor */
+    terrain_cache();
+
+    /** @brief Drop all the cached blocks */
+    void clear();
+
+    /**
+     * @brief Get the terrain elevation at a position
+     * @param pos Position
+     * @param timestamp Current timestamp in milliseconds
+     * @param elevation Interpolated elevation in meters
+     * @return true if terrain data is available for this position
+     */
+    bool get_elevation(const geo::position& pos, uint32_t timestamp, int16_t& elevation);
+
+    /** @brief Get the cache statistics */
+    const stats& get_stats() const { return m_stats; }
+
+    /** @brief Reset the cache statistics */
+    void reset_stats() { m_stats = {}; }
+
+  private:
+    /** @brief Cached block */
+    struct entry
+    {
+        /** @brief Latitude of the tile in degrees */
+        int16_t latitude;
+        /** @brief Longitude of the tile in degrees */
+        int16_t longitude;
+        /** @brief Index of the block in the tile */
+        uint32_t block_index;
+        /** @brief Value of the use counter on last access */
+        uint32_t last_use;
+        /** @brief Indicate if the entry contains a valid block */
+        bool is_valid;
+        /** @brief Decoded samples */
+        int16_t samples[terrain_tile::MAX_BLOCK_SAMPLES];
+    };
+
+    /** @brief Description of the current tile */
+    struct tile_info
+    {
+        /** @brief Latitude of the tile in degrees */
+        int16_t latitude;
+        /** @brief Longitude of the tile in degrees */
+        int16_t longitude;
+        /** @brief Indicate if the tile has been opened at least once */
+        bool is_known;
+        /** @brief Indicate if the tile is available */
+        bool is_available;
+        /** @brief Timestamp of the last opening attempt in milliseconds */
+        uint32_t open_timestamp;
+        /** @brief Number of sample intervals per degree */
+        uint16_t samples_per_degree;
+        /** @brief Number of sample intervals on each side of a block */
+        uint16_t block_size;
+        /** @brief Number of blocks on each side of the tile */
+        uint16_t blocks_per_side;
+    };
+
+    /** @brief Cached blocks */
+    entry m_entries[CACHE_SIZE];
+    /** @brief Current tile */
+    tile_info m_tile;
+    /** @brief Use counter to find the least recently used entry */
+    uint32_t m_use_counter;
+    /** @brief Statistics */
+    stats m_stats;
+
+    /** @brief Select the current tile, returns false if it is not available */
+    bool select_tile(int16_t latitude, int16_t longitude, uint32_t timestamp);
+
+    /** @brief Get a block of the current tile, loading it if needed */
+    const entry* get_block(uint32_t block_index);
+};
+
+} // namespace ov
+
+#endif // OV_TERRAIN_CACHE_H
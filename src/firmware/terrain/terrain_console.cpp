@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "terrain_console.h"
+#include "i_terrain_manager.h"
+#include "ov_data.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Constructor */
+terrain_console::terrain_console(i_debug_console& console, i_terrain_manager& terrain)
+    : m_console(console),
+      m_terrain(terrain),
+      m_terrain_handler{"terrain",
+                        "Display the terrain elevation and the tile cache statistics, 'terrain reset' resets the statistics",
+                        ov::handler_func::create<terrain_console, &terrain_console::terrain_handler>(*this),
+                        nullptr,
+                        false}
+{
+}
+
+/** @brief Register command handlers */
+void terrain_console::register_handlers()
+{
+    m_console.register_handler(m_terrain_handler);
+}
+
+/** @brief Handler for the 'terrain' command */
+void terrain_console::terrain_handler(const char* param)
+{
+    if (param && (strcmp(param, "reset") == 0))
+    {
+        m_terrain.reset_stats();
+        m_console.write_line("Statistics reset");
+    }
+    else
+    {
+        // Elevation
+        char tmp[96u];
+        auto terrain = ov::data::get_terrain();
+        if (terrain.is_valid)
+        {
+            snprintf(tmp,
+                     sizeof(tmp),
+                     "Elevation : %dm, height above ground : %ldm",
+                     static_cast<int>(terrain.elevation),
+                     static_cast<long>(terrain.height / 10));
+            m_console.write_line(tmp);
+        }
+        else
+        {
+            m_console.write_line("Elevation : unavailable");
+        }
+
+        // Cache statistics
+        auto stats = m_terrain.get_stats();
+        snprintf(tmp,
+                 sizeof(tmp),
+                 "Cache : %ld hits, %ld misses, %ld without data, %ld errors",
+                 static_cast<long>(stats.hits),
+                 static_cast<long>(stats.misses),
+                 static_cast<long>(stats.no_data),
+                 static_cast<long>(stats.errors));
+        m_console.write_line(tmp);
+    }
+}
+
+} // namespace ov
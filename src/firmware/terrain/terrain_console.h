@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TERRAIN_CONSOLE_H
+#define OV_TERRAIN_CONSOLE_H
+
+#include "i_debug_console.h"
+
+namespace ov
+{
+
+// Forward declarations
+class i_terrain_manager;
+
+/** @brief Console command helpers for the terrain manager */
+class terrain_console
+{
+  public:
+    /** @brief Constructor */
+    terrain_console(i_debug_console& console, i_terrain_manager& terrain);
+
+    /** @brief Register command handlers */
+    void register_handlers();
+
+  private:
+    /** @brief Console */
+    i_debug_console& m_console;
+    /** @brief Terrain manager */
+    i_terrain_manager& m_terrain;
+
+    /** @brief Handler for the 'terrain' command */
+    ov::i_debug_console::cmd_handler m_terrain_handler;
+
+    /** @brief Handler for the 'terrain' command */
+    void terrain_handler(const char* param);
+};
+
+} // namespace ov
+
+#endif // OV_TERRAIN_CONSOLE_H
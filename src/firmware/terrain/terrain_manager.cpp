@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "terrain_manager.h"
+#include "fs.h"
+#include "os.h"
+#include "ov_data.h"
+
+namespace ov
+{
+
+/** @brief Period of the terrain lookups in milliseconds */
+static const uint32_t LOOKUP_PERIOD_MS = 250u;
+
+/** @brief Constructor */
+terrain_manager::terrain_manager() : m_reload_requested(false), m_cache(), m_thread() { }
+
+/** @brief Initialize the terrain manager */
+bool terrain_manager::init()
+{
+    bool ret = true;
+
+    // Create the directory to store the terrain tiles
+    dir storage_dir = fs::open_dir(terrain_tile::TERRAIN_DIR);
+    if (!storage_dir.is_open())
+    {
+        ret = fs::mkdir(terrain_tile::TERRAIN_DIR);
+    }
+
+    if (ret)
+    {
+        // Start terrain thread
+        auto thread_func = ov::thread_func::create<terrain_manager, &terrain_manager::thread_func>(*this);
+        ret              = m_thread.start(thread_func, "Terrain", 2u, nullptr);
+    }
+
+    return ret;
+}
+
+/** @brief Terrain thread */
+void terrain_manager::thread_func(void*)
+{
+    // Thread loop
+    while (true)
+    {
+        // Drop modified tiles
+        if (m_reload_requested)
+        {
+            m_reload_requested = false;
+            m_cache.clear();
+        }
+
+        // Lookup terrain elevation below the current position
+        ov_data        data    = ov::data::get();
+        terrain_status terrain = {};
+        if (data.gnss.is_valid && m_cache.get_elevation(data.gnss.get_position(), ov::os::now(), terrain.elevation))
+        {
+            terrain.height   = data.altimeter.altitude - static_cast<int32_t>(terrain.elevation) * 10;
+            terrain.is_valid = data.altimeter.is_valid;
+        }
+        ov::data::set_terrain(terrain);
+
+        ov::this_thread::sleep_for(LOOKUP_PERIOD_MS);
+    }
+}
+
+} // namespace ov
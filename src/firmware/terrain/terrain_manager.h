@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TERRAIN_MANAGER_H
+#define OV_TERRAIN_MANAGER_H
+
+#include "i_terrain_manager.h"
+#include "thread.h"
+
+namespace ov
+{
+
+/**
+ * @brief Terrain manager
+ *        Tiles are loaded from its own thread so that a slow flash access
+ *        never delays the sensor acquisition
+ */
+class terrain_manager : public i_terrain_manager
+{
+  public:
+    /** @brief Constructor */
+    terrain_manager();
+
+    /** @brief Initialize the terrain manager */
+    bool init();
+
+    /** @brief Get the statistics of the tile cache */
+    terrain_cache::stats get_stats() override { return m_cache.get_stats(); }
+
+    /** @brief Reset the statistics of the tile cache */
+    void reset_stats() override { m_cache.reset_stats(); }
+
+    /** @brief Drop the cached tiles after the tiles have been modified (asynchronous) */
+    void reload() override { m_reload_requested = true; }
+
+  private:
+    /** @brief Indicate that the cached tiles must be dropped */
+    bool m_reload_requested;
+    /** @brief Tile cache */
+    terrain_cache m_cache;
+    /** @brief Terrain thread */
+    thread<2048u> m_thread;
+
+    /** @brief Terrain thread */
+    void thread_func(void*);
+};
+
+} // namespace ov
+
+#endif // OV_TERRAIN_MANAGER_H
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "terrain_tile.h"
+#include "fs.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace ov
+{
+
+/** @brief Constructor, opens the tile with the given south west corner */
+terrain_tile::terrain_tile(int16_t latitude, int16_t longitude) : m_header{}, m_file(open(latitude, longitude))
+{
+    // Read header
+    if (is_open())
+    {
+        bool is_valid = m_file.read(m_header);
+        is_valid      = is_valid && (m_header.magic == header::MAGIC_NUMBER) && (m_header.version == header::VERSION);
+        is_valid      = is_valid && (m_header.latitude == latitude) && (m_header.longitude == longitude);
+        is_valid      = is_valid && (m_header.block_size > 0u) && (m_header.block_size <= MAX_BLOCK_SIZE);
+        is_valid      = is_valid && ((m_header.block_size * m_header.blocks_per_side) == m_header.samples_per_degree);
+        if (!is_valid)
+        {
+            m_file.close();
+        }
+    }
+}
+
+/** @brief Read and decode a block, samples must be able to store MAX_BLOCK_SAMPLES */
+bool terrain_tile::read_block(uint32_t block_index, int16_t* samples)
+{
+    bool ret = false;
+
+    if (block_index < (static_cast<uint32_t>(m_header.blocks_per_side) * m_header.blocks_per_side))
+    {
+        // Read block descriptor
+        block_desc desc;
+        int32_t    new_offset = 0;
+        ret = m_file.seek(static_cast<int32_t>(sizeof(header) + block_index * sizeof(block_desc)), file::seek_set, new_offset);
+        ret = ret && m_file.read(desc);
+        ret = ret && m_file.seek(static_cast<int32_t>(desc.offset), file::seek_set, new_offset);
+        if (ret)
+        {
+            // Decode samples
+            const size_t stride = m_header.block_size + 1u;
+            const size_t count  = stride * stride;
+            if (desc.enc == encoding::raw)
+            {
+                size_t read_count = 0;
+                ret               = (desc.size == (count * sizeof(int16_t)));
+                ret               = ret && m_file.read(samples, desc.size, read_count) && (read_count == desc.size);
+            }
+            else if (desc.enc == encoding::delta)
+            {
+                ret = decode_delta(samples, stride, desc.size);
+            }
+            else
+            {
+                ret = false;
+            }
+        }
+    }
+
+    return ret;
+}
+
+/** @brief Build the path of the tile with the given south west corner (ex: /terrain/N45E005.ter) */
+void terrain_tile::get_path(int16_t latitude, int16_t longitude, char (&path)[MAX_PATH_SIZE])
+{
+    snprintf(path,
+             sizeof(path),
+             "%s/%c%02d%c%03d.ter",
+             TERRAIN_DIR,
+             (latitude < 0) ? 'S' : 'N',
+             abs(latitude),
+             (longitude < 0) ? 'W' : 'E',
+             abs(longitude));
+}
+
+/** @brief Open the file of the tile with the given south west corner */
+file terrain_tile::open(int16_t latitude, int16_t longitude)
+{
+    char path[MAX_PATH_SIZE];
+    get_path(latitude, longitude, path);
+    return ov::fs::open(path, ov::fs::o_rdonly);
+}
+
+/** @brief Decode a delta encoded block */
+bool terrain_tile::decode_delta(int16_t* samples, size_t stride, size_t size)
+{
+    bool ret = true;
+
+    // Each sample is relative to the previous one on the row, the first sample
+    // of a row is relative to the first sample of the previous row
+    const size_t count        = stride * stride;
+    uint8_t      buffer[64u]  = {};
+    size_t       buffer_count = 0u;
+    size_t       buffer_index = 0u;
+    size_t       remaining    = size;
+    size_t       index        = 0u;
+    bool         escaped      = false;
+    uint8_t      escaped_lsb  = 0u;
+    uint8_t      escaped_step = 0u;
+    while (ret && (index < count))
+    {
+        // Refill buffer
+        if (buffer_index == buffer_count)
+        {
+            size_t to_read = sizeof(buffer);
+            if (to_read > remaining)
+            {
+                to_read = remaining;
+            }
+            remaining -= to_read;
+            ret          = (to_read != 0u) && m_file.read(buffer, to_read, buffer_count) && (buffer_count == to_read);
+            buffer_index = 0u;
+        }
+        if (ret)
+        {
+            const uint8_t value = buffer[buffer_index];
+            buffer_index++;
+            if (escaped)
+            {
+                // Raw 16 bits sample, little endian
+                if (escaped_step == 0u)
+                {
+                    escaped_lsb  = value;
+                    escaped_step = 1u;
+                }
+                else
+                {
+                    samples[index] = static_cast<int16_t>(static_cast<uint16_t>(escaped_lsb) | (static_cast<uint16_t>(value) << 8u));
+                    index++;
+                    escaped      = false;
+                    escaped_step = 0u;
+                }
+            }
+            else if (static_cast<int8_t>(value) == DELTA_ESCAPE)
+            {
+                escaped = true;
+            }
+            else
+            {
+                int16_t reference = 0;
+                if (index >= stride)
+                {
+                    reference = ((index % stride) == 0u) ? samples[index - stride] : samples[index - 1u];
+                }
+                else if (index != 0u)
+                {
+                    reference = samples[index - 1u];
+                }
+                else
+                {
+                    // First sample is relative to 0
+                }
+                samples[index] = static_cast<int16_t>(reference + static_cast<int8_t>(value));
+                index++;
+            }
+        }
+    }
+
+    return ret;
+}
+
+} // namespace ov
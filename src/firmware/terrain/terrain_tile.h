@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TERRAIN_TILE_H
+#define OV_TERRAIN_TILE_H
+
+#include "file.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Read access to a terrain tile file
+ *        A tile covers 1° x 1° and is split in square blocks of elevation samples which can be
+ *        decoded independently. Each block contains its border samples so that a bilinear
+ *        interpolation never needs a neighbour block. Samples are stored row by row from north
+ *        to south and from west to east, either raw or delta encoded.
+ */
+class terrain_tile
+{
+  public:
+    /** @brief Directory to store the terrain tiles */
+    static constexpr const char* TERRAIN_DIR = "/terrain";
+    /** @brief Maximum size of a tile path, large enough for any 16 bits coordinates */
+    static constexpr size_t MAX_PATH_SIZE = 32u;
+    /** @brief Maximum number of intervals on each side of a block */
+    static constexpr uint16_t MAX_BLOCK_SIZE = 40u;
+    /** @brief Maximum number of samples in a block */
+    static constexpr size_t MAX_BLOCK_SAMPLES = (MAX_BLOCK_SIZE + 1u) * (MAX_BLOCK_SIZE + 1u);
+
+    /** @brief Tile header */
+    struct header
+    {
+        /** @brief Magic number */
+        uint32_t magic;
+        /** @brief Format version */
+        uint16_t version;
+        /** @brief Latitude of the south edge in degrees */
+        int16_t latitude;
+        /** @brief Longitude of the west edge in degrees */
+        int16_t longitude;
+        /** @brief Number of sample intervals per degree */
+        uint16_t samples_per_degree;
+        /** @brief Number of sample intervals on each side of a block */
+        uint16_t block_size;
+        /** @brief Number of blocks on each side of the tile */
+        uint16_t blocks_per_side;
+
+        /** @brief Magic number value */
+        static constexpr uint32_t MAGIC_NUMBER = 0x7E88A1E5u;
+        /** @brief Current format version */
+        static constexpr uint16_t VERSION = 1u;
+    };
+
+    /** @brief Block encodings */
+    enum class encoding : uint8_t
+    {
+        /** @brief Raw 16 bits samples */
+        raw,
+        /** @brief 8 bits deltas from the previous sample, escape value followed by a raw 16 bits sample */
+        delta
+    };
+
+    /** @brief Escape value of the delta encoding */
+    static constexpr int8_t DELTA_ESCAPE = -128;
+
+    /** @brief Block descriptor, the block table follows the header */
+    struct block_desc
+    {
+        /** @brief Offset of the block data from the start of the file */
+        uint32_t offset;
+        /** @brief Size of the block data in bytes */
+        uint16_t size;
+        /** @brief Encoding */
+        encoding enc;
+        /** @brief Padding */
+        uint8_t reserved;
+    };
+
+    /** @brief Constructor, opens the tile with the given south west corner */
+    terrain_tile(int16_t latitude, int16_t longitude);
+
+    /** @brief Indicate if the tile is valid */
+    bool is_open() const { return m_file.is_open(); }
+
+    /** @brief Get the tile header */
+    const header& get_header() const { return m_header; }
+
+    /** @brief Read and decode a block, samples must be able to store MAX_BLOCK_SAMPLES */
+    bool read_block(uint32_t block_index, int16_t* samples);
+
+    /** @brief Build the path of the tile with the given south west corner (ex: /terrain/N45E005.ter) */
+    static void get_path(int16_t latitude, int16_t longitude, char (&path)[MAX_PATH_SIZE]);
+
+  private:
+    /** @brief Tile header */
+    header m_header;
+    /** @brief Tile file */
+    file m_file;
+
+    /** @brief Open the file of the tile with the given south west corner */
+    static file open(int16_t latitude, int16_t longitude);
+
+    /** @brief Decode a delta encoded block */
+    bool decode_delta(int16_t* samples, size_t stride, size_t size);
+};
+
+} // namespace ov
+
+#endif // OV_TERRAIN_TILE_H
@@ -7,6 +7,7 @@
 #define OV_I_XCTRACK_LINK_H
 
 #include "i_usb_cdc.h"
+#include "polar.h"
 
 namespace ov
 {
@@ -15,9 +16,47 @@ namespace ov
 class i_xctrack_link
 {
   public:
+    /** @brief Instrument data sample */
+    struct sample
+    {
+        /** @brief Pressure (1 = 0.01mbar) */
+        int32_t pressure;
+        /** @brief Filtered altitude (1 = 0.1m) */
+        int32_t altitude;
+        /** @brief Filtered vertical speed (1 = 0.1m/s) */
+        int16_t vario;
+        /** @brief Temperature (1 = 0.1°C) */
+        int16_t temperature;
+        /** @brief Acceleration on X (1000 = 1g) */
+        int16_t x_accel;
+        /** @brief Acceleration on Y (1000 = 1g) */
+        int16_t y_accel;
+        /** @brief Acceleration on Z (1000 = 1g) */
+        int16_t z_accel;
+        /** @brief Total acceleration (1000 = 1g) */
+        int16_t total_accel;
+        /** @brief Indicate if the barometric data is valid */
+        bool is_baro_valid;
+        /** @brief Indicate if the acceleration data is valid */
+        bool is_accel_valid;
+        /** @brief Speed to fly and final glide */
+        polar_status polar;
+        /** @brief Total energy vertical speed (1 = 0.1m/s) */
+        int16_t te_vario;
+        /** @brief Netto vertical speed (1 = 0.1m/s) */
+        int16_t netto_vario;
+        /** @brief Indicate if the total energy vertical speed is valid */
+        bool is_te_valid;
+        /** @brief Indicate if the netto vertical speed is valid */
+        bool is_netto_valid;
+    };
+
     /** @brief Destructor */
     virtual ~i_xctrack_link() { }
 
+    /** @brief Publish a new sample, it is sent as soon as the configured maximum rate allows it (never blocks) */
+    virtual void publish(const sample& data) = 0;
+
     /** @brief Get the USB CDC link */
     virtual i_usb_cdc& get_usb() = 0;
 
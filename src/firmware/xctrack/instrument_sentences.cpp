@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "instrument_sentences.h"
+#include "nmea_sentence.h"
+
+namespace ov
+{
+namespace instrument
+{
+
+/** @brief LK8EX1 sentence prefix */
+static constexpr const char* LK8EX1_PREFIX = "$LK8EX1,";
+/** @brief LK8EX1 sentence prefix checksum */
+static constexpr uint8_t LK8EX1_CHECKSUM = nmea_sentence::checksum(LK8EX1_PREFIX);
+/** @brief LXWP0 sentence prefix, the logger is reported as not recording */
+static constexpr const char* LXWP0_PREFIX = "$LXWP0,N,,";
+/** @brief LXWP0 sentence prefix checksum */
+static constexpr uint8_t LXWP0_CHECKSUM = nmea_sentence::checksum(LXWP0_PREFIX);
+/** @brief PCPROBE sentence prefix, the orientation is not measured and is sent as the identity quaternion */
+static constexpr const char* PCPROBE_PREFIX = "$PCPROBE,T,03E8,0000,0000,0000,";
+/** @brief PCPROBE sentence prefix checksum */
+static constexpr uint8_t PCPROBE_CHECKSUM = nmea_sentence::checksum(PCPROBE_PREFIX);
+
+/** @brief Write a LK8EX1 sentence, return its length or 0 if it could not be written */
+size_t write_lk8ex1(const i_xctrack_link::sample& data, char* buffer, size_t size)
+{
+    // Use LK8000 protocol => https://github.com/LK8000/LK8000/blob/master/Docs/LK8EX1.txt
+    // $LK8EX1,pressure,altitude,vario,temperature,battery,*checksum
+    // Pressure in Pa, altitude in m, vario in cm/s, temperature in °C, 999 = battery not available
+
+    nmea_sentence sentence(buffer, size, LK8EX1_PREFIX, LK8EX1_CHECKSUM);
+    if (data.is_baro_valid)
+    {
+        sentence.fields()
+            .write_int(data.pressure)
+            .write(',')
+            .write_int(data.altitude / 10)
+            .write(',')
+            .write_int(data.vario * 10)
+            .write(',')
+            .write_int(data.temperature / 10)
+            .write(",999,");
+    }
+    else
+    {
+        sentence.fields().write("999999,99999,9999,99,999,");
+    }
+
+    return sentence.finish();
+}
+
+/** @brief Write a LXWP0 sentence, return its length or 0 if it could not be written */
+size_t write_lxwp0(const i_xctrack_link::sample& data, char* buffer, size_t size)
+{
+    // $LXWP0,logger,IAS,altitude,vario1,vario2,vario3,vario4,vario5,vario6,heading,wind direction,wind speed*checksum
+    // Altitude in m, vario in m/s, the unavailable fields are left empty
+
+    size_t ret = 0u;
+    if (data.is_baro_valid)
+    {
+        nmea_sentence sentence(buffer, size, LXWP0_PREFIX, LXWP0_CHECKSUM);
+        sentence.fields().write_fixed(data.altitude, 1u).write(',').write_fixed(data.vario, 1u).write(",,,,,,,,");
+        ret = sentence.finish();
+    }
+
+    return ret;
+}
+
+/** @brief Write a PCPROBE sentence, return its length or 0 if it could not be written */
+size_t write_pcprobe(const i_xctrack_link::sample& data, char* buffer, size_t size)
+{
+    // $PCPROBE,T,Q0,Q1,Q2,Q3,ax,ay,az,temp,rh,batt,delta_press,abs_press,C,*checksum
+    // Signed 16 bits hexadecimal fields except abs_press (24 bits) : accelerations in 1/1000 g, temperature in 1/10 °C,
+    // humidity in 1/10 %, battery in %, differential pressure in 1/10 Pa, absolute pressure in 1/400 hPa
+
+    size_t ret = 0u;
+    if (data.is_baro_valid && data.is_accel_valid)
+    {
+        nmea_sentence sentence(buffer, size, PCPROBE_PREFIX, PCPROBE_CHECKSUM);
+        sentence.fields()
+            .write_hex(static_cast<uint16_t>(data.x_accel), 4u)
+            .write(',')
+            .write_hex(static_cast<uint16_t>(data.y_accel), 4u)
+            .write(',')
+            .write_hex(static_cast<uint16_t>(data.z_accel), 4u)
+            .write(',')
+            .write_hex(static_cast<uint16_t>(data.temperature), 4u)
+            .write(",0000,0000,0000,")
+            .write_hex(static_cast<uint32_t>(data.pressure * 4) & 0x00FFFFFFu, 6u)
+            .write(",,");
+        ret = sentence.finish();
+    }
+
+    return ret;
+}
+
+/** @brief Write a XCTOD sentence, return its length or 0 if it could not be written */
+size_t write_xctod(const i_xctrack_link::sample& data, char* buffer, size_t size)
+{
+    // XCTrack custom fields => https://xctrack.org/Competition_Interfaces.html
+    // $XCTOD,field1,field2,...,field50[\r]\n
+    // $XCTOD,acceleration,temperature,speed to fly,polar sink,final glide altitude,total energy vario,netto vario\r\n
+
+    // Acceleration is sent in g with 2 decimals, speed to fly in km/h, polar sink, total energy and netto varios in m/s
+    // and final glide altitude in m, the polar and energy fields are left empty when they are not available
+    text_writer sentence(buffer, size);
+    sentence.write("$XCTOD,")
+        .write_fixed((data.is_accel_valid ? data.total_accel : 9990) / 10, 2u)
+        .write(',')
+        .write_int(data.is_baro_valid ? (data.temperature / 10) : 99)
+        .write(',');
+    if (data.polar.is_valid)
+    {
+        sentence.write_int((data.polar.speed_to_fly * 36u + 50u) / 100u);
+    }
+    sentence.write(',');
+    if (data.polar.is_valid && data.polar.is_polar_sink_valid)
+    {
+        sentence.write_fixed(data.polar.polar_sink, 1u);
+    }
+    sentence.write(',');
+    if (data.polar.is_valid && data.polar.is_final_glide_valid)
+    {
+        sentence.write_int(data.polar.final_glide_altitude / 10u);
+    }
+    sentence.write(',');
+    if (data.is_te_valid)
+    {
+        sentence.write_fixed(data.te_vario, 1u);
+    }
+    sentence.write(',');
+    if (data.is_netto_valid)
+    {
+        sentence.write_fixed(data.netto_vario, 1u);
+    }
+    sentence.write("\r\n");
+
+    return (sentence.is_truncated() ? 0u : sentence.size());
+}
+
+/** @brief Write a sentence received from the GNSS without its start of frame and checksum, return its length or 0 on error */
+size_t write_gnss(const char* gnss_sentence, size_t gnss_size, char* buffer, size_t size)
+{
+    nmea_sentence sentence(buffer, size, "$", 0u);
+    for (size_t i = 0; i < gnss_size; i++)
+    {
+        sentence.fields().write(gnss_sentence[i]);
+    }
+    return sentence.finish();
+}
+
+/** @brief Write the sentences of the selected protocols, return their total length */
+size_t write_sentences(uint8_t protocols, const i_xctrack_link::sample& data, char* buffer, size_t size)
+{
+    using writer_func = size_t (*)(const i_xctrack_link::sample&, char*, size_t);
+    static const struct
+    {
+        instrument_protocol protocol;
+        writer_func         write;
+    } WRITERS[] = {{instrument_protocol::lk8ex1, &write_lk8ex1},
+                   {instrument_protocol::lxwp0, &write_lxwp0},
+                   {instrument_protocol::pcprobe, &write_pcprobe},
+                   {instrument_protocol::xctod, &write_xctod}};
+
+    // Sentences are written one after the other in the same buffer
+    size_t length = 0u;
+    for (const auto& writer : WRITERS)
+    {
+        if ((protocols & static_cast<uint8_t>(writer.protocol)) != 0u)
+        {
+            length += writer.write(data, &buffer[length], size - length);
+        }
+    }
+
+    return length;
+}
+
+} // namespace instrument
+} // namespace ov
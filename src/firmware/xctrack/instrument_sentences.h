@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_INSTRUMENT_SENTENCES_H
+#define OV_INSTRUMENT_SENTENCES_H
+
+#include "i_xctrack_link.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Protocols of the sentences sent to the external instruments, used as bit flags in the configuration */
+enum class instrument_protocol : uint8_t
+{
+    /** @brief LK8000 external instrument : pressure, altitude, vario and temperature */
+    lk8ex1 = 0x01u,
+    /** @brief LX Navigation : altitude and vario */
+    lxwp0 = 0x02u,
+    /** @brief Compass C-Probe : accelerations, temperature and pressure */
+    pcprobe = 0x04u,
+    /** @brief XCTrack custom fields : acceleration and temperature */
+    xctod = 0x08u,
+    /** @brief Passthrough of the sentences received from the GNSS */
+    gnss = 0x10u
+};
+
+namespace instrument
+{
+
+/** @brief Write a LK8EX1 sentence, return its length or 0 if it could not be written */
+size_t write_lk8ex1(const i_xctrack_link::sample& data, char* buffer, size_t size);
+
+/** @brief Write a LXWP0 sentence, return its length or 0 if it could not be written */
+size_t write_lxwp0(const i_xctrack_link::sample& data, char* buffer, size_t size);
+
+/** @brief Write a PCPROBE sentence, return its length or 0 if it could not be written */
+size_t write_pcprobe(const i_xctrack_link::sample& data, char* buffer, size_t size);
+
+/** @brief Write a XCTOD sentence, return its length or 0 if it could not be written */
+size_t write_xctod(const i_xctrack_link::sample& data, char* buffer, size_t size);
+
+/** @brief Write a sentence received from the GNSS without its start of frame and checksum, return its length or 0 on error */
+size_t write_gnss(const char* gnss_sentence, size_t gnss_size, char* buffer, size_t size);
+
+/** @brief Write the sentences of the selected protocols, return their total length */
+size_t write_sentences(uint8_t protocols, const i_xctrack_link::sample& data, char* buffer, size_t size);
+
+} // namespace instrument
+} // namespace ov
+
+#endif // OV_INSTRUMENT_SENTENCES_H
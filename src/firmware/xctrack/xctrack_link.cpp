@@ -4,116 +4,159 @@
  */
 
 #include "xctrack_link.h"
+#include "instrument_sentences.h"
+#include "lock_guard.h"
 #include "os.h"
-#include "ov_data.h"
 
-#include <cstdio>
 #include <cstring>
 
 namespace ov
 {
 
 /** @brief Constructor */
-xctrack_link::xctrack_link(i_usb_cdc& usb) : m_usb(usb), m_is_active(true), m_thread() { }
+xctrack_link::xctrack_link(i_usb_cdc& usb)
+    : m_usb(usb),
+      m_serial(nullptr),
+      m_is_active(true),
+      m_sample{},
+      m_protocols(0u),
+      m_rate(1u),
+      m_has_sample(false),
+      m_gnss_sentences{},
+      m_gnss_size(0u),
+      m_mutex(),
+      m_sample_sem(0u, 1u),
+      m_sentences{},
+      m_thread()
+{
+}
 
-/** @brief Initialize the maintenance */
+/** @brief Initialize the link */
 bool xctrack_link::init()
 {
+    // Cache the output settings, they are read for each sentence and each sample
+    const ov_config config = ov::config::get();
+    m_protocols            = config.instr_protocols;
+    m_rate                 = config.instr_rate;
+    bool ret               = ov::config::subscribe(ov::config::listener::create<xctrack_link, &xctrack_link::on_config_changed>(*this));
+
     // Start XCTrack thread
     auto thread_func = ov::thread_func::create<xctrack_link, &xctrack_link::thread_func>(*this);
-    bool ret         = m_thread.start(thread_func, "XCTrack", 6u, nullptr);
+    ret              = ret && m_thread.start(thread_func, "XCTrack", 6u, nullptr);
 
     return ret;
 }
 
-/** @brief Maintenance thread */
-void xctrack_link::thread_func(void*)
+/** @brief Publish a new sample, it is sent as soon as the configured maximum rate allows it (never blocks) */
+void xctrack_link::publish(const sample& data)
 {
-    // Thread loop
-    while (true)
     {
-        // Check active state
-        if (m_is_active)
-        {
-            // Check USB link status
-            if (m_usb.is_link_up())
-            {
-                // Send data to XCTrack
-                send_barometric_data();
-                send_custom_data();
-            }
-        }
-
-        // Periodicity
-        ov::this_thread::sleep_for(250u);
+        lock_guard<mutex> lock(m_mutex);
+        m_sample     = data;
+        m_has_sample = true;
     }
+    m_sample_sem.release();
 }
 
-/** @brief Send barometric data */
-void xctrack_link::send_barometric_data()
+/** @brief Forward a sentence received from the GNSS, without start of frame and checksum (never blocks) */
+void xctrack_link::forward_gnss_sentence(const char* sentence, size_t size)
 {
-    // Use LK8000 protocol => https://github.com/LK8000/LK8000/blob/master/Docs/LK8EX1.txt
-    // $LK8EX1,pressure,altitude,vario,temperature,battery,*checksum
-    // $LK8EX1,pressure,99999,9999,temp,999,*checksum
-    static const char* lk8000_frame_format = "$LK8EX1,%d,99999,9999,%d,999,";
-
-    // Get barometric data
-    auto baro_data = ov::data::get_altimeter();
-    if (!baro_data.is_valid)
+    if ((m_protocols & static_cast<uint8_t>(instrument_protocol::gnss)) != 0u)
     {
-        baro_data.pressure    = 999999;
-        baro_data.temperature = 999;
+        // The sentence is dropped if the previous ones have not been sent yet
+        bool added = false;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            size_t length = instrument::write_gnss(sentence, size, &m_gnss_sentences[m_gnss_size], MAX_GNSS_SIZE - m_gnss_size);
+            m_gnss_size += length;
+            added = (length != 0u);
+        }
+        if (added)
+        {
+            m_sample_sem.release();
+        }
     }
+}
 
-    // Prepare frame
-    char lk8000_frame[64u];
-    int  lk8000_frame_size =
-        snprintf(lk8000_frame, sizeof(lk8000_frame), lk8000_frame_format, baro_data.pressure, (baro_data.temperature / 10));
+/** @brief XCTrack thread */
+void xctrack_link::thread_func(void*)
+{
+    uint32_t last_sent = os::now();
 
-    // Compute checksum
-    char checksum = 0u;
-    for (int i = 1; i < lk8000_frame_size; i++)
+    // Thread loop
+    while (true)
     {
-        checksum ^= lk8000_frame[i];
+        // Wait for a new sample or GNSS sentence
+        m_sample_sem.take();
+
+        // Forward the GNSS sentences right away
+        static_assert(MAX_GNSS_SIZE <= MAX_SENTENCES_SIZE, "GNSS sentences are sent from the sentences buffer");
+        size_t size = 0u;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            size = m_gnss_size;
+            memcpy(m_sentences, m_gnss_sentences, size);
+            m_gnss_size = 0u;
+        }
+        if (size != 0u)
+        {
+            send(m_sentences, size);
+        }
+
+        // Limit the output rate of the samples, the latest sample is sent at the end of the period
+        bool has_sample = false;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            has_sample = m_has_sample;
+        }
+        if (has_sample)
+        {
+            const uint8_t  rate       = m_rate;
+            const uint32_t min_period = 1000u / ((rate != 0u) ? rate : 1u);
+            const uint32_t elapsed    = os::now() - last_sent;
+            if (elapsed < min_period)
+            {
+                ov::this_thread::sleep_for(min_period - elapsed);
+            }
+
+            // Encode the sentences of the selected protocols
+            sample data;
+            {
+                lock_guard<mutex> lock(m_mutex);
+                data         = m_sample;
+                m_has_sample = false;
+            }
+            size = instrument::write_sentences(m_protocols, data, m_sentences, sizeof(m_sentences));
+
+            // Send all the sentences at once on each output
+            if (size != 0u)
+            {
+                send(m_sentences, size);
+                last_sent = os::now();
+            }
+        }
     }
-    char checksum_str[12u];
-    snprintf(checksum_str, sizeof(checksum_str), "*%X\r\n", static_cast<int>(checksum));
-    strcat(lk8000_frame, checksum_str);
+}
 
-    // Send frame
-    m_usb.write(lk8000_frame);
+/** @brief Called when the configuration has changed */
+void xctrack_link::on_config_changed(const ov_config& new_config, const ov_config&)
+{
+    m_protocols = new_config.instr_protocols;
+    m_rate      = new_config.instr_rate;
 }
 
-/** @brief Send custom data */
-void xctrack_link::send_custom_data()
+/** @brief Send data on each active output */
+void xctrack_link::send(const char* data, size_t size)
 {
-    // Use LK8000 protocol => https://github.com/LK8000/LK8000/blob/master/Docs/LK8EX1.txt
-    // $XCTOD,field1,field2,...,field50[\r]\n
-    // $XCTOD,acceleration,temperature\r\n
-    static const char* xctod_frame_format = "$XCTOD,%d.%02d,%d\r\n";
-
-    // Get acceleration
-    auto accel_data = ov::data::get_accelerometer();
-    if (!accel_data.is_valid)
+    if (m_is_active && m_usb.is_link_up())
     {
-        accel_data.total_accel = 999;
+        m_usb.write(data, size);
     }
-    uint16_t accel = accel_data.total_accel / 1000u;
-    uint16_t part  = (accel_data.total_accel - accel * 1000u) / 10u;
-
-    // Get temperature
-    auto baro_data = ov::data::get_altimeter();
-    if (!baro_data.is_valid)
+    i_serial* serial_output = m_serial;
+    if (serial_output != nullptr)
     {
-        baro_data.temperature = 99;
+        serial_output->write(data, size);
     }
-
-    // Prepare frame
-    char xctod_frame[64u];
-    snprintf(xctod_frame, sizeof(xctod_frame), xctod_frame_format, accel, part, baro_data.temperature / 10);
-
-    // Send frame
-    m_usb.write(xctod_frame);
 }
 
 } // namespace ov
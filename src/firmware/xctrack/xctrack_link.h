@@ -7,12 +7,20 @@
 #define OV_XCTRACK_LINK_H
 
 #include "i_xctrack_link.h"
+#include "mutex.h"
+#include "ov_config.h"
+#include "semaphore.h"
 #include "thread.h"
 
 namespace ov
 {
 
-/** @brief Handle the link with the XCTrack application */
+/**
+ * @brief Handle the link with the XCTrack application and the other external instruments
+ *        Each published sample is sent right away in the sentences of the configured protocols,
+ *        over the USB CDC link and an optional serial output (BLE serial port),
+ *        the GNSS sentences can be forwarded on the same outputs
+ */
 class xctrack_link : public i_xctrack_link
 {
   public:
@@ -22,6 +30,15 @@ class xctrack_link : public i_xctrack_link
     /** @brief Initialize the link */
     bool init();
 
+    /** @brief Set an additional serial output, nullptr to disable it */
+    void set_serial_output(i_serial* serial) { m_serial = serial; }
+
+    /** @brief Publish a new sample, it is sent as soon as the configured maximum rate allows it (never blocks) */
+    void publish(const sample& data) override;
+
+    /** @brief Forward a sentence received from the GNSS, without start of frame and checksum (never blocks) */
+    void forward_gnss_sentence(const char* sentence, size_t size);
+
     /** @brief Get the USB CDC link */
     i_usb_cdc& get_usb() override { return m_usb; }
 
@@ -32,19 +49,46 @@ class xctrack_link : public i_xctrack_link
     void set_active(bool is_active) override { m_is_active = is_active; }
 
   protected:
+    /** @brief Maximum size of the sentences sent for a sample in bytes */
+    static constexpr size_t MAX_SENTENCES_SIZE = 256u;
+    /** @brief Maximum size of the GNSS sentences waiting to be forwarded in bytes */
+    static constexpr size_t MAX_GNSS_SIZE = 256u;
+
     /** @brief USB CDC link */
     i_usb_cdc& m_usb;
+    /** @brief Additional serial output */
+    i_serial* volatile m_serial;
     /** @brief Indicate if the link is active */
     bool m_is_active;
+    /** @brief Latest published sample */
+    sample m_sample;
+    /** @brief Selected instrument protocols, cached from the configuration */
+    volatile uint8_t m_protocols;
+    /** @brief Maximum output rate of the samples (Hz), cached from the configuration */
+    volatile uint8_t m_rate;
+    /** @brief Indicate if the latest published sample has not been sent yet */
+    bool m_has_sample;
+    /** @brief GNSS sentences waiting to be forwarded */
+    char m_gnss_sentences[MAX_GNSS_SIZE];
+    /** @brief Size of the GNSS sentences waiting to be forwarded in bytes */
+    size_t m_gnss_size;
+    /** @brief Mutex to protect the latest published sample and the GNSS sentences */
+    mutex m_mutex;
+    /** @brief Signaled when a new sample has been published or a GNSS sentence has been received */
+    semaphore m_sample_sem;
+    /** @brief Sentences to send */
+    char m_sentences[MAX_SENTENCES_SIZE];
     /** @brief XCTrack thread */
     thread<2048u> m_thread;
 
     /** @brief XCTrack thread */
     void thread_func(void*);
-    /** @brief Send barometric data */
-    void send_barometric_data();
-    /** @brief Send custom data */
-    void send_custom_data();
+
+    /** @brief Called when the configuration has changed */
+    void on_config_changed(const ov_config& new_config, const ov_config& old_config);
+
+    /** @brief Send data on each active output */
+    void send(const char* data, size_t size);
 };
 
 } // namespace ov
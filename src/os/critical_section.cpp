@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "critical_section.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+namespace ov
+{
+
+/** @brief Constructor, enters the critical section */
+critical_section::critical_section() : m_from_isr(xPortIsInsideInterrupt() == pdTRUE), m_isr_mask(0u)
+{
+    if (m_from_isr)
+    {
+        m_isr_mask = taskENTER_CRITICAL_FROM_ISR();
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+    }
+}
+
+/** @brief Destructor, leaves the critical section */
+critical_section::~critical_section()
+{
+    if (m_from_isr)
+    {
+        taskEXIT_CRITICAL_FROM_ISR(m_isr_mask);
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+
+} // namespace ov
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_CRITICAL_SECTION_H
+#define OV_CRITICAL_SECTION_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/**
+ * @brief Scoped critical section which can be entered from a task or from an interrupt
+ *        Interrupts which are allowed to use the operating system services are masked until the end of the scope
+ */
+class critical_section
+{
+  public:
+    /** @brief Constructor, enters the critical section */
+    critical_section();
+    /** @brief Copy constructor */
+    critical_section(const critical_section& copy) = delete;
+    /** @brief Move constructor */
+    critical_section(critical_section&& move) = delete;
+
+    /** @brief Destructor, leaves the critical section */
+    ~critical_section();
+
+    /** @brief Copy operator */
+    critical_section& operator=(critical_section& copy) = delete;
+
+  private:
+    /** @brief Indicate if the critical section has been entered from an interrupt */
+    bool m_from_isr;
+    /** @brief Interrupt mask to restore when entered from an interrupt */
+    uint32_t m_isr_mask;
+};
+
+} // namespace ov
+
+#endif // OV_CRITICAL_SECTION_H
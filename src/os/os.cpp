@@ -26,6 +26,12 @@ void yield_from_isr(bool higher_priority_task_woken)
     portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
+/** @brief Indicate if the caller is running in an interrupt */
+bool is_in_isr()
+{
+    return (xPortIsInsideInterrupt() == pdTRUE);
+}
+
 /** @brief Get the infinite timeout value */
 uint32_t infinite_timeout_value()
 {
@@ -19,6 +19,9 @@ void start();
 /** @brief Yield from interrupt */
 void yield_from_isr(bool higher_priority_task_woken);
 
+/** @brief Indicate if the caller is running in an interrupt */
+bool is_in_isr();
+
 /** @brief Get the infinite timeout value */
 uint32_t infinite_timeout_value();
 
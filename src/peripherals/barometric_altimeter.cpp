@@ -12,7 +12,7 @@ namespace ov
 
 /** @brief Constructor */
 barometric_altimeter::barometric_altimeter(i_barometric_sensor& barometric_sensor)
-    : m_barometric_sensor(barometric_sensor), m_ref_temp(288.), m_ref_pressure(1013.), m_ref_alti(0.), m_data{}
+    : m_barometric_sensor(barometric_sensor), m_ref_temp(288.), m_ref_pressure(1013.), m_ref_alti(0.), m_data{}, m_listener(nullptr)
 {
     // Default reference :
     // - 15°C = 288°K
@@ -59,9 +59,17 @@ i_barometric_altimeter::data barometric_altimeter::get_data()
     m_data.altitude = static_cast<int32_t>(A * 10.);
 
     // Save sensor data
-    m_data.pressure    = sensor_data.pressure;
-    m_data.temperature = sensor_data.temperature;
-    m_data.is_valid    = sensor_data.is_valid;
+    m_data.pressure        = sensor_data.pressure;
+    m_data.temperature     = sensor_data.temperature;
+    m_data.raw_pressure    = sensor_data.raw_pressure;
+    m_data.raw_temperature = sensor_data.raw_temperature;
+    m_data.is_valid        = sensor_data.is_valid;
+
+    // Notify the conversion
+    if (m_listener)
+    {
+        m_listener->on_altimeter_data(m_data);
+    }
 
     return m_data;
 }
@@ -28,6 +28,9 @@ class barometric_altimeter : public i_barometric_altimeter
     /** @brief Get the barometric altimeter data */
     data get_data() override;
 
+    /** @brief Set the listener of the conversions (nullptr to remove it) */
+    void set_listener(i_listener* listener) override { m_listener = listener; }
+
   private:
     /** @brief Barometric sensor */
     i_barometric_sensor& m_barometric_sensor;
@@ -39,6 +42,8 @@ class barometric_altimeter : public i_barometric_altimeter
     double m_ref_alti;
     /** @brief Sensor data */
     data m_data;
+    /** @brief Listener of the conversions */
+    i_listener* m_listener;
 };
 
 } // namespace ov
@@ -28,6 +28,36 @@ struct date_time
     uint8_t second;
     /** @brief Milliseconds (0 - 999) */
     uint16_t millis;
+
+    /** @brief Move the date back by a duration in milliseconds shorter than a day */
+    void subtract(uint32_t duration_ms)
+    {
+        static constexpr int32_t MS_PER_DAY       = 86400000;
+        static constexpr uint8_t DAYS_PER_MONTH[] = {31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u};
+
+        int32_t time_ms = static_cast<int32_t>(((hour * 60u + minute) * 60u + second) * 1000u + millis) - static_cast<int32_t>(duration_ms);
+        if (time_ms < 0)
+        {
+            // Previous day
+            time_ms += MS_PER_DAY;
+            day--;
+            if (day == 0u)
+            {
+                month--;
+                if (month == 0u)
+                {
+                    month = 12u;
+                    year--;
+                }
+                day = DAYS_PER_MONTH[month - 1u] + (((month == 2u) && ((year % 4u) == 0u)) ? 1u : 0u);
+            }
+        }
+
+        hour   = static_cast<uint8_t>(time_ms / 3600000);
+        minute = static_cast<uint8_t>((time_ms / 60000) % 60);
+        second = static_cast<uint8_t>((time_ms / 1000) % 60);
+        millis = static_cast<uint16_t>(time_ms % 1000);
+    }
 };
 
 } // namespace ov
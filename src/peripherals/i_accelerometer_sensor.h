@@ -6,6 +6,7 @@
 #ifndef OV_I_ACCELEROMETER_SENSOR_H
 #define OV_I_ACCELEROMETER_SENSOR_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace ov
@@ -35,6 +36,12 @@ class i_accelerometer_sensor
 
     /** @brief Get the accelerometer sensor data */
     virtual data get_data() = 0;
+
+    /** @brief Get the rate at which the samples are stored in the FIFO in Hz */
+    virtual uint16_t get_fifo_rate() const = 0;
+
+    /** @brief Read the oldest samples stored in the FIFO, returns the number of samples read */
+    virtual size_t read_fifo(data* samples, size_t max_count) = 0;
 };
 
 } // namespace ov
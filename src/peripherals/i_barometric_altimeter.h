@@ -24,10 +24,25 @@ class i_barometric_altimeter
         int32_t altitude;
         /** @brief Temperature (1 = 0.1°C) */
         int16_t temperature;
+        /** @brief Raw pressure conversion result from the sensor */
+        uint32_t raw_pressure;
+        /** @brief Raw temperature conversion result from the sensor */
+        uint32_t raw_temperature;
         /** @brief Indicate if the data is valid */
         bool is_valid;
     };
 
+    /** @brief Interface to receive the result of each conversion */
+    class i_listener
+    {
+      public:
+        /** @brief Destructor */
+        virtual ~i_listener() { }
+
+        /** @brief Called for each conversion of the barometric sensor */
+        virtual void on_altimeter_data(const data& altimeter_data) = 0;
+    };
+
     /** @brief Destructor */
     virtual ~i_barometric_altimeter() { }
 
@@ -41,6 +56,9 @@ class i_barometric_altimeter
 
     /** @brief Get the barometric altimeter data */
     virtual data get_data() = 0;
+
+    /** @brief Set the listener of the conversions (nullptr to remove it) */
+    virtual void set_listener(i_listener* listener) = 0;
 };
 
 } // namespace ov
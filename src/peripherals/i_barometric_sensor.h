@@ -22,6 +22,10 @@ class i_barometric_sensor
         int32_t pressure;
         /** @brief Temperature (1 = 0.1°C) */
         int16_t temperature;
+        /** @brief Raw pressure conversion result */
+        uint32_t raw_pressure;
+        /** @brief Raw temperature conversion result */
+        uint32_t raw_temperature;
         /** @brief Indicate if the data is valid */
         bool is_valid;
     };
@@ -16,6 +16,9 @@ namespace ov
 class i_display
 {
   public:
+    /** @brief Height in pixels of a page of the frame buffer (vertical byte organization) */
+    static constexpr size_t PAGE_HEIGHT = 8u;
+
     /** @brief Destructor */
     virtual ~i_display() { }
 
@@ -42,6 +45,9 @@ class i_display
 
     /** @brief Refresh the display contents */
     virtual bool refresh() = 0;
+
+    /** @brief Refresh the display contents of the selected pages only (bit n = page n) */
+    virtual bool refresh(uint32_t page_mask) = 0;
 };
 
 } // namespace ov
@@ -7,7 +7,9 @@
 #define OV_I_GNSS_H
 
 #include "date_time.h"
+#include "geodesy.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace ov
@@ -36,6 +38,23 @@ class i_gnss
         uint8_t satellite_count;
         /** @brief Indicate if the data is valid */
         bool is_valid;
+
+        /** @brief Get the position in fixed point representation */
+        geo::position get_position() const { return geo::position::from_degrees(latitude, longitude); }
+    };
+
+    /** @brief Interface to receive the raw sentences and the fixes from the receiver */
+    class i_listener
+    {
+      public:
+        /** @brief Destructor */
+        virtual ~i_listener() { }
+
+        /** @brief Called for each valid sentence received, without start of frame and checksum */
+        virtual void on_sentence(const char* sentence, size_t size) = 0;
+
+        /** @brief Called once for each new fix, when all the sentences of the fix have been decoded */
+        virtual void on_fix(const data& fix) = 0;
     };
 
     /** @brief Destructor */
@@ -47,6 +66,9 @@ class i_gnss
     /** @brief Get the current navigation data */
     virtual data get_data() = 0;
 
+    /** @brief Set the listener of the raw sentences and of the fixes (nullptr to remove it) */
+    virtual void set_listener(i_listener* listener) = 0;
+
     /** @brief Convert a coordinate from decimal degrees (DD) to degrees minutes seconds (DMS) representation */
     static void to_dms(double dd, uint32_t& degrees, uint32_t& minutes, double& seconds);
     /** @brief Convert a coordinate from decimal degrees (DD) to degrees minutes seconds (DMS) representation */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_I_GYROSCOPE_SENSOR_H
+#define OV_I_GYROSCOPE_SENSOR_H
+
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief Interface for gyroscope sensor implementations */
+class i_gyroscope_sensor
+{
+  public:
+    /** @brief Gyroscope sensor data */
+    struct data
+    {
+        /** @brief Angular rate around X (1 = 0.01°/s) */
+        int16_t x_rate;
+        /** @brief Angular rate around Y (1 = 0.01°/s) */
+        int16_t y_rate;
+        /** @brief Angular rate around Z (1 = 0.01°/s) */
+        int16_t z_rate;
+        /** @brief Indicate if the data is valid */
+        bool is_valid;
+    };
+
+    /** @brief Destructor */
+    virtual ~i_gyroscope_sensor() { }
+
+    /** @brief Get the gyroscope sensor data */
+    virtual data get_gyro_data() = 0;
+};
+
+} // namespace ov
+
+#endif // OV_I_GYROSCOPE_SENSOR_H
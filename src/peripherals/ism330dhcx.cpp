@@ -5,11 +5,15 @@
 
 #include "ism330dhcx.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 namespace ov
 {
 
+/** @brief FIFO_CTRL3 register address */
+static const uint8_t FIFO_CTRL3 = 0x09u;
 /** @brief FIFO_CTRL4 register address */
 static const uint8_t FIFO_CTRL4 = 0x0Au;
 /** @brief WHO_AM_I_REG register address */
@@ -18,10 +22,25 @@ static const uint8_t WHO_AM_I_REG = 0x0Fu;
 static const uint8_t CTRL3_C_REG = 0x12u;
 /** @brief CTRL1_XL register address */
 static const uint8_t CTRL1_XL_REG = 0x10u;
+/** @brief CTRL2_G register address */
+static const uint8_t CTRL2_G_REG = 0x11u;
 /** @brief CTRL9_XL register address */
 static const uint8_t CTRL9_XL_REG = 0x18u;
+/** @brief OUTX_L_G register address */
+static const uint8_t OUTX_L_G_REG = 0x22u;
 /** @brief OUTX_L_A register address */
 static const uint8_t OUTX_L_A_REG = 0x28u;
+/** @brief FIFO_STATUS1 register address */
+static const uint8_t FIFO_STATUS1_REG = 0x3Au;
+/** @brief FIFO_DATA_OUT_TAG register address */
+static const uint8_t FIFO_DATA_OUT_TAG_REG = 0x78u;
+
+/** @brief Continuous mode value of the FIFO mode bits */
+static const uint8_t FIFO_MODE_CONTINUOUS = 0x06u;
+/** @brief DIFF_FIFO bits in FIFO_STATUS2 register */
+static const uint8_t FIFO_STATUS2_DIFF_FIFO_BITS = static_cast<uint8_t>(0x3 << 0);
+/** @brief Accelerometer sensor tag in FIFO_DATA_OUT_TAG register */
+static const uint8_t FIFO_TAG_ACCELEROMETER = 0x02u;
 
 /** @brief FIFO mode bits in FIFO_CTRL4 register */
 static const uint8_t FIFO_CTRL4_FIFO_MODE_BITS = static_cast<uint8_t>(0x7 << 0);
@@ -37,7 +56,7 @@ static const uint8_t CTRL3_C_BDU_BIT = static_cast<uint8_t>(1 << 6);
 static const uint8_t CTRL9_XL_REG_DEVICE_CONF_BIT = static_cast<uint8_t>(1 << 0);
 
 /** @brief Constructor */
-ism330dhcx::ism330dhcx(i_i2c& i2c, uint8_t address) : m_i2c(i2c), m_address(address) { }
+ism330dhcx::ism330dhcx(i_i2c& i2c, uint8_t address) : m_i2c(i2c), m_address(address), m_fifo_block{} { }
 
 /** @brief Initialize the barometric sensor */
 bool ism330dhcx::init()
@@ -64,12 +83,16 @@ bool ism330dhcx::init()
     // Set block data update mode
     ret = ret && set_bdu_mode(true);
 
-    // Set FIFO mode to BYPASS = disabled */
-    ret = ret && set_fifo_mode(0u);
+    // Batch the accelerometer samples in the FIFO (104Hz) in continuous mode
+    ret = ret && set_fifo_batch_rate(0x04u);
+    ret = ret && set_fifo_mode(FIFO_MODE_CONTINUOUS);
 
     // Select output data rate (104Hz) and scale (8g)
     ret = ret && set_data_rate_scale(0x04u, 0x03u);
 
+    // Select gyroscope output data rate (104Hz) and scale (250dps)
+    ret = ret && set_gyro_data_rate_scale(0x04u, 0x00u);
+
     // Exit configuration mode
     ret = ret && set_config_mode(false);
 
@@ -79,34 +102,69 @@ bool ism330dhcx::init()
 /** @brief Get the accelerometer sensor data */
 i_accelerometer_sensor::data ism330dhcx::get_data()
 {
-    data sensor_data;
+    i_accelerometer_sensor::data sensor_data;
 
-    // Get raw values
-    uint8_t          reg = OUTX_L_A_REG;
-    i_i2c::xfer_desc i2c_xfer_values;
-    i2c_xfer_values.data = reinterpret_cast<uint8_t*>(&sensor_data.x_accel);
-    i2c_xfer_values.size = 6u;
+    // Get raw values, the output registers are updated independently of the FIFO
+    int16_t raw_values[3u];
+    sensor_data.is_valid = read_axes(OUTX_L_A_REG, raw_values);
+    if (sensor_data.is_valid)
+    {
+        convert_accel(raw_values, sensor_data);
+    }
 
-    i_i2c::xfer_desc i2c_xfer_cmd;
-    i2c_xfer_cmd.read      = false;
-    i2c_xfer_cmd.data      = &reg;
-    i2c_xfer_cmd.size      = sizeof(reg);
-    i2c_xfer_cmd.stop_cond = false;
-    i2c_xfer_cmd.next      = &i2c_xfer_values;
+    return sensor_data;
+}
+
+/** @brief Read the oldest samples stored in the FIFO, returns the number of samples read */
+size_t ism330dhcx::read_fifo(i_accelerometer_sensor::data* samples, size_t max_count)
+{
+    size_t count = 0u;
+
+    // Get the number of unread words
+    uint8_t status[2u] = {};
+    bool    ret        = read_regs(FIFO_STATUS1_REG, status, sizeof(status));
+    if (ret)
+    {
+        size_t words = static_cast<size_t>(status[0u]) | (static_cast<size_t>(status[1u] & FIFO_STATUS2_DIFF_FIFO_BITS) << 8u);
+        words        = std::min(words, max_count);
+
+        // Read the words by blocks, the register address rolls back to FIFO_DATA_OUT_TAG after each word
+        while (ret && (words != 0u))
+        {
+            const size_t block_size = std::min(words, FIFO_BLOCK_SIZE);
+            ret                     = read_regs(FIFO_DATA_OUT_TAG_REG, m_fifo_block, block_size * FIFO_WORD_SIZE);
+            for (size_t i = 0u; ret && (i < block_size); i++)
+            {
+                const uint8_t* word = &m_fifo_block[i * FIFO_WORD_SIZE];
+                if ((word[0u] >> 3u) == FIFO_TAG_ACCELEROMETER)
+                {
+                    int16_t raw_values[3u];
+                    memcpy(raw_values, &word[1u], sizeof(raw_values));
+                    convert_accel(raw_values, samples[count]);
+                    samples[count].is_valid = true;
+                    count++;
+                }
+            }
+            words -= block_size;
+        }
+    }
+
+    return count;
+}
+
+/** @brief Get the gyroscope sensor data */
+i_gyroscope_sensor::data ism330dhcx::get_gyro_data()
+{
+    i_gyroscope_sensor::data sensor_data;
 
-    sensor_data.is_valid = m_i2c.xfer(m_address, i2c_xfer_cmd);
+    // Get raw values
+    sensor_data.is_valid = read_axes(OUTX_L_G_REG, &sensor_data.x_rate);
     if (sensor_data.is_valid)
     {
-        // Apply sensitivity => 0.244f for 8g
-        sensor_data.x_accel = static_cast<uint16_t>(static_cast<float>(sensor_data.x_accel) * 0.244f);
-        sensor_data.y_accel = static_cast<uint16_t>(static_cast<float>(sensor_data.y_accel) * 0.244f);
-        sensor_data.z_accel = static_cast<uint16_t>(static_cast<float>(sensor_data.z_accel) * 0.244f);
-
-        // Compute total acceleration
-        sensor_data.total_accel =
-            static_cast<uint16_t>(sqrt(static_cast<float>(sensor_data.x_accel) * static_cast<float>(sensor_data.x_accel) +
-                                       static_cast<float>(sensor_data.y_accel) * static_cast<float>(sensor_data.y_accel) +
-                                       static_cast<float>(sensor_data.z_accel) * static_cast<float>(sensor_data.z_accel)));
+        // Apply sensitivity => 8.75mdps for 250dps
+        sensor_data.x_rate = static_cast<int16_t>(static_cast<float>(sensor_data.x_rate) * 0.875f);
+        sensor_data.y_rate = static_cast<int16_t>(static_cast<float>(sensor_data.y_rate) * 0.875f);
+        sensor_data.z_rate = static_cast<int16_t>(static_cast<float>(sensor_data.z_rate) * 0.875f);
     }
 
     return sensor_data;
@@ -127,13 +185,13 @@ bool ism330dhcx::set_config_mode(bool is_enabled)
 /** @brief Set the sensor in auto increment mode */
 bool ism330dhcx::set_auto_inc_mode(bool is_enabled)
 {
-    return write_bit(CTRL3_C_REG, CTRL3_C_IF_INC_BIT, true);
+    return write_bit(CTRL3_C_REG, CTRL3_C_IF_INC_BIT, is_enabled);
 }
 
 /** @brief Set the sensor in block data update mode */
 bool ism330dhcx::set_bdu_mode(bool is_enabled)
 {
-    return write_bit(CTRL3_C_REG, CTRL3_C_BDU_BIT, true);
+    return write_bit(CTRL3_C_REG, CTRL3_C_BDU_BIT, is_enabled);
 }
 
 /** @brief Set the FIFO mode of the sensor */
@@ -150,6 +208,12 @@ bool ism330dhcx::set_fifo_mode(uint8_t mode)
     return ret;
 }
 
+/** @brief Set the accelerometer batch rate in the FIFO, the gyroscope is not batched */
+bool ism330dhcx::set_fifo_batch_rate(uint8_t datarate)
+{
+    return write_reg(FIFO_CTRL3, datarate);
+}
+
 /** @brief Set the datarate and the scale of the sensor */
 bool ism330dhcx::set_data_rate_scale(uint8_t datarate, uint8_t scale)
 {
@@ -157,6 +221,34 @@ bool ism330dhcx::set_data_rate_scale(uint8_t datarate, uint8_t scale)
     return write_reg(CTRL1_XL_REG, reg_value);
 }
 
+/** @brief Set the datarate and the scale of the gyroscope */
+bool ism330dhcx::set_gyro_data_rate_scale(uint8_t datarate, uint8_t scale)
+{
+    uint8_t reg_value = (scale << 2) | (datarate << 4);
+    return write_reg(CTRL2_G_REG, reg_value);
+}
+
+/** @brief Read the 3 axis output registers starting at a register address */
+bool ism330dhcx::read_axes(uint8_t reg, int16_t* values)
+{
+    return read_regs(reg, reinterpret_cast<uint8_t*>(values), 3u * sizeof(int16_t));
+}
+
+/** @brief Convert raw accelerometer values */
+void ism330dhcx::convert_accel(const int16_t* raw_values, i_accelerometer_sensor::data& sensor_data)
+{
+    // Apply sensitivity => 0.244f for 8g
+    sensor_data.x_accel = static_cast<int16_t>(static_cast<float>(raw_values[0u]) * 0.244f);
+    sensor_data.y_accel = static_cast<int16_t>(static_cast<float>(raw_values[1u]) * 0.244f);
+    sensor_data.z_accel = static_cast<int16_t>(static_cast<float>(raw_values[2u]) * 0.244f);
+
+    // Compute total acceleration
+    sensor_data.total_accel =
+        static_cast<int16_t>(sqrt(static_cast<float>(sensor_data.x_accel) * static_cast<float>(sensor_data.x_accel) +
+                                  static_cast<float>(sensor_data.y_accel) * static_cast<float>(sensor_data.y_accel) +
+                                  static_cast<float>(sensor_data.z_accel) * static_cast<float>(sensor_data.z_accel)));
+}
+
 /** @brief Write a bit in a register */
 bool ism330dhcx::write_bit(uint8_t reg, uint8_t bit, bool value)
 {
@@ -219,4 +311,21 @@ bool ism330dhcx::read_reg(uint8_t reg, uint8_t& value)
     return m_i2c.xfer(m_address, i2c_xfer_cmd);
 }
 
+/** @brief Read data from consecutive registers */
+bool ism330dhcx::read_regs(uint8_t reg, uint8_t* values, size_t size)
+{
+    i_i2c::xfer_desc i2c_xfer_values;
+    i2c_xfer_values.data = values;
+    i2c_xfer_values.size = static_cast<uint8_t>(size);
+
+    i_i2c::xfer_desc i2c_xfer_cmd;
+    i2c_xfer_cmd.read      = false;
+    i2c_xfer_cmd.data      = &reg;
+    i2c_xfer_cmd.size      = sizeof(reg);
+    i2c_xfer_cmd.stop_cond = false;
+    i2c_xfer_cmd.next      = &i2c_xfer_values;
+
+    return m_i2c.xfer(m_address, i2c_xfer_cmd);
+}
+
 } // namespace ov
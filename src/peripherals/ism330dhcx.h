@@ -7,13 +7,16 @@
 #define OV_ISM330DHCX_H
 
 #include "i_accelerometer_sensor.h"
+#include "i_gyroscope_sensor.h"
 #include "i_i2c.h"
 
+#include <cstddef>
+
 namespace ov
 {
 
-/** @brief Interface for accelerometer sensor implementations */
-class ism330dhcx : public i_accelerometer_sensor
+/** @brief Interface for accelerometer and gyroscope sensor implementations */
+class ism330dhcx : public i_accelerometer_sensor, public i_gyroscope_sensor
 {
   public:
     /** @brief Constructor */
@@ -23,16 +26,34 @@ class ism330dhcx : public i_accelerometer_sensor
     bool init();
 
     /** @brief Get the accelerometer sensor data */
-    data get_data() override;
+    i_accelerometer_sensor::data get_data() override;
+
+    /** @brief Get the rate at which the samples are stored in the FIFO in Hz */
+    uint16_t get_fifo_rate() const override { return FIFO_RATE; }
+
+    /** @brief Read the oldest samples stored in the FIFO, returns the number of samples read */
+    size_t read_fifo(i_accelerometer_sensor::data* samples, size_t max_count) override;
+
+    /** @brief Get the gyroscope sensor data */
+    i_gyroscope_sensor::data get_gyro_data() override;
 
   private:
     /** @brief Device identifier */
     static constexpr uint8_t DEVICE_ID = 0x6Bu;
+    /** @brief Accelerometer batch rate in the FIFO in Hz */
+    static constexpr uint16_t FIFO_RATE = 104u;
+    /** @brief Size of a FIFO word in bytes : tag + 3 axis */
+    static constexpr size_t FIFO_WORD_SIZE = 7u;
+    /** @brief Maximum number of FIFO words read in a single I2C transfer */
+    static constexpr size_t FIFO_BLOCK_SIZE = 16u;
+    static_assert((FIFO_BLOCK_SIZE * FIFO_WORD_SIZE) <= UINT8_MAX, "FIFO block must fit in a single I2C transfer");
 
     /** @brief I2C driver */
     i_i2c& m_i2c;
     /** @brief I2C address */
     uint8_t m_address;
+    /** @brief Words read from the FIFO */
+    uint8_t m_fifo_block[FIFO_BLOCK_SIZE * FIFO_WORD_SIZE];
 
     /** @brief Reset the sensor */
     bool reset();
@@ -44,8 +65,17 @@ class ism330dhcx : public i_accelerometer_sensor
     bool set_bdu_mode(bool is_enabled);
     /** @brief Set the FIFO mode of the sensor */
     bool set_fifo_mode(uint8_t mode);
+    /** @brief Set the accelerometer batch rate in the FIFO, the gyroscope is not batched */
+    bool set_fifo_batch_rate(uint8_t datarate);
     /** @brief Set the datarate and the scale of the sensor */
     bool set_data_rate_scale(uint8_t datarate, uint8_t scale);
+    /** @brief Set the datarate and the scale of the gyroscope */
+    bool set_gyro_data_rate_scale(uint8_t datarate, uint8_t scale);
+
+    /** @brief Read the 3 axis output registers starting at a register address */
+    bool read_axes(uint8_t reg, int16_t* values);
+    /** @brief Convert raw accelerometer values */
+    static void convert_accel(const int16_t* raw_values, i_accelerometer_sensor::data& sensor_data);
 
     /** @brief Write a bit in a register */
     bool write_bit(uint8_t reg, uint8_t bit, bool value);
@@ -56,6 +86,8 @@ class ism330dhcx : public i_accelerometer_sensor
     bool write_reg(uint8_t reg, uint8_t value);
     /** @brief Read data from a register */
     bool read_reg(uint8_t reg, uint8_t& value);
+    /** @brief Read data from consecutive registers */
+    bool read_regs(uint8_t reg, uint8_t* values, size_t size);
 };
 
 } // namespace ov
@@ -81,8 +81,10 @@ i_barometric_sensor::data ms56xx::get_data()
         const int64_t P = ((static_cast<int64_t>(D1) * SENS) / 2097152ll - OFF) / 32768ll;
 
         // Save computed values
-        m_data.pressure    = static_cast<uint32_t>(P);
-        m_data.temperature = static_cast<int16_t>(TEMP / 10);
+        m_data.pressure        = static_cast<uint32_t>(P);
+        m_data.temperature     = static_cast<int16_t>(TEMP / 10);
+        m_data.raw_pressure    = D1;
+        m_data.raw_temperature = D2;
     }
 
     // Validity
@@ -16,6 +16,10 @@ namespace ov
 nmea_gnss::nmea_gnss(i_serial& serial_port)
     : m_serial_port(serial_port),
       m_data{},
+      m_listener(nullptr),
+      m_fix_time(0u),
+      m_fix_sentences(0u),
+      m_new_fix(false),
       m_frame_buffer{},
       m_cs_buffer{},
       m_last_received_byte_ts(0),
@@ -115,8 +119,24 @@ bool nmea_gnss::update_data()
                     // Check end of frame char
                     if (byte == '\n')
                     {
+                        // Forward frame
+                        if (m_listener)
+                        {
+                            notify_listener();
+                        }
+
                         // Decode frame
                         m_data.is_valid = decode_frame();
+
+                        // Notify the new fix once all its sentences have been decoded
+                        if (m_new_fix)
+                        {
+                            m_new_fix = false;
+                            if (m_listener)
+                            {
+                                m_listener->on_fix(m_data);
+                            }
+                        }
                     }
 
                     // Reset state machine
@@ -163,6 +183,7 @@ bool nmea_gnss::update_data()
             {
                 // Timeout, data is now invalid
                 m_data              = {};
+                m_fix_sentences     = 0u;
                 m_decoding_state    = frame_decoding_state::wait_start;
                 reset_state_machine = true;
             }
@@ -244,6 +265,8 @@ bool nmea_gnss::decode_frame()
             // Extract altitude
             const char* const altitude = get_next_frame_param(skip);
             data_valid                 = data_valid && convert_altitude(altitude, m_data.altitude);
+
+            m_new_fix = data_valid && add_fix_sentence(FIX_GGA_BIT);
         }
         else if (strncmp(frametype, "RMC", 4u) == 0u)
         {
@@ -321,6 +344,8 @@ bool nmea_gnss::decode_frame()
             // Extract date
             const char* const date = get_next_frame_param(track_angle);
             data_valid             = convert_date_param(date, m_data.date);
+
+            m_new_fix = data_valid && add_fix_sentence(FIX_RMC_BIT);
         }
         else
         {
@@ -332,6 +357,48 @@ bool nmea_gnss::decode_frame()
     return data_valid;
 }
 
+/** @brief Add a decoded sentence to the current fix, returns true when it completes the fix */
+bool nmea_gnss::add_fix_sentence(uint8_t sentence_bit)
+{
+    // The sentences of a fix share the same UTC time
+    const uint32_t fix_time = ((m_data.date.hour * 60u + m_data.date.minute) * 60u + m_data.date.second) * 1000u + m_data.date.millis;
+    if (fix_time != m_fix_time)
+    {
+        m_fix_time      = fix_time;
+        m_fix_sentences = 0u;
+    }
+
+    // Repeated sentences of an already completed fix are ignored
+    const bool was_complete = (m_fix_sentences == FIX_COMPLETE_BITS);
+    m_fix_sentences |= sentence_bit;
+
+    return (!was_complete && (m_fix_sentences == FIX_COMPLETE_BITS));
+}
+
+/** @brief Forward the received frame to the listener */
+void nmea_gnss::notify_listener()
+{
+    // Restore the separators which have been converted to help decoding
+    for (uint32_t i = 0; i < m_frame_size; i++)
+    {
+        if (m_frame_buffer[i] == 0)
+        {
+            m_frame_buffer[i] = ',';
+        }
+    }
+
+    m_listener->on_sentence(m_frame_buffer, m_frame_size);
+
+    // Convert the separators again
+    for (uint32_t i = 0; i < m_frame_size; i++)
+    {
+        if (m_frame_buffer[i] == ',')
+        {
+            m_frame_buffer[i] = 0;
+        }
+    }
+}
+
 /** @brief Get the next parameter in a NMEA frame */
 const char* nmea_gnss::get_next_frame_param(const char* frame)
 {
@@ -371,7 +438,19 @@ bool nmea_gnss::convert_time_param(const char* time_str, date_time& date)
         date.hour   = convert_ndigits_int(&time_str[0u], 2u, 10u);
         date.minute = convert_ndigits_int(&time_str[2u], 2u, 10u);
         date.second = convert_ndigits_int(&time_str[4u], 2u, 10u);
+        date.millis = 0u;
         ret         = true;
+
+        // Optional fraction of second, needed to distinguish the fixes of receivers running faster than 1Hz
+        if (time_str[6u] == '.')
+        {
+            uint16_t scale = 100u;
+            for (size_t i = 7u; (scale != 0u) && (time_str[i] >= '0') && (time_str[i] <= '9'); i++)
+            {
+                date.millis += static_cast<uint16_t>(time_str[i] - '0') * scale;
+                scale /= 10u;
+            }
+        }
     }
     return ret;
 }
@@ -28,6 +28,9 @@ class nmea_gnss : public i_gnss
     /** @brief Get the current navigation data */
     data get_data() override { return m_data; }
 
+    /** @brief Set the listener of the raw sentences and of the fixes (nullptr to remove it) */
+    void set_listener(i_listener* listener) override { m_listener = listener; }
+
   protected:
     /** @brief Handle non-standard NMEA frames */
     virtual bool handle_frame(const char* frametype, const char* param)
@@ -56,6 +59,14 @@ class nmea_gnss : public i_gnss
     i_serial& m_serial_port;
     /** @brief GNSS data */
     data m_data;
+    /** @brief Listener of the raw sentences and of the fixes */
+    i_listener* m_listener;
+    /** @brief UTC time of the current fix in milliseconds since midnight */
+    uint32_t m_fix_time;
+    /** @brief Sentences of the current fix which have been decoded */
+    uint8_t m_fix_sentences;
+    /** @brief Indicate that the last decoded sentence has completed a new fix */
+    bool m_new_fix;
 
     /** @brief Buffer to store received frames */
     char m_frame_buffer[128u];
@@ -78,9 +89,19 @@ class nmea_gnss : public i_gnss
     static const uint32_t INTER_FRAME_TIMEOUT = 1500u;
     /** @brief Inter char timeout in milliseconds */
     static const uint32_t INTER_CHAR_TIMEOUT = 100u;
+    /** @brief GGA sentence bit in the sentences of a fix */
+    static const uint8_t FIX_GGA_BIT = 0x01u;
+    /** @brief RMC sentence bit in the sentences of a fix */
+    static const uint8_t FIX_RMC_BIT = 0x02u;
+    /** @brief Sentences needed to complete a fix */
+    static const uint8_t FIX_COMPLETE_BITS = FIX_GGA_BIT | FIX_RMC_BIT;
 
     /** @brief Decode the received frame */
     bool decode_frame();
+    /** @brief Forward the received frame to the listener */
+    void notify_listener();
+    /** @brief Add a decoded sentence to the current fix, returns true when it completes the fix */
+    bool add_fix_sentence(uint8_t sentence_bit);
 
   protected:
     /** @brief Get the next parameter in a NMEA frame */
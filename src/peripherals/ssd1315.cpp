@@ -127,16 +127,33 @@ bool ssd1315::turn_off()
 /** @brief Refresh the display contents */
 bool ssd1315::refresh()
 {
-    bool ret = false;
+    return refresh((1u << PAGE_COUNT) - 1u);
+}
 
-    ret = send_command(SSD1315_DISPLAY_START_LINE_1);
-    ret = send_command(SSD1315_SET_COLUMN_ADRESS) && ret;
-    ret = send_command(SSD1315_LOWER_COLUMN_START_ADRESS) && ret;
-    ret = send_command(SSD1315_DISPLAY_START_LINE_64) && ret;
-    ret = send_command(SSD1315_SET_PAGE_ADRESS) && ret;
-    ret = send_command(SSD1315_LOWER_COLUMN_START_ADRESS) && ret;
-    ret = send_command(SSD1315_LOWER_COLUMN_START_ADRESS_15) && ret;
-    ret = write_frame_buffer() && ret;
+/** @brief Refresh the display contents of the selected pages only (bit n = page n) */
+bool ssd1315::refresh(uint32_t page_mask)
+{
+    bool ret = true;
+
+    // Transfer each run of consecutive pages
+    uint8_t page = 0u;
+    while (page < PAGE_COUNT)
+    {
+        if ((page_mask & (1u << page)) != 0u)
+        {
+            uint8_t last_page = page;
+            while (((last_page + 1u) < PAGE_COUNT) && ((page_mask & (1u << (last_page + 1u))) != 0u))
+            {
+                last_page++;
+            }
+            ret  = write_frame_buffer(page, last_page) && ret;
+            page = last_page + 1u;
+        }
+        else
+        {
+            page++;
+        }
+    }
 
     return ret;
 }
@@ -153,17 +170,27 @@ bool ssd1315::send_command(uint8_t cmd)
     return ret;
 }
 
-/** @brief Write the frame buffer contents to the display */
-bool ssd1315::write_frame_buffer()
+/** @brief Write the frame buffer contents of consecutive pages to the display */
+bool ssd1315::write_frame_buffer(uint8_t first_page, uint8_t last_page)
 {
+    // Address window : all the columns of the selected pages
+    bool ret = send_command(SSD1315_DISPLAY_START_LINE_1);
+    ret      = send_command(SSD1315_SET_COLUMN_ADRESS) && ret;
+    ret      = send_command(SSD1315_LOWER_COLUMN_START_ADRESS) && ret;
+    ret      = send_command(SSD1315_DISPLAY_START_LINE_64) && ret;
+    ret      = send_command(SSD1315_SET_PAGE_ADRESS) && ret;
+    ret      = send_command(first_page) && ret;
+    ret      = send_command(last_page) && ret;
+
+    // Page data
     m_data_pin.set_high();
 
     i_spi::xfer_desc xfer;
     xfer.cs         = m_spi_cs_line;
-    xfer.write_data = m_frame_buffer;
-    xfer.size       = sizeof(m_frame_buffer);
+    xfer.write_data = &m_frame_buffer[first_page * PAGE_SIZE];
+    xfer.size       = (last_page - first_page + 1u) * PAGE_SIZE;
 
-    bool ret = m_spi_drv.xfer(xfer);
+    ret = m_spi_drv.xfer(xfer) && ret;
 
     m_data_pin.set_low();
 
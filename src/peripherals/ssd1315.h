@@ -47,6 +47,9 @@ class ssd1315 : public i_display
     /** @brief Refresh the display contents */
     bool refresh() override;
 
+    /** @brief Refresh the display contents of the selected pages only (bit n = page n) */
+    bool refresh(uint32_t page_mask) override;
+
   private:
     /** @brief SPI driver */
     i_spi& m_spi_drv;
@@ -59,14 +62,19 @@ class ssd1315 : public i_display
     /** @brief Indicate if the display is ON */
     bool m_is_on;
 
+    /** @brief Number of pages */
+    static constexpr uint8_t PAGE_COUNT = 8u;
+    /** @brief Size of a page in bytes */
+    static constexpr size_t PAGE_SIZE = 128u;
+
     /** @brief Frame buffer */
-    uint8_t m_frame_buffer[128u * 8u];
+    uint8_t m_frame_buffer[PAGE_SIZE * PAGE_COUNT];
 
     /** @brief Send a command to the display */
     bool send_command(uint8_t cmd);
 
-    /** @brief Write the frame buffer contents to the display */
-    bool write_frame_buffer();
+    /** @brief Write the frame buffer contents of consecutive pages to the display */
+    bool write_frame_buffer(uint8_t first_page, uint8_t last_page);
 };
 
 } // namespace ov
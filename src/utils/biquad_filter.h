@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_BIQUAD_FILTER_H
+#define OV_BIQUAD_FILTER_H
+
+#include "dsp_math.h"
+
+namespace ov
+{
+
+/** @brief Normalized coefficients of a biquad filter (a0 = 1) */
+struct biquad_coefs
+{
+    /** @brief Feedforward coefficient b0 */
+    float b0;
+    /** @brief Feedforward coefficient b1 */
+    float b1;
+    /** @brief Feedforward coefficient b2 */
+    float b2;
+    /** @brief Feedback coefficient a1 */
+    float a1;
+    /** @brief Feedback coefficient a2 */
+    float a2;
+
+    /** @brief Butterworth quality factor */
+    static constexpr float BUTTERWORTH_Q = 0.70710678f;
+
+    /** @brief Design a 2nd order low-pass filter (bilinear transform), cutoff frequency must be lower than half the sample rate */
+    static constexpr biquad_coefs low_pass(float cutoff, float sample_rate, float q = BUTTERWORTH_Q)
+    {
+        const float k    = dsp::tan(dsp::PI * cutoff / sample_rate);
+        const float k2   = k * k;
+        const float norm = 1.f / (1.f + k / q + k2);
+        const float b0   = k2 * norm;
+        return {b0, 2.f * b0, b0, 2.f * (k2 - 1.f) * norm, (1.f - k / q + k2) * norm};
+    }
+
+    /** @brief Design a 2nd order high-pass filter (bilinear transform), cutoff frequency must be lower than half the sample rate */
+    static constexpr biquad_coefs high_pass(float cutoff, float sample_rate, float q = BUTTERWORTH_Q)
+    {
+        const float k    = dsp::tan(dsp::PI * cutoff / sample_rate);
+        const float k2   = k * k;
+        const float norm = 1.f / (1.f + k / q + k2);
+        return {norm, -2.f * norm, norm, 2.f * (k2 - 1.f) * norm, (1.f - k / q + k2) * norm};
+    }
+
+    /** @brief Static gain of the filter */
+    constexpr float dc_gain() const { return ((b0 + b1 + b2) / (1.f + a1 + a2)); }
+};
+
+/** @brief Biquad IIR filter (transposed direct form II), the first value initializes the filter in steady state */
+template <typename T>
+class biquad_filter
+{
+  public:
+    /** @brief Constructor */
+    constexpr biquad_filter(const biquad_coefs& coefs) : m_coefs(coefs), m_z1(0.f), m_z2(0.f), m_value(0.f), m_initialized(false) { }
+
+    /** @brief Set new coefficients, resets the filter */
+    constexpr void set_coefs(const biquad_coefs& coefs)
+    {
+        m_coefs = coefs;
+        reset();
+    }
+
+    /** @brief Get the coefficients */
+    constexpr const biquad_coefs& get_coefs() const { return m_coefs; }
+
+    /** @brief Reset the filter */
+    constexpr void reset() { m_initialized = false; }
+
+    /** @brief Add value to the filter and get the new output value */
+    constexpr T add_value(const T& val)
+    {
+        const float x = static_cast<float>(val);
+        if (!m_initialized)
+        {
+            // Steady state for a constant input
+            const float y = x * m_coefs.dc_gain();
+            m_z1          = y - m_coefs.b0 * x;
+            m_z2          = m_coefs.b2 * x - m_coefs.a2 * y;
+            m_initialized = true;
+        }
+
+        // Filter
+        m_value = m_coefs.b0 * x + m_z1;
+        m_z1    = m_coefs.b1 * x - m_coefs.a1 * m_value + m_z2;
+        m_z2    = m_coefs.b2 * x - m_coefs.a2 * m_value;
+
+        return get_value();
+    }
+
+    /** @brief Get the current output value */
+    constexpr T get_value() const { return dsp::to_sample<T>(m_value); }
+
+  private:
+    /** @brief Coefficients */
+    biquad_coefs m_coefs;
+    /** @brief First state variable */
+    float m_z1;
+    /** @brief Second state variable */
+    float m_z2;
+    /** @brief Current output value */
+    float m_value;
+    /** @brief Indicate if the filter has been initialized */
+    bool m_initialized;
+};
+
+} // namespace ov
+
+#endif // OV_BIQUAD_FILTER_H
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_CRC16_H
+#define OV_CRC16_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ov
+{
+
+/** @brief CRC-16/CCITT-FALSE computation (polynomial 0x1021, initial value 0xFFFF, no reflection) */
+class crc16
+{
+  public:
+    /** @brief Initial value of the CRC */
+    static constexpr uint16_t INIT = 0xFFFFu;
+
+    /** @brief Update a CRC with a block of data */
+    static uint16_t update(uint16_t crc, const void* data, size_t size)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+        while (size != 0u)
+        {
+            crc = static_cast<uint16_t>((crc << 8u) ^ TABLE.values[(crc >> 8u) ^ *bytes]);
+            bytes++;
+            size--;
+        }
+        return crc;
+    }
+
+    /** @brief Compute the CRC of a block of data */
+    static uint16_t compute(const void* data, size_t size) { return update(INIT, data, size); }
+
+  private:
+    /** @brief Polynomial */
+    static constexpr uint16_t POLYNOMIAL = 0x1021u;
+
+    /** @brief Lookup table of the CRC of each byte value, built at compile time */
+    struct table
+    {
+        /** @brief Constructor */
+        constexpr table() : values()
+        {
+            for (uint32_t i = 0; i < 256u; i++)
+            {
+                uint16_t crc = static_cast<uint16_t>(i << 8u);
+                for (uint32_t bit = 0; bit < 8u; bit++)
+                {
+                    crc = static_cast<uint16_t>(((crc & 0x8000u) != 0u) ? ((crc << 1u) ^ POLYNOMIAL) : (crc << 1u));
+                }
+                values[i] = crc;
+            }
+        }
+
+        /** @brief Values */
+        uint16_t values[256u];
+    };
+
+    /** @brief Lookup table */
+    static const table TABLE;
+};
+
+/** @brief Lookup table */
+inline constexpr crc16::table crc16::TABLE = {};
+
+} // namespace ov
+
+#endif // OV_CRC16_H
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_DECIMATOR_H
+#define OV_DECIMATOR_H
+
+#include <cstddef>
+
+namespace ov
+{
+
+/**
+ * @brief Decimator producing the mean of each block of FACTOR values,
+ *        the block average acts as the anti-aliasing filter. S is the accumulator type
+ */
+template <typename T, typename S, size_t FACTOR>
+class decimator
+{
+    static_assert(FACTOR > 0u, "Decimation factor must not be null");
+
+  public:
+    /** @brief Constructor */
+    constexpr decimator() : m_sum{}, m_count(0u), m_value{} { }
+
+    /** @brief Reset the current block */
+    constexpr void reset()
+    {
+        m_sum   = S{};
+        m_count = 0u;
+    }
+
+    /** @brief Add value to the decimator, returns true when a new output value is available */
+    constexpr bool add_value(const T& val)
+    {
+        bool ret = false;
+
+        m_sum += static_cast<S>(val);
+        m_count++;
+        if (m_count == FACTOR)
+        {
+            m_value = static_cast<T>(m_sum / static_cast<S>(FACTOR));
+            reset();
+            ret = true;
+        }
+
+        return ret;
+    }
+
+    /** @brief Get the last output value */
+    constexpr T get_value() const { return m_value; }
+
+  private:
+    /** @brief Sum of the values of the current block */
+    S m_sum;
+    /** @brief Number of values in the current block */
+    size_t m_count;
+    /** @brief Last output value */
+    T m_value;
+};
+
+} // namespace ov
+
+#endif // OV_DECIMATOR_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_DELAY_LINE_H
+#define OV_DELAY_LINE_H
+
+#include <cstddef>
+
+namespace ov
+{
+
+/**
+ * @brief Delay line holding the last values of a signal over a window with parametrizable depth
+ *        Once full, the oldest value has been added (depth - 1) values ago, which gives
+ *        the variation of a signal over a fixed time span in O(1)
+ */
+template <typename T, size_t MAX_DEPTH>
+class delay_line
+{
+  public:
+    /** @brief Constructor */
+    constexpr delay_line() : m_values{}, m_depth(MAX_DEPTH), m_index(0u), m_count(0u) { }
+
+    /** @brief Set a new depth, clears the window */
+    constexpr bool set_depth(size_t new_depth)
+    {
+        bool ret = false;
+
+        // Check new depth
+        if ((new_depth > 0u) && (new_depth <= MAX_DEPTH))
+        {
+            m_depth = new_depth;
+            reset();
+            ret = true;
+        }
+
+        return ret;
+    }
+
+    /** @brief Get the depth */
+    constexpr size_t get_depth() const { return m_depth; }
+
+    /** @brief Get the number of values in the window */
+    constexpr size_t get_count() const { return m_count; }
+
+    /** @brief Indicate if the window is full */
+    constexpr bool is_full() const { return (m_count == m_depth); }
+
+    /** @brief Clear the window */
+    constexpr void reset()
+    {
+        m_index = 0u;
+        m_count = 0u;
+    }
+
+    /** @brief Add value to the window */
+    constexpr void add_value(const T& val)
+    {
+        m_values[m_index] = val;
+        m_index++;
+        if (m_index == m_depth)
+        {
+            m_index = 0u;
+        }
+        if (m_count < m_depth)
+        {
+            m_count++;
+        }
+    }
+
+    /** @brief Get the oldest value of the window, only meaningful if the window is not empty */
+    constexpr T get_oldest_value() const { return (is_full() ? m_values[m_index] : m_values[0u]); }
+
+    /** @brief Get the newest value of the window, only meaningful if the window is not empty */
+    constexpr T get_newest_value() const { return m_values[(m_index == 0u) ? (m_depth - 1u) : (m_index - 1u)]; }
+
+  private:
+    /** @brief Values */
+    T m_values[MAX_DEPTH];
+    /** @brief Depth */
+    size_t m_depth;
+    /** @brief Index of the next value to write */
+    size_t m_index;
+    /** @brief Number of values in the window */
+    size_t m_count;
+};
+
+} // namespace ov
+
+#endif // OV_DELAY_LINE_H
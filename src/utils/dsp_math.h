@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_DSP_MATH_H
+#define OV_DSP_MATH_H
+
+#include <type_traits>
+
+namespace ov
+{
+namespace dsp
+{
+
+/** @brief Pi */
+static constexpr float PI = 3.14159265358979f;
+
+/** @brief Reduce an angle in radians in the [-pi, pi] range */
+constexpr float reduce_angle(float x)
+{
+    while (x > PI)
+    {
+        x -= 2.f * PI;
+    }
+    while (x < -PI)
+    {
+        x += 2.f * PI;
+    }
+    return x;
+}
+
+/** @brief Sine usable in constant expressions (Taylor series, error < 1e-6 after range reduction) */
+constexpr float sin(float x)
+{
+    x                = reduce_angle(x);
+    const float x2   = x * x;
+    float       term = x;
+    float       sum  = x;
+    for (int i = 1; i < 10; i++)
+    {
+        term = -term * x2 / static_cast<float>((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/** @brief Cosine usable in constant expressions (Taylor series, error < 1e-6 after range reduction) */
+constexpr float cos(float x)
+{
+    x                = reduce_angle(x);
+    const float x2   = x * x;
+    float       term = 1.f;
+    float       sum  = 1.f;
+    for (int i = 1; i < 10; i++)
+    {
+        term = -term * x2 / static_cast<float>((2 * i - 1) * (2 * i));
+        sum += term;
+    }
+    return sum;
+}
+
+/** @brief Tangent usable in constant expressions */
+constexpr float tan(float x)
+{
+    return sin(x) / cos(x);
+}
+
+/** @brief Convert a filter internal value to the sample type, integral types are rounded to the nearest value */
+template <typename T>
+constexpr T to_sample(float val)
+{
+    if constexpr (std::is_integral<T>::value)
+    {
+        return static_cast<T>((val < 0.f) ? (val - 0.5f) : (val + 0.5f));
+    }
+    else
+    {
+        return static_cast<T>(val);
+    }
+}
+
+} // namespace dsp
+} // namespace ov
+
+#endif // OV_DSP_MATH_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_EMA_FILTER_H
+#define OV_EMA_FILTER_H
+
+#include "dsp_math.h"
+
+namespace ov
+{
+
+/** @brief Exponential moving average filter, the first value initializes the output */
+template <typename T>
+class ema_filter
+{
+  public:
+    /** @brief Constructor */
+    constexpr ema_filter(float alpha) : m_alpha(alpha), m_value(0.f), m_initialized(false) { }
+
+    /** @brief Compute the smoothing factor corresponding to a time constant (same unit as the sampling period) */
+    static constexpr float alpha_from_time_constant(float sampling_period, float time_constant)
+    {
+        return (sampling_period / (time_constant + sampling_period));
+    }
+
+    /** @brief Set the smoothing factor ]0, 1] */
+    constexpr void set_alpha(float alpha) { m_alpha = alpha; }
+
+    /** @brief Get the smoothing factor */
+    constexpr float get_alpha() const { return m_alpha; }
+
+    /** @brief Reset the filter */
+    constexpr void reset() { m_initialized = false; }
+
+    /** @brief Add value to the filter and get the new output value */
+    constexpr T add_value(const T& val)
+    {
+        const float x = static_cast<float>(val);
+        if (m_initialized)
+        {
+            m_value += m_alpha * (x - m_value);
+        }
+        else
+        {
+            m_value       = x;
+            m_initialized = true;
+        }
+        return get_value();
+    }
+
+    /** @brief Get the current output value */
+    constexpr T get_value() const { return dsp::to_sample<T>(m_value); }
+
+  private:
+    /** @brief Smoothing factor */
+    float m_alpha;
+    /** @brief Current output value */
+    float m_value;
+    /** @brief Indicate if the filter has been initialized */
+    bool m_initialized;
+};
+
+} // namespace ov
+
+#endif // OV_EMA_FILTER_H
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_GEODESY_H
+#define OV_GEODESY_H
+
+#include <cmath>
+#include <cstdint>
+
+namespace ov
+{
+namespace geo
+{
+
+/** @brief Mean earth radius in meters (IUGG) */
+static constexpr float EARTH_RADIUS = 6371008.8f;
+
+/** @brief Number of position units per degree */
+static constexpr int32_t UNITS_PER_DEGREE = 10000000;
+
+/** @brief Pi */
+static constexpr float PI = 3.14159265358979f;
+
+/** @brief Conversion factor from position units to radians */
+static constexpr float UNITS_TO_RAD = PI / (180.f * static_cast<float>(UNITS_PER_DEGREE));
+
+/** @brief Conversion factor from radians to position units */
+static constexpr float RAD_TO_UNITS = (180.f * static_cast<float>(UNITS_PER_DEGREE)) / PI;
+
+/** @brief Conversion factor from radians to degrees */
+static constexpr float RAD_TO_DEG = 180.f / PI;
+
+/** @brief Conversion factor from degrees to radians */
+static constexpr float DEG_TO_RAD = PI / 180.f;
+
+/** @brief Geographic position in fixed point representation */
+struct position
+{
+    /** @brief Latitude (1 = 1e-7°) */
+    int32_t latitude;
+    /** @brief Longitude (1 = 1e-7°) */
+    int32_t longitude;
+
+    /** @brief Create a position from decimal degrees */
+    static position from_degrees(double lat, double lon)
+    {
+        return {static_cast<int32_t>(std::lround(lat * static_cast<double>(UNITS_PER_DEGREE))),
+                static_cast<int32_t>(std::lround(lon * static_cast<double>(UNITS_PER_DEGREE)))};
+    }
+
+    /** @brief Get the latitude in decimal degrees */
+    double latitude_deg() const { return static_cast<double>(latitude) / static_cast<double>(UNITS_PER_DEGREE); }
+
+    /** @brief Get the longitude in decimal degrees */
+    double longitude_deg() const { return static_cast<double>(longitude) / static_cast<double>(UNITS_PER_DEGREE); }
+
+    /** @brief Comparison operator */
+    bool operator==(const position& pos) const { return ((latitude == pos.latitude) && (longitude == pos.longitude)); }
+
+    /** @brief Comparison operator */
+    bool operator!=(const position& pos) const { return !(*this == pos); }
+};
+
+/** @brief Wrap a longitude difference in the [-180°, 180°] range (1 = 1e-7°) */
+inline int32_t wrap_longitude(int64_t delta)
+{
+    constexpr int64_t HALF_TURN = 180ll * UNITS_PER_DEGREE;
+    constexpr int64_t FULL_TURN = 360ll * UNITS_PER_DEGREE;
+    if (delta > HALF_TURN)
+    {
+        delta -= FULL_TURN;
+    }
+    else if (delta < -HALF_TURN)
+    {
+        delta += FULL_TURN;
+    }
+    return static_cast<int32_t>(delta);
+}
+
+/** @brief Latitude difference from a to b in radians (exact integer difference before conversion) */
+inline float delta_lat_rad(const position& a, const position& b)
+{
+    return static_cast<float>(b.latitude - a.latitude) * UNITS_TO_RAD;
+}
+
+/** @brief Longitude difference from a to b in radians (exact integer difference before conversion) */
+inline float delta_lon_rad(const position& a, const position& b)
+{
+    return static_cast<float>(wrap_longitude(static_cast<int64_t>(b.longitude) - static_cast<int64_t>(a.longitude))) * UNITS_TO_RAD;
+}
+
+/** @brief Normalize an angle in degrees in the [0°, 360°[ range */
+inline float normalize_bearing(float bearing)
+{
+    while (bearing < 0.f)
+    {
+        bearing += 360.f;
+    }
+    while (bearing >= 360.f)
+    {
+        bearing -= 360.f;
+    }
+    return bearing;
+}
+
+/**
+ * @brief Fast distance in meters using the equirectangular approximation
+ *        Relative error stays below 0.1% up to 100km outside polar regions
+ */
+inline float fast_distance(const position& a, const position& b)
+{
+    const float mid_lat = static_cast<float>((static_cast<int64_t>(a.latitude) + static_cast<int64_t>(b.latitude)) / 2) * UNITS_TO_RAD;
+    const float x       = delta_lon_rad(a, b) * std::cos(mid_lat);
+    const float y       = delta_lat_rad(a, b);
+    return EARTH_RADIUS * std::sqrt(x * x + y * y);
+}
+
+/**
+ * @brief Great circle distance in meters using the haversine formula
+ *        Single precision is enough thanks to the exact fixed point differences
+ */
+inline float distance(const position& a, const position& b)
+{
+    const float lat_a     = static_cast<float>(a.latitude) * UNITS_TO_RAD;
+    const float lat_b     = static_cast<float>(b.latitude) * UNITS_TO_RAD;
+    const float sin_dlat  = std::sin(delta_lat_rad(a, b) * 0.5f);
+    const float sin_dlon  = std::sin(delta_lon_rad(a, b) * 0.5f);
+    float       haversine = sin_dlat * sin_dlat + std::cos(lat_a) * std::cos(lat_b) * sin_dlon * sin_dlon;
+    if (haversine > 1.f)
+    {
+        haversine = 1.f;
+    }
+    return 2.f * EARTH_RADIUS * std::asin(std::sqrt(haversine));
+}
+
+/**
+ * @brief Initial bearing in degrees [0°, 360°[ from a to b
+ *        The north component is written as sin(dlat) + 2.sin(lat_a).cos(lat_b).sin²(dlon/2)
+ *        to avoid the cancellation of the textbook formula between close positions
+ */
+inline float bearing(const position& a, const position& b)
+{
+    const float lat_a       = static_cast<float>(a.latitude) * UNITS_TO_RAD;
+    const float lat_b       = static_cast<float>(b.latitude) * UNITS_TO_RAD;
+    const float dlon        = delta_lon_rad(a, b);
+    const float cos_lat_b   = std::cos(lat_b);
+    const float sin_half_dl = std::sin(dlon * 0.5f);
+    const float y           = std::sin(dlon) * cos_lat_b;
+    const float x           = std::sin(delta_lat_rad(a, b)) + 2.f * std::sin(lat_a) * cos_lat_b * sin_half_dl * sin_half_dl;
+    return normalize_bearing(std::atan2(y, x) * RAD_TO_DEG);
+}
+
+/**
+ * @brief Destination point reached from a position following a bearing (°) over a distance (m) on a great circle
+ *        The latitude change is computed as a difference added to the fixed point latitude,
+ *        so that the error stays below 0.1m up to 100km despite single precision
+ */
+inline position destination(const position& from, float bearing_deg, float dist)
+{
+    const float lat        = static_cast<float>(from.latitude) * UNITS_TO_RAD;
+    const float angle      = bearing_deg * DEG_TO_RAD;
+    const float ang_dist   = dist / EARTH_RADIUS;
+    const float sin_lat    = std::sin(lat);
+    const float cos_lat    = std::cos(lat);
+    const float sin_dist   = std::sin(ang_dist);
+    const float sin_half_d = std::sin(ang_dist * 0.5f);
+    const float cos_dist   = 1.f - 2.f * sin_half_d * sin_half_d;
+    const float delta_sin  = cos_lat * sin_dist * std::cos(angle) - 2.f * sin_lat * sin_half_d * sin_half_d;
+    const float sin_dest   = sin_lat + delta_sin;
+    const float dest_dlon  = std::atan2(std::sin(angle) * sin_dist * cos_lat, cos_dist - sin_lat * sin_dest);
+    const float approx_lat = std::asin(sin_dest);
+
+    // sin(lat + dlat) - sin(lat) = 2.cos(lat + dlat/2).sin(dlat/2), the approximate latitude is only used in the cosine
+    const float dest_dlat = 2.f * std::asin(delta_sin / (2.f * std::cos((lat + approx_lat) * 0.5f)));
+
+    position dest;
+    dest.latitude  = from.latitude + static_cast<int32_t>(std::lround(dest_dlat * RAD_TO_UNITS));
+    dest.longitude = wrap_longitude(static_cast<int64_t>(from.longitude) + std::lround(dest_dlon * RAD_TO_UNITS));
+    return dest;
+}
+
+/**
+ * @brief Local flat projection around a reference position
+ *        The cosine of the reference latitude is computed once so that
+ *        projecting a position only costs 2 multiplications
+ */
+class flat_projection
+{
+  public:
+    /** @brief Constructor */
+    flat_projection() : m_ref{}, m_x_factor(0.f), m_y_factor(0.f) { }
+
+    /** @brief Constructor */
+    flat_projection(const position& ref) : flat_projection() { set_reference(ref); }
+
+    /** @brief Set the reference position */
+    void set_reference(const position& ref)
+    {
+        m_ref      = ref;
+        m_y_factor = UNITS_TO_RAD * EARTH_RADIUS;
+        m_x_factor = m_y_factor * std::cos(static_cast<float>(ref.latitude) * UNITS_TO_RAD);
+    }
+
+    /** @brief Get the reference position */
+    const position& get_reference() const { return m_ref; }
+
+    /** @brief Project a position : x = east (m), y = north (m) */
+    void to_xy(const position& pos, float& x, float& y) const
+    {
+        x = static_cast<float>(wrap_longitude(static_cast<int64_t>(pos.longitude) - static_cast<int64_t>(m_ref.longitude))) * m_x_factor;
+        y = static_cast<float>(pos.latitude - m_ref.latitude) * m_y_factor;
+    }
+
+    /** @brief Get the position corresponding to projected coordinates : x = east (m), y = north (m) */
+    position from_xy(float x, float y) const
+    {
+        position pos;
+        pos.latitude = m_ref.latitude + static_cast<int32_t>(std::lround(y / m_y_factor));
+        pos.longitude =
+            (m_x_factor > 0.f) ? wrap_longitude(static_cast<int64_t>(m_ref.longitude) + std::lround(x / m_x_factor)) : m_ref.longitude;
+        return pos;
+    }
+
+  private:
+    /** @brief Reference position */
+    position m_ref;
+    /** @brief Meters per position unit on the X axis */
+    float m_x_factor;
+    /** @brief Meters per position unit on the Y axis */
+    float m_y_factor;
+};
+
+} // namespace geo
+} // namespace ov
+
+#endif // OV_GEODESY_H
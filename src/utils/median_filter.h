@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_MEDIAN_FILTER_H
+#define OV_MEDIAN_FILTER_H
+
+#include <cstddef>
+
+namespace ov
+{
+
+/**
+ * @brief Sliding median filter with parametrizable depth to reject outliers
+ *        A sorted copy of the window is kept up to date by insertion, an odd depth is recommended
+ */
+template <typename T, size_t MAX_DEPTH>
+class median_filter
+{
+  public:
+    /** @brief Constructor */
+    constexpr median_filter() : m_values{}, m_sorted{}, m_depth(MAX_DEPTH), m_index(0u), m_count(0u) { }
+
+    /** @brief Set a new depth, clears the window */
+    constexpr bool set_depth(size_t new_depth)
+    {
+        bool ret = false;
+
+        // Check new depth
+        if ((new_depth > 0u) && (new_depth <= MAX_DEPTH))
+        {
+            m_depth = new_depth;
+            reset();
+            ret = true;
+        }
+
+        return ret;
+    }
+
+    /** @brief Get the depth */
+    constexpr size_t get_depth() const { return m_depth; }
+
+    /** @brief Clear the window */
+    constexpr void reset()
+    {
+        m_index = 0u;
+        m_count = 0u;
+    }
+
+    /** @brief Add value to the filter and get the new median value */
+    constexpr T add_value(const T& val)
+    {
+        // Remove oldest value from the sorted window
+        if (m_count == m_depth)
+        {
+            const T oldest = m_values[m_index];
+            size_t  pos    = 0u;
+            while ((pos < (m_count - 1u)) && (m_sorted[pos] != oldest))
+            {
+                pos++;
+            }
+            for (; pos < (m_count - 1u); pos++)
+            {
+                m_sorted[pos] = m_sorted[pos + 1u];
+            }
+            m_count--;
+        }
+
+        // Insert new value
+        size_t pos = m_count;
+        while ((pos > 0u) && (val < m_sorted[pos - 1u]))
+        {
+            m_sorted[pos] = m_sorted[pos - 1u];
+            pos--;
+        }
+        m_sorted[pos] = val;
+        m_count++;
+
+        // Save value
+        m_values[m_index] = val;
+        m_index++;
+        if (m_index == m_depth)
+        {
+            m_index = 0u;
+        }
+
+        return get_value();
+    }
+
+    /** @brief Get the current median value */
+    constexpr T get_value() const { return ((m_count != 0u) ? m_sorted[m_count / 2u] : T{}); }
+
+  private:
+    /** @brief Values in chronological order */
+    T m_values[MAX_DEPTH];
+    /** @brief Values in ascending order */
+    T m_sorted[MAX_DEPTH];
+    /** @brief Depth */
+    size_t m_depth;
+    /** @brief Index of the next value to write */
+    size_t m_index;
+    /** @brief Number of values in the window */
+    size_t m_count;
+};
+
+} // namespace ov
+
+#endif // OV_MEDIAN_FILTER_H
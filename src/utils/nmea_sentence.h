@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_NMEA_SENTENCE_H
+#define OV_NMEA_SENTENCE_H
+
+#include "text_writer.h"
+
+namespace ov
+{
+
+/**
+ * @brief Format an NMEA sentence into a caller provided buffer
+ *        The checksum of the constant prefix of the sentence is computed at compile time,
+ *        only the fields are processed when the sentence is finished
+ */
+class nmea_sentence
+{
+  public:
+    /** @brief Constructor, the prefix is the head of the sentence from the '$' to the first field separator included */
+    nmea_sentence(char* buffer, size_t size, const char* prefix, uint8_t prefix_checksum)
+        : m_writer(buffer, size), m_fields_start(0u), m_checksum(prefix_checksum)
+    {
+        m_writer.write(prefix);
+        m_fields_start = m_writer.size();
+    }
+
+    /** @brief Copy constructor */
+    nmea_sentence(const nmea_sentence& copy) = delete;
+    /** @brief Move constructor */
+    nmea_sentence(nmea_sentence&& move) = delete;
+    /** @brief Copy operator */
+    nmea_sentence& operator=(nmea_sentence& copy) = delete;
+
+    /** @brief Compute the checksum of a sentence prefix, to be evaluated at compile time */
+    static constexpr uint8_t checksum(const char* prefix)
+    {
+        uint8_t ret = 0u;
+        if (*prefix == '$')
+        {
+            prefix++;
+        }
+        while (*prefix != 0)
+        {
+            ret ^= static_cast<uint8_t>(*prefix);
+            prefix++;
+        }
+        return ret;
+    }
+
+    /** @brief Get the writer to format the fields of the sentence */
+    text_writer& fields() { return m_writer; }
+
+    /** @brief Append the checksum and the end of line, return the length of the sentence or 0 if it has been truncated */
+    size_t finish()
+    {
+        uint8_t     checksum = m_checksum;
+        const char* text     = m_writer.c_str();
+        for (size_t i = m_fields_start; i < m_writer.size(); i++)
+        {
+            checksum ^= static_cast<uint8_t>(text[i]);
+        }
+        m_writer.write('*').write_hex(checksum, 2u).write("\r\n");
+
+        return (m_writer.is_truncated() ? 0u : m_writer.size());
+    }
+
+  private:
+    /** @brief Writer */
+    text_writer m_writer;
+    /** @brief Index of the first character of the fields */
+    size_t m_fields_start;
+    /** @brief Checksum of the prefix */
+    uint8_t m_checksum;
+};
+
+} // namespace ov
+
+#endif // OV_NMEA_SENTENCE_H
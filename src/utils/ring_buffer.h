@@ -6,7 +6,10 @@
 #ifndef OV_RING_BUFFER_H
 #define OV_RING_BUFFER_H
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace ov
 {
@@ -75,6 +78,69 @@ class ring_buffer
         return ret;
     }
 
+    /** @brief Get the number of values in the buffer */
+    size_t get_count() const
+    {
+        size_t count = m_write_index - m_read_index;
+        if (m_write_index < m_read_index)
+        {
+            count = SIZE - m_read_index + m_write_index;
+        }
+        return count;
+    }
+
+    /** @brief Get the number of values which can still be written in the buffer */
+    size_t get_free_count() const { return (SIZE - 1u - get_count()); }
+
+    /** @brief Write several values in the buffer, return the number of values which have been written */
+    size_t write(const T* values, size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Bulk copy requires trivially copyable values");
+
+        // Copy up to the end of the buffer then from its start
+        if (count > get_free_count())
+        {
+            count = get_free_count();
+        }
+        size_t first_part = SIZE - m_write_index;
+        if (first_part > count)
+        {
+            first_part = count;
+        }
+        memcpy(&m_buffer[m_write_index], values, first_part * sizeof(T));
+        memcpy(&m_buffer[0u], &values[first_part], (count - first_part) * sizeof(T));
+
+        // Compute next index
+        m_write_index += count;
+        if (m_write_index >= SIZE)
+        {
+            m_write_index -= SIZE;
+        }
+
+        return count;
+    }
+
+    /** @brief Get the oldest values which are stored contiguously in the buffer, without removing them */
+    const T* peek(size_t& count) const
+    {
+        count = (m_write_index < m_read_index) ? (SIZE - m_read_index) : (m_write_index - m_read_index);
+        return &m_buffer[m_read_index];
+    }
+
+    /** @brief Remove the oldest values from the buffer */
+    void drop(size_t count)
+    {
+        if (count > get_count())
+        {
+            count = get_count();
+        }
+        m_read_index += count;
+        if (m_read_index >= SIZE)
+        {
+            m_read_index -= SIZE;
+        }
+    }
+
   private:
     /** @brief Buffer */
     T m_buffer[SIZE];
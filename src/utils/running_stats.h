@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_RUNNING_STATS_H
+#define OV_RUNNING_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ov
+{
+
+/** @brief 64 bits integer type with the signedness of an integer type */
+template <typename S>
+using running_stats_int64_t = typename std::conditional<std::is_signed<S>::value, int64_t, uint64_t>::type;
+
+/** @brief Default accumulator type of the squared values : 64 bits for the integer accumulators, the accumulator type otherwise */
+template <typename S>
+using running_stats_square_t = typename std::conditional<std::is_integral<S>::value, running_stats_int64_t<S>, S>::type;
+
+/**
+ * @brief Mean and variance over a sliding window with parametrizable depth
+ *        Sums are updated in O(1) on each new value, S is the accumulator type and must be able to hold the sum
+ *        of the values of the window, Q is the accumulator type of the variance and must be able to hold the sum
+ *        of the squared values of the window multiplied by the depth
+ */
+template <typename T, typename S, size_t MAX_DEPTH, typename Q = running_stats_square_t<S>>
+class running_stats
+{
+  public:
+    /** @brief Constructor */
+    constexpr running_stats() : m_values{}, m_depth(MAX_DEPTH), m_index(0u), m_count(0u), m_sum{}, m_sum_squares{} { }
+
+    /** @brief Set a new depth, clears the window */
+    constexpr bool set_depth(size_t new_depth)
+    {
+        bool ret = false;
+
+        // Check new depth
+        if ((new_depth > 0u) && (new_depth <= MAX_DEPTH))
+        {
+            m_depth = new_depth;
+            reset();
+            ret = true;
+        }
+
+        return ret;
+    }
+
+    /** @brief Get the depth */
+    constexpr size_t get_depth() const { return m_depth; }
+
+    /** @brief Get the number of values in the window */
+    constexpr size_t get_count() const { return m_count; }
+
+    /** @brief Indicate if the window is full */
+    constexpr bool is_full() const { return (m_count == m_depth); }
+
+    /** @brief Clear the window */
+    constexpr void reset()
+    {
+        m_index       = 0u;
+        m_count       = 0u;
+        m_sum         = S{};
+        m_sum_squares = Q{};
+    }
+
+    /** @brief Add value to the window and get the new mean value */
+    constexpr T add_value(const T& val)
+    {
+        // Remove oldest value
+        if (m_count == m_depth)
+        {
+            const S oldest        = static_cast<S>(m_values[m_index]);
+            const Q oldest_square = static_cast<Q>(m_values[m_index]);
+            m_sum -= oldest;
+            m_sum_squares -= oldest_square * oldest_square;
+        }
+        else
+        {
+            m_count++;
+        }
+
+        // Add new value
+        const Q q = static_cast<Q>(val);
+        m_sum += static_cast<S>(val);
+        m_sum_squares += q * q;
+        m_values[m_index] = val;
+        m_index++;
+        if (m_index == m_depth)
+        {
+            m_index = 0u;
+        }
+
+        return get_mean();
+    }
+
+    /** @brief Get the sum of the values in the window */
+    constexpr S get_sum() const { return m_sum; }
+
+    /** @brief Get the mean value */
+    constexpr T get_mean() const { return ((m_count != 0u) ? static_cast<T>(m_sum / static_cast<S>(m_count)) : T{}); }
+
+    /** @brief Get the population variance */
+    constexpr Q get_variance() const
+    {
+        Q variance{};
+        if (m_count != 0u)
+        {
+            const Q n   = static_cast<Q>(m_count);
+            const Q sum = static_cast<Q>(m_sum);
+            variance    = (n * m_sum_squares - sum * sum) / (n * n);
+        }
+        return variance;
+    }
+
+  private:
+    /** @brief Values */
+    T m_values[MAX_DEPTH];
+    /** @brief Depth */
+    size_t m_depth;
+    /** @brief Index of the next value to write */
+    size_t m_index;
+    /** @brief Number of values in the window */
+    size_t m_count;
+    /** @brief Sum of the values */
+    S m_sum;
+    /** @brief Sum of the squared values */
+    Q m_sum_squares;
+};
+
+} // namespace ov
+
+#endif // OV_RUNNING_STATS_H
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TEXT_WRITER_H
+#define OV_TEXT_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ov
+{
+
+/**
+ * @brief Format text into a caller provided buffer without varargs nor allocation
+ *        Value types are checked at compile time, the text is always null terminated
+ *        and is truncated if the buffer is too small
+ */
+class text_writer
+{
+  public:
+    /** @brief Maximum number of decimals of a fixed point value */
+    static constexpr uint8_t MAX_DECIMALS = 9u;
+
+    /** @brief Constructor */
+    text_writer(char* buffer, size_t size) : m_buffer(buffer), m_size(size), m_length(0u), m_truncated(false)
+    {
+        if (m_size != 0u)
+        {
+            m_buffer[0u] = 0;
+        }
+    }
+
+    /** @brief Constructor */
+    template <size_t SIZE>
+    text_writer(char (&buffer)[SIZE]) : text_writer(buffer, SIZE) { }
+
+    /** @brief Copy constructor */
+    text_writer(const text_writer& copy) = delete;
+    /** @brief Move constructor */
+    text_writer(text_writer&& move) = delete;
+    /** @brief Copy operator */
+    text_writer& operator=(text_writer& copy) = delete;
+
+    /** @brief Get the formatted text */
+    const char* c_str() const { return m_buffer; }
+
+    /** @brief Get the length of the formatted text */
+    size_t size() const { return m_length; }
+
+    /** @brief Indicate if the text has been truncated */
+    bool is_truncated() const { return m_truncated; }
+
+    /** @brief Write a character */
+    text_writer& write(char c)
+    {
+        put(c);
+        return *this;
+    }
+
+    /** @brief Write a null terminated string */
+    text_writer& write(const char* str)
+    {
+        while (*str != 0)
+        {
+            put(*str);
+            str++;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Write an integer value in decimal representation
+     *        Digits is the minimum number of digits (zero padding), the sign is not counted
+     */
+    template <typename T>
+    text_writer& write_int(T value, uint8_t digits = 0u, bool show_plus = false)
+    {
+        return write_fixed(value, 0u, digits, show_plus);
+    }
+
+    /**
+     * @brief Write a fixed point value with the given number of decimals (value = 1234, decimals = 2 => 12.34)
+     *        Digits is the minimum number of digits of the integer part (zero padding), the sign is not counted
+     */
+    template <typename T>
+    text_writer& write_fixed(T value, uint8_t decimals, uint8_t digits = 0u, bool show_plus = false)
+    {
+        static_assert(std::is_integral<T>::value && (sizeof(T) <= sizeof(uint32_t)), "Only integers up to 32 bits are supported");
+
+        // Sign
+        uint32_t magnitude = static_cast<uint32_t>(value);
+        if (std::is_signed<T>::value && (value < 0))
+        {
+            magnitude = 0u - magnitude;
+            put('-');
+        }
+        else if (show_plus)
+        {
+            put('+');
+        }
+
+        // Integer part and decimals
+        if (decimals > MAX_DECIMALS)
+        {
+            decimals = MAX_DECIMALS;
+        }
+        uint32_t scale = 1u;
+        for (uint8_t i = 0u; i < decimals; i++)
+        {
+            scale *= 10u;
+        }
+        put_unsigned(magnitude / scale, digits, 10u);
+        if (decimals != 0u)
+        {
+            put('.');
+            put_unsigned(magnitude % scale, decimals, 10u);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Write an unsigned value in uppercase hexadecimal representation
+     *        Digits is the minimum number of digits (zero padding)
+     */
+    template <typename T>
+    text_writer& write_hex(T value, uint8_t digits = 0u)
+    {
+        static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value && (sizeof(T) <= sizeof(uint32_t)),
+                      "Only unsigned integers up to 32 bits are supported");
+
+        put_unsigned(value, digits, 16u);
+        return *this;
+    }
+
+  private:
+    /** @brief Output buffer */
+    char* m_buffer;
+    /** @brief Size of the output buffer */
+    size_t m_size;
+    /** @brief Length of the formatted text */
+    size_t m_length;
+    /** @brief Indicate if the text has been truncated */
+    bool m_truncated;
+
+    /** @brief Add a character and keep the text null terminated */
+    void put(char c)
+    {
+        if ((m_length + 1u) < m_size)
+        {
+            m_buffer[m_length] = c;
+            m_length++;
+            m_buffer[m_length] = 0;
+        }
+        else
+        {
+            m_truncated = true;
+        }
+    }
+
+    /** @brief Add the digits of an unsigned value */
+    void put_unsigned(uint32_t value, uint8_t digits, uint32_t radix)
+    {
+        static const char DIGITS[] = "0123456789ABCDEF";
+
+        // Digits are computed from the least significant one
+        char    tmp[32u];
+        uint8_t count = 0u;
+        do
+        {
+            tmp[count] = DIGITS[value % radix];
+            value /= radix;
+            count++;
+        } while (value != 0u);
+        while ((count < digits) && (count < sizeof(tmp)))
+        {
+            tmp[count] = '0';
+            count++;
+        }
+        while (count != 0u)
+        {
+            count--;
+            put(tmp[count]);
+        }
+    }
+};
+
+} // namespace ov
+
+#endif // OV_TEXT_WRITER_H
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "airspace_checker.h"
+#include "airspace_importer.h"
+#include "fs.h"
+#include "host_fs.h"
+#include "ov_test.h"
+#include "random_generator.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace ov;
+
+/** @brief Check period of the airspace manager in milliseconds */
+static constexpr uint32_t CHECK_PERIOD_MS = 250u;
+
+/** @brief Maximum delay between an airspace entry and its report in milliseconds, an entry is reported at most 2 scans late */
+static constexpr uint32_t MAX_DETECTION_LATENCY_MS = 2000u;
+
+/** @brief Maximum number of updates of a scan before it is considered as stuck */
+static constexpr uint32_t MAX_UPDATES_PER_SCAN = 100000u;
+
+/** @brief Importer, too large for the stack */
+static airspace_importer s_importer;
+
+/** @brief OpenAir file writer */
+class openair_writer
+{
+  public:
+    /** @brief Constructor, creates the file */
+    openair_writer(const char* path) : m_file(fs::open(path, fs::o_creat | fs::o_trunc | fs::o_wronly)), m_size(0u), m_is_valid(true) { }
+
+    /** @brief Indicate if all the lines have been written */
+    bool is_valid() const { return m_is_valid && m_file.is_open(); }
+
+    /** @brief Get the size of the file in bytes */
+    size_t get_size() const { return m_size; }
+
+    /** @brief Close the file */
+    bool close()
+    {
+        const bool ret = is_valid();
+        return (m_file.close() && ret);
+    }
+
+    /** @brief Start an airspace */
+    void airspace(const char* cls, const char* name, const char* floor, const char* ceiling)
+    {
+        line("AC %s", cls);
+        line("AN %s", name);
+        line("AL %s", floor);
+        line("AH %s", ceiling);
+    }
+
+    /** @brief Polygon point */
+    void point(const geo::position& pos)
+    {
+        char coordinates[32u];
+        line("DP %s", format(pos, coordinates));
+    }
+
+    /** @brief Circle */
+    void circle(const geo::position& center, float radius_nm)
+    {
+        char coordinates[32u];
+        line("V X=%s", format(center, coordinates));
+        line("DC %.1f", static_cast<double>(radius_nm));
+    }
+
+  private:
+    /** @brief File */
+    file m_file;
+    /** @brief Size of the file in bytes */
+    size_t m_size;
+    /** @brief Indicate if all the lines have been written */
+    bool m_is_valid;
+
+    /** @brief Write a line */
+    template <typename... Args>
+    void line(const char* fmt, Args... args)
+    {
+        char   buffer[64u];
+        int    length      = snprintf(buffer, sizeof(buffer) - 1u, fmt, args...);
+        size_t write_count = 0u;
+        buffer[length]     = '\n';
+        m_is_valid         = m_is_valid && m_file.write(buffer, static_cast<size_t>(length) + 1u, write_count);
+        m_size += write_count;
+    }
+
+    /** @brief Format a position as "DD:MM:SS N DDD:MM:SS E" */
+    static const char* format(const geo::position& pos, char (&str)[32u])
+    {
+        const int32_t lat = static_cast<int32_t>(pos.latitude_deg() * 3600. + ((pos.latitude >= 0) ? 0.5 : -0.5));
+        const int32_t lon = static_cast<int32_t>(pos.longitude_deg() * 3600. + ((pos.longitude >= 0) ? 0.5 : -0.5));
+        const int32_t la  = (lat >= 0) ? lat : -lat;
+        const int32_t lo  = (lon >= 0) ? lon : -lon;
+        snprintf(str,
+                 sizeof(str),
+                 "%02d:%02d:%02d %c %03d:%02d:%02d %c",
+                 static_cast<int>(la / 3600),
+                 static_cast<int>((la / 60) % 60),
+                 static_cast<int>(la % 60),
+                 (lat >= 0) ? 'N' : 'S',
+                 static_cast<int>(lo / 3600),
+                 static_cast<int>((lo / 60) % 60),
+                 static_cast<int>(lo % 60),
+                 (lon >= 0) ? 'E' : 'W');
+        return str;
+    }
+};
+
+/** @brief Write an irregular polygon around a center */
+static void write_polygon(
+    openair_writer& writer, test::random_generator& random, const geo::position& center, float radius, uint32_t vertex_count)
+{
+    for (uint32_t i = 0u; i < vertex_count; i++)
+    {
+        const float bearing = 360.f * static_cast<float>(i) / static_cast<float>(vertex_count);
+        writer.point(geo::destination(center, bearing, radius * random.uniform(0.6f, 1.f)));
+    }
+}
+
+/**
+ * @brief Generate a national-size OpenAir file : 1500 polygons and 300 circles over the area of France,
+ *        with 250 of the polygons stacked over the same city to get a worst case grid cell
+ *        The real national files are not available offline, the counts and sizes mimic the French file
+ */
+static bool write_national_openair(const char* path, size_t& size)
+{
+    static const char* const CLASSES[]  = {"CTR", "D", "E", "R", "Q", "P", "C", "GP"};
+    static const char* const FLOORS[]   = {"SFC", "1500ft AGL", "FL65", "3500ft", "FL115"};
+    static const char* const CEILINGS[] = {"FL195", "FL115", "4500ft", "2000m", "UNL"};
+
+    test::random_generator random(0x0BE11A5Eu);
+    openair_writer         writer(path);
+    char                   name[32u];
+    for (uint32_t i = 0u; i < 1800u; i++)
+    {
+        snprintf(name, sizeof(name), "GEN %04u", static_cast<unsigned int>(i));
+        writer.airspace(CLASSES[i % 8u], name, FLOORS[i % 5u], CEILINGS[(i / 5u) % 5u]);
+        if (i < 250u)
+        {
+            // Stack of airspaces around Paris
+            const geo::position center = geo::destination(geo::position::from_degrees(48.86, 2.35), random.uniform(0.f, 360.f),
+                                                          random.uniform(0.f, 20000.f));
+            write_polygon(writer, random, center, random.uniform(3000.f, 40000.f), random.uniform(20u, 150u));
+        }
+        else
+        {
+            const geo::position center = geo::position::from_degrees(random.uniform(42.5f, 51.f), random.uniform(-4.5f, 7.5f));
+            if (i < 1500u)
+            {
+                write_polygon(writer, random, center, random.uniform(2000.f, 40000.f), random.uniform(6u, 120u));
+            }
+            else
+            {
+                writer.circle(center, random.uniform(1.f, 10.f));
+            }
+        }
+    }
+    size = writer.get_size();
+    return writer.close();
+}
+
+/** @brief Get the size of a file */
+static size_t get_file_size(const char* path)
+{
+    int32_t size = 0;
+    file    f    = fs::open(path, fs::o_rdonly);
+    f.seek(0, file::seek_end, size);
+    return static_cast<size_t>(size);
+}
+
+/** @brief Run a full scan and get the resulting status */
+static uint32_t scan(airspace_db& db, const geo::position& pos, int32_t altitude, airspace_status& status)
+{
+    airspace_checker checker;
+    terrain_status   terrain = {};
+    uint32_t         updates = 1u;
+    while (!checker.update(db, pos, altitude, terrain, status) && (updates < MAX_UPDATES_PER_SCAN))
+    {
+        updates++;
+    }
+    return updates;
+}
+
+OV_TEST(airspace, import_and_check)
+{
+    // CTR of 0.1° x 0.1° from the surface to 1500m and restricted area above it
+    OV_CHECK(test::format_host_fs());
+    OV_CHECK(fs::mkdir(airspace_db::AIRSPACE_DIR));
+    openair_writer writer(airspace_db::OPENAIR_FILE);
+    writer.airspace("CTR", "TEST CTR", "SFC", "1500m");
+    writer.point(geo::position::from_degrees(45.0, 5.7));
+    writer.point(geo::position::from_degrees(45.1, 5.7));
+    writer.point(geo::position::from_degrees(45.1, 5.8));
+    writer.point(geo::position::from_degrees(45.0, 5.8));
+    writer.airspace("R", "TEST R", "FL65", "FL95");
+    writer.circle(geo::position::from_degrees(45.05, 5.75), 2.f);
+    OV_CHECK(writer.close());
+
+    uint32_t airspace_count = 0u;
+    OV_CHECK(s_importer.import(airspace_db::OPENAIR_FILE, airspace_count));
+    OV_CHECK_EQ(airspace_count, 2u);
+
+    airspace_db db;
+    OV_CHECK(db.is_open());
+    OV_CHECK_EQ(db.get_header().airspace_count, 2u);
+    OV_CHECK_EQ(db.get_header().vertex_count, 4u + 360u / static_cast<uint32_t>(openair_parser::ARC_STEP));
+
+    // Inside the CTR
+    const geo::position center = geo::position::from_degrees(45.05, 5.75);
+    airspace_status     status = {};
+    scan(db, center, 1000, status);
+    OV_CHECK(status.is_valid);
+    OV_CHECK(status.proximity == airspace_status::level::inside);
+    OV_CHECK(strcmp(status.name, "TEST CTR") == 0);
+
+    // Between the CTR and the restricted area, nearer to the restricted area
+    scan(db, center, 1750, status);
+    OV_CHECK(status.proximity == airspace_status::level::near);
+    OV_CHECK(strcmp(status.name, "TEST R") == 0);
+    OV_CHECK_NEAR(status.vertical_distance, 1981 - 1750, 1);
+
+    // Lateral approach of the CTR from the west
+    scan(db, geo::destination(geo::position::from_degrees(45.05, 5.7), 270.f, 500.f), 1000, status);
+    OV_CHECK(status.proximity == airspace_status::level::warning);
+    OV_CHECK_NEAR(status.horizontal_distance, 500, 5);
+    scan(db, geo::destination(geo::position::from_degrees(45.05, 5.7), 270.f, 2000.f), 1000, status);
+    OV_CHECK(status.proximity == airspace_status::level::near);
+    scan(db, geo::destination(geo::position::from_degrees(45.05, 5.7), 270.f, 4000.f), 1000, status);
+    OV_CHECK(status.proximity == airspace_status::level::none);
+}
+
+OV_BENCHMARK(airspace, national_database)
+{
+    OV_CHECK(test::format_host_fs());
+    OV_CHECK(fs::mkdir(airspace_db::AIRSPACE_DIR));
+    size_t source_size = 0u;
+    OV_CHECK(write_national_openair(airspace_db::OPENAIR_FILE, source_size));
+
+    // Import
+    uint32_t        airspace_count = 0u;
+    test::stopwatch watch;
+    OV_CHECK(s_importer.import(airspace_db::OPENAIR_FILE, airspace_count));
+    const double import_ms = watch.elapsed_ns() / 1e6;
+    OV_CHECK_EQ(airspace_count, 1800u);
+
+    airspace_db db;
+    OV_CHECK(db.is_open());
+    const airspace_db::header& header = db.get_header();
+    test::report_result("OpenAir source", static_cast<double>(source_size) / 1024., "kB");
+    test::report_result("import", import_ms, "ms");
+    test::report_result("airspaces", header.airspace_count, "");
+    test::report_result("vertices", header.vertex_count, "");
+    test::report_result("grid", static_cast<double>(header.grid_columns) * header.grid_rows, "cells");
+    test::report_result("cell items", header.item_count, "");
+    test::report_result("index file", static_cast<double>(get_file_size(airspace_db::INDEX_FILE)) / 1024., "kB");
+    test::report_result("records file", static_cast<double>(get_file_size(airspace_db::RECORDS_FILE)) / 1024., "kB");
+    test::report_result("vertices file", static_cast<double>(get_file_size(airspace_db::VERTICES_FILE)) / 1024., "kB");
+
+    // Densest cell of the grid
+    geo::position worst_pos   = {};
+    uint32_t      worst_items = 0u;
+    for (uint32_t row = 0u; row < header.grid_rows; row++)
+    {
+        for (uint32_t column = 0u; column < header.grid_columns; column++)
+        {
+            const geo::position pos = {static_cast<int32_t>(header.grid_origin.latitude + (2 * row + 1) * header.cell_size / 2),
+                                       static_cast<int32_t>(header.grid_origin.longitude + (2 * column + 1) * header.cell_size / 2)};
+            airspace_db::cell   c;
+            if (db.get_cell(pos, c) && (c.item_count > worst_items))
+            {
+                worst_items = c.item_count;
+                worst_pos   = pos;
+            }
+        }
+    }
+    test::report_result("densest cell", worst_items, "airspaces");
+
+    // Scans of the densest cell, each update is bounded by MAX_WORK_PER_UPDATE reads of records or vertices
+    airspace_checker checker;
+    terrain_status   terrain     = {};
+    airspace_status  status      = {};
+    uint32_t         updates     = 0u;
+    double           max_ns      = 0.;
+    double           total_ns    = 0.;
+    size_t           max_read    = 0u;
+    bool             is_complete = false;
+    while (!is_complete && (updates < MAX_UPDATES_PER_SCAN))
+    {
+        const size_t read_bytes = test::get_host_fs_read_bytes();
+        watch.restart();
+        is_complete              = checker.update(db, worst_pos, 1000, terrain, status);
+        const double update_ns   = watch.elapsed_ns();
+        const size_t update_read = test::get_host_fs_read_bytes() - read_bytes;
+        max_ns                   = (update_ns > max_ns) ? update_ns : max_ns;
+        max_read                 = (update_read > max_read) ? update_read : max_read;
+        total_ns += update_ns;
+        updates++;
+    }
+    OV_CHECK(is_complete);
+    OV_CHECK(status.is_valid);
+    test::report_result("MAX_WORK_PER_UPDATE", airspace_checker::MAX_WORK_PER_UPDATE, "reads");
+    test::report_result("worst update", max_ns / 1e3, "us");
+    test::report_result("worst update flash reads", static_cast<double>(max_read) / 1024., "kB");
+    test::report_result("mean update", total_ns / updates / 1e3, "us");
+    test::report_result("updates per scan", updates, "");
+    test::report_result("scan latency", static_cast<double>(updates) * CHECK_PERIOD_MS / 1000., "s");
+    test::report_result("worst detection latency", static_cast<double>(2u * updates * CHECK_PERIOD_MS) / 1000., "s");
+    OV_CHECK((2u * updates * CHECK_PERIOD_MS) <= MAX_DETECTION_LATENCY_MS);
+}
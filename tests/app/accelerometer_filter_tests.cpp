@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "accelerometer_filter.h"
+#include "ov_test.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ov;
+
+/** @brief FIFO sample rate of the ISM330DHCX in Hz */
+static constexpr uint16_t FIFO_RATE = 104u;
+
+/** @brief Build a FIFO sample : 1g on Z plus a sine wave on X and Z */
+static i_accelerometer_sensor::data fifo_sample(uint32_t index, double frequency, double amplitude)
+{
+    const double                 wave   = amplitude * std::sin(2. * M_PI * frequency * index / FIFO_RATE);
+    i_accelerometer_sensor::data sample = {};
+    sample.x_accel                      = static_cast<int16_t>(std::lround(wave));
+    sample.z_accel                      = static_cast<int16_t>(std::lround(1000. + wave));
+    sample.is_valid                     = true;
+    return sample;
+}
+
+OV_TEST(accelerometer_filter, one_sample_per_acquisition_period)
+{
+    accelerometer_filter filter(FIFO_RATE);
+    OV_CHECK(!filter.get_sample().is_valid);
+
+    // 104Hz FIFO samples reduced to the 250ms period of the main loop
+    uint32_t outputs = 0u;
+    for (uint32_t i = 1u; i <= (10u * accelerometer_filter::DECIMATION); i++)
+    {
+        const bool has_output = filter.add_sample(fifo_sample(i, 0., 0.));
+        OV_CHECK_EQ(has_output, ((i % accelerometer_filter::DECIMATION) == 0u));
+        if (has_output)
+        {
+            outputs++;
+        }
+    }
+    OV_CHECK_EQ(outputs, 10u);
+
+    // Gravity goes through unchanged
+    const i_accelerometer_sensor::data& output = filter.get_sample();
+    OV_CHECK(output.is_valid);
+    OV_CHECK_EQ(output.x_accel, 0);
+    OV_CHECK_EQ(output.y_accel, 0);
+    OV_CHECK_EQ(output.z_accel, 1000);
+    OV_CHECK_EQ(output.total_accel, 1000);
+
+    // Reset invalidates the output
+    filter.reset();
+    OV_CHECK(!filter.get_sample().is_valid);
+}
+
+OV_TEST(accelerometer_filter, vibrations_are_rejected)
+{
+    // 17Hz vibration of 0.5g : aliased at 1Hz by a plain subsampling and only reduced
+    // to about 27mg by the block mean alone, the low-pass filter removes it
+    accelerometer_filter filter(FIFO_RATE);
+    int32_t              max_error = 0;
+    for (uint32_t i = 0u; i < (40u * accelerometer_filter::DECIMATION); i++)
+    {
+        if (filter.add_sample(fifo_sample(i, 17., 500.)) && (i > (4u * accelerometer_filter::DECIMATION)))
+        {
+            const i_accelerometer_sensor::data& output = filter.get_sample();
+            max_error = std::max(max_error, std::abs(static_cast<int32_t>(output.x_accel)));
+            max_error = std::max(max_error, std::abs(static_cast<int32_t>(output.z_accel) - 1000));
+        }
+    }
+    test::report_result("17Hz residual", max_error, "mg");
+    OV_CHECK(max_error <= 5);
+}
+
+OV_TEST(accelerometer_filter, load_factor_variations_are_kept)
+{
+    // Slow load factor variation while circling
+    accelerometer_filter filter(FIFO_RATE);
+    int32_t              max_output = 0;
+    for (uint32_t i = 0u; i < (40u * accelerometer_filter::DECIMATION); i++)
+    {
+        if (filter.add_sample(fifo_sample(i, 0.2, 500.)) && (i > (20u * accelerometer_filter::DECIMATION)))
+        {
+            max_output = std::max(max_output, static_cast<int32_t>(filter.get_sample().x_accel));
+        }
+    }
+    test::report_result("0.2Hz amplitude", max_output, "mg");
+    OV_CHECK(max_output >= 450);
+}
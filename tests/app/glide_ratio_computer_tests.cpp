@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "glide_ratio_computer.h"
+#include "ov_data.h"
+#include "ov_test.h"
+
+using namespace ov;
+
+/** @brief Acquisition period of the main loop in milliseconds */
+static constexpr uint32_t PERIOD_MS = 250u;
+
+/** @brief Integration window in milliseconds */
+static constexpr uint32_t WINDOW_MS = 20000u;
+
+/** @brief Synthetic straight glide : 10m/s ground speed towards the east, 1m/s sink rate, glide ratio = 10 */
+class synthetic_glide
+{
+  public:
+    /** @brief Expected glide ratio (1 = 0.1) */
+    static constexpr uint16_t GLIDE_RATIO = 100u;
+
+    /** @brief Constructor */
+    synthetic_glide() : m_start(geo::position::from_degrees(45.2, 5.7)), m_timestamp(0u) { }
+
+    /** @brief Get the timestamp of the next sample in milliseconds */
+    uint32_t get_timestamp() const { return m_timestamp; }
+
+    /** @brief Feed the next sample to the computer and get the computed glide ratio */
+    uint16_t step(glide_ratio_computer& computer, bool gnss_valid)
+    {
+        const float         elapsed  = static_cast<float>(m_timestamp) / 1000.f;
+        const geo::position position = geo::destination(m_start, 90.f, 10.f * elapsed);
+
+        i_gnss::data gnss = {};
+        gnss.latitude     = position.latitude_deg();
+        gnss.longitude    = position.longitude_deg();
+        gnss.speed        = 100u;
+        gnss.is_valid     = gnss_valid;
+
+        const int32_t  altitude    = 20000 - static_cast<int32_t>(m_timestamp / 100u);
+        const uint16_t glide_ratio = computer.update(gnss, altitude, m_timestamp);
+        m_timestamp += PERIOD_MS;
+        return glide_ratio;
+    }
+
+  private:
+    /** @brief Start position */
+    geo::position m_start;
+    /** @brief Timestamp of the next sample in milliseconds */
+    uint32_t m_timestamp;
+};
+
+/** @brief Check that a glide ratio matches the synthetic glide */
+static bool is_expected_glide_ratio(uint16_t glide_ratio)
+{
+    return ((glide_ratio >= (synthetic_glide::GLIDE_RATIO - 1u)) && (glide_ratio <= (synthetic_glide::GLIDE_RATIO + 1u)));
+}
+
+OV_TEST(glide_ratio_computer, steady_glide)
+{
+    glide_ratio_computer computer;
+    computer.set_window(WINDOW_MS);
+    OV_CHECK_EQ(computer.get_depth(), WINDOW_MS / glide_ratio_computer::SLOT_DURATION_MS);
+
+    // Invalid until the window is filled, then the glide ratio of the track
+    synthetic_glide glide;
+    while (glide.get_timestamp() < WINDOW_MS)
+    {
+        OV_CHECK_EQ(glide.step(computer, true), ov_data::INVALID_GLIDE_RATIO_VALUE);
+    }
+    while (glide.get_timestamp() < (3u * WINDOW_MS))
+    {
+        OV_CHECK(is_expected_glide_ratio(glide.step(computer, true)));
+    }
+}
+
+OV_TEST(glide_ratio_computer, short_gnss_gap_is_bridged)
+{
+    glide_ratio_computer computer;
+    computer.set_window(WINDOW_MS);
+
+    synthetic_glide glide;
+    while (glide.get_timestamp() < (2u * WINDOW_MS))
+    {
+        glide.step(computer, true);
+    }
+
+    // Dropout up to the limit : the last glide ratio is kept during the dropout, then the straight line
+    // between the surrounding fixes is spread over the slots of the dropout so that the window stays exact
+    const uint32_t gap_end = glide.get_timestamp() + glide_ratio_computer::MAX_GNSS_GAP_MS - PERIOD_MS;
+    while (glide.get_timestamp() < gap_end)
+    {
+        OV_CHECK(is_expected_glide_ratio(glide.step(computer, false)));
+    }
+    while (glide.get_timestamp() < (4u * WINDOW_MS))
+    {
+        OV_CHECK(is_expected_glide_ratio(glide.step(computer, true)));
+    }
+}
+
+OV_TEST(glide_ratio_computer, long_gnss_gap_restarts_window)
+{
+    glide_ratio_computer computer;
+    computer.set_window(WINDOW_MS);
+
+    synthetic_glide glide;
+    while (glide.get_timestamp() < (2u * WINDOW_MS))
+    {
+        glide.step(computer, true);
+    }
+
+    // Dropout longer than the limit : the window restarts once the limit is exceeded
+    const uint32_t gap_start     = glide.get_timestamp();
+    const uint32_t gap_end       = gap_start + 2u * glide_ratio_computer::MAX_GNSS_GAP_MS;
+    uint32_t       invalid_since = 0u;
+    while (glide.get_timestamp() < gap_end)
+    {
+        const uint32_t timestamp = glide.get_timestamp();
+        if ((glide.step(computer, false) == ov_data::INVALID_GLIDE_RATIO_VALUE) && (invalid_since == 0u))
+        {
+            invalid_since = timestamp;
+        }
+    }
+    OV_CHECK_EQ(invalid_since, gap_start + glide_ratio_computer::MAX_GNSS_GAP_MS);
+
+    // The result stays invalid for a full window after the first fix, and then matches the track again
+    // without any contribution of the distance travelled during the dropout
+    const uint32_t restart = glide.get_timestamp();
+    while (glide.get_timestamp() < (restart + WINDOW_MS))
+    {
+        OV_CHECK_EQ(glide.step(computer, true), ov_data::INVALID_GLIDE_RATIO_VALUE);
+    }
+    OV_CHECK(is_expected_glide_ratio(glide.step(computer, true)));
+    while (glide.get_timestamp() < (restart + 2u * WINDOW_MS))
+    {
+        OV_CHECK(is_expected_glide_ratio(glide.step(computer, true)));
+    }
+}
+
+OV_TEST(glide_ratio_computer, window_limits)
+{
+    glide_ratio_computer computer;
+    computer.set_window(0u);
+    OV_CHECK_EQ(computer.get_depth(), glide_ratio_computer::MIN_SLOTS);
+    computer.set_window(1000000u);
+    OV_CHECK_EQ(computer.get_depth(), glide_ratio_computer::MAX_SLOTS);
+}
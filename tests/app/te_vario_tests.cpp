@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "delay_line.h"
+#include "glider_polar.h"
+#include "median_filter.h"
+#include "ov_test.h"
+#include "random_generator.h"
+#include "running_stats.h"
+#include "speed_to_fly.h"
+#include "te_vario.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace ov;
+
+/** @brief Acquisition period of the main loop in milliseconds, as in the firmware */
+static constexpr uint32_t PERIOD_MS = 100u;
+
+/** @brief Period of the GNSS fixes in milliseconds (default rate of the u-blox SAM-M8Q) */
+static constexpr uint32_t FIX_PERIOD_MS = 1000u;
+
+/** @brief Number of altitudes of the sink rate window (default integration time of 2s) */
+static constexpr size_t SINK_RATE_DEPTH = 2000u / PERIOD_MS;
+
+/** @brief Maximum acceleration along the flight path when changing speed (m/s²) */
+static constexpr float MAX_ACCEL = 3.f;
+
+/** @brief Number of replayed flights of each test */
+static constexpr uint32_t FLIGHT_COUNT = 20u;
+
+/** @brief Standard gravity (m/s²) */
+static constexpr float GRAVITY = 9.80665f;
+
+/** @brief Degrees to radians */
+static constexpr float DEG_TO_RAD = 3.14159265f / 180.f;
+
+/** @brief Output of the replay at each period of the main loop */
+struct sample
+{
+    /** @brief Time since the start of the replay in milliseconds */
+    uint32_t time;
+    /** @brief Barometric vario as displayed (m/s, positive when climbing) */
+    float raw;
+    /** @brief Indicate if the total energy and netto varios are valid */
+    bool is_valid;
+    /** @brief Total energy vario as displayed (m/s) */
+    float te;
+    /** @brief Netto vario as displayed (m/s) */
+    float netto;
+    /** @brief True total energy vario : vertical speed of the air mass minus the sink of the polar (m/s) */
+    float expected_te;
+    /** @brief Vertical speed of the air mass (m/s) */
+    float lift;
+    /** @brief True airspeed (m/s) */
+    float airspeed;
+    /** @brief Airspeed estimated by the total energy vario (m/s) */
+    float estimated_airspeed;
+};
+
+/**
+ * @brief Replay of a simulated flight through the same sensor pipeline as the main loop of the firmware
+ *        The glider flies its polar in an air mass moving with the wind and a vertical speed, the exchanges between
+ *        height and speed are exact. The barometric altitude is noisy and sampled at each period, the GNSS fixes are
+ *        noisy, come at 1Hz and are held in between as with the real receiver.
+ */
+class replay
+{
+  public:
+    /** @brief Constructor : random seed, polar flown and initial airspeed (m/s) */
+    replay(uint32_t seed, const glider_polar& polar, float airspeed)
+        : m_random(seed),
+          m_polar(polar),
+          m_speed_to_fly(),
+          m_te(),
+          m_altitude_filter(),
+          m_altitudes(),
+          m_sink_rate_filter(),
+          m_te_filter(),
+          m_time(0u),
+          m_altitude(1500.f),
+          m_airspeed(airspeed),
+          m_heading(0.f),
+          m_wind_speed(0.f),
+          m_wind_direction(0.f),
+          m_lift(0.f),
+          m_gnss_valid(true),
+          m_fix(),
+          m_samples()
+    {
+        m_speed_to_fly.set_polar(polar);
+        m_altitudes.set_depth(SINK_RATE_DEPTH);
+        m_te.set_window(SINK_RATE_DEPTH, PERIOD_MS);
+    }
+
+    /** @brief Enable or disable the wind correction of the airspeed */
+    void set_wind_correction(bool enabled) { m_te.set_wind_correction(enabled); }
+
+    /** @brief Set the wind : speed (m/s) and direction the wind is blowing to (°) */
+    void set_wind(float speed, float direction)
+    {
+        m_wind_speed     = speed;
+        m_wind_direction = direction;
+    }
+
+    /** @brief Set the vertical speed of the air mass (m/s, positive upwards) */
+    void set_lift(float lift) { m_lift = lift; }
+
+    /** @brief Indicate if the GNSS provides fixes */
+    void set_gnss(bool valid) { m_gnss_valid = valid; }
+
+    /** @brief Get the current time in milliseconds */
+    uint32_t get_time() const { return m_time; }
+
+    /** @brief Indicate if the wind has been estimated */
+    bool is_wind_valid() const { return m_te.is_wind_valid(); }
+
+    /** @brief Get the samples of the replay */
+    const std::vector<sample>& get_samples() const { return m_samples; }
+
+    /** @brief Get the true sink rate of the polar at an airspeed (m/s, positive when sinking) */
+    float get_polar_sink(float airspeed) const
+    {
+        // Parabola through the 3 points of the polar (Lagrange form)
+        float sink = 0.f;
+        for (size_t i = 0u; i < glider_polar::POINTS_COUNT; i++)
+        {
+            float term = static_cast<float>(m_polar.sinks[i]) / 100.f;
+            for (size_t j = 0u; j < glider_polar::POINTS_COUNT; j++)
+            {
+                if (j != i)
+                {
+                    const float vi = static_cast<float>(m_polar.speeds[i]) / 3.6f;
+                    const float vj = static_cast<float>(m_polar.speeds[j]) / 3.6f;
+                    term *= (airspeed - vj) / (vi - vj);
+                }
+            }
+            sink += term;
+        }
+        return sink;
+    }
+
+    /** @brief Fly for a duration (ms) towards an airspeed (m/s) with a turn rate (°/s, positive to the right) */
+    void fly(uint32_t duration, float airspeed, float turn_rate)
+    {
+        const uint32_t end = m_time + duration;
+        while (m_time < end)
+        {
+            step(airspeed, turn_rate);
+        }
+    }
+
+  private:
+    /** @brief Random generator */
+    test::random_generator m_random;
+    /** @brief Polar flown */
+    const glider_polar& m_polar;
+    /** @brief Speed to fly computation of the polar, as selected in the firmware */
+    speed_to_fly m_speed_to_fly;
+    /** @brief Total energy vario */
+    te_vario m_te;
+    /** @brief Altitude spikes rejection, as in the main loop */
+    median_filter<int32_t, 3u> m_altitude_filter;
+    /** @brief Altitudes of the sink rate window, as in the main loop */
+    delay_line<int32_t, te_vario::MAX_DEPTH> m_altitudes;
+    /** @brief Mean of the barometric sink rate, as in the main loop */
+    running_stats<int16_t, int32_t, 1000u / PERIOD_MS> m_sink_rate_filter;
+    /** @brief Mean of the total energy sink rate, as in the main loop */
+    running_stats<int16_t, int32_t, 1000u / PERIOD_MS> m_te_filter;
+    /** @brief Current time in milliseconds */
+    uint32_t m_time;
+    /** @brief True altitude (m) */
+    float m_altitude;
+    /** @brief True airspeed (m/s) */
+    float m_airspeed;
+    /** @brief Heading (°) */
+    float m_heading;
+    /** @brief Wind speed (m/s) */
+    float m_wind_speed;
+    /** @brief Direction the wind is blowing to (°) */
+    float m_wind_direction;
+    /** @brief Vertical speed of the air mass (m/s) */
+    float m_lift;
+    /** @brief Indicate if the GNSS provides fixes */
+    bool m_gnss_valid;
+    /** @brief Last GNSS fix */
+    i_gnss::data m_fix;
+    /** @brief Samples of the replay */
+    std::vector<sample> m_samples;
+
+    /** @brief Simulate a period of the main loop */
+    void step(float target_airspeed, float turn_rate)
+    {
+        // Flight path : the kinetic energy gained or lost is exchanged with height
+        const float dt       = static_cast<float>(PERIOD_MS) / 1000.f;
+        const float max_step = MAX_ACCEL * dt;
+        const float airspeed = m_airspeed + std::fmax(-max_step, std::fmin(max_step, target_airspeed - m_airspeed));
+        const float expected = m_lift - get_polar_sink(0.5f * (m_airspeed + airspeed));
+        m_altitude += expected * dt - (airspeed * airspeed - m_airspeed * m_airspeed) / (2.f * GRAVITY);
+        m_airspeed = airspeed;
+        m_heading  = std::fmod(m_heading + turn_rate * dt + 360.f, 360.f);
+
+        // GNSS fix at 1Hz, the ground speed vector is the airspeed vector plus the wind vector
+        if ((m_time % FIX_PERIOD_MS) == 0u)
+        {
+            const float east  = m_airspeed * std::sin(m_heading * DEG_TO_RAD) + m_wind_speed * std::sin(m_wind_direction * DEG_TO_RAD);
+            const float north = m_airspeed * std::cos(m_heading * DEG_TO_RAD) + m_wind_speed * std::cos(m_wind_direction * DEG_TO_RAD);
+            const float speed = std::sqrt(east * east + north * north) + m_random.gaussian(0.f, 0.1f);
+            const float track = std::atan2(east, north) / DEG_TO_RAD + m_random.gaussian(0.f, 1.f);
+            m_fix.speed       = static_cast<uint32_t>(std::lround(std::fmax(speed, 0.f) * 10.f));
+            m_fix.track_angle = static_cast<uint16_t>(std::lround(std::fmod(track + 360.f, 360.f) * 10.f) % 3600);
+        }
+        m_fix.is_valid = m_gnss_valid;
+        m_time += PERIOD_MS;
+
+        // Barometric sink rate, same computation as the main loop
+        const float   measured  = m_altitude + m_random.gaussian(0.f, 0.1f);
+        const int32_t altitude  = m_altitude_filter.add_value(static_cast<int32_t>(std::lround(measured * 10.f)));
+        int16_t       sink_rate = 0;
+        m_altitudes.add_value(altitude);
+        if (m_altitudes.is_full())
+        {
+            const int32_t delta_alti = altitude - m_altitudes.get_oldest_value();
+            const int32_t delta_time = static_cast<int32_t>((m_altitudes.get_depth() - 1u) * PERIOD_MS);
+            sink_rate                = static_cast<int16_t>((delta_alti * 1000) / delta_time);
+        }
+        const int16_t mean_sink_rate = m_sink_rate_filter.add_value(sink_rate);
+
+        // Total energy and netto sink rates, same computation as the main loop
+        sample s             = {};
+        s.time               = m_time;
+        s.raw                = static_cast<float>(mean_sink_rate) / 10.f;
+        s.expected_te        = expected;
+        s.lift               = m_lift;
+        s.airspeed           = m_airspeed;
+        s.is_valid           = m_te.update(m_fix, sink_rate, m_time) && m_altitudes.is_full();
+        s.estimated_airspeed = static_cast<float>(m_te.get_airspeed()) / 10.f;
+        if (s.is_valid)
+        {
+            const int16_t te_sink_rate = m_te_filter.add_value(m_te.get_te_sink_rate());
+            s.te                       = static_cast<float>(te_sink_rate) / 10.f;
+            s.netto                    = static_cast<float>(m_te.get_netto_sink_rate(te_sink_rate, m_speed_to_fly)) / 10.f;
+        }
+        m_samples.push_back(s);
+    }
+};
+
+/** @brief Find a polar of the database by its name */
+static const glider_polar& find_polar(const char* name)
+{
+    const glider_polar* ret = polar::get(0u);
+    for (size_t i = 0u; i < polar::get_count(); i++)
+    {
+        if (strcmp(polar::get(i)->name, name) == 0)
+        {
+            ret = polar::get(i);
+        }
+    }
+    return *ret;
+}
+
+/** @brief Statistics of the samples of a time range */
+struct sample_stats
+{
+    /** @brief Number of valid total energy samples */
+    size_t count;
+    /** @brief Maximum of the barometric vario (m/s) */
+    float max_raw;
+    /** @brief Maximum error of the barometric vario as a total energy vario (m/s) */
+    float max_raw_error;
+    /** @brief Maximum of the total energy vario (m/s) */
+    float max_te;
+    /** @brief Maximum error of the total energy vario (m/s) */
+    float max_te_error;
+    /** @brief Mean of the netto vario (m/s) */
+    float mean_netto;
+    /** @brief Maximum error of the netto vario (m/s) */
+    float max_netto_error;
+    /** @brief Maximum error of the estimated airspeed (m/s) */
+    float max_airspeed_error;
+};
+
+/** @brief Compute the statistics of the samples in [start, end[ (ms) */
+static sample_stats get_stats(const replay& r, uint32_t start, uint32_t end)
+{
+    sample_stats stats = {0u, -100.f, 0.f, -100.f, 0.f, 0.f, 0.f, 0.f};
+    for (const sample& s : r.get_samples())
+    {
+        if ((s.time >= start) && (s.time < end))
+        {
+            stats.max_raw       = std::fmax(stats.max_raw, s.raw);
+            stats.max_raw_error = std::fmax(stats.max_raw_error, std::fabs(s.raw - s.expected_te));
+            if (s.is_valid)
+            {
+                stats.count++;
+                stats.max_te             = std::fmax(stats.max_te, s.te);
+                stats.max_te_error       = std::fmax(stats.max_te_error, std::fabs(s.te - s.expected_te));
+                stats.mean_netto         += s.netto;
+                stats.max_netto_error    = std::fmax(stats.max_netto_error, std::fabs(s.netto - s.lift));
+                stats.max_airspeed_error = std::fmax(stats.max_airspeed_error, std::fabs(s.estimated_airspeed - s.airspeed));
+            }
+        }
+    }
+    if (stats.count != 0u)
+    {
+        stats.mean_netto /= static_cast<float>(stats.count);
+    }
+    return stats;
+}
+
+/** @brief Count the samples without valid total energy in [start, end[ (ms) */
+static size_t count_invalid(const replay& r, uint32_t start, uint32_t end)
+{
+    size_t count = 0u;
+    for (const sample& s : r.get_samples())
+    {
+        if ((s.time >= start) && (s.time < end) && !s.is_valid)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+OV_TEST(te_vario, dive_and_pull_up)
+{
+    // Sailplane cruising at 90km/h in still air, diving to 144km/h then pulling up to 80km/h : the barometric vario
+    // shows the height exchanged with the speed, the total energy vario keeps showing the sink of the polar.
+    // The GNSS speed is held between the 1Hz fixes so that the kinetic energy lags the altitude by up to a second
+    const glider_polar& ask21         = find_polar("ASK 21");
+    float               max_glide     = 0.f;
+    float               max_te        = -100.f;
+    float               max_error     = 0.f;
+    float               min_raw       = 100.f;
+    float               min_rejection = 100.f;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        replay r(0x7E000000u + i, ask21, 25.f);
+        r.fly(30000u, 25.f, 0.f);
+        const uint32_t dive_start = r.get_time();
+        r.fly(15000u, 40.f, 0.f);
+        const uint32_t pull_up_start = r.get_time();
+        r.fly(35000u, 22.f, 0.f);
+
+        // Steady glide
+        const sample_stats glide = get_stats(r, 3000u, dive_start);
+        OV_CHECK(glide.count != 0u);
+        OV_CHECK(glide.max_te_error <= 0.8f);
+
+        // The pull-up is a strong climb on the barometric vario and not on the total energy vario
+        const sample_stats maneuver = get_stats(r, dive_start, r.get_time());
+        const sample_stats pull_up  = get_stats(r, pull_up_start, r.get_time());
+        OV_CHECK(pull_up.max_raw >= 8.f);
+        OV_CHECK(pull_up.max_te <= 1.5f);
+        OV_CHECK(maneuver.max_te_error <= (0.3f * maneuver.max_raw_error));
+
+        max_glide     = std::fmax(max_glide, glide.max_te_error);
+        max_te        = std::fmax(max_te, pull_up.max_te);
+        max_error     = std::fmax(max_error, maneuver.max_te_error);
+        min_raw       = std::fmin(min_raw, pull_up.max_raw);
+        min_rejection = std::fmin(min_rejection, maneuver.max_raw_error / maneuver.max_te_error);
+    }
+    test::report_result("max total energy error in steady glide", max_glide, "m/s");
+    test::report_result("min barometric climb in the pull-up", min_raw, "m/s");
+    test::report_result("max total energy climb in the pull-up", max_te, "m/s");
+    test::report_result("max total energy error in the maneuver", max_error, "m/s");
+    test::report_result("min ratio of the barometric and total energy errors", min_rejection, "");
+}
+
+OV_TEST(te_vario, gnss_dropout_reset)
+{
+    // The GNSS is lost for 5s while the glider slows down from 126km/h to 90km/h : the kinetic energy lost during the dropout
+    // is unknown so that the total energy is invalid until its window is filled again, then it is not disturbed
+    static constexpr uint32_t DROPOUT   = 5000u;
+    const glider_polar&       ask21     = find_polar("ASK 21");
+    float                     max_te    = -100.f;
+    float                     max_error = 0.f;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        replay r(0x7E100000u + i, ask21, 35.f);
+        r.fly(30000u, 35.f, 0.f);
+        const uint32_t dropout_start = r.get_time();
+        OV_CHECK_EQ(count_invalid(r, 3000u, dropout_start), 0u);
+        r.set_gnss(false);
+        r.fly(DROPOUT, 25.f, 0.f);
+        r.set_gnss(true);
+        const uint32_t dropout_end = r.get_time();
+        r.fly(30000u, 25.f, 0.f);
+
+        // Invalid during the dropout and the next window
+        OV_CHECK_EQ(count_invalid(r, dropout_start, r.get_time()), (DROPOUT / PERIOD_MS) + SINK_RATE_DEPTH - 1u);
+
+        // The height gained during the dropout is not seen as a climb
+        const sample_stats recovery = get_stats(r, dropout_end, r.get_time());
+        OV_CHECK(recovery.count != 0u);
+        OV_CHECK(recovery.max_te < 0.f);
+        OV_CHECK(recovery.max_te_error <= 0.7f);
+
+        max_te    = std::fmax(max_te, recovery.max_te);
+        max_error = std::fmax(max_error, recovery.max_te_error);
+    }
+    test::report_result("max total energy after the dropout", max_te, "m/s");
+    test::report_result("max total energy error after the dropout", max_error, "m/s");
+}
+
+OV_TEST(te_vario, circle_wind_estimate)
+{
+    // Thermalling at 86km/h in 20s circles in a 2m/s thermal drifting with a 18km/h wind : the ground speed varies by twice
+    // the wind speed over each circle, the wind estimated on the first circle removes it from the airspeed
+    const glider_polar& ask21              = find_polar("ASK 21");
+    float               max_airspeed_error = 0.f;
+    float               max_error          = 0.f;
+    float               min_raw_error      = 100.f;
+    float               max_netto_bias     = 0.f;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        sample_stats stats[2u];
+        for (size_t corrected = 0u; corrected < 2u; corrected++)
+        {
+            replay r(0x7E200000u + i, ask21, 24.f);
+            r.set_wind_correction(corrected != 0u);
+            r.set_wind(5.f, 30.f * static_cast<float>(i % 12u));
+            r.set_lift(2.f);
+            r.fly(20000u, 24.f, 0.f);
+            OV_CHECK(!r.is_wind_valid());
+            const uint32_t circling_start = r.get_time();
+            r.fly(120000u, 24.f, (i % 2u) == 0u ? 18.f : -18.f);
+            OV_CHECK(r.is_wind_valid());
+
+            // From the end of the first circle and of the next window
+            stats[corrected] = get_stats(r, circling_start + 25000u, r.get_time());
+            OV_CHECK(stats[corrected].count != 0u);
+        }
+
+        // Without correction the kinetic energy of the ground speed is seen as lift and sink over each circle
+        OV_CHECK(stats[0u].max_airspeed_error >= 4.f);
+        OV_CHECK(stats[0u].max_te_error >= 3.f);
+
+        // With the correction the airspeed is steady and the netto vario shows the thermal, the residual error comes from
+        // the wind estimated from the extreme ground speeds of fixes 18° apart
+        const sample_stats& corrected = stats[1u];
+        OV_CHECK(corrected.max_airspeed_error <= 2.5f);
+        OV_CHECK(corrected.max_te_error <= (0.7f * stats[0u].max_te_error));
+        OV_CHECK_NEAR(corrected.mean_netto, 2.f, 0.3f);
+
+        max_airspeed_error = std::fmax(max_airspeed_error, corrected.max_airspeed_error);
+        max_error          = std::fmax(max_error, corrected.max_te_error);
+        min_raw_error      = std::fmin(min_raw_error, stats[0u].max_te_error);
+        max_netto_bias     = std::fmax(max_netto_bias, std::fabs(corrected.mean_netto - 2.f));
+    }
+    test::report_result("max airspeed error with the wind correction", max_airspeed_error, "m/s");
+    test::report_result("min total energy error without the wind correction", min_raw_error, "m/s");
+    test::report_result("max total energy error with the wind correction", max_error, "m/s");
+    test::report_result("max netto bias in the thermal", max_netto_bias, "m/s");
+}
+
+OV_TEST(te_vario, netto_in_still_air)
+{
+    // Straight glides at speeds across the polar : the netto vario removes the sink of the polar at the airspeed,
+    // it shows no vertical air speed in still air and the lift of a rising air mass
+    const glider_polar& ask21     = find_polar("ASK 21");
+    float               max_bias  = 0.f;
+    float               max_error = 0.f;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        const float lift = ((i % 2u) == 0u) ? 0.f : 1.5f;
+        replay      r(0x7E300000u + i, ask21, 20.f);
+        r.set_lift(lift);
+        for (float speed = 20.f; speed <= 40.f; speed += 4.f)
+        {
+            // After the speed change and the next window
+            r.fly(6000u, speed, 0.f);
+            const uint32_t start = r.get_time();
+            r.fly(20000u, speed, 0.f);
+
+            const sample_stats glide = get_stats(r, start, r.get_time());
+            OV_CHECK(glide.count != 0u);
+            OV_CHECK_NEAR(glide.mean_netto, lift, 0.3f);
+            OV_CHECK(glide.max_netto_error <= 1.2f);
+
+            max_bias  = std::fmax(max_bias, std::fabs(glide.mean_netto - lift));
+            max_error = std::fmax(max_error, glide.max_netto_error);
+        }
+    }
+    test::report_result("max netto bias", max_bias, "m/s");
+    test::report_result("max netto error", max_error, "m/s");
+}
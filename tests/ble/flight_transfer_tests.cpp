@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_transfer.h"
+#include "ov_test.h"
+#include "random_generator.h"
+
+#include <algorithm>
+
+using namespace ov;
+
+/** @brief Size of the transferred file */
+static constexpr uint32_t FILE_SIZE = 10000u;
+
+/** @brief Data size of a packet, MTU of 247 bytes minus the ATT and packet headers */
+static constexpr size_t PACKET_SIZE = 236u;
+
+/** @brief Window used by the tests */
+static constexpr uint8_t WINDOW = 4u;
+
+/** @brief Interval between 2 connection events of the lossy link replay (ms) */
+static constexpr uint32_t CONNECTION_INTERVAL = 15u;
+
+/** @brief Send packets until the window is full, return the number of packets sent */
+static uint32_t fill_window(flight_transfer& transfer, uint32_t now, flight_transfer::packet* packets = nullptr)
+{
+    uint32_t                count = 0u;
+    flight_transfer::packet p;
+    while (transfer.next_packet(PACKET_SIZE, FILE_SIZE, now, p))
+    {
+        if (packets != nullptr)
+        {
+            packets[count] = p;
+        }
+        count++;
+    }
+    return count;
+}
+
+OV_TEST(flight_transfer, complete_transfer)
+{
+    flight_transfer transfer;
+    OV_CHECK(transfer.get_state() == flight_transfer::state::idle);
+    transfer.start(FILE_SIZE, 0u, WINDOW, 1000u);
+    OV_CHECK(transfer.get_state() == flight_transfer::state::transferring);
+
+    // Packets are contiguous and numbered, acknowledging each window opens the next one
+    uint32_t                now      = 1000u;
+    uint32_t                offset   = 0u;
+    uint16_t                sequence = 0u;
+    flight_transfer::packet packets[WINDOW];
+    while (transfer.get_state() == flight_transfer::state::transferring)
+    {
+        const uint32_t count = fill_window(transfer, now, packets);
+        OV_CHECK((count != 0u) && (count <= WINDOW));
+        for (uint32_t i = 0u; i < count; i++)
+        {
+            OV_CHECK_EQ(packets[i].sequence, sequence);
+            OV_CHECK_EQ(packets[i].offset, offset);
+            OV_CHECK((packets[i].size == PACKET_SIZE) || ((packets[i].offset + packets[i].size) == FILE_SIZE));
+            sequence++;
+            offset += static_cast<uint32_t>(packets[i].size);
+        }
+        now += 100u;
+        transfer.acknowledge(offset, false, now);
+    }
+    OV_CHECK(transfer.get_state() == flight_transfer::state::completed);
+    OV_CHECK_EQ(transfer.get_acked_offset(), FILE_SIZE);
+
+    // Nothing is sent again and the throughput is the file size over the duration
+    const flight_transfer::stats stats = transfer.get_stats(now + 5000u);
+    OV_CHECK_EQ(stats.bytes_sent, FILE_SIZE);
+    OV_CHECK_EQ(stats.bytes_retransmitted, 0u);
+    OV_CHECK_EQ(stats.duration, now - 1000u);
+    OV_CHECK_EQ(stats.throughput, (FILE_SIZE * 1000u) / stats.duration);
+    flight_transfer::packet p;
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, FILE_SIZE, now, p));
+}
+
+OV_TEST(flight_transfer, read_ahead_limits_packets)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+
+    // Packets never go past the data read from the file
+    flight_transfer::packet p;
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, 0u, 0u, p));
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, 100u, 0u, p));
+    OV_CHECK_EQ(p.offset, 0u);
+    OV_CHECK_EQ(p.size, 100u);
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, 100u, 0u, p));
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, 1000u, 0u, p));
+    OV_CHECK_EQ(p.offset, 100u);
+    OV_CHECK_EQ(p.size, PACKET_SIZE);
+
+    // Available offset past the end of the file
+    transfer.start(100u, 0u, WINDOW, 0u);
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, p));
+    OV_CHECK_EQ(p.size, 100u);
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, p));
+}
+
+OV_TEST(flight_transfer, rewind_on_timeout)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+
+    // No acknowledgement: the window is sent again from the start after the timeout
+    OV_CHECK_EQ(fill_window(transfer, 100u), WINDOW);
+    OV_CHECK(!transfer.check_timeout(100u + flight_transfer::ACK_TIMEOUT - 1u));
+    OV_CHECK(transfer.check_timeout(100u + flight_transfer::ACK_TIMEOUT));
+    OV_CHECK_EQ(transfer.get_next_offset(), 0u);
+    flight_transfer::packet packets[WINDOW];
+    OV_CHECK_EQ(fill_window(transfer, 1100u, packets), WINDOW);
+    OV_CHECK_EQ(packets[0u].offset, 0u);
+    OV_CHECK_EQ(packets[0u].sequence, WINDOW);
+    OV_CHECK_EQ(transfer.get_stats(1100u).bytes_retransmitted, WINDOW * PACKET_SIZE);
+
+    // An acknowledgement restarts the timeout, the unacknowledged packets are sent again from the acknowledged offset
+    transfer.acknowledge(2u * PACKET_SIZE, false, 1500u);
+    OV_CHECK(!transfer.check_timeout(1500u + flight_transfer::ACK_TIMEOUT - 1u));
+    OV_CHECK(transfer.check_timeout(1500u + flight_transfer::ACK_TIMEOUT));
+    OV_CHECK_EQ(transfer.get_next_offset(), 2u * PACKET_SIZE);
+    OV_CHECK_EQ(fill_window(transfer, 2600u, packets), WINDOW);
+    OV_CHECK_EQ(packets[0u].offset, 2u * PACKET_SIZE);
+
+    // No timeout without packet in flight
+    transfer.acknowledge(6u * PACKET_SIZE, false, 2700u);
+    OV_CHECK(!transfer.check_timeout(2700u + 10u * flight_transfer::ACK_TIMEOUT));
+}
+
+OV_TEST(flight_transfer, rewind_on_retransmit_request)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+
+    // The second packet has been lost : the receiver acknowledges the first one and requests a retransmission
+    OV_CHECK_EQ(fill_window(transfer, 0u), WINDOW);
+    transfer.acknowledge(PACKET_SIZE, true, 50u);
+    OV_CHECK_EQ(transfer.get_acked_offset(), PACKET_SIZE);
+    OV_CHECK_EQ(transfer.get_next_offset(), PACKET_SIZE);
+
+    // A whole window can be sent again from the lost packet
+    flight_transfer::packet packets[WINDOW];
+    OV_CHECK_EQ(fill_window(transfer, 50u, packets), WINDOW);
+    OV_CHECK_EQ(packets[0u].offset, PACKET_SIZE);
+    OV_CHECK_EQ(packets[0u].sequence, WINDOW);
+    OV_CHECK_EQ(packets[WINDOW - 1u].offset, WINDOW * PACKET_SIZE);
+    OV_CHECK_EQ(transfer.get_stats(50u).bytes_retransmitted, (WINDOW - 1u) * PACKET_SIZE);
+
+    // Late acknowledgement of the first transmission past the resent data : the transfer continues after the acknowledged offset
+    transfer.acknowledge(WINDOW * PACKET_SIZE, false, 60u);
+    OV_CHECK_EQ(transfer.get_next_offset(), (WINDOW + 1u) * PACKET_SIZE);
+    transfer.acknowledge((WINDOW + 1u) * PACKET_SIZE, false, 70u);
+    OV_CHECK_EQ(fill_window(transfer, 70u, packets), WINDOW);
+    OV_CHECK_EQ(packets[0u].offset, (WINDOW + 1u) * PACKET_SIZE);
+}
+
+OV_TEST(flight_transfer, partial_acknowledgement_inside_packet)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+    OV_CHECK_EQ(fill_window(transfer, 0u), WINDOW);
+
+    // Half of the second packet has been received : only the first packet leaves the window
+    const uint32_t offset = PACKET_SIZE + PACKET_SIZE / 2u;
+    transfer.acknowledge(offset, false, 10u);
+    OV_CHECK_EQ(transfer.get_acked_offset(), offset);
+    flight_transfer::packet packets[WINDOW];
+    OV_CHECK_EQ(fill_window(transfer, 10u, packets), 1u);
+    OV_CHECK_EQ(packets[0u].offset, WINDOW * PACKET_SIZE);
+
+    // The retransmission starts in the middle of the packet
+    transfer.acknowledge(offset, true, 20u);
+    OV_CHECK_EQ(fill_window(transfer, 20u, packets), WINDOW);
+    OV_CHECK_EQ(packets[0u].offset, offset);
+    OV_CHECK_EQ(packets[0u].size, PACKET_SIZE);
+    OV_CHECK_EQ(packets[1u].offset, offset + PACKET_SIZE);
+
+    // The data past the highest offset sent before is not counted as retransmitted
+    const uint32_t sent_before = (WINDOW + 1u) * PACKET_SIZE;
+    const uint32_t resent_end  = offset + WINDOW * PACKET_SIZE;
+    OV_CHECK_EQ(transfer.get_stats(20u).bytes_retransmitted, sent_before - offset);
+    OV_CHECK_EQ(transfer.get_stats(20u).bytes_sent, resent_end - offset + sent_before);
+
+    // Acknowledgements outside of the sent data are ignored
+    transfer.acknowledge(offset - 1u, false, 30u);
+    OV_CHECK_EQ(transfer.get_acked_offset(), offset);
+    transfer.acknowledge(resent_end + 1u, false, 30u);
+    OV_CHECK_EQ(transfer.get_acked_offset(), offset);
+}
+
+OV_TEST(flight_transfer, resume)
+{
+    flight_transfer         transfer;
+    flight_transfer::packet p;
+
+    // Resume inside the file : the transfer starts at the resume offset and the throughput only counts the transferred data
+    transfer.start(FILE_SIZE, 4000u, WINDOW, 0u);
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, p));
+    OV_CHECK_EQ(p.offset, 4000u);
+    OV_CHECK_EQ(p.sequence, 0u);
+    transfer.acknowledge(4000u + PACKET_SIZE, false, 100u);
+    OV_CHECK_EQ(transfer.get_stats(100u).throughput, PACKET_SIZE * 10u);
+
+    // Resume at the end of the file : nothing to send
+    transfer.start(FILE_SIZE, FILE_SIZE, WINDOW, 200u);
+    OV_CHECK(transfer.get_state() == flight_transfer::state::completed);
+    OV_CHECK_EQ(transfer.get_acked_offset(), FILE_SIZE);
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, FILE_SIZE, 200u, p));
+    OV_CHECK(!transfer.check_timeout(200u + 10u * flight_transfer::ACK_TIMEOUT));
+    const flight_transfer::stats stats = transfer.get_stats(5000u);
+    OV_CHECK_EQ(stats.bytes_sent, 0u);
+    OV_CHECK_EQ(stats.duration, 0u);
+    OV_CHECK_EQ(stats.throughput, 0u);
+
+    // Resume past the end of the file : the file has changed, the transfer starts from the beginning
+    transfer.start(FILE_SIZE, FILE_SIZE + 1u, WINDOW, 300u);
+    OV_CHECK(transfer.get_state() == flight_transfer::state::transferring);
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 300u, p));
+    OV_CHECK_EQ(p.offset, 0u);
+
+    // Empty file
+    transfer.start(0u, 0u, WINDOW, 400u);
+    OV_CHECK(transfer.get_state() == flight_transfer::state::completed);
+}
+
+OV_TEST(flight_transfer, cancel_packet)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+
+    // The packet could not be queued : it is returned again by the next call
+    flight_transfer::packet first;
+    flight_transfer::packet second;
+    flight_transfer::packet again;
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, first));
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, second));
+    transfer.cancel_packet(second);
+    OV_CHECK_EQ(transfer.get_next_offset(), second.offset);
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, again));
+    OV_CHECK_EQ(again.sequence, second.sequence);
+    OV_CHECK_EQ(again.offset, second.offset);
+    OV_CHECK_EQ(again.size, second.size);
+    flight_transfer::stats stats = transfer.get_stats(0u);
+    OV_CHECK_EQ(stats.bytes_sent, 2u * PACKET_SIZE);
+    OV_CHECK_EQ(stats.bytes_retransmitted, 0u);
+
+    // Only the last packet can be cancelled
+    transfer.cancel_packet(first);
+    OV_CHECK_EQ(transfer.get_next_offset(), 2u * PACKET_SIZE);
+
+    // The cancelled packet does not use a place in the window
+    flight_transfer::packet packets[WINDOW];
+    OV_CHECK_EQ(fill_window(transfer, 0u, packets), WINDOW - 2u);
+    transfer.cancel_packet(packets[WINDOW - 3u]);
+    OV_CHECK_EQ(transfer.get_next_offset(), (WINDOW - 1u) * PACKET_SIZE);
+    OV_CHECK_EQ(transfer.get_stats(0u).bytes_sent, (WINDOW - 1u) * PACKET_SIZE);
+
+    // Cancelled retransmission
+    OV_CHECK(transfer.check_timeout(flight_transfer::ACK_TIMEOUT));
+    OV_CHECK(transfer.next_packet(PACKET_SIZE, FILE_SIZE, flight_transfer::ACK_TIMEOUT, again));
+    OV_CHECK_EQ(again.offset, 0u);
+    OV_CHECK_EQ(transfer.get_stats(0u).bytes_retransmitted, PACKET_SIZE);
+    transfer.cancel_packet(again);
+    stats = transfer.get_stats(0u);
+    OV_CHECK_EQ(stats.bytes_retransmitted, 0u);
+    OV_CHECK_EQ(stats.bytes_sent, (WINDOW - 1u) * PACKET_SIZE);
+    OV_CHECK_EQ(transfer.get_next_offset(), 0u);
+
+    // Once sent again, only the data below the highest offset sent is retransmitted
+    OV_CHECK_EQ(fill_window(transfer, flight_transfer::ACK_TIMEOUT), WINDOW);
+    stats = transfer.get_stats(0u);
+    OV_CHECK_EQ(stats.bytes_retransmitted, (WINDOW - 1u) * PACKET_SIZE);
+    OV_CHECK_EQ(stats.bytes_sent - stats.bytes_retransmitted, WINDOW * PACKET_SIZE);
+}
+
+OV_TEST(flight_transfer, abort)
+{
+    flight_transfer transfer;
+    transfer.start(FILE_SIZE, 0u, WINDOW, 0u);
+    OV_CHECK_EQ(fill_window(transfer, 0u), WINDOW);
+    transfer.abort();
+    OV_CHECK(transfer.get_state() == flight_transfer::state::aborted);
+
+    // Nothing is sent nor acknowledged anymore
+    flight_transfer::packet p;
+    OV_CHECK(!transfer.next_packet(PACKET_SIZE, FILE_SIZE, 0u, p));
+    OV_CHECK(!transfer.check_timeout(10u * flight_transfer::ACK_TIMEOUT));
+    transfer.acknowledge(PACKET_SIZE, false, 10u);
+    OV_CHECK_EQ(transfer.get_acked_offset(), 0u);
+}
+
+OV_TEST(flight_transfer, lossy_link)
+{
+    // Go-back-N receiver over a link which loses packets and acknowledgements, the receiver
+    // acknowledges every 2 packets and requests a retransmission when it detects a gap
+    static constexpr float LOSS_RATES[] = {0.f, 0.01f, 0.05f, 0.2f};
+    for (const float loss_rate : LOSS_RATES)
+    {
+        test::random_generator random(0x10550u);
+        flight_transfer        transfer;
+        transfer.start(FILE_SIZE, 0u, 8u, 0u);
+
+        uint32_t now            = 0u;
+        uint32_t received       = 0u;
+        uint32_t packet_count   = 0u;
+        bool     gap_signaled   = false;
+        uint16_t expected_seq   = 0u;
+        bool     sequence_valid = true;
+        while ((transfer.get_state() == flight_transfer::state::transferring) && (now < 600000u))
+        {
+            // Up to 4 packets per connection event
+            flight_transfer::packet p;
+            transfer.check_timeout(now);
+            for (uint32_t i = 0u; (i < 4u) && transfer.next_packet(PACKET_SIZE, FILE_SIZE, now, p); i++)
+            {
+                sequence_valid = sequence_valid && (p.sequence == expected_seq);
+                expected_seq++;
+                if (!random.chance(loss_rate))
+                {
+                    if (p.offset <= received)
+                    {
+                        // Data already received is skipped
+                        received     = std::max(received, p.offset + static_cast<uint32_t>(p.size));
+                        gap_signaled = false;
+                        packet_count++;
+                        if (((packet_count % 2u) == 0u) || (received == FILE_SIZE))
+                        {
+                            if (!random.chance(loss_rate))
+                            {
+                                transfer.acknowledge(received, false, now);
+                            }
+                        }
+                    }
+                    else if (!gap_signaled)
+                    {
+                        // Gap : retransmission requested once
+                        gap_signaled = true;
+                        if (!random.chance(loss_rate))
+                        {
+                            transfer.acknowledge(received, true, now);
+                        }
+                    }
+                }
+            }
+            now += CONNECTION_INTERVAL;
+        }
+        OV_CHECK(transfer.get_state() == flight_transfer::state::completed);
+        OV_CHECK_EQ(received, FILE_SIZE);
+        OV_CHECK(sequence_valid);
+
+        const flight_transfer::stats stats = transfer.get_stats(now);
+        OV_CHECK_EQ(stats.bytes_sent - stats.bytes_retransmitted, FILE_SIZE);
+        if (loss_rate == 0.f)
+        {
+            OV_CHECK_EQ(stats.bytes_retransmitted, 0u);
+            test::report_result("throughput without loss", stats.throughput, "bytes/s");
+        }
+        if (loss_rate == 0.05f)
+        {
+            test::report_result("throughput with 5% loss", stats.throughput, "bytes/s");
+            test::report_result("retransmitted with 5% loss", (100. * stats.bytes_retransmitted) / stats.bytes_sent, "%");
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "host_fs.h"
+#include "fs.h"
+#include "ram_storage_memory.h"
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Storage memory of the filesystem */
+static ram_storage_memory<HOST_FS_SIZE, HOST_FS_BLOCK_SIZE> s_storage;
+
+/** @brief Get an empty filesystem stored in RAM, mounted on first use and formatted on each call */
+bool format_host_fs()
+{
+    static bool is_mounted = false;
+
+    bool reinit = false;
+    bool ret    = (is_mounted || fs::init(reinit, s_storage));
+    is_mounted  = ret;
+    ret         = ret && fs::format();
+    return ret;
+}
+
+/** @brief Get the number of bytes read from the storage memory of the host filesystem since its creation */
+size_t get_host_fs_read_bytes()
+{
+    return s_storage.get_read_bytes();
+}
+
+} // namespace test
+} // namespace ov
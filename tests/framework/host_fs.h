@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_HOST_FS_H
+#define OV_HOST_FS_H
+
+#include <cstddef>
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Size of the storage memory of the host filesystem, same as the board's NOR flash */
+static constexpr size_t HOST_FS_SIZE = 16u * 1024u * 1024u;
+
+/** @brief Size of an erase block of the host filesystem, same as the board's NOR flash */
+static constexpr size_t HOST_FS_BLOCK_SIZE = 64u * 1024u;
+
+/** @brief Get an empty filesystem stored in RAM, mounted on first use and formatted on each call */
+bool format_host_fs();
+
+/** @brief Get the number of bytes read from the storage memory of the host filesystem since its creation */
+size_t get_host_fs_read_bytes();
+
+} // namespace test
+} // namespace ov
+
+#endif // OV_HOST_FS_H
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "ov_test.h"
+
+#include <cstring>
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Registered tests */
+static test_case* s_tests = nullptr;
+
+/** @brief Last registered test */
+static test_case* s_last_test = nullptr;
+
+/** @brief Running test */
+static const test_case* s_current_test = nullptr;
+
+/** @brief Number of failed checks in the running test */
+static uint32_t s_failures = 0;
+
+/** @brief Register a test case, test cases are static objects which must live until the end of the program */
+void register_test(test_case& test)
+{
+    // Keep the definition order so that the output is stable
+    test.next = nullptr;
+    if (s_last_test)
+    {
+        s_last_test->next = &test;
+    }
+    else
+    {
+        s_tests = &test;
+    }
+    s_last_test = &test;
+}
+
+/** @brief Report a failed check of the running test */
+void report_failure(const char* file, int line, const char* expression)
+{
+    printf("  %s:%d: check failed: %s\n", file, line, expression);
+    s_failures++;
+}
+
+/** @brief Report a benchmark or measurement result of the running test */
+void report_result(const char* name, double value, const char* unit)
+{
+    printf("  [%s.%s] %s : %.3f %s\n", s_current_test->suite, s_current_test->name, name, value, unit);
+}
+
+} // namespace test
+} // namespace ov
+
+/** @brief Entry point : openvario_host_tests [--bench] [suite] */
+int main(int argc, char* argv[])
+{
+    bool        benchmarks = false;
+    const char* suite      = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--bench") == 0)
+        {
+            benchmarks = true;
+        }
+        else
+        {
+            suite = argv[i];
+        }
+    }
+
+    // Run the selected tests
+    uint32_t tests_count  = 0;
+    uint32_t failed_count = 0;
+    for (ov::test::test_case* test = ov::test::s_tests; test != nullptr; test = test->next)
+    {
+        if ((test->is_benchmark == benchmarks) && ((suite == nullptr) || (strcmp(suite, test->suite) == 0)))
+        {
+            printf("[ RUN  ] %s.%s\n", test->suite, test->name);
+            ov::test::s_current_test = test;
+            ov::test::s_failures     = 0;
+            test->func();
+            if (ov::test::s_failures == 0)
+            {
+                printf("[  OK  ] %s.%s\n", test->suite, test->name);
+            }
+            else
+            {
+                printf("[ FAIL ] %s.%s\n", test->suite, test->name);
+                failed_count++;
+            }
+            tests_count++;
+        }
+    }
+
+    printf("%u test(s) run, %u failed\n", tests_count, failed_count);
+
+    // A filter matching nothing is an error in the test registration
+    int ret = 0;
+    if ((tests_count == 0) || (failed_count != 0))
+    {
+        ret = 1;
+    }
+    return ret;
+}
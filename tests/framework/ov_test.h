@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_TEST_H
+#define OV_TEST_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Test or benchmark function */
+using test_func = void (*)();
+
+/** @brief Registered test or benchmark */
+struct test_case
+{
+    /** @brief Suite name */
+    const char* suite;
+    /** @brief Test name */
+    const char* name;
+    /** @brief Test function */
+    test_func func;
+    /** @brief Indicate if the test is a benchmark */
+    bool is_benchmark;
+    /** @brief Next registered test */
+    test_case* next;
+};
+
+/** @brief Register a test case, test cases are static objects which must live until the end of the program */
+void register_test(test_case& test);
+
+/** @brief Report a failed check of the running test */
+void report_failure(const char* file, int line, const char* expression);
+
+/** @brief Report a benchmark or measurement result of the running test */
+void report_result(const char* name, double value, const char* unit);
+
+/** @brief Helper to register a test case at static initialization time */
+class test_registrar
+{
+  public:
+    /** @brief Constructor */
+    test_registrar(test_case& test) { register_test(test); }
+};
+
+/** @brief Prevent the compiler from optimizing out the computation of a value in a benchmark loop */
+template <typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/** @brief Measure the elapsed time of a benchmark loop */
+class stopwatch
+{
+  public:
+    /** @brief Constructor, starts the measurement */
+    stopwatch() : m_start(std::chrono::steady_clock::now()) { }
+
+    /** @brief Restart the measurement */
+    void restart() { m_start = std::chrono::steady_clock::now(); }
+
+    /** @brief Get the elapsed time since the start in nanoseconds */
+    double elapsed_ns() const
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+  private:
+    /** @brief Start of the measurement */
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace test
+} // namespace ov
+
+/** @brief Define a test case */
+#define OV_TEST(suite_name, test_name) OV_TEST_DEFINE(suite_name, test_name, false)
+
+/** @brief Define a benchmark, benchmarks only run when requested on the command line */
+#define OV_BENCHMARK(suite_name, test_name) OV_TEST_DEFINE(suite_name, test_name, true)
+
+/** @brief Common part of the test and benchmark definitions */
+#define OV_TEST_DEFINE(suite_name, test_name, is_bench)                                                    \
+    static void                     suite_name##_##test_name();                                            \
+    static ov::test::test_case      suite_name##_##test_name##_case = {                                    \
+        #suite_name, #test_name, &suite_name##_##test_name, is_bench, nullptr};                            \
+    static ov::test::test_registrar suite_name##_##test_name##_registrar(suite_name##_##test_name##_case); \
+    static void                     suite_name##_##test_name()
+
+/** @brief Check that a condition is true */
+#define OV_CHECK(cond)                                           \
+    do                                                           \
+    {                                                            \
+        if (!(cond))                                             \
+        {                                                        \
+            ov::test::report_failure(__FILE__, __LINE__, #cond); \
+        }                                                        \
+    } while (false)
+
+/** @brief Check that 2 values are equal */
+#define OV_CHECK_EQ(a, b) OV_CHECK((a) == (b))
+
+/** @brief Check that 2 values are equal within a tolerance */
+#define OV_CHECK_NEAR(a, b, tolerance) \
+    OV_CHECK(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= static_cast<double>(tolerance))
+
+#endif // OV_TEST_H
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_RANDOM_GENERATOR_H
+#define OV_RANDOM_GENERATOR_H
+
+#include <cmath>
+#include <cstdint>
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Deterministic pseudo random generator (xorshift32) so that the generated data is the same on every run */
+class random_generator
+{
+  public:
+    /** @brief Constructor */
+    random_generator(uint32_t seed) : m_state(seed) { }
+
+    /** @brief Get a value in [min, max] */
+    float uniform(float min, float max) { return min + (max - min) * static_cast<float>(next() >> 8u) / static_cast<float>(1u << 24u); }
+
+    /** @brief Get an integer in [min, max] */
+    uint32_t uniform(uint32_t min, uint32_t max) { return min + next() % (max - min + 1u); }
+
+    /** @brief Get a value of a normal distribution (Box-Muller transform) */
+    float gaussian(float mean, float sigma)
+    {
+        const float u1 = uniform(1e-7f, 1.f);
+        const float u2 = uniform(0.f, 1.f);
+        return mean + sigma * std::sqrt(-2.f * std::log(u1)) * std::cos(6.2831853f * u2);
+    }
+
+    /** @brief Get true with the specified probability */
+    bool chance(float probability) { return (uniform(0.f, 1.f) < probability); }
+
+  private:
+    /** @brief State */
+    uint32_t m_state;
+
+    /** @brief Next value */
+    uint32_t next()
+    {
+        m_state ^= m_state << 13u;
+        m_state ^= m_state >> 17u;
+        m_state ^= m_state << 5u;
+        return m_state;
+    }
+};
+
+} // namespace test
+} // namespace ov
+
+#endif // OV_RANDOM_GENERATOR_H
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "dead_reckoning.h"
+#include "ov_test.h"
+#include "random_generator.h"
+
+#include <cmath>
+
+using namespace ov;
+
+/** @brief Period of the inertial samples in milliseconds */
+static constexpr uint32_t PERIOD_MS = 20u;
+
+/** @brief Number of inertial samples between 2 GNSS fixes */
+static constexpr uint32_t SAMPLES_PER_FIX = 50u;
+
+/** @brief Duration of the simulated flight in milliseconds */
+static constexpr uint32_t FLIGHT_MS = 120000u;
+
+/** @brief Time after which the errors are measured, the gyroscope bias has converged (ms) */
+static constexpr uint32_t SETTLING_MS = 5000u;
+
+/** @brief Latitude of the simulated flight (°) */
+static constexpr double LATITUDE = 45.;
+
+/** @brief Longitude of the simulated flight (°) */
+static constexpr double LONGITUDE = 6.;
+
+/** @brief Earth radius used to build the fixes (m) */
+static constexpr double EARTH_RADIUS = static_cast<double>(geo::EARTH_RADIUS);
+
+/** @brief Imperfections of the simulated sensors and mounting of the device */
+struct simulation_config
+{
+    /** @brief Roll angle of the device around its X axis (rad) */
+    float tilt;
+    /** @brief Gyroscope bias around the vertical axis (°/s) */
+    float gyro_bias;
+    /** @brief Standard deviation of the GNSS horizontal position (m) */
+    float gnss_sigma;
+};
+
+/** @brief Mean position errors of a simulated flight */
+struct simulation_result
+{
+    /** @brief Mean error of the dead reckoning estimate (m) */
+    double dead_reckoning_error;
+    /** @brief Mean error when holding the last fix (m) */
+    double hold_error;
+    /** @brief Maximum track angle error after the settling time (°) */
+    double max_track_error;
+};
+
+/**
+ * @brief Simulated paraglider flight : straight glide, 60s of thermalling at 20°/s, then a 5s deceleration
+ *        and a 5s acceleration back to trim speed. The device measures the turn rate in its own frame,
+ *        with a bias, and the GNSS fixes are noisy and arrive once per second
+ */
+class flight_simulation
+{
+  public:
+    /** @brief Constructor */
+    explicit flight_simulation(const simulation_config& config)
+        : m_config(config), m_random(1u), m_time(0u), m_east(0.), m_north(0.), m_speed(10.), m_heading(0.3)
+    {
+    }
+
+    /** @brief Run the flight through a dead reckoning filter */
+    simulation_result run(dead_reckoning& filter)
+    {
+        simulation_result ret       = {};
+        double            fix_east  = 0.;
+        double            fix_north = 0.;
+        uint32_t          count     = 0u;
+        for (uint32_t i = 0u; i < (FLIGHT_MS / PERIOD_MS); i++)
+        {
+            // Trajectory
+            const double dt    = PERIOD_MS / 1000.;
+            const double t     = m_time / 1000.;
+            const double rate  = ((t > 20.) && (t < 80.)) ? 0.35 : 0.;
+            double       accel = 0.;
+            if ((t > 90.) && (t < 95.))
+            {
+                accel = -1.;
+            }
+            else if ((t > 95.) && (t < 100.))
+            {
+                accel = 1.;
+            }
+            m_speed += accel * dt;
+            m_heading += rate * dt;
+            m_east += m_speed * std::sin(m_heading) * dt;
+            m_north += m_speed * std::cos(m_heading) * dt;
+            m_time += PERIOD_MS;
+
+            // Inertial sensors
+            filter.propagate(get_accel(), get_gyro(rate), PERIOD_MS);
+
+            // GNSS fix
+            if ((i % SAMPLES_PER_FIX) == 0u)
+            {
+                fix_east  = m_east + m_random.gaussian(0.f, m_config.gnss_sigma);
+                fix_north = m_north + m_random.gaussian(0.f, m_config.gnss_sigma);
+                filter.correct(get_fix(fix_east, fix_north));
+            }
+
+            // Errors
+            const position_estimate estimate = filter.get_estimate();
+            OV_CHECK(estimate.is_valid);
+            if (m_time > SETTLING_MS)
+            {
+                double east  = 0.;
+                double north = 0.;
+                to_local(estimate.position, east, north);
+                ret.dead_reckoning_error += std::hypot(east - m_east, north - m_north);
+                ret.hold_error += std::hypot(fix_east - m_east, fix_north - m_north);
+                count++;
+
+                double track_error  = std::fmod(std::fabs(estimate.track_angle / 10. - m_heading / geo::DEG_TO_RAD), 360.);
+                track_error         = std::fmin(track_error, 360. - track_error);
+                ret.max_track_error = std::fmax(ret.max_track_error, track_error);
+            }
+        }
+        ret.dead_reckoning_error /= count;
+        ret.hold_error /= count;
+        return ret;
+    }
+
+  private:
+    /** @brief Sensor imperfections */
+    simulation_config m_config;
+    /** @brief Noise generator */
+    test::random_generator m_random;
+    /** @brief Elapsed time in milliseconds */
+    uint32_t m_time;
+    /** @brief Position east of the start (m) */
+    double m_east;
+    /** @brief Position north of the start (m) */
+    double m_north;
+    /** @brief Ground speed (m/s) */
+    double m_speed;
+    /** @brief Heading, clockwise from north (rad) */
+    double m_heading;
+
+    /** @brief Accelerometer sample, the vertical is in the Y-Z plane of the tilted device */
+    i_accelerometer_sensor::data get_accel()
+    {
+        i_accelerometer_sensor::data ret = {};
+        ret.x_accel                      = static_cast<int16_t>(m_random.gaussian(0.f, 20.f));
+        ret.y_accel                      = static_cast<int16_t>(m_random.gaussian(1000.f * std::sin(m_config.tilt), 20.f));
+        ret.z_accel                      = static_cast<int16_t>(m_random.gaussian(1000.f * std::cos(m_config.tilt), 20.f));
+        ret.is_valid                     = true;
+        return ret;
+    }
+
+    /** @brief Gyroscope sample for a clockwise turn rate (rad/s), a clockwise turn is a negative rotation around the vertical */
+    i_gyroscope_sensor::data get_gyro(double rate)
+    {
+        const float vertical_rate    = static_cast<float>(-rate / geo::DEG_TO_RAD) + m_config.gyro_bias;
+        i_gyroscope_sensor::data ret = {};
+        ret.x_rate                   = static_cast<int16_t>(m_random.gaussian(0.f, 50.f));
+        ret.y_rate                   = static_cast<int16_t>(m_random.gaussian(100.f * vertical_rate * std::sin(m_config.tilt), 50.f));
+        ret.z_rate                   = static_cast<int16_t>(m_random.gaussian(100.f * vertical_rate * std::cos(m_config.tilt), 50.f));
+        ret.is_valid                 = true;
+        return ret;
+    }
+
+    /** @brief GNSS fix at a position of the local frame */
+    i_gnss::data get_fix(double east, double north) const
+    {
+        const double track  = std::fmod(m_heading / geo::DEG_TO_RAD, 360.);
+        i_gnss::data ret    = {};
+        ret.latitude        = LATITUDE + north / EARTH_RADIUS / geo::DEG_TO_RAD;
+        ret.longitude       = LONGITUDE + east / (EARTH_RADIUS * std::cos(LATITUDE * geo::DEG_TO_RAD)) / geo::DEG_TO_RAD;
+        ret.speed           = static_cast<uint32_t>(std::lround(m_speed * 10.));
+        ret.track_angle     = static_cast<uint16_t>(std::lround(track * 10.) % 3600);
+        ret.satellite_count = 10u;
+        ret.is_valid        = true;
+        return ret;
+    }
+
+    /** @brief Convert a position to the local frame */
+    static void to_local(const geo::position& position, double& east, double& north)
+    {
+        east  = (position.longitude_deg() - LONGITUDE) * geo::DEG_TO_RAD * EARTH_RADIUS * std::cos(LATITUDE * geo::DEG_TO_RAD);
+        north = (position.latitude_deg() - LATITUDE) * geo::DEG_TO_RAD * EARTH_RADIUS;
+    }
+};
+
+OV_TEST(dead_reckoning, replay_beats_holding_last_fix)
+{
+    dead_reckoning          filter;
+    flight_simulation       simulation({0.5f, 1.5f, 1.5f});
+    const simulation_result result = simulation.run(filter);
+
+    // The estimate follows the glider between the fixes instead of jumping once per second
+    OV_CHECK(result.dead_reckoning_error < (result.hold_error / 2.));
+    OV_CHECK(result.dead_reckoning_error < 2.5);
+    OV_CHECK(result.max_track_error < 10.);
+    test::report_result("mean error with dead reckoning", result.dead_reckoning_error, "m");
+    test::report_result("mean error holding the last fix", result.hold_error, "m");
+    test::report_result("max track error", result.max_track_error, "deg");
+}
+
+OV_TEST(dead_reckoning, independent_of_mounting)
+{
+    // Flat, tilted and vertical devices
+    static constexpr float TILTS[] = {0.f, 0.5f, 1.5707963f};
+    double                 errors[3u];
+    for (size_t i = 0u; i < 3u; i++)
+    {
+        dead_reckoning    filter;
+        flight_simulation simulation({TILTS[i], 1.5f, 1.5f});
+        errors[i] = simulation.run(filter).dead_reckoning_error;
+    }
+    OV_CHECK_NEAR(errors[1u], errors[0u], 0.2);
+    OV_CHECK_NEAR(errors[2u], errors[0u], 0.2);
+}
+
+OV_TEST(dead_reckoning, gyroscope_bias_compensated)
+{
+    // Without GNSS noise the remaining error comes from the sensors, an uncompensated 3°/s bias gives a 0.65m mean error
+    dead_reckoning    unbiased_filter;
+    dead_reckoning    biased_filter;
+    flight_simulation unbiased({0.5f, 0.f, 0.f});
+    flight_simulation biased({0.5f, 3.f, 0.f});
+
+    const simulation_result unbiased_result = unbiased.run(unbiased_filter);
+    const simulation_result biased_result   = biased.run(biased_filter);
+    OV_CHECK(unbiased_result.dead_reckoning_error < 0.1);
+    OV_CHECK(biased_result.dead_reckoning_error < 0.2);
+    test::report_result("mean error without bias", unbiased_result.dead_reckoning_error, "m");
+    test::report_result("mean error with a 3deg/s bias", biased_result.dead_reckoning_error, "m");
+}
+
+OV_TEST(dead_reckoning, invalid_without_fix)
+{
+    const i_accelerometer_sensor::data accel = {0, 0, 1000, 1000, true};
+    const i_gyroscope_sensor::data     gyro  = {0, 0, 0, true};
+
+    // No estimate before the first fix
+    dead_reckoning filter;
+    filter.propagate(accel, gyro, PERIOD_MS);
+    OV_CHECK(!filter.get_estimate().is_valid);
+
+    // The estimate starts on the fix and moves along its track
+    i_gnss::data fix = {};
+    fix.latitude     = LATITUDE;
+    fix.longitude    = LONGITUDE;
+    fix.speed        = 100u;
+    fix.track_angle  = 0u;
+    fix.is_valid     = true;
+    filter.correct(fix);
+    position_estimate estimate = filter.get_estimate();
+    OV_CHECK(estimate.is_valid);
+    OV_CHECK_EQ(estimate.position.latitude, fix.get_position().latitude);
+    OV_CHECK_EQ(estimate.position.longitude, fix.get_position().longitude);
+    OV_CHECK_EQ(estimate.speed, 100u);
+    filter.propagate(accel, gyro, 1000u);
+    estimate = filter.get_estimate();
+    OV_CHECK_NEAR(geo::distance(fix.get_position(), estimate.position), 10.f, 0.1f);
+    OV_CHECK_EQ(estimate.position.longitude, fix.get_position().longitude);
+    OV_CHECK_EQ(estimate.fix_age, 1000u);
+
+    // Invalid fixes are ignored, the estimate expires without fix
+    fix.is_valid = false;
+    filter.correct(fix);
+    for (uint32_t age = 1000u; age < dead_reckoning::MAX_PROPAGATION_MS; age += PERIOD_MS)
+    {
+        filter.propagate(accel, gyro, PERIOD_MS);
+    }
+    OV_CHECK(filter.get_estimate().is_valid);
+    filter.propagate(accel, gyro, PERIOD_MS);
+    OV_CHECK(!filter.get_estimate().is_valid);
+
+    // The next fix restarts the estimation on it
+    fix.latitude = LATITUDE + 0.01;
+    fix.is_valid = true;
+    filter.correct(fix);
+    estimate = filter.get_estimate();
+    OV_CHECK(estimate.is_valid);
+    OV_CHECK_EQ(estimate.position.latitude, fix.get_position().latitude);
+    OV_CHECK_EQ(estimate.fix_age, 0u);
+
+    // Reset
+    filter.reset();
+    OV_CHECK(!filter.get_estimate().is_valid);
+}
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "dashboard2_screen.h"
+#include "i_display.h"
+#include "i_hmi_manager.h"
+#include "ov_data.h"
+#include "ov_test.h"
+#include "random_generator.h"
+
+#include <cstring>
+
+using namespace ov;
+
+/** @brief Display width in pixels */
+static constexpr uint16_t DISPLAY_WIDTH = 128u;
+
+/** @brief Display height in pixels */
+static constexpr uint16_t DISPLAY_HEIGHT = 64u;
+
+/** @brief Number of pages of the display */
+static constexpr uint32_t PAGE_COUNT = DISPLAY_HEIGHT / i_display::PAGE_HEIGHT;
+
+/** @brief Mask of all the pages of the display */
+static constexpr uint32_t ALL_PAGES = (1u << PAGE_COUNT) - 1u;
+
+/** @brief Pages covered by the sink rate label of the dashboard (rows 5 to 20) */
+static constexpr uint32_t SINK_RATE_PAGES = 0x07u;
+
+/** @brief Pages covered by the speed label of the dashboard (rows 37 to 52) */
+static constexpr uint32_t SPEED_PAGES = 0x70u;
+
+/** @brief Number of refreshes of the replay */
+static constexpr uint32_t REFRESH_COUNT = 300u;
+
+/** @brief HMI manager which ignores the requests of the screens */
+class hmi_manager_stub : public i_hmi_manager
+{
+  public:
+    /** @brief Set the next screen */
+    void set_next_screen(hmi_screen) override { }
+
+    /** @brief Turn the display ON/OFF */
+    void set_display(bool) override { }
+};
+
+/** @brief Screen with 2 overlapping labels whose texts change of length */
+class overlap_screen : public base_screen
+{
+  public:
+    /** @brief Constructor */
+    overlap_screen(i_hmi_manager& hmi_manager)
+        : base_screen(hmi_screen::dashboard1, hmi_manager), m_top_label(), m_bottom_label(), m_top_string{}, m_bottom_string{}
+    {
+    }
+
+    /** @brief Set the texts of the labels */
+    void set_texts(const char* top, const char* bottom)
+    {
+        strncpy(m_top_string, top, sizeof(m_top_string) - 1u);
+        strncpy(m_bottom_string, bottom, sizeof(m_bottom_string) - 1u);
+    }
+
+  private:
+    /** @brief Top label */
+    YACSWL_label_t m_top_label;
+    /** @brief Bottom label, its first row is the last row of the top label */
+    YACSWL_label_t m_bottom_label;
+    /** @brief Top label string */
+    char m_top_string[16u];
+    /** @brief Bottom label string */
+    char m_bottom_string[16u];
+
+    /** @brief Initialize the screen */
+    void on_init(YACSGL_frame_t&) override
+    {
+        YACSWL_label_init(&m_top_label);
+        track_label(m_top_label, m_top_string);
+        YACSWL_widget_set_border_width(&m_top_label.widget, 0u);
+        YACSWL_widget_set_pos(&m_top_label.widget, 5u, 5u);
+
+        YACSWL_label_init(&m_bottom_label);
+        track_label(m_bottom_label, m_bottom_string);
+        YACSWL_widget_set_border_width(&m_bottom_label.widget, 0u);
+        YACSWL_widget_set_pos(
+            &m_bottom_label.widget, 20u, YACSWL_widget_get_pos_y(&m_top_label.widget) + YACSWL_widget_get_height(&m_top_label.widget));
+
+        YACSWL_widget_add_child(&m_root_widget, &m_top_label.widget);
+        YACSWL_widget_add_child(&m_root_widget, &m_bottom_label.widget);
+    }
+};
+
+/** @brief Screen rendered in its own frame buffer */
+template <typename SCREEN>
+class rendered_screen
+{
+  public:
+    /** @brief Constructor */
+    rendered_screen()
+        : m_hmi(),
+          m_screen(m_hmi),
+          m_buffer{},
+          m_frame{DISPLAY_WIDTH, DISPLAY_HEIGHT, 0u, 0u, m_buffer},
+          m_pixel_writes(0u)
+    {
+        m_screen.init(m_frame);
+    }
+
+    /** @brief Refresh the screen as the HMI manager does and get the mask of the modified pages */
+    uint32_t refresh(bool night_mode = false)
+    {
+        test::yacsgl_pixel_writes() = 0u;
+        m_screen.set_night_mode(night_mode);
+        const uint32_t pages = m_screen.refresh(m_frame);
+        m_pixel_writes       = test::yacsgl_pixel_writes();
+        return pages;
+    }
+
+    /** @brief Refresh the whole screen */
+    uint32_t redraw(bool night_mode = false)
+    {
+        m_screen.invalidate();
+        return refresh(night_mode);
+    }
+
+    /** @brief Get the number of pixels written by the last refresh */
+    uint32_t get_pixel_writes() const { return m_pixel_writes; }
+
+    /** @brief Get the frame buffer */
+    const uint8_t* get_buffer() const { return m_buffer; }
+
+    /** @brief Get the screen */
+    SCREEN& get_screen() { return m_screen; }
+
+  private:
+    /** @brief HMI manager */
+    hmi_manager_stub m_hmi;
+    /** @brief Screen */
+    SCREEN m_screen;
+    /** @brief Frame buffer */
+    uint8_t m_buffer[DISPLAY_WIDTH * PAGE_COUNT];
+    /** @brief Frame */
+    YACSGL_frame_t m_frame;
+    /** @brief Number of pixels written by the last refresh */
+    uint32_t m_pixel_writes;
+};
+
+/** @brief Size of a frame buffer */
+static constexpr size_t BUFFER_SIZE = DISPLAY_WIDTH * PAGE_COUNT;
+
+/** @brief Get the mask of the pages which differ between 2 frame buffers */
+static uint32_t get_changed_pages(const uint8_t* before, const uint8_t* after)
+{
+    uint32_t pages = 0u;
+    for (size_t i = 0u; i < BUFFER_SIZE; i++)
+    {
+        if (before[i] != after[i])
+        {
+            pages |= (1u << (i / DISPLAY_WIDTH));
+        }
+    }
+    return pages;
+}
+
+/** @brief Count the number of pages of a mask */
+static uint32_t count_pages(uint32_t pages)
+{
+    uint32_t count = 0u;
+    while (pages != 0u)
+    {
+        count += (pages & 1u);
+        pages >>= 1u;
+    }
+    return count;
+}
+
+/** @brief Set the data displayed by the dashboard */
+static void set_data(int16_t sink_rate, uint16_t glide_ratio, uint32_t speed, int16_t te_sink_rate, int16_t netto_sink_rate)
+{
+    i_barometric_altimeter::data altimeter = {};
+    altimeter.is_valid                     = true;
+    ov::data::set_altimeter(altimeter);
+    i_gnss::data gnss = {};
+    gnss.speed        = speed;
+    gnss.is_valid     = true;
+    ov::data::set_gnss(gnss);
+    ov::data::set_sink_rate(sink_rate);
+    ov::data::set_glide_ratio(glide_ratio);
+    ov::data::set_te_sink_rates(te_sink_rate, netto_sink_rate);
+}
+
+OV_TEST(base_screen, unchanged_text_is_not_redrawn)
+{
+    set_data(12, 85u, 100u, 10, 5);
+    rendered_screen<dashboard2_screen> screen;
+
+    // First refresh draws the whole screen
+    OV_CHECK_EQ(screen.refresh(), ALL_PAGES);
+    OV_CHECK(screen.get_pixel_writes() >= (DISPLAY_WIDTH * DISPLAY_HEIGHT));
+
+    // Nothing is drawn as long as the texts do not change
+    uint8_t before[BUFFER_SIZE];
+    memcpy(before, screen.get_buffer(), BUFFER_SIZE);
+    for (uint32_t i = 0u; i < 10u; i++)
+    {
+        OV_CHECK_EQ(screen.refresh(), 0u);
+        OV_CHECK_EQ(screen.get_pixel_writes(), 0u);
+    }
+    OV_CHECK_EQ(memcmp(before, screen.get_buffer(), BUFFER_SIZE), 0);
+}
+
+OV_TEST(base_screen, only_changed_labels_are_redrawn)
+{
+    set_data(12, 85u, 100u, 10, 5);
+    rendered_screen<dashboard2_screen> screen;
+    rendered_screen<dashboard2_screen> reference;
+    screen.refresh();
+    reference.refresh();
+    const uint32_t full_pixel_writes = reference.get_pixel_writes();
+
+    // Sink rate only
+    uint8_t before[BUFFER_SIZE];
+    memcpy(before, screen.get_buffer(), BUFFER_SIZE);
+    set_data(-8, 85u, 100u, 10, 5);
+    OV_CHECK_EQ(screen.refresh(), SINK_RATE_PAGES);
+    OV_CHECK((get_changed_pages(before, screen.get_buffer()) & ~SINK_RATE_PAGES) == 0u);
+    OV_CHECK(screen.get_pixel_writes() < (full_pixel_writes / 4u));
+    reference.redraw();
+    OV_CHECK_EQ(memcmp(screen.get_buffer(), reference.get_buffer(), BUFFER_SIZE), 0);
+
+    // Speed only
+    memcpy(before, screen.get_buffer(), BUFFER_SIZE);
+    set_data(-8, 85u, 123u, 10, 5);
+    OV_CHECK_EQ(screen.refresh(), SPEED_PAGES);
+    OV_CHECK((get_changed_pages(before, screen.get_buffer()) & ~SPEED_PAGES) == 0u);
+    OV_CHECK(screen.get_pixel_writes() < (full_pixel_writes / 4u));
+    reference.redraw();
+    OV_CHECK_EQ(memcmp(screen.get_buffer(), reference.get_buffer(), BUFFER_SIZE), 0);
+}
+
+OV_TEST(base_screen, full_redraw_on_night_mode_and_invalidate)
+{
+    set_data(12, 85u, 100u, 10, 5);
+    rendered_screen<dashboard2_screen> screen;
+    rendered_screen<dashboard2_screen> reference;
+    screen.refresh();
+
+    // Night mode change
+    OV_CHECK_EQ(screen.refresh(true), ALL_PAGES);
+    OV_CHECK_EQ(screen.refresh(true), 0u);
+    reference.redraw(true);
+    OV_CHECK_EQ(memcmp(screen.get_buffer(), reference.get_buffer(), BUFFER_SIZE), 0);
+
+    // Screen switch
+    screen.redraw(true);
+    OV_CHECK_EQ(screen.get_pixel_writes(), reference.get_pixel_writes());
+    OV_CHECK_EQ(screen.refresh(true), 0u);
+}
+
+OV_TEST(base_screen, replay_matches_full_redraw)
+{
+    test::random_generator random(0xD15Bu);
+    int16_t                sink_rate       = 0;
+    uint16_t               glide_ratio     = 100u;
+    uint32_t               speed           = 100u;
+    int16_t                te_sink_rate    = 0;
+    int16_t                netto_sink_rate = 0;
+    set_data(sink_rate, glide_ratio, speed, te_sink_rate, netto_sink_rate);
+    rendered_screen<dashboard2_screen> screen;
+    rendered_screen<dashboard2_screen> reference;
+    screen.refresh();
+
+    // At 5 refreshes per second the sink rates change at almost every refresh, the speed and glide ratio once per second
+    uint64_t full_pixel_writes = 0u;
+    uint64_t pixel_writes      = 0u;
+    uint32_t transferred_pages = 0u;
+    uint8_t  before[BUFFER_SIZE];
+    for (uint32_t i = 0u; i < REFRESH_COUNT; i++)
+    {
+        if (random.chance(0.8f))
+        {
+            sink_rate       = static_cast<int16_t>(static_cast<int32_t>(random.uniform(0u, 80u)) - 40);
+            te_sink_rate    = static_cast<int16_t>(sink_rate + static_cast<int32_t>(random.uniform(0u, 4u)) - 2);
+            netto_sink_rate = static_cast<int16_t>(sink_rate + 10);
+        }
+        if ((i % 5u) == 0u)
+        {
+            speed       = random.uniform(60u, 140u);
+            glide_ratio = static_cast<uint16_t>(random.uniform(40u, 120u));
+        }
+        set_data(sink_rate, glide_ratio, speed, te_sink_rate, netto_sink_rate);
+
+        memcpy(before, screen.get_buffer(), BUFFER_SIZE);
+        const uint32_t pages = screen.refresh();
+        reference.redraw();
+        OV_CHECK((get_changed_pages(before, screen.get_buffer()) & ~pages) == 0u);
+        OV_CHECK_EQ(memcmp(screen.get_buffer(), reference.get_buffer(), BUFFER_SIZE), 0);
+
+        full_pixel_writes += reference.get_pixel_writes();
+        pixel_writes += screen.get_pixel_writes();
+        transferred_pages += count_pages(pages);
+    }
+    OV_CHECK(pixel_writes < full_pixel_writes);
+    test::report_result("pixels written per refresh (full redraw)", static_cast<double>(full_pixel_writes) / REFRESH_COUNT, "pixels");
+    test::report_result("pixels written per refresh", static_cast<double>(pixel_writes) / REFRESH_COUNT, "pixels");
+    test::report_result("pages transferred per refresh", static_cast<double>(transferred_pages) / REFRESH_COUNT, "pages");
+}
+
+OV_TEST(base_screen, overlapping_labels_match_full_redraw)
+{
+    static const char* const TEXTS[] = {"1", "-2.5", "333", "TEXT", "LONGER TEXT", ""};
+    static constexpr uint32_t TEXT_COUNT = sizeof(TEXTS) / sizeof(TEXTS[0u]);
+
+    test::random_generator          random(0x0E7Au);
+    rendered_screen<overlap_screen> screen;
+    rendered_screen<overlap_screen> reference;
+    screen.get_screen().set_texts(TEXTS[0u], TEXTS[0u]);
+    screen.refresh();
+
+    // Texts become shorter or longer, the previous text must be erased without damaging the other label
+    uint8_t before[BUFFER_SIZE];
+    for (uint32_t i = 0u; i < REFRESH_COUNT; i++)
+    {
+        const char* top    = TEXTS[random.uniform(0u, TEXT_COUNT - 1u)];
+        const char* bottom = TEXTS[random.uniform(0u, TEXT_COUNT - 1u)];
+        screen.get_screen().set_texts(top, bottom);
+        reference.get_screen().set_texts(top, bottom);
+
+        memcpy(before, screen.get_buffer(), BUFFER_SIZE);
+        const uint32_t pages = screen.refresh();
+        reference.redraw();
+        OV_CHECK((get_changed_pages(before, screen.get_buffer()) & ~pages) == 0u);
+        OV_CHECK_EQ(memcmp(screen.get_buffer(), reference.get_buffer(), BUFFER_SIZE), 0);
+    }
+}
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "fs.h"
+#include "host_fs.h"
+#include "ov_test.h"
+#include "route_optimizer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace ov;
+
+/** @brief Reference position of the generated tasks (Annecy) */
+static const geo::position TASK_ORIGIN = geo::position::from_degrees(45.9, 6.12);
+
+/** @brief Speed of the simulated glider in meters per GNSS fix */
+static constexpr float GLIDER_STEP = 15.f;
+
+/** @brief Maximum number of fixes of a simulated flight */
+static constexpr uint32_t MAX_FIXES = 100000u;
+
+/** @brief Number of updates of the fully converged reference route, each update does at least one sweep */
+static constexpr uint32_t REFERENCE_UPDATES = 500u;
+
+/** @brief Number of fixes between 2 checks against the reference route */
+static constexpr uint32_t REFERENCE_PERIOD = 10u;
+
+/** @brief Maximum distance error of a converged route (m) */
+static constexpr float CONVERGED_ERROR = 1.f;
+
+/** @brief Sizes of the generated tasks */
+static constexpr size_t TASK_SIZES[] = {10u, 15u, 20u};
+
+/** @brief Statistics of a simulated flight along a task */
+struct route_stats
+{
+    /** @brief Number of GNSS fixes */
+    uint32_t fixes;
+    /** @brief Number of updates needed to converge from the cylinder centers at the takeoff */
+    uint32_t cold_updates;
+    /** @brief Distance error of the first update from the cylinder centers at the takeoff (m) */
+    float cold_error;
+    /** @brief Total number of sweeps */
+    uint32_t sweeps;
+    /** @brief Number of updates stopped by the maximum number of sweeps */
+    uint32_t max_sweep_updates;
+    /** @brief Maximum distance error against the fully converged route (m) */
+    float max_error;
+    /** @brief Maximum distance error of a single update from the cylinder centers, as after a turnpoint change (m) */
+    float max_restart_error;
+    /** @brief Mean duration of an update (ns) */
+    double mean_ns;
+    /** @brief Maximum duration of an update (ns) */
+    double max_ns;
+};
+
+/** @brief Format a position as a CUP coordinate pair "DDMM.mmmN,DDDMM.mmmE" */
+static const char* format_cup_position(const geo::position& pos, char (&str)[32u])
+{
+    // Thousandths of minutes
+    const long lat = std::lround(std::fabs(pos.latitude_deg()) * 60000.);
+    const long lon = std::lround(std::fabs(pos.longitude_deg()) * 60000.);
+    snprintf(str,
+             sizeof(str),
+             "%02d%02d.%03d%c,%03d%02d.%03d%c",
+             static_cast<int>(lat / 60000),
+             static_cast<int>((lat / 1000) % 60),
+             static_cast<int>(lat % 1000),
+             (pos.latitude >= 0) ? 'N' : 'S',
+             static_cast<int>(lon / 60000),
+             static_cast<int>((lon / 1000) % 60),
+             static_cast<int>(lon % 1000),
+             (pos.longitude >= 0) ? 'E' : 'W');
+    return str;
+}
+
+/** @brief Write a line into a file */
+static bool write_line(file& f, const char* line)
+{
+    size_t write_count = 0u;
+    return f.write(line, strlen(line), write_count) && f.write("\r\n", 2u, write_count);
+}
+
+/**
+ * @brief Generated turnpoint of a task of a given size
+ *        Real competition tasks are not available offline : legs of 8 to 32 km turning by the golden angle,
+ *        with the usual radiuses, a 5 km exit start around the takeoff and some overlapping cylinders
+ */
+static geo::position get_turnpoint(size_t task_size, size_t index, uint32_t& radius, const char*& type)
+{
+    static constexpr uint32_t RADIUSES[] = {400u, 1000u, 2000u, 3000u, 1000u, 5000u, 400u};
+
+    geo::position pos = TASK_ORIGIN;
+    for (size_t i = 2u; i <= index; i++)
+    {
+        const float bearing = 137.5f * static_cast<float>(i + task_size);
+        const float length  = 8000.f + 3000.f * static_cast<float>((i * 7u + task_size) % 9u);
+        pos                 = geo::destination(pos, geo::normalize_bearing(bearing), length);
+    }
+    if (index == 0u)
+    {
+        radius = 400u;
+        type   = "takeoff";
+    }
+    else if (index == 1u)
+    {
+        radius = 5000u;
+        type   = "sss";
+    }
+    else if (index == (task_size - 2u))
+    {
+        radius = 2000u;
+        type   = "ess";
+    }
+    else if (index == (task_size - 1u))
+    {
+        radius = 400u;
+        type   = "goal";
+    }
+    else
+    {
+        radius = RADIUSES[(index + task_size) % (sizeof(RADIUSES) / sizeof(RADIUSES[0u]))];
+        type   = "tp";
+    }
+    return pos;
+}
+
+/** @brief Get the path of the file of a generated task */
+static const char* get_task_path(size_t task_size, char (&path)[64u])
+{
+    snprintf(path, sizeof(path), "%s/task%02u.txt", waypoint_db::NAVIGATION_DIR, static_cast<unsigned int>(task_size));
+    return path;
+}
+
+/** @brief Get an empty filesystem with the waypoints of the generated tasks and their task files */
+static bool init_tasks()
+{
+    bool ret = test::format_host_fs() && fs::mkdir(waypoint_db::NAVIGATION_DIR);
+
+    file waypoints = fs::open(waypoint_db::WAYPOINTS_FILE, fs::o_creat | fs::o_trunc | fs::o_wronly);
+    ret            = ret && waypoints.is_open() && write_line(waypoints, "name,code,country,lat,lon,elev,style,rwdir,rwlen,freq,desc");
+    for (size_t task_size : TASK_SIZES)
+    {
+        char path[64u];
+        file task = fs::open(get_task_path(task_size, path), fs::o_creat | fs::o_trunc | fs::o_wronly);
+        ret       = ret && task.is_open() && write_line(task, "# Generated task");
+        for (size_t i = 0u; ret && (i < task_size); i++)
+        {
+            uint32_t            radius = 0u;
+            const char*         type   = nullptr;
+            const geo::position pos    = get_turnpoint(task_size, i, radius, type);
+            char                coordinates[32u];
+            char                line[128u];
+            snprintf(line,
+                     sizeof(line),
+                     "\"Task %02u point %02u\",T%02uP%02u,FR,%s,%um,1,,,,",
+                     static_cast<unsigned int>(task_size),
+                     static_cast<unsigned int>(i),
+                     static_cast<unsigned int>(task_size),
+                     static_cast<unsigned int>(i),
+                     format_cup_position(pos, coordinates),
+                     static_cast<unsigned int>(1000u + i * 50u));
+            ret = write_line(waypoints, line);
+            snprintf(line,
+                     sizeof(line),
+                     "%s %u T%02uP%02u",
+                     type,
+                     static_cast<unsigned int>(radius),
+                     static_cast<unsigned int>(task_size),
+                     static_cast<unsigned int>(i));
+            ret = ret && write_line(task, line);
+        }
+        ret = task.close() && ret;
+    }
+    ret = waypoints.close() && ret;
+
+    return ret;
+}
+
+/** @brief Load a generated task */
+static bool load_task(size_t task_size, flight_task& task)
+{
+    char path[64u];
+    return (task.load(get_task_path(task_size, path)) && (task.get_count() == task_size));
+}
+
+/** @brief Get the distance along the fully converged route from the cylinder centers */
+static float get_reference_distance(route_optimizer& optimizer, const geo::position& pos, size_t first)
+{
+    float distance = 0.f;
+    optimizer.reset();
+    for (uint32_t i = 0u; i < REFERENCE_UPDATES; i++)
+    {
+        distance = optimizer.update(pos, first);
+    }
+    return distance;
+}
+
+/**
+ * @brief Fly a task from the takeoff towards the optimized touch points with an update on each fix,
+ *        the touch point of the active turnpoint is validated when reached
+ */
+static route_stats fly_task(const flight_task& task, bool check_reference)
+{
+    route_optimizer optimizer;
+    route_optimizer reference;
+    route_optimizer restart;
+    optimizer.set_task(task);
+    reference.set_task(task);
+    restart.set_task(task);
+
+    // Cold start at the takeoff
+    route_stats   stats    = {};
+    geo::position pos      = task.get_turnpoint(0u).wp.position;
+    size_t        active   = 1u;
+    const float   distance = get_reference_distance(reference, pos, active);
+    float         error    = std::fabs(optimizer.update(pos, active) - distance);
+    stats.cold_error       = error;
+    stats.cold_updates     = 1u;
+    while ((error >= CONVERGED_ERROR) && (stats.cold_updates < REFERENCE_UPDATES))
+    {
+        error = std::fabs(optimizer.update(pos, active) - distance);
+        stats.cold_updates++;
+    }
+
+    // Flight
+    optimizer.reset();
+    while ((active < task.get_count()) && (stats.fixes < MAX_FIXES))
+    {
+        test::stopwatch watch;
+        const float     goal_distance = optimizer.update(pos, active);
+        const double    duration      = watch.elapsed_ns();
+        stats.mean_ns += duration;
+        stats.max_ns = (duration > stats.max_ns) ? duration : stats.max_ns;
+        stats.sweeps += static_cast<uint32_t>(optimizer.get_sweeps());
+        stats.max_sweep_updates += (optimizer.get_sweeps() == route_optimizer::MAX_SWEEPS) ? 1u : 0u;
+        stats.fixes++;
+
+        if (check_reference && ((stats.fixes % REFERENCE_PERIOD) == 0u))
+        {
+            const float distance_ref = get_reference_distance(reference, pos, active);
+            error                    = std::fabs(goal_distance - distance_ref);
+            stats.max_error          = (error > stats.max_error) ? error : stats.max_error;
+            restart.reset();
+            error                   = std::fabs(restart.update(pos, active) - distance_ref);
+            stats.max_restart_error = (error > stats.max_restart_error) ? error : stats.max_restart_error;
+        }
+
+        // Fly towards the touch point of the active turnpoint
+        const geo::position target = optimizer.get_point(active);
+        if (optimizer.get_first_leg_distance() <= GLIDER_STEP)
+        {
+            pos = target;
+            active++;
+        }
+        else
+        {
+            pos = geo::destination(pos, geo::bearing(pos, target), GLIDER_STEP);
+        }
+    }
+    stats.mean_ns /= stats.fixes;
+    return stats;
+}
+
+OV_TEST(route_optimizer, task_load)
+{
+    OV_CHECK(init_tasks());
+
+    for (size_t task_size : TASK_SIZES)
+    {
+        flight_task task;
+        OV_CHECK(load_task(task_size, task));
+        OV_CHECK(task.get_turnpoint(0u).type == flight_task::turnpoint_type::takeoff);
+        OV_CHECK(task.get_turnpoint(1u).type == flight_task::turnpoint_type::start);
+        OV_CHECK(task.get_turnpoint(task_size - 2u).type == flight_task::turnpoint_type::end_of_speed_section);
+        OV_CHECK(task.get_turnpoint(task_size - 1u).type == flight_task::turnpoint_type::goal);
+        OV_CHECK_EQ(task.get_turnpoint(1u).radius, 5000u);
+
+        // CUP coordinates have a resolution of 0.001'
+        uint32_t            radius = 0u;
+        const char*         type   = nullptr;
+        const geo::position last   = get_turnpoint(task_size, task_size - 1u, radius, type);
+        OV_CHECK(geo::distance(task.get_turnpoint(task_size - 1u).wp.position, last) < 2.f);
+    }
+
+    // Unknown waypoint
+    file f = fs::open("/navigation/unknown.txt", fs::o_creat | fs::o_trunc | fs::o_wronly);
+    OV_CHECK(write_line(f, "sss 5000 T10P01") && write_line(f, "goal 400 NOWHERE") && f.close());
+    flight_task task;
+    OV_CHECK(!task.load("/navigation/unknown.txt"));
+    OV_CHECK_EQ(task.get_count(), 0u);
+}
+
+/** @brief Write a waypoint into the waypoints file */
+static bool write_waypoint(file& waypoints, const char* code, const geo::position& pos)
+{
+    char coordinates[32u];
+    char line[128u];
+    snprintf(line, sizeof(line), "\"%s\",%s,FR,%s,1000m,1,,,,", code, code, format_cup_position(pos, coordinates));
+    return write_line(waypoints, line);
+}
+
+/** @brief Write a task file with a turnpoint and the goal */
+static bool write_leg_task(const char* path, const char* turnpoint, uint32_t radius, const char* goal)
+{
+    char line[64u];
+    file task = fs::open(path, fs::o_creat | fs::o_trunc | fs::o_wronly);
+    snprintf(line, sizeof(line), "tp %u %s", static_cast<unsigned int>(radius), turnpoint);
+    bool ret = write_line(task, line);
+    snprintf(line, sizeof(line), "goal 0 %s", goal);
+    ret = ret && write_line(task, line);
+    ret = task.close() && ret;
+    return ret;
+}
+
+OV_TEST(route_optimizer, known_geometry)
+{
+    OV_CHECK(test::format_host_fs() && fs::mkdir(waypoint_db::NAVIGATION_DIR));
+
+    // 20 km leg towards the east with a 1 km cylinder centered 5 km north of its middle : the route touches its southernmost point,
+    // with a 1 km cylinder centered 500 m north of its middle : the route is the straight line,
+    const geo::flat_projection projection(TASK_ORIGIN);
+    const geo::position        goal    = projection.from_xy(20000.f, 0.f);
+    const geo::position        north   = projection.from_xy(10000.f, 5000.f);
+    const geo::position        crossed = projection.from_xy(10000.f, 500.f);
+    const geo::position        large   = projection.from_xy(1250.f, -2950.f);
+    const geo::position        back    = projection.from_xy(-3500.f, 2350.f);
+    file                       waypoints = fs::open(waypoint_db::WAYPOINTS_FILE, fs::o_creat | fs::o_trunc | fs::o_wronly);
+    OV_CHECK(write_waypoint(waypoints, "NORTH", north) && write_waypoint(waypoints, "CROSSED", crossed));
+    OV_CHECK(write_waypoint(waypoints, "LARGE", large) && write_waypoint(waypoints, "BACK", back));
+    OV_CHECK(write_waypoint(waypoints, "GOAL", goal) && waypoints.close());
+    OV_CHECK(write_leg_task("/navigation/north.txt", "NORTH", 1000u, "GOAL"));
+    OV_CHECK(write_leg_task("/navigation/crossed.txt", "CROSSED", 1000u, "GOAL"));
+    OV_CHECK(write_leg_task("/navigation/large.txt", "LARGE", 3000u, "BACK"));
+
+    flight_task     task;
+    route_optimizer optimizer;
+    OV_CHECK(task.load("/navigation/north.txt"));
+    optimizer.set_task(task);
+    geo::position touch = projection.from_xy(10000.f, 4000.f);
+    OV_CHECK_NEAR(get_reference_distance(optimizer, TASK_ORIGIN, 0u), geo::distance(TASK_ORIGIN, touch) + geo::distance(touch, goal), 5.f);
+    OV_CHECK(geo::distance(optimizer.get_point(0u), touch) < 5.f);
+    OV_CHECK_NEAR(optimizer.get_first_leg_distance(), geo::distance(TASK_ORIGIN, touch), 5.f);
+
+    OV_CHECK(task.load("/navigation/crossed.txt"));
+    optimizer.set_task(task);
+    OV_CHECK_NEAR(get_reference_distance(optimizer, TASK_ORIGIN, 0u), geo::distance(TASK_ORIGIN, goal), 5.f);
+    OV_CHECK(geo::distance(optimizer.get_point(1u), goal) < 5.f);
+
+    // 200 m away from a 3 km cylinder with the goal on the side, the touch point must not oscillate around its optimal position,
+    // which is found by an exhaustive search over the cylinder
+    OV_CHECK(task.load("/navigation/large.txt"));
+    optimizer.set_task(task);
+    float shortest = 1e9f;
+    for (uint32_t i = 0u; i < 36000u; i++)
+    {
+        const float         angle = static_cast<float>(i) * 0.01f * geo::DEG_TO_RAD;
+        const geo::position p     = projection.from_xy(1250.f + 3000.f * std::cos(angle), -2950.f + 3000.f * std::sin(angle));
+        const float         d     = geo::distance(TASK_ORIGIN, p) + geo::distance(p, back);
+        if (d < shortest)
+        {
+            shortest = d;
+            touch    = p;
+        }
+    }
+    OV_CHECK_NEAR(get_reference_distance(optimizer, TASK_ORIGIN, 0u), shortest, 5.f);
+    OV_CHECK(geo::distance(optimizer.get_point(0u), touch) < 10.f);
+}
+
+OV_TEST(route_optimizer, incremental_convergence)
+{
+    OV_CHECK(init_tasks());
+
+    // Updates reusing the previous solution stay on the fully converged route despite the limited number of sweeps
+    for (size_t task_size : TASK_SIZES)
+    {
+        flight_task task;
+        OV_CHECK(load_task(task_size, task));
+        const route_stats stats = fly_task(task, true);
+        OV_CHECK(stats.fixes < MAX_FIXES);
+        OV_CHECK(stats.cold_updates <= 5u);
+        OV_CHECK(stats.max_error < CONVERGED_ERROR);
+        OV_CHECK(stats.max_restart_error < 1000.f);
+        OV_CHECK(stats.sweeps < (2u * stats.fixes));
+
+        char name[64u];
+        snprintf(name, sizeof(name), "%u tp : max error", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.max_error, "m");
+        snprintf(name, sizeof(name), "%u tp : max error of a restart", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.max_restart_error, "m");
+    }
+}
+
+OV_BENCHMARK(route_optimizer, competition_tasks)
+{
+    OV_CHECK(init_tasks());
+
+    for (size_t task_size : TASK_SIZES)
+    {
+        flight_task task;
+        OV_CHECK(load_task(task_size, task));
+        const route_stats stats = fly_task(task, false);
+
+        char name[64u];
+        snprintf(name, sizeof(name), "%u tp : fixes", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.fixes, "");
+        snprintf(name, sizeof(name), "%u tp : cold start updates to converge", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.cold_updates, "");
+        snprintf(name, sizeof(name), "%u tp : cold start first update error", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.cold_error, "m");
+        snprintf(name, sizeof(name), "%u tp : mean sweeps per update", static_cast<unsigned int>(task_size));
+        test::report_result(name, static_cast<double>(stats.sweeps) / stats.fixes, "");
+        snprintf(name, sizeof(name), "%u tp : updates limited to %u sweeps", static_cast<unsigned int>(task_size),
+                 static_cast<unsigned int>(route_optimizer::MAX_SWEEPS));
+        test::report_result(name, stats.max_sweep_updates, "");
+        snprintf(name, sizeof(name), "%u tp : mean update", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.mean_ns / 1e3, "us");
+        snprintf(name, sizeof(name), "%u tp : max update", static_cast<unsigned int>(task_size));
+        test::report_result(name, stats.max_ns / 1e3, "us");
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "date_time.h"
+#include "ov_test.h"
+
+using namespace ov;
+
+/** @brief Check that a date matches the expected one */
+static bool is_date(const date_time& date, const date_time& expected)
+{
+    return ((date.year == expected.year) && (date.month == expected.month) && (date.day == expected.day) && (date.hour == expected.hour) &&
+            (date.minute == expected.minute) && (date.second == expected.second) && (date.millis == expected.millis));
+}
+
+OV_TEST(date_time, subtract_same_day)
+{
+    date_time date = {23u, 7u, 14u, 12u, 0u, 0u, 250u};
+    date.subtract(500u);
+    OV_CHECK(is_date(date, {23u, 7u, 14u, 11u, 59u, 59u, 750u}));
+    date.subtract(11u * 3600000u);
+    OV_CHECK(is_date(date, {23u, 7u, 14u, 0u, 59u, 59u, 750u}));
+}
+
+OV_TEST(date_time, subtract_previous_day)
+{
+    // Previous day of the same month
+    date_time date = {23u, 7u, 14u, 0u, 1u, 0u, 0u};
+    date.subtract(120000u);
+    OV_CHECK(is_date(date, {23u, 7u, 13u, 23u, 59u, 0u, 0u}));
+
+    // Previous month, leap and non leap years
+    date = {24u, 3u, 1u, 0u, 1u, 0u, 0u};
+    date.subtract(120000u);
+    OV_CHECK(is_date(date, {24u, 2u, 29u, 23u, 59u, 0u, 0u}));
+    date = {23u, 3u, 1u, 0u, 0u, 0u, 500u};
+    date.subtract(1000u);
+    OV_CHECK(is_date(date, {23u, 2u, 28u, 23u, 59u, 59u, 500u}));
+    date = {23u, 5u, 1u, 0u, 0u, 0u, 0u};
+    date.subtract(1u);
+    OV_CHECK(is_date(date, {23u, 4u, 30u, 23u, 59u, 59u, 999u}));
+
+    // Previous year
+    date = {24u, 1u, 1u, 0u, 0u, 10u, 0u};
+    date.subtract(20000u);
+    OV_CHECK(is_date(date, {23u, 12u, 31u, 23u, 59u, 50u, 0u}));
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "glider_polar.h"
+#include "ov_test.h"
+#include "speed_to_fly.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace ov;
+
+/** @brief Performance of a glider from its manufacturer's data sheet */
+struct manufacturer_performance
+{
+    /** @brief Name of the polar in the database */
+    const char* name;
+    /** @brief Minimum sink rate (m/s) */
+    double min_sink;
+    /** @brief Speed of the minimum sink rate (km/h) */
+    double min_sink_speed;
+    /** @brief Best glide ratio */
+    double best_glide;
+    /** @brief Speed of the best glide (km/h) */
+    double best_glide_speed;
+};
+
+/** @brief Performance published by Alexander Schleicher for the manufacturer polars of the database */
+static const manufacturer_performance MANUFACTURER[] = {{"ASK 21", 0.65, 67., 34., 90.}, {"Ka 8 b", 0.65, 60., 27., 73.}};
+
+/** @brief Reference model of a polar, computed in double precision without tables */
+class reference_polar
+{
+  public:
+    /** @brief Constructor, fits the parabola by solving the linear system of the 3 points */
+    explicit reference_polar(const glider_polar& polar) : m_min_speed(polar.speeds[0u] / 3.6), m_max_speed(polar.speeds[2u] / 3.6)
+    {
+        // Cramer's rule on [v² v 1] . [a b c] = s
+        double m[3u][3u];
+        double s[3u];
+        for (size_t i = 0u; i < 3u; i++)
+        {
+            const double v = polar.speeds[i] / 3.6;
+            m[i][0u]       = v * v;
+            m[i][1u]       = v;
+            m[i][2u]       = 1.;
+            s[i]           = polar.sinks[i] / 100.;
+        }
+        const double d = determinant(m);
+        for (size_t j = 0u; j < 3u; j++)
+        {
+            double mj[3u][3u];
+            for (size_t i = 0u; i < 3u; i++)
+            {
+                for (size_t k = 0u; k < 3u; k++)
+                {
+                    mj[i][k] = (k == j) ? s[i] : m[i][k];
+                }
+            }
+            m_coefs[j] = determinant(mj) / d;
+        }
+    }
+
+    /** @brief Sink rate (m/s, positive when sinking) at a speed (m/s) */
+    double sink(double v) const { return m_coefs[0u] * v * v + m_coefs[1u] * v + m_coefs[2u]; }
+
+    /** @brief Speed to fly (m/s) for a MacCready setting (m/s), found by a search over the speed range of the polar */
+    double speed_to_fly(double mc) const
+    {
+        double best_speed = m_min_speed;
+        for (double v = m_min_speed; v <= m_max_speed; v += 0.001)
+        {
+            if (((sink(v) + mc) / v) < ((sink(best_speed) + mc) / best_speed))
+            {
+                best_speed = v;
+            }
+        }
+        return best_speed;
+    }
+
+    /** @brief Minimum speed (m/s) */
+    double min_speed() const { return m_min_speed; }
+
+    /** @brief Speed of the minimum sink rate (m/s) */
+    double min_sink_speed() const { return -m_coefs[1u] / (2. * m_coefs[0u]); }
+
+  private:
+    /** @brief Minimum speed (m/s) */
+    double m_min_speed;
+    /** @brief Maximum speed (m/s) */
+    double m_max_speed;
+    /** @brief Coefficients of the parabola, highest degree first */
+    double m_coefs[3u];
+
+    /** @brief Determinant of a 3x3 matrix */
+    static double determinant(const double m[3u][3u])
+    {
+        return m[0u][0u] * (m[1u][1u] * m[2u][2u] - m[1u][2u] * m[2u][1u]) - m[0u][1u] * (m[1u][0u] * m[2u][2u] - m[1u][2u] * m[2u][0u]) +
+               m[0u][2u] * (m[1u][0u] * m[2u][1u] - m[1u][1u] * m[2u][0u]);
+    }
+};
+
+/** @brief Still air glide ratio at the speed to fly of a MacCready setting (1 = 0.1m/s) */
+static double glide_ratio(const speed_to_fly& stf, uint16_t mac_cready)
+{
+    static constexpr uint32_t DISTANCE = 100000u;
+    return (DISTANCE * 10.) / static_cast<double>(stf.get_final_glide_altitude(DISTANCE, mac_cready));
+}
+
+/** @brief Find a polar of the database by its name, nullptr if not found */
+static const glider_polar* find_polar(const std::string& name)
+{
+    const glider_polar* ret = nullptr;
+    for (size_t i = 0u; (i < polar::get_count()) && (ret == nullptr); i++)
+    {
+        if (name == polar::get(i)->name)
+        {
+            ret = polar::get(i);
+        }
+    }
+    return ret;
+}
+
+OV_TEST(speed_to_fly, database_is_valid)
+{
+    OV_CHECK(polar::get(polar::get_count()) == nullptr);
+    for (size_t i = 0u; i < polar::get_count(); i++)
+    {
+        const glider_polar* polar = polar::get(i);
+        OV_CHECK(polar != nullptr);
+        speed_to_fly stf;
+        OV_CHECK(stf.set_polar(*polar));
+    }
+}
+
+OV_TEST(speed_to_fly, manufacturer_polars)
+{
+    for (const manufacturer_performance& published : MANUFACTURER)
+    {
+        const glider_polar* polar = find_polar(published.name);
+        OV_CHECK(polar != nullptr);
+        const reference_polar reference(*polar);
+        speed_to_fly          stf;
+        OV_CHECK(stf.set_polar(*polar));
+
+        // The fitted parabola has its minimum at the published minimum sink point
+        OV_CHECK_NEAR(reference.min_sink_speed() * 3.6, published.min_sink_speed, 1.);
+        OV_CHECK_NEAR(reference.sink(reference.min_sink_speed()), published.min_sink, 0.01);
+        const uint32_t min_sink_speed = static_cast<uint32_t>(std::lround(published.min_sink_speed / 0.36));
+        OV_CHECK_NEAR(-stf.get_sink(min_sink_speed) / 10., published.min_sink, 0.07);
+
+        // The speed to fly without MacCready is the published best glide, a parabola cannot follow the flat low speed part
+        // of a sailplane polar so that its tangent from the origin touches it a few km/h away from the published speed
+        const double best_glide       = glide_ratio(stf, 0u);
+        const double best_glide_speed = stf.get_speed_to_fly(0u) * 0.36;
+        char name[64u];
+        snprintf(name, sizeof(name), "%s : best glide", published.name);
+        test::report_result(name, best_glide, "");
+        snprintf(name, sizeof(name), "%s : best glide speed", published.name);
+        test::report_result(name, best_glide_speed, "km/h");
+        OV_CHECK_NEAR(best_glide, published.best_glide, published.best_glide * 0.03);
+        OV_CHECK_NEAR(best_glide_speed, published.best_glide_speed, 5.);
+
+        // Glide ratio at the published best glide speed
+        const double speed = published.best_glide_speed / 3.6;
+        OV_CHECK_NEAR(speed / reference.sink(speed), published.best_glide, published.best_glide * 0.03);
+    }
+}
+
+OV_TEST(speed_to_fly, parabola_fit)
+{
+    for (size_t i = 0u; i < polar::get_count(); i++)
+    {
+        const glider_polar*   polar = polar::get(i);
+        const reference_polar reference(*polar);
+        speed_to_fly          stf;
+        OV_CHECK(stf.set_polar(*polar));
+
+        // The fitted parabola goes through the 3 points of the polar
+        for (size_t j = 0u; j < glider_polar::POINTS_COUNT; j++)
+        {
+            OV_CHECK_NEAR(reference.sink(polar->speeds[j] / 3.6), polar->sinks[j] / 100., 1e-9);
+            const uint32_t speed = static_cast<uint32_t>(std::lround(polar->speeds[j] / 0.36));
+            OV_CHECK_NEAR(-stf.get_sink(speed) / 10., reference.sink(speed / 10.), 0.07);
+        }
+
+        // The speeds to fly minimize the time to climb and glide
+        for (uint16_t mc = 0u; mc <= speed_to_fly::MAX_MAC_CREADY; mc += 5u)
+        {
+            OV_CHECK_NEAR(stf.get_speed_to_fly(mc) / 10., reference.speed_to_fly(mc / 10.), 0.06);
+        }
+    }
+}
+
+OV_TEST(speed_to_fly, mac_cready_table_monotonic)
+{
+    for (size_t i = 0u; i < polar::get_count(); i++)
+    {
+        const glider_polar* polar = polar::get(i);
+        speed_to_fly        stf;
+        OV_CHECK(stf.set_polar(*polar));
+
+        // Flying faster for a stronger MacCready setting always costs altitude, up to the top speed of the polar
+        uint16_t previous_speed    = 0u;
+        uint32_t previous_altitude = 0u;
+        for (uint16_t mc = 0u; mc <= speed_to_fly::MAX_MAC_CREADY; mc++)
+        {
+            const uint16_t speed    = stf.get_speed_to_fly(mc);
+            const uint32_t altitude = stf.get_final_glide_altitude(10000u, mc);
+            OV_CHECK(speed >= previous_speed);
+            OV_CHECK(altitude >= previous_altitude);
+            OV_CHECK(speed >= std::lround(polar->speeds[0u] / 0.36));
+            OV_CHECK(speed <= std::lround(polar->speeds[2u] / 0.36));
+            previous_speed    = speed;
+            previous_altitude = altitude;
+        }
+        OV_CHECK(stf.get_speed_to_fly(speed_to_fly::MAX_MAC_CREADY) > stf.get_speed_to_fly(0u));
+        OV_CHECK_EQ(stf.get_speed_to_fly(speed_to_fly::MAX_MAC_CREADY), std::lround(polar->speeds[2u] / 0.36));
+
+        // Settings above the table are clamped
+        OV_CHECK_EQ(stf.get_speed_to_fly(speed_to_fly::MAX_MAC_CREADY + 1u), stf.get_speed_to_fly(speed_to_fly::MAX_MAC_CREADY));
+        OV_CHECK_EQ(stf.get_final_glide_altitude(10000u, 0xFFFFu), stf.get_final_glide_altitude(10000u, speed_to_fly::MAX_MAC_CREADY));
+    }
+}
+
+OV_TEST(speed_to_fly, get_sink_interpolation)
+{
+    for (size_t i = 0u; i < polar::get_count(); i++)
+    {
+        const glider_polar*   polar = polar::get(i);
+        const reference_polar reference(*polar);
+        speed_to_fly          stf;
+        OV_CHECK(stf.set_polar(*polar));
+
+        // Linear interpolation of the parabola between the 1m/s steps
+        const uint32_t min_speed = static_cast<uint32_t>(std::ceil(reference.min_speed())) * 10u;
+        int16_t        previous  = stf.get_sink(min_speed);
+        for (uint32_t speed = min_speed; speed < (speed_to_fly::MAX_SPEED * 10u); speed++)
+        {
+            const int16_t sink = stf.get_sink(speed);
+            OV_CHECK(sink <= 0);
+            OV_CHECK_NEAR(-sink / 10., reference.sink(speed / 10.), 0.07);
+            if ((speed / 10.) > (reference.min_sink_speed() + 1.))
+            {
+                OV_CHECK(sink <= previous);
+            }
+            previous = sink;
+        }
+
+        // Held at the minimum speed below it and at the maximum speed of the table above it
+        const int16_t min_sink = stf.get_sink(static_cast<uint32_t>(std::lround(reference.min_speed() * 10.)));
+        OV_CHECK_NEAR(-min_sink / 10., reference.sink(reference.min_speed()), 0.07);
+        OV_CHECK_EQ(stf.get_sink(0u), stf.get_sink(static_cast<uint32_t>(std::floor(reference.min_speed())) * 10u));
+        OV_CHECK(std::abs(stf.get_sink(0u) - min_sink) <= 1);
+        OV_CHECK_EQ(stf.get_sink(speed_to_fly::MAX_SPEED * 10u + 1000u), stf.get_sink(speed_to_fly::MAX_SPEED * 10u));
+    }
+}
+
+OV_TEST(speed_to_fly, invalid_polars)
+{
+    speed_to_fly stf;
+    OV_CHECK(!stf.is_valid());
+    OV_CHECK_EQ(stf.get_final_glide_altitude(10000u, 10u), 0u);
+
+    // Speeds not in increasing order
+    OV_CHECK(!stf.set_polar({"Unordered", {40u, 30u, 50u}, {110u, 120u, 190u}}));
+    OV_CHECK(!stf.set_polar({"Same speed", {30u, 30u, 50u}, {110u, 120u, 190u}}));
+
+    // Top speed beyond the sink table
+    OV_CHECK(!stf.set_polar({"Fast sailplane", {100u, 150u, 200u}, {60u, 70u, 150u}}));
+
+    // Sink rate not convex or negative at zero speed
+    OV_CHECK(!stf.set_polar({"Concave", {30u, 40u, 50u}, {100u, 180u, 200u}}));
+    OV_CHECK(!stf.set_polar({"Straight", {30u, 40u, 50u}, {100u, 150u, 200u}}));
+    OV_CHECK(!stf.is_valid());
+    OV_CHECK_EQ(stf.get_final_glide_altitude(10000u, 10u), 0u);
+
+    // A valid polar can be set again and reset
+    OV_CHECK(stf.set_polar(*polar::get(0u)));
+    OV_CHECK(stf.is_valid());
+    stf.reset();
+    OV_CHECK(!stf.is_valid());
+    OV_CHECK_EQ(stf.get_final_glide_altitude(10000u, 10u), 0u);
+}
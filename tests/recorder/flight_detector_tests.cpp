@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_detector.h"
+#include "ov_test.h"
+#include "pretrigger_buffer.h"
+#include "random_generator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace ov;
+
+/** @brief Recording period of the replays in milliseconds (default configuration) */
+static constexpr uint32_t PERIOD = 1000u;
+
+/** @brief Number of replayed flights */
+static constexpr uint32_t FLIGHT_COUNT = 20u;
+
+/** @brief Number of replayed days on the ground */
+static constexpr uint32_t GROUND_DAY_COUNT = 40u;
+
+/** @brief Number of hours of a replayed day on the ground */
+static constexpr uint32_t GROUND_DAY_HOURS = 8u;
+
+/** @brief Detection event with its time */
+struct detection
+{
+    /** @brief Time of the event in seconds since the start of the replay */
+    uint32_t time;
+    /** @brief Event */
+    flight_detector::event evt;
+};
+
+/**
+ * @brief Replay of a simulated day through the flight detector and the pretrigger buffer at the recording period
+ *        No recorded flight with the raw sensor data is available offline, the phases are modeled from the sensors noise
+ *        (GNSS speed noise and multipath spikes, barometric noise and pressure gusts) and from typical paraglider flights
+ */
+class replay
+{
+  public:
+    /** @brief Constructor */
+    replay(uint32_t seed)
+        : m_random(seed),
+          m_detector(),
+          m_pretrigger(),
+          m_time(0u),
+          m_altitude(1000.f),
+          m_detections(),
+          m_pretrigger_start(0u),
+          m_spike_duration(0u),
+          m_spike_speed(0.f),
+          m_gust_duration(0u),
+          m_gust_rate(0.f)
+    {
+    }
+
+    /** @brief Get the current time in seconds since the start of the replay */
+    uint32_t get_time() const { return m_time; }
+
+    /** @brief Get the time of the oldest entry of the pretrigger buffer when the last takeoff was detected */
+    uint32_t get_pretrigger_start() const { return m_pretrigger_start; }
+
+    /** @brief Count the detected events of a type */
+    size_t count(flight_detector::event evt) const
+    {
+        size_t count = 0u;
+        for (const detection& d : m_detections)
+        {
+            count += (d.evt == evt) ? 1u : 0u;
+        }
+        return count;
+    }
+
+    /** @brief Get the delay between a time and the first event of a type after it in seconds, UINT32_MAX if none */
+    uint32_t get_delay(uint32_t time, flight_detector::event evt) const
+    {
+        uint32_t delay = UINT32_MAX;
+        for (const detection& d : m_detections)
+        {
+            if ((d.evt == evt) && (d.time >= time) && (delay == UINT32_MAX))
+            {
+                delay = d.time - time;
+            }
+        }
+        return delay;
+    }
+
+    /** @brief Device lying on the ground : GNSS speed noise with multipath spikes, barometric noise with pressure gusts */
+    void rest(uint32_t duration)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            if ((m_spike_duration == 0u) && m_random.chance(1.f / 900.f))
+            {
+                m_spike_duration = m_random.uniform(1u, 4u);
+                m_spike_speed    = m_random.uniform(2.f, 6.f);
+            }
+            if ((m_gust_duration == 0u) && m_random.chance(1.f / 1200.f))
+            {
+                m_gust_duration = m_random.uniform(3u, 8u);
+                m_gust_rate     = m_random.uniform(-2.5f, 2.5f);
+            }
+            const float speed = (m_spike_duration != 0u) ? m_spike_speed : std::fabs(m_random.gaussian(0.f, 0.25f));
+            const float sink  = (m_gust_duration != 0u) ? m_gust_rate : m_random.gaussian(0.f, 0.15f);
+            m_spike_duration -= (m_spike_duration != 0u) ? 1u : 0u;
+            m_gust_duration -= (m_gust_duration != 0u) ? 1u : 0u;
+            feed(speed, sink, m_random.gaussian(0.f, 8.f));
+        }
+    }
+
+    /** @brief Pilot walking, preparing or packing the wing with the device in the harness */
+    void walk(uint32_t duration)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            feed(std::fabs(m_random.gaussian(1.2f, 0.4f)), m_random.gaussian(0.f, 0.25f), m_random.gaussian(0.f, 180.f));
+        }
+    }
+
+    /** @brief Pilot hiking up or down a slope with the device in the harness : mean climb rate (m/s) */
+    void hike(uint32_t duration, float climb)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            feed(std::fabs(m_random.gaussian(1.f, 0.3f)), m_random.gaussian(-climb, 0.25f), m_random.gaussian(0.f, 200.f));
+        }
+    }
+
+    /** @brief Takeoff run accelerating to the flight ground speed (m/s) */
+    void takeoff_run(uint32_t duration, float speed)
+    {
+        for (uint32_t i = 1u; i <= duration; i++)
+        {
+            feed(speed * static_cast<float>(i) / static_cast<float>(duration), m_random.gaussian(0.f, 0.3f), m_random.gaussian(0.f, 250.f));
+        }
+    }
+
+    /** @brief Flight with thermals of 4 minutes : ground speed (m/s) and turbulence (1000 = 1g) */
+    void fly(uint32_t duration, float speed, float turbulence)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            const float cycle = 6.2831853f * static_cast<float>(m_time % 240u) / 240.f;
+            const float sink  = 0.5f - 2.f * std::sin(cycle) + m_random.gaussian(0.f, 0.4f);
+            feed(std::fabs(m_random.gaussian(speed, 1.5f)), sink, m_random.gaussian(0.f, turbulence));
+        }
+    }
+
+    /** @brief Ridge soaring in a wind as strong as the trim speed : almost no ground speed nor vertical speed, calm air */
+    void hover(uint32_t duration)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            feed(std::fabs(m_random.gaussian(0.8f, 0.5f)), m_random.gaussian(-0.2f, 0.4f), m_random.gaussian(0.f, 60.f));
+        }
+    }
+
+    /** @brief Ridge soaring close to the slope : ground speed (m/s) and mean climb rate (m/s) in bumpy lift */
+    void soar(uint32_t duration, float speed, float climb)
+    {
+        for (uint32_t i = 0u; i < duration; i++)
+        {
+            feed(std::fabs(m_random.gaussian(speed, 1.f)), m_random.gaussian(-climb, 0.8f), m_random.gaussian(0.f, 100.f));
+        }
+    }
+
+    /** @brief Slow down from the flight ground speed (m/s) to the touchdown */
+    void touchdown(float speed)
+    {
+        for (uint32_t i = 1u; i <= 4u; i++)
+        {
+            const float accel = (i == 4u) ? 1500.f : m_random.gaussian(0.f, 250.f);
+            feed(speed * static_cast<float>(4u - i) / 4.f, m_random.gaussian(-1.f, 0.3f), accel);
+        }
+    }
+
+  private:
+    /** @brief Random generator */
+    test::random_generator m_random;
+    /** @brief Detector */
+    flight_detector m_detector;
+    /** @brief Pretrigger buffer filled while on ground, as in the flight recorder */
+    pretrigger_buffer m_pretrigger;
+    /** @brief Current time in seconds */
+    uint32_t m_time;
+    /** @brief Current barometric altitude (m) */
+    float m_altitude;
+    /** @brief Detected events */
+    std::vector<detection> m_detections;
+    /** @brief Time of the oldest entry of the pretrigger buffer when the last takeoff was detected */
+    uint32_t m_pretrigger_start;
+    /** @brief Remaining duration of a GNSS multipath speed spike in seconds */
+    uint32_t m_spike_duration;
+    /** @brief Speed of the GNSS multipath speed spike (m/s) */
+    float m_spike_speed;
+    /** @brief Remaining duration of a pressure gust in seconds */
+    uint32_t m_gust_duration;
+    /** @brief Vertical speed seen during the pressure gust (m/s) */
+    float m_gust_rate;
+
+    /** @brief Feed an entry : GNSS speed (m/s), sink rate (m/s) and deviation of the total acceleration (1000 = 1g) */
+    void feed(float speed, float sink, float accel_deviation)
+    {
+        m_altitude -= sink * static_cast<float>(PERIOD) / 1000.f;
+
+        flight_file::entry entry = {};
+        entry.speed              = static_cast<uint32_t>(std::lround(speed * 10.f));
+        entry.altitude           = static_cast<int32_t>(std::lround(m_altitude * 10.f));
+        entry.sink_rate          = static_cast<int16_t>(std::lround(sink * 10.f));
+        entry.total_accel        = static_cast<int16_t>(std::lround(1000.f + accel_deviation));
+        entry.gnss_is_valid      = true;
+        entry.alti_is_valid      = true;
+        entry.accel_is_valid     = true;
+        if (!m_detector.is_flying())
+        {
+            m_pretrigger.add(entry);
+        }
+
+        const flight_detector::event evt = m_detector.update(entry, PERIOD);
+        if (evt != flight_detector::event::none)
+        {
+            m_detections.push_back({m_time, evt});
+        }
+        if (evt == flight_detector::event::takeoff)
+        {
+            m_pretrigger_start = m_time + 1u - static_cast<uint32_t>(m_pretrigger.get_count());
+            m_pretrigger.clear();
+        }
+        m_time++;
+    }
+};
+
+/** @brief Report a detection delay */
+static void report_delay(const char* name, uint32_t delay)
+{
+    test::report_result(name, (delay == UINT32_MAX) ? -1. : static_cast<double>(delay), "s");
+}
+
+OV_TEST(flight_detector, paraglider_flight)
+{
+    uint32_t max_takeoff_delay = 0u;
+    uint32_t max_landing_delay = 0u;
+    uint32_t min_margin        = UINT32_MAX;
+    double   takeoff_delays    = 0.;
+    double   landing_delays    = 0.;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        // Device switched on at the takeoff, wing preparation, takeoff, 40 minutes of thermal flight with 2 minutes
+        // of calm ridge soaring without ground speed, landing then rest
+        replay r(0xF17E0000u + i);
+        r.rest(600u);
+        r.walk(180u);
+        r.rest(60u);
+        const uint32_t run_start = r.get_time();
+        r.takeoff_run(6u, 8.f);
+        r.fly(1800u, 9.f, 150.f);
+        r.hover(120u);
+        r.fly(600u, 9.f, 150.f);
+        r.touchdown(9.f);
+        const uint32_t landing = r.get_time();
+        r.rest(300u);
+
+        // A single flight, the takeoff run is in the pretrigger buffer : the calm ridge soaring does not land the glider since
+        // any sample out of the landing conditions restarts the landing duration, which also lets a GNSS multipath spike
+        // or a pressure gust delay the landing on the ground
+        const uint32_t takeoff_delay = r.get_delay(run_start, flight_detector::event::takeoff);
+        const uint32_t landing_delay = r.get_delay(landing, flight_detector::event::landing);
+        OV_CHECK_EQ(r.count(flight_detector::event::takeoff), 1u);
+        OV_CHECK_EQ(r.count(flight_detector::event::landing), 1u);
+        OV_CHECK(takeoff_delay <= ((flight_detector::TAKEOFF_DURATION / PERIOD) + 10u));
+        OV_CHECK(r.get_pretrigger_start() <= run_start);
+        OV_CHECK(landing_delay >= (flight_detector::LANDING_DURATION / PERIOD));
+        OV_CHECK(landing_delay <= (3u * flight_detector::LANDING_DURATION / PERIOD));
+
+        const uint32_t margin = run_start - r.get_pretrigger_start();
+        max_takeoff_delay     = (takeoff_delay > max_takeoff_delay) ? takeoff_delay : max_takeoff_delay;
+        max_landing_delay     = (landing_delay > max_landing_delay) ? landing_delay : max_landing_delay;
+        min_margin            = (margin < min_margin) ? margin : min_margin;
+        takeoff_delays += takeoff_delay;
+        landing_delays += landing_delay;
+    }
+    test::report_result("mean takeoff delay", takeoff_delays / FLIGHT_COUNT, "s");
+    test::report_result("max takeoff delay", max_takeoff_delay, "s");
+    test::report_result("mean landing delay", landing_delays / FLIGHT_COUNT, "s");
+    test::report_result("max landing delay", max_landing_delay, "s");
+    test::report_result("min pretrigger margin before the run", min_margin, "s");
+}
+
+OV_TEST(flight_detector, landing_then_packing)
+{
+    // The pilot starts packing 30 seconds after the touchdown : the landing is only detected once the device is at rest,
+    // walking back to the car does not trigger a takeoff
+    replay r(0xF17E0002u);
+    r.rest(300u);
+    r.takeoff_run(6u, 8.f);
+    r.fly(1200u, 9.f, 150.f);
+    r.touchdown(9.f);
+    const uint32_t landing = r.get_time();
+    r.rest(30u);
+    r.walk(240u);
+    const uint32_t packed = r.get_time();
+    r.rest(120u);
+    r.walk(1200u);
+    r.rest(600u);
+
+    const uint32_t landing_delay = r.get_delay(landing, flight_detector::event::landing);
+    OV_CHECK_EQ(r.count(flight_detector::event::takeoff), 1u);
+    OV_CHECK_EQ(r.count(flight_detector::event::landing), 1u);
+    OV_CHECK(r.get_delay(packed, flight_detector::event::landing) <= ((flight_detector::LANDING_DURATION / PERIOD) + 10u));
+    report_delay("landing delay", landing_delay);
+}
+
+OV_TEST(flight_detector, strong_wind_launch)
+{
+    // Launch into a wind almost as strong as the trim speed : the ground speed stays below the takeoff speed and the bumpy
+    // ridge lift does not give a steady vertical speed, the takeoff is detected from the height gained over the launch
+    // and the takeoff run is still in the pretrigger buffer
+    uint32_t max_takeoff_delay = 0u;
+    uint32_t min_margin        = UINT32_MAX;
+    for (uint32_t i = 0u; i < FLIGHT_COUNT; i++)
+    {
+        replay r(0xF17E0300u + i);
+        r.rest(300u);
+        const uint32_t run_start = r.get_time();
+        r.takeoff_run(3u, 2.5f);
+        r.soar(300u, 2.f, 0.8f);
+        r.fly(1200u, 9.f, 150.f);
+        r.touchdown(9.f);
+        r.rest(300u);
+
+        const uint32_t takeoff_delay = r.get_delay(run_start, flight_detector::event::takeoff);
+        OV_CHECK_EQ(r.count(flight_detector::event::takeoff), 1u);
+        OV_CHECK_EQ(r.count(flight_detector::event::landing), 1u);
+        OV_CHECK(r.get_pretrigger_start() <= run_start);
+
+        const uint32_t margin = run_start - r.get_pretrigger_start();
+        max_takeoff_delay     = (takeoff_delay > max_takeoff_delay) ? takeoff_delay : max_takeoff_delay;
+        min_margin            = (margin < min_margin) ? margin : min_margin;
+    }
+    test::report_result("max takeoff delay", max_takeoff_delay, "s");
+    test::report_result("min pretrigger margin before the run", min_margin, "s");
+}
+
+OV_TEST(flight_detector, ground_day)
+{
+    // Whole days on the ground with the device switched on : at rest with GNSS multipath and pressure gusts, carried around,
+    // hiking up to a launch and back down
+    size_t takeoffs = 0u;
+    for (uint32_t day = 0u; day < GROUND_DAY_COUNT; day++)
+    {
+        replay r(0x6A0D0000u + day);
+        for (uint32_t hour = 0u; hour < GROUND_DAY_HOURS; hour++)
+        {
+            r.rest(2400u);
+            r.walk(600u);
+            r.hike(300u, 0.25f);
+            r.hike(300u, -0.25f);
+        }
+        takeoffs += r.count(flight_detector::event::takeoff);
+    }
+    OV_CHECK_EQ(takeoffs, 0u);
+    test::report_result("replayed hours on the ground", GROUND_DAY_COUNT * GROUND_DAY_HOURS, "h");
+    test::report_result("false takeoffs", takeoffs, "");
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_catalog.h"
+#include "flight_drive.h"
+#include "fs.h"
+#include "host_fs.h"
+#include "i_flight_recorder.h"
+#include "igc_converter.h"
+#include "ov_test.h"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace ov;
+
+/** @brief Image of the volume, checked afterwards by an independent FAT reader (see tests/tools/check_fat16_image.py) */
+static constexpr const char* IMAGE_FILE = "flight_drive.img";
+
+/** @brief Directory receiving the expected contents of the files of the volume */
+static constexpr const char* EXPECTED_DIR = "flight_drive_expected";
+
+/** @brief Size of a sector of the volume in bytes */
+static constexpr uint32_t SECTOR_SIZE = i_usb_msc::BLOCK_SIZE;
+
+/** @brief Number of sectors read at once from the volume */
+static constexpr uint32_t SECTORS_PER_READ = 64u;
+
+/** @brief Get an empty filesystem with the flight directory */
+static bool init_fs()
+{
+    return (test::format_host_fs() && fs::mkdir(i_flight_recorder::RECORDED_DATA_DIR));
+}
+
+/** @brief Write a flight file with a straight climb towards the north-east */
+static bool write_flight(const char* name, const date_time& timestamp, uint16_t period, size_t entry_count)
+{
+    char path[64u];
+    snprintf(path, sizeof(path), "%s/%s", i_flight_recorder::RECORDED_DATA_DIR, name);
+
+    flight_file::header header = {};
+    header.timestamp           = timestamp;
+    header.period              = period;
+    strcpy(header.glider, "Test glider");
+
+    flight_file flight(path, header);
+    bool        ret = flight.is_open();
+    for (size_t i = 0u; ret && (i < entry_count); i++)
+    {
+        flight_file::entry e = {};
+        e.latitude           = 45.2 + static_cast<double>(i) * 0.0001;
+        e.longitude          = 5.7 + static_cast<double>(i) * 0.0001;
+        e.speed              = 100u;
+        e.gnss_altitude      = 10000u + static_cast<uint32_t>(i);
+        e.pressure           = 90000;
+        e.altitude           = 10000 + static_cast<int32_t>(i);
+        e.temperature        = 200;
+        e.total_accel        = 1000;
+        e.gnss_is_valid      = true;
+        e.alti_is_valid      = true;
+        e.accel_is_valid     = true;
+        ret                  = flight.write(e);
+    }
+    flight_stats stats = {};
+    ret                = flight.close(stats) && ret;
+    return ret;
+}
+
+/** @brief Read the whole IGC file of a flight */
+static size_t read_igc(const char* name, char* buffer, size_t size)
+{
+    char path[64u];
+    snprintf(path, sizeof(path), "%s/%s", i_flight_recorder::RECORDED_DATA_DIR, name);
+
+    size_t        igc_size = 0u;
+    flight_file   flight(path);
+    igc_converter igc(flight);
+    if (flight.is_open() && igc.init() && (igc.get_size() <= size) && igc.read(0u, buffer, igc.get_size()))
+    {
+        igc_size = igc.get_size();
+    }
+    return igc_size;
+}
+
+/** @brief Get the time of the n-th B record of an IGC file as HHMMSS */
+static const char* get_b_record_time(const char* igc, size_t index, char (&time)[7u])
+{
+    const char* record = strstr(igc, "\r\nB");
+    for (size_t i = 0u; (record != nullptr) && (i < index); i++)
+    {
+        record = strstr(record + 2u, "\r\nB");
+    }
+    time[0u] = 0;
+    if (record != nullptr)
+    {
+        memcpy(time, record + 3u, 6u);
+        time[6u] = 0;
+    }
+    return time;
+}
+
+/** @brief Get a little endian 16-bit value of the volume */
+static uint32_t get_u16(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0u]) | (static_cast<uint32_t>(data[1u]) << 8u);
+}
+
+/** @brief Get a little endian 32-bit value of the volume */
+static uint32_t get_u32(const uint8_t* data)
+{
+    return get_u16(data) | (get_u16(&data[2u]) << 16u);
+}
+
+/** @brief Write a file of the host */
+static bool write_host_file(const char* path, const void* data, size_t size)
+{
+    bool  ret = false;
+    FILE* f   = fopen(path, "wb");
+    if (f != nullptr)
+    {
+        ret = (fwrite(data, 1u, size, f) == size);
+        ret = (fclose(f) == 0) && ret;
+    }
+    return ret;
+}
+
+/** @brief Write the expected contents of the files of a flight */
+static bool write_expected_files(const flight_catalog::summary& summary)
+{
+    static uint8_t contents[256u * 1024u];
+
+    // Flight file
+    char path[128u];
+    snprintf(path, sizeof(path), "%s/%s", i_flight_recorder::RECORDED_DATA_DIR, summary.name);
+    file   rec      = fs::open(path, fs::o_rdonly);
+    size_t rec_size = 0u;
+    bool   ret      = rec.is_open() && rec.read(contents, sizeof(contents), rec_size);
+    snprintf(path, sizeof(path), "%s/%s", EXPECTED_DIR, summary.name);
+    ret = ret && write_host_file(path, contents, rec_size);
+
+    // IGC file, same name with the IGC extension
+    char   igc_name[32u];
+    size_t length = strlen(summary.name) - strlen(i_flight_recorder::RECORDED_DATA_EXT);
+    snprintf(igc_name, sizeof(igc_name), "%.*s.igc", static_cast<int>(length), summary.name);
+    size_t igc_size = read_igc(summary.name, reinterpret_cast<char*>(contents), sizeof(contents));
+    snprintf(path, sizeof(path), "%s/%s", EXPECTED_DIR, igc_name);
+    ret = ret && (igc_size != 0u) && write_host_file(path, contents, igc_size);
+
+    return ret;
+}
+
+/** @brief Dump the volume into a sparse image file */
+static bool write_image(flight_drive& drive)
+{
+    static uint8_t sectors[SECTORS_PER_READ * SECTOR_SIZE];
+
+    FILE* image = fopen(IMAGE_FILE, "wb");
+    bool  ret   = (image != nullptr);
+    for (uint32_t block = 0u; ret && (block < drive.get_block_count()); block += SECTORS_PER_READ)
+    {
+        const uint32_t remaining = drive.get_block_count() - block;
+        const uint32_t count     = (remaining < SECTORS_PER_READ) ? remaining : SECTORS_PER_READ;
+        ret                      = drive.read(block, sectors, count);
+
+        // Only the non-empty sectors are written, the last ones set the size of the image
+        bool is_empty = true;
+        for (size_t i = 0u; is_empty && (i < (count * SECTOR_SIZE)); i++)
+        {
+            is_empty = (sectors[i] == 0u);
+        }
+        if (ret && (!is_empty || (count == remaining)))
+        {
+            ret = (fseek(image, static_cast<long>(block) * static_cast<long>(SECTOR_SIZE), SEEK_SET) == 0) &&
+                  (fwrite(sectors, SECTOR_SIZE, count, image) == count);
+        }
+    }
+    if (image != nullptr)
+    {
+        ret = (fclose(image) == 0) && ret;
+    }
+    return ret;
+}
+
+OV_TEST(flight_drive, volume_image)
+{
+    OV_CHECK(init_fs());
+
+    // Long flight spanning many clusters, automatically started flight backdated before midnight,
+    // flight without GNSS date and flight without any entry
+    const date_time long_start      = {23u, 7u, 14u, 10u, 2u, 3u, 0u};
+    date_time       backdated_start = {24u, 3u, 1u, 0u, 1u, 0u, 0u};
+    const date_time no_gnss_start   = {};
+    backdated_start.subtract(120u * 1000u);
+    OV_CHECK(write_flight("2023-07-14T10-02-03.rec", long_start, 1000u, 1500u));
+    OV_CHECK(write_flight("2024-03-01T00-01-00.rec", backdated_start, 1000u, 200u));
+    OV_CHECK(write_flight("012345.rec", no_gnss_start, 500u, 3u));
+    OV_CHECK(write_flight("000042.rec", no_gnss_start, 1000u, 0u));
+    OV_CHECK(flight_catalog::rebuild());
+
+    flight_drive drive;
+    OV_CHECK(drive.init());
+
+    // Boot sector signature
+    uint8_t sector[SECTOR_SIZE];
+    OV_CHECK(drive.read(0u, sector, 1u));
+    OV_CHECK_EQ(sector[510u], 0x55u);
+    OV_CHECK_EQ(sector[511u], 0xAAu);
+
+    // Image and expected files for the FAT reader
+    mkdir(EXPECTED_DIR, 0755);
+    flight_catalog::reader catalog;
+    OV_CHECK(catalog.is_open());
+    OV_CHECK_EQ(catalog.get_count(), 4u);
+    for (size_t i = 0u; i < catalog.get_count(); i++)
+    {
+        flight_catalog::summary summary;
+        OV_CHECK(catalog.read(summary));
+        OV_CHECK(write_expected_files(summary));
+    }
+    OV_CHECK(write_image(drive));
+}
+
+OV_TEST(flight_drive, backdated_igc_start)
+{
+    OV_CHECK(init_fs());
+
+    // Automatic start at 00:01:00 with 120 entries of 1s from the pretrigger buffer : the first entry is at 23:59:00 the day before
+    date_time start = {24u, 3u, 1u, 0u, 1u, 0u, 0u};
+    start.subtract(120u * 1000u);
+    OV_CHECK(write_flight("2024-03-01T00-01-00.rec", start, 1000u, 200u));
+
+    static char igc[64u * 1024u];
+    size_t      size = read_igc("2024-03-01T00-01-00.rec", igc, sizeof(igc) - 1u);
+    OV_CHECK(size != 0u);
+    igc[size] = 0;
+
+    // Date of the first entry, B records from the first entry and across midnight
+    char time[7u];
+    OV_CHECK(strstr(igc, "HFDTEDATE:290224,01\r\n") != nullptr);
+    OV_CHECK(strcmp(get_b_record_time(igc, 0u, time), "235900") == 0);
+    OV_CHECK(strcmp(get_b_record_time(igc, 59u, time), "235959") == 0);
+    OV_CHECK(strcmp(get_b_record_time(igc, 60u, time), "000000") == 0);
+    OV_CHECK(strcmp(get_b_record_time(igc, 120u, time), "000100") == 0);
+}
+
+OV_TEST(flight_drive, rec_sectors_past_eof)
+{
+    OV_CHECK(init_fs());
+
+    // Flight file ending in the middle of its first cluster
+    OV_CHECK(write_flight("2023-07-14T10-02-03.rec", {23u, 7u, 14u, 10u, 2u, 3u, 0u}, 1000u, 40u));
+    OV_CHECK(flight_catalog::rebuild());
+
+    static uint8_t contents[64u * 1024u];
+    char           path[64u];
+    snprintf(path, sizeof(path), "%s/%s", i_flight_recorder::RECORDED_DATA_DIR, "2023-07-14T10-02-03.rec");
+    file   rec      = fs::open(path, fs::o_rdonly);
+    size_t rec_size = 0u;
+    OV_CHECK(rec.is_open() && rec.read(contents, sizeof(contents), rec_size));
+
+    flight_drive drive;
+    OV_CHECK(drive.init());
+
+    // Volume layout from the boot sector
+    uint8_t sector[SECTOR_SIZE];
+    OV_CHECK(drive.read(0u, sector, 1u));
+    const uint32_t sectors_per_cluster = sector[13u];
+    const uint32_t reserved_sectors    = get_u16(&sector[14u]);
+    const uint32_t fat_count           = sector[16u];
+    const uint32_t root_entries        = get_u16(&sector[17u]);
+    const uint32_t fat_sectors         = get_u16(&sector[22u]);
+    const uint32_t root_start          = reserved_sectors + fat_count * fat_sectors;
+    const uint32_t data_start          = root_start + (root_entries * 32u) / SECTOR_SIZE;
+
+    // Short file name entry of the flight file
+    uint32_t cluster = 0u;
+    uint32_t size    = 0u;
+    for (uint32_t s = root_start; (cluster == 0u) && (s < data_start); s++)
+    {
+        OV_CHECK(drive.read(s, sector, 1u));
+        for (uint32_t i = 0u; i < SECTOR_SIZE; i += 32u)
+        {
+            if (memcmp(&sector[i], "FLT00001REC", 11u) == 0)
+            {
+                cluster = get_u16(&sector[i + 26u]);
+                size    = get_u32(&sector[i + 28u]);
+            }
+        }
+    }
+    OV_CHECK(cluster >= 2u);
+    OV_CHECK_EQ(size, rec_size);
+    OV_CHECK((size % (sectors_per_cluster * SECTOR_SIZE)) < ((sectors_per_cluster - 1u) * SECTOR_SIZE));
+
+    // Each sector of the cluster read alone : the file contents then zeros up to the end of the cluster
+    uint32_t past_eof = 0u;
+    for (uint32_t i = 0u; i < sectors_per_cluster; i++)
+    {
+        const uint32_t offset = i * SECTOR_SIZE;
+        memset(sector, 0xA5, sizeof(sector));
+        OV_CHECK(drive.read(data_start + (cluster - 2u) * sectors_per_cluster + i, sector, 1u));
+        bool is_expected = true;
+        for (uint32_t j = 0u; j < SECTOR_SIZE; j++)
+        {
+            const uint8_t expected = ((offset + j) < size) ? contents[offset + j] : 0u;
+            is_expected            = is_expected && (sector[j] == expected);
+        }
+        OV_CHECK(is_expected);
+        past_eof += (offset >= size) ? 1u : 0u;
+    }
+    OV_CHECK(past_eof != 0u);
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_YACSGL_STUB_H
+#define OV_YACSGL_STUB_H
+
+#include <cstdint>
+
+/**
+ * @brief Host replacement of the YACSGL graphic library
+ *        Frames use the vertical byte organization of the display (bit n of a byte = row n of its page)
+ *        and every pixel write is counted to measure the drawing cost of a frame
+ */
+
+/** @brief Pixel colors */
+typedef enum
+{
+    /** @brief Pixel off */
+    YACSGL_P_BLACK = 0,
+    /** @brief Pixel on */
+    YACSGL_P_WHITE = 1
+} YACSGL_pixel_t;
+
+/** @brief Frame */
+typedef struct
+{
+    /** @brief Width in pixels */
+    uint16_t frame_x_width;
+    /** @brief Height in pixels */
+    uint16_t frame_y_heigth;
+    /** @brief Unused */
+    uint16_t frame_x_offset;
+    /** @brief Unused */
+    uint16_t frame_y_offset;
+    /** @brief Frame buffer */
+    uint8_t* frame_buffer;
+} YACSGL_frame_t;
+
+/** @brief Fixed size font */
+typedef struct
+{
+    /** @brief Width of a character in pixels */
+    uint16_t char_width;
+    /** @brief Height of a character in pixels */
+    uint16_t char_height;
+} YACSGL_font_t;
+
+namespace ov
+{
+namespace test
+{
+
+/** @brief Number of pixel writes since the last reset */
+inline uint32_t& yacsgl_pixel_writes()
+{
+    static uint32_t count = 0u;
+    return count;
+}
+
+} // namespace test
+} // namespace ov
+
+/** @brief Set a pixel, pixels outside the frame are ignored */
+inline void YACSGL_set_pixel(YACSGL_frame_t* frame, uint16_t x, uint16_t y, YACSGL_pixel_t pixel)
+{
+    if ((x < frame->frame_x_width) && (y < frame->frame_y_heigth))
+    {
+        uint8_t&      byte = frame->frame_buffer[(y / 8u) * frame->frame_x_width + x];
+        const uint8_t mask = static_cast<uint8_t>(1u << (y % 8u));
+        if (pixel == YACSGL_P_WHITE)
+        {
+            byte = static_cast<uint8_t>(byte | mask);
+        }
+        else
+        {
+            byte = static_cast<uint8_t>(byte & ~mask);
+        }
+        ov::test::yacsgl_pixel_writes()++;
+    }
+}
+
+/** @brief Fill a rectangle, the corners are included */
+inline void YACSGL_rect_fill(YACSGL_frame_t* frame, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, YACSGL_pixel_t pixel)
+{
+    for (uint32_t y = y0; y <= y1; y++)
+    {
+        for (uint32_t x = x0; x <= x1; x++)
+        {
+            YACSGL_set_pixel(frame, static_cast<uint16_t>(x), static_cast<uint16_t>(y), pixel);
+        }
+    }
+}
+
+/**
+ * @brief Draw a text, the glyphs are a pattern which depends on the character code
+ *        and which covers the whole character cell so that any overlap is visible
+ */
+inline void YACSGL_text(YACSGL_frame_t* frame, uint16_t x, uint16_t y, const YACSGL_font_t* font, const char* text, YACSGL_pixel_t pixel)
+{
+    while (*text != 0)
+    {
+        const uint32_t c = static_cast<uint8_t>(*text);
+        for (uint32_t row = 0u; row < font->char_height; row++)
+        {
+            for (uint32_t col = 0u; col < font->char_width; col++)
+            {
+                if ((c != ' ') && (((c * 31u + col * 7u + row * 13u) % 5u) < 2u))
+                {
+                    YACSGL_set_pixel(frame, static_cast<uint16_t>(x + col), static_cast<uint16_t>(y + row), pixel);
+                }
+            }
+        }
+        x = static_cast<uint16_t>(x + font->char_width);
+        text++;
+    }
+}
+
+#endif // OV_YACSGL_STUB_H
@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_YACSGL_FONT_5X7_STUB_H
+#define OV_YACSGL_FONT_5X7_STUB_H
+
+#include "YACSGL.h"
+
+/** @brief Small font */
+inline const YACSGL_font_t YACSGL_font_5x7 = {5u, 7u};
+
+#endif // OV_YACSGL_FONT_5X7_STUB_H
@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_YACSGL_FONT_8X16_STUB_H
+#define OV_YACSGL_FONT_8X16_STUB_H
+
+#include "YACSGL.h"
+
+/** @brief Default font of the labels */
+inline const YACSGL_font_t YACSGL_font_8x16 = {8u, 16u};
+
+#endif // OV_YACSGL_FONT_8X16_STUB_H
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_YACSWL_STUB_H
+#define OV_YACSWL_STUB_H
+
+#include "YACSGL.h"
+#include "YACSGL_font_8x16.h"
+
+#include <cstring>
+
+/**
+ * @brief Host replacement of the YACSWL widget library
+ *        Positions are relative to the parent widget, sizes are the offset of the last pixel
+ *        (a widget covers [x, x + width] x [y, y + height])
+ */
+
+/** @brief Widget */
+typedef struct _YACSWL_widget_t
+{
+    /** @brief X position relative to the parent */
+    uint16_t x;
+    /** @brief Y position relative to the parent */
+    uint16_t y;
+    /** @brief Width */
+    uint16_t width;
+    /** @brief Height */
+    uint16_t height;
+    /** @brief Border width */
+    uint16_t border_width;
+    /** @brief Margin */
+    uint16_t margin;
+    /** @brief Indicate if the widget is displayed */
+    bool displayed;
+    /** @brief Foreground color */
+    YACSGL_pixel_t foreground_color;
+    /** @brief Background color */
+    YACSGL_pixel_t background_color;
+    /** @brief Parent widget */
+    struct _YACSWL_widget_t* parent;
+    /** @brief First child widget */
+    struct _YACSWL_widget_t* first_child;
+    /** @brief Next sibling widget */
+    struct _YACSWL_widget_t* next_sibling;
+    /** @brief Draw the contents of the widget at the given absolute position */
+    void (*draw_contents)(struct _YACSWL_widget_t* widget, YACSGL_frame_t* frame, uint16_t x, uint16_t y);
+    /** @brief Compute the size of the widget from its contents */
+    void (*update_size)(struct _YACSWL_widget_t* widget);
+} YACSWL_widget_t;
+
+/** @brief Label */
+typedef struct
+{
+    /** @brief Widget, must be the first member */
+    YACSWL_widget_t widget;
+    /** @brief Text */
+    const char* text;
+    /** @brief Font */
+    const YACSGL_font_t* font;
+} YACSWL_label_t;
+
+/** @brief Initialize a widget */
+inline void YACSWL_widget_init(YACSWL_widget_t* widget)
+{
+    memset(widget, 0, sizeof(YACSWL_widget_t));
+    widget->border_width     = 1u;
+    widget->displayed        = true;
+    widget->foreground_color = YACSGL_P_BLACK;
+    widget->background_color = YACSGL_P_WHITE;
+}
+
+/** @brief Compute the size of a widget from its contents */
+inline void YACSWL_widget_update_size(YACSWL_widget_t* widget)
+{
+    if (widget->update_size != nullptr)
+    {
+        widget->update_size(widget);
+    }
+}
+
+/** @brief Set the position of a widget relative to its parent */
+inline void YACSWL_widget_set_pos(YACSWL_widget_t* widget, uint16_t x, uint16_t y)
+{
+    widget->x = x;
+    widget->y = y;
+}
+
+/** @brief Set the size of a widget */
+inline void YACSWL_widget_set_size(YACSWL_widget_t* widget, uint16_t width, uint16_t height)
+{
+    widget->width  = width;
+    widget->height = height;
+}
+
+/** @brief Set the border width of a widget */
+inline void YACSWL_widget_set_border_width(YACSWL_widget_t* widget, uint16_t border_width)
+{
+    widget->border_width = border_width;
+    YACSWL_widget_update_size(widget);
+}
+
+/** @brief Set the margins of a widget, only the left one is used for all sides */
+inline void YACSWL_widget_set_margins(YACSWL_widget_t* widget, uint16_t left, uint16_t, uint16_t, uint16_t)
+{
+    widget->margin = left;
+    YACSWL_widget_update_size(widget);
+}
+
+/** @brief Show or hide a widget */
+inline void YACSWL_widget_set_displayed(YACSWL_widget_t* widget, bool displayed)
+{
+    widget->displayed = displayed;
+}
+
+/** @brief Set the foreground color of a widget and of its children */
+inline void YACSWL_widget_set_foreground_color(YACSWL_widget_t* widget, YACSGL_pixel_t color)
+{
+    widget->foreground_color = color;
+    for (YACSWL_widget_t* child = widget->first_child; child != nullptr; child = child->next_sibling)
+    {
+        YACSWL_widget_set_foreground_color(child, color);
+    }
+}
+
+/** @brief Set the background color of a widget and of its children */
+inline void YACSWL_widget_set_background_color(YACSWL_widget_t* widget, YACSGL_pixel_t color)
+{
+    widget->background_color = color;
+    for (YACSWL_widget_t* child = widget->first_child; child != nullptr; child = child->next_sibling)
+    {
+        YACSWL_widget_set_background_color(child, color);
+    }
+}
+
+/** @brief Get the X position of a widget relative to its parent */
+inline uint16_t YACSWL_widget_get_pos_x(YACSWL_widget_t* widget)
+{
+    return widget->x;
+}
+
+/** @brief Get the Y position of a widget relative to its parent */
+inline uint16_t YACSWL_widget_get_pos_y(YACSWL_widget_t* widget)
+{
+    return widget->y;
+}
+
+/** @brief Get the width of a widget */
+inline uint16_t YACSWL_widget_get_width(YACSWL_widget_t* widget)
+{
+    return widget->width;
+}
+
+/** @brief Get the height of a widget */
+inline uint16_t YACSWL_widget_get_height(YACSWL_widget_t* widget)
+{
+    return widget->height;
+}
+
+/** @brief Add a child widget, children are drawn in the order they have been added */
+inline void YACSWL_widget_add_child(YACSWL_widget_t* parent, YACSWL_widget_t* child)
+{
+    YACSWL_widget_t** last = &parent->first_child;
+    while (*last != nullptr)
+    {
+        last = &(*last)->next_sibling;
+    }
+    *last         = child;
+    child->parent = parent;
+}
+
+/** @brief Draw a widget and its children at the given absolute position */
+inline void YACSWL_widget_draw_at(YACSWL_widget_t* widget, YACSGL_frame_t* frame, uint16_t x, uint16_t y)
+{
+    if (widget->displayed)
+    {
+        // Background, border and contents
+        YACSGL_rect_fill(frame, x, y, x + widget->width, y + widget->height, widget->background_color);
+        for (uint16_t i = 0u; i < widget->border_width; i++)
+        {
+            YACSGL_rect_fill(frame, x + i, y + i, x + widget->width - i, y + i, widget->foreground_color);
+            YACSGL_rect_fill(frame, x + i, y + widget->height - i, x + widget->width - i, y + widget->height - i, widget->foreground_color);
+            YACSGL_rect_fill(frame, x + i, y + i, x + i, y + widget->height - i, widget->foreground_color);
+            YACSGL_rect_fill(frame, x + widget->width - i, y + i, x + widget->width - i, y + widget->height - i, widget->foreground_color);
+        }
+        if (widget->draw_contents != nullptr)
+        {
+            widget->draw_contents(widget, frame, x, y);
+        }
+
+        // Children
+        for (YACSWL_widget_t* child = widget->first_child; child != nullptr; child = child->next_sibling)
+        {
+            YACSWL_widget_draw_at(child, frame, x + child->x, y + child->y);
+        }
+    }
+}
+
+/** @brief Draw a widget and its children */
+inline void YACSWL_widget_draw(YACSWL_widget_t* widget, YACSGL_frame_t* frame)
+{
+    uint16_t x = widget->x;
+    uint16_t y = widget->y;
+    for (YACSWL_widget_t* parent = widget->parent; parent != nullptr; parent = parent->parent)
+    {
+        x = static_cast<uint16_t>(x + parent->x);
+        y = static_cast<uint16_t>(y + parent->y);
+    }
+    YACSWL_widget_draw_at(widget, frame, x, y);
+}
+
+/** @brief Draw the text of a label */
+inline void YACSWL_label_draw_contents(YACSWL_widget_t* widget, YACSGL_frame_t* frame, uint16_t x, uint16_t y)
+{
+    YACSWL_label_t* label  = reinterpret_cast<YACSWL_label_t*>(widget);
+    const uint16_t  offset = static_cast<uint16_t>(widget->border_width + widget->margin);
+    YACSGL_text(frame, x + offset, y + offset, label->font, label->text, widget->foreground_color);
+}
+
+/** @brief Compute the size of a label from its text */
+inline void YACSWL_label_update_size(YACSWL_widget_t* widget)
+{
+    YACSWL_label_t* label = reinterpret_cast<YACSWL_label_t*>(widget);
+    const size_t    count = strlen(label->text);
+    const size_t    extra = 2u * (widget->border_width + widget->margin);
+    const size_t    width = count * label->font->char_width + extra;
+    widget->width         = static_cast<uint16_t>((width != 0u) ? (width - 1u) : 0u);
+    widget->height        = static_cast<uint16_t>(label->font->char_height + extra - 1u);
+}
+
+/** @brief Initialize a label */
+inline void YACSWL_label_init(YACSWL_label_t* label)
+{
+    YACSWL_widget_init(&label->widget);
+    label->text                 = "";
+    label->font                 = &YACSGL_font_8x16;
+    label->widget.draw_contents = &YACSWL_label_draw_contents;
+    label->widget.update_size   = &YACSWL_label_update_size;
+    YACSWL_label_update_size(&label->widget);
+}
+
+/** @brief Set the text of a label */
+inline void YACSWL_label_set_text(YACSWL_label_t* label, const char* text)
+{
+    label->text = text;
+    YACSWL_label_update_size(&label->widget);
+}
+
+/** @brief Set the font of a label */
+inline void YACSWL_label_set_font(YACSWL_label_t* label, const YACSGL_font_t* font)
+{
+    label->font = font;
+    YACSWL_label_update_size(&label->widget);
+}
+
+#endif // OV_YACSWL_STUB_H
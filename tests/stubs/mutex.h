@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_MUTEX_H
+#define OV_MUTEX_H
+
+#include <mutex>
+
+namespace ov
+{
+
+/** @brief Host replacement of the RTOS mutex wrapper */
+class mutex
+{
+  public:
+    /** @brief Constructor */
+    mutex() : m_mutex() { }
+    /** @brief Copy constructor */
+    mutex(const mutex& copy) = delete;
+    /** @brief Move constructor */
+    mutex(mutex&& move) = delete;
+
+    /** @brief Destructor */
+    virtual ~mutex() { }
+
+    /** @brief Copy operator */
+    mutex& operator=(mutex& copy) = delete;
+
+    /** @brief Lock the mutex */
+    void lock() { m_mutex.lock(); }
+    /** @brief Unlock the mutex */
+    void unlock() { m_mutex.unlock(); }
+
+  private:
+    /** @brief Host mutex */
+    std::mutex m_mutex;
+};
+
+} // namespace ov
+
+#endif // OV_MUTEX_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef OV_RAM_STORAGE_MEMORY_H
+#define OV_RAM_STORAGE_MEMORY_H
+
+#include "i_storage_memory.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace ov
+{
+
+/** @brief Storage memory in RAM with the erase semantic of a NOR flash */
+template <size_t SIZE, size_t BLOCK_SIZE>
+class ram_storage_memory : public i_storage_memory
+{
+  public:
+    /** @brief Constructor */
+    ram_storage_memory() : m_read_bytes(0u) { memset(m_memory, 0xFF, sizeof(m_memory)); }
+
+    /** @brief Get the memory size in bytes */
+    size_t get_size() override { return SIZE; }
+
+    /** @brief Get the erase block size in bytes */
+    size_t get_block_size() override { return BLOCK_SIZE; }
+
+    /** @brief Reset the memory */
+    bool reset() override { return true; }
+
+    /** @brief Read data from the memory */
+    bool read(size_t address, void* buffer, size_t size) override
+    {
+        bool ret = ((address + size) <= SIZE);
+        if (ret)
+        {
+            memcpy(buffer, &m_memory[address], size);
+            m_read_bytes += size;
+        }
+        return ret;
+    }
+
+    /** @brief Write data to the memory, bits can only be cleared as on a NOR flash */
+    bool write(size_t address, const void* buffer, size_t size) override
+    {
+        bool ret = ((address + size) <= SIZE);
+        if (ret)
+        {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer);
+            for (size_t i = 0u; i < size; i++)
+            {
+                m_memory[address + i] &= data[i];
+            }
+        }
+        return ret;
+    }
+
+    /** @brief Erase a block */
+    bool erase(size_t block) override
+    {
+        bool ret = (block < (SIZE / BLOCK_SIZE));
+        if (ret)
+        {
+            memset(&m_memory[block * BLOCK_SIZE], 0xFF, BLOCK_SIZE);
+        }
+        return ret;
+    }
+
+    /** @brief Get the number of bytes read from the memory since its creation */
+    size_t get_read_bytes() const { return m_read_bytes; }
+
+  private:
+    /** @brief Number of bytes read from the memory */
+    size_t m_read_bytes;
+    /** @brief Memory contents */
+    uint8_t m_memory[SIZE];
+};
+
+} // namespace ov
+
+#endif // OV_RAM_STORAGE_MEMORY_H
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "fs.h"
+#include "host_fs.h"
+#include "ov_test.h"
+#include "terrain_cache.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace ov;
+
+/** @brief Number of sample intervals per degree of the generated tiles (3 arc-seconds as SRTM3) */
+static constexpr uint16_t SAMPLES_PER_DEGREE = 1200u;
+
+/** @brief Number of sample intervals on each side of a block, same as the tile converter */
+static constexpr uint16_t BLOCK_SIZE = 40u;
+
+/** @brief Number of blocks on each side of a tile */
+static constexpr uint16_t BLOCKS_PER_SIDE = SAMPLES_PER_DEGREE / BLOCK_SIZE;
+
+/** @brief Number of samples on each side of a block */
+static constexpr size_t BLOCK_STRIDE = BLOCK_SIZE + 1u;
+
+/** @brief Number of lookups of the benchmarks */
+static constexpr uint32_t BENCH_ITERATIONS = 1000000u;
+
+/** @brief Number of encoded blocks of a tile */
+struct tile_encoding
+{
+    /** @brief Number of raw blocks */
+    uint32_t raw_blocks;
+    /** @brief Number of delta encoded blocks */
+    uint32_t delta_blocks;
+    /** @brief Size of the tile in bytes */
+    size_t size;
+};
+
+/**
+ * @brief Generated elevation sample of a tile, rows from north to south and columns from west to east
+ *        Real DEM data is not available offline : smooth relief with a cliff crossing the tile,
+ *        and a rough area in the north west quarter where the delta encoding is not worth it
+ */
+static int16_t dem_sample(int16_t latitude, int16_t longitude, uint32_t row, uint32_t column)
+{
+    const double lat       = latitude + 1. - static_cast<double>(row) / SAMPLES_PER_DEGREE;
+    const double lon       = longitude + static_cast<double>(column) / SAMPLES_PER_DEGREE;
+    double       elevation = 1500. + 1000. * std::sin(lat * 40.) * std::cos(lon * 30.);
+    if ((lon - longitude) > 0.5)
+    {
+        elevation += 300.;
+    }
+    if (((lat - latitude) > 0.75) && ((lon - longitude) < 0.25))
+    {
+        const uint32_t hash = (row * 2654435761u) ^ (column * 40503u);
+        elevation += static_cast<double>(hash % 801u) - 400.;
+    }
+    return static_cast<int16_t>(std::lround(elevation));
+}
+
+/** @brief Encode a block with the same rules as the tile converter (tools/ov-toolbox/ov_terrain.py) */
+static terrain_tile::encoding encode_block(const int16_t* samples, std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> delta;
+    for (size_t i = 0u; i < (BLOCK_STRIDE * BLOCK_STRIDE); i++)
+    {
+        int16_t reference = 0;
+        if (i != 0u)
+        {
+            reference = ((i % BLOCK_STRIDE) == 0u) ? samples[i - BLOCK_STRIDE] : samples[i - 1u];
+        }
+        const int32_t diff = samples[i] - reference;
+        if ((diff > terrain_tile::DELTA_ESCAPE) && (diff <= 127))
+        {
+            delta.push_back(static_cast<uint8_t>(diff));
+        }
+        else
+        {
+            delta.push_back(static_cast<uint8_t>(terrain_tile::DELTA_ESCAPE));
+            delta.push_back(static_cast<uint8_t>(samples[i] & 0xFF));
+            delta.push_back(static_cast<uint8_t>((samples[i] >> 8) & 0xFF));
+        }
+    }
+
+    terrain_tile::encoding enc = terrain_tile::encoding::delta;
+    if (delta.size() < (BLOCK_STRIDE * BLOCK_STRIDE * sizeof(int16_t)))
+    {
+        data = delta;
+    }
+    else
+    {
+        const uint8_t* raw = reinterpret_cast<const uint8_t*>(samples);
+        data.assign(raw, raw + BLOCK_STRIDE * BLOCK_STRIDE * sizeof(int16_t));
+        enc = terrain_tile::encoding::raw;
+    }
+    return enc;
+}
+
+/** @brief Get the samples of a block of a generated tile */
+static void get_block_samples(int16_t latitude, int16_t longitude, uint32_t block_index, int16_t* samples)
+{
+    const uint32_t first_row    = (block_index / BLOCKS_PER_SIDE) * BLOCK_SIZE;
+    const uint32_t first_column = (block_index % BLOCKS_PER_SIDE) * BLOCK_SIZE;
+    for (uint32_t i = 0u; i < (BLOCK_STRIDE * BLOCK_STRIDE); i++)
+    {
+        samples[i] = dem_sample(latitude, longitude, first_row + i / BLOCK_STRIDE, first_column + i % BLOCK_STRIDE);
+    }
+}
+
+/** @brief Write a generated tile : header, block table then block data */
+static bool write_tile(int16_t latitude, int16_t longitude, tile_encoding& encoding)
+{
+    char path[terrain_tile::MAX_PATH_SIZE];
+    terrain_tile::get_path(latitude, longitude, path);
+    file f   = fs::open(path, fs::o_creat | fs::o_trunc | fs::o_wronly);
+    bool ret = f.is_open();
+
+    const terrain_tile::header header = {terrain_tile::header::MAGIC_NUMBER,
+                                         terrain_tile::header::VERSION,
+                                         latitude,
+                                         longitude,
+                                         SAMPLES_PER_DEGREE,
+                                         BLOCK_SIZE,
+                                         BLOCKS_PER_SIDE};
+    ret                               = ret && f.write(header);
+
+    // Encode the blocks
+    const uint32_t                    block_count = BLOCKS_PER_SIDE * BLOCKS_PER_SIDE;
+    std::vector<std::vector<uint8_t>> blocks(block_count);
+    std::vector<int16_t>              samples(BLOCK_STRIDE * BLOCK_STRIDE);
+    uint32_t                          offset = static_cast<uint32_t>(sizeof(header) + block_count * sizeof(terrain_tile::block_desc));
+    encoding                                 = {};
+    for (uint32_t i = 0u; ret && (i < block_count); i++)
+    {
+        get_block_samples(latitude, longitude, i, samples.data());
+        terrain_tile::block_desc desc = {offset, 0u, encode_block(samples.data(), blocks[i]), 0u};
+        desc.size                     = static_cast<uint16_t>(blocks[i].size());
+        ret                           = f.write(desc);
+        offset += desc.size;
+        encoding.raw_blocks += (desc.enc == terrain_tile::encoding::raw) ? 1u : 0u;
+        encoding.delta_blocks += (desc.enc == terrain_tile::encoding::delta) ? 1u : 0u;
+    }
+    for (uint32_t i = 0u; ret && (i < block_count); i++)
+    {
+        size_t write_count = 0u;
+        ret                = f.write(blocks[i].data(), blocks[i].size(), write_count) && (write_count == blocks[i].size());
+    }
+    encoding.size = offset;
+
+    ret = f.close() && ret;
+    return ret;
+}
+
+/** @brief Get an empty filesystem with the generated tiles N45E005 and N45E006 */
+static bool init_tiles(tile_encoding& encoding)
+{
+    static bool          is_written = false;
+    static tile_encoding s_encoding = {};
+
+    bool ret = true;
+    if (!is_written)
+    {
+        tile_encoding east = {};
+        ret                = test::format_host_fs() && fs::mkdir(terrain_tile::TERRAIN_DIR);
+        ret                = ret && write_tile(45, 5, s_encoding) && write_tile(45, 6, east);
+        is_written         = ret;
+    }
+    encoding = s_encoding;
+    return ret;
+}
+
+/** @brief Reference bilinear interpolation of the generated elevation */
+static double reference_elevation(const geo::position& pos)
+{
+    const int16_t latitude  = static_cast<int16_t>(std::floor(pos.latitude_deg()));
+    const int16_t longitude = static_cast<int16_t>(std::floor(pos.longitude_deg()));
+    const double  y         = (latitude + 1. - pos.latitude_deg()) * SAMPLES_PER_DEGREE;
+    const double  x         = (pos.longitude_deg() - longitude) * SAMPLES_PER_DEGREE;
+    uint32_t      row       = static_cast<uint32_t>(y);
+    uint32_t      column    = static_cast<uint32_t>(x);
+    row                     = (row >= SAMPLES_PER_DEGREE) ? (SAMPLES_PER_DEGREE - 1u) : row;
+    column                  = (column >= SAMPLES_PER_DEGREE) ? (SAMPLES_PER_DEGREE - 1u) : column;
+    const double dy         = y - row;
+    const double dx         = x - column;
+    const double nw         = dem_sample(latitude, longitude, row, column);
+    const double ne         = dem_sample(latitude, longitude, row, column + 1u);
+    const double sw         = dem_sample(latitude, longitude, row + 1u, column);
+    const double se         = dem_sample(latitude, longitude, row + 1u, column + 1u);
+    const double north      = nw + dx * (ne - nw);
+    const double south      = sw + dx * (se - sw);
+    return north + dy * (south - north);
+}
+
+/** @brief Get the key of the block containing a position : tile longitude, block row and block column */
+static uint32_t get_block_key(const geo::position& pos)
+{
+    const int32_t units  = geo::UNITS_PER_DEGREE;
+    const int32_t lat    = pos.latitude / units;
+    const int32_t lon    = pos.longitude / units;
+    const int64_t row    = (static_cast<int64_t>((lat + 1) * units - pos.latitude) * SAMPLES_PER_DEGREE) / units;
+    const int64_t column = (static_cast<int64_t>(pos.longitude - lon * units) * SAMPLES_PER_DEGREE) / units;
+    return static_cast<uint32_t>((lon * BLOCKS_PER_SIDE + row / BLOCK_SIZE) * BLOCKS_PER_SIDE + column / BLOCK_SIZE);
+}
+
+/** @brief Simulated flight : 30 km straight glide towards the east crossing a tile edge, then 5 minutes of thermalling */
+static geo::position get_flight_position(uint32_t second)
+{
+    static constexpr uint32_t GLIDE_DURATION = 3000u;
+
+    const geo::position start    = geo::position::from_degrees(45.52, 5.85);
+    const uint32_t      duration = (second < GLIDE_DURATION) ? second : GLIDE_DURATION;
+    geo::position       pos      = geo::destination(start, 90.f, 10.f * static_cast<float>(duration));
+    if (second > GLIDE_DURATION)
+    {
+        // 100m radius circles of 20s
+        const float angle = 18.f * static_cast<float>(second - GLIDE_DURATION);
+        pos               = geo::destination(pos, angle, 100.f);
+    }
+    return pos;
+}
+
+/** @brief Duration of the simulated flight in seconds */
+static constexpr uint32_t FLIGHT_DURATION = 3300u;
+
+OV_TEST(terrain, tile_blocks_decode)
+{
+    tile_encoding encoding = {};
+    OV_CHECK(init_tiles(encoding));
+    OV_CHECK(encoding.raw_blocks != 0u);
+    OV_CHECK(encoding.delta_blocks != 0u);
+
+    // Every block decodes to the generated samples, whatever its encoding
+    terrain_tile tile(45, 5);
+    OV_CHECK(tile.is_open());
+    OV_CHECK_EQ(tile.get_header().samples_per_degree, SAMPLES_PER_DEGREE);
+    OV_CHECK_EQ(tile.get_header().blocks_per_side, BLOCKS_PER_SIDE);
+    static int16_t samples[terrain_tile::MAX_BLOCK_SAMPLES];
+    static int16_t expected[terrain_tile::MAX_BLOCK_SAMPLES];
+    uint32_t       mismatches = 0u;
+    for (uint32_t i = 0u; i < (BLOCKS_PER_SIDE * BLOCKS_PER_SIDE); i++)
+    {
+        OV_CHECK(tile.read_block(i, samples));
+        get_block_samples(45, 5, i, expected);
+        mismatches += (memcmp(samples, expected, BLOCK_STRIDE * BLOCK_STRIDE * sizeof(int16_t)) == 0) ? 0u : 1u;
+    }
+    OV_CHECK_EQ(mismatches, 0u);
+    OV_CHECK(!tile.read_block(BLOCKS_PER_SIDE * BLOCKS_PER_SIDE, samples));
+
+    // Missing tile
+    terrain_tile missing(46, 5);
+    OV_CHECK(!missing.is_open());
+}
+
+OV_TEST(terrain, bilinear_lookup)
+{
+    tile_encoding encoding = {};
+    OV_CHECK(init_tiles(encoding));
+
+    // Samples, positions between the samples, and edges of the tile
+    terrain_cache cache;
+    int16_t       elevation = 0;
+    double        max_error = 0.;
+    for (uint32_t i = 0u; i <= 200u; i++)
+    {
+        const double        t       = static_cast<double>(i) / 200.;
+        const geo::position diag   = geo::position::from_degrees(45. + 0.999999 * t, 5. + 0.7 * t + 0.0001234);
+        const geo::position sample = geo::position::from_degrees(45.5 - static_cast<double>(i) / SAMPLES_PER_DEGREE, 5.25);
+        const geo::position east   = geo::position::from_degrees(45. + 0.9 * t, 5.9999999);
+        const geo::position south  = geo::position::from_degrees(45.0000001, 5. + 0.9 * t);
+        for (const geo::position& pos : {diag, sample, east, south})
+        {
+            OV_CHECK(cache.get_elevation(pos, 0u, elevation));
+            const double error = std::fabs(elevation - reference_elevation(pos));
+            max_error          = (error > max_error) ? error : max_error;
+        }
+    }
+    OV_CHECK(max_error <= 1.);
+    test::report_result("max interpolation error", max_error, "m");
+
+    // No tile
+    const uint32_t no_data = cache.get_stats().no_data;
+    OV_CHECK(!cache.get_elevation(geo::position::from_degrees(46.5, 5.5), 0u, elevation));
+    OV_CHECK_EQ(cache.get_stats().no_data, no_data + 1u);
+}
+
+OV_TEST(terrain, cache_statistics)
+{
+    tile_encoding encoding = {};
+    OV_CHECK(init_tiles(encoding));
+
+    // Each block crossed by the flight is loaded once, then the thermalling only hits the cache
+    terrain_cache cache;
+    uint32_t      block_changes = 0u;
+    uint32_t      previous_key  = UINT32_MAX;
+    for (uint32_t second = 0u; second < FLIGHT_DURATION; second++)
+    {
+        const geo::position pos = get_flight_position(second);
+        int16_t             elevation;
+        OV_CHECK(cache.get_elevation(pos, second * 1000u, elevation));
+        const uint32_t key = get_block_key(pos);
+        block_changes += (key != previous_key) ? 1u : 0u;
+        previous_key = key;
+    }
+    const terrain_cache::stats& stats = cache.get_stats();
+    OV_CHECK_EQ(stats.hits + stats.misses, FLIGHT_DURATION);
+    OV_CHECK_EQ(stats.misses, block_changes);
+    OV_CHECK_EQ(stats.no_data, 0u);
+    OV_CHECK_EQ(stats.errors, 0u);
+    test::report_result("hits", stats.hits, "");
+    test::report_result("misses", stats.misses, "");
+    test::report_result("hit ratio", 100. * stats.hits / FLIGHT_DURATION, "%");
+}
+
+OV_BENCHMARK(terrain, decode_and_lookup)
+{
+    tile_encoding encoding = {};
+    OV_CHECK(init_tiles(encoding));
+    test::report_result("generated tile", static_cast<double>(encoding.size) / 1024., "kB");
+    test::report_result("raw blocks", encoding.raw_blocks, "");
+    test::report_result("delta blocks", encoding.delta_blocks, "");
+
+    // Block decoding, the rough north west quarter is raw encoded
+    terrain_tile   tile(45, 5);
+    static int16_t samples[terrain_tile::MAX_BLOCK_SAMPLES];
+    const uint32_t raw_block   = 0u;
+    const uint32_t delta_block = BLOCKS_PER_SIDE * BLOCKS_PER_SIDE - 1u;
+    const size_t   read_bytes  = test::get_host_fs_read_bytes();
+    test::stopwatch watch;
+    for (uint32_t i = 0u; i < 1000u; i++)
+    {
+        tile.read_block(raw_block, samples);
+    }
+    const double raw_us    = watch.elapsed_ns() / 1000. / 1e3;
+    const size_t raw_bytes = (test::get_host_fs_read_bytes() - read_bytes) / 1000u;
+    watch.restart();
+    for (uint32_t i = 0u; i < 1000u; i++)
+    {
+        tile.read_block(delta_block, samples);
+    }
+    const double delta_us    = watch.elapsed_ns() / 1000. / 1e3;
+    const size_t delta_bytes = (test::get_host_fs_read_bytes() - read_bytes) / 1000u - raw_bytes;
+    test::report_result("raw block decode", raw_us, "us");
+    test::report_result("raw block flash reads", static_cast<double>(raw_bytes), "bytes");
+    test::report_result("delta block decode", delta_us, "us");
+    test::report_result("delta block flash reads", static_cast<double>(delta_bytes), "bytes");
+
+    // Lookups in a cached block
+    terrain_cache cache;
+    int16_t       elevation = 0;
+    watch.restart();
+    for (uint32_t i = 0u; i < BENCH_ITERATIONS; i++)
+    {
+        const geo::position pos = {455000000 + static_cast<int32_t>(i % 1000u) * 100, 55000000 + static_cast<int32_t>(i % 777u) * 100};
+        cache.get_elevation(pos, 0u, elevation);
+        test::keep(elevation);
+    }
+    test::report_result("cached lookup", watch.elapsed_ns() / BENCH_ITERATIONS, "ns");
+    test::report_result("cached lookup misses", cache.get_stats().misses, "");
+
+    // Simulated flight
+    cache.reset_stats();
+    watch.restart();
+    for (uint32_t second = 0u; second < FLIGHT_DURATION; second++)
+    {
+        cache.get_elevation(get_flight_position(second), second * 1000u, elevation);
+    }
+    test::report_result("flight lookup", watch.elapsed_ns() / FLIGHT_DURATION / 1e3, "us");
+    test::report_result("flight hit ratio", 100. * cache.get_stats().hits / FLIGHT_DURATION, "%");
+}
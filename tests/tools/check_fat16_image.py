@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 open-vario
+# SPDX-License-Identifier: MIT
+#
+
+"""Independent FAT16 reader checking the volume generated by the flight drive
+
+Usage : check_fat16_image.py <image> <expected_dir>
+
+The volume must be a valid FAT16 volume as defined by Microsoft's FAT specification and its root
+directory must contain exactly the files of <expected_dir>, under their long file name and with the same contents.
+"""
+
+import os
+import struct
+import sys
+
+
+class Fat16Error(Exception):
+    """Invalid volume"""
+
+
+def check(condition, message):
+    """Raise an error if a condition is not met"""
+    if not condition:
+        raise Fat16Error(message)
+
+
+class Fat16Volume:
+    """Read-only FAT16 volume"""
+
+    def __init__(self, image):
+        self.image = image
+        boot = self.read(0, 512)
+        check(boot[510:512] == b"\x55\xaa", "missing boot sector signature")
+        check(boot[0] in (0xEB, 0xE9), "invalid jump instruction")
+
+        # BIOS parameter block
+        (self.bytes_per_sector, self.sectors_per_cluster, self.reserved_sectors, self.fat_count, self.root_entries,
+         total_sectors_16, self.media, self.fat_sectors) = struct.unpack_from("<HBHBHHBH", boot, 11)
+        total_sectors_32 = struct.unpack_from("<I", boot, 32)[0]
+        self.total_sectors = total_sectors_16 if total_sectors_16 != 0 else total_sectors_32
+        check(self.bytes_per_sector in (512, 1024, 2048, 4096), "invalid sector size")
+        check(self.sectors_per_cluster in (1, 2, 4, 8, 16, 32, 64, 128), "invalid cluster size")
+        check(self.reserved_sectors >= 1, "invalid number of reserved sectors")
+        check(self.fat_count >= 1, "no FAT")
+        check(self.media in (0xF0, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF), "invalid media descriptor")
+        check(boot[38] == 0x29, "invalid extended boot signature")
+        check(boot[54:62] == b"FAT16   ", "invalid file system type")
+        self.label = boot[43:54]
+
+        # Regions, the FAT type is given by the number of clusters only
+        self.fat_start = self.reserved_sectors
+        self.root_start = self.fat_start + self.fat_count * self.fat_sectors
+        root_sectors = (self.root_entries * 32 + self.bytes_per_sector - 1) // self.bytes_per_sector
+        self.data_start = self.root_start + root_sectors
+        self.cluster_size = self.bytes_per_sector * self.sectors_per_cluster
+        self.cluster_count = (self.total_sectors - self.data_start) // self.sectors_per_cluster
+        check(4085 <= self.cluster_count < 65525, "cluster count {} is not a FAT16 one".format(self.cluster_count))
+        check(self.fat_sectors * self.bytes_per_sector >= (self.cluster_count + 2) * 2, "FAT too small")
+        check(os.path.getsize(image) == self.total_sectors * self.bytes_per_sector, "image size does not match the volume")
+
+        # FATs must be identical
+        fat_size = self.fat_sectors * self.bytes_per_sector
+        fats = [self.read_sectors(self.fat_start + i * self.fat_sectors, self.fat_sectors) for i in range(self.fat_count)]
+        check(all(fat == fats[0] for fat in fats), "FAT copies differ")
+        self.fat = struct.unpack("<{}H".format(fat_size // 2), fats[0])
+        check(self.fat[0] == 0xFF00 | self.media, "invalid media entry in the FAT")
+        check(self.fat[1] >= 0xFFF8, "invalid end of chain entry in the FAT")
+
+    def read(self, offset, size):
+        """Read bytes of the image"""
+        with open(self.image, "rb") as f:
+            f.seek(offset)
+            data = f.read(size)
+        check(len(data) == size, "image too small")
+        return data
+
+    def read_sectors(self, sector, count):
+        """Read consecutive sectors"""
+        return self.read(sector * self.bytes_per_sector, count * self.bytes_per_sector)
+
+    def read_chain(self, cluster, size, used):
+        """Read the contents of a file by following its cluster chain"""
+        data = bytearray()
+        while len(data) < size:
+            check(2 <= cluster < self.cluster_count + 2, "cluster {} out of the data region".format(cluster))
+            check(cluster not in used, "cluster {} is used twice".format(cluster))
+            used.add(cluster)
+            sector = self.data_start + (cluster - 2) * self.sectors_per_cluster
+            data += self.read_sectors(sector, self.sectors_per_cluster)
+            cluster = self.fat[cluster]
+            if len(data) < size:
+                check(cluster < 0xFFF8, "chain shorter than the file size")
+        check(size == 0 or cluster >= 0xFFF8, "chain longer than the file size")
+        return bytes(data[:size])
+
+    def list_root(self):
+        """List the files of the root directory as (name, first cluster, size)"""
+        root = self.read_sectors(self.root_start, (self.root_entries * 32) // self.bytes_per_sector)
+        files = []
+        lfn_parts = {}
+        lfn_checksum = None
+        for index in range(self.root_entries):
+            entry = root[index * 32:(index + 1) * 32]
+            if entry[0] == 0x00:
+                break
+            if entry[0] == 0xE5:
+                lfn_parts = {}
+                continue
+            attributes = entry[11]
+            if attributes == 0x0F:
+                # Long file name entry, stored in reverse order before the short entry
+                order = entry[0] & 0x1F
+                check(order >= 1, "invalid long file name order")
+                if entry[0] & 0x40:
+                    lfn_parts = {}
+                    lfn_checksum = entry[13]
+                check(entry[13] == lfn_checksum, "inconsistent long file name checksums")
+                check(struct.unpack_from("<H", entry, 26)[0] == 0, "long file name entry with a cluster")
+                lfn_parts[order] = entry[1:11] + entry[14:26] + entry[28:32]
+                continue
+            if attributes & 0x08:
+                check(entry[0:11] == self.label, "volume label differs from the boot sector")
+                continue
+            check((attributes & 0x10) == 0, "unexpected directory in the root directory")
+
+            short_name = entry[0:11]
+            name = (short_name[0:8].decode("ascii").rstrip() + "." + short_name[8:11].decode("ascii").rstrip())
+            if lfn_parts:
+                checksum = 0
+                for c in short_name:
+                    checksum = (((checksum & 1) << 7) + (checksum >> 1) + c) & 0xFF
+                check(checksum == lfn_checksum, "long file name checksum mismatch for {}".format(name))
+                check(sorted(lfn_parts) == list(range(1, len(lfn_parts) + 1)), "missing long file name entries")
+                raw = b"".join(lfn_parts[i] for i in sorted(lfn_parts))
+                name = raw.decode("utf-16-le").split("\x00")[0]
+            lfn_parts = {}
+            cluster = struct.unpack_from("<H", entry, 26)[0]
+            size = struct.unpack_from("<I", entry, 28)[0]
+            check((size == 0) == (cluster == 0), "first cluster of {} does not match its size".format(name))
+            files.append((name, cluster, size))
+        return files
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 2
+    image, expected_dir = sys.argv[1:3]
+
+    try:
+        volume = Fat16Volume(image)
+        print("FAT16 volume {} : {} clusters of {} bytes".format(volume.label.decode("ascii").strip(), volume.cluster_count,
+                                                                volume.cluster_size))
+        used = set()
+        names = []
+        for name, cluster, size in volume.list_root():
+            contents = volume.read_chain(cluster, size, used)
+            path = os.path.join(expected_dir, name)
+            check(os.path.isfile(path), "unexpected file {}".format(name))
+            with open(path, "rb") as f:
+                check(f.read() == contents, "contents of {} differ".format(name))
+            print("  {:<32} {:>8} bytes, cluster {}".format(name, size, cluster))
+            names.append(name)
+        missing = set(os.listdir(expected_dir)) - set(names)
+        check(not missing, "missing files {}".format(sorted(missing)))
+        check(len(names) == len(set(names)), "duplicate file names")
+    except Fat16Error as error:
+        print("Invalid volume : {}".format(error))
+        return 1
+
+    print("{} file(s) checked".format(len(names)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "biquad_filter.h"
+#include "decimator.h"
+#include "delay_line.h"
+#include "ema_filter.h"
+#include "median_filter.h"
+#include "ov_test.h"
+#include "running_stats.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ov;
+
+/** @brief Amplitude of the steady state response of a filter to a sine wave, the sample rate must be a multiple of 4 times the frequency */
+static double sine_response(biquad_filter<float>& filter, double frequency, double sample_rate)
+{
+    double amplitude = 0.;
+    for (uint32_t i = 0; i < 4000u; i++)
+    {
+        const float output = filter.add_value(static_cast<float>(std::sin(2. * M_PI * frequency * i / sample_rate)));
+        if (i >= 2000u)
+        {
+            amplitude = std::max(amplitude, std::fabs(static_cast<double>(output)));
+        }
+    }
+    return amplitude;
+}
+
+/** @brief Constant expression usage : mean of the last 3 values of a sequence */
+static constexpr int32_t constexpr_mean()
+{
+    running_stats<int32_t, int32_t, 3u> stats;
+    stats.add_value(10);
+    stats.add_value(20);
+    stats.add_value(30);
+    return stats.add_value(40);
+}
+
+/** @brief Low-pass filter designed at compile time */
+static constexpr biquad_coefs s_low_pass = biquad_coefs::low_pass(1.f, 25.f);
+
+static_assert(constexpr_mean() == 30, "running_stats must be usable in constant expressions");
+static_assert((s_low_pass.dc_gain() > 0.999f) && (s_low_pass.dc_gain() < 1.001f), "biquad design must be usable in constant expressions");
+
+OV_TEST(dsp_filters, delay_line)
+{
+    delay_line<int32_t, 8u> line;
+    OV_CHECK(!line.set_depth(0u));
+    OV_CHECK(!line.set_depth(9u));
+    OV_CHECK(line.set_depth(4u));
+
+    // Oldest value is the value added (depth - 1) values ago once full
+    for (int32_t i = 1; i <= 20; i++)
+    {
+        line.add_value(i);
+        OV_CHECK_EQ(line.is_full(), (i >= 4));
+        OV_CHECK_EQ(line.get_newest_value(), i);
+        OV_CHECK_EQ(line.get_oldest_value(), (i >= 4) ? (i - 3) : 1);
+    }
+
+    // Changing the depth clears the window
+    OV_CHECK(line.set_depth(2u));
+    OV_CHECK_EQ(line.get_count(), 0u);
+    line.add_value(100);
+    line.add_value(200);
+    OV_CHECK(line.is_full());
+    OV_CHECK_EQ(line.get_oldest_value(), 100);
+}
+
+OV_TEST(dsp_filters, running_stats_full_range)
+{
+    // 16 bits samples with a 32 bits accumulator as in the sink rate filters, the squares exceed 32 bits
+    constexpr size_t                        DEPTH = 4u;
+    running_stats<int16_t, int32_t, DEPTH>  stats;
+    static constexpr int16_t                EXTREMES[] = {INT16_MAX, INT16_MIN, INT16_MAX - 1, INT16_MIN + 1};
+    std::vector<int16_t>                    values;
+    std::mt19937                            generator(7u);
+    std::uniform_int_distribution<uint32_t> distribution(0u, 3u);
+    for (uint32_t i = 0; i < 200u; i++)
+    {
+        const int16_t value = (i < 20u) ? INT16_MAX : EXTREMES[distribution(generator)];
+        values.push_back(value);
+        const int16_t mean = stats.add_value(value);
+
+        // Naive mean and population variance over the window
+        const size_t count  = std::min<size_t>(values.size(), DEPTH);
+        int64_t      sum    = 0;
+        int64_t      sum_sq = 0;
+        for (size_t j = values.size() - count; j < values.size(); j++)
+        {
+            sum += values[j];
+            sum_sq += static_cast<int64_t>(values[j]) * values[j];
+        }
+        const int64_t n = static_cast<int64_t>(count);
+        OV_CHECK_EQ(mean, static_cast<int16_t>(sum / n));
+        OV_CHECK_EQ(stats.get_variance(), (n * sum_sq - sum * sum) / (n * n));
+        if (i < 20u)
+        {
+            OV_CHECK_EQ(stats.get_variance(), 0);
+        }
+    }
+}
+
+OV_TEST(dsp_filters, running_stats_matches_naive_computation)
+{
+    constexpr size_t                       DEPTH = 20u;
+    running_stats<int32_t, int64_t, DEPTH> stats;
+    std::vector<int32_t>                   values;
+    std::mt19937                           generator(42u);
+    std::uniform_int_distribution<int32_t> distribution(-5000, 5000);
+    for (uint32_t i = 0; i < 500u; i++)
+    {
+        const int32_t value = distribution(generator);
+        values.push_back(value);
+        const int32_t mean = stats.add_value(value);
+
+        // Naive mean and population variance over the window
+        const size_t count  = std::min<size_t>(values.size(), DEPTH);
+        int64_t      sum    = 0;
+        int64_t      sum_sq = 0;
+        for (size_t j = values.size() - count; j < values.size(); j++)
+        {
+            sum += values[j];
+            sum_sq += static_cast<int64_t>(values[j]) * values[j];
+        }
+        const int64_t n = static_cast<int64_t>(count);
+        OV_CHECK_EQ(mean, static_cast<int32_t>(sum / n));
+        OV_CHECK_EQ(stats.get_variance(), (n * sum_sq - sum * sum) / (n * n));
+        OV_CHECK_EQ(stats.is_full(), (count == DEPTH));
+    }
+
+    OV_CHECK(!stats.set_depth(0u));
+    OV_CHECK(!stats.set_depth(DEPTH + 1u));
+    OV_CHECK(stats.set_depth(5u));
+    OV_CHECK_EQ(stats.get_count(), 0u);
+    OV_CHECK_EQ(stats.get_mean(), 0);
+}
+
+OV_TEST(dsp_filters, ema_time_constant)
+{
+    // Step response reaches 1 - 1/e after one time constant (discrete approximation)
+    ema_filter<float> filter(ema_filter<float>::alpha_from_time_constant(10.f, 1000.f));
+    filter.add_value(0.f);
+    float value = 0.f;
+    for (uint32_t i = 0; i < 100u; i++)
+    {
+        value = filter.add_value(1.f);
+    }
+    OV_CHECK_NEAR(value, 1. - std::exp(-1.), 0.01);
+
+    // Integer samples are rounded to the nearest value
+    ema_filter<int16_t> int_filter(0.5f);
+    OV_CHECK_EQ(int_filter.add_value(10), 10);
+    OV_CHECK_EQ(int_filter.add_value(13), 12);
+    OV_CHECK_EQ(int_filter.add_value(-20), -4);
+}
+
+OV_TEST(dsp_filters, biquad_low_pass_response)
+{
+    // 2nd order Butterworth : unity gain at DC, -3dB at the cutoff frequency, -12dB per octave above
+    constexpr float      SAMPLE_RATE = 100.f;
+    constexpr float      CUTOFF      = 5.f;
+    biquad_filter<float> filter(biquad_coefs::low_pass(CUTOFF, SAMPLE_RATE));
+    OV_CHECK_NEAR(filter.get_coefs().dc_gain(), 1., 1e-5);
+    OV_CHECK_NEAR(sine_response(filter, 0.1, SAMPLE_RATE), 1., 0.01);
+    filter.reset();
+    OV_CHECK_NEAR(sine_response(filter, CUTOFF, SAMPLE_RATE), M_SQRT1_2, 0.01);
+    filter.reset();
+    OV_CHECK(sine_response(filter, 4. * CUTOFF, SAMPLE_RATE) < 0.07);
+
+    // First value initializes the filter in steady state
+    filter.reset();
+    OV_CHECK_NEAR(filter.add_value(100.f), 100., 1e-3);
+    OV_CHECK_NEAR(filter.add_value(100.f), 100., 1e-3);
+}
+
+OV_TEST(dsp_filters, biquad_high_pass_response)
+{
+    constexpr float      SAMPLE_RATE = 100.f;
+    constexpr float      CUTOFF      = 1.f;
+    biquad_filter<float> filter(biquad_coefs::high_pass(CUTOFF, SAMPLE_RATE));
+    OV_CHECK_NEAR(filter.get_coefs().dc_gain(), 0., 1e-5);
+    OV_CHECK_NEAR(sine_response(filter, CUTOFF, SAMPLE_RATE), M_SQRT1_2, 0.01);
+    filter.reset();
+    OV_CHECK_NEAR(sine_response(filter, 25., SAMPLE_RATE), 1., 0.01);
+}
+
+OV_TEST(dsp_filters, constexpr_math)
+{
+    for (float x = -10.f; x <= 10.f; x += 0.01f)
+    {
+        OV_CHECK_NEAR(dsp::sin(x), std::sin(x), 1e-5);
+        OV_CHECK_NEAR(dsp::cos(x), std::cos(x), 1e-5);
+    }
+    OV_CHECK_NEAR(dsp::tan(0.5f), std::tan(0.5f), 1e-5);
+    OV_CHECK_EQ(dsp::to_sample<int32_t>(2.5f), 3);
+    OV_CHECK_EQ(dsp::to_sample<int32_t>(-2.5f), -3);
+}
+
+OV_TEST(dsp_filters, median_rejects_spikes)
+{
+    median_filter<int32_t, 3u> filter;
+    OV_CHECK_EQ(filter.add_value(1000), 1000);
+    OV_CHECK_EQ(filter.add_value(1001), 1001);
+    OV_CHECK_EQ(filter.add_value(1002), 1001);
+    OV_CHECK_EQ(filter.add_value(5000), 1002);
+    OV_CHECK_EQ(filter.add_value(1003), 1003);
+    OV_CHECK_EQ(filter.add_value(1004), 1004);
+
+    // Matches a sorted copy of the window
+    median_filter<int32_t, 9u>             wide_filter;
+    std::vector<int32_t>                   values;
+    std::mt19937                           generator(7u);
+    std::uniform_int_distribution<int32_t> distribution(-100, 100);
+    for (uint32_t i = 0; i < 300u; i++)
+    {
+        values.push_back(distribution(generator));
+        const int32_t        median = wide_filter.add_value(values.back());
+        const size_t         count  = std::min<size_t>(values.size(), 9u);
+        std::vector<int32_t> window(values.end() - static_cast<ptrdiff_t>(count), values.end());
+        std::sort(window.begin(), window.end());
+        OV_CHECK_EQ(median, window[count / 2u]);
+    }
+}
+
+OV_TEST(dsp_filters, decimator_block_mean)
+{
+    decimator<int16_t, int32_t, 4u> filter;
+    int16_t                         input   = 0;
+    uint32_t                        outputs = 0u;
+    for (uint32_t i = 0; i < 40u; i++)
+    {
+        const bool ready = filter.add_value(input);
+        OV_CHECK_EQ(ready, ((i % 4u) == 3u));
+        if (ready)
+        {
+            // Mean of the 4 last consecutive values, truncated by the integer division
+            OV_CHECK_EQ(filter.get_value(), static_cast<int16_t>((4 * input - 6) / 4));
+            outputs++;
+        }
+        input = static_cast<int16_t>(input + 1);
+    }
+    OV_CHECK_EQ(outputs, 10u);
+}
+
+/** @brief Number of iterations of the benchmarks */
+static constexpr uint32_t BENCH_ITERATIONS = 1000000u;
+
+/** @brief Input samples of the benchmarks */
+static int32_t s_samples[1024u];
+
+/** @brief Fill the input samples of the benchmarks */
+static void init_samples()
+{
+    std::mt19937                           generator(1u);
+    std::uniform_int_distribution<int32_t> distribution(0, 30000);
+    for (auto& sample : s_samples)
+    {
+        sample = distribution(generator);
+    }
+}
+
+OV_BENCHMARK(dsp_filters, windowed_mean)
+{
+    init_samples();
+
+    // Sliding mean over 40 values : O(1) running sums versus the O(n) sum of the former circular buffer
+    running_stats<int32_t, int64_t, 40u> stats;
+    int32_t                              window[40u] = {};
+    test::stopwatch                      watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(stats.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("running_stats<40>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        window[i % 40u] = s_samples[i % 1024u];
+        int64_t sum     = 0;
+        for (const int32_t value : window)
+        {
+            sum += value;
+        }
+        test::keep(sum / 40);
+    }
+    test::report_result("O(n) sum<40>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+}
+
+OV_BENCHMARK(dsp_filters, filters)
+{
+    init_samples();
+
+    delay_line<int32_t, 40u>        line;
+    ema_filter<int32_t>             ema(0.1f);
+    biquad_filter<int32_t>          biquad(biquad_coefs::low_pass(2.f, 104.f));
+    median_filter<int32_t, 3u>      median3;
+    median_filter<int32_t, 15u>     median15;
+    decimator<int32_t, int64_t, 8u> decim;
+    test::stopwatch                 watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        line.add_value(s_samples[i % 1024u]);
+        test::keep(line.get_oldest_value());
+    }
+    test::report_result("delay_line<40>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(ema.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("ema_filter", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(biquad.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("biquad_filter", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(median3.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("median_filter<3>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(median15.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("median_filter<15>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        test::keep(decim.add_value(s_samples[i % 1024u]));
+    }
+    test::report_result("decimator<8>", watch.elapsed_ns() / BENCH_ITERATIONS, "ns/sample");
+}
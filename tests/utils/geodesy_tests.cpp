@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "geodesy.h"
+#include "ov_test.h"
+
+using namespace ov;
+
+/** @brief Double precision reference implementations on the same sphere */
+namespace reference
+{
+
+/** @brief Pi */
+static constexpr double PI = 3.14159265358979323846;
+
+/** @brief Earth radius in meters */
+static constexpr double EARTH_RADIUS = static_cast<double>(geo::EARTH_RADIUS);
+
+/** @brief Convert a fixed point coordinate to radians */
+static double to_rad(int32_t value)
+{
+    return static_cast<double>(value) / static_cast<double>(geo::UNITS_PER_DEGREE) * PI / 180.;
+}
+
+/** @brief Haversine distance in meters */
+static double distance(const geo::position& a, const geo::position& b)
+{
+    const double lat_a    = to_rad(a.latitude);
+    const double lat_b    = to_rad(b.latitude);
+    const double sin_dlat = std::sin((lat_b - lat_a) / 2.);
+    const double sin_dlon = std::sin((to_rad(b.longitude) - to_rad(a.longitude)) / 2.);
+    const double h        = sin_dlat * sin_dlat + std::cos(lat_a) * std::cos(lat_b) * sin_dlon * sin_dlon;
+    return 2. * EARTH_RADIUS * std::asin(std::sqrt(h));
+}
+
+/** @brief Initial bearing in degrees */
+static double bearing(const geo::position& a, const geo::position& b)
+{
+    const double lat_a = to_rad(a.latitude);
+    const double lat_b = to_rad(b.latitude);
+    const double dlon  = to_rad(b.longitude) - to_rad(a.longitude);
+    const double y     = std::sin(dlon) * std::cos(lat_b);
+    const double x     = std::cos(lat_a) * std::sin(lat_b) - std::sin(lat_a) * std::cos(lat_b) * std::cos(dlon);
+    double       ret   = std::atan2(y, x) * 180. / PI;
+    if (ret < 0.)
+    {
+        ret += 360.;
+    }
+    return ret;
+}
+
+/** @brief Destination point in decimal degrees */
+static void destination(const geo::position& from, double bearing_deg, double dist, double& lat, double& lon)
+{
+    const double lat_from = to_rad(from.latitude);
+    const double angle    = bearing_deg * PI / 180.;
+    const double ang_dist = dist / EARTH_RADIUS;
+    const double sin_dest = std::sin(lat_from) * std::cos(ang_dist) + std::cos(lat_from) * std::sin(ang_dist) * std::cos(angle);
+    const double east     = std::sin(angle) * std::sin(ang_dist) * std::cos(lat_from);
+    const double dlon     = std::atan2(east, std::cos(ang_dist) - std::sin(lat_from) * sin_dest);
+    lat                   = std::asin(sin_dest) * 180. / PI;
+    lon                   = from.longitude_deg() + dlon * 180. / PI;
+    if (lon > 180.)
+    {
+        lon -= 360.;
+    }
+    else if (lon < -180.)
+    {
+        lon += 360.;
+    }
+}
+
+} // namespace reference
+
+/** @brief Pair of positions used as test vector */
+struct position_pair
+{
+    /** @brief Start position */
+    geo::position from;
+    /** @brief End position */
+    geo::position to;
+};
+
+/** @brief Test vectors from a few meters to a few hundred kilometers, at low and high latitudes */
+static const position_pair s_pairs[] = {
+    {geo::position::from_degrees(45.1234567, 5.7654321), geo::position::from_degrees(45.1234667, 5.7654421)},  // ~1.4m
+    {geo::position::from_degrees(45.1234567, 5.7654321), geo::position::from_degrees(45.1244567, 5.7664321)},  // ~140m
+    {geo::position::from_degrees(45.1234567, 5.7654321), geo::position::from_degrees(45.1834567, 5.8454321)},  // ~9km
+    {geo::position::from_degrees(45.1234567, 5.7654321), geo::position::from_degrees(45.8234567, 6.6654321)},  // ~105km
+    {geo::position::from_degrees(45.1234567, 5.7654321), geo::position::from_degrees(43.2965000, 5.3698000)},  // ~205km
+    {geo::position::from_degrees(-33.912345, 18.412345), geo::position::from_degrees(-33.512345, 18.912345)},  // ~63km, south
+    {geo::position::from_degrees(61.1234567, 10.123456), geo::position::from_degrees(61.5234567, 11.323456)},  // ~77km, north
+    {geo::position::from_degrees(-17.512345, 179.81234), geo::position::from_degrees(-17.412345, -179.71234)}, // antimeridian
+};
+
+OV_TEST(geodesy, distance_matches_reference)
+{
+    for (const auto& pair : s_pairs)
+    {
+        // Relative error below 1e-4 or absolute error below 5cm for short distances
+        const double expected = reference::distance(pair.from, pair.to);
+        const double actual   = geo::distance(pair.from, pair.to);
+        OV_CHECK(std::fabs(actual - expected) <= std::max(0.05, expected * 1e-4));
+        OV_CHECK_NEAR(geo::distance(pair.to, pair.from), actual, std::max(0.05, expected * 1e-4));
+    }
+    OV_CHECK_EQ(geo::distance(s_pairs[0].from, s_pairs[0].from), 0.f);
+}
+
+OV_TEST(geodesy, fast_distance_matches_reference_up_to_100km)
+{
+    for (const auto& pair : s_pairs)
+    {
+        const double expected = reference::distance(pair.from, pair.to);
+        if (expected <= 110000.)
+        {
+            const double actual = geo::fast_distance(pair.from, pair.to);
+            OV_CHECK(std::fabs(actual - expected) <= std::max(0.05, expected * 1e-3));
+        }
+    }
+}
+
+OV_TEST(geodesy, bearing_matches_reference)
+{
+    for (const auto& pair : s_pairs)
+    {
+        // Also accurate between positions a few meters apart
+        const double expected = reference::bearing(pair.from, pair.to);
+        const double actual   = geo::bearing(pair.from, pair.to);
+        double       error    = std::fabs(actual - expected);
+        if (error > 180.)
+        {
+            error = 360. - error;
+        }
+        OV_CHECK(error <= 0.01);
+        OV_CHECK((actual >= 0.f) && (actual < 360.f));
+    }
+
+    // Cardinal directions
+    const geo::position origin = geo::position::from_degrees(45., 5.);
+    OV_CHECK_NEAR(geo::bearing(origin, geo::position::from_degrees(45.1, 5.)), 0., 1e-3);
+    OV_CHECK_NEAR(geo::bearing(origin, geo::position::from_degrees(45., 5.1)), 90., 0.05);
+    OV_CHECK_NEAR(geo::bearing(origin, geo::position::from_degrees(44.9, 5.)), 180., 1e-3);
+    OV_CHECK_NEAR(geo::bearing(origin, geo::position::from_degrees(45., 4.9)), 270., 0.05);
+}
+
+OV_TEST(geodesy, destination_matches_reference)
+{
+    const geo::position origins[] = {geo::position::from_degrees(45.1234567, 5.7654321),
+                                     geo::position::from_degrees(-33.912345, 18.412345),
+                                     geo::position::from_degrees(61.1234567, 10.123456),
+                                     geo::position::from_degrees(-17.512345, 179.91234)};
+    const float         distances[] = {10.f, 1000.f, 25000.f, 100000.f};
+    for (const auto& origin : origins)
+    {
+        for (const float dist : distances)
+        {
+            for (float bearing = 0.f; bearing < 360.f; bearing += 45.f)
+            {
+                // Absolute error below 10cm up to 100km, measured with the reference distance
+                double lat = 0.;
+                double lon = 0.;
+                reference::destination(origin, static_cast<double>(bearing), static_cast<double>(dist), lat, lon);
+                const geo::position actual = geo::destination(origin, bearing, dist);
+                OV_CHECK(reference::distance(actual, geo::position::from_degrees(lat, lon)) <= 0.1);
+            }
+        }
+    }
+}
+
+OV_TEST(geodesy, destination_roundtrip)
+{
+    // Going to the destination and measuring the distance and bearing back gives the inputs
+    const geo::position origin = geo::position::from_degrees(45.1234567, 5.7654321);
+    for (float bearing = 10.f; bearing < 360.f; bearing += 40.f)
+    {
+        const geo::position dest = geo::destination(origin, bearing, 5000.f);
+        OV_CHECK_NEAR(geo::distance(origin, dest), 5000., 0.1);
+        OV_CHECK_NEAR(geo::bearing(origin, dest), bearing, 0.01);
+    }
+}
+
+OV_TEST(geodesy, flat_projection_roundtrip)
+{
+    const geo::flat_projection projection(geo::position::from_degrees(45.1234567, 5.7654321));
+    for (const auto& pair : s_pairs)
+    {
+        if (reference::distance(projection.get_reference(), pair.to) <= 20000.)
+        {
+            // Projected distance close to the great circle distance and back projection exact to a few units
+            float x = 0.f;
+            float y = 0.f;
+            projection.to_xy(pair.to, x, y);
+            const double expected = reference::distance(projection.get_reference(), pair.to);
+            OV_CHECK(std::fabs(std::sqrt(x * x + y * y) - expected) <= std::max(0.05, expected * 1e-3));
+            const geo::position back = projection.from_xy(x, y);
+            OV_CHECK(std::abs(back.latitude - pair.to.latitude) <= 2);
+            OV_CHECK(std::abs(back.longitude - pair.to.longitude) <= 2);
+        }
+    }
+}
+
+OV_TEST(geodesy, wrap_longitude)
+{
+    constexpr int64_t DEG = geo::UNITS_PER_DEGREE;
+    OV_CHECK_EQ(geo::wrap_longitude(10 * DEG), 10 * DEG);
+    OV_CHECK_EQ(geo::wrap_longitude(190 * DEG), -170 * DEG);
+    OV_CHECK_EQ(geo::wrap_longitude(-190 * DEG), 170 * DEG);
+    OV_CHECK_EQ(geo::wrap_longitude(180 * DEG), 180 * DEG);
+}
+
+/** @brief Number of iterations of the benchmarks */
+static constexpr uint32_t BENCH_ITERATIONS = 1000000u;
+
+/** @brief Number of test vectors */
+static constexpr uint32_t PAIRS_COUNT = sizeof(s_pairs) / sizeof(s_pairs[0]);
+
+OV_BENCHMARK(geodesy, distance)
+{
+    test::stopwatch watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(geo::fast_distance(pair.from, pair.to));
+    }
+    const double fast_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(geo::distance(pair.from, pair.to));
+    }
+    const double haversine_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(reference::distance(pair.from, pair.to));
+    }
+    const double reference_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    test::report_result("fast_distance", fast_ns, "ns/call");
+    test::report_result("distance", haversine_ns, "ns/call");
+    test::report_result("double reference", reference_ns, "ns/call");
+
+    // Worst relative error over the test vectors
+    double worst_error = 0.;
+    for (const auto& pair : s_pairs)
+    {
+        const double expected = reference::distance(pair.from, pair.to);
+        worst_error           = std::max(worst_error, std::fabs(geo::distance(pair.from, pair.to) - expected) / expected);
+    }
+    test::report_result("distance worst relative error", worst_error * 1e6, "ppm");
+}
+
+OV_BENCHMARK(geodesy, bearing)
+{
+    test::stopwatch watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(geo::bearing(pair.from, pair.to));
+    }
+    const double bearing_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(reference::bearing(pair.from, pair.to));
+    }
+    const double reference_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    test::report_result("bearing", bearing_ns, "ns/call");
+    test::report_result("double reference", reference_ns, "ns/call");
+}
+
+OV_BENCHMARK(geodesy, destination)
+{
+    test::stopwatch watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        const auto& pair = s_pairs[i % PAIRS_COUNT];
+        test::keep(geo::destination(pair.from, static_cast<float>(i % 360u), 25000.f));
+    }
+    const double destination_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    test::report_result("destination", destination_ns, "ns/call");
+
+    // Worst error over 100km in all directions
+    double              worst_error = 0.;
+    const geo::position origin      = s_pairs[0].from;
+    for (uint32_t bearing = 0; bearing < 360u; bearing++)
+    {
+        double lat = 0.;
+        double lon = 0.;
+        reference::destination(origin, static_cast<double>(bearing), 100000., lat, lon);
+        const geo::position actual = geo::destination(origin, static_cast<float>(bearing), 100000.f);
+        worst_error                = std::max(worst_error, reference::distance(actual, geo::position::from_degrees(lat, lon)));
+    }
+    test::report_result("destination worst error at 100km", worst_error, "m");
+}
@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2023 open-vario
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "date_time.h"
+#include "ov_test.h"
+#include "random_generator.h"
+#include "text_writer.h"
+
+#include <cinttypes>
+#include <cstring>
+#include <pthread.h>
+
+using namespace ov;
+
+/** @brief Number of random samples of the comparison with snprintf */
+static constexpr uint32_t SAMPLE_COUNT = 20000u;
+
+/** @brief Number of iterations of the benchmarks */
+static constexpr uint32_t BENCH_ITERATIONS = 1000000u;
+
+/** @brief Size of the stack of the measurement threads */
+static constexpr size_t PROBE_STACK_SIZE = 256u * 1024u;
+
+/** @brief Value used to paint the stack of the measurement threads */
+static constexpr uint8_t STACK_PAINT = 0xA5u;
+
+/** @brief Size of the formatted strings */
+static constexpr size_t STRING_SIZE = 64u;
+
+/** @brief Values displayed by the screens and sent by the links */
+struct sample
+{
+    /** @brief Sink rate (0.1m/s) */
+    int16_t sink_rate;
+    /** @brief Glide ratio (0.1) */
+    uint16_t glide_ratio;
+    /** @brief Speed (0.1m/s) */
+    uint32_t speed;
+    /** @brief Number of satellites */
+    uint8_t satellite_count;
+    /** @brief GNSS date */
+    date_time date;
+    /** @brief Pressure (Pa) */
+    int32_t pressure;
+    /** @brief Temperature (0.1°C) */
+    int16_t temperature;
+    /** @brief Total acceleration (0.001g) */
+    int16_t total_accel;
+};
+
+/** @brief Strings formatted by the HMI thread on each refresh */
+struct hmi_strings
+{
+    /** @brief Sink rate */
+    char sink_rate[STRING_SIZE];
+    /** @brief Glide ratio */
+    char glide_ratio[STRING_SIZE];
+    /** @brief Speed */
+    char speed[STRING_SIZE];
+    /** @brief Signal status */
+    char signal_status[STRING_SIZE];
+    /** @brief Date and time */
+    char date_time[STRING_SIZE];
+};
+
+/** @brief Frames formatted by the XCTrack link thread */
+struct link_frames
+{
+    /** @brief LK8EX1 frame */
+    char lk8000[STRING_SIZE];
+    /** @brief XCTOD frame */
+    char xctod[STRING_SIZE];
+};
+
+/** @brief Generate a random sample */
+static sample random_sample(test::random_generator& random)
+{
+    sample s;
+    s.sink_rate       = static_cast<int16_t>(static_cast<int32_t>(random.uniform(0u, 200u)) - 100);
+    s.glide_ratio     = static_cast<uint16_t>(random.uniform(0u, 999u));
+    s.speed           = random.uniform(0u, 2700u);
+    s.satellite_count = static_cast<uint8_t>(random.uniform(0u, 24u));
+    s.date.year       = static_cast<uint8_t>(random.uniform(23u, 99u));
+    s.date.month      = static_cast<uint8_t>(random.uniform(1u, 12u));
+    s.date.day        = static_cast<uint8_t>(random.uniform(1u, 31u));
+    s.date.hour       = static_cast<uint8_t>(random.uniform(0u, 23u));
+    s.date.minute     = static_cast<uint8_t>(random.uniform(0u, 59u));
+    s.date.second     = static_cast<uint8_t>(random.uniform(0u, 59u));
+    s.date.millis     = 0u;
+    s.pressure        = static_cast<int32_t>(random.uniform(50000u, 105000u));
+    s.temperature     = static_cast<int16_t>(static_cast<int32_t>(random.uniform(0u, 800u)) - 300);
+    s.total_accel     = static_cast<int16_t>(random.uniform(0u, 9999u));
+    return s;
+}
+
+/** @brief Fixed sample used by the benchmarks and the stack measurements */
+static const sample s_sample = {-23, 87u, 1042u, 9u, {24u, 7u, 14u, 13u, 5u, 42u, 0u}, 87654, -15, 1234};
+
+/** @brief Formats of the HMI refresh with snprintf, as before the migration */
+static void snprintf_hmi(const sample& s, hmi_strings& strings)
+{
+    const char    sign          = (s.sink_rate < 0) ? '-' : '+';
+    const int16_t sink_rate     = static_cast<int16_t>(abs(s.sink_rate));
+    const int16_t sink_rate_int = static_cast<int16_t>(sink_rate / 10);
+    snprintf(strings.sink_rate, sizeof(strings.sink_rate), "SR: %c%02d.%dm/s", sign, sink_rate_int, sink_rate - sink_rate_int * 10);
+    snprintf(strings.glide_ratio, sizeof(strings.glide_ratio), "GR: %02d.%d", s.glide_ratio / 10, s.glide_ratio % 10);
+    const uint32_t speed_damh = s.speed * 36u;
+    snprintf(strings.speed,
+             sizeof(strings.speed),
+             "SP: %03" PRIu32 ".%" PRIu32 "km/h",
+             speed_damh / 100u,
+             (speed_damh - (speed_damh / 100u) * 100u) / 10u);
+    snprintf(strings.signal_status, sizeof(strings.signal_status), "%02d sat(s)", static_cast<int>(s.satellite_count));
+    snprintf(strings.date_time,
+             sizeof(strings.date_time),
+             "%04d-%02d-%02dT%02d:%02d:%02dZ",
+             static_cast<int>(s.date.year) + 2000,
+             static_cast<int>(s.date.month),
+             static_cast<int>(s.date.day),
+             static_cast<int>(s.date.hour),
+             static_cast<int>(s.date.minute),
+             static_cast<int>(s.date.second));
+}
+
+/** @brief Formats of the HMI refresh with the text writer, as in the screens */
+static void writer_hmi(const sample& s, hmi_strings& strings)
+{
+    text_writer(strings.sink_rate).write("SR: ").write_fixed(s.sink_rate, 1u, 2u, true).write("m/s");
+    text_writer(strings.glide_ratio).write("GR: ").write_fixed(s.glide_ratio, 1u, 2u);
+    const uint32_t speed_damh = s.speed * 36u;
+    text_writer(strings.speed).write("SP: ").write_fixed(speed_damh / 10u, 1u, 3u).write("km/h");
+    text_writer(strings.signal_status).write_int(s.satellite_count, 2u).write(" sat(s)");
+    text_writer date_time(strings.date_time);
+    date_time.write_int(s.date.year + 2000, 4u).write('-').write_int(s.date.month, 2u).write('-').write_int(s.date.day, 2u);
+    date_time.write('T').write_int(s.date.hour, 2u).write(':').write_int(s.date.minute, 2u);
+    date_time.write(':').write_int(s.date.second, 2u).write('Z');
+}
+
+/** @brief Frames of the XCTrack link with snprintf, as before the migration with a 2 digits checksum */
+static void snprintf_link(const sample& s, link_frames& frames)
+{
+    const int size     = snprintf(frames.lk8000, sizeof(frames.lk8000), "$LK8EX1,%d,99999,9999,%d,999,", s.pressure, s.temperature / 10);
+    uint8_t   checksum = 0u;
+    for (int i = 1; i < size; i++)
+    {
+        checksum ^= static_cast<uint8_t>(frames.lk8000[i]);
+    }
+    snprintf(&frames.lk8000[size], sizeof(frames.lk8000) - static_cast<size_t>(size), "*%02X\r\n", static_cast<int>(checksum));
+
+    const int16_t accel = static_cast<int16_t>(s.total_accel / 1000);
+    const int16_t part  = static_cast<int16_t>((s.total_accel - accel * 1000) / 10);
+    snprintf(frames.xctod, sizeof(frames.xctod), "$XCTOD,%d.%02d,%d\r\n", accel, part, s.temperature / 10);
+}
+
+/** @brief Frames of the XCTrack link with the text writer, as in the link */
+static void writer_link(const sample& s, link_frames& frames)
+{
+    text_writer lk8000(frames.lk8000);
+    lk8000.write("$LK8EX1,").write_int(s.pressure).write(",99999,9999,").write_int(s.temperature / 10).write(",999,");
+    uint8_t checksum = 0u;
+    for (size_t i = 1u; i < lk8000.size(); i++)
+    {
+        checksum ^= static_cast<uint8_t>(frames.lk8000[i]);
+    }
+    lk8000.write('*').write_hex(checksum, 2u).write("\r\n");
+
+    text_writer(frames.xctod).write("$XCTOD,").write_fixed(s.total_accel / 10, 2u).write(',').write_int(s.temperature / 10).write("\r\n");
+}
+
+/** @brief Flight file path of the recorder with snprintf, as before the migration */
+static void snprintf_recorder(const sample& s, char (&path)[STRING_SIZE])
+{
+    snprintf(path,
+             sizeof(path),
+             "%s/%04d-%02d-%02dT%02d-%02d-%02d%s",
+             "/flights",
+             static_cast<int>(s.date.year) + 2000,
+             static_cast<int>(s.date.month),
+             static_cast<int>(s.date.day),
+             static_cast<int>(s.date.hour),
+             static_cast<int>(s.date.minute),
+             static_cast<int>(s.date.second),
+             ".rec");
+}
+
+/** @brief Flight file path of the recorder with the text writer, as in the recorder */
+static void writer_recorder(const sample& s, char (&path)[STRING_SIZE])
+{
+    text_writer writer(path);
+    writer.write("/flights").write('/');
+    writer.write_int(s.date.year + 2000, 4u).write('-').write_int(s.date.month, 2u).write('-').write_int(s.date.day, 2u);
+    writer.write('T').write_int(s.date.hour, 2u).write('-').write_int(s.date.minute, 2u).write('-').write_int(s.date.second, 2u);
+    writer.write(".rec");
+}
+
+/** @brief Function run by a stack measurement thread */
+using probe_func = void (*)();
+
+/** @brief Entry point of a stack measurement thread */
+static void* probe_entry(void* arg)
+{
+    (*static_cast<probe_func*>(arg))();
+    return nullptr;
+}
+
+/**
+ * @brief Measure the peak stack usage of a function in bytes
+ *        The function runs in a thread whose stack has been painted with a known value, as the RTOS
+ *        does to compute the high water mark of the task stacks. The thread and libc overheads are included.
+ */
+static size_t measure_stack(probe_func func)
+{
+    alignas(64) static uint8_t stack[PROBE_STACK_SIZE];
+    memset(stack, STACK_PAINT, sizeof(stack));
+
+    pthread_attr_t attr;
+    pthread_t      thread;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, sizeof(stack));
+    const bool started = (pthread_create(&thread, &attr, &probe_entry, &func) == 0);
+    if (started)
+    {
+        pthread_join(thread, nullptr);
+    }
+    pthread_attr_destroy(&attr);
+    OV_CHECK(started);
+
+    // The stack grows downwards, untouched bytes are at the lowest addresses
+    size_t untouched = 0u;
+    while ((untouched < sizeof(stack)) && (stack[untouched] == STACK_PAINT))
+    {
+        untouched++;
+    }
+    return (sizeof(stack) - untouched);
+}
+
+/** @brief Stack measurement of an empty function to subtract the thread and libc overheads */
+static void probe_empty() { }
+
+/** @brief Stack measurement of the HMI refresh with snprintf */
+static void probe_snprintf_hmi()
+{
+    hmi_strings strings;
+    snprintf_hmi(s_sample, strings);
+    test::keep(strings);
+}
+
+/** @brief Stack measurement of the HMI refresh with the text writer */
+static void probe_writer_hmi()
+{
+    hmi_strings strings;
+    writer_hmi(s_sample, strings);
+    test::keep(strings);
+}
+
+/** @brief Stack measurement of the XCTrack link with snprintf */
+static void probe_snprintf_link()
+{
+    link_frames frames;
+    snprintf_link(s_sample, frames);
+    test::keep(frames);
+}
+
+/** @brief Stack measurement of the XCTrack link with the text writer */
+static void probe_writer_link()
+{
+    link_frames frames;
+    writer_link(s_sample, frames);
+    test::keep(frames);
+}
+
+/** @brief Stack measurement of the recorder with snprintf */
+static void probe_snprintf_recorder()
+{
+    char path[STRING_SIZE];
+    snprintf_recorder(s_sample, path);
+    test::keep(path);
+}
+
+/** @brief Stack measurement of the recorder with the text writer */
+static void probe_writer_recorder()
+{
+    char path[STRING_SIZE];
+    writer_recorder(s_sample, path);
+    test::keep(path);
+}
+
+/** @brief Measure and report the stack usage of a thread formatting path with both implementations */
+static void report_stack(const char* thread_name, probe_func snprintf_probe, probe_func writer_probe)
+{
+    const size_t overhead       = measure_stack(&probe_empty);
+    const size_t snprintf_stack = measure_stack(snprintf_probe) - overhead;
+    const size_t writer_stack   = measure_stack(writer_probe) - overhead;
+    OV_CHECK(writer_stack < snprintf_stack);
+
+    char name[STRING_SIZE];
+    text_writer(name).write(thread_name).write(" snprintf");
+    test::report_result(name, static_cast<double>(snprintf_stack), "bytes");
+    text_writer(name).write(thread_name).write(" text_writer");
+    test::report_result(name, static_cast<double>(writer_stack), "bytes");
+    text_writer(name).write(thread_name).write(" saved");
+    test::report_result(name, static_cast<double>(snprintf_stack - writer_stack), "bytes");
+}
+
+OV_TEST(text_writer, values)
+{
+    char buffer[STRING_SIZE];
+
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_int(0).c_str(), "0"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_int(-42, 4u).c_str(), "-0042"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_int(42u, 0u, true).c_str(), "+42"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_int(INT32_MIN).c_str(), "-2147483648"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_int(UINT32_MAX).c_str(), "4294967295"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_fixed(-5, 1u).c_str(), "-0.5"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_fixed(1205, 3u, 2u).c_str(), "01.205"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_fixed(int16_t(-32768), 2u).c_str(), "-327.68"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_fixed(7, 12u).c_str(), "0.000000007"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_hex(uint8_t(0x0Au), 2u).c_str(), "0A"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write_hex(UINT32_MAX).c_str(), "FFFFFFFF"), 0);
+    OV_CHECK_EQ(strcmp(text_writer(buffer).write('a').write("bc").write_int(1).c_str(), "abc1"), 0);
+}
+
+OV_TEST(text_writer, fixed_matches_snprintf)
+{
+    test::random_generator random(0x5EEDu);
+    char                   expected[STRING_SIZE];
+    char                   buffer[STRING_SIZE];
+    for (uint32_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        const int32_t value    = static_cast<int32_t>(random.uniform(0u, 2000000u)) - 1000000;
+        const uint8_t decimals = static_cast<uint8_t>(random.uniform(0u, 4u));
+        const uint8_t digits   = static_cast<uint8_t>(random.uniform(0u, 6u));
+        const bool    plus     = random.chance(0.5f);
+
+        // Sign, integer part with zero padding and decimals
+        uint32_t scale = 1u;
+        for (uint8_t d = 0u; d < decimals; d++)
+        {
+            scale *= 10u;
+        }
+        const uint32_t magnitude = static_cast<uint32_t>((value < 0) ? -value : value);
+        const char*    sign      = (value < 0) ? "-" : (plus ? "+" : "");
+        if (decimals == 0u)
+        {
+            snprintf(expected, sizeof(expected), "%s%0*" PRIu32, sign, digits, magnitude);
+        }
+        else
+        {
+            const uint32_t integer = magnitude / scale;
+            snprintf(expected, sizeof(expected), "%s%0*" PRIu32 ".%0*" PRIu32, sign, digits, integer, decimals, magnitude % scale);
+        }
+
+        text_writer writer(buffer);
+        writer.write_fixed(value, decimals, digits, plus);
+        OV_CHECK_EQ(strcmp(writer.c_str(), expected), 0);
+        OV_CHECK_EQ(writer.size(), strlen(expected));
+        OV_CHECK(!writer.is_truncated());
+    }
+}
+
+OV_TEST(text_writer, call_sites_match_snprintf)
+{
+    test::random_generator random(0xCA11u);
+    for (uint32_t i = 0; i < SAMPLE_COUNT; i++)
+    {
+        const sample s = random_sample(random);
+
+        hmi_strings expected_strings;
+        hmi_strings strings;
+        snprintf_hmi(s, expected_strings);
+        writer_hmi(s, strings);
+        OV_CHECK_EQ(strcmp(strings.sink_rate, expected_strings.sink_rate), 0);
+        OV_CHECK_EQ(strcmp(strings.glide_ratio, expected_strings.glide_ratio), 0);
+        OV_CHECK_EQ(strcmp(strings.speed, expected_strings.speed), 0);
+        OV_CHECK_EQ(strcmp(strings.signal_status, expected_strings.signal_status), 0);
+        OV_CHECK_EQ(strcmp(strings.date_time, expected_strings.date_time), 0);
+
+        link_frames expected_frames;
+        link_frames frames;
+        snprintf_link(s, expected_frames);
+        writer_link(s, frames);
+        OV_CHECK_EQ(strcmp(frames.lk8000, expected_frames.lk8000), 0);
+        OV_CHECK_EQ(strcmp(frames.xctod, expected_frames.xctod), 0);
+
+        char expected_path[STRING_SIZE];
+        char path[STRING_SIZE];
+        snprintf_recorder(s, expected_path);
+        writer_recorder(s, path);
+        OV_CHECK_EQ(strcmp(path, expected_path), 0);
+    }
+}
+
+OV_TEST(text_writer, truncation)
+{
+    // Text is truncated and stays null terminated
+    char        small[6u];
+    text_writer writer(small);
+    writer.write("SR: ").write_fixed(-123, 1u);
+    OV_CHECK(writer.is_truncated());
+    OV_CHECK_EQ(writer.size(), 5u);
+    OV_CHECK_EQ(strcmp(small, "SR: -"), 0);
+
+    // Nothing is written in an empty buffer
+    char        empty[1u] = {'x'};
+    text_writer empty_writer(empty, 0u);
+    empty_writer.write('a');
+    OV_CHECK(empty_writer.is_truncated());
+    OV_CHECK_EQ(empty_writer.size(), 0u);
+    OV_CHECK_EQ(empty[0u], 'x');
+}
+
+OV_TEST(text_writer, stack_usage)
+{
+    // Peak stack of the formatting path of each migrated thread, the host libc is not newlib
+    // so the absolute values differ on the target but the order of magnitude is kept
+    report_stack("HMI refresh", &probe_snprintf_hmi, &probe_writer_hmi);
+    report_stack("XCTrack link", &probe_snprintf_link, &probe_writer_link);
+    report_stack("Flight recorder", &probe_snprintf_recorder, &probe_writer_recorder);
+}
+
+OV_BENCHMARK(text_writer, call_sites)
+{
+    hmi_strings strings;
+    link_frames frames;
+    char        path[STRING_SIZE];
+    sample      s = s_sample;
+
+    test::stopwatch watch;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.sink_rate = static_cast<int16_t>(static_cast<int32_t>(i % 200u) - 100);
+        snprintf_hmi(s, strings);
+        test::keep(strings);
+    }
+    const double snprintf_hmi_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.sink_rate = static_cast<int16_t>(static_cast<int32_t>(i % 200u) - 100);
+        writer_hmi(s, strings);
+        test::keep(strings);
+    }
+    const double writer_hmi_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.pressure = 80000 + static_cast<int32_t>(i % 20000u);
+        snprintf_link(s, frames);
+        test::keep(frames);
+    }
+    const double snprintf_link_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.pressure = 80000 + static_cast<int32_t>(i % 20000u);
+        writer_link(s, frames);
+        test::keep(frames);
+    }
+    const double writer_link_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.date.second = static_cast<uint8_t>(i % 60u);
+        snprintf_recorder(s, path);
+        test::keep(path);
+    }
+    const double snprintf_recorder_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+    watch.restart();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        s.date.second = static_cast<uint8_t>(i % 60u);
+        writer_recorder(s, path);
+        test::keep(path);
+    }
+    const double writer_recorder_ns = watch.elapsed_ns() / BENCH_ITERATIONS;
+
+    test::report_result("HMI refresh snprintf", snprintf_hmi_ns, "ns/refresh");
+    test::report_result("HMI refresh text_writer", writer_hmi_ns, "ns/refresh");
+    test::report_result("XCTrack link snprintf", snprintf_link_ns, "ns/frames");
+    test::report_result("XCTrack link text_writer", writer_link_ns, "ns/frames");
+    test::report_result("Flight recorder snprintf", snprintf_recorder_ns, "ns/path");
+    test::report_result("Flight recorder text_writer", writer_recorder_ns, "ns/path");
+}
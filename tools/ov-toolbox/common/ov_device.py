@@ -3,8 +3,11 @@
 import serial
 import struct
 from .ov_requests import *
-from .ov_protocol import OvProtocol
-from .ov_flight import OvDateTime, OvFlight, OvFlightEntry
+from .ov_protocol import OvProtocol, OV_PROTOCOL_V1, OV_PROTOCOL_VERSION
+from .ov_flight import OvDateTime, OvFlight, OvFlightEntry, OvFlightSummary
+
+# Size of the data chunks when uploading a file
+OV_UPLOAD_CHUNK_SIZE = 4096
 
 
 class OvDevice(object):
@@ -21,8 +24,10 @@ class OvDevice(object):
 
         device_infos = None
 
-        # Send request
-        response = self.__protocol.send_request(OV_REQ_ID_DEVICE_INFO)
+        # Send request with the latest supported protocol version, legacy firmwares ignore it
+        self.__protocol.set_version(OV_PROTOCOL_V1)
+        response = self.__protocol.send_request(
+            OV_REQ_ID_DEVICE_INFO, bytearray([OV_PROTOCOL_VERSION]))
         if response:
             try:
                 # Decode response
@@ -31,13 +36,19 @@ class OvDevice(object):
                 device_infos.name, i = self.__read_string(response, i)
                 device_infos.hw_version, i = self.__read_string(response, i)
                 device_infos.fw_version, i = self.__read_string(response, i)
+                if i < len(response):
+                    device_infos.protocol_version = response[i]
             except:
                 device_infos = None
 
+        # Use the negotiated protocol version for the next frames
+        if device_infos:
+            self.__protocol.set_version(device_infos.protocol_version)
+
         return device_infos
 
-    def get_flight_list(self) -> [(str, int)]:
-        ''' Get the list of the recorded flights '''
+    def get_flight_list(self) -> [OvFlightSummary]:
+        ''' Get the list of the recorded flights from the flight catalog '''
 
         flight_list = None
 
@@ -49,23 +60,26 @@ class OvDevice(object):
                 i = 0
                 accepted, i = self.__read_bool(response, i)
                 if accepted:
-                    # Read list of flights
+                    # Read packets of flight summaries
+                    count, i = self.__read_uint(response, 2, i)
                     has_more_data = True
                     flight_list = []
                     while has_more_data:
 
-                        # Ask for next item
+                        # Ask for next packet
                         response = self.__protocol.send_request(
                             OV_REQ_ID_LIST_FLIGHTS_DATA)
                         if response:
                             i = 0
                             has_more_data, i = self.__read_bool(response, i)
-                            if has_more_data:
-                                flight, i = self.__read_string(response, i)
-                                size, i = self.__read_uint(response, 4, i)
-                                flight_list.append((flight, size))
+                            while has_more_data and (i < len(response)):
+                                flight, i = self.__read_flight_summary(
+                                    response, i)
+                                flight_list.append(flight)
                         else:
                             has_more_data = False
+                    if len(flight_list) != count:
+                        flight_list = None
             except:
                 flight_list = None
 
@@ -121,6 +135,102 @@ class OvDevice(object):
 
         return flight
 
+    def upload_airspaces(self, openair_data: bytes) -> bool:
+        ''' Upload an OpenAir file and start its import into the airspace database '''
+
+        #  Prepare request
+        request = bytearray()
+        request.extend(self.__write_int(len(openair_data), 4))
+
+        return self.__upload(OV_REQ_ID_UPLOAD_AIRSPACES, OV_REQ_ID_UPLOAD_AIRSPACES_DATA, request, openair_data)
+
+    def upload_terrain(self, latitude: int, longitude: int, tile_data: bytes) -> bool:
+        ''' Upload a terrain tile with the given south west corner '''
+
+        #  Prepare request
+        request = bytearray()
+        request.extend(self.__write_int(len(tile_data), 4))
+        request.extend(self.__write_int(latitude, 2))
+        request.extend(self.__write_int(longitude, 2))
+
+        return self.__upload(OV_REQ_ID_UPLOAD_TERRAIN, OV_REQ_ID_UPLOAD_TERRAIN_DATA, request, tile_data)
+
+    def start_stream(self) -> bool:
+        ''' Start streaming the sensor records '''
+
+        ret = False
+
+        # Send request
+        response = self.__protocol.send_request(OV_REQ_ID_STREAM_START)
+        if response:
+            ret, i = self.__read_bool(response, 0)
+
+        return ret
+
+    def read_stream(self) -> (int, bytearray):
+        ''' Wait for the next packet of sensor records, returns the number of dropped records and the records '''
+
+        dropped = None
+        records = None
+
+        # Wait frame
+        frame = self.__protocol.receive(OV_REQ_ID_STREAM_DATA)
+        if frame:
+            dropped, i = self.__read_uint(frame, 4, 0)
+            records = frame[i:]
+
+        return dropped, records
+
+    def stop_stream(self) -> OvStreamStats:
+        ''' Stop streaming the sensor records '''
+
+        stats = None
+
+        # Send request
+        response = self.__protocol.send_request(OV_REQ_ID_STREAM_STOP)
+        if response:
+            try:
+                # Decode response
+                i = 1
+                stats = OvStreamStats()
+                stats.records, i = self.__read_uint(response, 4, i)
+                stats.dropped, i = self.__read_uint(response, 4, i)
+                stats.frames, i = self.__read_uint(response, 4, i)
+            except:
+                stats = None
+
+        return stats
+
+    def __upload(self, request_id: int, data_request_id: int, request: bytearray, data: bytes) -> bool:
+        ''' Send an upload request followed by the file contents '''
+
+        ret = False
+
+        # Send request
+        response = self.__protocol.send_request(request_id, request)
+        if response:
+            try:
+                # Decode response
+                i = 0
+                accepted, i = self.__read_bool(response, i)
+                if accepted:
+                    # Send file contents
+                    ret = True
+                    index = 0
+                    while ret and (index < len(data)):
+                        chunk = data[index:(index + OV_UPLOAD_CHUNK_SIZE)]
+                        response = self.__protocol.send_request(
+                            data_request_id, chunk)
+                        if response:
+                            ret, i = self.__read_bool(response, 0)
+                        else:
+                            ret = False
+                        index += len(chunk)
+            except:
+                ret = False
+
+        return ret
+
     def __read_bool(self, frame: bytearray, index: int) -> (bool, int):
         if frame[index] == 0:
             bool = False
@@ -206,6 +316,24 @@ class OvDevice(object):
 
         return datetime, index
 
+    def __read_flight_summary(self, frame: bytearray, index: int) -> (OvFlightSummary, int):
+        flight = OvFlightSummary()
+
+        flight.name, index = self.__read_string(frame, index)
+        flight.size, index = self.__read_uint(frame, 4, index)
+        flight.start, index = self.__read_datetime(frame, index)
+        flight.airtime, index = self.__read_uint(frame, 4, index)
+        flight.distance, index = self.__read_uint(frame, 4, index)
+        flight.max_speed, index = self.__read_uint(frame, 4, index)
+        flight.max_altitude, index = self.__read_int(frame, 4, index)
+        flight.min_altitude, index = self.__read_int(frame, 4, index)
+        flight.max_climb, index = self.__read_int(frame, 2, index)
+        flight.max_sink, index = self.__read_int(frame, 2, index)
+        flight.thermal_count, index = self.__read_uint(frame, 2, index)
+        flight.glider, index = self.__read_string(frame, index)
+
+        return flight, index
+
     def __read_flight_entry(self, frame: bytearray, index: int) -> (OvFlightEntry, int):
         entry = OvFlightEntry()
 
@@ -39,6 +39,38 @@ class OvFlightHeader:
         self.period = 0
 
 
+class OvFlightSummary:
+    """ Summary of a recorded flight """
+
+    def __init__(self) -> None:
+        """ Constructor """
+
+        # Name of the flight file
+        self.name = ""
+        # Size of the flight file in bytes
+        self.size = 0
+        # Start of the flight
+        self.start = OvDateTime()
+        # Airtime in seconds
+        self.airtime = 0
+        # Distance along the track (1 = 1m)
+        self.distance = 0
+        # Maximum GNSS speed (1 = 0.1m/s)
+        self.max_speed = 0
+        # Maximum barometric altitude (1 = 0.1m)
+        self.max_altitude = 0
+        # Minimum barometric altitude (1 = 0.1m)
+        self.min_altitude = 0
+        # Maximum climb rate (1 = 0.1m/s)
+        self.max_climb = 0
+        # Maximum sink rate, negative when sinking (1 = 0.1m/s)
+        self.max_sink = 0
+        # Number of thermals
+        self.thermal_count = 0
+        # Glider
+        self.glider = ""
+
+
 class OvFlightGnssData:
     """ Recorded flight GNSS data """
 
@@ -1,5 +1,6 @@
 # -*- coding: utf-8 -*-
 
+import binascii
 import serial
 
 # Start of frame
@@ -12,6 +13,13 @@ OV_MAINT_SOF = [OV_MAINT_SOF_1, OV_MAINT_SOF_2, OV_MAINT_SOF_3, OV_MAINT_SOF_4]
 # Header of a frame size in bytes (SOF + ID + LEN)
 OV_FRAME_HEADER_SIZE = 4 + 1 + 2
 
+# Legacy protocol version, frames are protected by an additive checksum
+OV_PROTOCOL_V1 = 1
+# Protocol version 2, frames are protected by a CRC-16/CCITT-FALSE
+OV_PROTOCOL_V2 = 2
+# Latest protocol version supported by the toolbox
+OV_PROTOCOL_VERSION = OV_PROTOCOL_V2
+
 
 class OvProtocol(object):
     """ Implement OpenVario maintenance protocol """
@@ -34,6 +42,12 @@ class OvProtocol(object):
         self.__rx_frame = []
         # CRC of the currently receiving frame
         self.__rx_frame_crc = 0
+        # Protocol version, the device infos request is always sent with the legacy version
+        self.__version = OV_PROTOCOL_V1
+
+    def set_version(self, version: int) -> None:
+        """ Set the protocol version negotiated with the device, it applies to the next frames """
+        self.__version = version
 
     def send_request(self, req_id: int, payload=bytearray(0)) -> bytearray:
         """ Send a request to the device and wait for its response """
@@ -47,6 +61,10 @@ class OvProtocol(object):
 
         return resp
 
+    def receive(self, req_id: int) -> bytearray:
+        """ Wait for a frame sent by the device without request """
+        return self.__wait_response(req_id)
+
     def __send(self, req_id: int, payload=bytearray(0)) -> bool:
         """ Send a request to the device """
 
@@ -58,9 +76,9 @@ class OvProtocol(object):
         # Id             => 1 byte
         # Size           => 2 bytes (LE)
         # Payload        => 0 to 5000 bytes
-        # Checksum       => 2 bytes (LE)
+        # CRC            => 2 bytes (LE)
 
-        frame = bytearray(9 + len(payload))
+        frame = bytearray(OV_FRAME_HEADER_SIZE + len(payload) + 2)
         frame[0] = OV_MAINT_SOF_1
         frame[1] = OV_MAINT_SOF_2
         frame[2] = OV_MAINT_SOF_3
@@ -68,10 +86,8 @@ class OvProtocol(object):
         frame[4] = req_id
         frame[5] = len(payload) & 0xFF
         frame[6] = (len(payload) >> 8) & 0xFF
-        index = 7
-        for i in range(len(payload)):
-            frame[index] = payload[i]
-            index += 1
+        index = OV_FRAME_HEADER_SIZE + len(payload)
+        frame[OV_FRAME_HEADER_SIZE:index] = payload
         crc = self.__compute_crc(frame)
         frame[index] = crc & 0xFF
         frame[index + 1] = (crc >> 8) & 0xFF
@@ -150,8 +166,11 @@ class OvProtocol(object):
         return (byte == OV_MAINT_SOF[state])
 
     def __wait_req_id(self, state: int, req_id: int, byte: int) -> bool:
-        """ Check the reception of the request id """
-        return (byte == req_id)
+        """ Check the reception of the request id, frames with other ids are skipped """
+        ret = None
+        if byte == req_id:
+            ret = True
+        return ret
 
     def __wait_len(self, state: int, req_id: int, byte: int) -> bool:
         """ Check the reception of the length of the frame """
@@ -182,7 +201,7 @@ class OvProtocol(object):
             self.__rx_frame_crc += (byte << 8)
 
             # Check CRC
-            crc = self.__compute_crc(self.__rx_frame) & 0x0000FFFF
+            crc = self.__compute_crc(self.__rx_frame)
             if not (crc == self.__rx_frame_crc):
                 print("Invalid received frame CRC : {}, expected CRC {}".format(crc,
                                                                                 self.__rx_frame_crc))
@@ -190,9 +209,13 @@ class OvProtocol(object):
         return ret
 
     def __compute_crc(self, frame: bytearray) -> int:
-        """ Compute the CRC of a request """
-        crc = 0
-        for i in range(len(frame) - 2):
-            crc = crc + frame[i]
-            crc = crc << 1
+        """ Compute the CRC of a frame, its last 2 bytes are the CRC field """
+        data = bytes(frame[:-2])
+        if self.__version == OV_PROTOCOL_V1:
+            crc = 0
+            for byte in data:
+                crc = ((crc + byte) << 1) & 0xFFFF
+        else:
+            # CRC-16/CCITT-FALSE computed by the table driven C implementation of binascii
+            crc = binascii.crc_hqx(data, 0xFFFF)
         return crc
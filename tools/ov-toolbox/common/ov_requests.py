@@ -7,6 +7,13 @@ OV_REQ_ID_LIST_FLIGHTS = 0x02
 OV_REQ_ID_LIST_FLIGHTS_DATA = 0x03
 OV_REQ_ID_READ_FLIGHT = 0x04
 OV_REQ_ID_READ_FLIGHT_DATA = 0x05
+OV_REQ_ID_UPLOAD_AIRSPACES = 0x06
+OV_REQ_ID_UPLOAD_AIRSPACES_DATA = 0x07
+OV_REQ_ID_UPLOAD_TERRAIN = 0x08
+OV_REQ_ID_UPLOAD_TERRAIN_DATA = 0x09
+OV_REQ_ID_STREAM_START = 0x0A
+OV_REQ_ID_STREAM_STOP = 0x0B
+OV_REQ_ID_STREAM_DATA = 0x0C
 
 
 class OvDeviceInfos:
@@ -21,3 +28,19 @@ class OvDeviceInfos:
         self.hw_version = ""
         # Firmware version
         self.fw_version = ""
+        # Maintenance protocol version
+        self.protocol_version = 1
+
+
+class OvStreamStats:
+    """ Sensor streaming statistics """
+
+    def __init__(self) -> None:
+        """ Constructor """
+
+        # Number of records pushed in the stream
+        self.records = 0
+        # Number of records dropped by the device
+        self.dropped = 0
+        # Number of frames sent
+        self.frames = 0
@@ -0,0 +1,123 @@
+# -*- coding: utf-8 -*-
+
+import struct
+
+# Magic number at the start of a sensor stream capture file
+OV_STREAM_MAGIC = b"OVSTREAM"
+# Version of the sensor stream capture file format
+OV_STREAM_VERSION = 1
+
+# Sensor stream record types
+OV_STREAM_RECORD_BAROMETER = 1
+OV_STREAM_RECORD_ACCELEROMETER = 2
+OV_STREAM_RECORD_GNSS = 3
+OV_STREAM_RECORD_NMEA_SENTENCE = 4
+OV_STREAM_RECORD_FILTERS = 5
+OV_STREAM_RECORD_ACCELEROMETER_BLOCK = 6
+
+# Record header : type, size, sequence number, timestamp in milliseconds
+OV_STREAM_HEADER_FORMAT = "<BBHI"
+OV_STREAM_HEADER_SIZE = struct.calcsize(OV_STREAM_HEADER_FORMAT)
+
+# Record payloads
+OV_STREAM_PAYLOAD_FORMATS = {
+    # Raw pressure (D1), raw temperature (D2), pressure (0.01mbar), altitude (0.1m), temperature (0.1°C), valid
+    OV_STREAM_RECORD_BAROMETER: "<IIiihBx",
+    # Filtered and decimated acceleration on X, Y, Z and total (1000 = 1g), valid
+    OV_STREAM_RECORD_ACCELEROMETER: "<hhhhBx",
+    # Latitude and longitude (1e-7°), speed (0.1m/s), altitude (0.1m), track angle (0.1°), satellites, valid
+    OV_STREAM_RECORD_GNSS: "<iiIIHBB",
+    # Filtered altitude (0.1m), sink rate (0.1m/s), glide ratio (0.1)
+    OV_STREAM_RECORD_FILTERS: "<ihH"
+}
+
+# Accelerometer block : sample period (us), sample count, then X, Y, Z (1000 = 1g) of each sample
+OV_STREAM_ACCEL_BLOCK_HEADER_FORMAT = "<HBx"
+OV_STREAM_ACCEL_BLOCK_SAMPLE_FORMAT = "<hhh"
+
+
+class OvStreamRecord:
+    """ Sensor stream record """
+
+    def __init__(self) -> None:
+        """ Constructor """
+
+        # Record type
+        self.type = 0
+        # Sequence number
+        self.sequence = 0
+        # Timestamp in milliseconds
+        self.timestamp = 0
+        # Decoded values (tuple), NMEA sentence (str) or accelerometer block (sample period, [(x, y, z)])
+        self.values = None
+
+
+def create_stream_file(filepath: str):
+    ''' Create a sensor stream capture file '''
+
+    stream_file = open(filepath, "wb")
+    stream_file.write(OV_STREAM_MAGIC)
+    stream_file.write(struct.pack("<H", OV_STREAM_VERSION))
+
+    return stream_file
+
+
+def decode_accelerometer_block(payload: bytes):
+    ''' Decode an accelerometer block record, the newest sample has been acquired at most one sample period before the record timestamp '''
+
+    sample_period, count = struct.unpack_from(
+        OV_STREAM_ACCEL_BLOCK_HEADER_FORMAT, payload)
+    offset = struct.calcsize(OV_STREAM_ACCEL_BLOCK_HEADER_FORMAT)
+    sample_size = struct.calcsize(OV_STREAM_ACCEL_BLOCK_SAMPLE_FORMAT)
+    samples = []
+    for i in range(count):
+        samples.append(struct.unpack_from(
+            OV_STREAM_ACCEL_BLOCK_SAMPLE_FORMAT, payload, offset + i * sample_size))
+
+    return (sample_period, samples)
+
+
+def decode_stream_records(records: bytes) -> [OvStreamRecord]:
+    ''' Decode the records of a stream data frame or of a capture file '''
+
+    decoded = []
+    index = 0
+    while (index + OV_STREAM_HEADER_SIZE) <= len(records):
+        record = OvStreamRecord()
+        record.type, size, record.sequence, record.timestamp = struct.unpack_from(
+            OV_STREAM_HEADER_FORMAT, records, index)
+        index += OV_STREAM_HEADER_SIZE
+        payload = records[index:(index + size)]
+        index += size
+        if len(payload) != size:
+            # Truncated record
+            break
+        if record.type == OV_STREAM_RECORD_NMEA_SENTENCE:
+            record.values = bytes(payload).decode(errors="replace")
+        elif record.type == OV_STREAM_RECORD_ACCELEROMETER_BLOCK:
+            record.values = decode_accelerometer_block(payload)
+        elif record.type in OV_STREAM_PAYLOAD_FORMATS:
+            record.values = struct.unpack(
+                OV_STREAM_PAYLOAD_FORMATS[record.type], payload)
+        decoded.append(record)
+
+    return decoded
+
+
+def load_stream_file(filepath: str) -> [OvStreamRecord]:
+    ''' Load the records of a sensor stream capture file for replay '''
+
+    records = None
+    try:
+        with open(filepath, "rb") as stream_file:
+            data = stream_file.read()
+        header_size = len(OV_STREAM_MAGIC) + 2
+        if (data[0:len(OV_STREAM_MAGIC)] == OV_STREAM_MAGIC) and \
+                (struct.unpack_from("<H", data, len(OV_STREAM_MAGIC))[0] == OV_STREAM_VERSION):
+            records = decode_stream_records(data[header_size:])
+        else:
+            print("Invalid sensor stream file '{}'".format(filepath))
+    except IOError as ex:
+        print("Unable to read file '{}' => {}".format(filepath, str(ex)))
+
+    return records
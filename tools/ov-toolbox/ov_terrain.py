@@ -0,0 +1,144 @@
+# -*- coding: utf-8 -*-
+
+import os
+import re
+import struct
+import sys
+
+# Terrain tile format
+OV_TERRAIN_MAGIC = 0x7E88A1E5
+OV_TERRAIN_VERSION = 1
+OV_TERRAIN_BLOCK_SIZE = 40
+OV_TERRAIN_ENCODING_RAW = 0
+OV_TERRAIN_ENCODING_DELTA = 1
+OV_TERRAIN_DELTA_ESCAPE = -128
+
+# SRTM void value
+SRTM_VOID = -32768
+
+
+def load_hgt(filename: str):
+    ''' Load an SRTM .hgt file, returns (latitude, longitude, samples per degree, rows) '''
+
+    # South west corner from the file name (ex: N45E005.hgt)
+    match = re.match(r"([NS])(\d{2})([EW])(\d{3})",
+                     os.path.basename(filename).upper())
+    if not match:
+        raise ValueError("Invalid .hgt file name : {}".format(filename))
+    latitude = int(match.group(2)) * (1 if match.group(1) == "N" else -1)
+    longitude = int(match.group(4)) * (1 if match.group(3) == "E" else -1)
+
+    # Big endian samples from north to south, west to east
+    with open(filename, "rb") as f:
+        data = f.read()
+    side = int(round((len(data) / 2) ** 0.5))
+    if side * side * 2 != len(data):
+        raise ValueError("Invalid .hgt file size : {}".format(len(data)))
+    samples = struct.unpack(">{}h".format(side * side), data)
+    rows = [list(samples[i * side:(i + 1) * side]) for i in range(side)]
+
+    # Replace voids with the previous valid sample
+    previous = 0
+    for row in rows:
+        for i in range(side):
+            if row[i] == SRTM_VOID:
+                row[i] = previous
+            previous = row[i]
+
+    return latitude, longitude, side - 1, rows
+
+
+def encode_block(samples: list) -> tuple:
+    ''' Encode a block, returns (encoding, data) keeping the smallest one '''
+
+    # Delta encoding : each sample is relative to the previous one on the row,
+    # the first sample of a row is relative to the first sample of the previous row
+    stride = OV_TERRAIN_BLOCK_SIZE + 1
+    delta = bytearray()
+    for i, sample in enumerate(samples):
+        if i == 0:
+            reference = 0
+        elif (i % stride) == 0:
+            reference = samples[i - stride]
+        else:
+            reference = samples[i - 1]
+        diff = sample - reference
+        if (diff > OV_TERRAIN_DELTA_ESCAPE) and (diff <= 127):
+            delta += struct.pack("<b", diff)
+        else:
+            delta += struct.pack("<bh", OV_TERRAIN_DELTA_ESCAPE, sample)
+
+    raw = struct.pack("<{}h".format(len(samples)), *samples)
+    if len(delta) < len(raw):
+        return OV_TERRAIN_ENCODING_DELTA, bytes(delta)
+    return OV_TERRAIN_ENCODING_RAW, raw
+
+
+def convert_hgt(hgt_file: str, ter_file: str) -> None:
+    ''' Convert an SRTM .hgt file into the Open Vario terrain tile format '''
+
+    latitude, longitude, samples_per_degree, rows = load_hgt(hgt_file)
+    if (samples_per_degree % OV_TERRAIN_BLOCK_SIZE) != 0:
+        raise ValueError(
+            "Unsupported resolution : {} samples per degree".format(samples_per_degree))
+    blocks_per_side = samples_per_degree // OV_TERRAIN_BLOCK_SIZE
+
+    # Encode blocks from north to south, west to east
+    blocks = []
+    for block_row in range(blocks_per_side):
+        for block_column in range(blocks_per_side):
+            first_row = block_row * OV_TERRAIN_BLOCK_SIZE
+            first_column = block_column * OV_TERRAIN_BLOCK_SIZE
+            samples = []
+            for row in rows[first_row:first_row + OV_TERRAIN_BLOCK_SIZE + 1]:
+                samples += row[first_column:first_column +
+                               OV_TERRAIN_BLOCK_SIZE + 1]
+            blocks.append(encode_block(samples))
+
+    # Header, block table then block data
+    header = struct.pack("<IHhhHHH", OV_TERRAIN_MAGIC, OV_TERRAIN_VERSION, latitude, longitude,
+                         samples_per_degree, OV_TERRAIN_BLOCK_SIZE, blocks_per_side)
+    offset = len(header) + len(blocks) * 8
+    table = bytearray()
+    for encoding, data in blocks:
+        table += struct.pack("<IHBB", offset, len(data), encoding, 0)
+        offset += len(data)
+
+    with open(ter_file, "wb") as f:
+        f.write(header)
+        f.write(table)
+        for _, data in blocks:
+            f.write(data)
+
+
+# Entry point
+if __name__ == '__main__':
+
+    exit_code = 1
+
+    print("######################################")
+    print("   OpenVario terrain tile converter")
+    print("######################################")
+    print("")
+
+    # Check args
+    if (len(sys.argv) > 1):
+
+        # Output file has the same name with the .ter extension
+        hgt_file = sys.argv[1]
+        ter_file = os.path.splitext(os.path.basename(hgt_file))[0].upper() + ".ter"
+        if (len(sys.argv) > 2):
+            ter_file = sys.argv[2]
+
+        print("Converting '{}' to '{}'...".format(hgt_file, ter_file))
+        try:
+            convert_hgt(hgt_file, ter_file)
+            print("Done! Upload the tile with : ov_toolbox.py --terrain {}".format(ter_file))
+            exit_code = 0
+        except (IOError, ValueError) as ex:
+            print("Unable to convert tile => {}".format(str(ex)))
+
+    else:
+        print("Usage : ov_terrain.py N45E005.hgt [N45E005.ter]")
+
+    sys.exit(exit_code)
@@ -1,21 +1,54 @@
 # -*- coding: utf-8 -*-
 
 import serial.tools.list_ports
+import struct
 import time
 import sys
 
 from common.ov_device import OvDevice
 from common.ov_flightfile import save_flight
+from common.ov_stream import create_stream_file
 
 # USB VID/PID of OpenVario device
 OV_USB_VID = 0x0483
-OV_USB_PID = 0x5740
+OV_USB_PID = 0x5741
+
+# USB interface of the maintenance port (the first CDC port is used by the flight instruments)
+OV_MAINTENANCE_INTERFACE = 2
+
+
+def find_maintenance_port():
+    """Find the maintenance port among the serial ports of the OpenVario device"""
+    ov_ports = []
+    for port in serial.tools.list_ports.comports():
+        if (port.vid == OV_USB_VID) and (port.pid == OV_USB_PID):
+            # The location ends with the interface number when the OS reports it
+            if port.location and port.location.endswith(".{}".format(OV_MAINTENANCE_INTERFACE)):
+                return port
+            ov_ports.append(port)
+
+    # Otherwise the ports are numbered in interface order
+    if len(ov_ports) > 1:
+        return sorted(ov_ports, key=lambda port: port.device)[-1]
+    return None
+
 
 # Entry point
 if __name__ == '__main__':
 
     exit_code = 1
 
+    # OpenAir file or terrain tile to upload, file to record the sensor stream
+    airspaces_file = None
+    terrain_file = None
+    stream_file = None
+    if (len(sys.argv) > 2) and (sys.argv[1] == "--airspaces"):
+        airspaces_file = sys.argv[2]
+    if (len(sys.argv) > 2) and (sys.argv[1] == "--terrain"):
+        terrain_file = sys.argv[2]
+    if (len(sys.argv) > 2) and (sys.argv[1] == "--stream"):
+        stream_file = sys.argv[2]
+
     print("######################################")
     print("         OpenVario toolbox")
     print("######################################")
@@ -25,11 +58,7 @@ if __name__ == '__main__':
     serial_port = None
     while not serial_port:
         # Listing serial ports
-        serial_ports = serial.tools.list_ports.comports()
-        for port in serial_ports:
-            if (port.vid == OV_USB_VID) and (port.pid == OV_USB_PID):
-                serial_port = port
-                break
+        serial_port = find_maintenance_port()
         if not serial_port:
             print(
                 "No OpenVario device detected, please plug the USB cable and/or reset the device...")
@@ -52,38 +81,85 @@ if __name__ == '__main__':
             print(" - Name : {}".format(device_infos.name))
             print(" - HW version : {}".format(device_infos.hw_version))
             print(" - FW version : {}".format(device_infos.fw_version))
+            print(" - Protocol version : {}".format(device_infos.protocol_version))
 
-            print("")
-            flights = ov_device.get_flight_list()
-            if flights:
-                print("Stored flights : ")
-                flight_id = 0
-                for flight in flights:
-                    print(" {} - {} : {} bytes".format(flight_id,
-                          flight[0], flight[1]))
-                    flight_id += 1
-
+            if airspaces_file:
                 print("")
-                flight_id = -1
-                while flight_id < 0 or flight_id >= len(flights):
-                    try:
-                        flight_id = int(input("Select flight to retrieve : "))
-                    except:
-                        flight_id = -1
-                flight_name = flights[flight_id][0]
-
+                print("Uploading airspaces '{}'...".format(airspaces_file))
+                with open(airspaces_file, "rb") as f:
+                    openair_data = f.read()
+                if ov_device.upload_airspaces(openair_data):
+                    print("Done! Import is in progress on the device")
+                    exit_code = 0
+                else:
+                    print("Unable to upload airspaces")
+            elif terrain_file:
                 print("")
-                print("Retrieving flight '{}'...".format(flight_name))
-                flight = ov_device.read_flight(flight_name)
-                if flight:
-                    print("Saving flight '{}'...".format(flight_name))
-                    if save_flight(flight_name, flight):
-                        print("Done!")
-                        exit_code = 0
+                print("Uploading terrain tile '{}'...".format(terrain_file))
+                with open(terrain_file, "rb") as f:
+                    tile_data = f.read()
+                latitude, longitude = struct.unpack_from("<hh", tile_data, 6)
+                if ov_device.upload_terrain(latitude, longitude, tile_data):
+                    print("Done!")
+                    exit_code = 0
                 else:
-                    print("Unable to retrieve flight")
+                    print("Unable to upload terrain tile")
+            elif stream_file:
+                print("")
+                print("Recording sensor stream into '{}', press Ctrl+C to stop...".format(stream_file))
+                with create_stream_file(stream_file) as f:
+                    if ov_device.start_stream():
+                        try:
+                            while True:
+                                dropped, records = ov_device.read_stream()
+                                if records:
+                                    f.write(records)
+                        except KeyboardInterrupt:
+                            pass
+                        stats = ov_device.stop_stream()
+                        if stats:
+                            print("Done! {} records, {} dropped by the device".format(
+                                stats.records, stats.dropped))
+                            exit_code = 0
+                        else:
+                            print("Unable to stop the sensor stream")
+                    else:
+                        print("Unable to start the sensor stream")
             else:
-                print("Unable to retrieve flight list")
+                print("")
+                flights = ov_device.get_flight_list()
+                if flights:
+                    print("Stored flights : ")
+                    flight_id = 0
+                    for flight in flights:
+                        print(" {} - {} : {} bytes, {:02}h{:02}, {:.1f} km, max {:.0f} m, max climb {:.1f} m/s, {} thermal(s), {}".format(
+                              flight_id, flight.name, flight.size,
+                              flight.airtime // 3600, (flight.airtime % 3600) // 60,
+                              flight.distance / 1000.0, flight.max_altitude / 10.0,
+                              flight.max_climb / 10.0, flight.thermal_count, flight.glider))
+                        flight_id += 1
+
+                    print("")
+                    flight_id = -1
+                    while flight_id < 0 or flight_id >= len(flights):
+                        try:
+                            flight_id = int(input("Select flight to retrieve : "))
+                        except:
+                            flight_id = -1
+                    flight_name = flights[flight_id].name
+
+                    print("")
+                    print("Retrieving flight '{}'...".format(flight_name))
+                    flight = ov_device.read_flight(flight_name)
+                    if flight:
+                        print("Saving flight '{}'...".format(flight_name))
+                        if save_flight(flight_name, flight):
+                            print("Done!")
+                            exit_code = 0
+                    else:
+                        print("Unable to retrieve flight")
+                else:
+                    print("Unable to retrieve flight list")
 
         else:
             print("Unable to retrieve device informations")